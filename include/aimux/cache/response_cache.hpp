@@ -4,6 +4,7 @@
 #include <unordered_map>
 #include <chrono>
 #include <mutex>
+#include <shared_mutex>
 #include <memory>
 #include <functional>
 #include <atomic>
@@ -15,13 +16,16 @@ namespace cache {
 
 /**
  * @brief Cached response entry with TTL
+ *
+ * The payload is kept serialized so its memory footprint is known exactly
+ * and a hit can be returned without re-serializing.
  */
 struct CacheEntry {
-    nlohmann::json response;
+    std::string payload;
     std::chrono::steady_clock::time_point timestamp;
     std::chrono::milliseconds ttl;
     int hit_count = 0;
-    size_t response_size;
+    size_t response_size = 0;
 
     bool isExpired() const {
         return std::chrono::steady_clock::now() > (timestamp + ttl);
@@ -30,6 +34,12 @@ struct CacheEntry {
 
 /**
  * @brief Intelligent response caching system with LRU eviction
+ *
+ * Keys are spread over independently locked shards. Each shard keeps its
+ * entries in a hash map whose nodes are threaded on an intrusive
+ * doubly-linked recency list, so lookup, promotion and eviction are all
+ * O(1). Entry and memory limits are enforced per shard from exact byte
+ * counts of the stored keys and payloads.
  */
 class ResponseCache {
 public:
@@ -43,10 +53,13 @@ public:
         std::chrono::milliseconds max_ttl{3600000}; // 1 hour
         double hit_rate_threshold = 0.7;
         bool enable_smart_ttl = true;
+        size_t shard_count = 16;
+        size_t max_routes = 64;     // Distinct route labels tracked before folding into "other"
     };
 
-    explicit ResponseCache(const Config& config = Config());
-    ~ResponseCache() = default;
+    ResponseCache();
+    explicit ResponseCache(const Config& config);
+    ~ResponseCache();
 
     // Non-copyable but movable
     ResponseCache(const ResponseCache&) = delete;
@@ -70,6 +83,20 @@ public:
     void put(const std::string& key, const nlohmann::json& response,
              std::optional<std::chrono::milliseconds> ttl = std::nullopt);
 
+    /**
+     * @brief Get a cached serialized response, counting the lookup against a route
+     * @param key Cache key
+     * @param route Route label for per-route hit/miss/eviction metrics; labels
+     *        beyond Config::max_routes are counted under "other"
+     */
+    std::optional<std::string> getPayload(const std::string& key, const std::string& route = "");
+
+    /**
+     * @brief Store a serialized response attributed to a route
+     */
+    void putPayload(const std::string& key, std::string payload, const std::string& route = "",
+                    std::optional<std::chrono::milliseconds> ttl = std::nullopt);
+
     /**
      * @brief Remove entry from cache
      */
@@ -98,21 +125,51 @@ public:
     Stats getStats() const;
     void resetStats();
 
+    /**
+     * @brief Per-route hit/miss/eviction counters
+     * @return JSON object keyed by route label, with overflow labels under "other"
+     */
+    nlohmann::json getRouteStats() const;
+
     // Advanced features
     void enableAdaptiveTTL(bool enable) { config_.enable_smart_ttl = enable; }
     void setTTLMultiplier(double multiplier) { ttl_multiplier_ = multiplier; }
 
 private:
-    struct LRUEntry {
-        std::string key;
-        std::chrono::steady_clock::time_point last_access;
+    struct RouteCounters {
+        std::atomic<size_t> hits{0};
+        std::atomic<size_t> misses{0};
+        std::atomic<size_t> evictions{0};
+    };
+
+    // Map value doubling as an intrusive recency-list node
+    struct Node {
+        const std::string* key = nullptr;
+        CacheEntry entry;
+        std::shared_ptr<RouteCounters> route;
+        size_t bytes = 0;
+        Node* prev = nullptr;
+        Node* next = nullptr;
+    };
+
+    struct Shard {
+        mutable std::mutex mutex;
+        std::unordered_map<std::string, Node> entries;
+        Node* head = nullptr;  // most recently used
+        Node* tail = nullptr;  // least recently used
+        size_t bytes = 0;
+
+        void linkFront(Node* node);
+        void unlink(Node* node);
     };
 
     Config config_;
-    mutable std::mutex mutex_;
+    std::unique_ptr<Shard[]> shards_;
+    size_t shard_max_entries_ = 0;
+    size_t shard_max_bytes_ = 0;
 
-    std::unordered_map<std::string, CacheEntry> cache_;
-    std::vector<LRUEntry> lru_list_;
+    mutable std::shared_mutex routes_mutex_;
+    std::unordered_map<std::string, std::shared_ptr<RouteCounters>> routes_;
 
     // Statistics
     mutable std::atomic<size_t> hits_{0};
@@ -122,13 +179,14 @@ private:
     double ttl_multiplier_ = 1.0;
 
     // Internal methods
-    void updateLRU(const std::string& key);
-    void evictLRU();
+    Shard& shardFor(const std::string& key) const;
+    std::shared_ptr<RouteCounters> routeCounters(const std::string& route);
+    void eraseNode(Shard& shard, std::unordered_map<std::string, Node>::iterator it);
+    void evictLRU(Shard& shard);
     bool shouldEvict(const CacheEntry& entry) const;
     std::chrono::milliseconds calculateTTL(const nlohmann::json& request,
                                           const nlohmann::json& response) const;
-    size_t estimateMemoryUsage(const CacheEntry& entry) const;
-    void enforceMemoryLimit();
+    static size_t entryBytes(const std::string& key, const CacheEntry& entry);
 };
 
 /**
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <atomic>
 #include <string>
 #include <functional>
 #include <memory>
@@ -13,6 +14,11 @@ namespace core {
 struct Request;
 struct Response;
 
+/**
+ * @brief Receives the outcome of Bridge::send_request_async(); invoked exactly once
+ */
+using ResponseCallback = std::function<void(Response response)>;
+
 /**
  * @brief Bridge interface for connecting with different AI providers
  *
@@ -63,6 +69,24 @@ public:
      * @note Response time depends on provider and model complexity
      */
     virtual Response send_request(const Request& request) = 0;
+
+    /**
+     * @brief Send a request without holding the calling thread for the upstream call
+     *
+     * HTTP providers start the transfer on the shared network event loop and
+     * return at once; @p on_complete then runs on the loop thread and must
+     * hand anything slow to another thread. The default implementation is a
+     * blocking send_request() that completes on the calling thread.
+     *
+     * @param request The request to send
+     * @param on_complete Receives the response; not invoked if the call throws before sending
+     *
+     * @thread Thread-safe: Must handle concurrent requests safely
+     * @since v2.0.0
+     */
+    virtual void send_request_async(const Request& request, ResponseCallback on_complete) {
+        on_complete(send_request(request));
+    }
     
     /**
      * @brief Check if the provider is healthy and available
@@ -82,6 +106,41 @@ public:
      */
     virtual bool is_healthy() const = 0;
 
+    /**
+     * @brief Actively probe the provider with a cheap upstream call
+     *
+     * Used by the gateway's health monitor on a timer. HTTP providers issue a
+     * models-list request over their pooled connections; the default reports
+     * is_healthy() without any network traffic.
+     *
+     * @return Response whose success and status_code describe the probe outcome
+     *
+     * @thread Thread-safe: Called from the health monitor thread
+     * @since v2.0.0
+     */
+    virtual Response probe_health() {
+        Response response;
+        response.success = is_healthy();
+        response.status_code = response.success ? 200 : 503;
+        response.provider_name = get_provider_name();
+        return response;
+    }
+
+    /**
+     * @brief Start a probe and report its outcome through a callback
+     *
+     * The health monitor probes every provider this way so a provider that
+     * hangs delays only its own probe. HTTP providers complete on the network
+     * event loop; the default answers at once with probe_health().
+     *
+     * @param on_complete Receives the probe_health()-style outcome, exactly once
+     *
+     * @since v2.0.0
+     */
+    virtual void probe_health_async(ResponseCallback on_complete) {
+        on_complete(probe_health());
+    }
+
     /**
      * @brief Get provider name and version information
      *
@@ -210,8 +269,8 @@ public:
 
 private:
     std::string provider_name_;
-    bool is_healthy_ = true;
-    int request_count_ = 0;
+    std::atomic<bool> is_healthy_{true};
+    std::atomic<int> request_count_{0};
 };
 
 } // namespace core
@@ -0,0 +1,81 @@
+#pragma once
+
+#include <atomic>
+#include <memory>
+
+namespace aimux {
+namespace core {
+
+/**
+ * @brief Shared flag used to abandon an in-flight provider call
+ *
+ * Copies share the same flag, so the side that started a call keeps one
+ * copy and cancels it while the worker running the call checks another.
+ * A default-constructed token is empty and can never be cancelled.
+ *
+ * @since v2.0.0
+ */
+class CancellationToken {
+public:
+    CancellationToken() = default;
+
+    /// Token with its own flag
+    static CancellationToken create() {
+        CancellationToken token;
+        token.flag_ = std::make_shared<std::atomic<bool>>(false);
+        return token;
+    }
+
+    void cancel() const {
+        if (flag_) {
+            flag_->store(true, std::memory_order_release);
+        }
+    }
+
+    bool cancelled() const {
+        return flag_ && flag_->load(std::memory_order_acquire);
+    }
+
+    /// True if this token can be cancelled at all
+    bool valid() const { return static_cast<bool>(flag_); }
+
+private:
+    std::shared_ptr<std::atomic<bool>> flag_;
+};
+
+/// Token governing provider calls made on the calling thread (empty by default)
+inline CancellationToken& current_cancellation() {
+    thread_local CancellationToken token;
+    return token;
+}
+
+/**
+ * @brief Installs a token for the calling thread while it is alive
+ *
+ * Bridge::send_request() has no cancellation parameter; code that can abort
+ * work (HttpClient transfers, provider retry backoff) consults
+ * current_cancellation() instead.
+ *
+ * @code
+ * CancellationScope scope(token);
+ * Response response = bridge->send_request(request);  // aborts once token.cancel()
+ * @endcode
+ */
+class CancellationScope {
+public:
+    explicit CancellationScope(CancellationToken token)
+        : previous_(current_cancellation()) {
+        current_cancellation() = std::move(token);
+    }
+
+    ~CancellationScope() { current_cancellation() = std::move(previous_); }
+
+    CancellationScope(const CancellationScope&) = delete;
+    CancellationScope& operator=(const CancellationScope&) = delete;
+
+private:
+    CancellationToken previous_;
+};
+
+} // namespace core
+} // namespace aimux
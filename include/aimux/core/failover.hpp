@@ -37,6 +37,12 @@ public:
      */
     void mark_healthy(const std::string& provider);
     
+    /**
+     * @brief Start tracking a provider; no-op if it is already tracked
+     * @param provider Provider name
+     */
+    void add_provider(const std::string& provider);
+    
     /**
      * @brief Check if a provider is currently available
      * @param provider Provider name
@@ -112,6 +118,13 @@ public:
      */
     std::string select_provider(const std::vector<std::string>& available_providers);
     
+    /**
+     * @brief Select the best provider for a request by position
+     * @param available_providers List of available providers
+     * @return Index into @p available_providers, or its size() if it is empty
+     */
+    size_t select_index(const std::vector<std::string>& available_providers);
+    
     /**
      * @brief Update response time metric for a provider
      * @param provider Provider name
@@ -168,12 +181,13 @@ private:
     ProviderMetrics* find_metrics(const std::string& provider);
     
     // Load balancing strategy implementations
-    std::string select_round_robin(const std::vector<std::string>& available_providers);
-    std::string select_least_connections(const std::vector<std::string>& available_providers);
-    std::string select_fastest_response(const std::vector<std::string>& available_providers);
-    std::string select_weighted_round_robin(const std::vector<std::string>& available_providers);
-    std::string select_adaptive(const std::vector<std::string>& available_providers);
-    std::string select_random(const std::vector<std::string>& available_providers);
+    // Each returns an index into a non-empty available_providers
+    size_t select_round_robin(const std::vector<std::string>& available_providers);
+    size_t select_least_connections(const std::vector<std::string>& available_providers);
+    size_t select_fastest_response(const std::vector<std::string>& available_providers);
+    size_t select_weighted_round_robin(const std::vector<std::string>& available_providers);
+    size_t select_adaptive(const std::vector<std::string>& available_providers);
+    size_t select_random(const std::vector<std::string>& available_providers);
     
     /**
      * @brief Helper methods for different strategies
@@ -0,0 +1,109 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <nlohmann/json.hpp>
+
+namespace aimux {
+namespace core {
+
+/**
+ * @brief Count of JSON parse/serialize work done on the current thread
+ *
+ * The difference between two snapshots (see JsonCodecScope) is the work the
+ * thread did in between. That equals a request's cost only while the request
+ * stays on one thread: through the synchronous route_request() path it does,
+ * but under the AsyncRequestPipeline the provider call and prettifier run on
+ * the curl event loop and pipeline workers, so a scope on the HTTP handler
+ * sees only the work done on its own thread.
+ *
+ * @since v2.0.0
+ */
+struct JsonCodecCounters {
+    uint64_t parses = 0;          ///< Documents parsed from text
+    uint64_t dumps = 0;           ///< Documents serialized to text
+    uint64_t reuses = 0;          ///< Parses avoided by sharing an existing document
+    uint64_t bytes_parsed = 0;
+    uint64_t bytes_dumped = 0;
+
+    JsonCodecCounters operator-(const JsonCodecCounters& other) const {
+        return {parses - other.parses, dumps - other.dumps, reuses - other.reuses,
+                bytes_parsed - other.bytes_parsed, bytes_dumped - other.bytes_dumped};
+    }
+
+    JsonCodecCounters operator+(const JsonCodecCounters& other) const {
+        return {parses + other.parses, dumps + other.dumps, reuses + other.reuses,
+                bytes_parsed + other.bytes_parsed, bytes_dumped + other.bytes_dumped};
+    }
+
+    nlohmann::json to_json() const {
+        return {
+            {"parses", parses},
+            {"dumps", dumps},
+            {"reuses", reuses},
+            {"bytes_parsed", bytes_parsed},
+            {"bytes_dumped", bytes_dumped}
+        };
+    }
+};
+
+/// Counters for the calling thread
+inline JsonCodecCounters& json_codec_counters() {
+    thread_local JsonCodecCounters counters;
+    return counters;
+}
+
+/**
+ * @brief Parse JSON text, counted in json_codec_counters()
+ * @throws nlohmann::json::parse_error on malformed input
+ */
+inline nlohmann::json parse_json(std::string_view text) {
+    auto& counters = json_codec_counters();
+    counters.parses++;
+    counters.bytes_parsed += text.size();
+    return nlohmann::json::parse(text);
+}
+
+/**
+ * @brief Parse JSON text without throwing
+ * @return The document, or a value for which is_discarded() is true
+ */
+inline nlohmann::json try_parse_json(std::string_view text) {
+    auto& counters = json_codec_counters();
+    counters.parses++;
+    counters.bytes_parsed += text.size();
+    return nlohmann::json::parse(text, nullptr, false);
+}
+
+/// Serialize a document, counted in json_codec_counters()
+inline std::string dump_json(const nlohmann::json& document, int indent = -1) {
+    std::string text = document.dump(indent);
+    auto& counters = json_codec_counters();
+    counters.dumps++;
+    counters.bytes_dumped += text.size();
+    return text;
+}
+
+/**
+ * @brief Measures the JSON work done on this thread while it is alive
+ *
+ * @code
+ * JsonCodecScope scope;
+ * Response response = manager->route_request(request);
+ * log(scope.counters().to_json().dump());
+ * @endcode
+ */
+class JsonCodecScope {
+public:
+    JsonCodecScope() : start_(json_codec_counters()) {}
+
+    /// Work done since construction
+    JsonCodecCounters counters() const { return json_codec_counters() - start_; }
+
+private:
+    JsonCodecCounters start_;
+};
+
+} // namespace core
+} // namespace aimux
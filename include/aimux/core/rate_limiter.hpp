@@ -0,0 +1,78 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <string>
+
+namespace aimux {
+namespace core {
+
+/**
+ * @brief Lock-free GCRA (generic cell rate algorithm) request limiter
+ *
+ * Equivalent to a token bucket holding @p burst tokens that refills at
+ * @p requests_per_minute, but the whole state is one theoretical arrival
+ * time, so try_acquire() is a single compare-and-swap loop with no refill
+ * timer and no lock. A limit of zero or less means unlimited.
+ *
+ * Instances are meant to be shared: every caller drawing on the same
+ * upstream quota (one provider API key) should use the same limiter,
+ * which shared() hands out by key.
+ *
+ * @thread Thread-safe: all methods may be called concurrently
+ * @since v2.0.0
+ */
+class RateLimiter {
+public:
+    /// Snapshot for status endpoints
+    struct State {
+        int limit = 0;              ///< Requests per minute (0 = unlimited)
+        int burst = 0;
+        int remaining = 0;          ///< Requests admissible right now
+        std::chrono::milliseconds reset_in{0};   ///< Until the bucket is full again
+    };
+
+    /**
+     * @param requests_per_minute Sustained rate; <= 0 disables limiting
+     * @param burst Requests admissible back to back; <= 0 uses requests_per_minute
+     */
+    explicit RateLimiter(int requests_per_minute, int burst = 0);
+
+    /**
+     * @brief Take one request from the budget if available
+     * @param retry_after Set on rejection to the wait until one is available
+     * @return true if the request may proceed
+     */
+    bool try_acquire(std::chrono::milliseconds* retry_after = nullptr);
+
+    /// Give back one request taken by try_acquire() that was never sent
+    void refund();
+
+    /// Change the rate; requests already admitted stay counted
+    void configure(int requests_per_minute, int burst = 0);
+
+    State state() const;
+
+    /**
+     * @brief Limiter shared by everyone using @p key
+     *
+     * The first caller creates it; later callers get the same instance,
+     * reconfigured to their rate (last configuration wins). Released once
+     * no holder remains.
+     */
+    static std::shared_ptr<RateLimiter> shared(const std::string& key, int requests_per_minute, int burst = 0);
+
+private:
+    static int64_t now_ns();
+
+    std::atomic<int64_t> emission_interval_ns_{0};  // 0 = unlimited
+    std::atomic<int64_t> tolerance_ns_{0};          // emission interval * (burst - 1)
+    std::atomic<int64_t> theoretical_arrival_ns_{0};
+    std::atomic<int> limit_{0};
+    std::atomic<int> burst_{0};
+};
+
+} // namespace core
+} // namespace aimux
@@ -1,19 +1,34 @@
 #pragma once
 
+#include <atomic>
+#include <functional>
+#include <mutex>
 #include <string>
+#include <string_view>
 #include <vector>
 #include <memory>
 #include "aimux/core/failover.hpp"
+#include "aimux/core/json_codec.hpp"
 #include <nlohmann/json.hpp>
 
 namespace aimux {
 namespace core {
 
 // Forward declarations
+class Bridge;
 struct ProviderConfig;
 struct Request;
 struct Response;
 
+/**
+ * @brief Builds the long-lived bridge for one provider
+ *
+ * Called once per provider when the router's provider table is (re)built,
+ * never per request. May throw; the provider then fails its requests until
+ * the next rebuild.
+ */
+using BridgeBuilder = std::function<std::shared_ptr<Bridge>(const ProviderConfig&)>;
+
 /**
  * @brief Core router class that manages provider selection and intelligent failover
  *
@@ -45,6 +60,14 @@ struct Response;
  *
  * Response response = router.route(request);
  * @endcode
+ *
+ * Providers live in an immutable table built once per configuration: each
+ * entry has an integer ID and its bridge, so routing never serializes a
+ * config or constructs a provider. The table also lists the enabled entry
+ * IDs; the load balancer's pick is a position in that list, so route()
+ * reaches the entry without a name lookup. update_providers() swaps in a
+ * new table atomically; requests already routed keep the table they
+ * started with.
  */
 class Router {
 public:
@@ -55,10 +78,28 @@ public:
      * and start background health monitoring for all enabled providers.
      *
      * @param providers Vector of provider configurations to manage
+     * @param bridge_builder Bridge constructor; defaults to BridgeFactory::create_bridge
      * @throws std::invalid_argument if providers vector is empty
      * @throws std::runtime_error if failover manager initialization fails
      */
-    explicit Router(const std::vector<ProviderConfig>& providers);
+    explicit Router(const std::vector<ProviderConfig>& providers, BridgeBuilder bridge_builder = {});
+    ~Router();
+
+    Router(const Router&) = delete;
+    Router& operator=(const Router&) = delete;
+
+    /**
+     * @brief Replace the provider configuration
+     *
+     * Builds a new provider table and publishes it atomically. Providers whose
+     * configuration is unchanged keep their bridge (and with it any rate-limit
+     * and failure state); changed or new providers get a new one. Safe to call
+     * while other threads are routing.
+     *
+     * @param providers New provider configurations
+     * @since v2.0.0
+     */
+    void update_providers(const std::vector<ProviderConfig>& providers);
 
     /**
      * @brief Route a request to the best available provider
@@ -140,7 +181,14 @@ public:
     std::string get_metrics() const;
 
 private:
-    std::vector<ProviderConfig> providers_;
+    struct ProviderTable;
+
+    std::shared_ptr<const ProviderTable> build_table(const std::vector<ProviderConfig>& providers,
+                                                     const ProviderTable* previous) const;
+
+    BridgeBuilder bridge_builder_;
+    std::atomic<std::shared_ptr<const ProviderTable>> table_;
+    std::mutex update_mutex_;   // Serializes update_providers()
     std::unique_ptr<FailoverManager> failover_manager_;
     std::unique_ptr<LoadBalancer> load_balancer_;
 };
@@ -361,6 +409,9 @@ struct Response {
      * For failed requests, may contain:
      * - Error details if some data was received
      * - Empty string if complete failure
+     *
+     * Once json() has been called, replace the body through set_data() or
+     * set_json(); a direct assignment is only noticed if it changes the length.
      */
     std::string data;
 
@@ -411,6 +462,47 @@ struct Response {
      */
     std::string provider_name;
 
+    /**
+     * @brief Parsed form of data, shared by every stage that reads the body
+     *
+     * Filled by json() or set_json() and dropped by set_data(). Copies of the
+     * response share the same immutable document. The size of the bytes it
+     * was parsed from is kept as a cheap guard against direct writes to data.
+     */
+    struct ParsedBody {
+        nlohmann::json document;
+        size_t source_size = 0;
+        bool valid = false;     ///< False if the body was not JSON
+    };
+    mutable std::shared_ptr<const ParsedBody> parsed_body;
+
+    /**
+     * @brief Parsed view of data, parsed at most once per body
+     *
+     * The first call parses data; later calls (on this response or any copy
+     * of it) return the same document. Like the rest of Response this is not
+     * synchronized; a response is handled by one thread at a time.
+     *
+     * @return The document, or nullptr if data is not valid JSON
+     */
+    const nlohmann::json* json() const;
+
+    /**
+     * @brief Replace data and drop the parsed view of the old body
+     * @param body New response body
+     */
+    void set_data(std::string body);
+
+    /**
+     * @brief Replace data with a serialized document and keep the document
+     *
+     * A stage that builds or rewrites the body as JSON hands it on through
+     * this so later stages read it without reparsing.
+     *
+     * @param document New response body
+     */
+    void set_json(nlohmann::json document);
+
     /**
      * @brief Convert response to JSON format
      *
@@ -434,5 +526,32 @@ struct Response {
     static Response from_json(const nlohmann::json& j);
 };
 
+inline const nlohmann::json* Response::json() const {
+    if (!parsed_body || parsed_body->source_size != data.size()) {
+        auto body = std::make_shared<ParsedBody>();
+        body->document = try_parse_json(data);
+        body->valid = !body->document.is_discarded();
+        body->source_size = data.size();
+        parsed_body = std::move(body);
+    } else {
+        json_codec_counters().reuses++;
+    }
+    return parsed_body->valid ? &parsed_body->document : nullptr;
+}
+
+inline void Response::set_json(nlohmann::json document) {
+    data = dump_json(document);
+    auto body = std::make_shared<ParsedBody>();
+    body->document = std::move(document);
+    body->valid = true;
+    body->source_size = data.size();
+    parsed_body = std::move(body);
+}
+
+inline void Response::set_data(std::string body) {
+    data = std::move(body);
+    parsed_body.reset();
+}
+
 } // namespace core
 } // namespace aimux
\ No newline at end of file
@@ -26,6 +26,10 @@
 #include <exception>
 #include <shared_mutex>
 #include <queue>
+#include <cstddef>
+#include <new>
+#include <stdexcept>
+#include <type_traits>
 
 namespace aimux {
 namespace core {
@@ -401,11 +405,132 @@ private:
 };
 
 /**
- * @brief RAII thread pool with automatic resource management
+ * @brief Move-only callable with inline storage for small captures
+ *
+ * Unlike std::function it accepts move-only callables (promises, packaged
+ * tasks, unique_ptrs), and captures of up to INLINE_SIZE bytes live in the
+ * object itself instead of a separate heap block.
+ */
+class PoolTask {
+public:
+    static constexpr size_t INLINE_SIZE = 48;
+
+    PoolTask() noexcept = default;
+
+    template<typename Function,
+             typename = std::enable_if_t<!std::is_same_v<std::decay_t<Function>, PoolTask>>>
+    PoolTask(Function&& func) {
+        using Callable = std::decay_t<Function>;
+        if constexpr (fits_inline<Callable>()) {
+            ::new (static_cast<void*>(storage_)) Callable(std::forward<Function>(func));
+            ops_ = &InlineOps<Callable>::ops;
+        } else {
+            ::new (static_cast<void*>(storage_)) Callable*(new Callable(std::forward<Function>(func)));
+            ops_ = &HeapOps<Callable>::ops;
+        }
+    }
+
+    PoolTask(PoolTask&& other) noexcept : ops_(other.ops_) {
+        if (ops_) {
+            ops_->move(storage_, other.storage_);
+            other.ops_ = nullptr;
+        }
+    }
+
+    PoolTask& operator=(PoolTask&& other) noexcept {
+        if (this != &other) {
+            reset();
+            if (other.ops_) {
+                other.ops_->move(storage_, other.storage_);
+                ops_ = other.ops_;
+                other.ops_ = nullptr;
+            }
+        }
+        return *this;
+    }
+
+    PoolTask(const PoolTask&) = delete;
+    PoolTask& operator=(const PoolTask&) = delete;
+
+    ~PoolTask() { reset(); }
+
+    explicit operator bool() const noexcept { return ops_ != nullptr; }
+
+    void operator()() { ops_->invoke(storage_); }
+
+    /// Whether Callable is stored without a heap allocation
+    template<typename Callable>
+    static constexpr bool fits_inline() {
+        return sizeof(Callable) <= INLINE_SIZE &&
+               alignof(Callable) <= alignof(std::max_align_t) &&
+               std::is_nothrow_move_constructible_v<Callable>;
+    }
+
+private:
+    struct Ops {
+        void (*invoke)(void* storage);
+        void (*move)(void* to, void* from) noexcept;
+        void (*destroy)(void* storage) noexcept;
+    };
+
+    template<typename Callable>
+    struct InlineOps {
+        static void invoke(void* storage) { (*static_cast<Callable*>(storage))(); }
+        static void move(void* to, void* from) noexcept {
+            ::new (to) Callable(std::move(*static_cast<Callable*>(from)));
+            static_cast<Callable*>(from)->~Callable();
+        }
+        static void destroy(void* storage) noexcept { static_cast<Callable*>(storage)->~Callable(); }
+        static constexpr Ops ops{&invoke, &move, &destroy};
+    };
+
+    template<typename Callable>
+    struct HeapOps {
+        static Callable*& target(void* storage) { return *static_cast<Callable**>(storage); }
+        static void invoke(void* storage) { (*target(storage))(); }
+        static void move(void* to, void* from) noexcept { ::new (to) Callable*(target(from)); }
+        static void destroy(void* storage) noexcept { delete target(storage); }
+        static constexpr Ops ops{&invoke, &move, &destroy};
+    };
+
+    void reset() noexcept {
+        if (ops_) {
+            ops_->destroy(storage_);
+            ops_ = nullptr;
+        }
+    }
+
+    alignas(std::max_align_t) unsigned char storage_[INLINE_SIZE];
+    const Ops* ops_ = nullptr;
+};
+
+/**
+ * @brief Work-stealing thread pool
+ *
+ * Every worker owns a Chase-Lev deque: tasks submitted from a worker go to
+ * the bottom of its own deque and are popped LIFO without locking, while
+ * idle workers steal FIFO from the top of the others. Submissions from
+ * outside the pool are spread round-robin over per-worker inboxes, so
+ * producers contend on one shard rather than a single queue. Workers that
+ * find nothing park on a condition variable and are woken only when work
+ * arrives while someone is parked.
+ *
+ * ThreadPool::shared() is the process-wide pool that components with short,
+ * independent tasks (stream chunk processing, metric flushes, async writes)
+ * use instead of spinning up private threads.
+ *
+ * @thread Thread-safe
+ * @since v2.0.0
  */
 class ThreadPool {
 public:
-    explicit ThreadPool(size_t thread_count, const std::string& pool_name = "ThreadPool");
+    /**
+     * @param thread_count Number of workers (at least one)
+     * @param pool_name Prefix for worker OS thread names
+     * @param pin_to_cores Bind worker i to CPU i modulo the core count (Linux only)
+     */
+    explicit ThreadPool(size_t thread_count, const std::string& pool_name = "ThreadPool",
+                        bool pin_to_cores = false);
     ~ThreadPool();
 
     // Delete copy/move operations
@@ -414,38 +539,63 @@ public:
     ThreadPool(ThreadPool&&) = delete;
     ThreadPool& operator=(ThreadPool&&) = delete;
 
+    /**
+     * @brief Process-wide pool sized to the hardware concurrency
+     *
+     * Holders keep it alive, so it outlives static destruction order issues.
+     */
+    static std::shared_ptr<ThreadPool> shared();
+
     /**
      * @brief Submit task to thread pool
      *
      * @tparam Function Callable type
      * @tparam Args Arguments types
      * @param func Function to execute
-     * @param args Arguments to pass to function
+     * @param args Arguments to pass to function, moved into the task
      * @return Future for the result
+     * @throws std::runtime_error if the pool has been shut down
      */
     template<typename Function, typename... Args>
-    auto submit(Function&& func, Args&&... args) -> std::future<decltype(func(args...))> {
-        using ReturnType = decltype(func(args...));
-
-        auto promise = std::make_shared<std::promise<ReturnType>>();
-        auto future = promise->get_future();
-
-        task_queue_.push([=, p = std::move(promise)]() mutable {
-            try {
-                if constexpr (std::is_void_v<ReturnType>) {
-                    func(args...);
-                    p->set_value();
-                } else {
-                    p->set_value(func(args...));
-                }
-            } catch (...) {
-                p->set_exception(std::current_exception());
-            }
-        });
+    auto submit(Function&& func, Args&&... args)
+        -> std::future<std::invoke_result_t<std::decay_t<Function>, std::decay_t<Args>...>> {
+        using ReturnType = std::invoke_result_t<std::decay_t<Function>, std::decay_t<Args>...>;
 
+        std::packaged_task<ReturnType()> task(
+            [func = std::forward<Function>(func), ...args = std::forward<Args>(args)]() mutable {
+                return std::invoke(std::move(func), std::move(args)...);
+            });
+        auto future = task.get_future();
+
+        if (!enqueue(PoolTask(std::move(task)))) {
+            throw std::runtime_error("Thread pool '" + pool_name_ + "' is shut down");
+        }
         return future;
     }
 
+    /**
+     * @brief Run a task without tracking its result
+     *
+     * Exceptions escaping the task are counted in PoolStats::failed_tasks.
+     *
+     * @return false if the pool has been shut down; the task is discarded
+     */
+    template<typename Function>
+    bool post(Function&& func) {
+        return enqueue(PoolTask(std::forward<Function>(func)));
+    }
+
+    /**
+     * @brief Per-worker scheduling counters
+     */
+    struct WorkerStats {
+        size_t queued_tasks;        // Deque plus inbox
+        uint64_t executed_tasks;
+        uint64_t stolen_tasks;      // Taken from another worker's deque or inbox
+        bool idle;                  // Parked waiting for work
+        int cpu;                    // Pinned core, -1 when not pinned
+    };
+
     /**
      * @brief Get pool statistics
      */
@@ -454,26 +604,48 @@ public:
         size_t active_threads;
         size_t queued_tasks;
         size_t completed_tasks;
+        uint64_t stolen_tasks;
+        uint64_t failed_tasks;
+        std::vector<WorkerStats> workers;
     };
 
     PoolStats get_stats() const;
 
+    size_t size() const { return workers_.size(); }
+
+    const std::string& name() const { return pool_name_; }
+
+    /// True when called from one of this pool's workers
+    bool is_worker_thread() const;
+
     /**
-     * @brief Shutdown pool and wait for all tasks to complete
+     * @brief Stop accepting tasks, run everything already queued and join the workers
+     *
+     * Must not be called from a worker thread.
      */
     void shutdown();
 
 private:
-    std::vector<std::unique_ptr<ManagedThread>> workers_;
-    std::queue<std::function<void()>> task_queue_;
-    mutable std::mutex queue_mutex_;
-    std::condition_variable queue_cv_;
-    std::atomic<bool> shutdown_flag_{false};
+    struct Worker;
+
+    bool enqueue(PoolTask task);
+    void worker_loop(size_t index);
+    PoolTask* find_task(size_t index, bool& stolen);
+    void wake_one();
+
+    std::vector<std::unique_ptr<Worker>> workers_;
+    const std::string pool_name_;
+
+    std::atomic<size_t> queued_tasks_{0};
+    std::atomic<size_t> next_inbox_{0};
+    std::atomic<size_t> idle_workers_{0};
     std::atomic<size_t> active_workers_{0};
     std::atomic<size_t> completed_tasks_{0};
-    const std::string pool_name_;
+    std::atomic<uint64_t> failed_tasks_{0};
+    std::atomic<bool> stopping_{false};
 
-    void worker_loop(ManagedThread* worker);
+    std::mutex park_mutex_;
+    std::condition_variable park_cv_;
 };
 
 /**
@@ -0,0 +1,182 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <nlohmann/json.hpp>
+#include "aimux/core/rate_limiter.hpp"
+#include "aimux/metrics/latency_histogram.hpp"
+
+namespace aimux {
+namespace gateway {
+
+/**
+ * @brief Per-provider admission limits applied before any upstream call
+ */
+struct AdmissionLimits {
+    int max_requests_per_minute_ = 0;       // 0 = no gateway-side rate limit
+    int burst_ = 0;                         // 0 = a minute's worth
+    int max_concurrent_requests_ = 0;       // 0 = unlimited
+    int max_queue_depth_ = 32;              // Requests allowed to wait for a slot
+    std::chrono::milliseconds max_queue_wait_{250};
+
+    nlohmann::json to_json() const;
+    static AdmissionLimits from_json(const nlohmann::json& j);
+};
+
+enum class AdmissionResult {
+    ADMITTED,
+    RATE_LIMITED,   // Provider's request rate exhausted
+    SATURATED       // No concurrency slot and the wait queue was full or timed out
+};
+
+std::string admission_result_to_string(AdmissionResult result);
+
+/**
+ * @brief Holds one concurrency slot for as long as it is alive
+ *
+ * Returned by AdmissionController::admit() whether or not the request was
+ * admitted; only admitted tickets hold a slot.
+ */
+class AdmissionTicket {
+public:
+    struct Gate;
+
+    AdmissionTicket() = default;
+    AdmissionTicket(std::shared_ptr<Gate> gate, AdmissionResult result, std::chrono::milliseconds retry_after);
+    ~AdmissionTicket();
+
+    AdmissionTicket(AdmissionTicket&& other) noexcept;
+    AdmissionTicket& operator=(AdmissionTicket&& other) noexcept;
+    AdmissionTicket(const AdmissionTicket&) = delete;
+    AdmissionTicket& operator=(const AdmissionTicket&) = delete;
+
+    bool admitted() const { return result_ == AdmissionResult::ADMITTED; }
+    AdmissionResult result() const { return result_; }
+
+    /// Suggested wait before retrying a rejected request
+    std::chrono::milliseconds retry_after() const { return retry_after_; }
+
+private:
+    void release();
+
+    std::shared_ptr<Gate> gate_;        // Set only while holding a slot
+    AdmissionResult result_ = AdmissionResult::ADMITTED;
+    std::chrono::milliseconds retry_after_{0};
+};
+
+/**
+ * @brief Rate and concurrency admission control in front of providers
+ *
+ * Each configured provider gets a GCRA rate limiter and a concurrency
+ * limit. Requests take a free slot with one compare-and-swap; when all
+ * slots are busy up to max_queue_depth_ requests wait at most
+ * max_queue_wait_ for one, and everything beyond that is rejected at once
+ * so callers can answer with a local 429 or reroute instead of queueing
+ * behind a saturated provider. A request rejected as SATURATED gives its
+ * rate token back, so only requests that reach the provider count against
+ * its rate. Providers without limits are always admitted.
+ *
+ * admit_async() is the same admission for callers that must not block (the
+ * event loop, pipeline workers): a request with no free slot is parked in
+ * the same bounded queue, handed the next released slot, and rejected when
+ * an engine timer finds it still waiting after max_queue_wait_.
+ *
+ * The provider table is published through an atomic shared_ptr, so admit()
+ * takes no lock unless it has to wait.
+ *
+ * @thread Thread-safe
+ * @since v2.0.0
+ */
+class AdmissionController {
+public:
+    /**
+     * @brief Receives the outcome of admit_async(), exactly once
+     */
+    using AdmissionCallback = std::function<void(AdmissionTicket ticket)>;
+
+    AdmissionController();
+
+    /// Set or replace a provider's limits; in-flight requests keep their slots
+    void configure(const std::string& provider_name, const AdmissionLimits& limits);
+    void remove(const std::string& provider_name);
+
+    /// Admit a request, waiting up to max_queue_wait_ for a concurrency slot
+    AdmissionTicket admit(const std::string& provider_name);
+
+    /// admit() without the wait: SATURATED at once when no slot is free
+    AdmissionTicket try_admit(const std::string& provider_name);
+
+    /**
+     * @brief admit() without blocking the calling thread
+     *
+     * An immediate outcome is delivered before this returns. A queued request
+     * is resumed on the network event loop once a released slot is handed to
+     * it, or rejected as SATURATED there when max_queue_wait_ runs out.
+     *
+     * @param provider_name Provider to admit the request to
+     * @param on_admitted Outcome callback; must not block
+     */
+    void admit_async(const std::string& provider_name, AdmissionCallback on_admitted);
+
+    /// In-flight, queue depth, rejection counters and queue wait/depth histograms per provider
+    nlohmann::json to_json() const;
+
+private:
+    using GateTable = std::unordered_map<std::string, std::shared_ptr<AdmissionTicket::Gate>>;
+
+    AdmissionTicket admit(const std::string& provider_name, bool may_wait);
+
+    std::atomic<std::shared_ptr<const GateTable>> gates_;
+    std::mutex update_mutex_;   // Serializes configure()/remove()
+};
+
+/**
+ * @brief Shared state behind one provider's admission limits
+ */
+struct AdmissionTicket::Gate : std::enable_shared_from_this<AdmissionTicket::Gate> {
+    /// An admit_async() request waiting for a slot
+    struct Parked {
+        AdmissionController::AdmissionCallback on_admitted;
+        std::chrono::steady_clock::time_point since;
+    };
+
+    explicit Gate(const AdmissionLimits& limits);
+
+    void apply(const AdmissionLimits& limits);
+    bool try_enter();
+    void leave();
+
+    /// Hand a free slot to the oldest parked request; false if none took it
+    bool resume_parked();
+    /// Reject a parked request whose wait ran out; no-op if it was resumed first
+    void expire(const std::shared_ptr<Parked>& parked);
+    void record_wait(std::chrono::steady_clock::time_point since);
+
+    core::RateLimiter rate_;
+    std::atomic<int> max_concurrent_{0};
+    std::atomic<int> max_queue_depth_{0};
+    std::atomic<int64_t> max_queue_wait_ms_{0};
+
+    std::atomic<int> in_flight_{0};
+    std::atomic<int> waiting_{0};
+    std::mutex wait_mutex_;
+    std::condition_variable wait_cv_;
+    std::deque<std::shared_ptr<Parked>> parked_;    // Guarded by wait_mutex_
+
+    std::atomic<uint64_t> admitted_{0};
+    std::atomic<uint64_t> queued_{0};
+    std::atomic<uint64_t> rate_limited_{0};
+    std::atomic<uint64_t> saturated_{0};
+    metrics::LatencyHistogram queue_wait_us_;
+    metrics::LatencyHistogram queue_depth_;     // Depth seen by each queued request
+};
+
+} // namespace gateway
+} // namespace aimux
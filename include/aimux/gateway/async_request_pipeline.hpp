@@ -0,0 +1,129 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include <nlohmann/json.hpp>
+#include "aimux/core/router.hpp"
+#include "aimux/metrics/latency_histogram.hpp"
+
+namespace aimux {
+namespace gateway {
+
+/**
+ * @brief Limits for AsyncRequestPipeline
+ */
+struct AsyncPipelineConfig {
+    size_t worker_threads_ = 4;                     // Run dispatches and continuations, never wait on upstream
+    int max_concurrent_requests_ = 1024;            // Requests dispatched and not yet completed
+    int max_queue_depth_ = 4096;                    // Requests waiting for a dispatch slot
+    std::chrono::milliseconds max_queue_wait_{30000};
+
+    nlohmann::json to_json() const;
+    static AsyncPipelineConfig from_json(const nlohmann::json& j);
+};
+
+/**
+ * @brief Bounded asynchronous request pipeline between HTTP handlers and routing
+ *
+ * HTTP handlers submit() a request with a completion and return to their
+ * server thread at once. A small pool of workers dispatches queued requests
+ * while fewer than max_concurrent_requests_ are outstanding; the dispatcher
+ * (normally GatewayManager::route_request_async) starts the upstream call
+ * and reports back through the completion, so a slow call holds a slot
+ * rather than a thread.
+ *
+ * Load is shed at the door: submit() refuses requests once
+ * max_queue_depth_ are waiting, and a request that waits longer than
+ * max_queue_wait_ for a slot completes with a 503 instead of being sent.
+ *
+ * Workers also run short tasks handed to post(), which is the executor to
+ * give the dispatcher so that response processing stays off the network
+ * event loop.
+ *
+ * @thread Thread-safe
+ * @since v2.0.0
+ */
+class AsyncRequestPipeline {
+public:
+    using Completion = std::function<void(core::Response)>;
+
+    /// Starts one request and calls done exactly once, from any thread
+    using Dispatcher = std::function<void(const core::Request&, Completion done)>;
+
+    AsyncRequestPipeline(Dispatcher dispatcher, const AsyncPipelineConfig& config = {});
+    ~AsyncRequestPipeline();
+
+    AsyncRequestPipeline(const AsyncRequestPipeline&) = delete;
+    AsyncRequestPipeline& operator=(const AsyncRequestPipeline&) = delete;
+
+    /**
+     * @brief Queue a request for dispatch
+     * @param request Request to route
+     * @param on_complete Receives the response; runs on the thread that completed it
+     * @return false if the request was shed (queue full or stopping); on_complete is not invoked
+     */
+    bool submit(core::Request request, Completion on_complete);
+
+    /// Run a short task on a worker thread
+    void post(std::function<void()> task);
+
+    /// Change the concurrency and queue limits; the worker count stays fixed
+    void update_limits(const AsyncPipelineConfig& config);
+
+    /**
+     * @brief Stop accepting requests, fail the queued ones and wait for in-flight ones
+     *
+     * Must not be called from a worker thread.
+     */
+    void stop();
+
+    int in_flight() const { return in_flight_.load(std::memory_order_relaxed); }
+    size_t queue_depth() const;
+
+    /// Limits, in-flight and queue depth, counters and queue wait histogram
+    nlohmann::json to_json() const;
+
+private:
+    struct Pending {
+        core::Request request;
+        Completion on_complete;
+        std::chrono::steady_clock::time_point enqueued;
+    };
+
+    void worker_loop();
+    void dispatch(Pending pending);
+    void complete(const Completion& on_complete, core::Response response);
+    static core::Response make_rejection(int status_code, const std::string& code, const std::string& message);
+
+    Dispatcher dispatcher_;
+
+    mutable std::mutex mutex_;
+    std::condition_variable work_available_;
+    std::condition_variable drained_;
+    std::deque<Pending> queue_;
+    std::deque<std::function<void()>> tasks_;
+    std::vector<std::thread> workers_;
+    bool accepting_ = true;
+    bool exit_ = false;
+
+    std::atomic<int> max_concurrent_{0};
+    std::atomic<int> max_queue_depth_{0};
+    std::atomic<int64_t> max_queue_wait_ms_{0};
+    std::atomic<int> in_flight_{0};
+    std::atomic<int> peak_in_flight_{0};
+
+    std::atomic<uint64_t> submitted_{0};
+    std::atomic<uint64_t> completed_{0};
+    std::atomic<uint64_t> shed_{0};
+    std::atomic<uint64_t> expired_{0};
+    metrics::LatencyHistogram queue_wait_us_;
+};
+
+} // namespace gateway
+} // namespace aimux
@@ -7,6 +7,7 @@
 #include <functional>
 #include <crow.h>
 #include <nlohmann/json.hpp>
+#include "aimux/gateway/async_request_pipeline.hpp"
 #include "aimux/gateway/gateway_manager.hpp"
 #include "aimux/core/router.hpp"
 #include "aimux/logging/logger.hpp"
@@ -22,6 +23,11 @@ struct ClaudeGatewayMetrics {
     std::atomic<uint64_t> successful_requests{0};
     std::atomic<uint64_t> failed_requests{0};
     std::atomic<double> total_response_time_ms{0.0};
+    // JSON work done by the handler (request validation, response conversion); provider
+    // and prettifier work runs on pipeline threads and is not included
+    std::atomic<uint64_t> json_parses{0};    ///< JSON documents parsed while handling requests
+    std::atomic<uint64_t> json_dumps{0};     ///< JSON documents serialized while handling requests
+    std::atomic<uint64_t> json_reuses{0};    ///< Parses avoided by sharing a response's document
     std::chrono::steady_clock::time_point start_time;
 
     ClaudeGatewayMetrics() : start_time(std::chrono::steady_clock::now()) {}
@@ -66,6 +72,14 @@ struct ClaudeGatewayConfig {
     size_t max_request_size_mb = 10;
     std::chrono::seconds request_timeout{60};
 
+    // Async request pipeline: upstream calls do not hold HTTP server threads
+    size_t worker_threads = 4;
+    int max_concurrent_requests = 1024;
+    int max_queued_requests = 4096;
+    std::chrono::milliseconds max_queue_wait{30000};
+
+    AsyncPipelineConfig pipeline_config() const;
+
     nlohmann::json to_json() const;
     static ClaudeGatewayConfig from_json(const nlohmann::json& j);
 };
@@ -77,6 +91,13 @@ struct ClaudeGatewayConfig {
  * `/anthropic/v1/messages` endpoint compatible with Claude Code. It leverages the
  * V3.1 GatewayManager for intelligent routing while providing a clean, production-ready
  * HTTP service interface.
+ *
+ * Messages are handed to an AsyncRequestPipeline and answered from its completion,
+ * so a Crow worker thread is free again as soon as the request is queued.
+ *
+ * Requests with "stream": true are answered the same way, in one piece: the bundled
+ * Crow writes nothing to the socket before res.end(), so it cannot relay SSE frames
+ * as they arrive.
  */
 class ClaudeGateway {
 public:
@@ -122,6 +143,7 @@ public:
 private:
     // Core components
     std::unique_ptr<GatewayManager> manager_;
+    std::unique_ptr<AsyncRequestPipeline> pipeline_;    // Declared after manager_: drained first
     crow::SimpleApp app_;
     std::thread server_thread_;
 
@@ -150,7 +172,7 @@ private:
 
     // Request handling
     crow::response handle_anthropic_request(const crow::request& req);
-    crow::response handle_messages_endpoint(const crow::request& req);
+    void handle_messages_endpoint(const crow::request& req, crow::response& res);
 
     // Management endpoints
     crow::response handle_metrics_request(const crow::request& req);
@@ -159,19 +181,20 @@ private:
     crow::response handle_providers_request(const crow::request& req);
 
     // Utility methods
-    core::Request convert_crow_request(const crow::request& req);
+    core::Request convert_crow_request(nlohmann::json body);
     crow::response convert_core_response(const core::Response& resp);
     crow::response create_error_response(int status, const std::string& code, const std::string& message);
 
     // Validation and security
-    bool validate_request(const crow::request& req, std::string& error_msg);
+    bool validate_request(const crow::request& req, nlohmann::json& body, std::string& error_msg);
     bool is_request_size_valid(const crow::request& req);
     void setup_cors_headers(crow::response& resp);
 
     // Logging and monitoring
     void log_request(const crow::request& req, const core::Response& resp, double duration_ms);
     void log_error(const std::string& type, const std::string& message);
-    void update_metrics(const core::Response& resp, double duration_ms);
+    void update_metrics(const core::Response& resp, double duration_ms,
+                        const core::JsonCodecCounters& json_work = {});
 
     // Service lifecycle helpers
     void server_thread_func();
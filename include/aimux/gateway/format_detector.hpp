@@ -1,7 +1,9 @@
 #pragma once
 
 #include <string>
+#include <string_view>
 #include <map>
+#include <memory>
 #include <nlohmann/json.hpp>
 #include <crow.h>
 
@@ -53,6 +55,9 @@ struct FormatDetectionConfig {
     std::vector<std::string> openai_endpoints = {
         "/v1/chat/completions", "/v1/completions", "/v1/engines"
     };
+
+    // Bytes of the raw body scanned for top-level keys before falling back to a full parse
+    size_t body_scan_limit = 4096;
 };
 
 /**
@@ -63,6 +68,9 @@ struct DetectionResult {
     double confidence = 0.0;  // 0.0 to 1.0
     std::string reasoning;     // Why this format was detected
 
+    // Request body, set when detection had to parse it; reuse it instead of parsing again
+    std::shared_ptr<const nlohmann::json> document;
+
     bool is_reliable(double threshold = 0.7) const {
         return format != APIFormat::UNKNOWN && confidence >= threshold;
     }
@@ -77,6 +85,19 @@ public:
 
     /**
      * @brief Detect API format from HTTP request
+     *
+     * Tiered so the common case never touches the body:
+     *  1. Endpoint and headers. If the body detectors could not outweigh
+     *     them, this decides.
+     *  2. A scan of the first body_scan_limit bytes for top-level keys
+     *     (model, system, messages, max_tokens, anthropic_version, ...),
+     *     fed to the model, structure and body detectors.
+     *  3. A full parse, only when the keys seen still leave the result
+     *     open. The parsed document is returned in DetectionResult::document.
+     *
+     * The format matches detect_format(json, ...); confidence covers the
+     * evidence examined, so an early decision may report less.
+     *
      * @param req Crow HTTP request
      * @param body Raw request body
      * @return Detection result with confidence
@@ -135,6 +156,13 @@ private:
         const std::map<std::string, std::string>& patterns
     );
 
+    // Case-insensitive match against Crow's headers without building a lowercased copy
+    bool has_header_pattern(
+        const crow::ci_map& headers,
+        const std::map<std::string, std::string>& patterns
+    );
+    DetectionResult detect_from_headers(const crow::ci_map& headers);
+
     bool matches_model_pattern(const std::string& model, const std::vector<std::string>& patterns);
 
     bool has_anthropic_message_structure(const nlohmann::json& json_data);
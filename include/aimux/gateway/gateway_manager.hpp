@@ -7,12 +7,18 @@
 #include <atomic>
 #include <shared_mutex>
 #include <functional>
-#include <deque>
+#include <array>
+#include <mutex>
+#include <optional>
+#include <condition_variable>
 #include <nlohmann/json.hpp>
 #include "aimux/core/bridge.hpp"
 #include "aimux/core/router.hpp"
+#include "aimux/gateway/admission_control.hpp"
 #include "aimux/gateway/provider_health.hpp"
+#include "aimux/gateway/request_metrics_store.hpp"
 #include "aimux/gateway/routing_logic.hpp"
+#include "aimux/cache/response_cache.hpp"
 #include "aimux/prettifier/prettifier_plugin.hpp"
 #include "aimux/prettifier/cerebras_formatter.hpp"
 #include "aimux/prettifier/openai_formatter.hpp"
@@ -44,6 +50,11 @@ struct GatewayProviderConfig {
     int max_concurrent_requests_ = 10;
     double cost_per_output_token_ = 0.0;
 
+    // Admission control (see AdmissionController)
+    int max_requests_per_minute_ = 0;       // 0 = no gateway-side rate limit
+    int max_queued_requests_ = 32;
+    std::chrono::milliseconds max_queue_wait_{250};
+
     // Health check settings
     std::chrono::seconds health_check_interval_{60};
     int max_failures_ = 5;
@@ -53,10 +64,56 @@ struct GatewayProviderConfig {
     int priority_score_ = 100;  // Higher = more preferred
     bool enabled_ = true;
 
+    AdmissionLimits admission_limits() const;
+
     nlohmann::json to_json() const;
     static GatewayProviderConfig from_json(const nlohmann::json& j);
 };
 
+/**
+ * @brief Hedged-request settings for GatewayManager::route_request
+ *
+ * While a request to the selected provider is still outstanding after that
+ * provider's latency_percentile_ (clamped to [min_delay_, max_delay_], or
+ * default_delay_ until min_samples_ latencies are known), the same request
+ * is also sent to the next-best available provider. The first successful
+ * response wins and the remaining attempts are cancelled. An attempt that
+ * fails while nothing else is in flight fails over immediately.
+ */
+struct HedgingConfig {
+    bool enabled_ = false;
+    double latency_percentile_ = 95.0;
+    std::chrono::milliseconds min_delay_{50};
+    std::chrono::milliseconds max_delay_{5000};
+    std::chrono::milliseconds default_delay_{1000};
+    size_t min_samples_ = 20;
+    int max_hedges_ = 1;    // Backup requests per call, not counting failovers
+
+    nlohmann::json to_json() const;
+    static HedgingConfig from_json(const nlohmann::json& j);
+};
+
+/**
+ * @brief Latencies of a provider's most recent successful calls
+ */
+class LatencyWindow {
+public:
+    static constexpr size_t CAPACITY = 256;
+
+    void record(double latency_ms);
+
+    /// p-th percentile (0-100), or nullopt with fewer than min_samples samples
+    std::optional<double> percentile(double p, size_t min_samples = 1) const;
+
+    size_t size() const;
+
+private:
+    mutable std::mutex mutex_;
+    std::array<double, CAPACITY> samples_{};
+    size_t count_ = 0;
+    size_t next_ = 0;
+};
+
 /**
  * @brief Request metrics for tracking and optimization
  */
@@ -93,6 +150,8 @@ class GatewayManager {
 public:
     using RouteCallback = std::function<void(const RequestMetrics&)>;
     using ProviderChangeCallback = std::function<void(const std::string&, bool)>;
+    using RouteCompletion = std::function<void(core::Response)>;
+    using Executor = std::function<void(std::function<void()>)>;
 
     explicit GatewayManager();
     ~GatewayManager();
@@ -108,17 +167,44 @@ public:
     void update_provider_config(const std::string& provider_name, const nlohmann::json& config);
     bool provider_exists(const std::string& provider_name) const;
 
-    // Provider adapters (using existing Bridge interface)
+    // Provider adapters (using existing Bridge interface). Adapters are shared so a
+    // request in flight keeps its bridge alive after the provider is removed.
     void add_provider_adapter(std::unique_ptr<core::Bridge> bridge);
     void remove_provider_adapter(const std::string& provider_name);
-    core::Bridge* get_provider_adapter(const std::string& provider_name);
-    const core::Bridge* get_provider_adapter(const std::string& provider_name) const;
+    std::shared_ptr<core::Bridge> get_provider_adapter(const std::string& provider_name);
+    std::shared_ptr<const core::Bridge> get_provider_adapter(const std::string& provider_name) const;
 
     // Primary routing method
     core::Response route_request(const core::Request& request);
     core::Response route_request_to_provider(const core::Request& request,
                                            const std::string& provider_name);
 
+    /**
+     * @brief route_request() without blocking the calling thread on upstream calls
+     *
+     * Provider calls go through Bridge::send_request_async(), so HTTP providers
+     * wait on the network event loop rather than on a thread. Failover happens
+     * from the completion of the failed attempt. Everything that runs after a
+     * provider answers (failover decisions, prettifier, metrics and
+     * @p on_complete itself) is handed to @p executor so the event loop is
+     * never held up; without one it runs on the thread that completed the call.
+     *
+     * Admission never waits here: a provider with no free concurrency slot is
+     * rejected as saturated and the next candidate is tried, whereas
+     * route_request() may queue for up to the provider's max_queue_wait.
+     *
+     * Hedged races run the same way: the hedge delay is an event-loop timer and
+     * the first successful callback wins. Backups and failovers are started, and
+     * the race settled, through @p executor. Providers without an async
+     * transport still block the thread they are started on.
+     *
+     * @param request Request to route
+     * @param on_complete Receives the final response exactly once
+     * @param executor Runs continuations, e.g. AsyncRequestPipeline::post
+     */
+    void route_request_async(const core::Request& request, RouteCompletion on_complete,
+                             Executor executor = {});
+
     // Configuration management
     void set_default_provider(const std::string& provider_name);
     void set_thinking_provider(const std::string& provider_name);
@@ -166,10 +252,33 @@ public:
 
     // Metrics and monitoring
     nlohmann::json get_metrics() const;
+
+    /**
+     * @brief Most recent routed requests, oldest first
+     *
+     * Records are stored compactly: error_message_ is not kept and
+     * routing_reasoning_ only carries the [FAILOVER] / [HEDGED] tags.
+     */
     std::vector<RequestMetrics> get_recent_metrics(int count = 100) const;
     void enable_metrics_collection(bool enabled);
     void clear_metrics();
 
+    // Response cache for deterministic requests (temperature 0 or "aimux_cache": true); off by default
+    void enable_response_cache(bool enabled);
+    bool is_response_cache_enabled() const { return response_cache_enabled_.load(); }
+    void configure_response_cache(const cache::ResponseCache::Config& config);
+    nlohmann::json get_response_cache_metrics() const;
+
+    // Hedged requests: race a backup provider once the primary is slower than usual
+    void configure_hedging(const HedgingConfig& config);
+    HedgingConfig get_hedging_config() const;
+    bool is_hedging_enabled() const { return hedging_enabled_.load(); }
+    std::chrono::milliseconds get_hedge_delay(const std::string& provider_name) const;
+    nlohmann::json get_hedging_metrics() const;
+
+    // Per-provider rate and concurrency limits checked before every upstream call
+    nlohmann::json get_admission_metrics() const;
+
     // Provider capabilities
     ProviderCapability get_provider_capabilities(const std::string& provider_name) const;
     std::vector<std::string> get_providers_with_capability(ProviderCapability capability) const;
@@ -201,7 +310,7 @@ public:
 private:
     // Provider configuration
     mutable std::shared_mutex adapters_mutex_;
-    std::unordered_map<std::string, std::unique_ptr<core::Bridge>> adapters_;
+    std::unordered_map<std::string, std::shared_ptr<core::Bridge>> adapters_;
     std::unordered_map<std::string, GatewayProviderConfig> provider_configs_;
 
     // Routing preferences
@@ -222,15 +331,37 @@ private:
     std::unordered_map<std::string, std::shared_ptr<prettifier::PrettifierPlugin>> prettifier_formatters_;
     std::atomic<bool> prettifier_enabled_{true};
 
+    // Response cache consulted before provider dispatch; swapped atomically on reconfigure.
+    // Opt-in: replaying a stored answer is only correct for deployments that expect it.
+    std::atomic<std::shared_ptr<cache::ResponseCache>> response_cache_;
+    std::atomic<bool> response_cache_enabled_{false};
+
+    // Hedging
+    mutable std::mutex hedging_mutex_;
+    HedgingConfig hedging_config_;
+    std::atomic<bool> hedging_enabled_{false};
+    mutable std::shared_mutex latency_mutex_;
+    std::unordered_map<std::string, std::unique_ptr<LatencyWindow>> latency_windows_;
+    std::atomic<uint64_t> hedged_requests_{0};
+    std::atomic<uint64_t> hedges_launched_{0};
+    std::atomic<uint64_t> hedge_wins_{0};
+    std::atomic<uint64_t> cancelled_attempts_{0};
+
+    // Provider callbacks and undecided hedge races that still reference the manager
+    std::mutex calls_mutex_;
+    std::condition_variable calls_done_;
+    size_t calls_in_flight_ = 0;
+
     // State management
     std::atomic<bool> initialized_{false};
     std::atomic<bool> debug_mode_{false};
     std::atomic<bool> metrics_collection_enabled_{true};
 
-    // Metrics storage
-    mutable std::shared_mutex metrics_mutex_;
-    std::deque<RequestMetrics> request_metrics_;
+    // Metrics storage: lock-free rings plus running per-provider aggregates
     static constexpr size_t MAX_METRICS_HISTORY = 10000;
+    RequestMetricsStore metrics_store_{MAX_METRICS_HISTORY};
+
+    AdmissionController admission_;
 
     // Callbacks
     RouteCallback route_callback_;
@@ -256,11 +387,53 @@ private:
     prettifier::PrettifierPlugin* get_prettifier_for_provider(const std::string& provider_name);
     core::Response apply_prettifier(const core::Response& response, const std::string& provider_name,
                                     const core::Request& request);
+    bool is_cacheable_request(const core::Request& request) const;
+    void record_provider_latency(const std::string& provider_name, double latency_ms);
+    void begin_provider_call();
+    void end_provider_call();
+    void wait_for_provider_calls();
+
+    // Hedged routing: attempts race on provider callbacks, backups start from engine timers
+    struct HedgeRace;
+    core::Response route_request_hedged(const core::Request& request,
+                                        const RoutingDecision& decision,
+                                        RequestMetrics& metrics);
+    void start_hedged_race(const core::Request& request, const RoutingDecision& decision, Executor executor,
+                           std::function<void(std::shared_ptr<HedgeRace>)> on_decided);
+    void launch_hedge_attempt(const std::shared_ptr<HedgeRace>& race, size_t index);
+    void dispatch_hedge_attempt(const std::shared_ptr<HedgeRace>& race, size_t index);
+    void arm_hedge_timer(const std::shared_ptr<HedgeRace>& race);
+    void on_hedge_result(const std::shared_ptr<HedgeRace>& race, size_t index, core::Response response);
+    void decide_hedged_race(const std::shared_ptr<HedgeRace>& race);
+    core::Response settle_hedged_race(HedgeRace& race, RequestMetrics& metrics);
+
+    // route_request() / route_request_async() shared steps
+    // On a hit, records the request (provider "response_cache") before returning it
+    std::optional<core::Response> find_cached_response(const core::Request& request,
+                                                       std::shared_ptr<cache::ResponseCache>& response_cache,
+                                                       std::string& cache_key);
+    void finish_routing(const core::Request& request, const core::Response& response,
+                        RequestMetrics& metrics,
+                        const std::shared_ptr<cache::ResponseCache>& response_cache,
+                        const std::string& cache_key);
+
+    // Asynchronous routing
+    struct AsyncRoute;
+    void start_async_attempt(const std::shared_ptr<AsyncRoute>& route);
+    void resume_async_route(const std::shared_ptr<AsyncRoute>& route, core::Response response);
+    void complete_async_route(const std::shared_ptr<AsyncRoute>& route, core::Response response);
+    void route_to_provider_async(const core::Request& request, const std::string& provider_name,
+                                 RouteCompletion on_complete);
+    void send_admitted_request(const core::Request& request, const std::string& provider_name,
+                               std::shared_ptr<core::Bridge> adapter, AdmissionTicket admission,
+                               RouteCompletion on_complete);
 
     // Error handling
     core::Response create_error_response(const std::string& error_code,
                                        const std::string& error_message,
                                        int http_status = 500) const;
+    core::Response create_admission_rejection(const std::string& provider_name,
+                                            const AdmissionTicket& ticket) const;
     void log_error(const std::string& error_type, const std::string& message) const;
     void log_debug(const std::string& message) const;
 };
@@ -0,0 +1,110 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace aimux {
+namespace gateway {
+
+/**
+ * @brief Precompiled multi-pattern matcher for request classification
+ *
+ * An Aho-Corasick automaton over case-folded ASCII in which every run of
+ * whitespace is collapsed to a single space, so "Step  by\nstep" matches the
+ * pattern "step by step". Each pattern reports into a category bit; a scan
+ * yields the union of the categories seen. The automaton is built once and
+ * is immutable afterwards, so one instance can be shared by any number of
+ * threads, each driving its own Scanner.
+ *
+ * @since v2.0.0
+ */
+class KeywordMatcher {
+    struct Node;
+
+public:
+    /// Longest pattern that can request word boundaries
+    static constexpr size_t MAX_BOUNDED_PATTERN_LENGTH = 63;
+
+    /**
+     * @brief Pattern registered with the matcher
+     */
+    struct Pattern {
+        std::string text;          ///< Literal text, matched case-insensitively
+        uint32_t category = 0;     ///< Category bit(s) reported on match
+        bool whole_word = false;   ///< Require word boundaries on both sides (regex \b)
+    };
+
+    /**
+     * @brief Streaming scan state; allocation-free and cheap to construct
+     *
+     * Text may be fed in any number of pieces; matches spanning pieces are
+     * found as if the pieces had been concatenated.
+     */
+    class Scanner {
+    public:
+        explicit Scanner(const KeywordMatcher& matcher);
+
+        /// Scan the next piece of text
+        void feed(std::string_view text);
+
+        /// Insert a word break between two pieces of text
+        void feed_separator();
+
+        /// Resolve matches still waiting for a trailing word boundary
+        uint32_t finish();
+
+        /// Categories matched so far
+        uint32_t matched() const { return found_; }
+
+        /// True once every category in mask has been matched
+        bool has_all(uint32_t mask) const { return (found_ & mask) == mask; }
+
+    private:
+        void check_bounded(const Node& node);
+
+        const KeywordMatcher* matcher_;
+        int32_t state_ = 0;        // Row offset into the transition table
+        uint32_t found_ = 0;
+        uint32_t pending_ = 0;     // Whole-word matches awaiting the next character
+        bool last_space_ = true;
+        uint64_t position_ = 0;
+        unsigned char history_[MAX_BOUNDED_PATTERN_LENGTH + 1] = {};
+    };
+
+    KeywordMatcher() : KeywordMatcher(std::vector<Pattern>{}) {}
+    explicit KeywordMatcher(const std::vector<Pattern>& patterns);
+
+    /**
+     * @brief One-shot scan of a complete string
+     * @return Union of matched category bits
+     */
+    uint32_t scan(std::string_view text) const;
+
+    /// Number of automaton states (diagnostics)
+    size_t state_count() const { return nodes_.size(); }
+
+private:
+    struct Output {
+        uint32_t category;
+        uint16_t length;
+    };
+
+    struct Node {
+        uint32_t plain_mask = 0;         // Categories of unbounded outputs, suffix links included
+        uint32_t bounded_begin = 0;      // Range into bounded_outputs_
+        uint32_t bounded_end = 0;
+    };
+
+    void build(const std::vector<Pattern>& patterns);
+
+    unsigned char class_of_[256] = {};
+    size_t class_count_ = 1;
+    std::vector<int32_t> transitions_;   // nodes x classes, fully resolved DFA (row offsets)
+    std::vector<Node> nodes_;
+    std::vector<Output> bounded_outputs_;
+};
+
+} // namespace gateway
+} // namespace aimux
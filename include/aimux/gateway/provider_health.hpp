@@ -2,10 +2,17 @@
 
 #include <chrono>
 #include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <random>
 #include <shared_mutex>
 #include <unordered_map>
 #include <string>
 #include <thread>
+#include <vector>
 #include <nlohmann/json.hpp>
 #include "aimux/core/router.hpp"
 
@@ -64,6 +71,33 @@ struct PerformanceMetrics {
     static PerformanceMetrics from_json(const nlohmann::json& j);
 };
 
+/**
+ * @brief Active probing and passive outlier ejection settings
+ *
+ * Passive detection looks at live traffic: a run of upstream errors (5xx,
+ * timeouts, transport failures) or a latency far above the provider's peers
+ * ejects it. Ejections double in length each time a provider is ejected
+ * again, and a returning provider stays DEGRADED until it has strung
+ * together enough successes.
+ */
+struct OutlierDetectionConfig {
+    int consecutive_errors_ = 5;                         // Upstream errors in a row before ejection
+    double latency_z_threshold_ = 3.0;                   // Eject above this z-score against peers
+    double latency_stddev_floor_ratio_ = 0.25;           // Peer stddev is at least this share of the peer mean
+    uint64_t min_latency_samples_ = 20;                  // Successes before a provider's latency is judged
+    size_t min_latency_peers_ = 2;                       // Other providers needed for a latency comparison
+    std::chrono::milliseconds base_ejection_time_{30000};
+    std::chrono::milliseconds max_ejection_time_{300000};
+    double max_ejection_percent_ = 50.0;                 // Never eject more than this share of providers
+    int recovery_probes_ = 2;                            // Probe successes to end an ejection early
+    int recovery_successes_ = 5;                         // Successes while DEGRADED before HEALTHY again
+    std::chrono::milliseconds sweep_interval_{10000};    // Latency outlier evaluation period
+    double probe_jitter_ = 0.1;                          // +/- share applied to every probe interval
+
+    nlohmann::json to_json() const;
+    static OutlierDetectionConfig from_json(const nlohmann::json& j);
+};
+
 /**
  * @brief Provider health monitoring information
  */
@@ -72,7 +106,12 @@ struct ProviderHealth {
     std::atomic<HealthStatus> status_{HealthStatus::HEALTHY};
     std::atomic<int> capability_flags_{0};
 
+    // Written from request threads; read through metrics_snapshot() or a ProviderScore
     PerformanceMetrics metrics_;
+    mutable std::mutex metrics_mutex_;
+
+    // Requests currently being served; shared with published ProviderScore snapshots
+    std::shared_ptr<std::atomic<int64_t>> in_flight_ = std::make_shared<std::atomic<int64_t>>(0);
 
     // Circuit breaker configuration
     std::atomic<int> consecutive_failures_{0};
@@ -89,7 +128,19 @@ struct ProviderHealth {
     // Recovery configuration
     std::atomic<int> successful_probes_{0};
     std::atomic<int> required_probes_{3};           // Success probes needed for recovery
-    std::chrono::seconds probe_interval_{30};       // 30 seconds between probes
+    std::chrono::seconds probe_interval_{10};       // Between probes while ejected or recovering
+
+    // Ejection state (CIRCUIT_OPEN until ejected_until_ns_, then DEGRADED while recovering)
+    std::atomic<int> ejection_count_{0};
+    std::atomic<int64_t> ejected_until_ns_{0};      // steady_clock
+    std::atomic<bool> recovering_{false};
+    std::atomic<int> recovery_successes_{0};
+    std::atomic<int> required_recovery_successes_{5};
+    std::chrono::milliseconds base_ejection_time_{30000};
+
+    // Latency of successful requests, for peer comparison
+    std::atomic<double> latency_ema_ms_{0.0};
+    std::atomic<uint64_t> latency_samples_{0};
 
     ProviderHealth(const std::string& name);
 
@@ -103,7 +154,9 @@ struct ProviderHealth {
 
     // Health status management
     void mark_success();
-    void mark_failure();
+    /// @param allow_ejection false caps the outcome at DEGRADED (ejection budget exhausted)
+    void mark_failure(bool allow_ejection = true);
+    /// Eject for base_ejection_time_ doubled per previous ejection, capped at failure_timeout_
     void open_circuit();
     void attempt_recovery();
     void close_circuit();
@@ -115,23 +168,138 @@ struct ProviderHealth {
     // Health checking
     bool is_healthy() const;
     bool can_accept_requests() const;
+    bool ejection_expired() const;
     std::chrono::seconds get_retry_delay() const;
 
     // Performance tracking
     void update_metrics(const core::Response& response, double request_time_ms);
+    void record_response_time(double request_time_ms);
+    void record_latency(double request_time_ms);
+    PerformanceMetrics metrics_snapshot() const;
     void reset_metrics();
 
     nlohmann::json to_json() const;
     static ProviderHealth from_json(const nlohmann::json& j);
 };
 
+/**
+ * @brief Immutable routing view of one provider
+ *
+ * Built from a ProviderHealth when ProviderHealthMonitor publishes a new
+ * ProviderScoreTable, so every field of one score comes from the same
+ * instant. The in-flight counter is the one live value: the snapshot shares
+ * the provider's counter instead of copying it.
+ */
+struct ProviderScore {
+    std::string provider_name_;
+    HealthStatus status_ = HealthStatus::HEALTHY;
+    int capability_flags_ = 0;
+    int64_t ejected_until_ns_ = 0;
+
+    double avg_response_time_ms_ = 0.0;
+    double success_rate_ = 1.0;
+    double performance_score_ = 1.0;
+    double cost_score_ = 1.0;
+    double cost_per_output_token_ = 0.0;
+    int requests_per_minute_ = 0;
+    int max_requests_per_minute_ = 60;
+
+    std::shared_ptr<std::atomic<int64_t>> in_flight_;
+
+    bool is_healthy() const {
+        return status_ == HealthStatus::HEALTHY || status_ == HealthStatus::DEGRADED;
+    }
+    bool can_accept_requests() const;
+    bool has_capability(ProviderCapability capability) const {
+        return (capability_flags_ & static_cast<int>(capability)) != 0;
+    }
+    int64_t in_flight() const { return in_flight_ ? in_flight_->load(std::memory_order_relaxed) : 0; }
+};
+
+/**
+ * @brief Every provider's ProviderScore at one point in time
+ *
+ * Published whole through an atomic shared_ptr; readers hold on to the
+ * version they loaded for as long as they need it.
+ */
+struct ProviderScoreTable {
+    uint64_t version_ = 0;
+    std::unordered_map<std::string, ProviderScore> scores_;
+
+    const ProviderScore* find(const std::string& provider_name) const {
+        auto it = scores_.find(provider_name);
+        return it != scores_.end() ? &it->second : nullptr;
+    }
+};
+
+/**
+ * @brief Counts one request against a provider's in-flight total while alive
+ */
+class InFlightRequest {
+public:
+    InFlightRequest() = default;
+    explicit InFlightRequest(std::shared_ptr<std::atomic<int64_t>> counter) : counter_(std::move(counter)) {
+        if (counter_) {
+            counter_->fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+    ~InFlightRequest() {
+        if (counter_) {
+            counter_->fetch_sub(1, std::memory_order_relaxed);
+        }
+    }
+
+    InFlightRequest(InFlightRequest&& other) noexcept : counter_(std::move(other.counter_)) {}
+    InFlightRequest& operator=(InFlightRequest&& other) noexcept {
+        if (this != &other) {
+            if (counter_) {
+                counter_->fetch_sub(1, std::memory_order_relaxed);
+            }
+            counter_ = std::move(other.counter_);
+        }
+        return *this;
+    }
+    InFlightRequest(const InFlightRequest&) = delete;
+    InFlightRequest& operator=(const InFlightRequest&) = delete;
+
+private:
+    std::shared_ptr<std::atomic<int64_t>> counter_;
+};
+
 /**
  * @brief Health monitoring system for providers
+ *
+ * Combines two signals:
+ * - Active probes: a HealthProbe (typically Bridge::probe_health_async()) runs
+ *   per provider on its own jittered schedule, more often while the provider
+ *   is ejected or recovering. The monitor thread only starts probes and
+ *   records each result from its completion, so a provider that hangs holds
+ *   up neither the other probes nor the outlier sweep. It sleeps until the
+ *   next probe or sweep is due and wakes immediately on stop.
+ * - Passive outlier detection: update_provider_metrics() feeds live traffic
+ *   in; runs of upstream errors eject at once, and evaluate_outliers()
+ *   periodically ejects providers whose latency is far above their peers.
+ *
+ * Without a probe installed only passive detection runs, and ejected
+ * providers return on probation once their ejection expires.
+ *
+ * Routing reads go through get_score_snapshot(), a single atomic load that
+ * never takes a lock or rebuilds anything. Metric updates mark the table
+ * dirty and republish it at most once per score publish interval; an update
+ * arriving inside the interval is published by the monitor thread when the
+ * interval ends (or by the next update after it). Status changes republish
+ * at once.
  */
 class ProviderHealthMonitor {
 public:
     using HealthChangeCallback = std::function<void(const std::string&, HealthStatus, HealthStatus)>;
 
+    /// Outcome of one probe; std::nullopt when there was nothing to probe
+    using ProbeCallback = std::function<void(std::optional<core::Response>)>;
+
+    /// Start probing one provider; calls back exactly once, from any thread
+    using HealthProbe = std::function<void(const std::string& provider_name, ProbeCallback on_complete)>;
+
     ProviderHealthMonitor();
     ~ProviderHealthMonitor();
 
@@ -146,6 +314,12 @@ public:
     void stop_monitoring();
     bool is_monitoring() const { return monitoring_active_.load(); }
 
+    // Lock-free routing view (see ProviderScoreTable)
+    std::shared_ptr<const ProviderScoreTable> get_score_snapshot() const;
+    void publish_scores();
+    void set_score_publish_interval(std::chrono::milliseconds interval);
+    InFlightRequest begin_request(const std::string& provider_name) const;
+
     // Health queries
     std::vector<std::string> get_healthy_providers() const;
     std::vector<std::string> get_providers_with_capability(ProviderCapability capability) const;
@@ -159,6 +333,13 @@ public:
     nlohmann::json get_all_provider_health() const;
     nlohmann::json get_provider_health_json(const std::string& provider_name) const;
 
+    // Active probing and passive outlier detection
+    void set_health_probe(HealthProbe probe);
+    void configure_outlier_detection(const OutlierDetectionConfig& config);
+    OutlierDetectionConfig get_outlier_detection_config() const;
+    void perform_health_check(const std::string& provider_name);
+    void evaluate_outliers();
+
     // Configuration
     void set_health_check_interval(const std::chrono::seconds& interval);
     void set_circuit_breaker_threshold(const std::string& provider_name, int threshold);
@@ -171,19 +352,56 @@ public:
 
 private:
     mutable std::shared_mutex providers_mutex_;
-    std::unordered_map<std::string, std::unique_ptr<ProviderHealth>> providers_;
+    // Shared so a probe in flight keeps its entry alive after remove_provider()
+    std::unordered_map<std::string, std::shared_ptr<ProviderHealth>> providers_;
 
     std::atomic<bool> monitoring_active_{false};
     std::thread monitoring_thread_;
     std::chrono::seconds health_check_interval_{60};
 
+    mutable std::mutex config_mutex_;
+    OutlierDetectionConfig outlier_config_;
+    HealthProbe health_probe_;
+
+    // Probes started but not yet completed; stop_monitoring() waits for them
+    std::mutex probes_mutex_;
+    std::condition_variable probes_done_;
+    size_t probes_in_flight_ = 0;
+
+    // Probe schedule: min-heap on due time, guarded by schedule_mutex_
+    struct ScheduledProbe {
+        std::chrono::steady_clock::time_point due;
+        std::string provider_name;
+
+        bool operator>(const ScheduledProbe& other) const { return due > other.due; }
+    };
+    std::mutex schedule_mutex_;
+    std::condition_variable schedule_cv_;
+    std::vector<ScheduledProbe> probe_queue_;
+    std::mt19937 jitter_rng_{std::random_device{}()};
+
     HealthChangeCallback health_change_callback_;
 
+    // Published routing scores; rebuilt by writers and the monitor thread, never by readers
+    mutable std::atomic<std::shared_ptr<const ProviderScoreTable>> scores_;
+    mutable std::atomic<bool> scores_dirty_{false};
+    mutable std::atomic<int64_t> scores_published_ns_{0};
+    std::atomic<int64_t> score_publish_interval_ns_{50'000'000};
+    mutable std::mutex publish_mutex_;
+    mutable uint64_t scores_version_ = 0;  // Guarded by publish_mutex_
+
     // Internal monitoring
+    void mark_scores_dirty();
+    void refresh_scores_if_stale();
+    void publish_scores_locked() const;
     void monitoring_loop();
-    void perform_health_check(const std::string& provider_name);
-    void perform_periodic_checks();
-    void check_circuit_breakers();
+    void schedule_probe(const std::string& provider_name, std::chrono::milliseconds delay);
+    std::shared_ptr<ProviderHealth> find_provider(const std::string& provider_name) const;
+    void complete_health_check(const std::string& provider_name, ProviderHealth& health,
+                               const std::optional<core::Response>& result);
+    std::chrono::milliseconds next_probe_delay(const ProviderHealth& health);
+    bool ejection_allowed() const;
+    void notify_status_change(const std::string& provider_name, HealthStatus before, HealthStatus after);
 };
 
 // Utility functions
@@ -0,0 +1,148 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+#include <nlohmann/json.hpp>
+#include "aimux/metrics/latency_histogram.hpp"
+
+namespace aimux {
+namespace gateway {
+
+/**
+ * @brief Fixed-size record of one routed request
+ *
+ * The provider is an ID from RequestMetricsStore::intern(), so recording a
+ * request copies no strings.
+ */
+struct MetricRecord {
+    enum Flags : uint8_t {
+        SUCCESS = 1 << 0,
+        FAILOVER = 1 << 1,
+        HEDGED = 1 << 2
+    };
+
+    int64_t start_ns = 0;           // steady_clock ticks since epoch
+    int64_t end_ns = 0;
+    uint32_t duration_us = 0;
+    int32_t request_tokens = 0;
+    int32_t response_tokens = 0;
+    float cost_usd = 0.0f;
+    int16_t http_status = 0;
+    uint16_t provider_id = 0;
+    uint8_t request_type = 0;       // RequestType
+    uint8_t flags = 0;
+};
+
+static_assert(std::is_trivially_copyable_v<MetricRecord>, "MetricRecord is copied through a seqlock");
+
+/**
+ * @brief Lock-free store of recent request records plus running aggregates
+ *
+ * Writers append to one of several ring buffers (threads are spread across
+ * shards round-robin) by claiming a slot with one fetch_add and publishing
+ * it through a per-slot sequence number, so concurrent writers never block
+ * each other or readers. Records are stored as relaxed atomic words, so a
+ * reader overlapping a writer copies a torn record that its sequence check
+ * then discards. A writer that laps a slot still being written (or already
+ * holding a newer record) drops its record from the ring; the aggregates
+ * still count it. Alongside the rings, per-provider counters and a
+ * LatencyHistogram are updated on every record(), which makes summary reads
+ * O(providers) no matter how much history the rings hold.
+ *
+ * Up to MAX_PROVIDERS - 1 distinct provider names are tracked separately;
+ * any further names share ID 0 ("other").
+ *
+ * @since v2.0.0
+ */
+class RequestMetricsStore {
+public:
+    static constexpr size_t MAX_PROVIDERS = 64;
+    static constexpr uint16_t OTHER_PROVIDER = 0;
+
+    /**
+     * @param capacity Records kept across all shards (split evenly)
+     * @param shards Ring count; 0 picks one per hardware thread (at least 4)
+     */
+    explicit RequestMetricsStore(size_t capacity = 10000, size_t shards = 0);
+    ~RequestMetricsStore();
+
+    RequestMetricsStore(const RequestMetricsStore&) = delete;
+    RequestMetricsStore& operator=(const RequestMetricsStore&) = delete;
+
+    /// Stable ID for a provider name; lock-free once the name is known
+    uint16_t intern(std::string_view provider_name);
+
+    std::string provider_name(uint16_t id) const;
+
+    void record(const MetricRecord& record);
+
+    /// Up to @p count most recent records, oldest first
+    std::vector<MetricRecord> recent(size_t count) const;
+
+    uint64_t total_requests() const;
+    uint64_t successful_requests() const;
+    const metrics::LatencyHistogram& latency() const;
+
+    /// Per-provider counters and latency percentiles (milliseconds)
+    nlohmann::json providers_to_json() const;
+
+    /// Drop history and reset aggregates (concurrent records may survive)
+    void clear();
+
+    size_t capacity() const { return shard_capacity_ * shard_count_; }
+    size_t shard_count() const { return shard_count_; }
+
+private:
+    struct Aggregate {
+        std::atomic<uint64_t> requests{0};
+        std::atomic<uint64_t> successes{0};
+        std::atomic<uint64_t> failovers{0};
+        std::atomic<uint64_t> hedged{0};
+        std::atomic<uint64_t> request_tokens{0};
+        std::atomic<uint64_t> response_tokens{0};
+        std::atomic<uint64_t> cost_micro_usd{0};
+        metrics::LatencyHistogram latency;
+
+        void add(const MetricRecord& record);
+        void reset();
+        nlohmann::json to_json() const;
+    };
+
+    static constexpr size_t RECORD_WORDS = (sizeof(MetricRecord) + sizeof(uint64_t) - 1) / sizeof(uint64_t);
+
+    struct Slot {
+        std::atomic<uint64_t> sequence{0};  // 0 empty, 2 * index + 1 while written, 2 * (index + 1) when published
+        std::array<std::atomic<uint64_t>, RECORD_WORDS> words{};   // MetricRecord bytes
+    };
+
+    struct alignas(64) Shard {
+        std::atomic<uint64_t> head{0};
+        std::unique_ptr<Slot[]> slots;
+    };
+
+    Shard& shard_for_this_thread();
+
+    size_t shard_count_;
+    size_t shard_capacity_;
+    std::unique_ptr<Shard[]> shards_;
+
+    // Names are published once and never move (deque storage)
+    std::array<std::atomic<const std::string*>, MAX_PROVIDERS> provider_names_{};
+    std::atomic<size_t> provider_count_{1};
+    std::mutex intern_mutex_;
+    std::deque<std::string> provider_storage_;
+
+    std::unique_ptr<Aggregate[]> providers_;
+    Aggregate totals_;
+};
+
+} // namespace gateway
+} // namespace aimux
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <atomic>
 #include <string>
 #include <vector>
 #include <memory>
@@ -8,6 +9,7 @@
 #include <nlohmann/json.hpp>
 #include "aimux/core/router.hpp"
 #include "aimux/gateway/provider_health.hpp"
+#include "aimux/gateway/keyword_matcher.hpp"
 
 namespace aimux {
 namespace gateway {
@@ -48,6 +50,7 @@ struct RequestAnalysis {
     bool requires_tools_ = false;
     bool requires_json_mode_ = false;
     bool requires_function_calling_ = false;
+    size_t content_length_ = 0;             // Characters of prompt text scanned
     double cost_sensitivity_ = 0.5;        // 0.0 = cost insensitive, 1.0 = cost sensitive
     double latency_sensitivity_ = 0.5;      // 0.0 = latency insensitive, 1.0 = latency sensitive
 
@@ -85,6 +88,20 @@ public:
         RequestType request_type = RequestType::STANDARD
     ) const = 0;
 
+    /**
+     * @brief Select a provider against a score table the caller already loaded
+     *
+     * RoutingLogic passes the snapshot it routes the whole request with.
+     * Balancers that ignore scores need not override this.
+     */
+    virtual std::string select_provider(
+        const std::vector<std::string>& providers,
+        RequestType request_type,
+        const ProviderScoreTable& /*scores*/
+    ) const {
+        return select_provider(providers, request_type);
+    }
+
     /**
      * @brief Get load balancing strategy name
      */
@@ -96,6 +113,7 @@ public:
  */
 class RoundRobinBalancer : public LoadBalancer {
 public:
+    using LoadBalancer::select_provider;
     std::string select_provider(
         const std::vector<std::string>& providers,
         RequestType request_type = RequestType::STANDARD
@@ -117,13 +135,18 @@ public:
         const std::vector<std::string>& providers,
         RequestType request_type = RequestType::STANDARD
     ) const override;
+    std::string select_provider(
+        const std::vector<std::string>& providers,
+        RequestType request_type,
+        const ProviderScoreTable& scores
+    ) const override;
     std::string get_strategy_name() const override { return "Weighted"; }
 
 private:
     ProviderHealthMonitor* health_monitor_;
 
-    double calculate_weight(const std::string& provider, RequestType request_type) const;
-    bool provider_is_suitable(const std::string& provider, RequestType request_type) const;
+    double calculate_weight(const ProviderScore& score, RequestType request_type) const;
+    bool provider_is_suitable(const ProviderScore& score, RequestType request_type) const;
 };
 
 /**
@@ -137,6 +160,11 @@ public:
         const std::vector<std::string>& providers,
         RequestType request_type = RequestType::STANDARD
     ) const override;
+    std::string select_provider(
+        const std::vector<std::string>& providers,
+        RequestType request_type,
+        const ProviderScoreTable& scores
+    ) const override;
     std::string get_strategy_name() const override { return "LeastConnections"; }
 
 private:
@@ -154,6 +182,11 @@ using CustomPriorityFunction = std::function<std::string(
 
 /**
  * @brief Intelligent routing logic with multiple strategies
+ *
+ * route_request() loads the health monitor's score snapshot once and every
+ * filter, selector and balancer it calls reads that same table, so one
+ * routing decision is made against one consistent view. The public
+ * selectors and filters load their own snapshot when called directly.
  */
 class RoutingLogic {
 public:
@@ -166,6 +199,18 @@ public:
         RoutingPriority priority = RoutingPriority::BALANCED
     );
 
+    /**
+     * @brief Route using an analysis the caller already computed
+     *
+     * Lets callers that need the analysis themselves (metrics, caching)
+     * avoid classifying the same request twice.
+     */
+    RoutingDecision route_request(
+        const core::Request& request,
+        const RequestAnalysis& analysis,
+        RoutingPriority priority = RoutingPriority::BALANCED
+    );
+
     // Provider selection strategies
     std::string select_by_cost(const std::vector<std::string>& providers);
     std::string select_by_performance(const std::vector<std::string>& providers);
@@ -182,7 +227,7 @@ public:
         RequestType request_type = RequestType::STANDARD
     );
 
-    // Request analysis
+    // Request analysis (single pass over the request JSON, no copies)
     RequestAnalysis analyze_request(const core::Request& request);
     bool is_thinking_request(const std::string& content);
     bool has_vision_content(const nlohmann::json& content);
@@ -231,6 +276,10 @@ private:
         "screenshot", "graph", "figure", "drawing", "illustration"
     };
 
+    // Keyword automaton compiled from the lists above; swapped atomically on reconfiguration
+    std::atomic<std::shared_ptr<const KeywordMatcher>> classifier_;
+    void rebuild_classifier();
+
     // Routing metrics
     mutable std::shared_mutex metrics_mutex_;
     std::unordered_map<std::string, int> provider_selection_counts_;
@@ -238,15 +287,30 @@ private:
     std::unordered_map<RoutingPriority, int> priority_usage_counts_;
     std::atomic<int> total_routings_{0};
 
+    // Selection and filtering against an already loaded score table
+    std::string select_by_cost(const std::vector<std::string>& providers, const ProviderScoreTable& scores);
+    std::string select_by_performance(const std::vector<std::string>& providers, const ProviderScoreTable& scores);
+    std::string select_by_reliability(const std::vector<std::string>& providers, const ProviderScoreTable& scores);
+    std::string select_balanced(const std::vector<std::string>& providers, const RequestAnalysis& analysis,
+                                const ProviderScoreTable& scores);
+    std::vector<std::string> filter_by_capability(const std::vector<std::string>& providers,
+                                                  ProviderCapability capability,
+                                                  const ProviderScoreTable& scores);
+    std::vector<std::string> filter_by_request_type(const std::vector<std::string>& providers,
+                                                    RequestType request_type,
+                                                    const ProviderScoreTable& scores);
+
     // Internal helper functions
     ProviderCapability get_required_capabilities(const RequestAnalysis& analysis);
     std::vector<std::string> get_capable_providers(ProviderCapability capabilities);
     double calculate_provider_score(const std::string& provider,
                                   ProviderCapability capabilities,
-                                  RoutingPriority priority);
+                                  RoutingPriority priority,
+                                  const ProviderScoreTable& scores);
     std::string generate_reasoning(const RoutingDecision& decision,
                                  const RequestAnalysis& analysis,
-                                 const std::vector<std::string>& candidates);
+                                 const std::vector<std::string>& candidates,
+                                 const ProviderScoreTable& scores);
 };
 
 // Utility functions
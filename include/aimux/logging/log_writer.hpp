@@ -0,0 +1,134 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <nlohmann/json.hpp>
+
+namespace aimux {
+namespace logging {
+
+enum class LogLevel;
+
+/**
+ * @brief Immutable description of where and how a logger's entries are written
+ *
+ * Loggers publish a new target whenever their settings change; records keep
+ * the target they were logged with alive until the writer has formatted them.
+ *
+ * @since v2.0.0
+ */
+struct LogTarget {
+    std::string logger_name;
+    nlohmann::json default_fields = nlohmann::json::object();
+    bool console = true;
+    std::string log_file;   // Empty: no file output
+};
+
+/**
+ * @brief One log call, formatted later on the writer thread
+ *
+ * @since v2.0.0
+ */
+struct LogRecord {
+    std::shared_ptr<const LogTarget> target;
+    LogLevel level{};
+    std::chrono::system_clock::time_point time;
+    std::string message;
+    nlohmann::json data;
+};
+
+/**
+ * @brief Counters reported by LogWriter::get_stats()
+ */
+struct LogWriterStats {
+    uint64_t records_submitted = 0;
+    uint64_t records_written = 0;
+    uint64_t records_dropped = 0;   // Ring was full
+    uint64_t batches = 0;
+    uint64_t write_calls = 0;       // writev() system calls
+    uint64_t write_errors = 0;
+    uint64_t rotations = 0;
+
+    nlohmann::json to_json() const;
+};
+
+/**
+ * @brief Background writer behind Logger: a lock-free ring drained by one thread
+ *
+ * Logging threads format nothing and make no system calls: submit() moves
+ * the record into a bounded multi-producer ring and returns. When the ring
+ * is full the record is dropped and counted, so a stalled disk or terminal
+ * never blocks request handling.
+ *
+ * The writer thread drains the ring in batches, renders each record as one
+ * JSON line and writes the batch with a single writev() per destination.
+ * Log files stay open between batches and are rotated once they exceed
+ * max_file_bytes (file -> file.1 -> ... -> file.<max_files>). A file that
+ * is moved or deleted externally is reopened on the next batch.
+ *
+ * The process-wide instance() is never destroyed; it is drained at exit.
+ * Records submitted after that are written synchronously.
+ *
+ * All methods are thread-safe.
+ *
+ * @since v2.0.0
+ */
+class LogWriter {
+public:
+    struct Options {
+        size_t ring_capacity = 8192;                         // Rounded up to a power of two
+        size_t max_batch = 256;                              // Records per writev round
+        std::chrono::milliseconds idle_wait{100};            // Writer sleep when the ring is empty
+        uint64_t max_file_bytes = 10 * 1024 * 1024;          // Rotate above this size (0: never)
+        unsigned max_files = 5;                              // Rotated files kept
+    };
+
+    /**
+     * @brief Process-wide writer used by Logger
+     */
+    static LogWriter& instance();
+
+    explicit LogWriter(const Options& options);
+    ~LogWriter();
+
+    LogWriter(const LogWriter&) = delete;
+    LogWriter& operator=(const LogWriter&) = delete;
+
+    /**
+     * @brief Queue a record for writing
+     * @return false if the ring was full and the record was dropped
+     */
+    bool submit(LogRecord&& record);
+
+    /**
+     * @brief Wait until everything submitted so far has been written
+     * @param timeout Maximum time to wait
+     * @return true if the ring was drained in time
+     */
+    bool flush(std::chrono::milliseconds timeout = std::chrono::seconds(5));
+
+    /**
+     * @brief Drain the ring and stop the writer thread; later records are written synchronously
+     */
+    void stop();
+
+    /**
+     * @brief Render @p record as the JSON line Logger emits (with trailing newline)
+     */
+    static void format(const LogRecord& record, std::string& out);
+
+    LogWriterStats get_stats() const;
+
+private:
+    struct Impl;
+    std::unique_ptr<Impl> pImpl;
+};
+
+} // namespace logging
+} // namespace aimux
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <atomic>
 #include <string>
 #include <memory>
 #include <fstream>
@@ -25,6 +26,12 @@ enum class LogLevel {
 
 /**
  * @brief Logger class for structured JSON logging
+ *
+ * Entries are handed to LogWriter::instance() and written by its background
+ * thread, so a log call costs a level check and a ring push; nothing is
+ * formatted or written on the calling thread. FATAL entries are flushed
+ * before log() returns. Use the AIMUX_LOG_* macros on hot paths so that
+ * messages for filtered levels are never built.
  */
 class Logger {
 public:
@@ -45,6 +52,15 @@ public:
      * @param level Minimum level to log
      */
     void set_level(LogLevel level);
+
+    /**
+     * @brief Whether entries at @p level pass the level filter
+     * @param level Level to check
+     * @return true if log() would emit an entry at this level
+     */
+    bool should_log(LogLevel level) const noexcept {
+        return level >= level_.load(std::memory_order_relaxed);
+    }
     
     /**
      * @brief Enable/disable console output
@@ -90,26 +106,14 @@ public:
     nlohmann::json get_statistics() const;
     
     /**
-     * @brief Flush all pending log entries
+     * @brief Wait until all entries logged so far have been written
      */
     void flush();
 
 private:
     struct Impl;
     std::unique_ptr<Impl> pImpl;
-    
-    /**
-     * @brief Convert log level to string
-     * @param level Log level
-     * @return String representation
-     */
-    std::string level_to_string(LogLevel level) const;
-    
-    /**
-     * @brief Get current timestamp as ISO string
-     * @return ISO timestamp
-     */
-    std::string get_timestamp() const;
+    std::atomic<LogLevel> level_{LogLevel::INFO};
 };
 
 /**
@@ -202,6 +206,11 @@ public:
     static std::string get_current_timestamp();
 };
 
+/**
+ * @brief Logger behind the global convenience functions ("aimux_default")
+ */
+Logger& default_logger();
+
 // Global convenience functions
 void debug(const std::string& message, const nlohmann::json& data = nlohmann::json{});
 void info(const std::string& message, const nlohmann::json& data = nlohmann::json{});
@@ -223,3 +232,34 @@ void fatal(const std::string& message, const nlohmann::json& data = nlohmann::js
 void trace(const std::string& message, const nlohmann::json& data = nlohmann::json{});
 } // namespace aimux
 
+/**
+ * Level-gated logging macros. Arguments are evaluated only when the entry
+ * passes both the compile-time floor AIMUX_LOG_MIN_LEVEL (0 = TRACE ...
+ * 5 = FATAL) and the logger's runtime level:
+ *
+ *   AIMUX_LOG_DEBUG(*logger, "Routed to " + provider, {{"ms", duration}});
+ *   AIMUX_LOG_DEBUG(aimux::logging::default_logger(), "Cache miss for " + key);
+ */
+#ifndef AIMUX_LOG_MIN_LEVEL
+#define AIMUX_LOG_MIN_LEVEL 0
+#endif
+
+#define AIMUX_LOG_ENABLED(logger, level) \
+    (static_cast<int>(level) >= AIMUX_LOG_MIN_LEVEL && (logger).should_log(level))
+
+#define AIMUX_LOG(logger, level, ...) \
+    do { \
+        if (static_cast<int>(level) >= AIMUX_LOG_MIN_LEVEL) { \
+            auto& aimux_log_logger_ = (logger); \
+            if (aimux_log_logger_.should_log(level)) { \
+                aimux_log_logger_.log(level, __VA_ARGS__); \
+            } \
+        } \
+    } while (0)
+
+#define AIMUX_LOG_TRACE(logger, ...) AIMUX_LOG(logger, ::aimux::logging::LogLevel::TRACE, __VA_ARGS__)
+#define AIMUX_LOG_DEBUG(logger, ...) AIMUX_LOG(logger, ::aimux::logging::LogLevel::DEBUG, __VA_ARGS__)
+#define AIMUX_LOG_INFO(logger, ...) AIMUX_LOG(logger, ::aimux::logging::LogLevel::INFO, __VA_ARGS__)
+#define AIMUX_LOG_WARN(logger, ...) AIMUX_LOG(logger, ::aimux::logging::LogLevel::WARN, __VA_ARGS__)
+#define AIMUX_LOG_ERROR(logger, ...) AIMUX_LOG(logger, ::aimux::logging::LogLevel::ERROR, __VA_ARGS__)
+#define AIMUX_LOG_FATAL(logger, ...) AIMUX_LOG(logger, ::aimux::logging::LogLevel::FATAL, __VA_ARGS__)
@@ -0,0 +1,198 @@
+#pragma once
+
+#include "aimux/metrics/time_series_db.hpp"
+#include <chrono>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <shared_mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace aimux {
+namespace metrics {
+
+/**
+ * @brief Statistics for one time window (and tag group) returned by
+ *        ColumnarTimeSeriesDB::query_windows()
+ *
+ * @since v2.0.0
+ */
+struct WindowStatistics {
+    std::chrono::system_clock::time_point start;
+    std::unordered_map<std::string, std::string> group;   // Values of the group_by tags
+    MetricStatistics stats;
+
+    nlohmann::json to_json() const;
+};
+
+/**
+ * @brief Embedded single-node TimeSeriesDB backed by local column files
+ *
+ * Every MetricPoint is split into one column per value: "value" plus one
+ * per entry in fields. A series is a (measurement, column, tag set) triple;
+ * its points are Gorilla-compressed (delta-of-delta timestamps, XOR values)
+ * into blocks of up to TSDBConfig::max_block_points.
+ *
+ * Blocks live in append-only files, one per database and partition_duration
+ * window, named raw-<start>.tsdb. Files are memory-mapped for reading and
+ * grow only by appending whole blocks, so a crash can at worst leave a torn
+ * last block, which connect() detects by checksum and truncates. Points not
+ * yet in a full block stay in an in-memory head block until flush(),
+ * disconnect() or the block filling up.
+ *
+ * Every block header carries count/sum/sum of squares/min/max/time bounds,
+ * so aggregations over blocks that lie entirely inside the query range read
+ * only headers. Blocks straddling the range edges are decoded into flat
+ * arrays and folded with a branch-free masked loop.
+ *
+ * run_maintenance() (also triggered from writes once per rollup_interval):
+ *  - rolls raw partitions older than raw_retention into rollup-<start>.tsdb,
+ *    keeping exact count/sum/min/max per rollup_interval and series, then
+ *    deletes the raw file;
+ *  - deletes partitions of either kind that ended before the active
+ *    retention (TSDBConfig::retention or the default retention policy).
+ *
+ * Percentiles over rolled-up data are computed from the per-interval means
+ * and are therefore approximate. Events are stored as the
+ * "prettification_events" measurement; capabilities_used and metadata are
+ * not persisted. Continuous queries are not supported.
+ *
+ * All methods are thread-safe. Writes take an exclusive lock; queries share.
+ *
+ * @since v2.0.0
+ */
+class ColumnarTimeSeriesDB : public TimeSeriesDB {
+public:
+    static constexpr const char* EVENTS_MEASUREMENT = "prettification_events";
+
+    explicit ColumnarTimeSeriesDB(const TSDBConfig& config);
+    ~ColumnarTimeSeriesDB() override;
+
+    ColumnarTimeSeriesDB(const ColumnarTimeSeriesDB&) = delete;
+    ColumnarTimeSeriesDB& operator=(const ColumnarTimeSeriesDB&) = delete;
+
+    bool connect() override;
+    bool disconnect() override;
+    bool is_connected() const override;
+    bool ping() override;
+
+    /// Databases are subdirectories of TSDBConfig::data_directory
+    bool create_database(const std::string& name) override;
+    bool drop_database(const std::string& name) override;
+    std::vector<std::string> list_databases() override;
+
+    bool write_metrics(const std::vector<MetricPoint>& metrics) override;
+    bool write_events(const std::vector<PrettificationEvent>& events) override;
+
+    /**
+     * @brief Stored points in time order (newest first with order_by(..., "desc"))
+     *
+     * Columns of the same tag set and timestamp are joined back into one
+     * point. Rolled-up data is returned as one point per rollup interval
+     * holding the interval mean.
+     */
+    std::vector<MetricPoint> query_metrics(const TSDBQueryBuilder& query) override;
+    std::vector<PrettificationEvent> query_events(const TSDBQueryBuilder& query) override;
+
+    /**
+     * @brief One MetricStatistics per queried column and group_by tag group
+     *
+     * Queries the "value" column unless fields are given. Percentiles
+     * ("median", "p95", "p99") are only computed when requested, since they
+     * need every block decoded.
+     */
+    std::vector<MetricStatistics> query_aggregations(
+        const TSDBQueryBuilder& query,
+        const std::vector<std::string>& aggregations = {"mean", "count"}) override;
+
+    /**
+     * @brief Like query_aggregations() but bucketed into @p window wide windows
+     *
+     * Windows are aligned to multiples of @p window since the epoch and
+     * only windows holding data are returned, oldest first.
+     */
+    std::vector<WindowStatistics> query_windows(const TSDBQueryBuilder& query,
+                                                std::chrono::milliseconds window,
+                                                bool percentiles = false);
+
+    bool create_retention_policy(
+        const std::string& name,
+        const std::chrono::hours& duration,
+        int replication_factor = 1,
+        bool default_policy = false) override;
+    bool drop_retention_policy(const std::string& name) override;
+    std::vector<std::string> list_retention_policies() override;
+
+    bool create_continuous_query(const std::string& name, const std::string& query) override;
+    bool drop_continuous_query(const std::string& name) override;
+    std::vector<std::string> list_continuous_queries() override;
+
+    nlohmann::json get_status() const override;
+    double get_query_performance_ms() const override;
+
+    /// Write every in-memory head block to disk
+    bool flush();
+
+    /// Seal finished partitions, roll up old raw data and apply retention as of @p now
+    void run_maintenance(std::chrono::system_clock::time_point now = std::chrono::system_clock::now());
+
+protected:
+    bool write_metrics_sync(const std::vector<MetricPoint>& metrics) override;
+    bool write_events_sync(const std::vector<PrettificationEvent>& events) override;
+
+private:
+    struct Series;
+    struct BlockHeader;
+    struct BlockRef;
+    struct Partition;
+    struct HeadBlock;
+    struct Accumulator;
+    struct ScanPlan;
+
+    using HeadKey = std::pair<int64_t, uint32_t>;   // (partition start, series id)
+
+    // All *_locked methods expect state_mutex_ to be held (exclusively for mutators)
+    std::string database_path() const;
+    bool open_locked();
+    void close_locked();
+    bool load_partition_locked(const std::string& path, int64_t start_us, bool rollup);
+    uint32_t intern_series_locked(const std::string& measurement, const std::string& column,
+                                  const std::unordered_map<std::string, std::string>& tags,
+                                  MetricType type);
+    void append_locked(uint32_t series_id, int64_t timestamp_us, double value);
+    bool seal_locked(const HeadKey& key, HeadBlock& head);
+    bool seal_partition_heads_locked(int64_t partition_start);
+    Partition& partition_locked(int64_t start_us, bool rollup);
+    bool append_block_locked(Partition& partition, const BlockHeader& header,
+                             uint32_t series_id, const std::vector<uint8_t>& payload);
+    bool rollup_partition_locked(int64_t partition_start);
+    void drop_partition_locked(int64_t partition_start, bool rollup);
+    int64_t active_retention_us_locked() const;
+
+    ScanPlan plan_scan_locked(const TSDBQueryBuilder& query, const std::vector<std::string>& columns) const;
+    // Keyed by (window start, plan slot)
+    std::map<std::pair<int64_t, uint32_t>, Accumulator> aggregate_locked(
+        const ScanPlan& plan, int64_t window_us, bool percentiles) const;
+    void record_query_time(std::chrono::steady_clock::time_point started) const;
+    void maybe_run_maintenance();
+
+    mutable std::shared_mutex state_mutex_;
+    std::vector<Series> series_;
+    std::unordered_map<std::string, uint32_t> series_ids_;
+    std::map<int64_t, std::unique_ptr<Partition>> raw_partitions_;
+    std::map<int64_t, std::unique_ptr<Partition>> rollup_partitions_;
+    std::map<HeadKey, std::unique_ptr<HeadBlock>> heads_;
+    size_t buffered_points_ = 0;
+
+    std::map<std::string, std::chrono::hours> retention_policies_;
+    std::string default_retention_policy_;
+
+    std::atomic<int64_t> next_maintenance_us_{0};
+    std::atomic<bool> maintenance_running_{false};
+    mutable std::atomic<double> last_query_time_ms_{0.0};
+};
+
+} // namespace metrics
+} // namespace aimux
@@ -0,0 +1,276 @@
+#pragma once
+
+#include <bit>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+namespace aimux {
+namespace metrics {
+
+/**
+ * @brief Append-only bit stream, most significant bit first
+ */
+class BitWriter {
+public:
+    /// Append the low @p bits bits of @p value (bits <= 64)
+    void write_bits(uint64_t value, unsigned bits) {
+        while (bits > 0) {
+            unsigned used = static_cast<unsigned>(bit_size_ % 8);
+            if (used == 0) {
+                bytes_.push_back(0);
+            }
+            unsigned room = 8 - used;
+            unsigned take = bits < room ? bits : room;
+            uint64_t chunk = (value >> (bits - take)) & ((1ull << take) - 1);
+            bytes_.back() |= static_cast<uint8_t>(chunk << (room - take));
+            bit_size_ += take;
+            bits -= take;
+        }
+    }
+
+    void write_bit(bool bit) { write_bits(bit ? 1 : 0, 1); }
+
+    const std::vector<uint8_t>& bytes() const { return bytes_; }
+    size_t bit_size() const { return bit_size_; }
+
+private:
+    std::vector<uint8_t> bytes_;
+    size_t bit_size_ = 0;
+};
+
+/**
+ * @brief Reader for BitWriter streams; reads past the end yield zeros and clear ok()
+ */
+class BitReader {
+public:
+    BitReader(const uint8_t* data, size_t byte_size) : data_(data), bit_size_(byte_size * 8) {}
+
+    uint64_t read_bits(unsigned bits) {
+        if (bits == 0) {
+            return 0;
+        }
+        if (position_ + bits > bit_size_) {
+            ok_ = false;
+            position_ = bit_size_;
+            return 0;
+        }
+        uint64_t value = 0;
+        while (bits > 0) {
+            unsigned offset = static_cast<unsigned>(position_ % 8);
+            unsigned room = 8 - offset;
+            unsigned take = bits < room ? bits : room;
+            uint64_t byte = data_[position_ / 8];
+            uint64_t chunk = (byte >> (room - take)) & ((1ull << take) - 1);
+            value = (value << take) | chunk;
+            position_ += take;
+            bits -= take;
+        }
+        return value;
+    }
+
+    bool read_bit() { return read_bits(1) != 0; }
+    bool ok() const { return ok_; }
+
+private:
+    const uint8_t* data_;
+    size_t bit_size_;
+    size_t position_ = 0;
+    bool ok_ = true;
+};
+
+/**
+ * @brief Gorilla-style compressor for (timestamp, value) pairs
+ *
+ * Timestamps are stored as delta-of-delta in variable-width buckets, so a
+ * regular sampling interval costs one bit per point. Values are XORed with
+ * their predecessor and only the meaningful bits are written, reusing the
+ * previous leading/trailing-zero window when the new bits fit in it. Slowly
+ * changing gauges and latencies typically compress to a few bits per value.
+ *
+ * Timestamps are signed integers in any unit; out-of-order points are
+ * allowed and simply cost more bits.
+ *
+ * @since v2.0.0
+ */
+class GorillaEncoder {
+public:
+    void append(int64_t timestamp, double value) {
+        uint64_t bits = std::bit_cast<uint64_t>(value);
+
+        if (count_ == 0) {
+            out_.write_bits(static_cast<uint64_t>(timestamp), 64);
+            out_.write_bits(bits, 64);
+        } else {
+            int64_t delta = timestamp - previous_timestamp_;
+            write_delta_of_delta(delta - previous_delta_);
+            previous_delta_ = delta;
+            write_value(bits);
+        }
+
+        previous_timestamp_ = timestamp;
+        previous_bits_ = bits;
+        count_++;
+    }
+
+    size_t count() const { return count_; }
+    const std::vector<uint8_t>& bytes() const { return out_.bytes(); }
+
+private:
+    // Prefix '0', '10', '110', '1110', '11110', '11111' for 0, 7, 9, 12, 32 and 64 bits
+    void write_delta_of_delta(int64_t dod) {
+        if (dod == 0) {
+            out_.write_bit(false);
+            return;
+        }
+        static constexpr struct { unsigned prefix; unsigned prefix_bits; unsigned bits; } BUCKETS[] = {
+            {0b10, 2, 7}, {0b110, 3, 9}, {0b1110, 4, 12}, {0b11110, 5, 32}
+        };
+        for (const auto& bucket : BUCKETS) {
+            int64_t limit = int64_t{1} << (bucket.bits - 1);
+            if (dod >= -limit && dod < limit) {
+                out_.write_bits(bucket.prefix, bucket.prefix_bits);
+                out_.write_bits(static_cast<uint64_t>(dod), bucket.bits);
+                return;
+            }
+        }
+        out_.write_bits(0b11111, 5);
+        out_.write_bits(static_cast<uint64_t>(dod), 64);
+    }
+
+    void write_value(uint64_t bits) {
+        uint64_t x = bits ^ previous_bits_;
+        if (x == 0) {
+            out_.write_bit(false);
+            return;
+        }
+        out_.write_bit(true);
+
+        unsigned leading = static_cast<unsigned>(std::countl_zero(x));
+        unsigned trailing = static_cast<unsigned>(std::countr_zero(x));
+        if (leading > 31) {
+            leading = 31;   // Five bits on the wire
+        }
+
+        if (window_valid_ && leading >= previous_leading_ && trailing >= previous_trailing_) {
+            out_.write_bit(false);
+            out_.write_bits(x >> previous_trailing_, 64 - previous_leading_ - previous_trailing_);
+            return;
+        }
+
+        unsigned significant = 64 - leading - trailing;
+        out_.write_bit(true);
+        out_.write_bits(leading, 5);
+        out_.write_bits(significant - 1, 6);
+        out_.write_bits(x >> trailing, significant);
+        previous_leading_ = leading;
+        previous_trailing_ = trailing;
+        window_valid_ = true;
+    }
+
+    BitWriter out_;
+    size_t count_ = 0;
+    int64_t previous_timestamp_ = 0;
+    int64_t previous_delta_ = 0;
+    uint64_t previous_bits_ = 0;
+    unsigned previous_leading_ = 0;
+    unsigned previous_trailing_ = 0;
+    bool window_valid_ = false;
+};
+
+/**
+ * @brief Decoder for GorillaEncoder streams
+ *
+ * The stream does not record its length in points; callers pass the count
+ * they stored alongside it.
+ */
+class GorillaDecoder {
+public:
+    GorillaDecoder(const uint8_t* data, size_t byte_size, size_t count)
+        : in_(data, byte_size), remaining_(count) {}
+
+    /// Next point, or false when @p count points were read or the stream is corrupt
+    bool next(int64_t& timestamp, double& value) {
+        if (remaining_ == 0 || !in_.ok()) {
+            return false;
+        }
+
+        if (first_) {
+            previous_timestamp_ = static_cast<int64_t>(in_.read_bits(64));
+            previous_bits_ = in_.read_bits(64);
+            first_ = false;
+        } else {
+            previous_delta_ += read_delta_of_delta();
+            previous_timestamp_ += previous_delta_;
+            read_value();
+        }
+
+        if (!in_.ok()) {
+            return false;
+        }
+        remaining_--;
+        timestamp = previous_timestamp_;
+        value = std::bit_cast<double>(previous_bits_);
+        return true;
+    }
+
+    /// Decode everything into parallel arrays; returns false on corruption
+    bool decode_all(std::vector<int64_t>& timestamps, std::vector<double>& values) {
+        timestamps.clear();
+        values.clear();
+        timestamps.reserve(remaining_);
+        values.reserve(remaining_);
+        int64_t timestamp;
+        double value;
+        while (next(timestamp, value)) {
+            timestamps.push_back(timestamp);
+            values.push_back(value);
+        }
+        return remaining_ == 0;
+    }
+
+private:
+    static int64_t sign_extend(uint64_t raw, unsigned bits) {
+        if (bits == 64) {
+            return static_cast<int64_t>(raw);
+        }
+        uint64_t sign = 1ull << (bits - 1);
+        return static_cast<int64_t>((raw ^ sign) - sign);
+    }
+
+    int64_t read_delta_of_delta() {
+        // Indexed by the number of leading '1' prefix bits
+        static constexpr unsigned WIDTHS[] = {0, 7, 9, 12, 32, 64};
+        unsigned ones = 0;
+        while (ones < 5 && in_.read_bit()) {
+            ones++;
+        }
+        unsigned width = WIDTHS[ones];
+        return width == 0 ? 0 : sign_extend(in_.read_bits(width), width);
+    }
+
+    void read_value() {
+        if (!in_.read_bit()) {
+            return;   // Same value
+        }
+        if (in_.read_bit()) {
+            leading_ = static_cast<unsigned>(in_.read_bits(5));
+            unsigned significant = static_cast<unsigned>(in_.read_bits(6)) + 1;
+            trailing_ = 64 - leading_ - significant;
+        }
+        unsigned significant = 64 - leading_ - trailing_;
+        previous_bits_ ^= in_.read_bits(significant) << trailing_;
+    }
+
+    BitReader in_;
+    size_t remaining_;
+    bool first_ = true;
+    int64_t previous_timestamp_ = 0;
+    int64_t previous_delta_ = 0;
+    uint64_t previous_bits_ = 0;
+    unsigned leading_ = 0;
+    unsigned trailing_ = 0;
+};
+
+} // namespace metrics
+} // namespace aimux
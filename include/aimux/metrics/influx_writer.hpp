@@ -0,0 +1,176 @@
+#pragma once
+
+#include "aimux/metrics/metrics_collector.hpp"
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <utility>
+#include <vector>
+#include <nlohmann/json.hpp>
+
+namespace aimux {
+namespace metrics {
+
+struct TSDBConfig;
+
+/**
+ * @brief Appends InfluxDB line protocol to a caller-owned buffer
+ *
+ * Numbers are written with std::to_chars and strings are escaped in place,
+ * so encoding allocates nothing beyond growth of the target buffer; a buffer
+ * that is cleared and reused between batches settles at a steady capacity.
+ *
+ * Tags are written sorted by key (as InfluxDB recommends) and tags with an
+ * empty value are skipped. Non-finite field values are skipped too; a point
+ * left without any field is not written at all. Numeric fields are written
+ * as floats, matching the schema earlier releases produced.
+ *
+ * Not thread-safe; each writer keeps its own encoder.
+ *
+ * @since v2.0.0
+ */
+class LineProtocolEncoder {
+public:
+    /// Append one line for @p point; returns false (and appends nothing) if it has no valid field
+    bool append(std::string& out, const MetricPoint& point);
+
+    /// Append one "prettification_events" line for @p event
+    bool append(std::string& out, const PrettificationEvent& event);
+
+private:
+    std::vector<std::pair<std::string_view, std::string_view>> tags_;   // Reused sort scratch
+};
+
+/**
+ * @brief Counters reported by InfluxWriteBatcher::get_stats()
+ */
+struct InfluxWriteStats {
+    uint64_t lines_accepted = 0;
+    uint64_t lines_sent = 0;
+    uint64_t lines_dropped = 0;      // Evicted by back-pressure or failed after retries
+    uint64_t batches_sent = 0;
+    uint64_t batches_failed = 0;
+    uint64_t bytes_encoded = 0;      // Line protocol before compression
+    uint64_t bytes_sent = 0;         // Bodies handed to the transport
+    size_t pending_lines = 0;
+    size_t pending_batches = 0;
+    double last_send_ms = 0.0;
+    double max_send_ms = 0.0;
+
+    nlohmann::json to_json() const;
+};
+
+/**
+ * @brief Size- and time-triggered line protocol batcher with gzip and bounded backlog
+ *
+ * Callers encode straight into the open batch buffer and return; a single
+ * background flusher seals it once it holds max_lines lines or max_bytes
+ * bytes, or flush_interval after its first line, gzips it and hands it to
+ * the transport. Batch buffers are recycled, so steady-state encoding and
+ * compression do not allocate.
+ *
+ * At most max_pending_batches sealed batches wait for the transport. When a
+ * slow endpoint lets the backlog fill up, the oldest batch is dropped and
+ * its lines are counted in lines_dropped, so producers never block on the
+ * network and memory stays bounded. Failed sends are retried after
+ * retry_delay only while the backlog has room. The flusher runs at lowered
+ * scheduling priority where the platform allows it, so compression yields
+ * to request handling under load.
+ *
+ * Without zlib (AIMUX_HAVE_ZLIB undefined) batches are sent uncompressed.
+ *
+ * All methods are thread-safe.
+ *
+ * @since v2.0.0
+ */
+class InfluxWriteBatcher {
+public:
+    /// Delivers one batch body; return false to have it retried or counted as failed
+    using Transport = std::function<bool(std::string_view body, bool gzipped)>;
+
+    struct Options {
+        size_t max_lines = 1000;
+        size_t max_bytes = 1024 * 1024;
+        std::chrono::milliseconds flush_interval{1000};
+        size_t max_pending_batches = 8;
+        size_t max_retries = 3;
+        std::chrono::milliseconds retry_delay{5000};
+        bool gzip = true;
+        int gzip_level = 1;             // Fastest; line protocol compresses well regardless
+
+        /// Batching limits from TSDBConfig (max_batch_size, flush_interval, enable_compression, ...)
+        static Options from_config(const TSDBConfig& config);
+    };
+
+    InfluxWriteBatcher(Options options, Transport transport);
+    ~InfluxWriteBatcher();
+
+    InfluxWriteBatcher(const InfluxWriteBatcher&) = delete;
+    InfluxWriteBatcher& operator=(const InfluxWriteBatcher&) = delete;
+
+    /// Encode into the open batch; returns the number of lines accepted
+    size_t add(const std::vector<MetricPoint>& metrics);
+    size_t add(const std::vector<PrettificationEvent>& events);
+
+    /// Seal the open batch and wait until everything queued was sent or dropped
+    bool flush(std::chrono::milliseconds timeout = std::chrono::milliseconds{5000});
+
+    /// Replace the transport; waits for an in-flight send to finish first
+    void set_transport(Transport transport);
+
+    InfluxWriteStats get_stats() const;
+
+    /// True when batches are gzipped before sending
+    bool compresses() const;
+
+private:
+    struct Batch {
+        std::string body;
+        size_t lines = 0;
+    };
+
+    class Compressor;
+
+    template<typename Item>
+    size_t add_items(const std::vector<Item>& items);
+
+    // *_locked methods expect mutex_ to be held
+    void line_added_locked();
+    void seal_locked();
+    std::string take_buffer_locked();
+    void recycle_locked(std::string buffer);
+
+    void run();
+    bool deliver(std::unique_lock<std::mutex>& lock, Batch& batch);
+
+    Options options_;
+
+    mutable std::mutex mutex_;
+    std::condition_variable work_cv_;     // Wakes the flusher
+    std::condition_variable idle_cv_;     // Wakes flush() and set_transport()
+    Transport transport_;
+    LineProtocolEncoder encoder_;
+    std::string open_;
+    size_t open_lines_ = 0;
+    std::chrono::steady_clock::time_point open_since_;
+    std::deque<Batch> ready_;
+    std::vector<std::string> spare_buffers_;
+    bool in_flight_ = false;
+    bool stopping_ = false;
+    uint64_t sealed_batches_ = 0;
+    uint64_t finished_batches_ = 0;      // Sent, failed or dropped; flush() waits on this
+    InfluxWriteStats stats_;
+
+    std::unique_ptr<Compressor> compressor_;   // Flusher thread only
+    std::thread flusher_;
+};
+
+} // namespace metrics
+} // namespace aimux
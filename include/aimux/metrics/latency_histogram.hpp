@@ -0,0 +1,184 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <bit>
+#include <cstdint>
+#include <limits>
+#include <nlohmann/json.hpp>
+
+namespace aimux {
+namespace metrics {
+
+/**
+ * @brief Fixed-size, lock-free latency histogram with HDR-style log-linear buckets
+ *
+ * Values are integers (callers use microseconds). Values below 32 get a
+ * bucket each; above that every power of two is split into 16 buckets, so
+ * any recorded value is reported within ~6% of its true value. Values
+ * past MAX_TRACKABLE (about 38 hours in microseconds) are clamped.
+ *
+ * record() is a handful of relaxed atomic increments and may be called from
+ * any number of threads. Readers see a consistent-enough view for
+ * monitoring; counts read during concurrent updates may be off by the
+ * in-flight records.
+ *
+ * @since v2.0.0
+ */
+class LatencyHistogram {
+public:
+    static constexpr uint32_t SUB_BUCKET_BITS = 4;
+    static constexpr uint64_t SUB_BUCKETS = 1ull << SUB_BUCKET_BITS;         // per power of two
+    static constexpr uint64_t LINEAR_LIMIT = SUB_BUCKETS * 2;                // exact below this
+    static constexpr uint32_t MAX_SHIFT = 32;
+    static constexpr uint64_t MAX_TRACKABLE = (LINEAR_LIMIT << MAX_SHIFT) - 1;
+    static constexpr size_t BUCKET_COUNT = (MAX_SHIFT + 2) * SUB_BUCKETS;
+
+    static size_t bucket_index(uint64_t value) {
+        if (value < LINEAR_LIMIT) {
+            return static_cast<size_t>(value);
+        }
+        if (value > MAX_TRACKABLE) {
+            value = MAX_TRACKABLE;
+        }
+        uint32_t shift = static_cast<uint32_t>(std::bit_width(value)) - (SUB_BUCKET_BITS + 1);
+        uint64_t mantissa = value >> shift;   // In [SUB_BUCKETS, 2 * SUB_BUCKETS)
+        return static_cast<size_t>((shift + 1) * SUB_BUCKETS + (mantissa - SUB_BUCKETS));
+    }
+
+    /// Smallest value that lands in @p index
+    static uint64_t bucket_lower_bound(size_t index) {
+        if (index < LINEAR_LIMIT) {
+            return index;
+        }
+        uint64_t shift = index / SUB_BUCKETS - 1;
+        uint64_t mantissa = index % SUB_BUCKETS + SUB_BUCKETS;
+        return mantissa << shift;
+    }
+
+    /// Largest value that lands in @p index
+    static uint64_t bucket_upper_bound(size_t index) {
+        if (index < LINEAR_LIMIT) {
+            return index;
+        }
+        uint64_t shift = index / SUB_BUCKETS - 1;
+        return bucket_lower_bound(index) + (1ull << shift) - 1;
+    }
+
+    void record(uint64_t value) {
+        buckets_[bucket_index(value)].fetch_add(1, std::memory_order_relaxed);
+        count_.fetch_add(1, std::memory_order_relaxed);
+        sum_.fetch_add(value, std::memory_order_relaxed);
+
+        uint64_t seen = max_.load(std::memory_order_relaxed);
+        while (value > seen && !max_.compare_exchange_weak(seen, value, std::memory_order_relaxed)) {
+        }
+        seen = min_.load(std::memory_order_relaxed);
+        while (value < seen && !min_.compare_exchange_weak(seen, value, std::memory_order_relaxed)) {
+        }
+    }
+
+    uint64_t count() const { return count_.load(std::memory_order_relaxed); }
+    uint64_t sum() const { return sum_.load(std::memory_order_relaxed); }
+    uint64_t max() const { return max_.load(std::memory_order_relaxed); }
+
+    uint64_t min() const {
+        uint64_t value = min_.load(std::memory_order_relaxed);
+        return value == std::numeric_limits<uint64_t>::max() ? 0 : value;
+    }
+
+    double mean() const {
+        uint64_t n = count();
+        return n == 0 ? 0.0 : static_cast<double>(sum()) / static_cast<double>(n);
+    }
+
+    /**
+     * @brief Value at percentile @p p (0-100), or 0 when empty
+     *
+     * Reports the midpoint of the bucket holding the requested rank,
+     * capped at the largest value actually recorded.
+     */
+    double percentile(double p) const {
+        uint64_t total = 0;
+        std::array<uint64_t, BUCKET_COUNT> counts;
+        for (size_t i = 0; i < BUCKET_COUNT; ++i) {
+            counts[i] = buckets_[i].load(std::memory_order_relaxed);
+            total += counts[i];
+        }
+        if (total == 0) {
+            return 0.0;
+        }
+
+        p = p < 0.0 ? 0.0 : (p > 100.0 ? 100.0 : p);
+        uint64_t rank = static_cast<uint64_t>(p / 100.0 * static_cast<double>(total - 1)) + 1;
+        uint64_t seen = 0;
+        for (size_t i = 0; i < BUCKET_COUNT; ++i) {
+            seen += counts[i];
+            if (seen >= rank) {
+                double mid = (static_cast<double>(bucket_lower_bound(i)) +
+                              static_cast<double>(bucket_upper_bound(i))) / 2.0;
+                double largest = static_cast<double>(max());
+                return largest > 0.0 && mid > largest ? largest : mid;
+            }
+        }
+        return static_cast<double>(max());
+    }
+
+    /// Add every bucket and summary of @p other, e.g. to combine per-thread histograms
+    void merge_from(const LatencyHistogram& other) {
+        for (size_t i = 0; i < BUCKET_COUNT; ++i) {
+            uint64_t n = other.buckets_[i].load(std::memory_order_relaxed);
+            if (n != 0) {
+                buckets_[i].fetch_add(n, std::memory_order_relaxed);
+            }
+        }
+        count_.fetch_add(other.count(), std::memory_order_relaxed);
+        sum_.fetch_add(other.sum(), std::memory_order_relaxed);
+
+        uint64_t value = other.max();
+        uint64_t seen = max_.load(std::memory_order_relaxed);
+        while (value > seen && !max_.compare_exchange_weak(seen, value, std::memory_order_relaxed)) {
+        }
+        value = other.min_.load(std::memory_order_relaxed);
+        seen = min_.load(std::memory_order_relaxed);
+        while (value < seen && !min_.compare_exchange_weak(seen, value, std::memory_order_relaxed)) {
+        }
+    }
+
+    void reset() {
+        for (auto& bucket : buckets_) {
+            bucket.store(0, std::memory_order_relaxed);
+        }
+        count_.store(0, std::memory_order_relaxed);
+        sum_.store(0, std::memory_order_relaxed);
+        max_.store(0, std::memory_order_relaxed);
+        min_.store(std::numeric_limits<uint64_t>::max(), std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Summary with every value divided by @p scale (e.g. 1000 for us -> ms)
+     */
+    nlohmann::json to_json(double scale = 1.0) const {
+        return {
+            {"count", count()},
+            {"mean", mean() / scale},
+            {"min", static_cast<double>(min()) / scale},
+            {"max", static_cast<double>(max()) / scale},
+            {"p50", percentile(50.0) / scale},
+            {"p90", percentile(90.0) / scale},
+            {"p95", percentile(95.0) / scale},
+            {"p99", percentile(99.0) / scale},
+            {"p999", percentile(99.9) / scale}
+        };
+    }
+
+private:
+    std::array<std::atomic<uint64_t>, BUCKET_COUNT> buckets_{};
+    std::atomic<uint64_t> count_{0};
+    std::atomic<uint64_t> sum_{0};
+    std::atomic<uint64_t> max_{0};
+    std::atomic<uint64_t> min_{std::numeric_limits<uint64_t>::max()};
+};
+
+} // namespace metrics
+} // namespace aimux
@@ -1,19 +1,22 @@
 #pragma once
 
 #include <chrono>
+#include <cstdint>
 #include <string>
 #include <vector>
 #include <memory>
 #include <atomic>
 #include <mutex>
+#include <shared_mutex>
 #include <condition_variable>
-#include <queue>
 #include <thread>
 #include <optional>
 #include <unordered_map>
 #include <limits>
 #include <functional>
 #include <nlohmann/json.hpp>
+#include "aimux/metrics/latency_histogram.hpp"
+#include "aimux/metrics/mpsc_queue.hpp"
 
 namespace aimux {
 namespace metrics {
@@ -86,12 +89,57 @@ struct PrettificationEvent {
     static PrettificationEvent from_json(const nlohmann::json& j);
 };
 
+/**
+ * @brief Interned metric series (name + tag set) for allocation-free recording
+ *
+ * Returned by MetricsCollector::register_metric(). A handle is a dense index
+ * into the collector that issued it and is only meaningful there. A
+ * default-constructed handle is invalid and records nothing.
+ *
+ * @since v2.0.0
+ */
+class MetricHandle {
+public:
+    MetricHandle() = default;
+
+    bool valid() const { return id_ != INVALID; }
+    uint32_t id() const { return id_; }
+    MetricType type() const { return type_; }
+
+private:
+    friend class MetricsCollector;
+    static constexpr uint32_t INVALID = std::numeric_limits<uint32_t>::max();
+
+    MetricHandle(uint32_t id, MetricType type) : id_(id), type_(type) {}
+
+    uint32_t id_ = INVALID;
+    MetricType type_ = MetricType::COUNTER;
+};
+
 /**
  * @brief Real-time metrics collector interface
  *
- * Provides high-performance metrics collection with minimal overhead.
- * Supports both real-time streaming and batch collection modes.
- * Thread-safe implementation for concurrent access patterns.
+ * Metrics are pre-aggregated where they are recorded. register_metric()
+ * interns a name and tag set into a MetricHandle once; record() then adds
+ * the value to a cell owned by the calling thread (a count, sum and min/max,
+ * plus a log-linear LatencyHistogram for everything but counters), with
+ * no lock, no allocation after the thread's first record of that series
+ * and no cache line shared with other recording threads. The string-based
+ * record_* methods intern on every call and are meant for cold paths.
+ *
+ * A background merger folds the per-thread cells into per-series
+ * aggregates every flush_interval and hands store_metrics() one point per
+ * series that changed: the summed delta for counters, the last value for
+ * gauges and the interval mean for histograms and timers, with count and
+ * sum deltas and lifetime min/max/p50/p95/p99 as fields. Memory is bounded
+ * by Config::max_series and the number of recording threads, not by the
+ * number of records; registrations past max_series are refused.
+ *
+ * Raw MetricPoints and PrettificationEvents go through lock-free MPSC
+ * queues, bounded by buffer_size, and are stored as recorded.
+ *
+ * Derived classes must call stop_collection() in their destructor so that
+ * the merger never calls into a partly destroyed object.
  */
 class MetricsCollector {
 public:
@@ -107,6 +155,7 @@ public:
         double sampling_rate;                    // Sampling rate (0.0-1.0)
         std::string storage_backend;      // Storage backend type
         nlohmann::json backend_config;                 // Backend-specific config
+        size_t max_series;                      // Interned name + tag sets; fixed at construction
 
         Config() : buffer_size(10000),
                   flush_interval(std::chrono::milliseconds(100)),
@@ -114,12 +163,35 @@ public:
                   enable_real_time(true),
                   enable_compression(true),
                   sampling_rate(1.0),
-                  storage_backend("influxdb") {}
+                  storage_backend("influxdb"),
+                  max_series(4096) {}
     };
 
+    using Tags = std::unordered_map<std::string, std::string>;
+
     explicit MetricsCollector(const Config& config = Config());
     virtual ~MetricsCollector();
 
+    MetricsCollector(const MetricsCollector&) = delete;
+    MetricsCollector& operator=(const MetricsCollector&) = delete;
+
+    /**
+     * @brief Intern @p name and @p tags as a series of @p type
+     * @return Handle for record(); invalid once max_series series exist
+     *
+     * Registering the same name, type and tags again returns the same handle.
+     * Takes a shared lock for lookups and an exclusive one for new series.
+     */
+    MetricHandle register_metric(const std::string& name, MetricType type, const Tags& tags = {});
+
+    /// Add @p value to the series; lock-free, allocation-free after the first call per thread
+    void record(MetricHandle handle, double value);
+
+    /// Record a duration in milliseconds
+    void record(MetricHandle handle, std::chrono::nanoseconds duration) {
+        record(handle, std::chrono::duration<double, std::milli>(duration).count());
+    }
+
     // Core collection methods
     void record_counter(const std::string& name, double value = 1.0,
                        const std::unordered_map<std::string, std::string>& tags = {});
@@ -129,6 +201,7 @@ public:
                          const std::unordered_map<std::string, std::string>& tags = {});
     void record_timer(const std::string& name, std::chrono::nanoseconds duration,
                      const std::unordered_map<std::string, std::string>& tags = {});
+    /// Queue a raw point for storage and fold its value into real-time stats for its series
     void record_event(const MetricPoint& event);
     void record_prettification_event(const PrettificationEvent& event);
 
@@ -148,7 +221,14 @@ public:
         const std::chrono::system_clock::time_point& start,
         const std::chrono::system_clock::time_point& end) const;
 
-    // Real-time aggregation
+    /**
+     * @brief Lifetime statistics per name, combining every tag set of that name
+     *
+     * Merges pending per-thread records first. Costs O(series x buckets) for
+     * the requested names regardless of how many values were recorded.
+     * Percentiles are accurate to the histogram buckets (~6%); counters
+     * report count, sum, mean and min/max only.
+     */
     std::vector<MetricStatistics> get_real_time_stats(const std::vector<std::string>& metric_names) const;
 
     // Plugin-specific analytics
@@ -177,6 +257,7 @@ public:
     void clear_old_data();
 
     // Configuration and status
+    /// Apply new settings; max_series keeps its construction-time value
     void update_config(const Config& config);
     Config get_config() const { return config_; }
     nlohmann::json get_status() const;
@@ -189,23 +270,52 @@ public:
     void set_event_callback(EventCallback callback) { event_callback_ = callback; }
 
 protected:
-    // Internal processing
+    /// Merge per-thread aggregates and store changed series, raw points and events once
     void process_batch();
     virtual void store_metrics(const std::vector<MetricPoint>& metrics) = 0;
     virtual void store_events(const std::vector<PrettificationEvent>& events) = 0;
 
 private:
+    static constexpr double HISTOGRAM_SCALE = 1000.0;   // Histograms keep three decimal places
+
+    struct Series;
+    struct SeriesCell;
+    struct ThreadShard;
+    struct SeriesAggregate;
+    struct MergedView;
+    struct MergeState;
+
     Config config_;
     std::atomic<bool> collecting_{false};
 
-    // Thread-safe buffers
-    mutable std::mutex metrics_mutex_;
-    mutable std::mutex events_mutex_;
-    std::queue<MetricPoint> metrics_buffer_;
-    std::queue<PrettificationEvent> events_buffer_;
+    const size_t max_series_;
+    const uint64_t instance_id_;
+
+    // Series registry; series_ is sized once and slots below series_count_ never change
+    mutable std::shared_mutex registry_mutex_;
+    std::vector<std::unique_ptr<Series>> series_;
+    std::atomic<uint32_t> series_count_{0};
+    std::unordered_map<std::string, uint32_t> series_ids_;
+    std::unordered_map<std::string, std::vector<uint32_t>> series_by_name_;
+    std::atomic<uint64_t> dropped_series_{0};
+
+    // Per-thread cells, folded by the merger
+    mutable std::mutex shards_mutex_;
+    mutable std::vector<std::shared_ptr<ThreadShard>> shards_;
+
+    mutable std::mutex merge_mutex_;
+    std::unique_ptr<MergeState> merge_state_;
+    mutable std::atomic<std::shared_ptr<const MergedView>> merged_;
+
+    // Raw ingestion
+    MpscQueue<MetricPoint> metrics_buffer_;
+    MpscQueue<PrettificationEvent> events_buffer_;
+    std::atomic<uint64_t> dropped_points_{0};
+    std::mutex batch_mutex_;
 
     // Processing thread
     std::thread processor_thread_;
+    std::mutex processor_mutex_;
     std::condition_variable processor_cv_;
     std::atomic<bool> should_stop_{false};
 
@@ -213,11 +323,6 @@ private:
     MetricCallback metric_callback_;
     EventCallback event_callback_;
 
-    // In-memory aggregation for real-time stats
-    mutable std::mutex aggregation_mutex_;
-    std::unordered_map<std::string, std::vector<double>> recent_values_;
-    std::unordered_map<std::string, std::chrono::system_clock::time_point> last_update_;
-
     // Utility methods
     MetricPoint create_metric_point(
         const std::string& name,
@@ -225,8 +330,12 @@ private:
         double value,
         const std::unordered_map<std::string, std::string>& tags = {}) const;
 
-    void update_real_time_aggregation(const MetricPoint& point);
-    std::vector<double> calculate_percentiles(const std::vector<double>& values) const;
+    MetricHandle intern_series(const std::string& name, MetricType type, const Tags& tags, bool exported);
+    ThreadShard& local_shard();
+    bool record_value(MetricHandle handle, double value);
+    void merge_shards() const;
+    void export_aggregates(std::vector<MetricPoint>& points);
+    void collection_loop();
 };
 
 /**
@@ -235,6 +344,7 @@ private:
 class InMemoryMetricsCollector : public MetricsCollector {
 public:
     explicit InMemoryMetricsCollector(const Config& config = Config{});
+    ~InMemoryMetricsCollector() override;
 
     // Access stored data for testing
     const std::vector<MetricPoint>& get_stored_metrics() const { return stored_metrics_; }
@@ -0,0 +1,89 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <utility>
+
+namespace aimux {
+namespace metrics {
+
+/**
+ * @brief Unbounded lock-free multi-producer queue drained in batches
+ *
+ * Producers push with a single compare-and-swap on the list head; a
+ * consumer detaches the whole list with one exchange and hands the items
+ * over oldest first. There is no per-item pop, so there is no ABA hazard,
+ * and concurrent drain() calls simply split the items between them.
+ *
+ * size() is maintained separately and is only approximate while pushes and
+ * drains are in flight; callers use it for soft bounds.
+ *
+ * @since v2.0.0
+ */
+template<typename T>
+class MpscQueue {
+public:
+    MpscQueue() = default;
+    ~MpscQueue() {
+        drain([](T&&) {});
+    }
+
+    MpscQueue(const MpscQueue&) = delete;
+    MpscQueue& operator=(const MpscQueue&) = delete;
+
+    void push(T value) {
+        Node* node = new Node{std::move(value), head_.load(std::memory_order_relaxed)};
+        while (!head_.compare_exchange_weak(node->next, node,
+                                            std::memory_order_release, std::memory_order_relaxed)) {
+        }
+        size_.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Remove everything pushed so far and pass each item to @p consume in push order
+     * @return Number of items consumed
+     */
+    template<typename Consumer>
+    size_t drain(Consumer&& consume) {
+        Node* node = head_.exchange(nullptr, std::memory_order_acquire);
+
+        // The list is newest first
+        Node* oldest = nullptr;
+        while (node) {
+            Node* next = node->next;
+            node->next = oldest;
+            oldest = node;
+            node = next;
+        }
+
+        size_t drained = 0;
+        while (oldest) {
+            Node* next = oldest->next;
+            consume(std::move(oldest->value));
+            delete oldest;
+            oldest = next;
+            drained++;
+        }
+        size_.fetch_sub(drained, std::memory_order_relaxed);
+        return drained;
+    }
+
+    size_t size() const {
+        auto current = static_cast<std::ptrdiff_t>(size_.load(std::memory_order_relaxed));
+        return current > 0 ? static_cast<size_t>(current) : 0;
+    }
+
+    bool empty() const { return head_.load(std::memory_order_relaxed) == nullptr; }
+
+private:
+    struct Node {
+        T value;
+        Node* next;
+    };
+
+    std::atomic<Node*> head_{nullptr};
+    std::atomic<size_t> size_{0};
+};
+
+} // namespace metrics
+} // namespace aimux
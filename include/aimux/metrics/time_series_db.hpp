@@ -1,6 +1,8 @@
 #pragma once
 
 #include "metrics_collector.hpp"
+#include "aimux/metrics/influx_writer.hpp"
+#include "aimux/core/thread_manager.hpp"
 #include <string>
 #include <vector>
 #include <memory>
@@ -35,6 +37,16 @@ struct TSDBConfig {
     std::chrono::milliseconds flush_interval{1000};
     size_t max_retries = 3;
     std::chrono::seconds retry_delay{5};
+    size_t max_batch_bytes = 1024 * 1024;           // Batches are also sealed at this size
+    size_t max_pending_batches = 8;                 // Oldest batch is dropped beyond this backlog
+
+    // Embedded columnar backend ("columnar")
+    std::string data_directory = "data/tsdb";
+    std::chrono::hours partition_duration{1};       // One file per database and window
+    std::chrono::hours raw_retention{48};           // Raw points older than this are rolled up
+    std::chrono::seconds rollup_interval{60};       // Resolution of rolled-up data
+    std::chrono::hours retention{24 * 7};           // Everything older is deleted
+    size_t max_block_points = 1024;                 // Points per compressed block
 };
 
 /**
@@ -63,6 +75,10 @@ public:
     const std::string& get_measurement() const { return measurement_; }
     const std::optional<std::pair<std::chrono::system_clock::time_point, std::chrono::system_clock::time_point>>& get_time_range() const { return time_range_; }
     const std::unordered_map<std::string, std::string>& get_tags() const { return tags_; }
+    const std::vector<std::string>& get_fields() const { return fields_; }
+    const std::vector<std::string>& get_group_by() const { return group_by_; }
+    const std::optional<size_t>& get_limit() const { return limit_; }
+    const std::optional<std::pair<std::string, std::string>>& get_order_by() const { return order_by_; }
 
 private:
     std::string measurement_;
@@ -150,23 +166,35 @@ protected:
         std::function<void(bool)> callback;
     };
 
+    // Queued writes are drained by one task at a time on the shared pool,
+    // which keeps them in order without a dedicated writer thread
     std::queue<AsyncWriteRequest> async_write_queue_;
     std::mutex async_mutex_;
     std::condition_variable async_cv_;
-    std::thread async_worker_;
+    std::shared_ptr<core::ThreadPool> async_pool_;
+    bool async_drain_scheduled_ = false;
     std::atomic<bool> should_stop_async_{false};
 
     void process_async_writes();
     virtual bool write_metrics_sync(const std::vector<MetricPoint>& metrics) = 0;
     virtual bool write_events_sync(const std::vector<PrettificationEvent>& events) = 0;
 
+    // Waits for queued writes; backends call it first in their destructor
+    // because the drain calls back into their write_*_sync overrides
+    void stop_async_worker();
+
 private:
+    void enqueue_async_write(AsyncWriteRequest request);
     void start_async_worker();
-    void stop_async_worker();
 };
 
 /**
  * @brief InfluxDB 2.x implementation of TimeSeriesDB
+ *
+ * Writes are encoded into an InfluxWriteBatcher and return once batched;
+ * batches are gzipped (with enable_compression) and posted from the
+ * batcher's own thread. Delivery failures and points dropped under
+ * back-pressure are reported by get_write_stats() and get_status().
  */
 class InfluxDB2Client : public TimeSeriesDB {
 public:
@@ -213,22 +241,37 @@ public:
     bool drop_continuous_query(const std::string& name) override;
     std::vector<std::string> list_continuous_queries() override;
 
+    // Write batching
+    /// Post write batches through @p transport instead of the HTTP client (tests, benchmarks)
+    void set_write_transport(InfluxWriteBatcher::Transport transport);
+    /// Send the open batch and wait until every batched point was sent or dropped
+    bool flush_writes(std::chrono::milliseconds timeout = std::chrono::milliseconds{5000});
+    InfluxWriteStats get_write_stats() const;
+
 protected:
+    /**
+     * Queue points on the write batcher; the HTTP post happens later on its flusher.
+     * Returns false when none of the points could be encoded, or when batched lines
+     * were dropped (back-pressure or exhausted retries) since the previous write, so
+     * a failing endpoint surfaces on the caller's next write instead of never.
+     */
     bool write_metrics_sync(const std::vector<MetricPoint>& metrics) override;
     bool write_events_sync(const std::vector<PrettificationEvent>& events) override;
 
 private:
+    bool batched_write_ok(size_t offered, size_t accepted);
+
     // Internal HTTP client methods
     bool http_request(const std::string& method,
                      const std::string& endpoint,
-                     const std::string& body,
+                     std::string_view body,
                      nlohmann::json& response,
-                     std::string& error_msg);
+                     std::string& error_msg,
+                     std::string_view content_encoding = {});
 
     std::string build_write_url() const;
     std::string build_query_url() const;
-    std::string format_metrics_for_influx(const std::vector<MetricPoint>& metrics) const;
-    std::string format_events_for_influx(const std::vector<PrettificationEvent>& events) const;
+    bool post_write_batch(std::string_view body, bool gzipped);
 
     std::string parse_line_protocol(const std::string& line, MetricPoint& point) const;
     MetricPoint parse_influx_point(const nlohmann::json& json_point) const;
@@ -245,6 +288,10 @@ private:
     // Performance tracking
     mutable std::atomic<double> last_query_time_ms_{0.0};
     mutable std::mutex performance_mutex_;
+
+    std::string write_url_;                             // build_write_url(), computed once
+    std::unique_ptr<InfluxWriteBatcher> write_batcher_;
+    std::atomic<uint64_t> reported_drops_{0};           // lines_dropped already surfaced to a writer
 };
 
 /**
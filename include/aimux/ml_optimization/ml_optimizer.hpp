@@ -10,6 +10,7 @@
 #include <mutex>
 #include <condition_variable>
 #include <thread>
+#include <queue>
 #include <functional>
 #include <nlohmann/json.hpp>
 #include "aimux/metrics/metrics_collector.hpp"
@@ -0,0 +1,96 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <memory>
+#include <nlohmann/json.hpp>
+#include <curl/curl.h>
+
+namespace aimux {
+namespace network {
+
+/**
+ * @brief Event-driven driver for many concurrent transfers on one thread
+ *
+ * A single loop thread owns a CURLM handle and waits on epoll for the
+ * sockets curl asks it to watch (CURLMOPT_SOCKETFUNCTION) and for curl's
+ * own timers (CURLMOPT_TIMERFUNCTION), calling curl_multi_socket_action()
+ * only for the sockets that are ready. An in-flight request therefore costs
+ * a file descriptor rather than a blocked OS thread.
+ *
+ * The same loop also runs one-shot timers (schedule()), which lets callers
+ * such as provider retry backoff wait without parking a thread.
+ *
+ * Completion and timer callbacks run on the loop thread and must not block;
+ * hand any heavy work off to another thread.
+ */
+class CurlMultiEngine {
+public:
+    /**
+     * @brief Invoked once when a transfer finishes, fails or is cancelled
+     */
+    using CompletionCallback = std::function<void(CURLcode result)>;
+
+    /**
+     * @brief Invoked once per timer: fired is false if the engine shut down first
+     */
+    using TimerCallback = std::function<void(bool fired)>;
+
+    /**
+     * @brief Constructor
+     * @param max_total_connections Upper bound on open connections (CURLMOPT_MAX_TOTAL_CONNECTIONS)
+     */
+    explicit CurlMultiEngine(long max_total_connections = 256);
+
+    /**
+     * @brief Destructor; cancels outstanding transfers and joins the loop thread
+     */
+    ~CurlMultiEngine();
+
+    CurlMultiEngine(const CurlMultiEngine&) = delete;
+    CurlMultiEngine& operator=(const CurlMultiEngine&) = delete;
+
+    /**
+     * @brief Process-wide engine shared by all HttpClient instances
+     */
+    static CurlMultiEngine& instance();
+
+    /**
+     * @brief Start a fully configured easy handle
+     *
+     * Ownership of the handle stays with the caller; it is detached from the
+     * multi handle before on_complete runs and may be reused from there.
+     *
+     * @param easy Configured easy handle
+     * @param on_complete Completion callback (runs on the loop thread)
+     * @return false if the engine is shutting down (callback is not invoked)
+     */
+    bool submit(CURL* easy, CompletionCallback on_complete);
+
+    /**
+     * @brief Run a callback on the loop thread after a delay
+     * @param delay Time to wait; zero runs it on the next loop iteration
+     * @param on_fire Timer callback (runs on the loop thread)
+     * @return false if the engine is shutting down (callback is not invoked)
+     */
+    bool schedule(std::chrono::milliseconds delay, TimerCallback on_fire);
+
+    /**
+     * @brief Cancel all transfers and timers and stop the loop thread
+     */
+    void shutdown();
+
+    /**
+     * @brief Get engine statistics
+     * @return JSON with submitted/completed/in-flight counts, watched sockets and pending timers
+     */
+    nlohmann::json get_statistics() const;
+
+private:
+    struct Impl;
+    std::unique_ptr<Impl> pImpl;
+};
+
+} // namespace network
+} // namespace aimux
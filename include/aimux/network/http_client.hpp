@@ -41,6 +41,16 @@ struct HttpRequest {
 
 /**
  * @brief Asynchronous HTTP client with connection pooling
+ *
+ * Each client keeps a pool of reusable CURL easy handles bound to a single
+ * CURLSH share (DNS cache and TLS session cache). Every pooled handle keeps
+ * its own connection cache and async transfers reuse the event loop's multi
+ * handle cache, so a long-lived client reuses warm TCP/TLS connections and
+ * negotiates HTTP/2 where the upstream supports it.
+ *
+ * Every send_* call picks up the calling thread's core::current_cancellation()
+ * token; once it is cancelled the transfer is aborted (within about a second)
+ * and reported with status 0 and the error "Request cancelled".
  */
 class HttpClient {
 public:
@@ -48,11 +58,11 @@ public:
      * @brief HTTP response callback type
      */
     using ResponseCallback = std::function<void(const HttpResponse&)>;
-    
+
     /**
      * @brief Constructor
-     * @param max_connections Maximum concurrent connections
-     * @param connection_timeout_ms Connection timeout in milliseconds
+     * @param max_connections Maximum idle handles (and connections) kept for reuse
+     * @param connection_timeout_ms Upper bound on connection setup, in milliseconds
      */
     explicit HttpClient(int max_connections = 10, int connection_timeout_ms = 30000);
     
@@ -70,13 +80,18 @@ public:
     
     /**
      * @brief Send HTTP request (asynchronous)
+     *
+     * The transfer is multiplexed on the shared CurlMultiEngine event loop
+     * rather than occupying a thread. The callback runs on the loop thread
+     * and must not block.
+     *
      * @param request HTTP request
      * @param callback Response callback
      */
     void send_request_async(const HttpRequest& request, ResponseCallback callback);
     
     /**
-     * @brief Send HTTP request (future-based)
+     * @brief Send HTTP request (future-based, driven by the event loop)
      * @param request HTTP request
      * @return Future containing HTTP response
      */
@@ -84,15 +99,32 @@ public:
     
     /**
      * @brief Get client statistics
-     * @return JSON with client metrics
+     * @return JSON with client metrics, including new/reused connection
+     *         counts, TLS handshakes, share lock acquisitions and the
+     *         connection reuse ratio
      */
     nlohmann::json get_statistics() const;
     
     /**
-     * @brief Set timeout for all requests
+     * @brief Set the connection timeout for all requests
+     *
+     * Connection setup is bounded by the smaller of this and half the
+     * request's own timeout_ms.
+     *
      * @param timeout_ms Timeout in milliseconds
      */
     void set_timeout(int timeout_ms);
+
+    /**
+     * @brief Resize the pool of reusable handles and connections
+     * @param max_connections Maximum idle handles kept (at least 1)
+     */
+    void set_max_connections(int max_connections);
+
+    /**
+     * @brief Current pool size limit
+     */
+    size_t max_connections() const;
     
     /**
      * @brief Add default header for all requests
@@ -142,6 +174,28 @@ public:
      * @return Unique pointer to HTTP client
      */
     static std::unique_ptr<HttpClient> create_client(int max_connections, int timeout_ms);
+
+    /**
+     * @brief Get a long-lived client shared by all callers using the same key
+     *
+     * Providers key their client by name and endpoint so that warm
+     * connections survive across requests and provider instances. The
+     * first caller's limits create the client; a later caller asking for a
+     * larger pool grows it, but the pool is never shrunk.
+     *
+     * @param key Client key (e.g. "cerebras@https://api.cerebras.ai")
+     * @param max_connections Pool size the caller needs
+     * @param connection_timeout_ms Connection timeout for a newly created client
+     * @return Shared pointer to the keyed HTTP client
+     */
+    static std::shared_ptr<HttpClient> get_shared_client(const std::string& key, int max_connections = 10,
+                                                         int connection_timeout_ms = 30000);
+
+    /**
+     * @brief Get statistics for all keyed clients
+     * @return JSON object mapping client key to client statistics
+     */
+    static nlohmann::json get_shared_client_statistics();
     
     /**
      * @brief Configure global SSL settings
@@ -1,11 +1,11 @@
 #pragma once
 
 #include "aimux/prettifier/prettifier_plugin.hpp"
+#include "aimux/prettifier/pattern_registry.hpp"
 #include <chrono>
 #include <atomic>
 #include <memory>
 #include <string>
-#include <regex>
 
 namespace aimux {
 namespace prettifier {
@@ -314,19 +314,29 @@ private:
     bool streaming_active_ = false;
     std::chrono::steady_clock::time_point streaming_start_;
 
-    // Claude-specific patterns
+    // Claude-specific patterns, compiled once in the shared PatternRegistry
     struct ClaudePatterns {
+        PatternSet set;
+
         // XML tool use patterns
-        std::regex function_calls_start;
-        std::regex function_calls_end;
-        std::regex function_call_pattern;
-        std::regex thinking_start;
-        std::regex thinking_end;
-        std::regex reflection_pattern;
+        const CompiledPattern& function_calls_start;
+        const CompiledPattern& function_calls_end;
+        const CompiledPattern& function_call_pattern;
+        const CompiledPattern& parameter_pattern;
+        const CompiledPattern& thinking_start;
+        const CompiledPattern& thinking_end;
+        const CompiledPattern& reflection_pattern;
 
         // Content patterns
-        std::regex code_block_pattern;
-        std::regex xml_artifact_pattern;
+        const CompiledPattern& code_block_pattern;
+        const CompiledPattern& xml_artifact_pattern;
+        const CompiledPattern& blank_lines_pattern;
+        const CompiledPattern& line_endings_pattern;
+        const CompiledPattern& excess_whitespace_pattern;
+        const CompiledPattern& image_pattern;
+        const CompiledPattern& document_pattern;
+        const CompiledPattern& step_pattern;
+        const CompiledPattern& analysis_pattern;
 
         ClaudePatterns();
     };
@@ -363,6 +373,14 @@ private:
      */
     std::vector<ToolCall> extract_claude_json_tool_uses(const std::string& content) const;
 
+    /**
+     * @brief Extract tool_use blocks from an already parsed response
+     *
+     * @param response_json Parsed Anthropic message
+     * @return Vector of extracted tool calls
+     */
+    std::vector<ToolCall> extract_claude_json_tool_uses(const nlohmann::json& response_json) const;
+
     /**
      * @brief Extract and process thinking blocks
      *
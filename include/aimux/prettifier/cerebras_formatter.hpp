@@ -1,11 +1,11 @@
 #pragma once
 
 #include "aimux/prettifier/prettifier_plugin.hpp"
+#include "aimux/prettifier/pattern_registry.hpp"
 #include <chrono>
 #include <atomic>
 #include <memory>
 #include <string>
-#include <regex>
 
 namespace aimux {
 namespace prettifier {
@@ -290,12 +290,18 @@ private:
     bool streaming_active_ = false;
     std::chrono::steady_clock::time_point streaming_start_;
 
-    // Pre-compiled regex patterns for speed
+    // Pre-compiled patterns for speed, shared through the PatternRegistry
     struct CerebrasPatterns {
+        PatternSet set;
+
         // Cerebras-specific tool call patterns (optimized for speed)
-        std::regex fast_tool_pattern;
-        std::regex cerebras_json_pattern;
-        std::regex streaming_tool_pattern;
+        const CompiledPattern& fast_tool_pattern;
+        const CompiledPattern& cerebras_json_pattern;
+        const CompiledPattern& streaming_tool_pattern;
+
+        // Normalization patterns
+        const CompiledPattern& artifacts_pattern;
+        const CompiledPattern& whitespace_pattern;
 
         CerebrasPatterns();
     };
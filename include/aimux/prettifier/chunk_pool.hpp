@@ -0,0 +1,255 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string_view>
+#include <utility>
+
+namespace aimux {
+namespace prettifier {
+
+class ChunkPool;
+
+/**
+ * @brief Block of chunk storage handed out by a ChunkPool
+ *
+ * The bytes follow the header in the same allocation. Every slice carved
+ * from the block, and the writer still filling it, holds one reference;
+ * the block returns to its pool when the last one is dropped.
+ */
+struct ChunkBlock {
+    std::atomic<uint32_t> refs{0};
+    uint32_t capacity = 0;
+    ChunkPool* pool = nullptr;
+    ChunkBlock* next_free = nullptr;
+
+    char* data() { return reinterpret_cast<char*>(this + 1); }
+    const char* data() const { return reinterpret_cast<const char*>(this + 1); }
+};
+
+/**
+ * @brief Budgeted allocator of fixed-size chunk blocks
+ *
+ * Blocks of BLOCK_SIZE bytes are recycled through a free list, so a steady
+ * stream of chunks reuses the same memory instead of going to the heap.
+ * Chunks too large to share a block get a dedicated one that is freed on
+ * release. All storage, cached blocks included, counts against a byte
+ * budget; acquire() fails rather than exceed it.
+ *
+ * The free list is touched once per block, not once per chunk.
+ *
+ * @thread Thread-safe
+ * @since v2.0.0
+ */
+class ChunkPool {
+public:
+    static constexpr size_t BLOCK_SIZE = 8 * 1024;
+
+    /// Larger chunks get a dedicated block instead of sharing one
+    static constexpr size_t MAX_SHARED_CHUNK = BLOCK_SIZE / 4;
+
+    struct Stats {
+        size_t budget_bytes = 0;
+        size_t allocated_bytes = 0;     // Cached blocks included
+        size_t in_use_bytes = 0;
+        size_t total_blocks = 0;        // Shared-size blocks alive, cached or in use
+        size_t free_blocks = 0;
+        uint64_t rejected = 0;          // acquire() calls refused by the budget
+    };
+
+    explicit ChunkPool(size_t budget_bytes);
+    ~ChunkPool();
+
+    ChunkPool(const ChunkPool&) = delete;
+    ChunkPool& operator=(const ChunkPool&) = delete;
+
+    /**
+     * @brief Take a block holding one reference
+     *
+     * @param min_capacity Bytes needed; BLOCK_SIZE or less reuses a pooled block
+     * @return Block, or nullptr when allocating it would exceed the budget
+     */
+    ChunkBlock* acquire(size_t min_capacity = BLOCK_SIZE);
+
+    /**
+     * @brief Hand back a block whose last reference was dropped
+     */
+    static void release(ChunkBlock* block) noexcept { block->pool->recycle(block); }
+
+    /**
+     * @brief Change the budget; cached blocks above it are freed
+     */
+    void set_budget(size_t budget_bytes);
+
+    size_t allocated_bytes() const { return allocated_bytes_.load(std::memory_order_relaxed); }
+
+    Stats get_stats() const;
+
+private:
+    void recycle(ChunkBlock* block) noexcept;
+    bool reserve(size_t bytes);
+    void trim_free_blocks(size_t keep_bytes);
+    static void free_block(ChunkBlock* block) noexcept;
+
+    mutable std::mutex mutex_;
+    ChunkBlock* free_list_ = nullptr;
+    size_t free_blocks_ = 0;
+
+    std::atomic<size_t> budget_bytes_;
+    std::atomic<size_t> allocated_bytes_{0};
+    std::atomic<size_t> in_use_bytes_{0};
+    std::atomic<size_t> total_blocks_{0};
+    std::atomic<uint64_t> rejected_{0};
+};
+
+/**
+ * @brief Reference-counted view of bytes stored in a ChunkBlock
+ *
+ * Copying shares the storage; the block is released with its last slice.
+ */
+class ChunkSlice {
+public:
+    ChunkSlice() = default;
+
+    ChunkSlice(const ChunkSlice& other) noexcept
+        : block_(other.block_), offset_(other.offset_), size_(other.size_) {
+        if (block_) {
+            block_->refs.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+
+    ChunkSlice(ChunkSlice&& other) noexcept
+        : block_(std::exchange(other.block_, nullptr)), offset_(other.offset_),
+          size_(std::exchange(other.size_, 0)) {}
+
+    ChunkSlice& operator=(ChunkSlice other) noexcept {
+        std::swap(block_, other.block_);
+        std::swap(offset_, other.offset_);
+        std::swap(size_, other.size_);
+        return *this;
+    }
+
+    ~ChunkSlice() { reset(); }
+
+    void reset() noexcept {
+        if (block_ && block_->refs.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+            ChunkPool::release(block_);
+        }
+        block_ = nullptr;
+        size_ = 0;
+    }
+
+    std::string_view view() const noexcept {
+        return block_ ? std::string_view(block_->data() + offset_, size_) : std::string_view();
+    }
+
+    size_t size() const noexcept { return size_; }
+    bool empty() const noexcept { return size_ == 0; }
+
+private:
+    friend class ChunkWriter;
+
+    // Adopts one reference already taken on block
+    ChunkSlice(ChunkBlock* block, uint32_t offset, uint32_t size) noexcept
+        : block_(block), offset_(offset), size_(size) {}
+
+    ChunkBlock* block_ = nullptr;
+    uint32_t offset_ = 0;
+    uint32_t size_ = 0;
+};
+
+/**
+ * @brief Copies one stream's chunks into pooled blocks
+ *
+ * Small chunks are appended back to back into the writer's current block,
+ * so a stream takes a new block once per BLOCK_SIZE bytes rather than one
+ * allocation per chunk.
+ *
+ * Not thread-safe; use one writer per stream.
+ */
+class ChunkWriter {
+public:
+    explicit ChunkWriter(ChunkPool& pool) : pool_(&pool) {}
+    ~ChunkWriter() { reset(); }
+
+    ChunkWriter(const ChunkWriter&) = delete;
+    ChunkWriter& operator=(const ChunkWriter&) = delete;
+
+    /**
+     * @brief Copy data into pool storage
+     * @return false, leaving out untouched, when the pool's budget is exhausted
+     */
+    bool append(std::string_view data, ChunkSlice& out);
+
+    /**
+     * @brief Stop filling the current block; slices already taken keep it alive
+     */
+    void reset() noexcept;
+
+private:
+    ChunkPool* pool_;
+    ChunkBlock* block_ = nullptr;
+    uint32_t used_ = 0;
+};
+
+/**
+ * @brief Bounded single-producer/single-consumer ring
+ *
+ * One thread pushes and one thread pops at a time; neither side locks.
+ * Capacity is rounded up to a power of two.
+ */
+template <typename T>
+class SpscRing {
+public:
+    explicit SpscRing(size_t capacity)
+        : mask_(std::bit_ceil(std::max<size_t>(capacity, 2)) - 1),
+          slots_(std::make_unique<T[]>(mask_ + 1)) {}
+
+    bool try_push(T&& item) {
+        size_t tail = tail_.load(std::memory_order_relaxed);
+        if (tail - head_.load(std::memory_order_acquire) > mask_) {
+            return false;
+        }
+        slots_[tail & mask_] = std::move(item);
+        tail_.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    bool try_pop(T& item) {
+        size_t head = head_.load(std::memory_order_relaxed);
+        if (head == tail_.load(std::memory_order_acquire)) {
+            return false;
+        }
+        item = std::move(slots_[head & mask_]);
+        head_.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+    bool full() const {
+        return tail_.load(std::memory_order_relaxed) - head_.load(std::memory_order_acquire) > mask_;
+    }
+
+    bool empty() const {
+        return head_.load(std::memory_order_acquire) == tail_.load(std::memory_order_acquire);
+    }
+
+    size_t size() const {
+        return tail_.load(std::memory_order_acquire) - head_.load(std::memory_order_acquire);
+    }
+
+    size_t capacity() const { return mask_ + 1; }
+
+private:
+    const size_t mask_;
+    std::unique_ptr<T[]> slots_;
+    alignas(64) std::atomic<size_t> head_{0};   // Consumer
+    alignas(64) std::atomic<size_t> tail_{0};   // Producer
+};
+
+} // namespace prettifier
+} // namespace aimux
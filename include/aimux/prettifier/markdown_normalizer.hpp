@@ -1,7 +1,7 @@
 #pragma once
 
 #include "aimux/prettifier/prettifier_plugin.hpp"
-#include <regex>
+#include "aimux/prettifier/pattern_registry.hpp"
 #include <chrono>
 #include <atomic>
 
@@ -97,6 +97,9 @@ struct MarkdownNormalizerStats {
 
 /**
  * @brief Provider-specific markdown patterns and normalization rules
+ *
+ * Each list is compiled into the PatternRegistry on first use and shared
+ * by every plugin instance afterwards.
  */
 class ProviderPatterns {
 public:
@@ -106,7 +109,7 @@ public:
      * Handles fast responses with incomplete code blocks and JSON tool responses.
      * Optimizes for speed while ensuring quality.
      */
-    static std::vector<std::regex> get_cerebras_patterns();
+    static const std::vector<const CompiledPattern*>& get_cerebras_patterns();
 
     /**
      * @brief Get normalization patterns for OpenAI provider
@@ -114,7 +117,7 @@ public:
      * Handles well-structured but sometimes verbose responses.
      * Normalizes fenced code blocks and function calling formats.
      */
-    static std::vector<std::regex> get_openai_patterns();
+    static const std::vector<const CompiledPattern*>& get_openai_patterns();
 
     /**
      * @brief Get normalization patterns for Anthropic provider
@@ -122,7 +125,7 @@ public:
      * Manages Claude-specific XML tags and tool use format.
      * Separates reasoning from final responses appropriately.
      */
-    static std::vector<std::regex> get_anthropic_patterns();
+    static const std::vector<const CompiledPattern*>& get_anthropic_patterns();
 
     /**
      * @brief Get normalization patterns for Synthetic provider
@@ -130,12 +133,12 @@ public:
      * Handles mixed markdown with structured tool outputs.
      * Manages complex nested reasoning patterns.
      */
-    static std::vector<std::regex> get_synthetic_patterns();
+    static const std::vector<const CompiledPattern*>& get_synthetic_patterns();
 
     /**
      * @brief Get common patterns applicable to all providers
      */
-    static std::vector<std::regex> get_common_patterns();
+    static const std::vector<const CompiledPattern*>& get_common_patterns();
 };
 
 /**
@@ -213,10 +216,17 @@ private:
     bool streaming_active_ = false;
     std::string current_provider_;
 
-    // Pre-compiled regex patterns for performance
+    // Pre-compiled patterns for performance
     mutable std::mutex patterns_mutex_;
-    std::map<std::string, std::vector<std::regex>> provider_patterns_;
-    std::vector<std::regex> common_patterns_;
+    std::map<std::string, std::vector<const CompiledPattern*>> provider_patterns_;
+    std::vector<const CompiledPattern*> common_patterns_;
+    PatternSet pattern_set_;
+    const CompiledPattern* code_block_no_lang_ = nullptr;
+    const CompiledPattern* excess_newlines_ = nullptr;
+    const CompiledPattern* script_open_ = nullptr;
+    const CompiledPattern* script_close_ = nullptr;
+    const CompiledPattern* javascript_scheme_ = nullptr;
+    std::vector<const CompiledPattern*> injection_patterns_;
 
     // Core normalization methods
 
@@ -291,7 +301,7 @@ private:
     /**
      * @brief Get cached patterns for provider
      */
-    std::vector<std::regex> get_provider_patterns(const std::string& provider) const;
+    std::vector<const CompiledPattern*> get_provider_patterns(const std::string& provider) const;
 
     /**
      * @brief Update performance statistics
@@ -1,11 +1,11 @@
 #pragma once
 
 #include "aimux/prettifier/prettifier_plugin.hpp"
+#include "aimux/prettifier/pattern_registry.hpp"
 #include <chrono>
 #include <atomic>
 #include <memory>
 #include <string>
-#include <regex>
 
 namespace aimux {
 namespace prettifier {
@@ -305,20 +305,28 @@ private:
     bool streaming_active_ = false;
     std::chrono::steady_clock::time_point streaming_start_;
 
-    // OpenAI-specific patterns
+    // OpenAI-specific patterns, shared through the PatternRegistry
     struct OpenAIPatterns {
+        PatternSet set;
+
         // Function call patterns
-        std::regex function_call_pattern;
-        std::regex tool_calls_pattern;
-        std::regex legacy_function_pattern;
+        const CompiledPattern& function_call_pattern;
+        const CompiledPattern& tool_calls_pattern;
+        const CompiledPattern& legacy_function_pattern;
 
         // Structured output patterns
-        std::regex json_schema_pattern;
-        std::regex structured_output_pattern;
+        const CompiledPattern& json_schema_pattern;
+        const CompiledPattern& structured_output_pattern;
 
         // Streaming patterns
-        std::regex streaming_delta_pattern;
-        std::regex streaming_function_delta;
+        const CompiledPattern& streaming_delta_pattern;
+        const CompiledPattern& streaming_function_delta;
+        const CompiledPattern& sse_data_pattern;
+
+        // Repair and normalization patterns
+        const CompiledPattern& trailing_comma_pattern;
+        const CompiledPattern& artifacts_pattern;
+        const CompiledPattern& whitespace_pattern;
 
         OpenAIPatterns();
     };
@@ -341,6 +349,14 @@ private:
      */
     std::vector<ToolCall> extract_openai_function_calls(const std::string& content) const;
 
+    /**
+     * @brief Extract function calls from an already parsed response
+     *
+     * @param content_json Parsed response document
+     * @return Vector of validated tool calls
+     */
+    std::vector<ToolCall> extract_openai_function_calls(const nlohmann::json& content_json) const;
+
     /**
      * @brief Validate structured JSON output
      *
@@ -357,6 +373,17 @@ private:
         const std::string& content,
         const std::optional<nlohmann::json>& schema = std::nullopt) const;
 
+    /**
+     * @brief Validate an already parsed structured output
+     *
+     * @param json Parsed output
+     * @param schema Optional JSON schema for validation
+     * @throws std::invalid_argument if the output is not an object or misses required fields
+     */
+    void check_structured_output(
+        const nlohmann::json& json,
+        const std::optional<nlohmann::json>& schema = std::nullopt) const;
+
     /**
      * @brief Process legacy OpenAI formats
      *
@@ -381,12 +408,14 @@ private:
      *
      * @param content Processed content
      * @param tool_calls Extracted tool calls
+     * @param format_type Format detected for content
      * @param context Processing context
      * @return TOON format JSON string
      */
     std::string generate_openai_toon(
         const std::string& content,
         const std::vector<ToolCall>& tool_calls,
+        const std::string& format_type,
         const ProcessingContext& context) const;
 
     /**
@@ -450,6 +479,14 @@ private:
      */
     std::string detect_format_type(const std::string& content) const;
 
+    /**
+     * @brief Detect the format type of an already parsed response
+     *
+     * @param content_json Parsed response document
+     * @return Detected format type
+     */
+    std::string detect_format_type(const nlohmann::json& content_json) const;
+
     /**
      * @brief Clean and normalize OpenAI content
      *
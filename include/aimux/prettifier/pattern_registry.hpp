@@ -0,0 +1,172 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <shared_mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+#include <nlohmann/json.hpp>
+
+namespace aimux {
+namespace prettifier {
+
+/**
+ * @brief Result of a single pattern match
+ *
+ * Views point into the searched text and are valid only while it is.
+ * Index 0 is the whole match; non-participating groups are empty.
+ */
+struct PatternMatch {
+    std::vector<std::string_view> groups;
+    size_t position = 0;    ///< Offset of the whole match in the searched text
+
+    size_t size() const { return groups.size(); }
+    size_t length() const { return groups.empty() ? 0 : groups[0].size(); }
+    std::string str(size_t index = 0) const {
+        return index < groups.size() ? std::string(groups[index]) : std::string();
+    }
+};
+
+/**
+ * @brief Pattern compiled once and shared by every plugin that uses it
+ *
+ * Backed by RE2 (linear-time, no backtracking) when the build has it and
+ * the pattern is within RE2's syntax; otherwise by a std::regex compiled at
+ * registration. Patterns are immutable after construction, so all matching
+ * methods are safe to call concurrently. Every call is timed into per-pattern
+ * counters reported by to_json().
+ *
+ * Matching follows ECMAScript leftmost-first semantics on bytes.
+ */
+class CompiledPattern {
+public:
+    enum Flags : uint32_t {
+        NONE = 0,
+        ICASE = 1u << 0,      ///< Case-insensitive
+        MULTILINE = 1u << 1   ///< ^ and $ match at line boundaries
+    };
+
+    CompiledPattern(std::string name, std::string pattern, uint32_t flags);
+    ~CompiledPattern();
+
+    CompiledPattern(const CompiledPattern&) = delete;
+    CompiledPattern& operator=(const CompiledPattern&) = delete;
+
+    /// True if the pattern occurs anywhere in text (regex_search)
+    bool search(std::string_view text) const;
+
+    /// First occurrence with capture groups
+    bool search(std::string_view text, PatternMatch& match) const;
+
+    /// True if the pattern matches all of text (regex_match)
+    bool full_match(std::string_view text) const;
+
+    /// Full match with capture groups
+    bool full_match(std::string_view text, PatternMatch& match) const;
+
+    /**
+     * @brief Visit successive non-overlapping matches
+     * @param visitor Return false to stop early
+     * @return Number of matches visited
+     */
+    size_t for_each_match(std::string_view text,
+                          const std::function<bool(const PatternMatch&)>& visitor) const;
+
+    /**
+     * @brief Replace every match (regex_replace)
+     * @param format ECMAScript format string: $&, $1..$99 and $$ are expanded
+     */
+    std::string replace_all(std::string_view text, std::string_view format) const;
+
+    const std::string& name() const { return name_; }
+    const std::string& pattern() const { return pattern_; }
+
+    /// "re2" or "std::regex"
+    const char* engine() const;
+
+    /// Call count, match count and timing for this pattern
+    nlohmann::json to_json() const;
+
+    void reset_stats() const;
+
+private:
+    struct Engine;
+
+    bool find(std::string_view text, size_t start, bool anchor_both, PatternMatch* match) const;
+    void record(std::chrono::steady_clock::duration elapsed, bool matched) const;
+
+    std::string name_;
+    std::string pattern_;
+    uint32_t flags_;
+    std::unique_ptr<Engine> engine_;
+
+    mutable std::atomic<uint64_t> calls_{0};
+    mutable std::atomic<uint64_t> matches_{0};
+    mutable std::atomic<uint64_t> total_ns_{0};
+    mutable std::atomic<uint64_t> max_ns_{0};
+};
+
+/**
+ * @brief Process-wide cache of compiled prettifier patterns
+ *
+ * Plugins look their patterns up once at construction and keep the returned
+ * references; entries are never removed, so references stay valid for the
+ * life of the process. Identical pattern text and flags share one entry.
+ */
+class PatternRegistry {
+public:
+    static PatternRegistry& instance();
+
+    /**
+     * @brief Get or compile a pattern
+     * @param name Label used in metrics (the first registration's label wins)
+     * @param pattern ECMAScript-compatible pattern text
+     * @param flags CompiledPattern::Flags
+     */
+    const CompiledPattern& get(const std::string& name, const std::string& pattern,
+                               uint32_t flags = CompiledPattern::NONE);
+
+    /**
+     * @brief Shared content-safety patterns (XSS, code execution, SQL injection,
+     * path traversal), all case-insensitive
+     */
+    const std::vector<const CompiledPattern*>& security_patterns();
+
+    /// Number of distinct compiled patterns
+    size_t size() const;
+
+    /// Per-pattern metrics for every registered pattern
+    nlohmann::json get_metrics() const;
+
+private:
+    PatternRegistry() = default;
+
+    mutable std::shared_mutex mutex_;
+    std::unordered_map<std::string, std::unique_ptr<CompiledPattern>> patterns_;
+};
+
+/**
+ * @brief The patterns one plugin instance depends on, for its get_metrics()
+ */
+class PatternSet {
+public:
+    const CompiledPattern& add(const std::string& name, const std::string& pattern,
+                               uint32_t flags = CompiledPattern::NONE);
+
+    /// Include a pattern obtained elsewhere (e.g. a shared provider list)
+    void track(const CompiledPattern& pattern);
+
+    nlohmann::json to_json() const;
+
+private:
+    std::vector<const CompiledPattern*> patterns_;
+};
+
+} // namespace prettifier
+} // namespace aimux
@@ -390,6 +390,18 @@ protected:
      */
     std::optional<nlohmann::json> validate_json(const std::string& content) const;
 
+    /**
+     * @brief Parsed response body, reusing the response's shared parse
+     *
+     * Falls back to validate_json()'s repairs when the body is not strict JSON.
+     *
+     * @param response Response whose data is read
+     * @param repaired Holds the repaired document when one is needed
+     * @return The document, or nullptr if the body is not JSON even after repair
+     */
+    const nlohmann::json* response_json(const core::Response& response,
+                                        std::optional<nlohmann::json>& repaired) const;
+
 protected:
     // Allow derived classes to construct the base class
     PrettifierPlugin() = default;
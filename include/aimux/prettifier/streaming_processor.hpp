@@ -1,15 +1,19 @@
 #pragma once
 
 #include "aimux/prettifier/prettifier_plugin.hpp"
+#include "aimux/prettifier/chunk_pool.hpp"
+#include "aimux/core/thread_manager.hpp"
 #include <string>
+#include <string_view>
 #include <vector>
+#include <array>
 #include <memory>
 #include <chrono>
 #include <atomic>
 #include <thread>
-#include <queue>
 #include <mutex>
 #include <shared_mutex>
+#include <unordered_map>
 #include <condition_variable>
 #include <future>
 
@@ -25,7 +29,7 @@ namespace prettifier {
  * while maintaining consistent performance and resource usage.
  *
  * Key features:
- * - Async streaming chunk processing with thread pool
+ * - Async streaming chunk processing on the shared core::ThreadPool
  * - Memory-efficient TOON format generation for large responses
  * - Backpressure management for consistent performance
  * - Real-time TOON chunk assembly
@@ -40,11 +44,13 @@ namespace prettifier {
  * - Zero-copy operations where possible
  *
  * Architecture:
- * - Thread pool for concurrent processing
- * - Lock-free queues for high throughput
- * - Circular buffers for memory efficiency
- * - Adaptive chunk size handling
- * - Resource-aware scheduling
+ * - Chunks are copied once into pooled, reference-counted ChunkPool slices
+ * - Each stream owns a bounded single-producer/single-consumer ring
+ * - A stream is drained by at most one pool task at a time, in order, so
+ *   one stream's chunks never contend with another's
+ * - Completion is signalled per stream rather than polled
+ * - buffer_size_mb bounds the bytes held by all streams and
+ *   backpressure_threshold the chunks held by one
  *
  * Usage example:
  * @code
@@ -58,29 +64,61 @@ namespace prettifier {
  *
  * auto stream_id = processor->create_stream(context);
  * for (const auto& chunk : response_chunks) {
- *     processor->process_chunk(stream_id, chunk, is_final);
+ *     processor->submit_chunk(stream_id, chunk, is_final);
  * }
  * auto result = processor->get_result(stream_id);
  * @endcode
  */
 class StreamingProcessor {
 public:
+    /// Chunks a producer may run ahead of its stream's worker
+    static constexpr size_t STREAM_QUEUE_CAPACITY = 128;
+
+    /**
+     * @brief Chunk waiting in a stream's ring
+     */
+    struct QueuedChunk {
+        ChunkSlice data;
+        uint32_t enqueued_ms = 0;   // Since stream start
+        bool is_final = false;
+    };
+
     /**
      * @brief Stream context for tracking individual streaming sessions
      */
     struct StreamContext {
+        explicit StreamContext(ChunkPool& pool) : writer(pool) {}
+
         std::string stream_id;
         ProcessingContext process_context;
         std::chrono::steady_clock::time_point start_time;
         std::shared_ptr<PrettifierPlugin> formatter;
 
-        // Buffer management
-        std::vector<std::string> chunk_buffer;
+        // Producer side, guarded by producer_mutex
+        std::mutex producer_mutex;
+        ChunkWriter writer;
+        uint64_t chunks_submitted = 0;
+        bool final_submitted = false;
+
+        // Consumer side: at most one drain task owns the ring's read end
+        SpscRing<QueuedChunk> queue{STREAM_QUEUE_CAPACITY};
+        std::atomic<bool> drain_scheduled{false};
+
+        // Processed chunks, held until the stream is finalized or closed
+        std::vector<ChunkSlice> chunk_buffer;
         size_t total_bytes = 0;
         size_t total_chunks = 0;
 
+        // Chunk outcomes, guarded by context_mutex and signalled on completion_cv.
+        // Chunks run in order and a failure closes the stream, so the
+        // successful ones are always a prefix.
+        uint64_t chunks_settled = 0;
+        uint64_t chunks_succeeded = 0;
+        std::condition_variable completion_cv;
+
         // State tracking
         std::atomic<bool> is_active{true};
+        std::atomic<bool> holds_open_slot{true};    // Counted in max_concurrent_streams
         std::atomic<bool> is_finalized{false};
         std::string error_message;
 
@@ -93,19 +131,6 @@ public:
         mutable std::mutex context_mutex;
     };
 
-    /**
-     * @brief Processing task for the thread pool
-     */
-    struct ProcessingTask {
-        std::string stream_id;
-        std::string chunk_data;
-        bool is_final;
-        std::chrono::steady_clock::time_point timestamp;
-
-        // Callback for completion
-        std::promise<bool> completion_promise;
-    };
-
     /**
      * @brief Processor statistics
      */
@@ -126,17 +151,24 @@ public:
      * @brief Constructor
      *
      * Initializes the streaming processor with default configuration:
-     * - 4 worker threads
-     * - 64MB buffer pool
-     * - 1000 chunk backpressure threshold
+     * - chunks processed on core::ThreadPool::shared()
+     * - 64MB chunk memory budget
+     * - 1000 chunks held per stream
      */
     StreamingProcessor();
 
+    /**
+     * @brief Constructor processing chunks on the given pool
+     *
+     * @param pool Pool to run chunk tasks on; shared with other components
+     */
+    explicit StreamingProcessor(std::shared_ptr<core::ThreadPool> pool);
+
     /**
      * @brief Destructor
      *
-     * Gracefully shuts down the processor, waiting for all ongoing
-     * operations to complete and cleaning up resources.
+     * Gracefully shuts down the processor, waiting for its chunk tasks
+     * still queued on the pool to finish and cleaning up resources.
      */
     ~StreamingProcessor();
 
@@ -151,16 +183,38 @@ public:
      * @param context Processing context for the stream
      * @param formatter Plugin to use for processing
      * @return Unique stream identifier
+     * @throws std::invalid_argument if formatter is null
+     * @throws std::runtime_error if max_concurrent_streams streams are still accepting chunks
      */
     std::string create_stream(
         const ProcessingContext& context,
         std::shared_ptr<PrettifierPlugin> formatter);
 
+    /**
+     * @brief Queue a streaming chunk
+     *
+     * Copies the chunk into the stream's ring and returns; the stream's
+     * worker processes it in submission order. No per-chunk allocation is
+     * made once the stream's pool block and ring are warm.
+     *
+     * @param stream_id Stream identifier
+     * @param chunk Chunk data to process
+     * @param is_final True if this is the last chunk
+     * @return false if the stream is unknown or closed, or the chunk was
+     *         refused by backpressure (ring full, per-stream chunk limit or
+     *         memory budget reached)
+     */
+    bool submit_chunk(
+        const std::string& stream_id,
+        std::string_view chunk,
+        bool is_final = false);
+
     /**
      * @brief Process a streaming chunk
      *
-     * Submits a chunk for asynchronous processing. The method returns
-     * immediately while the chunk is processed in the background.
+     * submit_chunk() plus a future for the chunk's outcome. The future is
+     * deferred: it waits on the stream's completion signal when read, and
+     * costs nothing if discarded.
      *
      * @param stream_id Stream identifier
      * @param chunk Chunk data to process
@@ -176,7 +230,9 @@ public:
      * @brief Get the final processing result
      *
      * Retrieves the complete processing result for a finalized stream.
-     * Blocks if the stream is still being processed.
+     * Blocks until the stream is finalized or closed, for at most 5 seconds
+     * or until the stream timeout. Once the stream is done it is released,
+     * so the result can be retrieved once.
      *
      * @param stream_id Stream identifier
      * @return Processing result with formatted content
@@ -207,11 +263,11 @@ public:
      * @brief Configure processor settings
      *
      * Configuration options:
-     * - "thread_pool_size": number of worker threads (default: 4)
-     * - "buffer_size_mb": total buffer pool size in MB (default: 64)
-     * - "backpressure_threshold": chunks before backpressure (default: 1000)
+     * - "thread_pool_size": retained for compatibility; chunks run on the pool given at construction
+     * - "buffer_size_mb": bytes of chunk data all streams may hold, in MB (default: 64)
+     * - "backpressure_threshold": chunks one stream may hold (default: 1000)
      * - "enable_compression": enable buffer compression (default: false)
-     * - "max_concurrent_streams": maximum concurrent streams (default: 1000)
+     * - "max_concurrent_streams": maximum streams still accepting chunks (default: 1000)
      * - "chunk_timeout_ms": timeout for individual chunks (default: 5000)
      * - "stream_timeout_ms": timeout for entire stream (default: 60000)
      * - "enable_metrics": enable detailed metrics collection (default: true)
@@ -315,16 +371,27 @@ private:
     int stream_timeout_ms_ = 60000;
     bool enable_metrics_ = true;
 
-    // Thread pool
-    std::vector<std::thread> worker_threads_;
-    std::queue<ProcessingTask> task_queue_;
-    std::mutex queue_mutex_;
-    std::condition_variable queue_cv_;
+    // Chunk storage; declared before the streams so it outlives their slices
+    ChunkPool chunk_pool_{buffer_size_mb_ * 1024 * 1024};
+
+    // Stream drains run on a pool shared with other components
+    std::shared_ptr<core::ThreadPool> pool_;
     std::atomic<bool> shutdown_requested_{false};
+    std::atomic<size_t> pending_tasks_{0};
+    std::mutex pending_mutex_;
+    std::condition_variable pending_cv_;
+
+    // Stream management, sharded so lookups on different streams rarely share a lock
+    static constexpr size_t STREAM_SHARDS = 16;
+
+    struct alignas(64) StreamShard {
+        mutable std::shared_mutex mutex;
+        std::unordered_map<std::string, std::shared_ptr<StreamContext>> streams;
+    };
 
-    // Stream management
-    mutable std::shared_mutex streams_mutex_;
-    std::unordered_map<std::string, std::unique_ptr<StreamContext>> active_streams_;
+    std::array<StreamShard, STREAM_SHARDS> stream_shards_;
+    std::atomic<size_t> open_streams_{0};
+    std::atomic<int64_t> next_cleanup_ms_{0};
 
     // Statistics
     mutable std::atomic<uint64_t> total_streams_{0};
@@ -333,68 +400,77 @@ private:
     mutable std::atomic<uint64_t> total_chunks_processed_{0};
     mutable std::atomic<uint64_t> total_bytes_processed_{0};
     mutable std::atomic<uint64_t> backpressure_events_{0};
-    mutable std::atomic<size_t> current_memory_usage_{0};
 
     // Performance tracking
     std::chrono::steady_clock::time_point start_time_;
 
-    // Buffer pool management
-    struct BufferPool {
-        std::vector<std::unique_ptr<char[]>> buffers;
-        std::queue<char*> available_buffers;
-        std::mutex pool_mutex;
-        size_t buffer_size;
-        size_t total_buffers;
-    };
+    // Private helper methods
 
-    BufferPool buffer_pool_;
+    /**
+     * @brief Copy a chunk into the stream's ring and make sure a drain is scheduled
+     *
+     * @param sequence Set to the chunk's position in the stream when accepted
+     */
+    bool enqueue_chunk(const std::shared_ptr<StreamContext>& stream,
+                       std::string_view chunk, bool is_final, uint64_t* sequence);
 
-    // Private helper methods
+    /**
+     * @brief Post a drain for the stream unless one is already pending
+     */
+    void schedule_drain(const std::shared_ptr<StreamContext>& stream);
 
     /**
-     * @brief Initialize the thread pool
+     * @brief Process the stream's queued chunks in order on a pool worker
      */
-    void initialize_thread_pool();
+    void drain_stream(const std::shared_ptr<StreamContext>& stream);
 
     /**
-     * @brief Worker thread main function
+     * @brief Process one chunk and record its outcome
      */
-    void worker_thread_main();
+    void run_chunk(StreamContext& stream, QueuedChunk& chunk);
 
     /**
-     * @brief Process a single task
+     * @brief Run the formatter over one chunk
      */
-    bool process_task(const ProcessingTask& task);
+    bool process_queued_chunk(StreamContext& stream, QueuedChunk& chunk);
 
     /**
-     * @brief Handle stream finalization
+     * @brief Settle every chunk still queued as failed
      */
-    void finalize_stream(StreamContext& stream);
+    void discard_queued_chunks(StreamContext& stream);
 
     /**
-     * @brief Generate TOON format for accumulated data
+     * @brief Mark a drain task finished and wake the destructor if it was the last
      */
-    std::string generate_streaming_toon(StreamContext& stream);
+    void finish_pending_task();
 
     /**
-     * @brief Apply backpressure if necessary
+     * @brief Handle stream finalization
      */
-    bool apply_backpressure(const std::string& stream_id);
+    void finalize_stream(StreamContext& stream);
 
     /**
-     * @brief Get buffer from pool
+     * @brief Stop counting the stream against max_concurrent_streams
+     *
+     * Called once its final chunk is queued or it is closed; the work still
+     * queued is bounded by the stream's ring and the memory budget.
      */
-    char* get_buffer_from_pool();
+    void release_open_slot(StreamContext& stream);
 
     /**
-     * @brief Return buffer to pool
+     * @brief Close an open stream and release its chunk storage
+     *
+     * Caller must hold stream.context_mutex.
+     *
+     * @param error Recorded as the stream's error and counted as a failure unless empty
+     * @return false if the stream was already closed
      */
-    void return_buffer_to_pool(char* buffer);
+    bool close_stream(StreamContext& stream, const std::string& error);
 
     /**
-     * @brief Initialize buffer pool
+     * @brief Generate TOON format for accumulated data
      */
-    void initialize_buffer_pool();
+    std::string generate_streaming_toon(StreamContext& stream);
 
     /**
      * @brief Update performance metrics
@@ -403,6 +479,9 @@ private:
 
     /**
      * @brief Clean up expired streams
+     *
+     * Drops finished streams nobody collected within the stream timeout and
+     * closes open ones idle for twice that.
      */
     void cleanup_expired_streams();
 
@@ -411,6 +490,13 @@ private:
      */
     std::shared_ptr<StreamContext> get_stream_context(const std::string& stream_id) const;
 
+    /**
+     * @brief Remove a stream from its shard
+     */
+    void erase_stream(const std::string& stream_id);
+
+    static size_t shard_index(const std::string& stream_id);
+
     /**
      * @brief Create unique stream identifier
      */
@@ -1,10 +1,14 @@
 #pragma once
 
 #include "aimux/prettifier/prettifier_plugin.hpp"
-#include <regex>
+#include "aimux/prettifier/pattern_registry.hpp"
+#include "aimux/prettifier/tool_call_scanner.hpp"
 #include <chrono>
 #include <atomic>
+#include <map>
+#include <memory>
 #include <optional>
+#include <string_view>
 
 namespace aimux {
 namespace prettifier {
@@ -106,7 +110,7 @@ public:
      * Cerebras often uses fast JSON-based tool calls with minimal formatting.
      * Pattern: {"tool_calls": [{"name": "...", "arguments": "..."}]}
      */
-    static std::vector<std::regex> get_cerebras_patterns();
+    static const std::vector<const CompiledPattern*>& get_cerebras_patterns();
 
     /**
      * @brief Get OpenAI tool call patterns
@@ -114,7 +118,7 @@ public:
      * OpenAI uses structured function calling format with JSON.
      * Pattern: {"function": {"name": "...", "arguments": "..."}}
      */
-    static std::vector<std::regex> get_openai_patterns();
+    static const std::vector<const CompiledPattern*>& get_openai_patterns();
 
     /**
      * @brief Get Anthropic tool call patterns
@@ -122,7 +126,7 @@ public:
      * Anthropic uses XML-based tool calls in Claude format.
      * Pattern: <function_calls><invoke name="...">...args...</invoke></function_calls>
      */
-    static std::vector<std::regex> get_anthropic_patterns();
+    static const std::vector<const CompiledPattern*>& get_anthropic_patterns();
 
     /**
      * @brief Get Synthetic tool call patterns
@@ -130,12 +134,12 @@ public:
      * Synthetic uses mixed formats for testing and diagnostics.
      * Pattern: Multiple formats including JSON, XML, and text.
      */
-    static std::vector<std::regex> get_synthetic_patterns();
+    static const std::vector<const CompiledPattern*>& get_synthetic_patterns();
 
     /**
      * @brief Get common tool call patterns applicable to all providers
      */
-    static std::vector<std::regex> get_common_patterns();
+    static const std::vector<const CompiledPattern*>& get_common_patterns();
 };
 
 /**
@@ -144,6 +148,12 @@ public:
  * Extracts tool calls from AI responses with security validation and error recovery.
  * Supports multiple JSON/XML patterns and provider-specific formats.
  *
+ * Extraction is a single pass of ToolCallScanner over the content. In
+ * streaming mode the scanner state survives between chunks, and each tool
+ * call is reported in the result of the chunk that completes it. Calls
+ * whose arguments arrive as deltas (OpenAI tool_calls deltas, Anthropic
+ * input_json_delta events) are assembled until their block finishes.
+ *
  * Performance targets:
  * - <20ms for 50 tool calls
  * - <2ms for typical single tool call
@@ -205,18 +215,43 @@ public:
     nlohmann::json get_diagnostics() const override;
 
 private:
+    /**
+     * @brief Resumable extraction state for one response or stream
+     */
+    struct ExtractionState {
+        /// Tool call whose arguments are still arriving as deltas
+        struct PendingCall {
+            std::string id;
+            std::string name;
+            std::string arguments;
+        };
+
+        ToolCallScanner scanner;
+        std::vector<ToolCallScanner::Segment> segments;
+        std::map<std::string, PendingCall> pending;    // Keyed by provider block index
+        std::vector<ToolCall> completed;
+
+        ExtractionState(uint32_t formats, size_t max_segment_size)
+            : scanner(formats, max_segment_size) {}
+    };
+
     ToolCallExtractorConfig config_;
     mutable ToolCallExtractorStats stats_;
 
     // Streaming state
-    std::string streaming_buffer_;
+    std::unique_ptr<ExtractionState> streaming_state_;
+    size_t streaming_reported_ = 0;    // Calls already returned from process_streaming_chunk
     bool streaming_active_ = false;
     std::string current_provider_;
 
-    // Pre-compiled regex patterns for performance
+    // Pre-compiled patterns for performance
     mutable std::mutex patterns_mutex_;
-    std::map<std::string, std::vector<std::regex>> provider_patterns_;
-    std::vector<std::regex> common_patterns_;
+    std::map<std::string, std::vector<const CompiledPattern*>> provider_patterns_;
+    std::vector<const CompiledPattern*> common_patterns_;
+    PatternSet pattern_set_;
+    const CompiledPattern* sql_or_ = nullptr;
+    const CompiledPattern* path_traversal_ = nullptr;
+    std::vector<const CompiledPattern*> malicious_patterns_;
 
     // Core extraction methods
 
@@ -228,21 +263,43 @@ private:
         const std::string& provider) const;
 
     /**
-     * @brief Provider-specific extraction
+     * @brief Scanner formats to recognize for a provider
      */
-    std::vector<ToolCall> extract_provider_tool_calls(
-        const std::string& content,
-        const std::string& provider) const;
+    uint32_t formats_for_provider(const std::string& provider) const;
+
+    /**
+     * @brief Scan the next piece of content and resolve closed segments
+     */
+    void feed_extraction(ExtractionState& state, std::string_view content) const;
+
+    /**
+     * @brief End of content: flush calls still assembling from deltas
+     */
+    void finish_extraction(ExtractionState& state) const;
+
+    /**
+     * @brief Parse one JSON segment, recovering nested objects if it is malformed
+     */
+    void handle_json_segment(ExtractionState& state, const std::string& text, int depth = 0) const;
 
     /**
-     * @brief Extract JSON tool calls
+     * @brief Collect tool calls from a parsed JSON value
+     *
+     * Understands bare calls ({"name", "arguments"|"input"}, {"function"},
+     * {"tool"}), tool_calls/functions arrays, chat completion responses and
+     * deltas, Anthropic messages and Anthropic streaming events.
      */
-    std::vector<ToolCall> extract_json_tool_calls(const std::string& content) const;
+    void resolve_json(ExtractionState& state, const nlohmann::json& json) const;
 
     /**
-     * @brief Extract XML tool calls
+     * @brief Complete pending delta calls whose key starts with prefix
      */
-    std::vector<ToolCall> extract_xml_tool_calls(const std::string& content) const;
+    void flush_pending(ExtractionState& state, const std::string& prefix) const;
+
+    /**
+     * @brief Append a call if it validated and the count limit allows
+     */
+    void add_tool_call(ExtractionState& state, std::optional<ToolCall> tool) const;
 
     /**
      * @brief Parse structured tool call from JSON object
@@ -251,8 +308,12 @@ private:
 
     /**
      * @brief Parse tool call from XML element
+     *
+     * <invoke name="..."> takes its parameters from <parameter name="..."> children;
+     * <tool_use> and <function_call> bodies are read as JSON when they parse.
      */
-    std::optional<ToolCall> parse_tool_call_from_xml(const std::string& xml_element) const;
+    std::optional<ToolCall> parse_tool_call_from_xml(const std::string& tag,
+                                                     const std::string& xml_element) const;
 
     // Security and validation methods
 
@@ -276,18 +337,6 @@ private:
      */
     std::string sanitize_tool_arguments(const std::string& arguments) const;
 
-    // Error recovery methods
-
-    /**
-     * @brief Attempt to recover from JSON parse errors
-     */
-    std::vector<ToolCall> recover_from_json_error(const std::string& content) const;
-
-    /**
-     * @brief Attempt to recover from XML parse errors
-     */
-    std::vector<ToolCall> recover_from_xml_error(const std::string& content) const;
-
     // Performance optimization
 
     /**
@@ -298,7 +347,7 @@ private:
     /**
      * @brief Get cached patterns for provider
      */
-    std::vector<std::regex> get_provider_patterns(const std::string& provider) const;
+    std::vector<const CompiledPattern*> get_provider_patterns(const std::string& provider) const;
 
     /**
      * @brief Update performance statistics
@@ -319,8 +368,9 @@ private:
 
     /**
      * @brief Process partial content in streaming mode
+     * @return Tool calls completed by this chunk
      */
-    std::string process_streaming_extraction(const std::string& chunk, bool is_final);
+    std::vector<ToolCall> process_streaming_extraction(const std::string& chunk, bool is_final);
 
     // Utility methods
 
@@ -0,0 +1,111 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace aimux {
+namespace prettifier {
+
+/**
+ * @brief Incremental single-pass recognizer for tool-call candidates
+ *
+ * Finds the spans of text that can carry tool calls:
+ * - balanced top-level JSON objects, string- and escape-aware
+ * - <tool_use>, <invoke> and <function_call> XML elements
+ *
+ * Input may arrive in any number of pieces (for example SSE chunks). All
+ * state needed to resume mid-object or mid-tag is kept between feed()
+ * calls, so every byte is examined exactly once and each segment is
+ * reported as soon as its closing brace or closing tag arrives.
+ * Interpreting a segment (JSON parsing, attribute extraction) is left to
+ * the caller.
+ *
+ * Not thread-safe; use one scanner per stream.
+ *
+ * @since v2.0.0
+ */
+class ToolCallScanner {
+public:
+    enum Format : uint32_t {
+        JSON = 1u << 0,
+        XML = 1u << 1,
+        ALL = JSON | XML
+    };
+
+    /**
+     * @brief A closed candidate span
+     */
+    struct Segment {
+        enum class Kind { JSON_OBJECT, XML_ELEMENT };
+
+        Kind kind = Kind::JSON_OBJECT;
+        std::string tag;        ///< Element name for XML_ELEMENT, empty for JSON
+        std::string text;       ///< Complete span, including braces or tags
+        uint64_t offset = 0;    ///< Stream offset of the first byte
+    };
+
+    static constexpr size_t DEFAULT_MAX_SEGMENT_SIZE = 1024 * 1024;
+
+    explicit ToolCallScanner(uint32_t formats = ALL,
+                             size_t max_segment_size = DEFAULT_MAX_SEGMENT_SIZE);
+
+    /**
+     * @brief Scan the next piece of the stream
+     * @param out Segments closed within this piece are appended in stream order
+     */
+    void feed(std::string_view text, std::vector<Segment>& out);
+
+    /**
+     * @brief End of stream; discards any unterminated segment
+     * @return True if a segment was left open
+     */
+    bool finish();
+
+    /// Forget all state and start a new stream
+    void reset();
+
+    /// True while inside an unterminated JSON object or XML element
+    bool in_segment() const { return state_ != State::TEXT; }
+
+    /// True while inside an unterminated XML element
+    bool in_element() const { return state_ == State::XML_BODY; }
+
+    /// Bytes held for the open segment
+    size_t buffered() const { return buffer_.size(); }
+
+    /// Segments dropped for exceeding the size limit
+    uint64_t oversized_segments() const { return oversized_; }
+
+private:
+    enum class State {
+        TEXT,           // Looking for '{' or '<'
+        JSON_START,     // After '{', expecting '"' or '}' (whitespace allowed)
+        JSON_BODY,      // Inside an object, outside strings
+        JSON_STRING,    // Inside a string literal
+        JSON_ESCAPE,    // After a backslash in a string literal
+        TAG_NAME,       // After '<', reading an element name
+        XML_BODY        // Inside a recognized element, looking for its closing tag
+    };
+
+    void begin_segment(uint64_t offset, char first);
+    void abandon_segment();
+    bool over_limit(size_t pending) const { return buffer_.size() + pending > max_segment_size_; }
+
+    uint32_t formats_;
+    size_t max_segment_size_;
+
+    State state_ = State::TEXT;
+    std::string buffer_;        // Open segment text
+    uint64_t segment_offset_ = 0;
+    uint64_t position_ = 0;     // Stream offset of the next byte
+    uint32_t depth_ = 0;        // Combined {} / [] nesting depth
+    std::string tag_;           // Element name being read or matched
+    std::string closing_tag_;   // "</name>" for the open element
+    size_t closing_matched_ = 0;
+    uint64_t oversized_ = 0;
+};
+
+} // namespace prettifier
+} // namespace aimux
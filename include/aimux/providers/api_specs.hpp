@@ -133,6 +133,7 @@ namespace timeouts {
     constexpr std::chrono::milliseconds CONNECTION_TIMEOUT{30000};  // 30 seconds
     constexpr std::chrono::milliseconds REQUEST_TIMEOUT{120000};     // 2 minutes
     constexpr std::chrono::milliseconds RATE_LIMIT_RETRY{60000};     // 1 minute
+    constexpr std::chrono::milliseconds HEALTH_PROBE{5000};          // 5 seconds
 }
 
 // Provider configuration validation
@@ -1,16 +1,37 @@
 #pragma once
 
+#include <atomic>
 #include <string>
 #include <vector>
 #include <memory>
 #include <map>
+#include <optional>
 #include <random>
+#include <chrono>
 #include <nlohmann/json.hpp>
 #include "aimux/core/bridge.hpp"
+#include "aimux/core/rate_limiter.hpp"
+#include "aimux/network/http_client.hpp"
+#include "aimux/security/advanced_crypto.hpp"
 
 namespace aimux {
 namespace providers {
 
+/**
+ * @brief Backoff schedule for BaseProvider::send_with_retries()
+ *
+ * 5xx responses and transport failures wait base_delay * 2^attempt, capped
+ * at max_delay and jittered between half and the full value so concurrent
+ * callers do not retry in lockstep. 429 responses honour Retry-After,
+ * falling back to rate_limit_delay.
+ */
+struct RetryPolicy {
+    int max_attempts = 3;
+    std::chrono::milliseconds base_delay{500};
+    std::chrono::milliseconds max_delay{8000};
+    std::chrono::milliseconds rate_limit_delay{1000};
+};
+
 /**
  * @brief Base provider implementation
  */
@@ -19,39 +40,157 @@ public:
     explicit BaseProvider(const std::string& name, const nlohmann::json& config);
     virtual ~BaseProvider() = default;
 
+    /**
+     * @brief Send on the shared event loop; the callback runs on the loop thread
+     *
+     * Uses build_http_request() and process_response() with the same retries
+     * as send_with_retries(). Providers without an HTTP endpoint fall back to
+     * a blocking send_request().
+     */
+    void send_request_async(const core::Request& request, core::ResponseCallback on_complete) override;
+
+    /**
+     * @brief Probe the provider with a bodiless GET on the pooled client
+     *
+     * Requests endpoint_ + health_probe_path_ with only the cached
+     * authenticated headers; no request body is formatted. Providers without
+     * an HTTP client or a probe path fall back to Bridge::probe_health().
+     */
+    core::Response probe_health() override;
+
+    /**
+     * @brief Same probe on the shared event loop; the callback runs on the loop thread
+     */
+    void probe_health_async(core::ResponseCallback on_complete) override;
+
 protected:
     std::string provider_name_;
     nlohmann::json config_;
-    bool is_healthy_ = true;
+    std::atomic<bool> is_healthy_{true};
     std::string encrypted_api_key_;
     std::string api_key_hash_;
     std::string endpoint_;
+
+    // Path under endpoint_ for active probes ("health_probe_path"); empty means no HTTP probe
+    std::string health_probe_path_;
+
+    /**
+     * @brief Request headers rendered once per credential epoch
+     *
+     * The decrypted key is kept only inside the mlock'd Authorization value.
+     */
+    struct AuthHeaders {
+        aimux::security::SecureString authorization;                // "Bearer <key>"
+        std::vector<std::pair<std::string, std::string>> headers;   // Sent after Authorization
+        uint64_t epoch = 0;                                         // AdvancedCrypto::credential_epoch()
+    };
+    mutable std::atomic<std::shared_ptr<const AuthHeaders>> auth_headers_;
+
+    // Long-lived HTTP client keyed by provider and endpoint (warm connections)
+    std::shared_ptr<network::HttpClient> http_client_;
+    std::chrono::milliseconds request_timeout_{120000};
     
-    // Rate limiting
-    int requests_made_ = 0;
+    // Rate limiting: one GCRA budget per provider and API key, shared by every instance
     int max_requests_per_minute_ = 60;
-    std::chrono::steady_clock::time_point rate_limit_reset_;
+    std::shared_ptr<core::RateLimiter> rate_limiter_;
 
-    // Health tracking
-    int consecutive_failures_ = 0;
-    std::chrono::steady_clock::time_point last_failure_time_;
+    // Health tracking; updated from callers' threads and the curl event loop
+    std::atomic<int> consecutive_failures_{0};
+    std::atomic<std::chrono::steady_clock::time_point> last_failure_time_{};
     std::chrono::seconds recovery_delay_ = std::chrono::seconds(300); // 5 minutes default
     
     /**
-     * @brief Check rate limit before making request
-     * @return true if request allowed
+     * @brief Take one request from the shared rate budget
+     * @return true if request allowed; false means answer with a local 429
      */
     bool check_rate_limit();
-    
+
+    /**
+     * @brief Attach the shared limiter for this provider's API key at max_requests_per_minute_
+     *
+     * Honours "rate_limit_burst" from the config (defaults to a minute's worth).
+     */
+    void init_rate_limiter();
+
     /**
-     * @brief Update rate limit after request
+     * @brief Fill the rate-limit fields of get_rate_limit_status()
      */
-    void update_rate_limit();
+    void add_rate_limit_status(nlohmann::json& status) const;
 
     /**
      * @brief Check if provider should recover from unhealthy state
      */
     void check_recovery();
+
+    /**
+     * @brief Attach the shared keyed HTTP client for this provider's endpoint
+     *
+     * Honours "timeout_ms" (request timeout), "connect_timeout_ms" and
+     * "max_connections" (falling back to "max_concurrent_requests") from the
+     * config; unset values keep the api_specs defaults.
+     */
+    void init_http_client();
+
+    /**
+     * @brief Send an HTTP request, retrying 429, 5xx and transport failures
+     *
+     * Attempts run on the shared CurlMultiEngine event loop and the waits
+     * between them are engine timers, so no thread sleeps during backoff;
+     * the caller only blocks for the final outcome. Stops retrying as soon
+     * as the calling thread's core::current_cancellation() token fires.
+     *
+     * @return The last response received
+     */
+    network::HttpResponse send_with_retries(const network::HttpRequest& http_request,
+                                            const RetryPolicy& policy = {});
+
+    /**
+     * @brief send_with_retries() without the wait: @p on_complete gets the last response
+     *
+     * The callback runs on the event loop thread and must not block.
+     */
+    void send_with_retries_async(const network::HttpRequest& http_request,
+                                 std::function<void(network::HttpResponse)> on_complete,
+                                 const RetryPolicy& policy = {});
+
+    /**
+     * @brief Build the upstream HTTP request for a provider call
+     * @param request Incoming request
+     * @param http_request Filled with URL, headers, body and timeout
+     * @return false if this provider has no HTTP endpoint (no async transport)
+     */
+    virtual bool build_http_request(const core::Request& request, network::HttpRequest& http_request);
+
+    /**
+     * @brief Set @p http_request's headers to the provider's authenticated header list
+     *
+     * The API key is decrypted and the list rendered on first use, then reused
+     * until AdvancedCrypto::rotate_master_key() advances the credential epoch.
+     */
+    void apply_auth_headers(network::HttpRequest& http_request) const;
+
+    /**
+     * @brief The bodiless, authenticated GET sent by probe_health() and probe_health_async()
+     */
+    network::HttpRequest build_probe_request() const;
+
+    /**
+     * @brief Map a probe's HTTP outcome to the response the health monitor records
+     */
+    core::Response make_probe_response(const network::HttpResponse& http_response) const;
+
+    /**
+     * @brief Non-secret headers sent after Authorization on every request
+     *
+     * Rendered into the cached list by apply_auth_headers(); the default adds
+     * Content-Type and User-Agent.
+     */
+    virtual void add_request_headers(std::vector<std::pair<std::string, std::string>>& headers) const;
+
+    /**
+     * @brief Map an exception thrown during a provider call to an error response
+     */
+    virtual core::Response make_exception_response(const std::exception& e);
     
     /**
      * @brief Process API response into standard format
@@ -74,6 +213,10 @@ public:
     std::string get_provider_name() const override;
     nlohmann::json get_rate_limit_status() const override;
 
+protected:
+    bool build_http_request(const core::Request& request, network::HttpRequest& http_request) override;
+    core::Response make_exception_response(const std::exception& e) override;
+
 private:
     /**
      * @brief Format request for Cerebras API
@@ -94,11 +237,22 @@ public:
     explicit ZaiProvider(const nlohmann::json& config);
     
     core::Response send_request(const core::Request& request) override;
+    void send_request_async(const core::Request& request, core::ResponseCallback on_complete) override;
     bool is_healthy() const override;
     std::string get_provider_name() const override;
     nlohmann::json get_rate_limit_status() const override;
 
+protected:
+    bool build_http_request(const core::Request& request, network::HttpRequest& http_request) override;
+    core::Response make_exception_response(const std::exception& e) override;
+
 private:
+    /**
+     * @brief Validate request structure before it is sent to Z.AI
+     * @return Error response if invalid, std::nullopt otherwise
+     */
+    std::optional<core::Response> validate_zai_request(const core::Request& request) const;
+
     /**
      * @brief Format request for Z.AI API
      */
@@ -127,6 +281,14 @@ public:
     std::string get_provider_name() const override;
     nlohmann::json get_rate_limit_status() const override;
 
+protected:
+    bool build_http_request(const core::Request& request, network::HttpRequest& http_request) override;
+
+    /**
+     * @brief Adds the MiniMax Group ID ahead of the default headers
+     */
+    void add_request_headers(std::vector<std::pair<std::string, std::string>>& headers) const override;
+
 private:
     std::string group_id_;  // MiniMax specific Group ID
 
@@ -135,11 +297,6 @@ private:
      */
     std::string format_minimax_request(const core::Request& request);
 
-    /**
-     * @brief Handle MiniMax-specific authentication headers
-     */
-    std::map<std::string, std::string> get_auth_headers() const;
-
     /**
      * @brief Parse MiniMax API response
      */
@@ -161,6 +318,7 @@ public:
 private:
     std::mt19937 rng_;  // Random number generator
     std::vector<std::string> response_variations_;
+    std::atomic<int> requests_served_{0};
     
     /**
      * @brief Generate AI-like response
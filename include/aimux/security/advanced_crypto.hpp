@@ -1,23 +1,117 @@
 #pragma once
 
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <mutex>
 #include <string>
+#include <string_view>
+#include <unordered_map>
 #include <vector>
-#include <memory>
-#include <chrono>
 #include <openssl/evp.h>
 #include <openssl/rand.h>
 #include <openssl/sha.h>
-#include <openssl/pbkdf2.h>
 
 namespace aimux {
 namespace security {
 
+/**
+ * @brief Utility class for secure string handling
+ *
+ * The value lives in its own anonymous mapping that is mlock()ed so it is
+ * never written to swap and excluded from core dumps where the platform
+ * supports it. Each string owns whole pages, so releasing one never unlocks
+ * another. If the lock is refused (RLIMIT_MEMLOCK) the value is still kept
+ * and wiped on destruction; is_locked() reports the outcome.
+ *
+ * Move-only: copies would leave unlocked duplicates behind.
+ */
+class SecureString {
+public:
+    SecureString() = default;
+
+    /**
+     * @brief Create secure string from regular string
+     *
+     * @param str Source string
+     */
+    explicit SecureString(const std::string& str);
+
+    /**
+     * @brief Create secure string from raw bytes
+     *
+     * @param data Source bytes
+     * @param size Number of bytes
+     */
+    SecureString(const char* data, size_t size);
+
+    /**
+     * @brief Destructor - securely clears, unlocks and unmaps memory
+     */
+    ~SecureString();
+
+    SecureString(SecureString&& other) noexcept;
+    SecureString& operator=(SecureString&& other) noexcept;
+    SecureString(const SecureString&) = delete;
+    SecureString& operator=(const SecureString&) = delete;
+
+    /**
+     * @brief Get string value (use with caution)
+     *
+     * @return Copy of the value in ordinary, unlocked memory
+     */
+    std::string get() const;
+
+    /**
+     * @brief Borrow the value without copying it out of locked memory
+     *
+     * @return View valid for the lifetime of this object
+     */
+    std::string_view view() const noexcept;
+
+    /**
+     * @brief Check if string is empty
+     *
+     * @return True if empty
+     */
+    bool empty() const;
+
+    /**
+     * @brief Get string length
+     *
+     * @return String length
+     */
+    size_t size() const;
+
+    /**
+     * @brief Whether the value is pinned in RAM by mlock()
+     */
+    bool is_locked() const noexcept;
+
+private:
+    void release() noexcept;
+
+    char* data_ = nullptr;
+    size_t size_ = 0;
+    size_t mapped_ = 0;     // Whole pages owned by this string
+    bool locked_ = false;
+};
+
 /**
  * @brief Advanced cryptographic utilities for secure API key management
  *
  * This class provides AES-256-GCM encryption for API keys with secure key derivation
  * using PBKDF2. It includes key rotation capabilities and hardware security module
  * (HSM) integration readiness.
+ *
+ * PBKDF2 runs once per master key and salt: each master key carries its own
+ * salt, reused for every encryption under it (the IV stays random per call),
+ * and derived keys are cached in SecureString memory. rotate_master_key()
+ * wipes the cache and advances credential_epoch(), which holders of
+ * decrypted credentials compare against to know when to rebuild them.
+ *
+ * All methods are thread-safe.
  */
 class AdvancedCrypto {
 public:
@@ -103,6 +197,18 @@ public:
      */
     void rotate_master_key(int grace_period_hours = 24);
 
+    /**
+     * @brief Process-wide counter advanced by every rotate_master_key()
+     *
+     * @return Current epoch; a changed value means cached credentials are stale
+     */
+    static uint64_t credential_epoch() noexcept;
+
+    /**
+     * @brief Number of PBKDF2 derivations run by this instance (cache misses)
+     */
+    uint64_t derivation_count() const noexcept;
+
     /**
      * @brief Generate a cryptographically secure random key
      *
@@ -185,13 +291,20 @@ public:
 private:
     struct KeyInfo {
         std::vector<uint8_t> key;
+        std::vector<uint8_t> salt;      // Used for every encryption under this key
         KeyMetadata metadata;
     };
 
+    mutable std::mutex mutex_;          // Guards all state below, including cipher_ctx_
     std::vector<uint8_t> master_key_;
     std::vector<KeyInfo> key_history_;  // For key rotation support
     std::unique_ptr<EVP_CIPHER_CTX, void(*)(EVP_CIPHER_CTX*)> cipher_ctx_;
 
+    // Derived keys by key ID and salt; wiped on rotation and when full
+    std::unordered_map<std::string, SecureString> derived_keys_;
+    std::atomic<uint64_t> derivations_{0};
+    static constexpr size_t MAX_DERIVED_KEYS = 64;
+
     std::string current_key_id_;
     static const int AES_KEY_SIZE = 32;  // 256 bits
     static const int IV_SIZE = 12;       // 96 bits for GCM
@@ -223,62 +336,35 @@ private:
     );
 
     /**
-     * @brief Securely clear memory
+     * @brief Cached derive_encryption_key() for a known master key (call with mutex_ held)
      *
-     * @param data Data to clear
-     * @param length Length of data in bytes
-     */
-    static void secure_clear(void* data, size_t length);
-
-    /**
-     * @brief Generate unique key ID
-     *
-     * @return Unique identifier for key
-     */
-    std::string generate_key_id() const;
-};
-
-/**
- * @brief Utility class for secure string handling
- */
-class SecureString {
-public:
-    /**
-     * @brief Create secure string from regular string
-     *
-     * @param str Source string
-     */
-    explicit SecureString(const std::string& str);
-
-    /**
-     * @brief Destructor - securely clears memory
+     * @param key_info Master key to derive from
+     * @param salt Salt for derivation
+     * @return Derived key, valid until the cache is next modified
      */
-    ~SecureString();
+    const SecureString& cached_encryption_key(const KeyInfo& key_info, const std::vector<uint8_t>& salt);
 
     /**
-     * @brief Get string value (use with caution)
+     * @brief Add a fresh master key with its own salt as the current key (call with mutex_ held)
      *
-     * @return String value
+     * @param version Key version number
      */
-    std::string get() const;
+    void add_master_key(int version);
 
     /**
-     * @brief Check if string is empty
+     * @brief Securely clear memory
      *
-     * @return True if empty
+     * @param data Data to clear
+     * @param length Length of data in bytes
      */
-    bool empty() const;
+    static void secure_clear(void* data, size_t length);
 
     /**
-     * @brief Get string length
+     * @brief Generate unique key ID
      *
-     * @return String length
+     * @return Unique identifier for key
      */
-    size_t size() const;
-
-private:
-    std::unique_ptr<char[]> data_;
-    size_t size_;
+    std::string generate_key_id() const;
 };
 
 } // namespace security
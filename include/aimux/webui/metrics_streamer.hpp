@@ -12,9 +12,11 @@
 #include <deque>
 #include <unordered_map>
 #include <unordered_set>
+#include <vector>
 #include <functional>
 #include <crow.h>
 #include <nlohmann/json.hpp>
+#include "aimux/metrics/columnar_tsdb.hpp"
 
 namespace aimux {
 namespace webui {
@@ -243,6 +245,26 @@ struct HistoricalData {
     }
 };
 
+/**
+ * @brief What a WebSocket client asked to receive with a "subscribe" message
+ *
+ * Clients that never subscribe get every section as a full
+ * "comprehensive_metrics" frame on each broadcast.
+ *
+ * @since v2.0.0
+ */
+struct StreamSubscription {
+    std::vector<std::string> sections;    // "providers", "system", "historical"; empty = all
+    std::vector<std::string> providers;   // Provider names; empty = all
+    bool delta = false;                   // "metrics_delta" frames between keyframes
+    bool ack = false;                     // Client acks frames, enabling slow-consumer dropping
+
+    /// Subscriptions with equal keys receive the same serialised frames
+    std::string key() const;
+
+    static StreamSubscription from_json(const nlohmann::json& j);
+};
+
 /**
  * @brief WebSocket connection information
  */
@@ -256,6 +278,14 @@ struct WebSocketConnection {
     bool authenticated = false;
     std::string client_info;
 
+    // Broadcast state, guarded by state_mutex
+    std::mutex state_mutex;
+    StreamSubscription subscription;
+    std::string subscription_key;
+    uint64_t last_frame_seq = 0;          // Broadcast the client is in sync with (0 = none)
+    bool needs_keyframe = true;
+    std::deque<uint64_t> unacked_frames;  // Sequence numbers sent but not yet acked
+
     WebSocketConnection(crow::websocket::connection* conn, const std::string& id)
         : connection(conn), connection_id(id), connect_time(std::chrono::steady_clock::now()),
           last_ping(std::chrono::steady_clock::now()) {}
@@ -271,10 +301,14 @@ struct MetricsStreamerConfig {
     uint32_t connection_timeout_ms = 30000;     // Connection timeout
     uint32_t max_message_queue_size = 1000;     // Max queued messages per connection
     bool enable_delta_compression = true;       // Use delta compression for updates
+    uint32_t keyframe_interval = 30;            // Delta subscribers get a full frame every N broadcasts
+    uint32_t max_unacked_frames = 8;            // Acking clients this far behind are skipped until they ack
     bool enable_authentication = false;         // Require WebSocket authentication
     std::string auth_token = "";               // Authentication token
     uint32_t history_retention_minutes = 60;    // Historical data retention
     bool enable_performance_monitoring = true;  // Track internal performance
+    std::string history_store_path = "";        // Persist per-provider history here ("" = memory only)
+    uint32_t history_store_retention_hours = 168;
 };
 
 /**
@@ -286,6 +320,22 @@ struct MetricsStreamerConfig {
  * - Historical data buffering for trend analysis
  * - Configurable performance optimization
  * - Professional error handling and recovery
+ *
+ * Each broadcast builds one snapshot and serialises it once per distinct
+ * subscription; every client with that subscription is sent the same
+ * buffer. Nothing is built while no client is connected.
+ *
+ * Client messages:
+ * - {"type":"subscribe","sections":[...],"providers":[...],"delta":true,"ack":true}
+ *   narrows what is sent. With "delta" (and enable_delta_compression) the
+ *   client gets a full "comprehensive_metrics" keyframe, then
+ *   "metrics_delta" frames whose "changes" member is a JSON merge patch
+ *   (RFC 7386) against the previous broadcast; unchanged broadcasts are not
+ *   sent at all. Keyframes follow every keyframe_interval broadcasts and
+ *   after any gap.
+ * - {"type":"ack","seq":N} confirms frames up to N. Clients that subscribed
+ *   with "ack" and have max_unacked_frames outstanding are skipped (counted
+ *   in messages_dropped) and resume with a keyframe once they ack.
  */
 class MetricsStreamer {
 public:
@@ -355,6 +405,21 @@ public:
      */
     HistoricalData get_historical_data() const;
 
+    /**
+     * @brief Whether per-provider history is persisted (history_store_path set)
+     */
+    bool has_history_store() const;
+
+    /**
+     * @brief Per-provider latency and success history from the history store
+     *
+     * Covers the last @p span in @p step wide windows, optionally for one
+     * provider only. Returns an empty "points" array without a store.
+     */
+    nlohmann::json query_history(const std::string& provider,
+                                 std::chrono::minutes span,
+                                 std::chrono::seconds step) const;
+
     /**
      * @brief Configuration access
      */
@@ -373,6 +438,9 @@ public:
         uint64_t failed_connections = 0;
         uint64_t messages_sent = 0;
         uint64_t messages_dropped = 0;
+        uint64_t frames_serialized = 0;     // Broadcast frames dumped (shared by all their recipients)
+        uint64_t delta_frames_sent = 0;
+        uint64_t bytes_sent = 0;            // Broadcast payload bytes
     };
 
     PerformanceStats get_performance_stats() const;
@@ -400,6 +468,7 @@ private:
 
     mutable std::shared_mutex history_mutex_;
     HistoricalData historical_data_;
+    std::shared_ptr<metrics::ColumnarTimeSeriesDB> history_store_;
 
     mutable std::shared_mutex connections_mutex_;
     std::unordered_map<std::string, std::unique_ptr<WebSocketConnection>> connections_;
@@ -408,6 +477,13 @@ private:
     mutable std::mutex performance_mutex_;
     PerformanceStats performance_stats_;
 
+    // Filtered snapshot last broadcast per subscription key, for deltas (broadcast thread only)
+    struct BroadcastView {
+        uint64_t seq = 0;
+        nlohmann::json data;
+    };
+    std::unordered_map<std::string, BroadcastView> last_views_;
+
     // Synchronization
     std::condition_variable stop_cv_;
     std::mutex stop_mutex_;
@@ -416,7 +492,7 @@ private:
     void metrics_collection_loop();
     void websocket_broadcast_loop();
     void update_system_metrics();
-    void broadcast_to_all_connections(const nlohmann::json& data);
+    void broadcast_to_all_connections(uint64_t sequence_num);
     void send_to_connection(const std::string& connection_id, const nlohmann::json& data);
     void cleanup_stale_connections();
 
@@ -431,6 +507,8 @@ private:
     bool authenticate_connection(const std::string& connection_id, const std::string& auth_token) const;
     void handle_connection_request(const std::string& connection_id, const nlohmann::json& message);
     void handle_ping_pong(const std::string& connection_id, const nlohmann::json& message);
+    void handle_subscribe(const std::string& connection_id, const nlohmann::json& message);
+    void handle_ack(const std::string& connection_id, const nlohmann::json& message);
 
     // Utility methods
     uint64_t get_current_timestamp() const;
@@ -103,6 +103,8 @@ struct WebUIConfig {
     bool enable_websocket_auth = false;
     std::string websocket_auth_token = "";
     uint32_t history_retention_minutes = 60;
+    std::string history_store_path = "";           // Persist per-provider history here ("" = memory only)
+    uint32_t history_store_retention_hours = 168;
 
     nlohmann::json toJson() const {
         nlohmann::json j;
@@ -124,6 +126,9 @@ struct WebUIConfig {
         if (!detected_ip.empty()) j["detected_ip"] = detected_ip;
         j["zerotier_interface_prefix"] = zerotier_interface_prefix;
 
+        if (!history_store_path.empty()) j["history_store_path"] = history_store_path;
+        j["history_store_retention_hours"] = history_store_retention_hours;
+
         return j;
     }
 
@@ -147,6 +152,9 @@ struct WebUIConfig {
         config.detected_ip = j.value("detected_ip", "");
         config.zerotier_interface_prefix = j.value("zerotier_interface_prefix", "zt");
 
+        config.history_store_path = j.value("history_store_path", "");
+        config.history_store_retention_hours = j.value("history_store_retention_hours", 168u);
+
         return config;
     }
 };
@@ -1,4 +1,5 @@
 #include "aimux/cache/response_cache.hpp"
+#include "aimux/core/json_codec.hpp"
 #include <openssl/sha.h>
 #include <iomanip>
 #include <sstream>
@@ -10,47 +11,150 @@ namespace aimux {
 namespace cache {
 
 // ResponseCache implementation
+namespace {
+    // Heap bytes owned by a string (short strings live inside the object)
+    size_t heapBytes(const std::string& str) {
+        static const size_t inline_capacity = std::string().capacity();
+        return str.capacity() > inline_capacity ? str.capacity() + 1 : 0;
+    }
+
+    // Bucket pointer plus the hash-node link and cached hash code
+    constexpr size_t kMapNodeOverhead = 3 * sizeof(void*);
+
+    // Route labels come from requests, so labels past the cap share one bucket
+    const std::string kOverflowRoute = "other";
+}
+
+void ResponseCache::Shard::linkFront(Node* node) {
+    node->prev = nullptr;
+    node->next = head;
+    if (head) {
+        head->prev = node;
+    }
+    head = node;
+    if (!tail) {
+        tail = node;
+    }
+}
+
+void ResponseCache::Shard::unlink(Node* node) {
+    if (node->prev) {
+        node->prev->next = node->next;
+    } else {
+        head = node->next;
+    }
+    if (node->next) {
+        node->next->prev = node->prev;
+    } else {
+        tail = node->prev;
+    }
+    node->prev = nullptr;
+    node->next = nullptr;
+}
+
+ResponseCache::ResponseCache() : ResponseCache(Config()) {}
+
 ResponseCache::ResponseCache(const Config& config) : config_(config) {
-    lru_list_.reserve(config_.max_entries);
+    config_.shard_count = std::max<size_t>(1, config_.shard_count);
+    shards_ = std::make_unique<Shard[]>(config_.shard_count);
+    shard_max_entries_ = std::max<size_t>(1,
+        (config_.max_entries + config_.shard_count - 1) / config_.shard_count);
+    shard_max_bytes_ = config_.max_memory_mb * 1024 * 1024 / config_.shard_count;
+    for (size_t i = 0; i < config_.shard_count; ++i) {
+        shards_[i].entries.reserve(shard_max_entries_);
+    }
 }
 
+ResponseCache::~ResponseCache() = default;
+
 std::string ResponseCache::generateKey(const std::string& model, const nlohmann::json& request) const {
     return KeyGenerator::hashingStrategy(model, request);
 }
 
+ResponseCache::Shard& ResponseCache::shardFor(const std::string& key) const {
+    return shards_[std::hash<std::string>{}(key) % config_.shard_count];
+}
+
+std::shared_ptr<ResponseCache::RouteCounters> ResponseCache::routeCounters(const std::string& route) {
+    {
+        std::shared_lock<std::shared_mutex> lock(routes_mutex_);
+        auto it = routes_.find(route);
+        if (it != routes_.end()) {
+            return it->second;
+        }
+    }
+    std::unique_lock<std::shared_mutex> lock(routes_mutex_);
+    if (routes_.size() >= config_.max_routes && !routes_.contains(route)) {
+        auto& overflow = routes_[kOverflowRoute];
+        if (!overflow) {
+            overflow = std::make_shared<RouteCounters>();
+        }
+        return overflow;
+    }
+    auto& counters = routes_[route];
+    if (!counters) {
+        counters = std::make_shared<RouteCounters>();
+    }
+    return counters;
+}
+
+size_t ResponseCache::entryBytes(const std::string& key, const CacheEntry& entry) {
+    return sizeof(std::string) + sizeof(Node) + kMapNodeOverhead +
+           heapBytes(key) + heapBytes(entry.payload);
+}
+
 std::optional<nlohmann::json> ResponseCache::get(const std::string& key) {
-    std::lock_guard<std::mutex> lock(mutex_);
+    auto payload = getPayload(key);
+    if (!payload) {
+        return std::nullopt;
+    }
+    return nlohmann::json::parse(*payload);
+}
 
-    auto it = cache_.find(key);
-    if (it == cache_.end()) {
+void ResponseCache::put(const std::string& key, const nlohmann::json& response,
+                       std::optional<std::chrono::milliseconds> ttl) {
+    putPayload(key, response.dump(), "", ttl);
+}
+
+std::optional<std::string> ResponseCache::getPayload(const std::string& key, const std::string& route) {
+    auto counters = routeCounters(route);
+    Shard& shard = shardFor(key);
+    std::lock_guard<std::mutex> lock(shard.mutex);
+
+    auto it = shard.entries.find(key);
+    if (it == shard.entries.end()) {
         misses_++;
+        counters->misses++;
         return std::nullopt;
     }
 
-    auto& entry = it->second;
-    if (entry.isExpired()) {
-        cache_.erase(it);
+    Node& node = it->second;
+    if (node.entry.isExpired()) {
+        eraseNode(shard, it);
         misses_++;
+        counters->misses++;
         return std::nullopt;
     }
 
-    // Update LRU and hit count
-    updateLRU(key);
-    entry.hit_count++;
+    // Promote to most recently used
+    shard.unlink(&node);
+    shard.linkFront(&node);
+    node.entry.hit_count++;
     hits_++;
+    counters->hits++;
 
-    return entry.response;
+    return node.entry.payload;
 }
 
-void ResponseCache::put(const std::string& key, const nlohmann::json& response,
-                       std::optional<std::chrono::milliseconds> ttl) {
-    std::lock_guard<std::mutex> lock(mutex_);
+void ResponseCache::putPayload(const std::string& key, std::string payload, const std::string& route,
+                               std::optional<std::chrono::milliseconds> ttl) {
+    auto counters = routeCounters(route);
 
     CacheEntry entry;
-    entry.response = response;
+    entry.response_size = payload.size();
+    entry.payload = std::move(payload);
     entry.timestamp = std::chrono::steady_clock::now();
-    entry.ttl = ttl ? *ttl : config_.default_ttl;
-    entry.response_size = response.dump().length();
+    entry.ttl = std::min(ttl ? *ttl : config_.default_ttl, config_.max_ttl);
 
     // Apply adaptive TTL if enabled
     if (config_.enable_smart_ttl) {
@@ -59,79 +163,87 @@ void ResponseCache::put(const std::string& key, const nlohmann::json& response,
         );
     }
 
-    // Enforce memory limits before insertion
-    enforceMemoryLimit();
+    size_t bytes = entryBytes(key, entry);
+    Shard& shard = shardFor(key);
+    std::lock_guard<std::mutex> lock(shard.mutex);
 
-    // If cache is full, evict LRU
-    if (cache_.size() >= config_.max_entries) {
-        evictLRU();
+    auto existing = shard.entries.find(key);
+    if (existing != shard.entries.end()) {
+        eraseNode(shard, existing);
+    }
+    if (bytes > shard_max_bytes_) {
+        return;  // Larger than a whole shard; never cacheable, so evict nothing for it
+    }
+
+    // Make room: entry count first, then the shard's byte budget
+    while (!shard.entries.empty() &&
+           (shard.entries.size() >= shard_max_entries_ || shard.bytes + bytes > shard_max_bytes_)) {
+        evictLRU(shard);
     }
 
-    cache_[key] = std::move(entry);
-    updateLRU(key);
+    auto [it, inserted] = shard.entries.try_emplace(key);
+    Node& node = it->second;
+    node.key = &it->first;
+    node.entry = std::move(entry);
+    node.route = std::move(counters);
+    node.bytes = bytes;
+    shard.linkFront(&node);
+    shard.bytes += bytes;
 }
 
 void ResponseCache::remove(const std::string& key) {
-    std::lock_guard<std::mutex> lock(mutex_);
-    cache_.erase(key);
-
-    // Remove from LRU list
-    lru_list_.erase(
-        std::remove_if(lru_list_.begin(), lru_list_.end(),
-                      [&key](const LRUEntry& e) { return e.key == key; }),
-        lru_list_.end()
-    );
+    Shard& shard = shardFor(key);
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    auto it = shard.entries.find(key);
+    if (it != shard.entries.end()) {
+        eraseNode(shard, it);
+    }
 }
 
 void ResponseCache::clear() {
-    std::lock_guard<std::mutex> lock(mutex_);
-    cache_.clear();
-    lru_list_.clear();
+    for (size_t i = 0; i < config_.shard_count; ++i) {
+        Shard& shard = shards_[i];
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        shard.entries.clear();
+        shard.head = nullptr;
+        shard.tail = nullptr;
+        shard.bytes = 0;
+    }
 }
 
 size_t ResponseCache::cleanup() {
-    std::lock_guard<std::mutex> lock(mutex_);
-
     size_t removed = 0;
-    auto it = cache_.begin();
-    while (it != cache_.end()) {
-        if (it->second.isExpired() || shouldEvict(it->second)) {
-            it = cache_.erase(it);
-            removed++;
-        } else {
-            ++it;
+    for (size_t i = 0; i < config_.shard_count; ++i) {
+        Shard& shard = shards_[i];
+        std::lock_guard<std::mutex> lock(shard.mutex);
+
+        auto it = shard.entries.begin();
+        while (it != shard.entries.end()) {
+            auto current = it++;
+            if (current->second.entry.isExpired() || shouldEvict(current->second.entry)) {
+                eraseNode(shard, current);
+                removed++;
+            }
         }
     }
-
-    // Cleanup LRU list
-    lru_list_.erase(
-        std::remove_if(lru_list_.begin(), lru_list_.end(),
-                      [this](const LRUEntry& e) {
-                          return cache_.find(e.key) == cache_.end();
-                      }),
-        lru_list_.end()
-    );
-
     return removed;
 }
 
 ResponseCache::Stats ResponseCache::getStats() const {
-    std::lock_guard<std::mutex> lock(mutex_);
-
     Stats stats;
     stats.hits = hits_.load();
     stats.misses = misses_.load();
-    stats.entries = cache_.size();
     stats.evictions = evictions_.load();
 
     size_t total_requests = stats.hits + stats.misses;
     stats.hit_rate = total_requests > 0 ?
         static_cast<double>(stats.hits) / total_requests : 0.0;
 
-    // Calculate memory usage
-    stats.memory_usage_bytes = 0;
-    for (const auto& [key, entry] : cache_) {
-        stats.memory_usage_bytes += estimateMemoryUsage(entry);
+    for (size_t i = 0; i < config_.shard_count; ++i) {
+        const Shard& shard = shards_[i];
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        stats.entries += shard.entries.size();
+        stats.memory_usage_bytes += shard.bytes;
     }
 
     return stats;
@@ -141,29 +253,47 @@ void ResponseCache::resetStats() {
     hits_ = 0;
     misses_ = 0;
     evictions_ = 0;
-}
 
-void ResponseCache::updateLRU(const std::string& key) {
-    auto now = std::chrono::steady_clock::now();
+    std::shared_lock<std::shared_mutex> lock(routes_mutex_);
+    for (auto& [route, counters] : routes_) {
+        counters->hits = 0;
+        counters->misses = 0;
+        counters->evictions = 0;
+    }
+}
 
-    // Remove existing entry
-    lru_list_.erase(
-        std::remove_if(lru_list_.begin(), lru_list_.end(),
-                      [&key](const LRUEntry& e) { return e.key == key; }),
-        lru_list_.end()
-    );
+nlohmann::json ResponseCache::getRouteStats() const {
+    nlohmann::json routes = nlohmann::json::object();
+
+    std::shared_lock<std::shared_mutex> lock(routes_mutex_);
+    for (const auto& [route, counters] : routes_) {
+        size_t hits = counters->hits.load();
+        size_t misses = counters->misses.load();
+        nlohmann::json route_stats;
+        route_stats["hits"] = hits;
+        route_stats["misses"] = misses;
+        route_stats["evictions"] = counters->evictions.load();
+        route_stats["hit_rate"] = (hits + misses) > 0 ?
+            static_cast<double>(hits) / (hits + misses) : 0.0;
+        routes[route.empty() ? "default" : route] = route_stats;
+    }
+    return routes;
+}
 
-    // Add to front (most recently used)
-    lru_list_.insert(lru_list_.begin(), LRUEntry{key, now});
+void ResponseCache::eraseNode(Shard& shard, std::unordered_map<std::string, Node>::iterator it) {
+    shard.unlink(&it->second);
+    shard.bytes -= it->second.bytes;
+    shard.entries.erase(it);
 }
 
-void ResponseCache::evictLRU() {
-    if (lru_list_.empty()) return;
+void ResponseCache::evictLRU(Shard& shard) {
+    if (!shard.tail) return;
 
-    // Remove least recently used from back
-    auto lru_key = lru_list_.back().key;
-    lru_list_.pop_back();
-    cache_.erase(lru_key);
+    Node* victim = shard.tail;
+    if (victim->route) {
+        victim->route->evictions++;
+    }
+    eraseNode(shard, shard.entries.find(*victim->key));
     evictions_++;
 }
 
@@ -180,48 +310,32 @@ bool ResponseCache::shouldEvict(const CacheEntry& entry) const {
     return false;
 }
 
-size_t ResponseCache::estimateMemoryUsage(const CacheEntry& entry) const {
-    size_t usage = sizeof(CacheEntry) + entry.response_size + 256; // Overhead
-    return usage;
-}
-
-void ResponseCache::enforceMemoryLimit() {
-    size_t total_memory = 0;
-    for (const auto& [key, entry] : cache_) {
-        total_memory += estimateMemoryUsage(entry);
-    }
-
-    size_t max_memory_bytes = config_.max_memory_mb * 1024 * 1024;
-
-    while (total_memory > max_memory_bytes && !lru_list_.empty()) {
-        auto lru_key = lru_list_.back().key;
-        auto it = cache_.find(lru_key);
-        if (it != cache_.end()) {
-            total_memory -= estimateMemoryUsage(it->second);
-            cache_.erase(it);
-        }
-        lru_list_.pop_back();
-        evictions_++;
-    }
-}
-
 // KeyGenerator implementation
 std::string KeyGenerator::hashingStrategy(const std::string& model, const nlohmann::json& request) {
-    // Extract core content for caching
-    std::string content = extractCoreContent(request);
-    std::string combined = model + "|" + content;
+    // Hash the whole request so tools, system prompts and sampling parameters
+    // all distinguish entries; object keys serialize in sorted order
+    std::string combined = model + "|";
+    if (request.is_object() && request.contains("aimux_cache")) {
+        nlohmann::json canonical = request;
+        canonical.erase("aimux_cache");
+        combined += core::dump_json(canonical);
+    } else {
+        combined += core::dump_json(request);
+    }
 
     // SHA-256 hash
     unsigned char hash[SHA256_DIGEST_LENGTH];
     SHA256(reinterpret_cast<const unsigned char*>(combined.c_str()), combined.length(), hash);
 
-    std::stringstream ss;
-    ss << std::hex << std::setfill('0');
+    static const char hex_digits[] = "0123456789abcdef";
+    std::string key;
+    key.reserve(SHA256_DIGEST_LENGTH * 2);
     for (int i = 0; i < SHA256_DIGEST_LENGTH; i++) {
-        ss << std::setw(2) << static_cast<int>(hash[i]);
+        key.push_back(hex_digits[hash[i] >> 4]);
+        key.push_back(hex_digits[hash[i] & 0x0f]);
     }
 
-    return ss.str();
+    return key;
 }
 
 std::string KeyGenerator::semanticStrategy(const std::string& model, const nlohmann::json& request) {
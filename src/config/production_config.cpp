@@ -1002,6 +1002,12 @@ std::vector<std::string> validateWebUIConfig(const WebUIConfig& config) {
                         std::to_string(config.history_retention_minutes));
     }
 
+    if (!config.history_store_path.empty() &&
+        (config.history_store_retention_hours < 1 || config.history_store_retention_hours > 24 * 366)) {
+        errors.push_back("Invalid history_store_retention_hours (must be 1-8784): " +
+                        std::to_string(config.history_store_retention_hours));
+    }
+
     return errors;
 }
 
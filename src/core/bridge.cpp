@@ -57,7 +57,7 @@ Response ConcreteBridge::send_request(const Request& request) {
 
         Response response;
         response.provider_name = provider_name_;
-        request_count_++;
+        int request_number = ++request_count_;
 
         // Validate request
         if (request.model.empty()) {
@@ -71,10 +71,10 @@ Response ConcreteBridge::send_request(const Request& request) {
         }
 
         // Simulate some processing time with error handling
-        int response_time = 50 + (request_count_ % 100);
+        int response_time = 50 + (request_number % 100);
         std::this_thread::sleep_for(std::chrono::milliseconds(response_time));
 
-        if (request_count_ % 10 == 0) {
+        if (request_number % 10 == 0) {
             is_healthy_ = false;
             response.success = false;
             response.error_message = "Simulated provider failure";
@@ -107,10 +107,11 @@ std::string ConcreteBridge::get_provider_name() const {
 nlohmann::json ConcreteBridge::get_rate_limit_status() const {
     nlohmann::json status;
     status["provider"] = provider_name_;
-    status["requests_made"] = request_count_;
-    status["requests_remaining"] = 1000 - request_count_;
+    int requests_made = request_count_.load();
+    status["requests_made"] = requests_made;
+    status["requests_remaining"] = 1000 - requests_made;
     status["reset_time"] = "2025-01-12T00:00:00Z";
-    status["is_healthy"] = is_healthy_;
+    status["is_healthy"] = is_healthy_.load();
     return status;
 }
 
@@ -64,6 +64,16 @@ void FailoverManager::mark_healthy(const std::string& provider) {
     }
 }
 
+void FailoverManager::add_provider(const std::string& provider) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    
+    if (!find_provider(provider)) {
+        ProviderStatus status;
+        status.name = provider;
+        provider_statuses_.push_back(status);
+    }
+}
+
 bool FailoverManager::is_available(const std::string& provider) const {
     std::lock_guard<std::mutex> lock(mutex_);
     
@@ -145,10 +155,15 @@ bool FailoverManager::is_cool_down_expired(const ProviderStatus& status) const {
 LoadBalancer::LoadBalancer(Strategy strategy) : strategy_(strategy) {}
 
 std::string LoadBalancer::select_provider(const std::vector<std::string>& available_providers) {
+    size_t index = select_index(available_providers);
+    return index < available_providers.size() ? available_providers[index] : "";
+}
+
+size_t LoadBalancer::select_index(const std::vector<std::string>& available_providers) {
     std::lock_guard<std::mutex> lock(mutex_);
     
     if (available_providers.empty()) {
-        return "";
+        return 0;
     }
     
     // Initialize metrics for new providers
@@ -174,7 +189,7 @@ std::string LoadBalancer::select_provider(const std::vector<std::string>& availa
         case Strategy::RANDOM:
             return select_random(available_providers);
         default:
-            return available_providers[0];
+            return 0;
     }
 }
 
@@ -231,22 +246,22 @@ LoadBalancer::ProviderMetrics* LoadBalancer::find_metrics(const std::string& pro
     return (it != provider_metrics_.end()) ? &(*it) : nullptr;
 }
 
-std::string LoadBalancer::select_round_robin(const std::vector<std::string>& available_providers) {
+size_t LoadBalancer::select_round_robin(const std::vector<std::string>& available_providers) {
     if (round_robin_index_ >= available_providers.size()) {
         round_robin_index_ = 0;
     }
-    return available_providers[round_robin_index_++];
+    return round_robin_index_++;
 }
 
-std::string LoadBalancer::select_least_connections(const std::vector<std::string>& available_providers) {
-    std::string best_provider = available_providers[0];
+size_t LoadBalancer::select_least_connections(const std::vector<std::string>& available_providers) {
+    size_t best_provider = 0;
     int min_connections = std::numeric_limits<int>::max();
     
-    for (const auto& provider : available_providers) {
-        if (auto* metrics = find_metrics(provider)) {
+    for (size_t i = 0; i < available_providers.size(); ++i) {
+        if (auto* metrics = find_metrics(available_providers[i])) {
             if (metrics->current_connections < min_connections) {
                 min_connections = metrics->current_connections;
-                best_provider = provider;
+                best_provider = i;
             }
         }
     }
@@ -254,43 +269,37 @@ std::string LoadBalancer::select_least_connections(const std::vector<std::string
     return best_provider;
 }
 
-std::string LoadBalancer::select_fastest_response(const std::vector<std::string>& available_providers) {
-    std::string best_provider = available_providers[0];
+size_t LoadBalancer::select_fastest_response(const std::vector<std::string>& available_providers) {
+    size_t best_provider = 0;
     double best_time = std::numeric_limits<double>::max();
     
-    for (const auto& provider : available_providers) {
-        if (auto* metrics = find_metrics(provider)) {
+    for (size_t i = 0; i < available_providers.size(); ++i) {
+        if (auto* metrics = find_metrics(available_providers[i])) {
             if (metrics->avg_response_time_ms < best_time && metrics->avg_response_time_ms > 0) {
                 best_time = metrics->avg_response_time_ms;
-                best_provider = provider;
+                best_provider = i;
             }
         } else {
             // New provider with no metrics yet
-            return provider;
+            return i;
         }
     }
     
     return best_provider;
 }
 
-std::string LoadBalancer::select_adaptive(const std::vector<std::string>& available_providers) {
-    std::lock_guard<std::mutex> lock(mutex_);
-    
-    if (available_providers.empty()) {
-        return "";
-    }
-    
+size_t LoadBalancer::select_adaptive(const std::vector<std::string>& available_providers) {
     // Adaptive algorithm: combines multiple factors
-    std::vector<std::tuple<std::string, double, int>> scored_providers;
+    std::vector<std::tuple<size_t, double, int>> scored_providers;
     
-    for (const auto& provider : available_providers) {
-        if (auto* metrics = find_metrics(provider)) {
+    for (size_t i = 0; i < available_providers.size(); ++i) {
+        if (auto* metrics = find_metrics(available_providers[i])) {
             double response_score = metrics->avg_response_time_ms > 0 ? 
                                 100.0 / metrics->avg_response_time_ms : 100.0;
             int connection_score = std::max(0, 10 - metrics->current_connections);
             double overall_score = (response_score * 0.7) + (connection_score * 0.3);
             
-            scored_providers.emplace_back(provider, overall_score, metrics->total_requests);
+            scored_providers.emplace_back(i, overall_score, metrics->total_requests);
         }
     }
     
@@ -306,27 +315,21 @@ std::string LoadBalancer::select_adaptive(const std::vector<std::string>& availa
     return std::get<0>(scored_providers[0]);
 }
 
-std::string LoadBalancer::select_weighted_round_robin(const std::vector<std::string>& available_providers) {
-    std::lock_guard<std::mutex> lock(mutex_);
-    
-    if (available_providers.empty()) {
-        return "";
-    }
-    
+size_t LoadBalancer::select_weighted_round_robin(const std::vector<std::string>& available_providers) {
     // For weighted round robin, we'll use response times as weights (faster = higher weight)
-    std::vector<std::pair<std::string, double>> weighted_providers;
+    std::vector<std::pair<size_t, double>> weighted_providers;
     double total_weight = 0.0;
     
-    for (const auto& provider : available_providers) {
-        if (auto* metrics = find_metrics(provider)) {
+    for (size_t i = 0; i < available_providers.size(); ++i) {
+        if (auto* metrics = find_metrics(available_providers[i])) {
             // Inverse response time as weight (faster = higher weight)
             double weight = metrics->avg_response_time_ms > 0 ? 
                           1000.0 / metrics->avg_response_time_ms : 1000.0;
-            weighted_providers.emplace_back(provider, weight);
+            weighted_providers.emplace_back(i, weight);
             total_weight += weight;
         } else {
             // New provider gets default weight
-            weighted_providers.emplace_back(provider, 100.0);
+            weighted_providers.emplace_back(i, 100.0);
             total_weight += 100.0;
         }
     }
@@ -344,14 +347,14 @@ std::string LoadBalancer::select_weighted_round_robin(const std::vector<std::str
     }
     
     // Fallback to first provider
-    return available_providers[0];
+    return 0;
 }
 
-std::string LoadBalancer::select_random(const std::vector<std::string>& available_providers) {
+size_t LoadBalancer::select_random(const std::vector<std::string>& available_providers) {
     static std::random_device rd;
     static std::mt19937 gen(rd());
     std::uniform_int_distribution<std::size_t> dis(0, available_providers.size() - 1);
-    return available_providers[dis(gen)];
+    return dis(gen);
 }
 
 std::string LoadBalancer::strategy_to_string(Strategy strategy) const {
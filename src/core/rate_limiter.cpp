@@ -0,0 +1,114 @@
+#include "aimux/core/rate_limiter.hpp"
+#include <algorithm>
+#include <mutex>
+#include <unordered_map>
+
+namespace aimux {
+namespace core {
+
+namespace {
+    constexpr int64_t NANOS_PER_MINUTE = 60'000'000'000LL;
+}
+
+RateLimiter::RateLimiter(int requests_per_minute, int burst) {
+    configure(requests_per_minute, burst);
+}
+
+int64_t RateLimiter::now_ns() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+void RateLimiter::configure(int requests_per_minute, int burst) {
+    if (requests_per_minute <= 0) {
+        limit_.store(0, std::memory_order_relaxed);
+        burst_.store(0, std::memory_order_relaxed);
+        emission_interval_ns_.store(0, std::memory_order_relaxed);
+        return;
+    }
+
+    if (burst <= 0) {
+        burst = requests_per_minute;
+    }
+    int64_t interval = NANOS_PER_MINUTE / requests_per_minute;
+    limit_.store(requests_per_minute, std::memory_order_relaxed);
+    burst_.store(burst, std::memory_order_relaxed);
+    tolerance_ns_.store(interval * (burst - 1), std::memory_order_relaxed);
+    emission_interval_ns_.store(interval, std::memory_order_relaxed);
+}
+
+bool RateLimiter::try_acquire(std::chrono::milliseconds* retry_after) {
+    int64_t interval = emission_interval_ns_.load(std::memory_order_relaxed);
+    if (interval <= 0) {
+        return true;
+    }
+    int64_t tolerance = tolerance_ns_.load(std::memory_order_relaxed);
+    int64_t now = now_ns();
+
+    int64_t arrival = theoretical_arrival_ns_.load(std::memory_order_relaxed);
+    while (true) {
+        int64_t base = std::max(arrival, now);
+        if (base - now > tolerance) {
+            if (retry_after) {
+                *retry_after = std::chrono::ceil<std::chrono::milliseconds>(
+                    std::chrono::nanoseconds(base - tolerance - now));
+            }
+            return false;
+        }
+        if (theoretical_arrival_ns_.compare_exchange_weak(arrival, base + interval,
+                                                          std::memory_order_acq_rel,
+                                                          std::memory_order_relaxed)) {
+            return true;
+        }
+    }
+}
+
+void RateLimiter::refund() {
+    int64_t interval = emission_interval_ns_.load(std::memory_order_relaxed);
+    if (interval <= 0) {
+        return;
+    }
+    // An arrival time in the past already means a full bucket, so the subtraction needs no floor
+    theoretical_arrival_ns_.fetch_sub(interval, std::memory_order_acq_rel);
+}
+
+RateLimiter::State RateLimiter::state() const {
+    State state;
+    state.limit = limit_.load(std::memory_order_relaxed);
+    state.burst = burst_.load(std::memory_order_relaxed);
+
+    int64_t interval = emission_interval_ns_.load(std::memory_order_relaxed);
+    if (interval <= 0) {
+        return state;
+    }
+
+    int64_t backlog = std::max<int64_t>(0, theoretical_arrival_ns_.load(std::memory_order_relaxed) - now_ns());
+    int64_t capacity = static_cast<int64_t>(state.burst) * interval;
+    state.remaining = static_cast<int>(std::max<int64_t>(0, (capacity - backlog) / interval));
+    state.reset_in = std::chrono::ceil<std::chrono::milliseconds>(std::chrono::nanoseconds(backlog));
+    return state;
+}
+
+std::shared_ptr<RateLimiter> RateLimiter::shared(const std::string& key, int requests_per_minute, int burst) {
+    static std::mutex registry_mutex;
+    static std::unordered_map<std::string, std::weak_ptr<RateLimiter>> registry;
+
+    std::lock_guard<std::mutex> lock(registry_mutex);
+    auto& slot = registry[key];
+    if (auto limiter = slot.lock()) {
+        limiter->configure(requests_per_minute, burst);
+        return limiter;
+    }
+
+    // Drop limiters nobody holds any more before adding one
+    std::erase_if(registry, [&key](const auto& entry) {
+        return entry.first != key && entry.second.expired();
+    });
+
+    auto limiter = std::make_shared<RateLimiter>(requests_per_minute, burst);
+    registry[key] = limiter;
+    return limiter;
+}
+
+} // namespace core
+} // namespace aimux
@@ -4,102 +4,191 @@
 #include <algorithm>
 #include <stdexcept>
 #include <chrono>
+#include <unordered_map>
 
 namespace aimux {
 namespace core {
 
-Router::Router(const std::vector<ProviderConfig>& providers) 
-    : providers_(providers) {
-    
+struct Router::ProviderTable {
+    struct Entry {
+        uint32_t id = 0;
+        ProviderConfig config;
+        std::shared_ptr<Bridge> bridge;
+        std::string bridge_error;   // Why bridge is null
+    };
+
+    std::vector<Entry> entries;                          // Indexed by id
+    std::unordered_map<std::string, uint32_t> ids;
+
+    // Enabled providers in table order; enabled_names[i] names entries[enabled[i]]
+    std::vector<uint32_t> enabled;
+    std::vector<std::string> enabled_names;
+};
+
+Router::Router(const std::vector<ProviderConfig>& providers, BridgeBuilder bridge_builder)
+    : bridge_builder_(std::move(bridge_builder)) {
+
+    if (!bridge_builder_) {
+        bridge_builder_ = [](const ProviderConfig& config) -> std::shared_ptr<Bridge> {
+            return BridgeFactory::create_bridge(config.name, config.to_json());
+        };
+    }
+
     std::vector<std::string> provider_names;
-    for (const auto& provider : providers_) {
+    for (const auto& provider : providers) {
         provider_names.push_back(provider.name);
     }
-    
+
     failover_manager_ = std::make_unique<FailoverManager>(provider_names);
     load_balancer_ = std::make_unique<LoadBalancer>(LoadBalancer::Strategy::FASTEST_RESPONSE);
+    table_.store(build_table(providers, nullptr));
+}
+
+Router::~Router() = default;
+
+std::shared_ptr<const Router::ProviderTable> Router::build_table(const std::vector<ProviderConfig>& providers,
+                                                                 const ProviderTable* previous) const {
+    auto table = std::make_shared<ProviderTable>();
+    table->entries.reserve(providers.size());
+
+    for (const auto& config : providers) {
+        if (table->ids.count(config.name)) {
+            continue;   // First definition wins
+        }
+
+        ProviderTable::Entry entry;
+        entry.id = static_cast<uint32_t>(table->entries.size());
+        entry.config = config;
+
+        // Reuse the live bridge when nothing about the provider changed
+        if (previous) {
+            auto it = previous->ids.find(config.name);
+            if (it != previous->ids.end()) {
+                const auto& old_entry = previous->entries[it->second];
+                if (old_entry.bridge && old_entry.config.to_json() == config.to_json()) {
+                    entry.bridge = old_entry.bridge;
+                }
+            }
+        }
+
+        if (!entry.bridge) {
+            try {
+                entry.bridge = bridge_builder_(config);
+                if (!entry.bridge) {
+                    entry.bridge_error = "no bridge for provider " + config.name;
+                }
+            } catch (const std::exception& e) {
+                entry.bridge_error = e.what();
+            }
+        }
+
+        if (config.enabled) {
+            table->enabled.push_back(entry.id);
+            table->enabled_names.push_back(config.name);
+        }
+        table->ids.emplace(config.name, entry.id);
+        table->entries.push_back(std::move(entry));
+    }
+
+    return table;
+}
+
+void Router::update_providers(const std::vector<ProviderConfig>& providers) {
+    std::lock_guard<std::mutex> lock(update_mutex_);
+
+    for (const auto& provider : providers) {
+        failover_manager_->add_provider(provider.name);
+    }
+    auto previous = table_.load();
+    table_.store(build_table(providers, previous.get()));
 }
 
 Response Router::route(const Request& request) {
-    // Get available providers
-    std::vector<std::string> available_providers;
-    for (const auto& provider : providers_) {
-        if (provider.enabled && failover_manager_->is_available(provider.name)) {
-            available_providers.push_back(provider.name);
+    auto table = table_.load();
+
+    // Get available providers; the table's own lists serve while none is cooling down
+    const std::vector<uint32_t>* available_ids = &table->enabled;
+    const std::vector<std::string>* available_providers = &table->enabled_names;
+    std::vector<uint32_t> filtered_ids;
+    std::vector<std::string> filtered_providers;
+    auto is_available = [this](const std::string& name) { return failover_manager_->is_available(name); };
+    if (!std::all_of(table->enabled_names.begin(), table->enabled_names.end(), is_available)) {
+        for (size_t i = 0; i < table->enabled.size(); ++i) {
+            if (is_available(table->enabled_names[i])) {
+                filtered_ids.push_back(table->enabled[i]);
+                filtered_providers.push_back(table->enabled_names[i]);
+            }
         }
+        available_ids = &filtered_ids;
+        available_providers = &filtered_providers;
     }
-    
-    if (available_providers.empty()) {
+
+    if (available_ids->empty()) {
         Response response;
         response.success = false;
         response.error_message = "No available providers";
         response.status_code = 503;
         return response;
     }
-    
+
     // Select best provider using load balancer
-    std::string selected_provider = load_balancer_->select_provider(available_providers);
-    
-    // Find provider config
-    auto provider_it = std::find_if(providers_.begin(), providers_.end(),
-        [&selected_provider](const ProviderConfig& config) {
-            return config.name == selected_provider;
-        });
-    
-    if (provider_it == providers_.end()) {
-        Response response;
-        response.success = false;
-        response.error_message = "Selected provider not found: " + selected_provider;
-        response.status_code = 500;
-        return response;
-    }
-    
-    // Create bridge and send request
+    size_t selected = load_balancer_->select_index(*available_providers);
+    const ProviderTable::Entry& entry = table->entries[(*available_ids)[selected]];
+    const std::string& selected_provider = entry.config.name;
+
     try {
-        auto bridge = BridgeFactory::create_bridge(provider_it->name, provider_it->to_json());
+        if (!entry.bridge) {
+            throw std::runtime_error(entry.bridge_error);
+        }
+
         auto start_time = std::chrono::high_resolution_clock::now();
-        
-        Response response = bridge->send_request(request);
+
+        Response response = entry.bridge->send_request(request);
         auto end_time = std::chrono::high_resolution_clock::now();
-        
+
         // Update metrics
         response.response_time_ms = std::chrono::duration<double, std::milli>(end_time - start_time).count();
         response.provider_name = selected_provider;
         load_balancer_->update_response_time(selected_provider, response.response_time_ms);
-        
+
         if (response.success) {
             failover_manager_->mark_healthy(selected_provider);
         } else {
             failover_manager_->mark_failed(selected_provider);
         }
-        
+
         return response;
     } catch (const std::exception& e) {
         failover_manager_->mark_failed(selected_provider);
-        
+
         Response response;
         response.success = false;
         response.error_message = std::string("Provider error: ") + e.what();
         response.status_code = 502;
         response.provider_name = selected_provider;
-        
+
         return response;
     }
 }
 
 std::string Router::get_health_status() const {
+    auto table = table_.load();
     nlohmann::json status;
     status["providers"] = nlohmann::json::array();
-    
-    for (const auto& provider : providers_) {
+
+    for (const auto& entry : table->entries) {
+        const ProviderConfig& provider = entry.config;
         nlohmann::json provider_status;
         provider_status["name"] = provider.name;
         provider_status["enabled"] = provider.enabled;
         provider_status["available"] = failover_manager_->is_available(provider.name);
         provider_status["endpoint"] = provider.endpoint;
+        if (!entry.bridge) {
+            provider_status["error"] = entry.bridge_error;
+        }
         status["providers"].push_back(provider_status);
     }
-    
+
     return status.dump(2);
 }
 
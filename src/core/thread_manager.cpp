@@ -380,99 +380,5 @@ void ThreadManager::notify_lifecycle_change(const ThreadInfo& info, ThreadStatus
     }
 }
 
-// ThreadPool implementation
-ThreadPool::ThreadPool(size_t thread_count, const std::string& pool_name)
-    : pool_name_(pool_name) {
-
-    workers_.reserve(thread_count);
-    for (size_t i = 0; i < thread_count; ++i) {
-        auto worker = std::make_unique<ManagedThread>(
-            pool_name + "_worker_" + std::to_string(i),
-            "Thread pool worker thread " + std::to_string(i));
-
-        // Store raw pointer before moving
-        ManagedThread* worker_ptr = worker.get();
-
-        workers_.push_back(std::move(worker));
-
-        // Start worker thread
-        worker_ptr->start([this, worker_ptr]() {
-            worker_loop(worker_ptr);
-        });
-    }
-
-    AIMUX_INFO("Thread pool '" + pool_name + "' created with " +
-              std::to_string(thread_count) + " workers");
-}
-
-ThreadPool::~ThreadPool() {
-    shutdown();
-}
-
-ThreadPool::PoolStats ThreadPool::get_stats() const {
-    PoolStats stats;
-    stats.total_threads = workers_.size();
-    stats.active_threads = active_workers_.load();
-
-    std::lock_guard<std::mutex> lock(queue_mutex_);
-    stats.queued_tasks = task_queue_.size();
-    stats.completed_tasks = completed_tasks_.load();
-
-    return stats;
-}
-
-void ThreadPool::shutdown() {
-    shutdown_flag_.store(true);
-    queue_cv_.notify_all();
-
-    // Wait for all workers to finish
-    size_t failed_shutdowns = 0;
-    for (auto& worker : workers_) {
-        if (!worker->force_stop(5000)) {
-            failed_shutdowns++;
-        }
-    }
-
-    if (failed_shutdowns > 0) {
-        AIMUX_WARNING(std::to_string(failed_shutdowns) + " thread pool workers failed to shutdown cleanly");
-    }
-
-    AIMUX_INFO("Thread pool '" + pool_name_ + "' shutdown completed");
-}
-
-void ThreadPool::worker_loop(ManagedThread* worker) {
-    while (!shutdown_flag_.load()) {
-        std::function<void()> task;
-
-        {
-            std::unique_lock<std::mutex> lock(queue_mutex_);
-            queue_cv_.wait(lock, [this]() {
-                return !task_queue_.empty() || shutdown_flag_.load();
-            });
-
-            if (shutdown_flag_.load()) {
-                break;
-            }
-
-            task = std::move(task_queue_.front());
-            task_queue_.pop();
-        }
-
-        active_workers_++;
-        worker->update_activity();
-
-        try {
-            task();
-            completed_tasks_++;
-        } catch (const std::exception& e) {
-            AIMUX_ERROR("Thread pool task error: " + std::string(e.what()));
-        }
-
-        active_workers_--;
-    }
-
-    worker->update_activity();
-}
-
 } // namespace core
 } // namespace aimux
\ No newline at end of file
@@ -0,0 +1,395 @@
+/**
+ * @file thread_pool.cpp
+ * @brief Work-stealing ThreadPool implementation
+ *
+ * Kept apart from thread_manager.cpp so that components which only need the
+ * pool do not pull in ManagedThread and the ErrorHandler.
+ */
+
+#include "aimux/core/thread_manager.hpp"
+#include <algorithm>
+#include <deque>
+
+#ifdef __linux__
+#include <sys/prctl.h>
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+namespace aimux {
+namespace core {
+
+namespace {
+
+/**
+ * Chase-Lev deque of task pointers (Le, Pop, Cohen, Zappa Nardelli, PPoPP'13).
+ * push() and pop() are owner-only and lock-free; steal() may be called from
+ * any thread. Buffers replaced by grow() are retired rather than freed, since
+ * a concurrent thief may still be reading from them.
+ */
+class WorkStealingDeque {
+public:
+    explicit WorkStealingDeque(int64_t capacity = 256)
+        : buffer_(new Buffer(capacity)) {}
+
+    ~WorkStealingDeque() {
+        Buffer* buffer = buffer_.load(std::memory_order_relaxed);
+        for (int64_t i = top_.load(std::memory_order_relaxed); i < bottom_.load(std::memory_order_relaxed); ++i) {
+            delete buffer->get(i);
+        }
+        delete buffer;
+    }
+
+    WorkStealingDeque(const WorkStealingDeque&) = delete;
+    WorkStealingDeque& operator=(const WorkStealingDeque&) = delete;
+
+    void push(PoolTask* task) {
+        int64_t bottom = bottom_.load(std::memory_order_relaxed);
+        int64_t top = top_.load(std::memory_order_acquire);
+        Buffer* buffer = buffer_.load(std::memory_order_relaxed);
+        if (bottom - top > buffer->capacity - 1) {
+            buffer = grow(buffer, top, bottom);
+        }
+        buffer->put(bottom, task);
+        std::atomic_thread_fence(std::memory_order_release);
+        bottom_.store(bottom + 1, std::memory_order_relaxed);
+    }
+
+    PoolTask* pop() {
+        int64_t bottom = bottom_.load(std::memory_order_relaxed) - 1;
+        Buffer* buffer = buffer_.load(std::memory_order_relaxed);
+        bottom_.store(bottom, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        int64_t top = top_.load(std::memory_order_relaxed);
+
+        if (top > bottom) {
+            bottom_.store(bottom + 1, std::memory_order_relaxed);
+            return nullptr;
+        }
+
+        PoolTask* task = buffer->get(bottom);
+        if (top == bottom) {
+            // Last element: race the thieves for it
+            if (!top_.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst,
+                                              std::memory_order_relaxed)) {
+                task = nullptr;
+            }
+            bottom_.store(bottom + 1, std::memory_order_relaxed);
+        }
+        return task;
+    }
+
+    PoolTask* steal() {
+        int64_t top = top_.load(std::memory_order_acquire);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        int64_t bottom = bottom_.load(std::memory_order_acquire);
+        if (top >= bottom) {
+            return nullptr;
+        }
+
+        Buffer* buffer = buffer_.load(std::memory_order_acquire);
+        PoolTask* task = buffer->get(top);
+        if (!top_.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst,
+                                          std::memory_order_relaxed)) {
+            return nullptr;
+        }
+        return task;
+    }
+
+    size_t size() const {
+        int64_t bottom = bottom_.load(std::memory_order_relaxed);
+        int64_t top = top_.load(std::memory_order_relaxed);
+        return bottom > top ? static_cast<size_t>(bottom - top) : 0;
+    }
+
+private:
+    struct Buffer {
+        explicit Buffer(int64_t size)
+            : capacity(size), slots(new std::atomic<PoolTask*>[static_cast<size_t>(size)]) {}
+
+        PoolTask* get(int64_t index) const {
+            return slots[static_cast<size_t>(index & (capacity - 1))].load(std::memory_order_relaxed);
+        }
+
+        void put(int64_t index, PoolTask* task) {
+            slots[static_cast<size_t>(index & (capacity - 1))].store(task, std::memory_order_relaxed);
+        }
+
+        int64_t capacity;   // Power of two
+        std::unique_ptr<std::atomic<PoolTask*>[]> slots;
+    };
+
+    Buffer* grow(Buffer* old_buffer, int64_t top, int64_t bottom) {
+        auto* buffer = new Buffer(old_buffer->capacity * 2);
+        for (int64_t i = top; i < bottom; ++i) {
+            buffer->put(i, old_buffer->get(i));
+        }
+        retired_.emplace_back(old_buffer);
+        buffer_.store(buffer, std::memory_order_release);
+        return buffer;
+    }
+
+    alignas(64) std::atomic<int64_t> top_{0};
+    alignas(64) std::atomic<int64_t> bottom_{0};
+    std::atomic<Buffer*> buffer_;
+    std::vector<std::unique_ptr<Buffer>> retired_;
+};
+
+// Lets a worker push to its own deque instead of an inbox
+thread_local const ThreadPool* current_pool = nullptr;
+thread_local size_t current_worker = 0;
+
+} // namespace
+
+struct alignas(64) ThreadPool::Worker {
+    WorkStealingDeque deque;
+
+    // Submissions from threads outside the pool
+    std::mutex inbox_mutex;
+    std::deque<PoolTask*> inbox;
+    std::atomic<size_t> inbox_size{0};
+
+    std::atomic<uint64_t> executed{0};
+    std::atomic<uint64_t> stolen{0};
+    std::atomic<bool> idle{false};
+    std::atomic<int> cpu{-1};
+
+    std::thread thread;
+
+    ~Worker() {
+        for (PoolTask* task : inbox) {
+            delete task;
+        }
+    }
+
+    PoolTask* take_from_inbox() {
+        if (inbox_size.load(std::memory_order_acquire) == 0) {
+            return nullptr;
+        }
+        std::lock_guard<std::mutex> lock(inbox_mutex);
+        if (inbox.empty()) {
+            return nullptr;
+        }
+        PoolTask* task = inbox.front();
+        inbox.pop_front();
+        inbox_size.store(inbox.size(), std::memory_order_release);
+        return task;
+    }
+};
+
+ThreadPool::ThreadPool(size_t thread_count, const std::string& pool_name, bool pin_to_cores)
+    : pool_name_(pool_name) {
+    size_t worker_count = std::max<size_t>(1, thread_count);
+    unsigned cores = std::max(1u, std::thread::hardware_concurrency());
+
+    workers_.reserve(worker_count);
+    for (size_t i = 0; i < worker_count; ++i) {
+        auto worker = std::make_unique<Worker>();
+        if (pin_to_cores) {
+            worker->cpu.store(static_cast<int>(i % cores), std::memory_order_relaxed);
+        }
+        workers_.push_back(std::move(worker));
+    }
+
+    // Start only once every deque exists, since workers steal from each other
+    for (size_t i = 0; i < worker_count; ++i) {
+        workers_[i]->thread = std::thread(&ThreadPool::worker_loop, this, i);
+    }
+}
+
+ThreadPool::~ThreadPool() {
+    shutdown();
+}
+
+std::shared_ptr<ThreadPool> ThreadPool::shared() {
+    static std::shared_ptr<ThreadPool> pool = std::make_shared<ThreadPool>(
+        std::max(2u, std::thread::hardware_concurrency()), "aimux-pool");
+    return pool;
+}
+
+bool ThreadPool::is_worker_thread() const {
+    return current_pool == this;
+}
+
+bool ThreadPool::enqueue(PoolTask task) {
+    // Counted before the stopping check so shutdown() cannot miss a task that got past it
+    queued_tasks_.fetch_add(1, std::memory_order_seq_cst);
+    if (stopping_.load(std::memory_order_seq_cst)) {
+        queued_tasks_.fetch_sub(1, std::memory_order_seq_cst);
+        return false;
+    }
+
+    auto* node = new PoolTask(std::move(task));
+    if (current_pool == this) {
+        workers_[current_worker]->deque.push(node);
+    } else {
+        Worker& worker = *workers_[next_inbox_.fetch_add(1, std::memory_order_relaxed) % workers_.size()];
+        std::lock_guard<std::mutex> lock(worker.inbox_mutex);
+        worker.inbox.push_back(node);
+        worker.inbox_size.store(worker.inbox.size(), std::memory_order_release);
+    }
+
+    wake_one();
+    return true;
+}
+
+void ThreadPool::wake_one() {
+    // Pairs with the idle count a worker publishes before re-checking queued_tasks_
+    if (idle_workers_.load(std::memory_order_seq_cst) == 0) {
+        return;
+    }
+    {
+        std::lock_guard<std::mutex> lock(park_mutex_);
+    }
+    park_cv_.notify_one();
+}
+
+PoolTask* ThreadPool::find_task(size_t index, bool& stolen) {
+    Worker& self = *workers_[index];
+    stolen = false;
+
+    if (PoolTask* task = self.deque.pop()) {
+        return task;
+    }
+
+    // Move the whole inbox into the deque so thieves can take from it too
+    if (self.inbox_size.load(std::memory_order_acquire) > 0) {
+        std::deque<PoolTask*> arrived;
+        {
+            std::lock_guard<std::mutex> lock(self.inbox_mutex);
+            arrived.swap(self.inbox);
+            self.inbox_size.store(0, std::memory_order_release);
+        }
+        // Oldest last, so the owner pops it first
+        for (auto it = arrived.rbegin(); it != arrived.rend(); ++it) {
+            self.deque.push(*it);
+        }
+        if (PoolTask* task = self.deque.pop()) {
+            return task;
+        }
+    }
+
+    size_t count = workers_.size();
+    for (size_t offset = 1; offset < count; ++offset) {
+        Worker& victim = *workers_[(index + offset) % count];
+        PoolTask* task = victim.deque.steal();
+        if (!task) {
+            task = victim.take_from_inbox();
+        }
+        if (task) {
+            stolen = true;
+            return task;
+        }
+    }
+    return nullptr;
+}
+
+void ThreadPool::worker_loop(size_t index) {
+    current_pool = this;
+    current_worker = index;
+    Worker& self = *workers_[index];
+
+#ifdef __linux__
+    std::string os_name = (pool_name_ + "/" + std::to_string(index)).substr(0, 15);
+    prctl(PR_SET_NAME, os_name.c_str(), 0, 0, 0);
+    int cpu = self.cpu.load(std::memory_order_relaxed);
+    if (cpu >= 0) {
+        cpu_set_t cpus;
+        CPU_ZERO(&cpus);
+        CPU_SET(cpu, &cpus);
+        if (pthread_setaffinity_np(pthread_self(), sizeof(cpus), &cpus) != 0) {
+            self.cpu.store(-1, std::memory_order_relaxed);
+        }
+    }
+#endif
+
+    while (true) {
+        bool stolen = false;
+        if (PoolTask* task = find_task(index, stolen)) {
+            queued_tasks_.fetch_sub(1, std::memory_order_seq_cst);
+            if (queued_tasks_.load(std::memory_order_relaxed) > 0) {
+                wake_one();
+            }
+
+            active_workers_.fetch_add(1, std::memory_order_relaxed);
+            try {
+                (*task)();
+            } catch (...) {
+                failed_tasks_.fetch_add(1, std::memory_order_relaxed);
+            }
+            delete task;
+            active_workers_.fetch_sub(1, std::memory_order_relaxed);
+
+            self.executed.fetch_add(1, std::memory_order_relaxed);
+            if (stolen) {
+                self.stolen.fetch_add(1, std::memory_order_relaxed);
+            }
+            completed_tasks_.fetch_add(1, std::memory_order_relaxed);
+            continue;
+        }
+
+        // Read stopping first: an enqueue that saw the pool running is then already counted
+        bool stopping = stopping_.load(std::memory_order_seq_cst);
+        if (queued_tasks_.load(std::memory_order_seq_cst) > 0) {
+            // Counted but not yet visible in a queue, or mid-steal elsewhere
+            std::this_thread::yield();
+            continue;
+        }
+        if (stopping) {
+            break;
+        }
+
+        std::unique_lock<std::mutex> lock(park_mutex_);
+        idle_workers_.fetch_add(1, std::memory_order_seq_cst);
+        self.idle.store(true, std::memory_order_relaxed);
+        park_cv_.wait(lock, [this] {
+            return queued_tasks_.load(std::memory_order_seq_cst) > 0 ||
+                   stopping_.load(std::memory_order_seq_cst);
+        });
+        self.idle.store(false, std::memory_order_relaxed);
+        idle_workers_.fetch_sub(1, std::memory_order_seq_cst);
+    }
+
+    current_pool = nullptr;
+}
+
+ThreadPool::PoolStats ThreadPool::get_stats() const {
+    PoolStats stats;
+    stats.total_threads = workers_.size();
+    stats.active_threads = active_workers_.load(std::memory_order_relaxed);
+    stats.queued_tasks = queued_tasks_.load(std::memory_order_relaxed);
+    stats.completed_tasks = completed_tasks_.load(std::memory_order_relaxed);
+    stats.stolen_tasks = 0;
+    stats.failed_tasks = failed_tasks_.load(std::memory_order_relaxed);
+
+    stats.workers.reserve(workers_.size());
+    for (const auto& worker : workers_) {
+        WorkerStats worker_stats;
+        worker_stats.queued_tasks = worker->deque.size() + worker->inbox_size.load(std::memory_order_relaxed);
+        worker_stats.executed_tasks = worker->executed.load(std::memory_order_relaxed);
+        worker_stats.stolen_tasks = worker->stolen.load(std::memory_order_relaxed);
+        worker_stats.idle = worker->idle.load(std::memory_order_relaxed);
+        worker_stats.cpu = worker->cpu.load(std::memory_order_relaxed);
+        stats.stolen_tasks += worker_stats.stolen_tasks;
+        stats.workers.push_back(worker_stats);
+    }
+    return stats;
+}
+
+void ThreadPool::shutdown() {
+    stopping_.store(true, std::memory_order_seq_cst);
+    {
+        std::lock_guard<std::mutex> lock(park_mutex_);
+    }
+    park_cv_.notify_all();
+
+    // Workers leave once nothing is queued, so accepted tasks all run
+    for (auto& worker : workers_) {
+        if (worker->thread.joinable()) {
+            worker->thread.join();
+        }
+    }
+}
+
+} // namespace core
+} // namespace aimux
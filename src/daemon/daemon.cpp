@@ -193,6 +193,10 @@ bool AimuxDaemon::reload_config() {
         auto log_level = pImpl->config["logging"].value("level", "info");
         pImpl->logger->set_level(logging::LogUtils::string_to_level(log_level));
         
+        // Rebuild the provider table; unchanged providers keep their bridges
+        if (pImpl->router) {
+            pImpl->router->update_providers(providers::ConfigParser::parse_providers(pImpl->config));
+        }
         
         pImpl->logger->info("Configuration reloaded successfully");
         return true;
@@ -0,0 +1,356 @@
+#include "aimux/gateway/admission_control.hpp"
+#include "aimux/network/curl_multi_engine.hpp"
+#include <algorithm>
+
+namespace aimux {
+namespace gateway {
+
+namespace {
+
+// The releasing thread may be inside another request's completion, so a
+// resumed request continues on the event loop instead
+void resume_on_event_loop(const AdmissionController::AdmissionCallback& on_admitted, AdmissionTicket ticket) {
+    auto held = std::make_shared<AdmissionTicket>(std::move(ticket));
+    bool scheduled = network::CurlMultiEngine::instance().schedule(std::chrono::milliseconds(0),
+        [on_admitted, held](bool) { on_admitted(std::move(*held)); });
+    if (!scheduled) {
+        on_admitted(std::move(*held));
+    }
+}
+
+} // namespace
+
+// ============================================================================
+// AdmissionLimits
+// ============================================================================
+
+nlohmann::json AdmissionLimits::to_json() const {
+    nlohmann::json j;
+    j["max_requests_per_minute"] = max_requests_per_minute_;
+    j["burst"] = burst_;
+    j["max_concurrent_requests"] = max_concurrent_requests_;
+    j["max_queue_depth"] = max_queue_depth_;
+    j["max_queue_wait_ms"] = max_queue_wait_.count();
+    return j;
+}
+
+AdmissionLimits AdmissionLimits::from_json(const nlohmann::json& j) {
+    AdmissionLimits limits;
+    limits.max_requests_per_minute_ = j.value("max_requests_per_minute", 0);
+    limits.burst_ = j.value("burst", 0);
+    limits.max_concurrent_requests_ = j.value("max_concurrent_requests", 0);
+    limits.max_queue_depth_ = j.value("max_queue_depth", 32);
+    limits.max_queue_wait_ = std::chrono::milliseconds(j.value("max_queue_wait_ms", 250));
+    return limits;
+}
+
+std::string admission_result_to_string(AdmissionResult result) {
+    switch (result) {
+        case AdmissionResult::ADMITTED: return "admitted";
+        case AdmissionResult::RATE_LIMITED: return "rate_limited";
+        case AdmissionResult::SATURATED: return "saturated";
+        default: return "unknown";
+    }
+}
+
+// ============================================================================
+// Gate
+// ============================================================================
+
+AdmissionTicket::Gate::Gate(const AdmissionLimits& limits)
+    : rate_(limits.max_requests_per_minute_, limits.burst_) {
+    apply(limits);
+}
+
+void AdmissionTicket::Gate::apply(const AdmissionLimits& limits) {
+    rate_.configure(limits.max_requests_per_minute_, limits.burst_);
+    max_concurrent_.store(std::max(0, limits.max_concurrent_requests_), std::memory_order_relaxed);
+    max_queue_depth_.store(std::max(0, limits.max_queue_depth_), std::memory_order_relaxed);
+    max_queue_wait_ms_.store(std::max<int64_t>(0, limits.max_queue_wait_.count()), std::memory_order_relaxed);
+
+    // A raised limit may free slots for requests already waiting
+    {
+        std::lock_guard<std::mutex> lock(wait_mutex_);
+    }
+    wait_cv_.notify_all();
+    while (resume_parked()) {
+    }
+}
+
+bool AdmissionTicket::Gate::try_enter() {
+    int limit = max_concurrent_.load(std::memory_order_relaxed);
+    int current = in_flight_.load(std::memory_order_relaxed);
+    while (limit <= 0 || current < limit) {
+        if (in_flight_.compare_exchange_weak(current, current + 1, std::memory_order_acquire,
+                                             std::memory_order_relaxed)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+void AdmissionTicket::Gate::leave() {
+    in_flight_.fetch_sub(1, std::memory_order_release);
+    if (waiting_.load(std::memory_order_acquire) > 0 && !resume_parked()) {
+        // Taking the mutex orders this wakeup after a waiter's predicate check
+        {
+            std::lock_guard<std::mutex> lock(wait_mutex_);
+        }
+        wait_cv_.notify_one();
+    }
+}
+
+bool AdmissionTicket::Gate::resume_parked() {
+    std::shared_ptr<Parked> parked;
+    {
+        std::lock_guard<std::mutex> lock(wait_mutex_);
+        if (parked_.empty() || !try_enter()) {
+            return false;
+        }
+        parked = std::move(parked_.front());
+        parked_.pop_front();
+    }
+
+    waiting_.fetch_sub(1, std::memory_order_acq_rel);
+    record_wait(parked->since);
+    admitted_.fetch_add(1, std::memory_order_relaxed);
+    resume_on_event_loop(parked->on_admitted,
+                         AdmissionTicket(shared_from_this(), AdmissionResult::ADMITTED, std::chrono::milliseconds(0)));
+    return true;
+}
+
+void AdmissionTicket::Gate::expire(const std::shared_ptr<Parked>& parked) {
+    {
+        std::lock_guard<std::mutex> lock(wait_mutex_);
+        auto it = std::find(parked_.begin(), parked_.end(), parked);
+        if (it == parked_.end()) {
+            return;
+        }
+        parked_.erase(it);
+    }
+
+    waiting_.fetch_sub(1, std::memory_order_acq_rel);
+    record_wait(parked->since);
+    saturated_.fetch_add(1, std::memory_order_relaxed);
+    rate_.refund();
+    parked->on_admitted(AdmissionTicket(nullptr, AdmissionResult::SATURATED,
+                                        std::chrono::milliseconds(max_queue_wait_ms_.load(std::memory_order_relaxed))));
+}
+
+void AdmissionTicket::Gate::record_wait(std::chrono::steady_clock::time_point since) {
+    queue_wait_us_.record(static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now() - since).count()));
+}
+
+// ============================================================================
+// AdmissionTicket
+// ============================================================================
+
+AdmissionTicket::AdmissionTicket(std::shared_ptr<Gate> gate, AdmissionResult result,
+                                 std::chrono::milliseconds retry_after)
+    : gate_(std::move(gate)), result_(result), retry_after_(retry_after) {}
+
+AdmissionTicket::~AdmissionTicket() {
+    release();
+}
+
+AdmissionTicket::AdmissionTicket(AdmissionTicket&& other) noexcept
+    : gate_(std::move(other.gate_)), result_(other.result_), retry_after_(other.retry_after_) {}
+
+AdmissionTicket& AdmissionTicket::operator=(AdmissionTicket&& other) noexcept {
+    if (this != &other) {
+        release();
+        gate_ = std::move(other.gate_);
+        result_ = other.result_;
+        retry_after_ = other.retry_after_;
+    }
+    return *this;
+}
+
+void AdmissionTicket::release() {
+    if (gate_) {
+        gate_->leave();
+        gate_.reset();
+    }
+}
+
+// ============================================================================
+// AdmissionController
+// ============================================================================
+
+AdmissionController::AdmissionController() {
+    gates_.store(std::make_shared<const GateTable>());
+}
+
+void AdmissionController::configure(const std::string& provider_name, const AdmissionLimits& limits) {
+    std::lock_guard<std::mutex> lock(update_mutex_);
+    auto current = gates_.load();
+
+    auto it = current->find(provider_name);
+    if (it != current->end()) {
+        it->second->apply(limits);
+        return;
+    }
+
+    auto table = std::make_shared<GateTable>(*current);
+    table->emplace(provider_name, std::make_shared<AdmissionTicket::Gate>(limits));
+    gates_.store(std::move(table));
+}
+
+void AdmissionController::remove(const std::string& provider_name) {
+    std::lock_guard<std::mutex> lock(update_mutex_);
+    auto table = std::make_shared<GateTable>(*gates_.load());
+    table->erase(provider_name);
+    gates_.store(std::move(table));
+}
+
+AdmissionTicket AdmissionController::admit(const std::string& provider_name) {
+    return admit(provider_name, true);
+}
+
+AdmissionTicket AdmissionController::try_admit(const std::string& provider_name) {
+    return admit(provider_name, false);
+}
+
+AdmissionTicket AdmissionController::admit(const std::string& provider_name, bool may_wait) {
+    auto table = gates_.load(std::memory_order_acquire);
+    auto it = table->find(provider_name);
+    if (it == table->end()) {
+        return AdmissionTicket();
+    }
+    std::shared_ptr<AdmissionTicket::Gate> gate = it->second;
+
+    // Cheapest rejection first: no slot is touched when the rate is exhausted
+    std::chrono::milliseconds retry_after{0};
+    if (!gate->rate_.try_acquire(&retry_after)) {
+        gate->rate_limited_.fetch_add(1, std::memory_order_relaxed);
+        return AdmissionTicket(nullptr, AdmissionResult::RATE_LIMITED, retry_after);
+    }
+
+    if (!gate->try_enter()) {
+        auto max_wait = std::chrono::milliseconds(gate->max_queue_wait_ms_.load(std::memory_order_relaxed));
+        int depth = gate->waiting_.fetch_add(1, std::memory_order_acq_rel) + 1;
+        if (!may_wait || depth > gate->max_queue_depth_.load(std::memory_order_relaxed) ||
+            max_wait.count() == 0) {
+            gate->waiting_.fetch_sub(1, std::memory_order_acq_rel);
+            gate->saturated_.fetch_add(1, std::memory_order_relaxed);
+            gate->rate_.refund();
+            return AdmissionTicket(nullptr, AdmissionResult::SATURATED, max_wait);
+        }
+
+        gate->queued_.fetch_add(1, std::memory_order_relaxed);
+        gate->queue_depth_.record(static_cast<uint64_t>(depth));
+
+        auto start = std::chrono::steady_clock::now();
+        bool entered;
+        {
+            std::unique_lock<std::mutex> lock(gate->wait_mutex_);
+            entered = gate->wait_cv_.wait_for(lock, max_wait, [&gate] { return gate->try_enter(); });
+        }
+        gate->waiting_.fetch_sub(1, std::memory_order_acq_rel);
+        gate->record_wait(start);
+
+        if (!entered) {
+            gate->saturated_.fetch_add(1, std::memory_order_relaxed);
+            gate->rate_.refund();
+            return AdmissionTicket(nullptr, AdmissionResult::SATURATED, max_wait);
+        }
+    }
+
+    gate->admitted_.fetch_add(1, std::memory_order_relaxed);
+    return AdmissionTicket(std::move(gate), AdmissionResult::ADMITTED, std::chrono::milliseconds(0));
+}
+
+void AdmissionController::admit_async(const std::string& provider_name, AdmissionCallback on_admitted) {
+    auto table = gates_.load(std::memory_order_acquire);
+    auto it = table->find(provider_name);
+    if (it == table->end()) {
+        on_admitted(AdmissionTicket());
+        return;
+    }
+    std::shared_ptr<AdmissionTicket::Gate> gate = it->second;
+
+    std::chrono::milliseconds retry_after{0};
+    if (!gate->rate_.try_acquire(&retry_after)) {
+        gate->rate_limited_.fetch_add(1, std::memory_order_relaxed);
+        on_admitted(AdmissionTicket(nullptr, AdmissionResult::RATE_LIMITED, retry_after));
+        return;
+    }
+
+    if (gate->try_enter()) {
+        gate->admitted_.fetch_add(1, std::memory_order_relaxed);
+        on_admitted(AdmissionTicket(std::move(gate), AdmissionResult::ADMITTED, std::chrono::milliseconds(0)));
+        return;
+    }
+
+    auto max_wait = std::chrono::milliseconds(gate->max_queue_wait_ms_.load(std::memory_order_relaxed));
+    int depth = gate->waiting_.fetch_add(1, std::memory_order_acq_rel) + 1;
+    if (depth > gate->max_queue_depth_.load(std::memory_order_relaxed) || max_wait.count() == 0) {
+        gate->waiting_.fetch_sub(1, std::memory_order_acq_rel);
+        gate->saturated_.fetch_add(1, std::memory_order_relaxed);
+        gate->rate_.refund();
+        on_admitted(AdmissionTicket(nullptr, AdmissionResult::SATURATED, max_wait));
+        return;
+    }
+
+    auto parked = std::make_shared<AdmissionTicket::Gate::Parked>();
+    parked->on_admitted = std::move(on_admitted);
+    parked->since = std::chrono::steady_clock::now();
+
+    bool entered;
+    {
+        // Checked again under the lock: a slot released before the request was parked found nobody to hand it to
+        std::lock_guard<std::mutex> lock(gate->wait_mutex_);
+        entered = gate->try_enter();
+        if (!entered) {
+            gate->parked_.push_back(parked);
+        }
+    }
+    if (entered) {
+        gate->waiting_.fetch_sub(1, std::memory_order_acq_rel);
+        gate->admitted_.fetch_add(1, std::memory_order_relaxed);
+        parked->on_admitted(AdmissionTicket(std::move(gate), AdmissionResult::ADMITTED, std::chrono::milliseconds(0)));
+        return;
+    }
+
+    gate->queued_.fetch_add(1, std::memory_order_relaxed);
+    gate->queue_depth_.record(static_cast<uint64_t>(depth));
+
+    // A timer that finds the request already resumed does nothing
+    if (!network::CurlMultiEngine::instance().schedule(max_wait,
+            [gate, parked](bool) { gate->expire(parked); })) {
+        gate->expire(parked);
+    }
+}
+
+nlohmann::json AdmissionController::to_json() const {
+    auto table = gates_.load(std::memory_order_acquire);
+    nlohmann::json providers = nlohmann::json::object();
+
+    for (const auto& [name, gate] : *table) {
+        core::RateLimiter::State rate = gate->rate_.state();
+
+        nlohmann::json j;
+        j["in_flight"] = gate->in_flight_.load(std::memory_order_relaxed);
+        j["queue_depth"] = gate->waiting_.load(std::memory_order_relaxed);
+        j["max_concurrent_requests"] = gate->max_concurrent_.load(std::memory_order_relaxed);
+        j["max_queue_depth"] = gate->max_queue_depth_.load(std::memory_order_relaxed);
+        j["admitted"] = gate->admitted_.load(std::memory_order_relaxed);
+        j["queued"] = gate->queued_.load(std::memory_order_relaxed);
+        j["rejected_rate_limited"] = gate->rate_limited_.load(std::memory_order_relaxed);
+        j["rejected_saturated"] = gate->saturated_.load(std::memory_order_relaxed);
+        j["rate_limit"] = {
+            {"requests_per_minute", rate.limit},
+            {"burst", rate.burst},
+            {"remaining", rate.remaining}
+        };
+        j["queue_wait_ms"] = gate->queue_wait_us_.to_json(1000.0);
+        j["queue_depth_histogram"] = gate->queue_depth_.to_json();
+        providers[name] = std::move(j);
+    }
+
+    return providers;
+}
+
+} // namespace gateway
+} // namespace aimux
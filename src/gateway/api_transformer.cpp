@@ -121,25 +121,30 @@ TransformResult ApiTransformer::anthropic_to_openai_request(const nlohmann::json
             result.field_mappings["model"] = anthropic_model + " -> " + openai_req["model"].get<std::string>();
         }
 
-        // Transform messages
-        if (anthropic_req.contains("messages")) {
-            openai_req["messages"] = transform_messages_anthropic_to_openai(anthropic_req["messages"]);
-        }
-
-        // Handle system message (Anthropic has separate system field)
+        // Handle system message (Anthropic has separate system field); it goes
+        // first so the transformed messages are appended rather than shifted
         if (anthropic_req.contains("system")) {
             nlohmann::json system_msg;
             system_msg["role"] = "system";
             system_msg["content"] = anthropic_req["system"];
 
-            if (!openai_req.contains("messages")) {
-                openai_req["messages"] = nlohmann::json::array();
-            }
-
-            openai_req["messages"].insert(openai_req["messages"].begin(), system_msg);
+            openai_req["messages"] = nlohmann::json::array();
+            openai_req["messages"].push_back(std::move(system_msg));
             result.field_mappings["system"] = "system -> messages[0].content";
         }
 
+        // Transform messages
+        if (anthropic_req.contains("messages")) {
+            nlohmann::json messages = transform_messages_anthropic_to_openai(anthropic_req["messages"]);
+            if (openai_req.contains("messages")) {
+                for (auto& message : messages) {
+                    openai_req["messages"].push_back(std::move(message));
+                }
+            } else {
+                openai_req["messages"] = std::move(messages);
+            }
+        }
+
         // Copy common parameters with adaptation
         std::vector<std::string> common_params = {"max_tokens", "temperature", "top_p"};
         for (const auto& param : common_params) {
@@ -0,0 +1,255 @@
+#include "aimux/gateway/async_request_pipeline.hpp"
+#include "aimux/logging/logger.hpp"
+#include <algorithm>
+
+namespace aimux {
+namespace gateway {
+
+// ============================================================================
+// AsyncPipelineConfig
+// ============================================================================
+
+nlohmann::json AsyncPipelineConfig::to_json() const {
+    nlohmann::json j;
+    j["worker_threads"] = worker_threads_;
+    j["max_concurrent_requests"] = max_concurrent_requests_;
+    j["max_queue_depth"] = max_queue_depth_;
+    j["max_queue_wait_ms"] = max_queue_wait_.count();
+    return j;
+}
+
+AsyncPipelineConfig AsyncPipelineConfig::from_json(const nlohmann::json& j) {
+    AsyncPipelineConfig config;
+    config.worker_threads_ = j.value("worker_threads", static_cast<size_t>(4));
+    config.max_concurrent_requests_ = j.value("max_concurrent_requests", 1024);
+    config.max_queue_depth_ = j.value("max_queue_depth", 4096);
+    config.max_queue_wait_ = std::chrono::milliseconds(j.value("max_queue_wait_ms", 30000));
+    return config;
+}
+
+// ============================================================================
+// AsyncRequestPipeline
+// ============================================================================
+
+AsyncRequestPipeline::AsyncRequestPipeline(Dispatcher dispatcher, const AsyncPipelineConfig& config)
+    : dispatcher_(std::move(dispatcher)) {
+    update_limits(config);
+
+    size_t worker_count = std::max<size_t>(1, config.worker_threads_);
+    workers_.reserve(worker_count);
+    for (size_t i = 0; i < worker_count; ++i) {
+        workers_.emplace_back(&AsyncRequestPipeline::worker_loop, this);
+    }
+}
+
+AsyncRequestPipeline::~AsyncRequestPipeline() {
+    stop();
+}
+
+void AsyncRequestPipeline::update_limits(const AsyncPipelineConfig& config) {
+    max_concurrent_.store(std::max(1, config.max_concurrent_requests_), std::memory_order_relaxed);
+    max_queue_depth_.store(std::max(0, config.max_queue_depth_), std::memory_order_relaxed);
+    max_queue_wait_ms_.store(std::max<int64_t>(0, config.max_queue_wait_.count()), std::memory_order_relaxed);
+
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+    }
+    work_available_.notify_all();
+}
+
+bool AsyncRequestPipeline::submit(core::Request request, Completion on_complete) {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (!accepting_ ||
+            queue_.size() >= static_cast<size_t>(max_queue_depth_.load(std::memory_order_relaxed))) {
+            shed_.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+        queue_.push_back({std::move(request), std::move(on_complete), std::chrono::steady_clock::now()});
+    }
+    submitted_.fetch_add(1, std::memory_order_relaxed);
+    work_available_.notify_one();
+    return true;
+}
+
+void AsyncRequestPipeline::post(std::function<void()> task) {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        tasks_.push_back(std::move(task));
+    }
+    work_available_.notify_one();
+}
+
+void AsyncRequestPipeline::stop() {
+    std::deque<Pending> abandoned;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (exit_) {
+            return;
+        }
+        accepting_ = false;
+        abandoned.swap(queue_);
+    }
+
+    for (auto& pending : abandoned) {
+        complete(pending.on_complete, make_rejection(503, "SHUTTING_DOWN", "Gateway is shutting down"));
+    }
+
+    // Workers keep running continuations until every dispatched request has completed
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        drained_.wait(lock, [this] {
+            return in_flight_.load(std::memory_order_acquire) == 0 && tasks_.empty();
+        });
+        exit_ = true;
+    }
+    work_available_.notify_all();
+
+    for (auto& worker : workers_) {
+        if (worker.joinable()) {
+            worker.join();
+        }
+    }
+}
+
+size_t AsyncRequestPipeline::queue_depth() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return queue_.size();
+}
+
+void AsyncRequestPipeline::worker_loop() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (true) {
+        if (!tasks_.empty()) {
+            std::function<void()> task = std::move(tasks_.front());
+            tasks_.pop_front();
+            lock.unlock();
+            try {
+                task();
+            } catch (const std::exception& e) {
+                aimux::error("AsyncRequestPipeline: task failed: " + std::string(e.what()));
+            }
+            lock.lock();
+            if (tasks_.empty()) {
+                drained_.notify_all();
+            }
+            continue;
+        }
+
+        if (!queue_.empty()) {
+            auto max_wait = std::chrono::milliseconds(max_queue_wait_ms_.load(std::memory_order_relaxed));
+            auto deadline = queue_.front().enqueued + max_wait;
+
+            // Oldest first: it is either dispatched now or has waited too long
+            if (std::chrono::steady_clock::now() >= deadline) {
+                Pending pending = std::move(queue_.front());
+                queue_.pop_front();
+                lock.unlock();
+                expired_.fetch_add(1, std::memory_order_relaxed);
+                complete(pending.on_complete, make_rejection(503, "QUEUE_TIMEOUT",
+                    "Request waited " + std::to_string(max_wait.count()) + "ms without an upstream slot"));
+                lock.lock();
+                continue;
+            }
+
+            if (in_flight_.load(std::memory_order_acquire) < max_concurrent_.load(std::memory_order_relaxed)) {
+                Pending pending = std::move(queue_.front());
+                queue_.pop_front();
+                in_flight_.fetch_add(1, std::memory_order_acq_rel);
+                lock.unlock();
+                dispatch(std::move(pending));
+                lock.lock();
+                continue;
+            }
+
+            if (exit_) {
+                return;
+            }
+            work_available_.wait_until(lock, deadline);
+            continue;
+        }
+
+        if (exit_) {
+            return;
+        }
+        work_available_.wait(lock);
+    }
+}
+
+void AsyncRequestPipeline::dispatch(Pending pending) {
+    int current = in_flight_.load(std::memory_order_relaxed);
+    int peak = peak_in_flight_.load(std::memory_order_relaxed);
+    while (current > peak && !peak_in_flight_.compare_exchange_weak(peak, current, std::memory_order_relaxed)) {
+    }
+    queue_wait_us_.record(static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now() - pending.enqueued).count()));
+
+    // Frees the slot exactly once, however many times the dispatcher calls back
+    auto finished = std::make_shared<std::atomic<bool>>(false);
+    Completion on_complete = std::move(pending.on_complete);
+    Completion done = [this, finished, on_complete](core::Response response) {
+        if (finished->exchange(true)) {
+            return;
+        }
+        complete(on_complete, std::move(response));
+        completed_.fetch_add(1, std::memory_order_relaxed);
+
+        in_flight_.fetch_sub(1, std::memory_order_acq_rel);
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+        }
+        work_available_.notify_one();
+        drained_.notify_all();
+    };
+
+    try {
+        dispatcher_(pending.request, done);
+    } catch (const std::exception& e) {
+        aimux::error("AsyncRequestPipeline: dispatch failed: " + std::string(e.what()));
+        done(make_rejection(500, "DISPATCH_FAILED", e.what()));
+    }
+}
+
+void AsyncRequestPipeline::complete(const Completion& on_complete, core::Response response) {
+    try {
+        on_complete(std::move(response));
+    } catch (const std::exception& e) {
+        aimux::error("AsyncRequestPipeline: completion failed: " + std::string(e.what()));
+    }
+}
+
+core::Response AsyncRequestPipeline::make_rejection(int status_code, const std::string& code,
+                                                    const std::string& message) {
+    nlohmann::json error;
+    error["error"]["type"] = "overloaded_error";
+    error["error"]["code"] = code;
+    error["error"]["message"] = message;
+    error["error"]["status"] = status_code;
+
+    core::Response response;
+    response.success = false;
+    response.status_code = status_code;
+    response.error_message = message;
+    response.data = error.dump();
+    return response;
+}
+
+nlohmann::json AsyncRequestPipeline::to_json() const {
+    nlohmann::json j;
+    j["workers"] = workers_.size();
+    j["max_concurrent_requests"] = max_concurrent_.load(std::memory_order_relaxed);
+    j["max_queue_depth"] = max_queue_depth_.load(std::memory_order_relaxed);
+    j["max_queue_wait_ms"] = max_queue_wait_ms_.load(std::memory_order_relaxed);
+    j["in_flight"] = in_flight_.load(std::memory_order_relaxed);
+    j["peak_in_flight"] = peak_in_flight_.load(std::memory_order_relaxed);
+    j["queue_depth"] = queue_depth();
+    j["submitted"] = submitted_.load(std::memory_order_relaxed);
+    j["completed"] = completed_.load(std::memory_order_relaxed);
+    j["shed"] = shed_.load(std::memory_order_relaxed);
+    j["expired"] = expired_.load(std::memory_order_relaxed);
+    j["queue_wait_ms"] = queue_wait_us_.to_json(1000.0);
+    return j;
+}
+
+} // namespace gateway
+} // namespace aimux
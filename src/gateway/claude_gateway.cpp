@@ -20,6 +20,9 @@ ClaudeGatewayMetrics::ClaudeGatewayMetrics(const ClaudeGatewayMetrics& other)
       successful_requests(other.successful_requests.load()),
       failed_requests(other.failed_requests.load()),
       total_response_time_ms(other.total_response_time_ms.load()),
+      json_parses(other.json_parses.load()),
+      json_dumps(other.json_dumps.load()),
+      json_reuses(other.json_reuses.load()),
       start_time(other.start_time) {
 }
 
@@ -30,6 +33,9 @@ ClaudeGatewayMetrics& ClaudeGatewayMetrics::operator=(const ClaudeGatewayMetrics
         successful_requests.store(other.successful_requests.load());
         failed_requests.store(other.failed_requests.load());
         total_response_time_ms.store(other.total_response_time_ms.load());
+        json_parses.store(other.json_parses.load());
+        json_dumps.store(other.json_dumps.load());
+        json_reuses.store(other.json_reuses.load());
         start_time = other.start_time;
     }
     return *this;
@@ -41,6 +47,9 @@ ClaudeGatewayMetrics::ClaudeGatewayMetrics(ClaudeGatewayMetrics&& other) noexcep
       successful_requests(other.successful_requests.load()),
       failed_requests(other.failed_requests.load()),
       total_response_time_ms(other.total_response_time_ms.load()),
+      json_parses(other.json_parses.load()),
+      json_dumps(other.json_dumps.load()),
+      json_reuses(other.json_reuses.load()),
       start_time(std::move(other.start_time)) {
 }
 
@@ -51,6 +60,9 @@ ClaudeGatewayMetrics& ClaudeGatewayMetrics::operator=(ClaudeGatewayMetrics&& oth
         successful_requests.store(other.successful_requests.load());
         failed_requests.store(other.failed_requests.load());
         total_response_time_ms.store(other.total_response_time_ms.load());
+        json_parses.store(other.json_parses.load());
+        json_dumps.store(other.json_dumps.load());
+        json_reuses.store(other.json_reuses.load());
         start_time = std::move(other.start_time);
     }
     return *this;
@@ -64,6 +76,15 @@ nlohmann::json ClaudeGatewayMetrics::to_json() const {
     j["success_rate"] = get_success_rate();
     j["average_response_time_ms"] = get_average_response_time();
     j["uptime_seconds"] = get_uptime_seconds();
+
+    uint64_t total = total_requests.load();
+    j["json_codec"] = {
+        {"parses", json_parses.load()},
+        {"dumps", json_dumps.load()},
+        {"reuses", json_reuses.load()},
+        {"parses_per_request", total > 0 ? static_cast<double>(json_parses.load()) / total : 0.0},
+        {"dumps_per_request", total > 0 ? static_cast<double>(json_dumps.load()) / total : 0.0}
+    };
     j["start_time_iso"] = std::chrono::duration_cast<std::chrono::milliseconds>(
         start_time.time_since_epoch()).count();
     return j;
@@ -84,6 +105,10 @@ nlohmann::json ClaudeGatewayConfig::to_json() const {
     j["request_logging"] = request_logging;
     j["max_request_size_mb"] = max_request_size_mb;
     j["request_timeout_seconds"] = request_timeout.count();
+    j["worker_threads"] = worker_threads;
+    j["max_concurrent_requests"] = max_concurrent_requests;
+    j["max_queued_requests"] = max_queued_requests;
+    j["max_queue_wait_ms"] = max_queue_wait.count();
     return j;
 }
 
@@ -98,9 +123,22 @@ ClaudeGatewayConfig ClaudeGatewayConfig::from_json(const nlohmann::json& j) {
     config.request_logging = j.value("request_logging", false);
     config.max_request_size_mb = j.value("max_request_size_mb", 10U);
     config.request_timeout = std::chrono::seconds(j.value("request_timeout_seconds", 60));
+    config.worker_threads = j.value("worker_threads", static_cast<size_t>(4));
+    config.max_concurrent_requests = j.value("max_concurrent_requests", 1024);
+    config.max_queued_requests = j.value("max_queued_requests", 4096);
+    config.max_queue_wait = std::chrono::milliseconds(j.value("max_queue_wait_ms", 30000));
     return config;
 }
 
+AsyncPipelineConfig ClaudeGatewayConfig::pipeline_config() const {
+    AsyncPipelineConfig pipeline;
+    pipeline.worker_threads_ = worker_threads;
+    pipeline.max_concurrent_requests_ = max_concurrent_requests;
+    pipeline.max_queue_depth_ = max_queued_requests;
+    pipeline.max_queue_wait_ = max_queue_wait;
+    return pipeline;
+}
+
 // ============================================================================
 // ClaudeGateway Implementation
 // ============================================================================
@@ -143,6 +181,18 @@ void ClaudeGateway::initialize(const ClaudeGatewayConfig& config) {
             aimux::warn("Could not load provider config: " + std::string(e.what()));
         }
 
+        // Requests are routed off the Crow threads; continuations run on the pipeline workers
+        if (pipeline_) {
+            pipeline_->stop();
+        }
+        pipeline_ = std::make_unique<AsyncRequestPipeline>(
+            [this](const core::Request& request, AsyncRequestPipeline::Completion done) {
+                manager_->route_request_async(request, std::move(done), [this](std::function<void()> task) {
+                    pipeline_->post(std::move(task));
+                });
+            },
+            config_.pipeline_config());
+
         // Setup Crow routes
         setup_routes();
 
@@ -216,6 +266,11 @@ void ClaudeGateway::shutdown() {
         stop();
     }
 
+    // Finish in-flight requests before their providers go away
+    if (pipeline_) {
+        pipeline_->stop();
+    }
+
     if (manager_) {
         manager_->shutdown();
     }
@@ -247,6 +302,9 @@ ClaudeGatewayMetrics ClaudeGateway::get_metrics() const {
     result.successful_requests.store(metrics_.successful_requests.load());
     result.failed_requests.store(metrics_.failed_requests.load());
     result.total_response_time_ms.store(metrics_.total_response_time_ms.load());
+    result.json_parses.store(metrics_.json_parses.load());
+    result.json_dumps.store(metrics_.json_dumps.load());
+    result.json_reuses.store(metrics_.json_reuses.load());
     result.start_time = metrics_.start_time;
     return result;
 }
@@ -256,6 +314,9 @@ void ClaudeGateway::reset_metrics() {
     metrics_.successful_requests.store(0);
     metrics_.failed_requests.store(0);
     metrics_.total_response_time_ms.store(0.0);
+    metrics_.json_parses.store(0);
+    metrics_.json_dumps.store(0);
+    metrics_.json_reuses.store(0);
     metrics_.start_time = std::chrono::steady_clock::now();
     aimux::info("ClaudeGateway: Metrics reset");
 }
@@ -269,6 +330,10 @@ nlohmann::json ClaudeGateway::get_detailed_metrics() const {
         detailed["provider_configs"] = manager_->get_provider_configs();
     }
 
+    if (pipeline_) {
+        detailed["pipeline"] = pipeline_->to_json();
+    }
+
     detailed["service_status"] = nlohmann::json::object({
         {"initialized", initialized_.load()},
         {"running", running_.load()},
@@ -331,8 +396,8 @@ void ClaudeGateway::setup_anthropic_routes() {
     // Main messages endpoint - Claude Code compatible
     app_.route_dynamic("/anthropic/v1/messages")
         .methods("POST"_method)
-        ([this](const crow::request& req) {
-            return handle_messages_endpoint(req);
+        ([this](const crow::request& req, crow::response& res) {
+            handle_messages_endpoint(req, res);    // Ends the response when routing completes
         });
 
     // Models endpoint
@@ -436,48 +501,78 @@ void ClaudeGateway::setup_health_routes() {
     aimux::debug("ClaudeGateway: Health routes configured");
 }
 
-crow::response ClaudeGateway::handle_messages_endpoint(const crow::request& req) {
+void ClaudeGateway::handle_messages_endpoint(const crow::request& req, crow::response& res) {
     auto start_time = std::chrono::high_resolution_clock::now();
+    core::JsonCodecScope json_scope;
 
     try {
-        // Validate request
+        // Validate request; the body is parsed once here and handed on
+        nlohmann::json body;
         std::string validation_error;
-        if (!validate_request(req, validation_error)) {
+        if (!validate_request(req, body, validation_error)) {
             metrics_.failed_requests++;
-            return create_error_response(400, "INVALID_REQUEST", validation_error);
+            res = create_error_response(400, "INVALID_REQUEST", validation_error);
+            res.end();
+            return;
         }
 
         // Convert to core request
-        core::Request core_req = convert_crow_request(req);
-
-        // Route through gateway manager
-        core::Response core_resp = manager_->route_request(core_req);
-
-        // Calculate duration
-        auto end_time = std::chrono::high_resolution_clock::now();
-        double duration_ms = std::chrono::duration<double, std::milli>(end_time - start_time).count();
-
-        // Update metrics
-        update_metrics(core_resp, duration_ms);
-
-        // Log request if enabled
-        if (config_.request_logging) {
-            log_request(req, core_resp, duration_ms);
-        }
-
-        // Convert response
-        crow::response resp = convert_core_response(core_resp);
-
-        // Set CORS headers
-        setup_cors_headers(resp);
+        core::Request core_req = convert_crow_request(std::move(body));
+        auto callback_request = request_callback_ ? std::make_shared<core::Request>(core_req) : nullptr;
+        core::JsonCodecCounters request_json_work = json_scope.counters();
+
+        // Route through the pipeline; this Crow thread is released right after queueing.
+        // req and res stay valid until res.end(), which the completion calls.
+        bool accepted = pipeline_ && pipeline_->submit(std::move(core_req),
+            [this, &req, &res, start_time, request_json_work, callback_request](core::Response core_resp) {
+                // Counters are per thread: this adds the completion's work to the
+                // validation measured above, not what ran on pipeline workers
+                core::JsonCodecScope completion_scope;
+                try {
+                    // Calculate duration
+                    auto end_time = std::chrono::high_resolution_clock::now();
+                    double duration_ms = std::chrono::duration<double, std::milli>(end_time - start_time).count();
+
+                    // Convert response
+                    crow::response resp = convert_core_response(core_resp);
+
+                    // Update metrics
+                    core::JsonCodecCounters json_work = request_json_work + completion_scope.counters();
+                    update_metrics(core_resp, duration_ms, json_work);
+                    resp.set_header("X-Aimux-Json-Codec", "parses=" + std::to_string(json_work.parses) +
+                                    ", dumps=" + std::to_string(json_work.dumps) +
+                                    ", reuses=" + std::to_string(json_work.reuses));
+
+                    // Log request if enabled
+                    if (config_.request_logging) {
+                        log_request(req, core_resp, duration_ms);
+                    }
+
+                    // Set CORS headers
+                    setup_cors_headers(resp);
+
+                    // Trigger callback if set
+                    if (request_callback_ && callback_request) {
+                        request_callback_(*callback_request, core_resp, duration_ms);
+                    }
+
+                    res = std::move(resp);
+                } catch (const std::exception& e) {
+                    metrics_.failed_requests++;
+                    log_error("MESSAGES_ENDPOINT", e.what());
+                    res = create_error_response(500, "INTERNAL_ERROR", e.what());
+                }
+                res.end();
+            });
 
-        // Trigger callback if set
-        if (request_callback_) {
-            request_callback_(core_req, core_resp, duration_ms);
+        if (!accepted) {
+            // Shed load here rather than queue behind requests that will time out anyway
+            metrics_.failed_requests++;
+            res = create_error_response(503, "OVERLOADED", "Too many requests in progress, retry shortly");
+            res.set_header("Retry-After", "1");
+            res.end();
         }
 
-        return resp;
-
     } catch (const std::exception& e) {
         metrics_.failed_requests++;
         log_error("MESSAGES_ENDPOINT", e.what());
@@ -486,7 +581,8 @@ crow::response ClaudeGateway::handle_messages_endpoint(const crow::request& req)
             error_callback_("MESSAGES_ENDPOINT", e.what());
         }
 
-        return create_error_response(500, "INTERNAL_ERROR", e.what());
+        res = create_error_response(500, "INTERNAL_ERROR", e.what());
+        res.end();
     }
 }
 
@@ -561,19 +657,17 @@ crow::response ClaudeGateway::handle_providers_request(const crow::request& /* r
     }
 }
 
-core::Request ClaudeGateway::convert_crow_request(const crow::request& req) {
+core::Request ClaudeGateway::convert_crow_request(nlohmann::json body) {
     core::Request request;
+    request.method = "POST";
 
     // Extract model from request body
     try {
-        nlohmann::json body = nlohmann::json::parse(req.body);
         request.model = body.value("model", "claude-3-sonnet-20240229");
-        request.method = "POST";
-        request.data = body;
+        request.data = std::move(body);
     } catch (const std::exception& e) {
-        // If JSON parsing fails, create basic request
+        // Unusable body, create basic request
         request.model = "claude-3-sonnet-20240229";
-        request.method = "POST";
         request.data = nlohmann::json::object();
     }
 
@@ -594,8 +688,11 @@ crow::response ClaudeGateway::convert_core_response(const core::Response& resp)
     } else {
         // Parse error data for proper HTTP status
         try {
-            nlohmann::json error_data = nlohmann::json::parse(resp.data);
-            int status_code = error_data.value("error", nlohmann::json::object()).value("status", 500);
+            const nlohmann::json* error_data = resp.json();
+            if (!error_data) {
+                throw std::invalid_argument("error body is not JSON");
+            }
+            int status_code = error_data->value("error", nlohmann::json::object()).value("status", 500);
             crow_resp.code = status_code;
         } catch (...) {
             crow_resp.code = resp.status_code > 0 ? resp.status_code : 500;
@@ -628,7 +725,7 @@ crow::response ClaudeGateway::create_error_response(int status, const std::strin
     return resp;
 }
 
-bool ClaudeGateway::validate_request(const crow::request& req, std::string& error_msg) {
+bool ClaudeGateway::validate_request(const crow::request& req, nlohmann::json& body, std::string& error_msg) {
     // Check request size
     if (!is_request_size_valid(req)) {
         error_msg = "Request too large (max " + std::to_string(config_.max_request_size_mb) + "MB)";
@@ -644,7 +741,7 @@ bool ClaudeGateway::validate_request(const crow::request& req, std::string& erro
 
     // Validate JSON structure
     try {
-        nlohmann::json body = nlohmann::json::parse(req.body);
+        body = core::parse_json(req.body);
 
         // Check required fields
         if (!body.contains("messages") || !body["messages"].is_array()) {
@@ -690,13 +787,17 @@ void ClaudeGateway::log_error(const std::string& type, const std::string& messag
     aimux::error("ClaudeGateway[" + type + "]: " + message);
 }
 
-void ClaudeGateway::update_metrics(const core::Response& resp, double duration_ms) {
+void ClaudeGateway::update_metrics(const core::Response& resp, double duration_ms,
+                                   const core::JsonCodecCounters& json_work) {
     if (!config_.enable_metrics) {
         return;
     }
 
     metrics_.total_requests++;
     metrics_.total_response_time_ms += duration_ms;
+    metrics_.json_parses += json_work.parses;
+    metrics_.json_dumps += json_work.dumps;
+    metrics_.json_reuses += json_work.reuses;
 
     if (resp.success) {
         metrics_.successful_requests++;
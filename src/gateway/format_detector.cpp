@@ -1,38 +1,392 @@
 #include "aimux/gateway/format_detector.hpp"
 #include <algorithm>
 #include <cctype>
+#include <cmath>
+#include <cstring>
+#include <iterator>
 #include <sstream>
 #include <regex>
 
 namespace aimux {
 namespace gateway {
 
+namespace {
+
+// combine_results() weights: endpoint, headers, model, structure, body
+constexpr double DETECTOR_WEIGHTS[] = {0.4, 0.3, 0.15, 0.1, 0.05};
+constexpr double MODEL_WEIGHT_MAX = DETECTOR_WEIGHTS[2] * 0.7;
+constexpr double STRUCTURE_WEIGHT_MAX = DETECTOR_WEIGHTS[3] * 0.6;
+constexpr double BODY_WEIGHT_MAX = DETECTOR_WEIGHTS[4] * 0.6;
+
+bool iequals(std::string_view a, std::string_view b) {
+    return a.size() == b.size() &&
+           std::equal(a.begin(), a.end(), b.begin(), [](unsigned char x, unsigned char y) {
+               return std::tolower(x) == std::tolower(y);
+           });
+}
+
+bool icontains(std::string_view haystack, std::string_view needle) {
+    return std::search(haystack.begin(), haystack.end(), needle.begin(), needle.end(),
+                       [](unsigned char x, unsigned char y) { return std::tolower(x) == std::tolower(y); }) !=
+           haystack.end();
+}
+
+DetectionResult header_result(bool has_anthropic_headers, bool has_openai_headers) {
+    DetectionResult result;
+    if (has_anthropic_headers && !has_openai_headers) {
+        result.format = APIFormat::ANTHROPIC;
+        result.confidence = 0.8;
+        result.reasoning = "Found Anthropic-specific headers";
+    } else if (has_openai_headers && !has_anthropic_headers) {
+        result.format = APIFormat::OPENAI;
+        result.confidence = 0.8;
+        result.reasoning = "Found OpenAI-specific headers";
+    } else if (has_anthropic_headers && has_openai_headers) {
+        // Both detected - need more context, lower confidence
+        result.format = APIFormat::UNKNOWN;
+        result.confidence = 0.3;
+        result.reasoning = "Conflicting headers found - both Anthropic and OpenAI patterns detected";
+    } else {
+        result.reasoning = "No format-specific headers detected";
+    }
+    return result;
+}
+
+// Field scoring shared by the parsed-body and scanned-prefix paths
+template <typename HasKey>
+DetectionResult score_body_fields(HasKey&& has_key) {
+    DetectionResult result;
+
+    // Look for Anthropic-specific fields
+    std::vector<std::string> anthropic_fields = {"max_tokens", "temperature", "top_p", "top_k"};
+    std::vector<std::string> openai_fields = {"max_tokens", "temperature", "top_p", "frequency_penalty", "presence_penalty"};
+
+    int anthropic_score = 0;
+    int openai_score = 0;
+
+    for (const auto& field : anthropic_fields) {
+        if (has_key(field)) anthropic_score++;
+    }
+
+    for (const auto& field : openai_fields) {
+        if (has_key(field)) openai_score++;
+    }
+
+    // Check for unique fields
+    if (has_key("top_k")) {
+        anthropic_score += 2; // top_k is more unique to Anthropic
+    }
+
+    if (has_key("anthropic_version")) {
+        anthropic_score += 3; // Bedrock / Vertex style Anthropic bodies
+    }
+
+    if (has_key("frequency_penalty") || has_key("presence_penalty")) {
+        openai_score += 2; // These are OpenAI-specific
+    }
+
+    if (anthropic_score > openai_score) {
+        result.format = APIFormat::ANTHROPIC;
+        result.confidence = std::min(0.6, 0.1 + (anthropic_score * 0.1));
+        result.reasoning = "Body contains Anthropic-specific fields";
+    } else if (openai_score > anthropic_score) {
+        result.format = APIFormat::OPENAI;
+        result.confidence = std::min(0.6, 0.1 + (openai_score * 0.1));
+        result.reasoning = "Body contains OpenAI-specific fields";
+    } else {
+        result.reasoning = "Body format analysis inconclusive";
+    }
+
+    return result;
+}
+
+DetectionResult structure_result(bool anthropic, bool openai) {
+    DetectionResult result;
+    if (anthropic) {
+        result.format = APIFormat::ANTHROPIC;
+        result.confidence = 0.6;
+        result.reasoning = "Message structure matches Anthropic format";
+    } else if (openai) {
+        result.format = APIFormat::OPENAI;
+        result.confidence = 0.6;
+        result.reasoning = "Message structure matches OpenAI format";
+    } else {
+        result.reasoning = "Message structure not recognized";
+    }
+    return result;
+}
+
+/**
+ * Top-level keys found in a bounded prefix of the raw body. Values are
+ * skipped without decoding; a value running past the limit ends the scan.
+ */
+struct BodyPrefix {
+    std::vector<std::string_view> keys;
+    std::string_view model;
+    bool complete = false;   // The closing brace of the object was reached
+
+    // A message with content and this role, as has_*_message_structure() checks for
+    bool user_or_assistant_message = false;
+    bool system_message = false;
+
+    bool has(std::string_view key) const {
+        return std::find(keys.begin(), keys.end(), key) != keys.end();
+    }
+};
+
+class PrefixScanner {
+public:
+    PrefixScanner(std::string_view body, size_t limit) : text_(body.substr(0, limit)) {}
+
+    BodyPrefix scan() {
+        BodyPrefix prefix;
+        if (!consume('{')) {
+            return prefix;
+        }
+        if (consume('}')) {
+            prefix.complete = true;
+            return prefix;
+        }
+        while (peek() == '"') {
+            std::string_view key = string_token();
+            if (key.empty() || !consume(':')) {
+                return prefix;
+            }
+            key = key.substr(1, key.size() - 2);
+            peek();
+            size_t value_start = pos_;
+            if (!skip_value()) {
+                return prefix;
+            }
+            prefix.keys.push_back(key);
+            std::string_view value = text_.substr(value_start, pos_ - value_start);
+            if (key == "model") {
+                if (value.size() >= 2 && value.front() == '"') {
+                    prefix.model = value.substr(1, value.size() - 2);
+                }
+            } else if (key == "messages") {
+                PrefixScanner(value, value.size()).scan_message_roles(prefix);
+            }
+            if (consume('}')) {
+                prefix.complete = true;
+                return prefix;
+            }
+            if (!consume(',')) {
+                return prefix;
+            }
+        }
+        return prefix;
+    }
+
+private:
+    // Walk a complete messages array, noting the roles of messages that carry content
+    void scan_message_roles(BodyPrefix& prefix) {
+        if (!consume('[') || consume(']')) {
+            return;
+        }
+        do {
+            if (peek() != '{') {
+                if (!skip_value()) {
+                    return;
+                }
+                continue;
+            }
+            ++pos_;
+            std::string_view role;
+            bool content = false;
+            while (peek() == '"') {
+                std::string_view key = string_token();
+                if (key.empty() || !consume(':')) {
+                    return;
+                }
+                peek();
+                size_t value_start = pos_;
+                if (!skip_value()) {
+                    return;
+                }
+                if (key == "\"role\"") {
+                    role = text_.substr(value_start, pos_ - value_start);
+                } else if (key == "\"content\"") {
+                    content = true;
+                }
+                if (!consume(',')) {
+                    break;
+                }
+            }
+            if (!consume('}')) {
+                return;
+            }
+            if (content && (role == "\"user\"" || role == "\"assistant\"")) {
+                prefix.user_or_assistant_message = true;
+            } else if (content && role == "\"system\"") {
+                prefix.system_message = true;
+            }
+        } while (consume(','));
+    }
+
+    char peek() {
+        while (pos_ < text_.size() && std::isspace(static_cast<unsigned char>(text_[pos_]))) {
+            ++pos_;
+        }
+        return pos_ < text_.size() ? text_[pos_] : '\0';
+    }
+
+    bool consume(char c) {
+        if (peek() == c) {
+            ++pos_;
+            return true;
+        }
+        return false;
+    }
+
+    // String token with its quotes, or empty if it runs past the limit
+    std::string_view string_token() {
+        size_t start = pos_++;
+        while (pos_ < text_.size()) {
+            const void* hit = std::memchr(text_.data() + pos_, '"', text_.size() - pos_);
+            if (!hit) {
+                break;
+            }
+            size_t quote = static_cast<const char*>(hit) - text_.data();
+            size_t backslashes = 0;
+            while (quote - backslashes > start + 1 && text_[quote - backslashes - 1] == '\\') {
+                ++backslashes;
+            }
+            pos_ = quote + 1;
+            if (backslashes % 2 == 0) {
+                return text_.substr(start, pos_ - start);
+            }
+        }
+        return {};
+    }
+
+    bool skip_value() {
+        char c = peek();
+        if (c == '"') {
+            return !string_token().empty();
+        }
+        if (c != '{' && c != '[') {
+            while (pos_ < text_.size() && text_[pos_] != ',' && text_[pos_] != '}' && text_[pos_] != ']' &&
+                   !std::isspace(static_cast<unsigned char>(text_[pos_]))) {
+                ++pos_;
+            }
+            return pos_ < text_.size();
+        }
+        int depth = 0;
+        while (pos_ < text_.size()) {
+            c = text_[pos_];
+            if (c == '"') {
+                if (string_token().empty()) {
+                    return false;
+                }
+                continue;
+            }
+            ++pos_;
+            if (c == '{' || c == '[') {
+                ++depth;
+            } else if ((c == '}' || c == ']') && --depth == 0) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    std::string_view text_;
+    size_t pos_ = 0;
+};
+
+// Lead of the best format over the other, using combine_results() weights
+double score_margin(const std::vector<DetectionResult>& results) {
+    double anthropic = 0.0;
+    double openai = 0.0;
+    for (size_t i = 0; i < results.size() && i < std::size(DETECTOR_WEIGHTS); ++i) {
+        if (results[i].format == APIFormat::ANTHROPIC) {
+            anthropic += results[i].confidence * DETECTOR_WEIGHTS[i];
+        } else if (results[i].format == APIFormat::OPENAI) {
+            openai += results[i].confidence * DETECTOR_WEIGHTS[i];
+        }
+    }
+    return std::abs(anthropic - openai);
+}
+
+} // namespace
+
 FormatDetector::FormatDetector(const FormatDetectionConfig& config)
     : config_(config) {}
 
 DetectionResult FormatDetector::detect_format(const crow::request& req, const std::string& body) {
-    // Extract headers
+    // Tier 1: endpoint and headers, straight from Crow's case-insensitive map
+    std::vector<DetectionResult> results;
+    results.push_back(detect_from_endpoint(req.url));
+    results.push_back(detect_from_headers(req.headers));
+
+    const std::string& content_type = req.get_header_value("content-type");
+    bool json_body = !body.empty() &&
+                     (content_type.empty() || content_type.find("application/json") != std::string::npos);
+    if (!json_body) {
+        return combine_results(results);
+    }
+
+    double body_weight = MODEL_WEIGHT_MAX + STRUCTURE_WEIGHT_MAX + BODY_WEIGHT_MAX;
+    DetectionResult decided = combine_results(results);
+    if (decided.format != APIFormat::UNKNOWN && score_margin(results) > body_weight) {
+        return decided;
+    }
+
+    // Tier 2: top-level keys from a bounded prefix of the body
+    BodyPrefix prefix = PrefixScanner(body, config_.body_scan_limit).scan();
+    auto has_key = [&](std::string_view key) { return prefix.has(key); };
+    double unseen_weight = 0.0;
+
+    if (!prefix.model.empty()) {
+        results.push_back(detect_from_model(nlohmann::json{{"model", prefix.model}}));
+    } else {
+        results.emplace_back();
+        unseen_weight += prefix.complete ? 0.0 : MODEL_WEIGHT_MAX;
+    }
+    if (prefix.complete) {
+        // Whole object seen, message roles included: same checks as has_*_message_structure()
+        bool conversation = prefix.user_or_assistant_message;
+        results.push_back(structure_result(
+            conversation && prefix.has("system"),
+            (conversation || prefix.system_message) &&
+                (prefix.has("functions") || prefix.has("tools") ||
+                 prefix.has("response_format") || prefix.has("stream"))));
+        results.push_back(score_body_fields(has_key));
+        return combine_results(results);
+    }
+    unseen_weight += STRUCTURE_WEIGHT_MAX + BODY_WEIGHT_MAX;
+
+    // Bedrock and Vertex Anthropic bodies carry no model, only anthropic_version
+    if (decided.format == APIFormat::UNKNOWN && prefix.model.empty() && prefix.has("anthropic_version")) {
+        DetectionResult result;
+        result.format = APIFormat::ANTHROPIC;
+        result.confidence = score_body_fields(has_key).confidence * DETECTOR_WEIGHTS[4];
+        result.reasoning = "Body contains anthropic_version";
+        return result;
+    }
+
+    decided = combine_results(results);
+    if (decided.format != APIFormat::UNKNOWN && score_margin(results) > unseen_weight) {
+        return decided;
+    }
+
+    // Tier 3: still open, parse the whole body
     std::map<std::string, std::string> headers;
     for (const auto& header : req.headers) {
         headers[to_lower(header.first)] = header.second;
     }
 
-    // Get endpoint
-    std::string endpoint = req.url;
-
-    // Parse JSON body if possible
-    nlohmann::json json_data;
-
+    std::shared_ptr<nlohmann::json> document;
     try {
-        if (!body.empty() && (headers["content-type"].find("application/json") != std::string::npos ||
-                            headers["content-type"].empty())) {
-            json_data = nlohmann::json::parse(body);
-        }
+        document = std::make_shared<nlohmann::json>(nlohmann::json::parse(body));
     } catch (const nlohmann::json::exception&) {
         // JSON parsing failed, continue with other detection methods
     }
 
-    return detect_format(json_data, headers, endpoint);
+    DetectionResult result = detect_format(document ? *document : nlohmann::json(), headers, req.url);
+    result.document = std::move(document);
+    return result;
 }
 
 DetectionResult FormatDetector::detect_format(
@@ -117,74 +471,22 @@ DetectionResult FormatDetector::detect_from_endpoint(const std::string& endpoint
 }
 
 DetectionResult FormatDetector::detect_from_headers(const std::map<std::string, std::string>& headers) {
-    DetectionResult result;
-
     // Check for Anthropic headers
     bool has_anthropic_headers = has_header_pattern(headers, config_.anthropic_headers);
 
     // Check for OpenAI headers
     bool has_openai_headers = has_header_pattern(headers, config_.openai_headers);
 
-    if (has_anthropic_headers && !has_openai_headers) {
-        result.format = APIFormat::ANTHROPIC;
-        result.confidence = 0.8;
-        result.reasoning = "Found Anthropic-specific headers";
-    } else if (has_openai_headers && !has_anthropic_headers) {
-        result.format = APIFormat::OPENAI;
-        result.confidence = 0.8;
-        result.reasoning = "Found OpenAI-specific headers";
-    } else if (has_anthropic_headers && has_openai_headers) {
-        // Both detected - need more context, lower confidence
-        result.format = APIFormat::UNKNOWN;
-        result.confidence = 0.3;
-        result.reasoning = "Conflicting headers found - both Anthropic and OpenAI patterns detected";
-    } else {
-        result.reasoning = "No format-specific headers detected";
-    }
+    return header_result(has_anthropic_headers, has_openai_headers);
+}
 
-    return result;
+DetectionResult FormatDetector::detect_from_headers(const crow::ci_map& headers) {
+    return header_result(has_header_pattern(headers, config_.anthropic_headers),
+                         has_header_pattern(headers, config_.openai_headers));
 }
 
 DetectionResult FormatDetector::detect_from_body(const nlohmann::json& json_data) {
-    DetectionResult result;
-
-    // Look for Anthropic-specific fields
-    std::vector<std::string> anthropic_fields = {"max_tokens", "temperature", "top_p", "top_k"};
-    std::vector<std::string> openai_fields = {"max_tokens", "temperature", "top_p", "frequency_penalty", "presence_penalty"};
-
-    int anthropic_score = 0;
-    int openai_score = 0;
-
-    for (const auto& field : anthropic_fields) {
-        if (json_data.contains(field)) anthropic_score++;
-    }
-
-    for (const auto& field : openai_fields) {
-        if (json_data.contains(field)) openai_score++;
-    }
-
-    // Check for unique fields
-    if (json_data.contains("top_k")) {
-        anthropic_score += 2; // top_k is more unique to Anthropic
-    }
-
-    if (json_data.contains("frequency_penalty") || json_data.contains("presence_penalty")) {
-        openai_score += 2; // These are OpenAI-specific
-    }
-
-    if (anthropic_score > openai_score) {
-        result.format = APIFormat::ANTHROPIC;
-        result.confidence = std::min(0.6, 0.1 + (anthropic_score * 0.1));
-        result.reasoning = "Body contains Anthropic-specific fields";
-    } else if (openai_score > anthropic_score) {
-        result.format = APIFormat::OPENAI;
-        result.confidence = std::min(0.6, 0.1 + (openai_score * 0.1));
-        result.reasoning = "Body contains OpenAI-specific fields";
-    } else {
-        result.reasoning = "Body format analysis inconclusive";
-    }
-
-    return result;
+    return score_body_fields([&](const std::string& field) { return json_data.contains(field); });
 }
 
 DetectionResult FormatDetector::detect_from_model(const nlohmann::json& json_data) {
@@ -217,21 +519,8 @@ DetectionResult FormatDetector::detect_from_model(const nlohmann::json& json_dat
 }
 
 DetectionResult FormatDetector::detect_from_message_structure(const nlohmann::json& json_data) {
-    DetectionResult result;
-
-    if (has_anthropic_message_structure(json_data)) {
-        result.format = APIFormat::ANTHROPIC;
-        result.confidence = 0.6;
-        result.reasoning = "Message structure matches Anthropic format";
-    } else if (has_openai_message_structure(json_data)) {
-        result.format = APIFormat::OPENAI;
-        result.confidence = 0.6;
-        result.reasoning = "Message structure matches OpenAI format";
-    } else {
-        result.reasoning = "Message structure not recognized";
-    }
-
-    return result;
+    return structure_result(has_anthropic_message_structure(json_data),
+                            has_openai_message_structure(json_data));
 }
 
 bool FormatDetector::has_header_pattern(
@@ -255,6 +544,21 @@ bool FormatDetector::has_header_pattern(
     return false;
 }
 
+bool FormatDetector::has_header_pattern(
+    const crow::ci_map& headers,
+    const std::map<std::string, std::string>& patterns) {
+
+    for (const auto& header : headers) {
+        for (const auto& pattern : patterns) {
+            if (iequals(header.first, pattern.first) &&
+                (pattern.second.empty() || icontains(header.second, pattern.second))) {
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
 bool FormatDetector::matches_model_pattern(const std::string& model, const std::vector<std::string>& patterns) {
     for (const auto& pattern : patterns) {
         if (model.find(pattern) != std::string::npos) {
@@ -321,12 +625,10 @@ DetectionResult FormatDetector::combine_results(const std::vector<DetectionResul
     std::map<APIFormat, std::vector<std::string>> reasons;
 
     // Weight different detection methods
-    std::vector<double> weights = {0.4, 0.3, 0.15, 0.1, 0.05}; // endpoint, headers, model, structure, body
-
-    for (size_t i = 0; i < results.size() && i < weights.size(); ++i) {
+    for (size_t i = 0; i < results.size() && i < std::size(DETECTOR_WEIGHTS); ++i) {
         const auto& result = results[i];
         if (result.format != APIFormat::UNKNOWN) {
-            double weighted_score = result.confidence * weights[i];
+            double weighted_score = result.confidence * DETECTOR_WEIGHTS[i];
             format_scores[result.format] += weighted_score;
             if (!result.reasoning.empty()) {
                 reasons[result.format].push_back(result.reasoning);
@@ -2,16 +2,31 @@
 #include "aimux/logging/logger.hpp"
 #include "aimux/network/http_client.hpp"
 #include "aimux/providers/provider_impl.hpp"
+#include "aimux/core/cancellation.hpp"
+#include "aimux/core/thread_manager.hpp"
+#include "aimux/network/curl_multi_engine.hpp"
 #include <algorithm>
+#include <cmath>
 #include <random>
 #include <sstream>
 #include <fstream>
+#include <future>
 #include <regex>
 #include <iomanip>
+#include <thread>
 
 namespace aimux {
 namespace gateway {
 
+// Debug messages are only built when debug mode is on and the default logger accepts DEBUG
+#define GATEWAY_LOG_DEBUG(message) \
+    do { \
+        if (debug_mode_.load(std::memory_order_relaxed) && \
+            AIMUX_LOG_ENABLED(logging::default_logger(), logging::LogLevel::DEBUG)) { \
+            log_debug(message); \
+        } \
+    } while (0)
+
 // ============================================================================
 // GatewayProviderConfig Implementation
 // ============================================================================
@@ -31,6 +46,9 @@ nlohmann::json GatewayProviderConfig::to_json() const {
     j["success_rate"] = success_rate_;
     j["max_concurrent_requests"] = max_concurrent_requests_;
     j["cost_per_output_token"] = cost_per_output_token_;
+    j["max_requests_per_minute"] = max_requests_per_minute_;
+    j["max_queued_requests"] = max_queued_requests_;
+    j["max_queue_wait_ms"] = max_queue_wait_.count();
     j["health_check_interval"] = health_check_interval_.count();
     j["max_failures"] = max_failures_;
     j["recovery_delay"] = recovery_delay_.count();
@@ -54,6 +72,9 @@ GatewayProviderConfig GatewayProviderConfig::from_json(const nlohmann::json& j)
     config.success_rate_ = j.value("success_rate", 1.0);
     config.max_concurrent_requests_ = j.value("max_concurrent_requests", 10);
     config.cost_per_output_token_ = j.value("cost_per_output_token", 0.0);
+    config.max_requests_per_minute_ = j.value("max_requests_per_minute", 0);
+    config.max_queued_requests_ = j.value("max_queued_requests", 32);
+    config.max_queue_wait_ = std::chrono::milliseconds(j.value("max_queue_wait_ms", 250));
     config.health_check_interval_ = std::chrono::seconds(j.value("health_check_interval", 60));
     config.max_failures_ = j.value("max_failures", 5);
     config.recovery_delay_ = std::chrono::seconds(j.value("recovery_delay", 300));
@@ -62,6 +83,75 @@ GatewayProviderConfig GatewayProviderConfig::from_json(const nlohmann::json& j)
     return config;
 }
 
+AdmissionLimits GatewayProviderConfig::admission_limits() const {
+    AdmissionLimits limits;
+    limits.max_requests_per_minute_ = max_requests_per_minute_;
+    limits.max_concurrent_requests_ = max_concurrent_requests_;
+    limits.max_queue_depth_ = max_queued_requests_;
+    limits.max_queue_wait_ = max_queue_wait_;
+    return limits;
+}
+
+// ============================================================================
+// HedgingConfig / LatencyWindow Implementation
+// ============================================================================
+
+nlohmann::json HedgingConfig::to_json() const {
+    nlohmann::json j;
+    j["enabled"] = enabled_;
+    j["latency_percentile"] = latency_percentile_;
+    j["min_delay_ms"] = min_delay_.count();
+    j["max_delay_ms"] = max_delay_.count();
+    j["default_delay_ms"] = default_delay_.count();
+    j["min_samples"] = min_samples_;
+    j["max_hedges"] = max_hedges_;
+    return j;
+}
+
+HedgingConfig HedgingConfig::from_json(const nlohmann::json& j) {
+    HedgingConfig config;
+    config.enabled_ = j.value("enabled", false);
+    config.latency_percentile_ = std::clamp(j.value("latency_percentile", 95.0), 0.0, 100.0);
+    config.min_delay_ = std::chrono::milliseconds(j.value("min_delay_ms", 50));
+    config.max_delay_ = std::chrono::milliseconds(j.value("max_delay_ms", 5000));
+    config.default_delay_ = std::chrono::milliseconds(j.value("default_delay_ms", 1000));
+    config.min_samples_ = j.value("min_samples", static_cast<size_t>(20));
+    config.max_hedges_ = std::max(0, j.value("max_hedges", 1));
+    if (config.max_delay_ < config.min_delay_) {
+        config.max_delay_ = config.min_delay_;
+    }
+    return config;
+}
+
+void LatencyWindow::record(double latency_ms) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    samples_[next_] = latency_ms;
+    next_ = (next_ + 1) % CAPACITY;
+    count_ = std::min(count_ + 1, CAPACITY);
+}
+
+std::optional<double> LatencyWindow::percentile(double p, size_t min_samples) const {
+    std::array<double, CAPACITY> sorted;
+    size_t count;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        count = count_;
+        std::copy_n(samples_.begin(), count, sorted.begin());
+    }
+    if (count == 0 || count < min_samples) {
+        return std::nullopt;
+    }
+
+    size_t rank = static_cast<size_t>(std::clamp(p, 0.0, 100.0) / 100.0 * static_cast<double>(count - 1) + 0.5);
+    std::nth_element(sorted.begin(), sorted.begin() + rank, sorted.begin() + count);
+    return sorted[rank];
+}
+
+size_t LatencyWindow::size() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return count_;
+}
+
 // ============================================================================
 // RequestMetrics Implementation
 // ============================================================================
@@ -127,7 +217,22 @@ void RequestMetrics::record_response(const core::Response& response) {
 
 GatewayManager::GatewayManager()
     : health_monitor_(std::make_unique<ProviderHealthMonitor>()),
-      routing_logic_(std::make_unique<RoutingLogic>(health_monitor_.get())) {
+      routing_logic_(std::make_unique<RoutingLogic>(health_monitor_.get())),
+      response_cache_(std::make_shared<cache::ResponseCache>()) {
+
+    // Active health probes use each adapter's own cheap upstream call; the completion
+    // holds the adapter so removing the provider mid-probe cannot free it
+    health_monitor_->set_health_probe([this](const std::string& provider_name,
+                                             ProviderHealthMonitor::ProbeCallback on_complete) {
+        std::shared_ptr<core::Bridge> adapter = get_provider_adapter(provider_name);
+        if (!adapter) {
+            on_complete(std::nullopt);
+            return;
+        }
+        adapter->probe_health_async([adapter, on_complete = std::move(on_complete)](core::Response response) {
+            on_complete(std::move(response));
+        });
+    });
 
     // Initialize with default providers if any
     aimux::info("GatewayManager: Initializing unified gateway manager");
@@ -135,6 +240,7 @@ GatewayManager::GatewayManager()
 
 GatewayManager::~GatewayManager() {
     shutdown();
+    wait_for_provider_calls();
     aimux::info("GatewayManager: Shut down successfully");
 }
 
@@ -176,6 +282,9 @@ void GatewayManager::shutdown() {
     // Stop health monitoring
     stop_health_monitoring();
 
+    // Provider callbacks (including cancelled hedge attempts) may still be running
+    wait_for_provider_calls();
+
     // Clean up adapters
     std::unique_lock<std::shared_mutex> lock(adapters_mutex_);
     adapters_.clear();
@@ -210,6 +319,7 @@ void GatewayManager::add_provider(const std::string& provider_name, const nlohma
     }
 
     // Add to collections
+    admission_.configure(provider_name, provider_config.admission_limits());
     std::unique_lock<std::shared_mutex> lock(adapters_mutex_);
     adapters_[provider_name] = std::move(bridge);
     provider_configs_[provider_name] = std::move(provider_config);
@@ -237,6 +347,8 @@ void GatewayManager::remove_provider(const std::string& provider_name) {
 
     lock.unlock();
 
+    admission_.remove(provider_name);
+
     // Remove from health monitor
     health_monitor_->remove_provider(provider_name);
 
@@ -258,9 +370,12 @@ void GatewayManager::update_provider_config(const std::string& provider_name, co
 
     config_it->second = GatewayProviderConfig::from_json(config);
     config_it->second.name_ = provider_name;
+    AdmissionLimits limits = config_it->second.admission_limits();
 
     lock.unlock();
 
+    admission_.configure(provider_name, limits);
+
     // Update health monitor
     health_monitor_->add_provider(provider_name, config);
 
@@ -282,6 +397,11 @@ void GatewayManager::add_provider_adapter(std::unique_ptr<core::Bridge> bridge)
     adapters_[provider_name] = std::move(bridge);
     lock.unlock();
 
+    // Routing only considers providers the health monitor knows about
+    if (!health_monitor_->get_provider_health(provider_name)) {
+        health_monitor_->add_provider(provider_name, nlohmann::json::object());
+    }
+
     notify_provider_change(provider_name, true);
     aimux::info("GatewayManager: Added adapter for provider: " + provider_name);
 }
@@ -295,16 +415,16 @@ void GatewayManager::remove_provider_adapter(const std::string& provider_name) {
     aimux::info("GatewayManager: Removed adapter for provider: " + provider_name);
 }
 
-core::Bridge* GatewayManager::get_provider_adapter(const std::string& provider_name) {
+std::shared_ptr<core::Bridge> GatewayManager::get_provider_adapter(const std::string& provider_name) {
     std::shared_lock<std::shared_mutex> lock(adapters_mutex_);
     auto it = adapters_.find(provider_name);
-    return (it != adapters_.end()) ? it->second.get() : nullptr;
+    return (it != adapters_.end()) ? it->second : nullptr;
 }
 
-const core::Bridge* GatewayManager::get_provider_adapter(const std::string& provider_name) const {
+std::shared_ptr<const core::Bridge> GatewayManager::get_provider_adapter(const std::string& provider_name) const {
     std::shared_lock<std::shared_mutex> lock(adapters_mutex_);
     auto it = adapters_.find(provider_name);
-    return (it != adapters_.end()) ? it->second.get() : nullptr;
+    return (it != adapters_.end()) ? it->second : nullptr;
 }
 
 // ============================================================================
@@ -318,11 +438,16 @@ core::Response GatewayManager::route_request(const core::Request& request) {
                                   503);
     }
 
-    // Analyze request to determine routing strategy
-    RequestAnalysis analysis = routing_logic_->analyze_request(request);
+    // Serve repeated deterministic requests without an upstream round trip
+    std::shared_ptr<cache::ResponseCache> response_cache;
+    std::string cache_key;
+    if (auto cached = find_cached_response(request, response_cache, cache_key)) {
+        return std::move(*cached);
+    }
 
-    // Get routing decision
-    RoutingDecision decision = routing_logic_->route_request(request);
+    // Analyze once; the same analysis drives routing and metrics
+    RequestAnalysis analysis = routing_logic_->analyze_request(request);
+    RoutingDecision decision = routing_logic_->route_request(request, analysis);
 
     // Create metrics
     RequestMetrics metrics = RequestMetrics::create_metrics(
@@ -331,35 +456,36 @@ core::Response GatewayManager::route_request(const core::Request& request) {
     core::Response response;
 
     try {
-        // Route to selected provider
-        response = route_request_to_provider(request, decision.selected_provider_);
-
-        // Update metrics
-        metrics.record_response(response);
-
-        // Update provider metrics
-        update_provider_metrics(decision.selected_provider_, metrics);
+        if (hedging_enabled_.load() && !decision.alternative_providers_.empty()) {
+            response = route_request_hedged(request, decision, metrics);
+        } else {
+            // Route to selected provider
+            response = route_request_to_provider(request, decision.selected_provider_);
 
-        // Handle failure cases
-        if (!response.success) {
-            health_monitor_->update_provider_metrics(decision.selected_provider_,
-                                                    response, metrics.duration_ms_);
+            // Update metrics
+            metrics.record_response(response);
 
-            // Try failover providers if available
-            for (const auto& alt_provider : decision.alternative_providers_) {
-                if (provider_is_available(alt_provider)) {
-                    aimux::warn("Attempting failover from " + decision.selected_provider_ +
-                               " to " + alt_provider);
+            // Update provider metrics
+            update_provider_metrics(decision.selected_provider_, metrics);
 
-                    metrics.provider_name_ = alt_provider;
-                    metrics.routing_reasoning_ += " [FAILOVER]";
+            // Handle failure cases
+            if (!response.success) {
+                // Try failover providers if available
+                for (const auto& alt_provider : decision.alternative_providers_) {
+                    if (provider_is_available(alt_provider)) {
+                        aimux::warn("Attempting failover from " + decision.selected_provider_ +
+                                   " to " + alt_provider);
 
-                    response = route_request_to_provider(request, alt_provider);
-                    metrics.record_response(response);
+                        metrics.provider_name_ = alt_provider;
+                        metrics.routing_reasoning_ += " [FAILOVER]";
 
-                    if (response.success) {
+                        response = route_request_to_provider(request, alt_provider);
+                        metrics.record_response(response);
                         update_provider_metrics(alt_provider, metrics);
-                        break;
+
+                        if (response.success) {
+                            break;
+                        }
                     }
                 }
             }
@@ -371,6 +497,49 @@ core::Response GatewayManager::route_request(const core::Request& request) {
         metrics.record_response(response);
     }
 
+    finish_routing(request, response, metrics, response_cache, cache_key);
+    return response;
+}
+
+std::optional<core::Response> GatewayManager::find_cached_response(
+        const core::Request& request,
+        std::shared_ptr<cache::ResponseCache>& response_cache,
+        std::string& cache_key) {
+    if (!response_cache_enabled_.load() || !is_cacheable_request(request)) {
+        return std::nullopt;
+    }
+
+    auto started = std::chrono::steady_clock::now();
+    response_cache = response_cache_.load();
+    cache_key = response_cache->generateKey(request.model, request.data);
+    auto cached = response_cache->getPayload(cache_key, request.model);
+    if (!cached) {
+        return std::nullopt;
+    }
+
+    core::Response response;
+    response.success = true;
+    response.status_code = 200;
+    response.data = std::move(*cached);
+    response.provider_name = "response_cache";
+
+    // A hit is still gateway traffic; record it under its own provider label
+    RequestMetrics metrics = RequestMetrics::create_metrics(
+        response.provider_name, request, RequestType::STANDARD, "[CACHED] Served from response cache");
+    metrics.start_time_ = started;
+    metrics.record_response(response);
+    finish_routing(request, response, metrics, nullptr, cache_key);
+    return response;
+}
+
+void GatewayManager::finish_routing(const core::Request& request, const core::Response& response,
+                                    RequestMetrics& metrics,
+                                    const std::shared_ptr<cache::ResponseCache>& response_cache,
+                                    const std::string& cache_key) {
+    if (response_cache && response.success && response.status_code == 200) {
+        response_cache->putPayload(cache_key, response.data, request.model);
+    }
+
     // Record metrics
     record_routing_metrics(metrics);
 
@@ -379,15 +548,204 @@ core::Response GatewayManager::route_request(const core::Request& request) {
         route_callback_(metrics);
     }
 
-    log_debug("Request routed to " + metrics.provider_name_ +
-             " in " + std::to_string(metrics.duration_ms_) + "ms");
+    GATEWAY_LOG_DEBUG("Request routed to " + metrics.provider_name_ +
+                     " in " + std::to_string(metrics.duration_ms_) + "ms");
+}
 
-    return response;
+// One route_request_async() call; kept alive by whichever provider callback is pending
+struct GatewayManager::AsyncRoute {
+    core::Request request;
+    RouteCompletion on_complete;
+    Executor executor;
+    RequestMetrics metrics;
+    std::vector<std::string> candidates;    // Selected provider first, then failovers
+    size_t attempt = 0;
+    std::shared_ptr<cache::ResponseCache> response_cache;
+    std::string cache_key;
+};
+
+void GatewayManager::route_request_async(const core::Request& request, RouteCompletion on_complete,
+                                         Executor executor) {
+    if (!initialized_.load()) {
+        on_complete(create_error_response("NOT_INITIALIZED", "GatewayManager not initialized", 503));
+        return;
+    }
+
+    auto route = std::make_shared<AsyncRoute>();
+    route->on_complete = std::move(on_complete);
+    route->executor = std::move(executor);
+
+    RoutingDecision decision;
+    try {
+        if (auto cached = find_cached_response(request, route->response_cache, route->cache_key)) {
+            route->on_complete(std::move(*cached));
+            return;
+        }
+
+        RequestAnalysis analysis = routing_logic_->analyze_request(request);
+        decision = routing_logic_->route_request(request, analysis);
+        route->metrics = RequestMetrics::create_metrics(
+            decision.selected_provider_, request, analysis.type_, decision.reasoning_);
+    } catch (const std::exception& e) {
+        aimux::error("Exception during request routing: " + std::string(e.what()));
+        route->on_complete(create_error_response("ROUTING_EXCEPTION", e.what(), 500));
+        return;
+    }
+    route->request = request;
+
+    if (hedging_enabled_.load() && !decision.alternative_providers_.empty()) {
+        // The race runs on provider callbacks and engine timers; only settling it goes to the executor
+        start_hedged_race(route->request, decision, route->executor,
+            [this, route](std::shared_ptr<HedgeRace> race) {
+                begin_provider_call();
+                auto settle = [this, route, race]() {
+                    core::Response response;
+                    try {
+                        response = settle_hedged_race(*race, route->metrics);
+                    } catch (const std::exception& e) {
+                        aimux::error("Exception during request routing: " + std::string(e.what()));
+                        response = create_error_response("ROUTING_EXCEPTION", e.what(), 500);
+                        route->metrics.record_response(response);
+                    }
+                    complete_async_route(route, std::move(response));
+                    end_provider_call();
+                };
+                if (route->executor) {
+                    route->executor(std::move(settle));
+                } else {
+                    settle();
+                }
+            });
+        return;
+    }
+
+    route->candidates.push_back(decision.selected_provider_);
+    route->candidates.insert(route->candidates.end(), decision.alternative_providers_.begin(),
+                             decision.alternative_providers_.end());
+    start_async_attempt(route);
+}
+
+void GatewayManager::start_async_attempt(const std::shared_ptr<AsyncRoute>& route) {
+    route_to_provider_async(route->request, route->candidates[route->attempt],
+        [this, route](core::Response response) {
+            if (route->executor) {
+                route->executor([this, route, response = std::move(response)]() mutable {
+                    resume_async_route(route, std::move(response));
+                });
+            } else {
+                resume_async_route(route, std::move(response));
+            }
+        });
+}
+
+void GatewayManager::resume_async_route(const std::shared_ptr<AsyncRoute>& route, core::Response response) {
+    const std::string provider_name = route->candidates[route->attempt];
+
+    // Off the event loop now; same post-processing as route_request_to_provider()
+    if (prettifier_enabled_.load() && response.success) {
+        response = apply_prettifier(response, provider_name, route->request);
+    }
+
+    route->metrics.record_response(response);
+    update_provider_metrics(provider_name, route->metrics);
+
+    if (!response.success) {
+        while (++route->attempt < route->candidates.size()) {
+            const std::string& alt_provider = route->candidates[route->attempt];
+            if (provider_is_available(alt_provider)) {
+                aimux::warn("Attempting failover from " + provider_name + " to " + alt_provider);
+                route->metrics.provider_name_ = alt_provider;
+                route->metrics.routing_reasoning_ += " [FAILOVER]";
+                start_async_attempt(route);
+                return;
+            }
+        }
+    }
+
+    complete_async_route(route, std::move(response));
+}
+
+void GatewayManager::complete_async_route(const std::shared_ptr<AsyncRoute>& route, core::Response response) {
+    finish_routing(route->request, response, route->metrics, route->response_cache, route->cache_key);
+    route->on_complete(std::move(response));
+}
+
+void GatewayManager::route_to_provider_async(const core::Request& request, const std::string& provider_name,
+                                             RouteCompletion on_complete) {
+    std::shared_ptr<core::Bridge> adapter = get_provider_adapter(provider_name);
+    if (!adapter) {
+        on_complete(create_error_response("PROVIDER_NOT_FOUND", "Provider not found: " + provider_name, 404));
+        return;
+    }
+
+    if (!adapter->is_healthy()) {
+        on_complete(create_error_response("PROVIDER_UNHEALTHY", "Provider unhealthy: " + provider_name, 503));
+        return;
+    }
+
+    // Runs on the event loop or a pipeline worker, so the request waits for a slot in the
+    // provider's bounded queue without blocking; the extra call keeps shutdown waiting for it
+    begin_provider_call();
+    admission_.admit_async(provider_name,
+        [this, request, provider_name, adapter, on_complete](AdmissionTicket admission) {
+            if (admission.admitted()) {
+                send_admitted_request(request, provider_name, adapter, std::move(admission), on_complete);
+            } else {
+                try {
+                    on_complete(create_admission_rejection(provider_name, admission));
+                } catch (const std::exception& e) {
+                    aimux::error("Completion for " + provider_name + " request failed: " + e.what());
+                }
+            }
+            end_provider_call();
+        });
+}
+
+void GatewayManager::send_admitted_request(const core::Request& request, const std::string& provider_name,
+                                           std::shared_ptr<core::Bridge> adapter, AdmissionTicket admission,
+                                           RouteCompletion on_complete) {
+    // Slot, in-flight count and attempt count are held until the provider answers; the
+    // adapter until its callback is released, since remove_provider() does not wait
+    struct Attempt {
+        std::shared_ptr<core::Bridge> adapter;
+        AdmissionTicket admission;
+        InFlightRequest in_flight;
+        std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+        std::atomic<bool> completed{false};
+    };
+    auto attempt = std::make_shared<Attempt>(adapter, std::move(admission), health_monitor_->begin_request(provider_name));
+    begin_provider_call();
+
+    auto finish = [this, attempt, provider_name, on_complete](core::Response response) {
+        if (attempt->completed.exchange(true)) {
+            return;
+        }
+        if (response.success) {
+            record_provider_latency(provider_name, std::chrono::duration<double, std::milli>(
+                std::chrono::steady_clock::now() - attempt->start).count());
+        }
+        attempt->admission = AdmissionTicket();
+        attempt->in_flight = InFlightRequest();
+
+        try {
+            on_complete(std::move(response));
+        } catch (const std::exception& e) {
+            aimux::error("Completion for " + provider_name + " request failed: " + e.what());
+        }
+        end_provider_call();
+    };
+
+    try {
+        adapter->send_request_async(request, finish);
+    } catch (const std::exception& e) {
+        aimux::error("Provider " + provider_name + " request failed: " + e.what());
+        finish(create_error_response("PROVIDER_REQUEST_FAILED", e.what(), 502));
+    }
 }
 
 core::Response GatewayManager::route_request_to_provider(const core::Request& request,
                                                         const std::string& provider_name) {
-    core::Bridge* adapter = get_provider_adapter(provider_name);
+    std::shared_ptr<core::Bridge> adapter = get_provider_adapter(provider_name);
     if (!adapter) {
         return create_error_response("PROVIDER_NOT_FOUND",
                                   "Provider not found: " + provider_name,
@@ -400,9 +758,21 @@ core::Response GatewayManager::route_request_to_provider(const core::Request& re
                                   503);
     }
 
+    // Over the provider's limits: answer locally so the caller can reroute
+    AdmissionTicket admission = admission_.admit(provider_name);
+    if (!admission.admitted()) {
+        return create_admission_rejection(provider_name, admission);
+    }
+
+    InFlightRequest in_flight = health_monitor_->begin_request(provider_name);
     try {
         // Send request to provider
+        auto start = std::chrono::steady_clock::now();
         core::Response response = adapter->send_request(request);
+        if (response.success) {
+            record_provider_latency(provider_name, std::chrono::duration<double, std::milli>(
+                std::chrono::steady_clock::now() - start).count());
+        }
 
         // Apply prettifier postprocessing (v2.1)
         if (prettifier_enabled_.load() && response.success) {
@@ -416,6 +786,270 @@ core::Response GatewayManager::route_request_to_provider(const core::Request& re
     }
 }
 
+// One hedged route. Attempts report to it from their provider callbacks and
+// backups are started from engine timers, so no thread waits on the race.
+struct GatewayManager::HedgeRace {
+    core::Request request;
+    std::vector<std::string> candidates;    // Selected provider first, then available alternatives
+    int max_hedges = 0;
+    Executor executor;                      // Starts hedges and failovers off the event loop
+    std::function<void(std::shared_ptr<HedgeRace>)> on_decided;
+
+    std::mutex mutex;
+    std::vector<core::CancellationToken> tokens;
+    std::vector<std::optional<core::Response>> results;
+    std::vector<std::chrono::steady_clock::time_point> starts;
+    std::vector<double> durations_ms;
+    std::vector<bool> is_hedge;
+    std::vector<size_t> failed;
+    std::optional<size_t> winner;
+    size_t launched = 0;
+    size_t in_flight = 0;
+    int hedges = 0;
+    uint64_t timer_generation = 0;          // Bumped per launch; older hedge timers are stale
+    bool decided = false;
+};
+
+core::Response GatewayManager::route_request_hedged(const core::Request& request,
+                                                    const RoutingDecision& decision,
+                                                    RequestMetrics& metrics) {
+    // Hedges start from the event loop; run them on the shared pool unless we are holding one of its workers
+    Executor executor;
+    auto pool = core::ThreadPool::shared();
+    if (!pool->is_worker_thread()) {
+        executor = [pool](std::function<void()> task) {
+            if (!pool->post(task)) {
+                task();
+            }
+        };
+    }
+
+    auto decided = std::make_shared<std::promise<std::shared_ptr<HedgeRace>>>();
+    auto outcome = decided->get_future();
+    start_hedged_race(request, decision, std::move(executor),
+        [decided](std::shared_ptr<HedgeRace> race) { decided->set_value(std::move(race)); });
+
+    std::shared_ptr<HedgeRace> race = outcome.get();
+    return settle_hedged_race(*race, metrics);
+}
+
+void GatewayManager::start_hedged_race(const core::Request& request, const RoutingDecision& decision,
+                                       Executor executor,
+                                       std::function<void(std::shared_ptr<HedgeRace>)> on_decided) {
+    auto race = std::make_shared<HedgeRace>();
+    race->request = request;
+    race->candidates.push_back(decision.selected_provider_);
+    for (const auto& alt_provider : decision.alternative_providers_) {
+        if (provider_is_available(alt_provider)) {
+            race->candidates.push_back(alt_provider);
+        }
+    }
+    race->max_hedges = get_hedging_config().max_hedges_;
+    race->executor = std::move(executor);
+    race->on_decided = std::move(on_decided);
+
+    const size_t count = race->candidates.size();
+    race->results.resize(count);
+    race->starts.resize(count);
+    race->durations_ms.resize(count, 0.0);
+    race->is_hedge.resize(count, false);
+    for (size_t i = 0; i < count; ++i) {
+        race->tokens.push_back(core::CancellationToken::create());
+    }
+    race->launched = 1;
+    race->in_flight = 1;
+
+    // Held until the race is decided, so timers and callbacks never outlive the manager.
+    // The timer is armed first: a provider without an async transport blocks in its launch.
+    begin_provider_call();
+    arm_hedge_timer(race);
+    launch_hedge_attempt(race, 0);
+}
+
+void GatewayManager::launch_hedge_attempt(const std::shared_ptr<HedgeRace>& race, size_t index) {
+    std::string provider_name;
+    core::CancellationToken token;
+    {
+        std::lock_guard<std::mutex> lock(race->mutex);
+        race->starts[index] = std::chrono::steady_clock::now();
+        provider_name = race->candidates[index];
+        token = race->tokens[index];
+    }
+
+    // The provider picks the token up when it starts its transfer, so losers can be aborted
+    core::CancellationScope scope(token);
+    route_to_provider_async(race->request, provider_name, [this, race, index](core::Response response) {
+        on_hedge_result(race, index, std::move(response));
+    });
+}
+
+void GatewayManager::dispatch_hedge_attempt(const std::shared_ptr<HedgeRace>& race, size_t index) {
+    // The caller took a provider-call hold for this launch
+    auto launch = [this, race, index]() {
+        arm_hedge_timer(race);
+        launch_hedge_attempt(race, index);
+        end_provider_call();
+    };
+    if (race->executor) {
+        race->executor(std::move(launch));
+    } else {
+        launch();
+    }
+}
+
+void GatewayManager::arm_hedge_timer(const std::shared_ptr<HedgeRace>& race) {
+    uint64_t generation;
+    std::string provider_name;
+    {
+        std::lock_guard<std::mutex> lock(race->mutex);
+        if (race->decided || race->launched >= race->candidates.size() || race->hedges >= race->max_hedges) {
+            return;
+        }
+        generation = race->timer_generation;
+        provider_name = race->candidates[race->launched - 1];
+    }
+
+    network::CurlMultiEngine::instance().schedule(get_hedge_delay(provider_name),
+        [this, race, generation](bool fired) {
+            size_t index;
+            {
+                // Only an undecided race may touch the manager: its hold keeps the manager alive
+                std::lock_guard<std::mutex> lock(race->mutex);
+                if (!fired || race->decided || generation != race->timer_generation ||
+                    race->launched >= race->candidates.size() || race->hedges >= race->max_hedges) {
+                    return;
+                }
+                index = race->launched++;
+                race->in_flight++;
+                race->hedges++;
+                race->is_hedge[index] = true;
+                race->timer_generation++;
+                begin_provider_call();
+            }
+            hedges_launched_++;
+            GATEWAY_LOG_DEBUG("Hedging request to " + race->candidates[index] + " after " +
+                             race->candidates[index - 1] + " exceeded its latency threshold");
+            dispatch_hedge_attempt(race, index);
+        });
+}
+
+void GatewayManager::on_hedge_result(const std::shared_ptr<HedgeRace>& race, size_t index,
+                                     core::Response response) {
+    std::optional<size_t> failover;
+    bool decided_now = false;
+    {
+        std::lock_guard<std::mutex> lock(race->mutex);
+        race->durations_ms[index] = std::chrono::duration<double, std::milli>(
+            std::chrono::steady_clock::now() - race->starts[index]).count();
+        race->results[index] = std::move(response);
+        race->in_flight--;
+        if (race->decided) {
+            return;     // A cancelled loser unwinding; its result is ignored
+        }
+
+        if (race->results[index]->success) {
+            race->winner = index;
+            race->decided = decided_now = true;
+        } else {
+            race->failed.push_back(index);
+            if (race->in_flight == 0 && race->launched < race->candidates.size()) {
+                // Everything launched so far failed; fail over without waiting for a hedge deadline
+                failover = race->launched++;
+                race->in_flight++;
+                race->timer_generation++;
+                begin_provider_call();
+            } else if (race->in_flight == 0) {
+                race->decided = decided_now = true;
+            }
+        }
+    }
+
+    if (failover) {
+        aimux::warn("Attempting failover from " + race->candidates[index] +
+                   " to " + race->candidates[*failover]);
+        dispatch_hedge_attempt(race, *failover);
+    } else if (decided_now) {
+        decide_hedged_race(race);
+    }
+}
+
+void GatewayManager::decide_hedged_race(const std::shared_ptr<HedgeRace>& race) {
+    {
+        // The losers' HTTP transfers abort; their late results are ignored
+        std::lock_guard<std::mutex> lock(race->mutex);
+        for (size_t i = 0; i < race->launched; ++i) {
+            if (!race->winner || i != *race->winner) {
+                if (!race->results[i]) {
+                    cancelled_attempts_++;
+                }
+                race->tokens[i].cancel();
+            }
+        }
+        if (race->hedges > 0) {
+            hedged_requests_++;
+        }
+    }
+
+    try {
+        race->on_decided(race);
+    } catch (const std::exception& e) {
+        aimux::error("Hedged request completion failed: " + std::string(e.what()));
+    }
+    end_provider_call();
+}
+
+core::Response GatewayManager::settle_hedged_race(HedgeRace& race, RequestMetrics& metrics) {
+    std::unique_lock<std::mutex> lock(race.mutex);
+    const size_t chosen = race.winner ? *race.winner : race.failed.back();
+    const bool won = race.winner.has_value();
+    const bool hedged = race.is_hedge[chosen];
+    core::Response response = std::move(*race.results[chosen]);
+    std::vector<std::pair<size_t, core::Response>> failures;
+    for (size_t i : race.failed) {
+        failures.emplace_back(i, *race.results[i]);
+    }
+    std::vector<double> durations = race.durations_ms;
+    lock.unlock();
+
+    for (const auto& [index, failure] : failures) {
+        health_monitor_->update_provider_metrics(race.candidates[index], failure, durations[index]);
+    }
+
+    const std::string& provider_name = race.candidates[chosen];
+    if (prettifier_enabled_.load() && response.success) {
+        response = apply_prettifier(response, provider_name, race.request);
+    }
+
+    if (chosen != 0) {
+        metrics.provider_name_ = provider_name;
+        metrics.routing_reasoning_ += hedged ? " [HEDGED]" : " [FAILOVER]";
+        if (hedged && won) {
+            hedge_wins_++;
+        }
+    }
+    metrics.record_response(response);
+    update_provider_metrics(provider_name, metrics);
+
+    return response;
+}
+
+void GatewayManager::begin_provider_call() {
+    std::lock_guard<std::mutex> lock(calls_mutex_);
+    calls_in_flight_++;
+}
+
+void GatewayManager::end_provider_call() {
+    std::lock_guard<std::mutex> lock(calls_mutex_);
+    if (--calls_in_flight_ == 0) {
+        calls_done_.notify_all();
+    }
+}
+
+void GatewayManager::wait_for_provider_calls() {
+    std::unique_lock<std::mutex> lock(calls_mutex_);
+    calls_done_.wait(lock, [this]() { return calls_in_flight_ == 0; });
+}
+
 // ============================================================================
 // Configuration Management
 // ============================================================================
@@ -552,6 +1186,8 @@ nlohmann::json GatewayManager::get_configuration() const {
     config["tools_provider"] = tools_provider_;
     config["providers"] = get_provider_configs();
     config["routing"] = get_routing_config();
+    config["hedging"] = get_hedging_config().to_json();
+    config["outlier_detection"] = health_monitor_->get_outlier_detection_config().to_json();
     return config;
 }
 
@@ -561,6 +1197,27 @@ void GatewayManager::load_configuration(const nlohmann::json& config) {
     vision_provider_ = config.value("vision_provider", "");
     tools_provider_ = config.value("tools_provider", "");
 
+    if (config.contains("response_cache") && config["response_cache"].is_object()) {
+        const auto& cache_config = config["response_cache"];
+        cache::ResponseCache::Config settings;
+        settings.max_entries = cache_config.value("max_entries", settings.max_entries);
+        settings.max_memory_mb = cache_config.value("max_memory_mb", settings.max_memory_mb);
+        settings.shard_count = cache_config.value("shards", settings.shard_count);
+        settings.default_ttl = std::chrono::milliseconds(
+            cache_config.value("ttl_ms", static_cast<long long>(settings.default_ttl.count())));
+        configure_response_cache(settings);
+        enable_response_cache(cache_config.value("enabled", false));
+    }
+
+    if (config.contains("hedging") && config["hedging"].is_object()) {
+        configure_hedging(HedgingConfig::from_json(config["hedging"]));
+    }
+
+    if (config.contains("outlier_detection") && config["outlier_detection"].is_object()) {
+        health_monitor_->configure_outlier_detection(
+            OutlierDetectionConfig::from_json(config["outlier_detection"]));
+    }
+
     if (config.contains("providers") && config["providers"].is_object()) {
         for (const auto& [name, provider_config] : config["providers"].items()) {
             try {
@@ -602,44 +1259,173 @@ nlohmann::json GatewayManager::get_metrics() const {
     metrics["health_monitoring_active"] = health_monitoring_active_.load();
     metrics["metrics_collection_enabled"] = metrics_collection_enabled_.load();
 
-    // Request metrics summary
-    std::shared_lock<std::shared_mutex> metrics_lock(metrics_mutex_);
-    int total_requests = request_metrics_.size();
-    int successful_requests = 0;
-    double total_duration = 0.0;
-
-    for (const auto& metric : request_metrics_) {
-        if (metric.success_) {
-            successful_requests++;
-        }
-        total_duration += metric.duration_ms_;
-    }
+    // Request metrics summary (running aggregates, independent of history size)
+    uint64_t total_requests = metrics_store_.total_requests();
+    uint64_t successful_requests = metrics_store_.successful_requests();
 
     metrics["total_requests"] = total_requests;
     metrics["successful_requests"] = successful_requests;
     metrics["success_rate"] = total_requests > 0 ?
-        static_cast<double>(successful_requests) / total_requests : 0.0;
-    metrics["avg_response_time_ms"] = total_requests > 0 ?
-        total_duration / total_requests : 0.0;
+        static_cast<double>(successful_requests) / static_cast<double>(total_requests) : 0.0;
+    metrics["avg_response_time_ms"] = metrics_store_.latency().mean() / 1000.0;
+    metrics["latency_ms"] = metrics_store_.latency().to_json(1000.0);
+    metrics["provider_requests"] = metrics_store_.providers_to_json();
 
     // Provider health metrics
     metrics["provider_health"] = health_monitor_->get_all_provider_health();
 
+    metrics["response_cache"] = get_response_cache_metrics();
+    metrics["hedging"] = get_hedging_metrics();
+    metrics["admission"] = get_admission_metrics();
+
     return metrics;
 }
 
-std::vector<RequestMetrics> GatewayManager::get_recent_metrics(int count) const {
-    std::shared_lock<std::shared_mutex> lock(metrics_mutex_);
+void GatewayManager::enable_response_cache(bool enabled) {
+    response_cache_enabled_.store(enabled);
+    aimux::info("GatewayManager: Response cache " + std::string(enabled ? "enabled" : "disabled"));
+}
+
+void GatewayManager::configure_response_cache(const cache::ResponseCache::Config& config) {
+    response_cache_.store(std::make_shared<cache::ResponseCache>(config));
+}
+
+nlohmann::json GatewayManager::get_response_cache_metrics() const {
+    auto response_cache = response_cache_.load();
+    cache::ResponseCache::Stats stats = response_cache->getStats();
+
+    nlohmann::json metrics;
+    metrics["enabled"] = response_cache_enabled_.load();
+    metrics["hits"] = stats.hits;
+    metrics["misses"] = stats.misses;
+    metrics["evictions"] = stats.evictions;
+    metrics["entries"] = stats.entries;
+    metrics["memory_usage_bytes"] = stats.memory_usage_bytes;
+    metrics["hit_rate"] = stats.hit_rate;
+    metrics["routes"] = response_cache->getRouteStats();
+    return metrics;
+}
+
+void GatewayManager::configure_hedging(const HedgingConfig& config) {
+    {
+        std::lock_guard<std::mutex> lock(hedging_mutex_);
+        hedging_config_ = config;
+    }
+    hedging_enabled_.store(config.enabled_);
+    aimux::info("GatewayManager: Hedged requests " + std::string(config.enabled_ ? "enabled" : "disabled"));
+}
+
+HedgingConfig GatewayManager::get_hedging_config() const {
+    std::lock_guard<std::mutex> lock(hedging_mutex_);
+    return hedging_config_;
+}
+
+std::chrono::milliseconds GatewayManager::get_hedge_delay(const std::string& provider_name) const {
+    HedgingConfig config = get_hedging_config();
+
+    std::optional<double> threshold;
+    {
+        std::shared_lock<std::shared_mutex> lock(latency_mutex_);
+        auto it = latency_windows_.find(provider_name);
+        if (it != latency_windows_.end()) {
+            threshold = it->second->percentile(config.latency_percentile_, config.min_samples_);
+        }
+    }
+    if (!threshold) {
+        return config.default_delay_;
+    }
+
+    auto delay = std::chrono::milliseconds(static_cast<int64_t>(std::ceil(*threshold)));
+    return std::max(config.min_delay_, std::min(delay, config.max_delay_));
+}
+
+void GatewayManager::record_provider_latency(const std::string& provider_name, double latency_ms) {
+    {
+        std::shared_lock<std::shared_mutex> lock(latency_mutex_);
+        auto it = latency_windows_.find(provider_name);
+        if (it != latency_windows_.end()) {
+            it->second->record(latency_ms);
+            return;
+        }
+    }
+    std::unique_lock<std::shared_mutex> lock(latency_mutex_);
+    auto& window = latency_windows_[provider_name];
+    if (!window) {
+        window = std::make_unique<LatencyWindow>();
+    }
+    window->record(latency_ms);
+}
+
+nlohmann::json GatewayManager::get_hedging_metrics() const {
+    nlohmann::json metrics = get_hedging_config().to_json();
+    metrics["hedged_requests"] = hedged_requests_.load();
+    metrics["hedges_launched"] = hedges_launched_.load();
+    metrics["hedge_wins"] = hedge_wins_.load();
+    metrics["cancelled_attempts"] = cancelled_attempts_.load();
+
+    nlohmann::json delays = nlohmann::json::object();
+    std::vector<std::string> providers;
+    {
+        std::shared_lock<std::shared_mutex> lock(latency_mutex_);
+        for (const auto& [name, window] : latency_windows_) {
+            providers.push_back(name);
+        }
+    }
+    for (const auto& name : providers) {
+        delays[name] = get_hedge_delay(name).count();
+    }
+    metrics["hedge_delay_ms"] = delays;
+    return metrics;
+}
+
+nlohmann::json GatewayManager::get_admission_metrics() const {
+    return admission_.to_json();
+}
 
-    if (count <= 0 || request_metrics_.empty()) {
+bool GatewayManager::is_cacheable_request(const core::Request& request) const {
+    const auto& data = request.data;
+    if (!data.is_object() || data.value("stream", false)) {
+        return false;
+    }
+
+    // Explicit opt-in/opt-out wins over the temperature heuristic
+    auto opt = data.find("aimux_cache");
+    if (opt != data.end() && opt->is_boolean()) {
+        return opt->get<bool>();
+    }
+
+    auto temperature = data.find("temperature");
+    return temperature != data.end() && temperature->is_number() &&
+           temperature->get<double>() == 0.0;
+}
+
+std::vector<RequestMetrics> GatewayManager::get_recent_metrics(int count) const {
+    if (count <= 0) {
         return {};
     }
 
-    int start_idx = std::max(0, static_cast<int>(request_metrics_.size()) - count);
     std::vector<RequestMetrics> recent;
-
-    for (auto it = request_metrics_.begin() + start_idx; it != request_metrics_.end(); ++it) {
-        recent.push_back(*it);
+    for (const MetricRecord& record : metrics_store_.recent(static_cast<size_t>(count))) {
+        RequestMetrics metrics;
+        metrics.provider_name_ = metrics_store_.provider_name(record.provider_id);
+        metrics.start_time_ = std::chrono::steady_clock::time_point(
+            std::chrono::duration_cast<std::chrono::steady_clock::duration>(std::chrono::nanoseconds(record.start_ns)));
+        metrics.end_time_ = std::chrono::steady_clock::time_point(
+            std::chrono::duration_cast<std::chrono::steady_clock::duration>(std::chrono::nanoseconds(record.end_ns)));
+        metrics.duration_ms_ = record.duration_us / 1000.0;
+        metrics.success_ = record.flags & MetricRecord::SUCCESS;
+        metrics.http_status_code_ = record.http_status;
+        metrics.request_tokens_ = record.request_tokens;
+        metrics.response_tokens_ = record.response_tokens;
+        metrics.cost_usd_ = record.cost_usd;
+        metrics.request_type_ = static_cast<RequestType>(record.request_type);
+        if (record.flags & MetricRecord::FAILOVER) {
+            metrics.routing_reasoning_ += "[FAILOVER]";
+        }
+        if (record.flags & MetricRecord::HEDGED) {
+            metrics.routing_reasoning_ += metrics.routing_reasoning_.empty() ? "[HEDGED]" : " [HEDGED]";
+        }
+        recent.push_back(std::move(metrics));
     }
 
     return recent;
@@ -651,8 +1437,7 @@ void GatewayManager::enable_metrics_collection(bool enabled) {
 }
 
 void GatewayManager::clear_metrics() {
-    std::unique_lock<std::shared_mutex> lock(metrics_mutex_);
-    request_metrics_.clear();
+    metrics_store_.clear();
     aimux::info("GatewayManager: Cleared all metrics");
 }
 
@@ -731,6 +1516,7 @@ void GatewayManager::manually_mark_provider_healthy(const std::string& provider_
     ProviderHealth* health = health_monitor_->get_provider_health(provider_name);
     if (health) {
         health->mark_success();
+        health_monitor_->publish_scores();
         aimux::info("GatewayManager: Manually marked provider healthy: " + provider_name);
     }
 }
@@ -739,6 +1525,7 @@ void GatewayManager::manually_mark_provider_unhealthy(const std::string& provide
     ProviderHealth* health = health_monitor_->get_provider_health(provider_name);
     if (health) {
         health->mark_failure();
+        health_monitor_->publish_scores();
         aimux::info("GatewayManager: Manually marked provider unhealthy: " + provider_name);
     }
 }
@@ -767,7 +1554,7 @@ bool GatewayManager::validate_provider_config(const nlohmann::json& config) cons
 }
 
 bool GatewayManager::test_provider_connectivity(const std::string& provider_name) const {
-    const core::Bridge* adapter = get_provider_adapter(provider_name);
+    std::shared_ptr<const core::Bridge> adapter = get_provider_adapter(provider_name);
     if (!adapter) {
         return false;
     }
@@ -821,7 +1608,7 @@ nlohmann::json GatewayManager::debug_routing_decision(const core::Request& reque
     debug_info["provider_capabilities"] = capabilities;
 
     // Routing decision
-    RoutingDecision decision = routing_logic_->route_request(request);
+    RoutingDecision decision = routing_logic_->route_request(request, analysis);
     debug_info["routing_decision"] = decision.to_json();
 
     return debug_info;
@@ -859,13 +1646,29 @@ void GatewayManager::record_routing_metrics(const RequestMetrics& metrics) {
         return;
     }
 
-    std::unique_lock<std::shared_mutex> lock(metrics_mutex_);
-    request_metrics_.push_back(metrics);
-
-    // Maintain history limit
-    while (request_metrics_.size() > MAX_METRICS_HISTORY) {
-        request_metrics_.pop_front();
+    MetricRecord record;
+    record.start_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
+        metrics.start_time_.time_since_epoch()).count();
+    record.end_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
+        metrics.end_time_.time_since_epoch()).count();
+    record.duration_us = static_cast<uint32_t>(std::clamp(metrics.duration_ms_ * 1000.0, 0.0, 4.0e9));
+    record.request_tokens = metrics.request_tokens_;
+    record.response_tokens = metrics.response_tokens_;
+    record.cost_usd = static_cast<float>(metrics.cost_usd_);
+    record.http_status = static_cast<int16_t>(metrics.http_status_code_);
+    record.provider_id = metrics_store_.intern(metrics.provider_name_);
+    record.request_type = static_cast<uint8_t>(metrics.request_type_);
+    if (metrics.success_) {
+        record.flags |= MetricRecord::SUCCESS;
+    }
+    if (metrics.routing_reasoning_.find("[FAILOVER]") != std::string::npos) {
+        record.flags |= MetricRecord::FAILOVER;
     }
+    if (metrics.routing_reasoning_.find("[HEDGED]") != std::string::npos) {
+        record.flags |= MetricRecord::HEDGED;
+    }
+
+    metrics_store_.record(record);
 }
 
 std::string GatewayManager::select_failover_provider(const std::string& failed_provider,
@@ -1057,10 +1860,10 @@ core::Response GatewayManager::apply_prettifier(const core::Response& response,
         if (result.success) {
             // Create modified response with prettified content
             core::Response prettified_response = response;
-            prettified_response.data = result.processed_content;
+            prettified_response.set_data(result.processed_content);
 
-            log_debug("Prettifier processed response from " + provider_name +
-                     " in " + std::to_string(duration_ms) + "ms");
+            GATEWAY_LOG_DEBUG("Prettifier processed response from " + provider_name +
+                             " in " + std::to_string(duration_ms) + "ms");
 
             return prettified_response;
         } else {
@@ -1099,6 +1902,30 @@ core::Response GatewayManager::create_error_response(const std::string& error_co
     return response;
 }
 
+core::Response GatewayManager::create_admission_rejection(const std::string& provider_name,
+                                                         const AdmissionTicket& ticket) const {
+    bool rate_limited = ticket.result() == AdmissionResult::RATE_LIMITED;
+    std::string message = rate_limited ?
+        "Rate limit reached for provider " + provider_name :
+        "Provider " + provider_name + " is at its concurrency limit";
+
+    std::string error_code = rate_limited ? "RATE_LIMITED" : "PROVIDER_SATURATED";
+
+    core::Response response;
+    response.success = false;
+    response.status_code = 429;
+    response.error_message = error_code + ": " + message;
+    response.provider_name = provider_name;
+
+    nlohmann::json error_json;
+    error_json["error"]["code"] = error_code;
+    error_json["error"]["message"] = message;
+    error_json["error"]["type"] = "rate_limit_error";
+    error_json["error"]["retry_after_ms"] = ticket.retry_after().count();
+    response.data = error_json.dump();
+    return response;
+}
+
 void GatewayManager::log_error(const std::string& error_type, const std::string& message) const {
     aimux::error("GatewayManager [" + error_type + "]: " + message);
 }
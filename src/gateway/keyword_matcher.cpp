@@ -0,0 +1,255 @@
+#include "aimux/gateway/keyword_matcher.hpp"
+#include <array>
+#include <climits>
+#include <deque>
+
+namespace aimux {
+namespace gateway {
+
+namespace {
+
+constexpr size_t HISTORY_MASK = KeywordMatcher::MAX_BOUNDED_PATTERN_LENGTH;
+constexpr int32_t OUTPUT_FLAG = INT32_MIN;
+
+// ASCII case folding with every whitespace byte mapped to ' '
+constexpr std::array<unsigned char, 256> FOLD = []() {
+    std::array<unsigned char, 256> table{};
+    for (size_t i = 0; i < table.size(); ++i) {
+        unsigned char c = static_cast<unsigned char>(i);
+        if (c >= 'A' && c <= 'Z') {
+            c = static_cast<unsigned char>(c - 'A' + 'a');
+        } else if (c == '\t' || c == '\n' || c == '\v' || c == '\f' || c == '\r') {
+            c = ' ';
+        }
+        table[i] = c;
+    }
+    return table;
+}();
+
+// Word characters in the sense of regex \b
+constexpr std::array<bool, 256> WORD = []() {
+    std::array<bool, 256> table{};
+    for (size_t i = 0; i < table.size(); ++i) {
+        table[i] = (i >= 'a' && i <= 'z') || (i >= 'A' && i <= 'Z') ||
+                   (i >= '0' && i <= '9') || i == '_';
+    }
+    return table;
+}();
+
+std::string normalize(std::string_view text) {
+    std::string out;
+    out.reserve(text.size());
+    bool last_space = true;
+    for (unsigned char raw : text) {
+        unsigned char c = FOLD[raw];
+        if (c == ' ') {
+            if (last_space) {
+                continue;
+            }
+            last_space = true;
+        } else {
+            last_space = false;
+        }
+        out.push_back(static_cast<char>(c));
+    }
+    return out;
+}
+
+} // namespace
+
+// ============================================================================
+// Automaton construction
+// ============================================================================
+
+KeywordMatcher::KeywordMatcher(const std::vector<Pattern>& patterns) {
+    build(patterns);
+}
+
+void KeywordMatcher::build(const std::vector<Pattern>& patterns) {
+    struct Prepared {
+        std::string text;
+        uint32_t category;
+        bool whole_word;
+    };
+
+    std::vector<Prepared> prepared;
+    prepared.reserve(patterns.size());
+    for (const auto& pattern : patterns) {
+        std::string text = normalize(pattern.text);
+        if (text.empty() || pattern.category == 0) {
+            continue;
+        }
+        bool whole_word = pattern.whole_word && text.size() <= MAX_BOUNDED_PATTERN_LENGTH;
+        for (unsigned char c : text) {
+            if (class_of_[c] == 0) {
+                class_of_[c] = static_cast<unsigned char>(class_count_++);
+            }
+        }
+        prepared.push_back({std::move(text), pattern.category, whole_word});
+    }
+
+    // Trie
+    std::vector<std::vector<Output>> bounded(1);
+    nodes_.assign(1, Node{});
+    transitions_.assign(class_count_, -1);
+
+    for (const auto& pattern : prepared) {
+        int32_t node = 0;
+        for (unsigned char c : pattern.text) {
+            size_t slot = static_cast<size_t>(node) * class_count_ + class_of_[c];
+            if (transitions_[slot] < 0) {
+                transitions_[slot] = static_cast<int32_t>(nodes_.size());
+                nodes_.emplace_back();
+                bounded.emplace_back();
+                transitions_.resize(nodes_.size() * class_count_, -1);
+            }
+            node = transitions_[slot];
+        }
+        if (pattern.whole_word) {
+            bounded[node].push_back({pattern.category, static_cast<uint16_t>(pattern.text.size())});
+        } else {
+            nodes_[node].plain_mask |= pattern.category;
+        }
+    }
+
+    // Failure links, resolved into a complete transition table in BFS order
+    std::vector<int32_t> fail(nodes_.size(), 0);
+    std::deque<int32_t> queue;
+    for (size_t c = 0; c < class_count_; ++c) {
+        int32_t& next = transitions_[c];
+        if (next < 0) {
+            next = 0;
+        } else {
+            queue.push_back(next);
+        }
+    }
+
+    while (!queue.empty()) {
+        int32_t node = queue.front();
+        queue.pop_front();
+
+        int32_t link = fail[node];
+        nodes_[node].plain_mask |= nodes_[link].plain_mask;
+        bounded[node].insert(bounded[node].end(), bounded[link].begin(), bounded[link].end());
+
+        for (size_t c = 0; c < class_count_; ++c) {
+            int32_t& next = transitions_[static_cast<size_t>(node) * class_count_ + c];
+            int32_t fallback = transitions_[static_cast<size_t>(link) * class_count_ + c];
+            if (next < 0) {
+                next = fallback;
+            } else {
+                fail[next] = fallback;
+                queue.push_back(next);
+            }
+        }
+    }
+
+    for (size_t node = 0; node < nodes_.size(); ++node) {
+        nodes_[node].bounded_begin = static_cast<uint32_t>(bounded_outputs_.size());
+        bounded_outputs_.insert(bounded_outputs_.end(), bounded[node].begin(), bounded[node].end());
+        nodes_[node].bounded_end = static_cast<uint32_t>(bounded_outputs_.size());
+    }
+
+    // Store row offsets instead of node ids and flag rows that emit output, so
+    // the scan loop is a single dependent load per byte
+    for (int32_t& next : transitions_) {
+        const Node& target = nodes_[next];
+        bool emits = target.plain_mask != 0 || target.bounded_begin != target.bounded_end;
+        next = static_cast<int32_t>(static_cast<size_t>(next) * class_count_) | (emits ? OUTPUT_FLAG : 0);
+    }
+}
+
+uint32_t KeywordMatcher::scan(std::string_view text) const {
+    Scanner scanner(*this);
+    scanner.feed(text);
+    return scanner.finish();
+}
+
+// ============================================================================
+// Scanner
+// ============================================================================
+
+KeywordMatcher::Scanner::Scanner(const KeywordMatcher& matcher) : matcher_(&matcher) {}
+
+void KeywordMatcher::Scanner::feed(std::string_view text) {
+    // Hot loop works on locals: history_ stores are char-typed and would
+    // otherwise force every member and table pointer to be reloaded per byte
+    const KeywordMatcher& m = *matcher_;
+    const int32_t* transitions = m.transitions_.data();
+    const Node* nodes = m.nodes_.data();
+    const unsigned char* class_of = m.class_of_;
+    const size_t classes = m.class_count_;
+
+    int32_t state = state_;
+    uint32_t found = found_;
+    bool last_space = last_space_;
+    uint64_t position = position_;
+
+    for (unsigned char raw : text) {
+        unsigned char c = FOLD[raw];
+        if (c == ' ') {
+            if (last_space) {
+                continue;
+            }
+            last_space = true;
+        } else {
+            last_space = false;
+        }
+
+        if (pending_ != 0) {
+            if (!WORD[c]) {
+                found |= pending_;
+            }
+            pending_ = 0;
+        }
+
+        history_[position & HISTORY_MASK] = c;
+        int32_t next = transitions[static_cast<size_t>(state) + class_of[c]];
+        state = next & ~OUTPUT_FLAG;
+
+        if (next < 0) {
+            const Node& node = nodes[static_cast<size_t>(state) / classes];
+            found |= node.plain_mask;
+            if (node.bounded_begin != node.bounded_end) {
+                found_ = found;
+                position_ = position;
+                check_bounded(node);
+            }
+        }
+        ++position;
+    }
+
+    state_ = state;
+    found_ = found;
+    last_space_ = last_space;
+    position_ = position;
+}
+
+void KeywordMatcher::Scanner::feed_separator() {
+    feed(" ");
+}
+
+uint32_t KeywordMatcher::Scanner::finish() {
+    found_ |= pending_;
+    pending_ = 0;
+    return found_;
+}
+
+void KeywordMatcher::Scanner::check_bounded(const Node& node) {
+    for (uint32_t i = node.bounded_begin; i < node.bounded_end; ++i) {
+        const Output& output = matcher_->bounded_outputs_[i];
+        if ((found_ | pending_) & output.category) {
+            continue;
+        }
+        // Leading boundary: the character before the match must not be a word character
+        uint64_t start = position_ + 1 - output.length;
+        if (start > 0 && WORD[history_[(start - 1) & HISTORY_MASK]]) {
+            continue;
+        }
+        // Trailing boundary is decided by the next character (or end of input)
+        pending_ |= output.category;
+    }
+}
+
+} // namespace gateway
+} // namespace aimux
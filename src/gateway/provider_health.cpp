@@ -4,10 +4,32 @@
 #include <cmath>
 #include <sstream>
 #include <random>
+#include <tuple>
 
 namespace aimux {
 namespace gateway {
 
+namespace {
+    int64_t steady_now_ns() {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count();
+    }
+
+    // Errors that say the provider itself is in trouble; 4xx (including 429) do not
+    bool is_upstream_failure(const core::Response& response) {
+        return !response.success &&
+               (response.status_code == 0 || response.status_code == 408 || response.status_code >= 500);
+    }
+
+    void apply_outlier_config(ProviderHealth& health, const OutlierDetectionConfig& config) {
+        health.max_consecutive_failures_.store(config.consecutive_errors_);
+        health.base_ejection_time_ = config.base_ejection_time_;
+        health.failure_timeout_ = std::chrono::ceil<std::chrono::seconds>(config.max_ejection_time_);
+        health.required_probes_.store(config.recovery_probes_);
+        health.required_recovery_successes_.store(config.recovery_successes_);
+    }
+}
+
 // PerformanceMetrics implementation
 void PerformanceMetrics::update_response_time(double response_time_ms) {
     // Exponential moving average with alpha = 0.1
@@ -83,6 +105,44 @@ PerformanceMetrics PerformanceMetrics::from_json(const nlohmann::json& j) {
     return metrics;
 }
 
+// OutlierDetectionConfig implementation
+nlohmann::json OutlierDetectionConfig::to_json() const {
+    return nlohmann::json{
+        {"consecutive_errors", consecutive_errors_},
+        {"latency_z_threshold", latency_z_threshold_},
+        {"latency_stddev_floor_ratio", latency_stddev_floor_ratio_},
+        {"min_latency_samples", min_latency_samples_},
+        {"min_latency_peers", min_latency_peers_},
+        {"base_ejection_time_ms", base_ejection_time_.count()},
+        {"max_ejection_time_ms", max_ejection_time_.count()},
+        {"max_ejection_percent", max_ejection_percent_},
+        {"recovery_probes", recovery_probes_},
+        {"recovery_successes", recovery_successes_},
+        {"sweep_interval_ms", sweep_interval_.count()},
+        {"probe_jitter", probe_jitter_}
+    };
+}
+
+OutlierDetectionConfig OutlierDetectionConfig::from_json(const nlohmann::json& j) {
+    OutlierDetectionConfig config;
+    config.consecutive_errors_ = std::max(1, j.value("consecutive_errors", config.consecutive_errors_));
+    config.latency_z_threshold_ = j.value("latency_z_threshold", config.latency_z_threshold_);
+    config.latency_stddev_floor_ratio_ = j.value("latency_stddev_floor_ratio", config.latency_stddev_floor_ratio_);
+    config.min_latency_samples_ = j.value("min_latency_samples", config.min_latency_samples_);
+    config.min_latency_peers_ = std::max<size_t>(1, j.value("min_latency_peers", config.min_latency_peers_));
+    config.base_ejection_time_ = std::chrono::milliseconds(
+        j.value("base_ejection_time_ms", config.base_ejection_time_.count()));
+    config.max_ejection_time_ = std::chrono::milliseconds(
+        j.value("max_ejection_time_ms", config.max_ejection_time_.count()));
+    config.max_ejection_percent_ = j.value("max_ejection_percent", config.max_ejection_percent_);
+    config.recovery_probes_ = std::max(1, j.value("recovery_probes", config.recovery_probes_));
+    config.recovery_successes_ = std::max(1, j.value("recovery_successes", config.recovery_successes_));
+    config.sweep_interval_ = std::max(std::chrono::milliseconds(100), std::chrono::milliseconds(
+        j.value("sweep_interval_ms", config.sweep_interval_.count())));
+    config.probe_jitter_ = std::clamp(j.value("probe_jitter", config.probe_jitter_), 0.0, 0.9);
+    return config;
+}
+
 // ProviderHealth implementation
 ProviderHealth::ProviderHealth(const std::string& name) : provider_name_(name) {
     last_health_check_ = std::chrono::steady_clock::now();
@@ -94,7 +154,8 @@ ProviderHealth::ProviderHealth(const ProviderHealth& other)
     : provider_name_(other.provider_name_),
       status_(other.status_.load()),
       capability_flags_(other.capability_flags_.load()),
-      metrics_(other.metrics_),
+      metrics_(other.metrics_snapshot()),
+      in_flight_(std::make_shared<std::atomic<int64_t>>(other.in_flight_->load())),
       consecutive_failures_(other.consecutive_failures_.load()),
       max_consecutive_failures_(other.max_consecutive_failures_.load()),
       failure_timeout_(other.failure_timeout_),
@@ -105,7 +166,15 @@ ProviderHealth::ProviderHealth(const ProviderHealth& other)
       health_check_in_progress_(other.health_check_in_progress_.load()),
       successful_probes_(other.successful_probes_.load()),
       required_probes_(other.required_probes_.load()),
-      probe_interval_(other.probe_interval_) {
+      probe_interval_(other.probe_interval_),
+      ejection_count_(other.ejection_count_.load()),
+      ejected_until_ns_(other.ejected_until_ns_.load()),
+      recovering_(other.recovering_.load()),
+      recovery_successes_(other.recovery_successes_.load()),
+      required_recovery_successes_(other.required_recovery_successes_.load()),
+      base_ejection_time_(other.base_ejection_time_),
+      latency_ema_ms_(other.latency_ema_ms_.load()),
+      latency_samples_(other.latency_samples_.load()) {
 }
 
 // Copy assignment operator
@@ -114,7 +183,12 @@ ProviderHealth& ProviderHealth::operator=(const ProviderHealth& other) {
         provider_name_ = other.provider_name_;
         status_.store(other.status_.load());
         capability_flags_.store(other.capability_flags_.load());
-        metrics_ = other.metrics_;
+        PerformanceMetrics metrics = other.metrics_snapshot();
+        {
+            std::lock_guard<std::mutex> lock(metrics_mutex_);
+            metrics_ = metrics;
+        }
+        in_flight_->store(other.in_flight_->load());
         consecutive_failures_.store(other.consecutive_failures_.load());
         max_consecutive_failures_.store(other.max_consecutive_failures_.load());
         failure_timeout_ = other.failure_timeout_;
@@ -126,6 +200,14 @@ ProviderHealth& ProviderHealth::operator=(const ProviderHealth& other) {
         successful_probes_.store(other.successful_probes_.load());
         required_probes_.store(other.required_probes_.load());
         probe_interval_ = other.probe_interval_;
+        ejection_count_.store(other.ejection_count_.load());
+        ejected_until_ns_.store(other.ejected_until_ns_.load());
+        recovering_.store(other.recovering_.load());
+        recovery_successes_.store(other.recovery_successes_.load());
+        required_recovery_successes_.store(other.required_recovery_successes_.load());
+        base_ejection_time_ = other.base_ejection_time_;
+        latency_ema_ms_.store(other.latency_ema_ms_.load());
+        latency_samples_.store(other.latency_samples_.load());
     }
     return *this;
 }
@@ -135,7 +217,8 @@ ProviderHealth::ProviderHealth(ProviderHealth&& other) noexcept
     : provider_name_(std::move(other.provider_name_)),
       status_(other.status_.load()),
       capability_flags_(other.capability_flags_.load()),
-      metrics_(std::move(other.metrics_)),
+      metrics_(other.metrics_snapshot()),
+      in_flight_(other.in_flight_),
       consecutive_failures_(other.consecutive_failures_.load()),
       max_consecutive_failures_(other.max_consecutive_failures_.load()),
       failure_timeout_(other.failure_timeout_),
@@ -146,7 +229,15 @@ ProviderHealth::ProviderHealth(ProviderHealth&& other) noexcept
       health_check_in_progress_(other.health_check_in_progress_.load()),
       successful_probes_(other.successful_probes_.load()),
       required_probes_(other.required_probes_.load()),
-      probe_interval_(other.probe_interval_) {
+      probe_interval_(other.probe_interval_),
+      ejection_count_(other.ejection_count_.load()),
+      ejected_until_ns_(other.ejected_until_ns_.load()),
+      recovering_(other.recovering_.load()),
+      recovery_successes_(other.recovery_successes_.load()),
+      required_recovery_successes_(other.required_recovery_successes_.load()),
+      base_ejection_time_(other.base_ejection_time_),
+      latency_ema_ms_(other.latency_ema_ms_.load()),
+      latency_samples_(other.latency_samples_.load()) {
 }
 
 // Move assignment operator
@@ -155,7 +246,12 @@ ProviderHealth& ProviderHealth::operator=(ProviderHealth&& other) noexcept {
         provider_name_ = std::move(other.provider_name_);
         status_.store(other.status_.load());
         capability_flags_.store(other.capability_flags_.load());
-        metrics_ = std::move(other.metrics_);
+        PerformanceMetrics metrics = other.metrics_snapshot();
+        {
+            std::lock_guard<std::mutex> lock(metrics_mutex_);
+            metrics_ = metrics;
+        }
+        in_flight_ = other.in_flight_;
         consecutive_failures_.store(other.consecutive_failures_.load());
         max_consecutive_failures_.store(other.max_consecutive_failures_.load());
         failure_timeout_ = other.failure_timeout_;
@@ -167,6 +263,14 @@ ProviderHealth& ProviderHealth::operator=(ProviderHealth&& other) noexcept {
         successful_probes_.store(other.successful_probes_.load());
         required_probes_.store(other.required_probes_.load());
         probe_interval_ = other.probe_interval_;
+        ejection_count_.store(other.ejection_count_.load());
+        ejected_until_ns_.store(other.ejected_until_ns_.load());
+        recovering_.store(other.recovering_.load());
+        recovery_successes_.store(other.recovery_successes_.load());
+        required_recovery_successes_.store(other.required_recovery_successes_.load());
+        base_ejection_time_ = other.base_ejection_time_;
+        latency_ema_ms_.store(other.latency_ema_ms_.load());
+        latency_samples_.store(other.latency_samples_.load());
     }
     return *this;
 }
@@ -174,49 +278,83 @@ ProviderHealth& ProviderHealth::operator=(ProviderHealth&& other) noexcept {
 void ProviderHealth::mark_success() {
     consecutive_failures_.store(0);
 
-    if (status_.load() == HealthStatus::CIRCUIT_OPEN) {
+    HealthStatus current = status_.load();
+    if (current == HealthStatus::CIRCUIT_OPEN) {
         // In circuit open state, count successful probes for recovery
-        successful_probes_.fetch_add(1);
-        if (successful_probes_.load() >= required_probes_.load()) {
+        if (successful_probes_.fetch_add(1) + 1 >= required_probes_.load()) {
             close_circuit();
         }
-    } else if (status_.load() == HealthStatus::UNHEALTHY) {
+    } else if (recovering_.load()) {
+        // Back from an ejection: HEALTHY only after a run of successes
+        if (recovery_successes_.fetch_add(1) + 1 >= required_recovery_successes_.load()) {
+            recovering_.store(false);
+            status_.store(HealthStatus::HEALTHY);
+        }
+    } else if (current == HealthStatus::UNHEALTHY || current == HealthStatus::DEGRADED) {
         status_.store(HealthStatus::HEALTHY);
     }
 
+    std::lock_guard<std::mutex> lock(metrics_mutex_);
     metrics_.update_success(true);
+    metrics_.calculate_scores();
 }
 
-void ProviderHealth::mark_failure() {
+void ProviderHealth::mark_failure(bool allow_ejection) {
     int failures = consecutive_failures_.fetch_add(1) + 1;
     last_error_time_ = std::chrono::steady_clock::now();
 
-    metrics_.update_error();
+    {
+        std::lock_guard<std::mutex> lock(metrics_mutex_);
+        metrics_.update_error();
+        metrics_.calculate_scores();
+    }
+
+    // A failed recovery probe or a relapse on probation re-ejects at once
+    HealthStatus current = status_.load();
+    bool eject = current == HealthStatus::CIRCUIT_OPEN ||
+                 recovering_.load() ||
+                 failures >= max_consecutive_failures_.load();
 
-    if (failures >= max_consecutive_failures_.load()) {
+    if (eject && allow_ejection) {
         open_circuit();
-    } else if (failures >= 2) {
-        status_.store(HealthStatus::UNHEALTHY);
+    } else if (current != HealthStatus::CIRCUIT_OPEN && failures >= 2) {
+        status_.store(HealthStatus::DEGRADED);
     }
 }
 
 void ProviderHealth::open_circuit() {
+    // Each repeat ejection lasts twice as long, up to failure_timeout_
+    int previous = ejection_count_.fetch_add(1);
+    auto duration = std::min<std::chrono::milliseconds>(
+        base_ejection_time_ * (int64_t{1} << std::min(previous, 16)),
+        std::chrono::duration_cast<std::chrono::milliseconds>(failure_timeout_));
+
     status_.store(HealthStatus::CIRCUIT_OPEN);
     circuit_open_time_ = std::chrono::steady_clock::now();
+    ejected_until_ns_.store(steady_now_ns() +
+        std::chrono::duration_cast<std::chrono::nanoseconds>(duration).count());
     consecutive_failures_.store(max_consecutive_failures_.load());
     successful_probes_.store(0);
+    recovering_.store(false);
+    recovery_successes_.store(0);
+
+    // Latency is judged afresh after the provider comes back
+    latency_ema_ms_.store(0.0);
+    latency_samples_.store(0);
 }
 
 void ProviderHealth::attempt_recovery() {
     if (status_.load() == HealthStatus::CIRCUIT_OPEN) {
-        // Perform a health probe
-        health_check_in_progress_.store(true);
-        // The actual health check will be performed by the monitoring thread
+        // End the ejection now; the next probe (or request) decides
+        ejected_until_ns_.store(steady_now_ns());
     }
 }
 
 void ProviderHealth::close_circuit() {
-    status_.store(HealthStatus::HEALTHY);
+    // Routable again, but on probation until recovery_successes_ succeed
+    status_.store(HealthStatus::DEGRADED);
+    recovering_.store(true);
+    recovery_successes_.store(0);
     consecutive_failures_.store(0);
     successful_probes_.store(0);
 }
@@ -242,55 +380,84 @@ bool ProviderHealth::is_healthy() const {
 }
 
 bool ProviderHealth::can_accept_requests() const {
-    HealthStatus current_status = status_.load();
-    bool circuit_closed = current_status != HealthStatus::CIRCUIT_OPEN;
-
-    if (!circuit_closed) {
-        // Check if circuit timeout has passed
-        auto now = std::chrono::steady_clock::now();
-        auto timeout_passed = (now - circuit_open_time_) >= std::chrono::seconds(300); // 5 minutes
-        return timeout_passed;
-    }
+    return status_.load() != HealthStatus::CIRCUIT_OPEN || ejection_expired();
+}
 
-    return true;
+bool ProviderHealth::ejection_expired() const {
+    return steady_now_ns() >= ejected_until_ns_.load();
 }
 
 std::chrono::seconds ProviderHealth::get_retry_delay() const {
-    HealthStatus current_status = status_.load();
-    if (current_status == HealthStatus::CIRCUIT_OPEN) {
-        auto elapsed = std::chrono::steady_clock::now() - circuit_open_time_;
-        auto remaining = std::chrono::seconds(300) - std::chrono::duration_cast<std::chrono::seconds>(elapsed);
-        return std::max(std::chrono::seconds(1), remaining);
+    if (status_.load() == HealthStatus::CIRCUIT_OPEN) {
+        auto remaining = std::chrono::nanoseconds(ejected_until_ns_.load() - steady_now_ns());
+        return std::max(std::chrono::seconds(1), std::chrono::ceil<std::chrono::seconds>(remaining));
     }
     return std::chrono::seconds(0);
 }
 
 void ProviderHealth::update_metrics(const core::Response& response, double request_time_ms) {
+    std::lock_guard<std::mutex> lock(metrics_mutex_);
     metrics_.update_response_time(request_time_ms);
     metrics_.update_success(response.success);
     metrics_.calculate_scores();
 }
 
+void ProviderHealth::record_response_time(double request_time_ms) {
+    std::lock_guard<std::mutex> lock(metrics_mutex_);
+    metrics_.update_response_time(request_time_ms);
+}
+
+PerformanceMetrics ProviderHealth::metrics_snapshot() const {
+    std::lock_guard<std::mutex> lock(metrics_mutex_);
+    return metrics_;
+}
+
+void ProviderHealth::record_latency(double request_time_ms) {
+    // Exponential moving average with alpha = 0.1, seeded by the first sample
+    double current = latency_ema_ms_.load();
+    double next;
+    do {
+        next = latency_samples_.load() == 0 || current == 0.0
+            ? request_time_ms
+            : 0.1 * request_time_ms + 0.9 * current;
+    } while (!latency_ema_ms_.compare_exchange_weak(current, next));
+    latency_samples_.fetch_add(1);
+}
+
 void ProviderHealth::reset_metrics() {
-    metrics_ = PerformanceMetrics();
+    {
+        std::lock_guard<std::mutex> lock(metrics_mutex_);
+        metrics_ = PerformanceMetrics();
+    }
     consecutive_failures_.store(0);
     successful_probes_.store(0);
+    recovering_.store(false);
+    recovery_successes_.store(0);
+    latency_ema_ms_.store(0.0);
+    latency_samples_.store(0);
     status_.store(HealthStatus::HEALTHY);
 }
 
 nlohmann::json ProviderHealth::to_json() const {
+    PerformanceMetrics metrics = metrics_snapshot();
     return nlohmann::json{
         {"provider_name", provider_name_},
         {"status", health_status_to_string(status_.load())},
         {"consecutive_failures", consecutive_failures_.load()},
         {"max_consecutive_failures", max_consecutive_failures_.load()},
         {"last_success_time", std::chrono::duration_cast<std::chrono::seconds>(
-            std::chrono::steady_clock::now() - metrics_.last_success_time_).count()},
+            std::chrono::steady_clock::now() - metrics.last_success_time_).count()},
         {"last_error_time", std::chrono::duration_cast<std::chrono::seconds>(
-            std::chrono::steady_clock::now() - metrics_.last_error_time_).count()},
+            std::chrono::steady_clock::now() - metrics.last_error_time_).count()},
         {"health_check_in_progress", health_check_in_progress_.load()},
+        {"ejection_count", ejection_count_.load()},
+        {"retry_after_seconds", get_retry_delay().count()},
+        {"recovering", recovering_.load()},
+        {"latency_ema_ms", latency_ema_ms_.load()},
+        {"latency_samples", latency_samples_.load()},
         {"capability_flags", capability_flags_.load()},
-        {"metrics", metrics_.to_json()}
+        {"in_flight", in_flight_->load()},
+        {"metrics", metrics.to_json()}
     };
 }
 
@@ -305,9 +472,14 @@ ProviderHealth ProviderHealth::from_json(const nlohmann::json& j) {
     return health;
 }
 
+// ProviderScore implementation
+bool ProviderScore::can_accept_requests() const {
+    return status_ != HealthStatus::CIRCUIT_OPEN || steady_now_ns() >= ejected_until_ns_;
+}
+
 // ProviderHealthMonitor implementation
 ProviderHealthMonitor::ProviderHealthMonitor() {
-    // Load balancer will be set later
+    scores_.store(std::make_shared<const ProviderScoreTable>());
 }
 
 ProviderHealthMonitor::~ProviderHealthMonitor() {
@@ -317,7 +489,9 @@ ProviderHealthMonitor::~ProviderHealthMonitor() {
 void ProviderHealthMonitor::add_provider(const std::string& provider_name, const nlohmann::json& config) {
     std::unique_lock<std::shared_mutex> lock(providers_mutex_);
 
-    auto health = std::make_unique<ProviderHealth>(provider_name);
+    auto health = std::make_shared<ProviderHealth>(provider_name);
+    health->health_check_interval_ = health_check_interval_;
+    apply_outlier_config(*health, get_outlier_detection_config());
 
     // Configure health check settings
     if (config.contains("health_check_interval")) {
@@ -347,14 +521,24 @@ void ProviderHealthMonitor::add_provider(const std::string& provider_name, const
         health->metrics_.cost_per_output_token_ = config["cost_per_output_token"];
     }
 
+    auto first_probe = std::chrono::duration_cast<std::chrono::milliseconds>(health->probe_interval_);
     providers_[provider_name] = std::move(health);
+    lock.unlock();
+
+    publish_scores();
+    if (monitoring_active_.load()) {
+        schedule_probe(provider_name, first_probe);
+    }
 
     aimux::info("Added provider to health monitoring: " + provider_name);
 }
 
 void ProviderHealthMonitor::remove_provider(const std::string& provider_name) {
-    std::unique_lock<std::shared_mutex> lock(providers_mutex_);
-    providers_.erase(provider_name);
+    {
+        std::unique_lock<std::shared_mutex> lock(providers_mutex_);
+        providers_.erase(provider_name);
+    }
+    publish_scores();
     aimux::info("Removed provider from health monitoring: " + provider_name);
 }
 
@@ -370,6 +554,12 @@ const ProviderHealth* ProviderHealthMonitor::get_provider_health(const std::stri
     return (it != providers_.end()) ? it->second.get() : nullptr;
 }
 
+std::shared_ptr<ProviderHealth> ProviderHealthMonitor::find_provider(const std::string& provider_name) const {
+    std::shared_lock<std::shared_mutex> lock(providers_mutex_);
+    auto it = providers_.find(provider_name);
+    return (it != providers_.end()) ? it->second : nullptr;
+}
+
 void ProviderHealthMonitor::start_monitoring() {
     if (monitoring_active_.load()) {
         aimux::warn("Health monitoring is already active");
@@ -377,30 +567,129 @@ void ProviderHealthMonitor::start_monitoring() {
     }
 
     monitoring_active_.store(true);
+
+    // Spread the first probes over one recovery interval rather than probing everyone at once
+    {
+        std::shared_lock<std::shared_mutex> providers_lock(providers_mutex_);
+        std::lock_guard<std::mutex> lock(schedule_mutex_);
+        probe_queue_.clear();
+        auto now = std::chrono::steady_clock::now();
+        for (const auto& [name, health] : providers_) {
+            std::uniform_real_distribution<double> spread(0.0, 1.0);
+            auto delay = std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+                health->probe_interval_ * spread(jitter_rng_));
+            probe_queue_.push_back({now + delay, name});
+            std::push_heap(probe_queue_.begin(), probe_queue_.end(), std::greater<ScheduledProbe>());
+        }
+    }
+
     monitoring_thread_ = std::thread(&ProviderHealthMonitor::monitoring_loop, this);
 
     aimux::info("Started provider health monitoring");
 }
 
 void ProviderHealthMonitor::stop_monitoring() {
-    if (!monitoring_active_.load()) {
+    if (monitoring_active_.load()) {
+        {
+            std::lock_guard<std::mutex> lock(schedule_mutex_);
+            monitoring_active_.store(false);
+        }
+        schedule_cv_.notify_all();
+        if (monitoring_thread_.joinable()) {
+            monitoring_thread_.join();
+        }
+
+        aimux::info("Stopped provider health monitoring");
+    }
+
+    // Probe completions call back into the monitor; each is bounded by the probe timeout
+    std::unique_lock<std::mutex> lock(probes_mutex_);
+    probes_done_.wait(lock, [this]() { return probes_in_flight_ == 0; });
+}
+
+std::shared_ptr<const ProviderScoreTable> ProviderHealthMonitor::get_score_snapshot() const {
+    // Readers never rebuild: writers and the monitor thread keep the table current
+    return scores_.load(std::memory_order_acquire);
+}
+
+void ProviderHealthMonitor::publish_scores() {
+    std::lock_guard<std::mutex> lock(publish_mutex_);
+    publish_scores_locked();
+}
+
+void ProviderHealthMonitor::set_score_publish_interval(std::chrono::milliseconds interval) {
+    score_publish_interval_ns_.store(std::chrono::duration_cast<std::chrono::nanoseconds>(interval).count());
+}
+
+InFlightRequest ProviderHealthMonitor::begin_request(const std::string& provider_name) const {
+    auto scores = get_score_snapshot();
+    const ProviderScore* score = scores->find(provider_name);
+    return score ? InFlightRequest(score->in_flight_) : InFlightRequest();
+}
+
+void ProviderHealthMonitor::mark_scores_dirty() {
+    bool was_dirty = scores_dirty_.exchange(true, std::memory_order_relaxed);
+    refresh_scores_if_stale();
+
+    // Too soon to rebuild: the monitor thread publishes once the interval is up
+    if (!was_dirty && scores_dirty_.load(std::memory_order_relaxed) && monitoring_active_.load()) {
+        std::lock_guard<std::mutex> lock(schedule_mutex_);
+        schedule_cv_.notify_one();
+    }
+}
+
+void ProviderHealthMonitor::refresh_scores_if_stale() {
+    // Batch metric updates: at most one rebuild per interval, and never wait for another rebuilder
+    if (steady_now_ns() - scores_published_ns_.load(std::memory_order_relaxed) <
+        score_publish_interval_ns_.load(std::memory_order_relaxed)) {
         return;
     }
 
-    monitoring_active_.store(false);
-    if (monitoring_thread_.joinable()) {
-        monitoring_thread_.join();
+    std::unique_lock<std::mutex> lock(publish_mutex_, std::try_to_lock);
+    if (lock.owns_lock() && scores_dirty_.load(std::memory_order_relaxed)) {
+        publish_scores_locked();
     }
+}
 
-    aimux::info("Stopped provider health monitoring");
+void ProviderHealthMonitor::publish_scores_locked() const {
+    auto table = std::make_shared<ProviderScoreTable>();
+
+    // Cleared before reading so updates racing with this rebuild mark the table dirty again
+    scores_dirty_.store(false, std::memory_order_relaxed);
+    {
+        std::shared_lock<std::shared_mutex> lock(providers_mutex_);
+        table->scores_.reserve(providers_.size());
+        for (const auto& [name, health] : providers_) {
+            PerformanceMetrics metrics = health->metrics_snapshot();
+
+            ProviderScore score;
+            score.provider_name_ = name;
+            score.status_ = health->status_.load();
+            score.capability_flags_ = health->capability_flags_.load();
+            score.ejected_until_ns_ = health->ejected_until_ns_.load();
+            score.avg_response_time_ms_ = metrics.avg_response_time_ms_;
+            score.success_rate_ = metrics.success_rate_;
+            score.performance_score_ = metrics.performance_score_;
+            score.cost_score_ = metrics.cost_score_;
+            score.cost_per_output_token_ = metrics.cost_per_output_token_;
+            score.requests_per_minute_ = metrics.requests_per_minute_;
+            score.max_requests_per_minute_ = metrics.max_requests_per_minute_;
+            score.in_flight_ = health->in_flight_;
+            table->scores_.emplace(name, std::move(score));
+        }
+    }
+
+    table->version_ = ++scores_version_;
+    scores_.store(std::move(table), std::memory_order_release);
+    scores_published_ns_.store(steady_now_ns(), std::memory_order_relaxed);
 }
 
 std::vector<std::string> ProviderHealthMonitor::get_healthy_providers() const {
-    std::shared_lock<std::shared_mutex> lock(providers_mutex_);
+    auto scores = get_score_snapshot();
     std::vector<std::string> healthy_providers;
 
-    for (const auto& [name, health] : providers_) {
-        if (health->is_healthy() && health->can_accept_requests()) {
+    for (const auto& [name, score] : scores->scores_) {
+        if (score.is_healthy() && score.can_accept_requests()) {
             healthy_providers.push_back(name);
         }
     }
@@ -409,11 +698,11 @@ std::vector<std::string> ProviderHealthMonitor::get_healthy_providers() const {
 }
 
 std::vector<std::string> ProviderHealthMonitor::get_providers_with_capability(ProviderCapability capability) const {
-    std::shared_lock<std::shared_mutex> lock(providers_mutex_);
+    auto scores = get_score_snapshot();
     std::vector<std::string> capable_providers;
 
-    for (const auto& [name, health] : providers_) {
-        if (health->has_capability(capability) && health->can_accept_requests()) {
+    for (const auto& [name, score] : scores->scores_) {
+        if (score.has_capability(capability) && score.can_accept_requests()) {
             capable_providers.push_back(name);
         }
     }
@@ -422,11 +711,11 @@ std::vector<std::string> ProviderHealthMonitor::get_providers_with_capability(Pr
 }
 
 std::vector<std::string> ProviderHealthMonitor::get_unhealthy_providers() const {
-    std::shared_lock<std::shared_mutex> lock(providers_mutex_);
+    auto scores = get_score_snapshot();
     std::vector<std::string> unhealthy_providers;
 
-    for (const auto& [name, health] : providers_) {
-        if (!health->is_healthy() || !health->can_accept_requests()) {
+    for (const auto& [name, score] : scores->scores_) {
+        if (!score.is_healthy() || !score.can_accept_requests()) {
             unhealthy_providers.push_back(name);
         }
     }
@@ -442,10 +731,31 @@ HealthStatus ProviderHealthMonitor::get_provider_status(const std::string& provi
 void ProviderHealthMonitor::update_provider_metrics(const std::string& provider_name,
                                                    const core::Response& response,
                                                    double request_time_ms) {
-    ProviderHealth* health = get_provider_health(provider_name);
-    if (health) {
+    // A cancelled attempt (a hedging loser, a client that left) says nothing about the provider
+    if (response.status_code == 499) {
+        return;
+    }
+
+    // Completions run on the event loop, possibly after the provider was removed
+    std::shared_ptr<ProviderHealth> health = find_provider(provider_name);
+    if (!health) {
+        return;
+    }
+
+    HealthStatus before = health->status_.load();
+    if (is_upstream_failure(response)) {
+        health->record_response_time(request_time_ms);
+        health->mark_failure(before == HealthStatus::CIRCUIT_OPEN || ejection_allowed());
+    } else if (response.success) {
+        health->record_response_time(request_time_ms);
+        health->record_latency(request_time_ms);
+        health->mark_success();
+    } else {
+        // Client-side errors (4xx, 429) leave the provider's health alone
         health->update_metrics(response, request_time_ms);
     }
+    mark_scores_dirty();
+    notify_status_change(provider_name, before, health->status_.load());
 }
 
 nlohmann::json ProviderHealthMonitor::get_all_provider_health() const {
@@ -487,81 +797,296 @@ void ProviderHealthMonitor::set_failure_timeout(const std::string& provider_name
     }
 }
 
+void ProviderHealthMonitor::set_health_probe(HealthProbe probe) {
+    std::lock_guard<std::mutex> lock(config_mutex_);
+    health_probe_ = std::move(probe);
+}
+
+void ProviderHealthMonitor::configure_outlier_detection(const OutlierDetectionConfig& config) {
+    {
+        std::lock_guard<std::mutex> lock(config_mutex_);
+        outlier_config_ = config;
+    }
+
+    std::shared_lock<std::shared_mutex> lock(providers_mutex_);
+    for (auto& [name, health] : providers_) {
+        apply_outlier_config(*health, config);
+    }
+}
+
+OutlierDetectionConfig ProviderHealthMonitor::get_outlier_detection_config() const {
+    std::lock_guard<std::mutex> lock(config_mutex_);
+    return outlier_config_;
+}
+
 void ProviderHealthMonitor::monitoring_loop() {
-    auto last_check = std::chrono::steady_clock::now();
+    auto next_sweep = std::chrono::steady_clock::now() + get_outlier_detection_config().sweep_interval_;
 
+    std::unique_lock<std::mutex> lock(schedule_mutex_);
     while (monitoring_active_.load()) {
         auto now = std::chrono::steady_clock::now();
-        auto elapsed = now - last_check;
 
-        if (elapsed >= health_check_interval_) {
-            perform_periodic_checks();
-            check_circuit_breakers();
-            last_check = now;
+        std::vector<std::string> due;
+        while (!probe_queue_.empty() && probe_queue_.front().due <= now) {
+            std::pop_heap(probe_queue_.begin(), probe_queue_.end(), std::greater<ScheduledProbe>());
+            due.push_back(std::move(probe_queue_.back().provider_name));
+            probe_queue_.pop_back();
+        }
+        bool sweep = now >= next_sweep;
+
+        // Metric updates that arrived too soon after the last publish wait for this thread
+        bool dirty = scores_dirty_.load(std::memory_order_relaxed);
+        auto publish_due = std::chrono::steady_clock::time_point(std::chrono::nanoseconds(
+            scores_published_ns_.load(std::memory_order_relaxed) +
+            score_publish_interval_ns_.load(std::memory_order_relaxed)));
+        bool publish = dirty && now >= publish_due;
+
+        if (due.empty() && !sweep && !publish) {
+            auto wake = next_sweep;
+            if (!probe_queue_.empty()) {
+                wake = std::min(wake, probe_queue_.front().due);
+            }
+            if (dirty) {
+                wake = std::min(wake, publish_due);
+            }
+            schedule_cv_.wait_until(lock, wake);
+            continue;
         }
 
-        std::this_thread::sleep_for(std::chrono::seconds(5));
+        // Probes and sweeps run without the schedule lock so they can reschedule
+        lock.unlock();
+        if (publish) {
+            publish_scores();
+        }
+        for (const auto& provider_name : due) {
+            perform_health_check(provider_name);
+        }
+        if (sweep) {
+            evaluate_outliers();
+            next_sweep = std::chrono::steady_clock::now() + get_outlier_detection_config().sweep_interval_;
+        }
+        lock.lock();
     }
 }
 
-void ProviderHealthMonitor::perform_periodic_checks() {
-    std::shared_lock<std::shared_mutex> lock(providers_mutex_);
+void ProviderHealthMonitor::schedule_probe(const std::string& provider_name, std::chrono::milliseconds delay) {
+    double jitter = get_outlier_detection_config().probe_jitter_;
 
-    for (const auto& [name, health] : providers_) {
-        if (!health->health_check_in_progress_.load()) {
-            auto now = std::chrono::steady_clock::now();
-            auto time_since_check = now - health->last_health_check_;
+    std::lock_guard<std::mutex> lock(schedule_mutex_);
+    std::uniform_real_distribution<double> spread(1.0 - jitter, 1.0 + jitter);
+    auto jittered = std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+        std::chrono::duration<double, std::milli>(static_cast<double>(delay.count()) * spread(jitter_rng_)));
 
-            if (time_since_check >= health->health_check_interval_) {
-                perform_health_check(name);
-            }
-        }
+    probe_queue_.push_back({std::chrono::steady_clock::now() + jittered, provider_name});
+    std::push_heap(probe_queue_.begin(), probe_queue_.end(), std::greater<ScheduledProbe>());
+    schedule_cv_.notify_one();
+}
+
+std::chrono::milliseconds ProviderHealthMonitor::next_probe_delay(const ProviderHealth& health) {
+    HealthStatus status = health.status_.load();
+    if (status == HealthStatus::CIRCUIT_OPEN && !health.ejection_expired()) {
+        // Nothing to learn before the ejection ends
+        auto remaining = std::chrono::nanoseconds(health.ejected_until_ns_.load() - steady_now_ns());
+        return std::max(std::chrono::milliseconds(1), std::chrono::ceil<std::chrono::milliseconds>(remaining));
+    }
+    if (status == HealthStatus::CIRCUIT_OPEN || health.recovering_.load()) {
+        return std::chrono::duration_cast<std::chrono::milliseconds>(health.probe_interval_);
     }
+    return std::chrono::duration_cast<std::chrono::milliseconds>(health.health_check_interval_);
 }
 
 void ProviderHealthMonitor::perform_health_check(const std::string& provider_name) {
-    ProviderHealth* health = get_provider_health(provider_name);
-    if (!health || health->health_check_in_progress_.load()) {
+    // Held for the whole probe: remove_provider() may run before the probe completes
+    std::shared_ptr<ProviderHealth> health = find_provider(provider_name);
+    if (!health || health->health_check_in_progress_.exchange(true)) {
+        return;
+    }
+
+    HealthProbe probe;
+    {
+        std::lock_guard<std::mutex> lock(config_mutex_);
+        probe = health_probe_;
+    }
+
+    bool still_ejected = health->status_.load() == HealthStatus::CIRCUIT_OPEN && !health->ejection_expired();
+    if (!probe || still_ejected) {
+        complete_health_check(provider_name, *health, std::nullopt);
         return;
     }
 
-    health->health_check_in_progress_.store(true);
     health->last_health_check_ = std::chrono::steady_clock::now();
+    {
+        std::lock_guard<std::mutex> lock(probes_mutex_);
+        probes_in_flight_++;
+    }
+
+    // Usually completes on the network event loop while this thread starts the next probe
+    auto on_complete = [this, provider_name, health](std::optional<core::Response> result) {
+        complete_health_check(provider_name, *health, result);
+
+        std::lock_guard<std::mutex> lock(probes_mutex_);
+        if (--probes_in_flight_ == 0) {
+            probes_done_.notify_all();
+        }
+    };
 
-    // In a real implementation, this would make an actual health check request
-    // For now, we'll simulate based on current status
     try {
-        // Simple health check - in real implementation, make request to provider
-        bool is_healthy = (std::rand() % 100) > 10; // 90% success rate for simulation
+        probe(provider_name, on_complete);
+    } catch (const std::exception& e) {
+        aimux::error("Health probe exception for provider " + provider_name + ": " + e.what());
+        core::Response failed;
+        failed.status_code = 500;
+        failed.error_message = e.what();
+        on_complete(std::move(failed));
+    }
+}
 
-        if (is_healthy) {
-            health->mark_success();
-            aimux::debug("Health check passed for provider: " + provider_name);
+void ProviderHealthMonitor::complete_health_check(const std::string& provider_name, ProviderHealth& health,
+                                                  const std::optional<core::Response>& result) {
+    HealthStatus before = health.status_.load();
+    if (result) {
+        // A rate-limited provider is up; any other non-success counts against it
+        if (result->success || result->status_code == 429) {
+            health.mark_success();
+            aimux::debug("Health probe passed for provider: " + provider_name);
         } else {
-            health->mark_failure();
-            aimux::warn("Health check failed for provider: " + provider_name);
+            health.mark_failure(before == HealthStatus::CIRCUIT_OPEN || ejection_allowed());
+            aimux::warn("Health probe failed for provider " + provider_name + " (HTTP " +
+                       std::to_string(result->status_code) + "): " + result->error_message);
         }
-    } catch (const std::exception& e) {
-        health->mark_failure();
-        aimux::error("Health check exception for provider " + provider_name + ": " + e.what());
     }
 
-    health->health_check_in_progress_.store(false);
+    health.health_check_in_progress_.store(false);
+    mark_scores_dirty();
+    notify_status_change(provider_name, before, health.status_.load());
+
+    if (monitoring_active_.load()) {
+        schedule_probe(provider_name, next_probe_delay(health));
+    }
 }
 
-void ProviderHealthMonitor::check_circuit_breakers() {
-    std::shared_lock<std::shared_mutex> lock(providers_mutex_);
+void ProviderHealthMonitor::evaluate_outliers() {
+    OutlierDetectionConfig config = get_outlier_detection_config();
+    bool have_probe;
+    {
+        std::lock_guard<std::mutex> lock(config_mutex_);
+        have_probe = static_cast<bool>(health_probe_);
+    }
 
-    for (const auto& [name, health] : providers_) {
-        if (health->status_.load() == HealthStatus::CIRCUIT_OPEN) {
-            auto now = std::chrono::steady_clock::now();
-            auto time_circuit_open = now - health->circuit_open_time_;
+    struct Candidate {
+        const std::string* name;
+        ProviderHealth* health;
+        double latency_ms;
+    };
 
-            if (time_circuit_open >= health->failure_timeout_) {
-                // Attempt recovery after timeout
-                health->attempt_recovery();
+    std::vector<std::tuple<std::string, HealthStatus, HealthStatus>> changes;
+    {
+        std::shared_lock<std::shared_mutex> lock(providers_mutex_);
+        int64_t now_ns = steady_now_ns();
+        int64_t forget_after_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
+            config.max_ejection_time_).count();
+        size_t ejected = 0;
+        std::vector<Candidate> candidates;
+
+        for (const auto& [name, health] : providers_) {
+            HealthStatus status = health->status_.load();
+            if (status == HealthStatus::CIRCUIT_OPEN) {
+                if (!have_probe && health->ejection_expired()) {
+                    // Nothing can probe it, so live traffic decides while it is on probation
+                    health->close_circuit();
+                    changes.emplace_back(name, status, health->status_.load());
+                } else {
+                    ejected++;
+                }
+                continue;
+            }
+
+            // Forget past ejections once a provider has stayed in service long enough
+            if (status == HealthStatus::HEALTHY && health->ejection_count_.load() > 0 &&
+                now_ns - health->ejected_until_ns_.load() > forget_after_ns) {
+                health->ejection_count_.store(0);
+            }
+
+            if (health->latency_samples_.load() >= config.min_latency_samples_) {
+                candidates.push_back({&name, health.get(), health->latency_ema_ms_.load()});
             }
         }
+
+        for (const auto& candidate : candidates) {
+            // Compare against the other providers only, so an outlier cannot hide by inflating the mean
+            double sum = 0.0;
+            double sum_sq = 0.0;
+            size_t peers = 0;
+            for (const auto& peer : candidates) {
+                if (&peer != &candidate) {
+                    sum += peer.latency_ms;
+                    sum_sq += peer.latency_ms * peer.latency_ms;
+                    peers++;
+                }
+            }
+            if (peers < config.min_latency_peers_) {
+                break;
+            }
+
+            double mean = sum / static_cast<double>(peers);
+            double stddev = std::sqrt(std::max(0.0, sum_sq / static_cast<double>(peers) - mean * mean));
+            double scale = std::max(stddev, mean * config.latency_stddev_floor_ratio_);
+            if (scale <= 0.0) {
+                continue;
+            }
+
+            double z_score = (candidate.latency_ms - mean) / scale;
+            if (z_score < config.latency_z_threshold_) {
+                continue;
+            }
+            if (static_cast<double>(ejected + 1) * 100.0 >
+                config.max_ejection_percent_ * static_cast<double>(providers_.size())) {
+                break;
+            }
+
+            HealthStatus status = candidate.health->status_.load();
+            candidate.health->open_circuit();
+            ejected++;
+            changes.emplace_back(*candidate.name, status, HealthStatus::CIRCUIT_OPEN);
+
+            std::ostringstream reason;
+            reason << "Ejecting latency outlier " << *candidate.name << ": " << candidate.latency_ms
+                   << "ms against a peer mean of " << mean << "ms (z=" << z_score << ")";
+            aimux::warn(reason.str());
+        }
+    }
+
+    for (const auto& [provider_name, before, after] : changes) {
+        notify_status_change(provider_name, before, after);
+    }
+}
+
+bool ProviderHealthMonitor::ejection_allowed() const {
+    double max_percent = get_outlier_detection_config().max_ejection_percent_;
+
+    std::shared_lock<std::shared_mutex> lock(providers_mutex_);
+    size_t ejected = 0;
+    for (const auto& [name, health] : providers_) {
+        if (health->status_.load() == HealthStatus::CIRCUIT_OPEN) {
+            ejected++;
+        }
+    }
+    return static_cast<double>(ejected + 1) * 100.0 <= max_percent * static_cast<double>(providers_.size());
+}
+
+void ProviderHealthMonitor::notify_status_change(const std::string& provider_name,
+                                                 HealthStatus before, HealthStatus after) {
+    if (before == after) {
+        return;
+    }
+
+    // Routing must see status changes at once, not at the next batched publish
+    publish_scores();
+
+    aimux::info("Provider " + provider_name + " health: " + health_status_to_string(before) +
+                " -> " + health_status_to_string(after));
+    if (health_change_callback_) {
+        health_change_callback_(provider_name, before, after);
     }
 }
 
@@ -0,0 +1,232 @@
+#include "aimux/gateway/request_metrics_store.hpp"
+#include <algorithm>
+#include <cstring>
+#include <thread>
+
+namespace aimux {
+namespace gateway {
+
+namespace {
+    // Assigned once per thread; spreads writers over the shards
+    std::atomic<uint32_t> next_thread_slot{0};
+
+    uint32_t thread_slot() {
+        thread_local uint32_t slot = next_thread_slot.fetch_add(1, std::memory_order_relaxed);
+        return slot;
+    }
+}
+
+// ============================================================================
+// Aggregate
+// ============================================================================
+
+void RequestMetricsStore::Aggregate::add(const MetricRecord& record) {
+    requests.fetch_add(1, std::memory_order_relaxed);
+    if (record.flags & MetricRecord::SUCCESS) {
+        successes.fetch_add(1, std::memory_order_relaxed);
+    }
+    if (record.flags & MetricRecord::FAILOVER) {
+        failovers.fetch_add(1, std::memory_order_relaxed);
+    }
+    if (record.flags & MetricRecord::HEDGED) {
+        hedged.fetch_add(1, std::memory_order_relaxed);
+    }
+    request_tokens.fetch_add(static_cast<uint64_t>(std::max(0, record.request_tokens)), std::memory_order_relaxed);
+    response_tokens.fetch_add(static_cast<uint64_t>(std::max(0, record.response_tokens)), std::memory_order_relaxed);
+    cost_micro_usd.fetch_add(static_cast<uint64_t>(std::max(0.0f, record.cost_usd) * 1e6f), std::memory_order_relaxed);
+    latency.record(record.duration_us);
+}
+
+void RequestMetricsStore::Aggregate::reset() {
+    requests.store(0, std::memory_order_relaxed);
+    successes.store(0, std::memory_order_relaxed);
+    failovers.store(0, std::memory_order_relaxed);
+    hedged.store(0, std::memory_order_relaxed);
+    request_tokens.store(0, std::memory_order_relaxed);
+    response_tokens.store(0, std::memory_order_relaxed);
+    cost_micro_usd.store(0, std::memory_order_relaxed);
+    latency.reset();
+}
+
+nlohmann::json RequestMetricsStore::Aggregate::to_json() const {
+    uint64_t total = requests.load(std::memory_order_relaxed);
+    uint64_t ok = successes.load(std::memory_order_relaxed);
+
+    nlohmann::json j;
+    j["requests"] = total;
+    j["successful_requests"] = ok;
+    j["success_rate"] = total > 0 ? static_cast<double>(ok) / static_cast<double>(total) : 0.0;
+    j["failovers"] = failovers.load(std::memory_order_relaxed);
+    j["hedged"] = hedged.load(std::memory_order_relaxed);
+    j["request_tokens"] = request_tokens.load(std::memory_order_relaxed);
+    j["response_tokens"] = response_tokens.load(std::memory_order_relaxed);
+    j["cost_usd"] = static_cast<double>(cost_micro_usd.load(std::memory_order_relaxed)) / 1e6;
+    j["latency_ms"] = latency.to_json(1000.0);
+    return j;
+}
+
+// ============================================================================
+// RequestMetricsStore
+// ============================================================================
+
+RequestMetricsStore::RequestMetricsStore(size_t capacity, size_t shards) {
+    if (shards == 0) {
+        shards = std::max<size_t>(4, std::thread::hardware_concurrency());
+    }
+    shard_count_ = shards;
+    shard_capacity_ = std::max<size_t>(1, (capacity + shards - 1) / shards);
+
+    shards_ = std::make_unique<Shard[]>(shard_count_);
+    for (size_t i = 0; i < shard_count_; ++i) {
+        shards_[i].slots = std::make_unique<Slot[]>(shard_capacity_);
+    }
+    providers_ = std::make_unique<Aggregate[]>(MAX_PROVIDERS);
+
+    provider_storage_.emplace_back("other");
+    provider_names_[OTHER_PROVIDER].store(&provider_storage_.back(), std::memory_order_release);
+}
+
+RequestMetricsStore::~RequestMetricsStore() = default;
+
+uint16_t RequestMetricsStore::intern(std::string_view provider_name) {
+    size_t count = provider_count_.load(std::memory_order_acquire);
+    for (size_t id = 1; id < count; ++id) {
+        if (*provider_names_[id].load(std::memory_order_acquire) == provider_name) {
+            return static_cast<uint16_t>(id);
+        }
+    }
+
+    std::lock_guard<std::mutex> lock(intern_mutex_);
+    count = provider_count_.load(std::memory_order_relaxed);
+    for (size_t id = 1; id < count; ++id) {
+        if (*provider_names_[id].load(std::memory_order_relaxed) == provider_name) {
+            return static_cast<uint16_t>(id);
+        }
+    }
+    if (count >= MAX_PROVIDERS) {
+        return OTHER_PROVIDER;
+    }
+
+    provider_storage_.emplace_back(provider_name);
+    provider_names_[count].store(&provider_storage_.back(), std::memory_order_release);
+    provider_count_.store(count + 1, std::memory_order_release);
+    return static_cast<uint16_t>(count);
+}
+
+std::string RequestMetricsStore::provider_name(uint16_t id) const {
+    if (id >= provider_count_.load(std::memory_order_acquire)) {
+        id = OTHER_PROVIDER;
+    }
+    return *provider_names_[id].load(std::memory_order_acquire);
+}
+
+RequestMetricsStore::Shard& RequestMetricsStore::shard_for_this_thread() {
+    return shards_[thread_slot() % shard_count_];
+}
+
+void RequestMetricsStore::record(const MetricRecord& record) {
+    uint16_t id = record.provider_id < MAX_PROVIDERS ? record.provider_id : OTHER_PROVIDER;
+    providers_[id].add(record);
+    totals_.add(record);
+
+    Shard& shard = shard_for_this_thread();
+    uint64_t index = shard.head.fetch_add(1, std::memory_order_relaxed);
+    Slot& slot = shard.slots[index % shard_capacity_];
+
+    // Claim the slot only from an older, settled record: a writer that lapped one still
+    // being written (or already overwritten by a newer index) gives up rather than tear it
+    uint64_t writing = 2 * index + 1;
+    uint64_t current = slot.sequence.load(std::memory_order_relaxed);
+    do {
+        if ((current & 1) != 0 || current > writing) {
+            return;
+        }
+    } while (!slot.sequence.compare_exchange_weak(current, writing, std::memory_order_relaxed));
+    std::atomic_thread_fence(std::memory_order_release);
+
+    std::array<uint64_t, RECORD_WORDS> words{};
+    std::memcpy(words.data(), &record, sizeof(MetricRecord));
+    for (size_t i = 0; i < RECORD_WORDS; ++i) {
+        slot.words[i].store(words[i], std::memory_order_relaxed);
+    }
+    slot.sequence.store(writing + 1, std::memory_order_release);
+}
+
+std::vector<MetricRecord> RequestMetricsStore::recent(size_t count) const {
+    std::vector<MetricRecord> records;
+    if (count == 0) {
+        return records;
+    }
+
+    for (size_t s = 0; s < shard_count_; ++s) {
+        const Shard& shard = shards_[s];
+        uint64_t head = shard.head.load(std::memory_order_acquire);
+        uint64_t available = std::min<uint64_t>({head, shard_capacity_, count});
+
+        for (uint64_t index = head - available; index < head; ++index) {
+            const Slot& slot = shard.slots[index % shard_capacity_];
+            uint64_t before = slot.sequence.load(std::memory_order_acquire);
+            if (before != 2 * (index + 1)) {
+                continue;   // Still being written, overwritten since, or cleared
+            }
+            std::array<uint64_t, RECORD_WORDS> words;
+            for (size_t i = 0; i < RECORD_WORDS; ++i) {
+                words[i] = slot.words[i].load(std::memory_order_relaxed);
+            }
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (slot.sequence.load(std::memory_order_relaxed) == before) {
+                MetricRecord copy;
+                std::memcpy(static_cast<void*>(&copy), words.data(), sizeof(MetricRecord));
+                records.push_back(copy);
+            }
+        }
+    }
+
+    std::sort(records.begin(), records.end(), [](const MetricRecord& a, const MetricRecord& b) {
+        return a.end_ns < b.end_ns;
+    });
+    if (records.size() > count) {
+        records.erase(records.begin(), records.end() - static_cast<std::ptrdiff_t>(count));
+    }
+    return records;
+}
+
+uint64_t RequestMetricsStore::total_requests() const {
+    return totals_.requests.load(std::memory_order_relaxed);
+}
+
+uint64_t RequestMetricsStore::successful_requests() const {
+    return totals_.successes.load(std::memory_order_relaxed);
+}
+
+const metrics::LatencyHistogram& RequestMetricsStore::latency() const {
+    return totals_.latency;
+}
+
+nlohmann::json RequestMetricsStore::providers_to_json() const {
+    nlohmann::json providers = nlohmann::json::object();
+    size_t count = provider_count_.load(std::memory_order_acquire);
+    for (size_t id = 0; id < count; ++id) {
+        if (providers_[id].requests.load(std::memory_order_relaxed) == 0) {
+            continue;
+        }
+        providers[*provider_names_[id].load(std::memory_order_acquire)] = providers_[id].to_json();
+    }
+    return providers;
+}
+
+void RequestMetricsStore::clear() {
+    for (size_t id = 0; id < MAX_PROVIDERS; ++id) {
+        providers_[id].reset();
+    }
+    totals_.reset();
+
+    for (size_t s = 0; s < shard_count_; ++s) {
+        for (size_t i = 0; i < shard_capacity_; ++i) {
+            shards_[s].slots[i].sequence.store(0, std::memory_order_release);
+        }
+    }
+}
+
+} // namespace gateway
+} // namespace aimux
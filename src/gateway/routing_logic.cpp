@@ -2,7 +2,6 @@
 #include "aimux/logging/logger.hpp"
 #include <algorithm>
 #include <random>
-#include <regex>
 #include <sstream>
 #include <cmath>
 #include <unordered_set>
@@ -10,6 +9,84 @@
 namespace aimux {
 namespace gateway {
 
+namespace {
+
+// Classifier categories reported by the keyword automaton
+constexpr uint32_t CATEGORY_THINKING = 1u << 0;
+constexpr uint32_t CATEGORY_VISION = 1u << 1;
+constexpr uint32_t CATEGORY_TOOL_MARKER = 1u << 2;
+
+constexpr size_t LONG_CONTEXT_THRESHOLD = 10000;
+
+// Whole-word reasoning phrases; whitespace runs in the prompt match a single space
+constexpr const char* THINKING_PHRASES[] = {
+    "step by step", "break down", "explain your reasoning", "think aloud",
+    "show your work", "walk me through", "how would you approach", "what are the steps"
+};
+
+// Serialized tool-call fragments pasted into prompt text
+constexpr const char* TOOL_MARKERS[] = {"tool_call", "function_call"};
+
+const std::string* string_field(const nlohmann::json& object, const char* key) {
+    auto it = object.find(key);
+    if (it == object.end() || !it->is_string()) {
+        return nullptr;
+    }
+    return &it->get_ref<const std::string&>();
+}
+
+/**
+ * @brief Accumulates classifier state while walking message content
+ */
+struct ContentScan {
+    explicit ContentScan(const KeywordMatcher& matcher) : scanner(matcher) {}
+
+    KeywordMatcher::Scanner scanner;
+    size_t text_length = 0;
+    bool has_images = false;
+    bool has_tool_blocks = false;
+
+    void add_text(const std::string& text) {
+        text_length += text.size() + 1;
+        // Length still counts, but once every verdict is in the bytes need no scanning
+        if (!scanner.has_all(CATEGORY_THINKING | CATEGORY_TOOL_MARKER)) {
+            scanner.feed(text);
+            scanner.feed_separator();
+        }
+    }
+
+    void visit_content(const nlohmann::json& content) {
+        if (content.is_string()) {
+            add_text(content.get_ref<const std::string&>());
+            return;
+        }
+        if (!content.is_array()) {
+            return;
+        }
+        // Handle multimodal content
+        for (const auto& item : content) {
+            if (!item.is_object()) {
+                continue;
+            }
+            const std::string* type = string_field(item, "type");
+            if (!type) {
+                continue;
+            }
+            if (*type == "text") {
+                if (const std::string* text = string_field(item, "text")) {
+                    add_text(*text);
+                }
+            } else if (*type == "image" || *type == "image_url") {
+                has_images = true;
+            } else if (*type == "tool_use" || *type == "tool_result") {
+                has_tool_blocks = true;
+            }
+        }
+    }
+};
+
+} // namespace
+
 // ============================================================================
 // Utility Functions Implementation
 // ============================================================================
@@ -104,6 +181,7 @@ nlohmann::json RequestAnalysis::to_json() const {
     j["requires_tools"] = requires_tools_;
     j["requires_json_mode"] = requires_json_mode_;
     j["requires_function_calling"] = requires_function_calling_;
+    j["content_length"] = content_length_;
     j["cost_sensitivity"] = cost_sensitivity_;
     j["latency_sensitivity"] = latency_sensitivity_;
     return j;
@@ -145,6 +223,13 @@ WeightedBalancer::WeightedBalancer(ProviderHealthMonitor* health_monitor)
 std::string WeightedBalancer::select_provider(
     const std::vector<std::string>& providers,
     RequestType request_type) const {
+    return select_provider(providers, request_type, *health_monitor_->get_score_snapshot());
+}
+
+std::string WeightedBalancer::select_provider(
+    const std::vector<std::string>& providers,
+    RequestType request_type,
+    const ProviderScoreTable& scores) const {
 
     if (providers.empty()) {
         return "";
@@ -159,11 +244,12 @@ std::string WeightedBalancer::select_provider(
     double total_weight = 0.0;
 
     for (const auto& provider : providers) {
-        if (!provider_is_suitable(provider, request_type)) {
+        const ProviderScore* score = scores.find(provider);
+        if (!score || !provider_is_suitable(*score, request_type)) {
             continue;
         }
 
-        double weight = calculate_weight(provider, request_type);
+        double weight = calculate_weight(*score, request_type);
         if (weight > 0.0) {
             weighted_providers.emplace_back(provider, weight);
             total_weight += weight;
@@ -192,35 +278,30 @@ std::string WeightedBalancer::select_provider(
     return weighted_providers.back().first;
 }
 
-double WeightedBalancer::calculate_weight(const std::string& provider,
+double WeightedBalancer::calculate_weight(const ProviderScore& score,
                                           RequestType /* request_type */) const {
-    ProviderHealth* health = health_monitor_->get_provider_health(provider);
-    if (!health) {
-        return 0.0;
-    }
-
-    if (!health->is_healthy()) {
+    if (!score.is_healthy()) {
         return 0.0;
     }
 
     double weight = 1.0;
 
     // Performance score (higher is better)
-    double performance_score = health->metrics_.performance_score_;
+    double performance_score = score.performance_score_;
     weight *= performance_score;
 
     // Success rate (higher is better)
-    double success_rate = health->metrics_.success_rate_;
+    double success_rate = score.success_rate_;
     weight *= success_rate;
 
     // Response time (lower is better, so invert)
-    double response_time = health->metrics_.avg_response_time_ms_;
+    double response_time = score.avg_response_time_ms_;
     if (response_time > 0.0) {
         weight *= (1000.0 / response_time); // Invert and normalize
     }
 
     // Cost factor (lower cost is better, so invert)
-    double cost_score = health->metrics_.cost_score_;
+    double cost_score = score.cost_score_;
     if (cost_score > 0.0) {
         weight *= (1.0 / cost_score); // Invert
     }
@@ -228,10 +309,9 @@ double WeightedBalancer::calculate_weight(const std::string& provider,
     return std::max(0.0, weight);
 }
 
-bool WeightedBalancer::provider_is_suitable(const std::string& provider,
+bool WeightedBalancer::provider_is_suitable(const ProviderScore& score,
                                            RequestType request_type) const {
-    ProviderHealth* health = health_monitor_->get_provider_health(provider);
-    if (!health || !health->is_healthy()) {
+    if (!score.is_healthy()) {
         return false;
     }
 
@@ -258,7 +338,7 @@ bool WeightedBalancer::provider_is_suitable(const std::string& provider,
             break;
     }
 
-    return health->has_capability(required_caps);
+    return score.has_capability(required_caps);
 }
 
 LeastConnectionsBalancer::LeastConnectionsBalancer(ProviderHealthMonitor* health_monitor)
@@ -266,22 +346,30 @@ LeastConnectionsBalancer::LeastConnectionsBalancer(ProviderHealthMonitor* health
 
 std::string LeastConnectionsBalancer::select_provider(
     const std::vector<std::string>& providers,
-    RequestType /* request_type */) const {
+    RequestType request_type) const {
+    return select_provider(providers, request_type, *health_monitor_->get_score_snapshot());
+}
+
+std::string LeastConnectionsBalancer::select_provider(
+    const std::vector<std::string>& providers,
+    RequestType /* request_type */,
+    const ProviderScoreTable& scores) const {
 
     if (providers.empty()) {
         return "";
     }
 
     std::string best_provider;
-    int min_connections = std::numeric_limits<int>::max();
+    int64_t min_connections = std::numeric_limits<int64_t>::max();
 
     for (const auto& provider : providers) {
-        ProviderHealth* health = health_monitor_->get_provider_health(provider);
-        if (!health || !health->is_healthy()) {
+        const ProviderScore* score = scores.find(provider);
+        if (!score || !score->is_healthy()) {
             continue;
         }
 
-        int current_requests = health->metrics_.requests_per_minute_;
+        // Live count, not the snapshot's: requests start and finish between publishes
+        int64_t current_requests = score->in_flight();
         if (current_requests < min_connections) {
             min_connections = current_requests;
             best_provider = provider;
@@ -296,17 +384,32 @@ std::string LeastConnectionsBalancer::select_provider(
 // ============================================================================
 
 RoutingLogic::RoutingLogic(ProviderHealthMonitor* health_monitor)
-    : health_monitor_(health_monitor) {}
+    : health_monitor_(health_monitor) {
+    rebuild_classifier();
+}
 
 RoutingDecision RoutingLogic::route_request(
     const core::Request& request,
     RoutingPriority priority) {
+    return route_request(request, analyze_request(request), priority);
+}
 
-    // Analyze the request
-    RequestAnalysis analysis = analyze_request(request);
+RoutingDecision RoutingLogic::route_request(
+    const core::Request& /*request*/,
+    const RequestAnalysis& analysis,
+    RoutingPriority priority) {
+
+    // One snapshot for the whole decision: every filter and selector below reads this table
+    std::shared_ptr<const ProviderScoreTable> snapshot = health_monitor_->get_score_snapshot();
+    const ProviderScoreTable& scores = *snapshot;
 
     // Get all healthy providers
-    std::vector<std::string> healthy_providers = health_monitor_->get_healthy_providers();
+    std::vector<std::string> healthy_providers;
+    for (const auto& [name, score] : scores.scores_) {
+        if (score.is_healthy() && score.can_accept_requests()) {
+            healthy_providers.push_back(name);
+        }
+    }
 
     if (healthy_providers.empty()) {
         RoutingDecision decision;
@@ -318,7 +421,7 @@ RoutingDecision RoutingLogic::route_request(
     }
 
     // Filter providers based on request requirements
-    std::vector<std::string> capable_providers = filter_by_request_type(healthy_providers, analysis.type_);
+    std::vector<std::string> capable_providers = filter_by_request_type(healthy_providers, analysis.type_, scores);
 
     if (capable_providers.empty()) {
         // If no capable providers, try with all healthy providers
@@ -330,26 +433,26 @@ RoutingDecision RoutingLogic::route_request(
 
     switch (priority) {
         case RoutingPriority::COST:
-            selected_provider = select_by_cost(capable_providers);
+            selected_provider = select_by_cost(capable_providers, scores);
             break;
         case RoutingPriority::PERFORMANCE:
-            selected_provider = select_by_performance(capable_providers);
+            selected_provider = select_by_performance(capable_providers, scores);
             break;
         case RoutingPriority::RELIABILITY:
-            selected_provider = select_by_reliability(capable_providers);
+            selected_provider = select_by_reliability(capable_providers, scores);
             break;
         case RoutingPriority::BALANCED:
-            selected_provider = select_balanced(capable_providers, analysis);
+            selected_provider = select_balanced(capable_providers, analysis, scores);
             break;
         case RoutingPriority::CUSTOM:
             if (custom_priority_function_) {
                 selected_provider = select_custom(capable_providers, analysis, custom_priority_function_);
             } else {
-                selected_provider = select_balanced(capable_providers, analysis);
+                selected_provider = select_balanced(capable_providers, analysis, scores);
             }
             break;
         default:
-            selected_provider = select_balanced(capable_providers, analysis);
+            selected_provider = select_balanced(capable_providers, analysis, scores);
             break;
     }
 
@@ -366,8 +469,9 @@ RoutingDecision RoutingLogic::route_request(
     decision.selected_provider_ = selected_provider;
     decision.priority_used_ = priority;
     decision.alternative_providers_ = alternatives;
-    decision.selection_score_ = calculate_provider_score(selected_provider, analysis.required_capabilities_, priority);
-    decision.reasoning_ = generate_reasoning(decision, analysis, capable_providers);
+    decision.selection_score_ = calculate_provider_score(selected_provider, analysis.required_capabilities_, priority,
+                                                         scores);
+    decision.reasoning_ = generate_reasoning(decision, analysis, capable_providers, scores);
 
     // Record the routing decision
     record_routing_decision(decision);
@@ -376,6 +480,11 @@ RoutingDecision RoutingLogic::route_request(
 }
 
 std::string RoutingLogic::select_by_cost(const std::vector<std::string>& providers) {
+    return select_by_cost(providers, *health_monitor_->get_score_snapshot());
+}
+
+std::string RoutingLogic::select_by_cost(const std::vector<std::string>& providers,
+                                        const ProviderScoreTable& scores) {
     if (providers.empty()) {
         return "";
     }
@@ -384,12 +493,12 @@ std::string RoutingLogic::select_by_cost(const std::vector<std::string>& provide
     double min_cost = std::numeric_limits<double>::max();
 
     for (const auto& provider : providers) {
-        ProviderHealth* health = health_monitor_->get_provider_health(provider);
-        if (!health) {
+        const ProviderScore* score = scores.find(provider);
+        if (!score) {
             continue;
         }
 
-        double cost = health->metrics_.cost_per_output_token_;
+        double cost = score->cost_per_output_token_;
         if (cost < min_cost) {
             min_cost = cost;
             cheapest_provider = provider;
@@ -400,6 +509,11 @@ std::string RoutingLogic::select_by_cost(const std::vector<std::string>& provide
 }
 
 std::string RoutingLogic::select_by_performance(const std::vector<std::string>& providers) {
+    return select_by_performance(providers, *health_monitor_->get_score_snapshot());
+}
+
+std::string RoutingLogic::select_by_performance(const std::vector<std::string>& providers,
+                                        const ProviderScoreTable& scores) {
     if (providers.empty()) {
         return "";
     }
@@ -408,12 +522,12 @@ std::string RoutingLogic::select_by_performance(const std::vector<std::string>&
     double min_response_time = std::numeric_limits<double>::max();
 
     for (const auto& provider : providers) {
-        ProviderHealth* health = health_monitor_->get_provider_health(provider);
-        if (!health) {
+        const ProviderScore* score = scores.find(provider);
+        if (!score) {
             continue;
         }
 
-        double response_time = health->metrics_.avg_response_time_ms_;
+        double response_time = score->avg_response_time_ms_;
         if (response_time < min_response_time) {
             min_response_time = response_time;
             fastest_provider = provider;
@@ -424,6 +538,11 @@ std::string RoutingLogic::select_by_performance(const std::vector<std::string>&
 }
 
 std::string RoutingLogic::select_by_reliability(const std::vector<std::string>& providers) {
+    return select_by_reliability(providers, *health_monitor_->get_score_snapshot());
+}
+
+std::string RoutingLogic::select_by_reliability(const std::vector<std::string>& providers,
+                                        const ProviderScoreTable& scores) {
     if (providers.empty()) {
         return "";
     }
@@ -432,12 +551,12 @@ std::string RoutingLogic::select_by_reliability(const std::vector<std::string>&
     double max_success_rate = -1.0;
 
     for (const auto& provider : providers) {
-        ProviderHealth* health = health_monitor_->get_provider_health(provider);
-        if (!health) {
+        const ProviderScore* score = scores.find(provider);
+        if (!score) {
             continue;
         }
 
-        double success_rate = health->metrics_.success_rate_;
+        double success_rate = score->success_rate_;
         if (success_rate > max_success_rate) {
             max_success_rate = success_rate;
             most_reliable_provider = provider;
@@ -449,6 +568,12 @@ std::string RoutingLogic::select_by_reliability(const std::vector<std::string>&
 
 std::string RoutingLogic::select_balanced(const std::vector<std::string>& providers,
                                          const RequestAnalysis& analysis) {
+    return select_balanced(providers, analysis, *health_monitor_->get_score_snapshot());
+}
+
+std::string RoutingLogic::select_balanced(const std::vector<std::string>& providers,
+                                         const RequestAnalysis& analysis,
+                                         const ProviderScoreTable& scores) {
     if (providers.empty()) {
         return "";
     }
@@ -459,7 +584,7 @@ std::string RoutingLogic::select_balanced(const std::vector<std::string>& provid
 
     // Apply load balancing if configured
     if (load_balancer_) {
-        return load_balancer_->select_provider(providers, analysis.type_);
+        return load_balancer_->select_provider(providers, analysis.type_, scores);
     }
 
     // Fallback to weighted selection based on performance metrics
@@ -467,7 +592,8 @@ std::string RoutingLogic::select_balanced(const std::vector<std::string>& provid
     double best_score = -1.0;
 
     for (const auto& provider : providers) {
-        double score = calculate_provider_score(provider, analysis.required_capabilities_, RoutingPriority::BALANCED);
+        double score = calculate_provider_score(provider, analysis.required_capabilities_, RoutingPriority::BALANCED,
+                                                scores);
         if (score > best_score) {
             best_score = score;
             best_provider = provider;
@@ -519,89 +645,76 @@ RequestAnalysis RoutingLogic::analyze_request(const core::Request& request) {
     RequestAnalysis analysis;
 
     try {
-        // Extract messages from request data
-        nlohmann::json messages;
-        if (request.data.contains("messages")) {
-            messages = request.data["messages"];
-        } else if (request.data.contains("prompt")) {
-            // Handle single prompt format
-            messages = nlohmann::json::array({{
-                {"role", "user"},
-                {"content", request.data["prompt"]}
-            }});
-        } else if (request.data.contains("content")) {
-            // Handle single content format
-            messages = nlohmann::json::array({{
-                {"role", "user"},
-                {"content", request.data["content"]}
-            }});
-        }
-
-        // Analyze content
-        std::string content_text;
-        bool has_images = false;
+        std::shared_ptr<const KeywordMatcher> classifier = classifier_.load(std::memory_order_acquire);
+        ContentScan scan(*classifier);
         bool requires_tools = false;
         bool requires_streaming = false;
         bool requires_json_mode = false;
         bool requires_function_calling = false;
 
-        // Extract and analyze content
-        for (const auto& message : messages) {
-            if (message.contains("content")) {
-                const auto& content = message["content"];
-
-                if (content.is_string()) {
-                    content_text += content.get<std::string>() + " ";
-                } else if (content.is_array()) {
-                    // Handle multimodal content
-                    for (const auto& content_item : content) {
-                        if (content_item.contains("type")) {
-                            std::string type = content_item["type"];
-                            if (type == "text" && content_item.contains("text")) {
-                                content_text += content_item["text"].get<std::string>() + " ";
-                            } else if (type == "image") {
-                                has_images = true;
-                            }
-                        }
+        // Walk the request in place; nothing is copied or re-serialized
+        const nlohmann::json& data = request.data;
+        if (auto messages = data.find("messages"); messages != data.end()) {
+            if (messages->is_array()) {
+                for (const auto& message : *messages) {
+                    if (!message.is_object()) {
+                        continue;
+                    }
+                    if (auto content = message.find("content"); content != message.end()) {
+                        scan.visit_content(*content);
                     }
-                }
-            }
 
-            // Check for function/tool calls
-            if (message.contains("tool_calls") || message.contains("function_call")) {
-                requires_function_calling = true;
+                    // Check for function/tool calls
+                    if (message.contains("tool_calls") || message.contains("function_call")) {
+                        requires_function_calling = true;
+                        requires_tools = true;
+                    } else if (message.contains("tool_call_id")) {
+                        requires_tools = true;
+                    }
+                }
             }
+        } else if (auto prompt = data.find("prompt"); prompt != data.end()) {
+            // Handle single prompt format
+            scan.visit_content(*prompt);
+        } else if (auto content = data.find("content"); content != data.end()) {
+            // Handle single content format
+            scan.visit_content(*content);
+        }
 
-            // Check for tool use in the content
-            std::string message_str = message.dump();
-            if (message_str.find("tool_call") != std::string::npos ||
-                message_str.find("function_call") != std::string::npos) {
+        // Tool definitions offered to the model
+        for (const char* key : {"tools", "functions"}) {
+            auto tools = data.find(key);
+            if (tools != data.end() && tools->is_array() && !tools->empty()) {
                 requires_tools = true;
             }
         }
 
+        uint32_t matched = scan.scanner.finish();
+        if (scan.has_tool_blocks || (matched & CATEGORY_TOOL_MARKER)) {
+            requires_tools = true;
+        }
+
         // Analyze request parameters
-        if (request.data.contains("stream")) {
-            requires_streaming = request.data["stream"].get<bool>();
+        if (auto stream = data.find("stream"); stream != data.end() && stream->is_boolean()) {
+            requires_streaming = stream->get<bool>();
         }
 
-        if (request.data.contains("response_format")) {
-            const auto& format = request.data["response_format"];
-            if (format.contains("type") && format["type"] == "json") {
+        if (auto format = data.find("response_format"); format != data.end() && format->is_object()) {
+            if (const std::string* type = string_field(*format, "type"); type && *type == "json") {
                 requires_json_mode = true;
             }
         }
 
         // Determine request type
-        if (has_images) {
+        if (scan.has_images) {
             analysis.type_ = RequestType::MULTIMODAL;
-        } else if (is_thinking_request(content_text)) {
+        } else if (matched & CATEGORY_THINKING) {
             analysis.type_ = RequestType::THINKING;
         } else if (requires_tools || requires_function_calling) {
             analysis.type_ = RequestType::TOOLS;
         } else if (requires_streaming) {
             analysis.type_ = RequestType::STREAMING;
-        } else if (content_text.length() > 10000) { // Long content threshold
+        } else if (scan.text_length > LONG_CONTEXT_THRESHOLD) {
             analysis.type_ = RequestType::LONG_CONTEXT;
         } else {
             analysis.type_ = RequestType::STANDARD;
@@ -614,7 +727,7 @@ RequestAnalysis RoutingLogic::analyze_request(const core::Request& request) {
             caps = caps | ProviderCapability::THINKING;
         }
 
-        if (has_images || analysis.type_ == RequestType::MULTIMODAL) {
+        if (scan.has_images || analysis.type_ == RequestType::MULTIMODAL) {
             caps = caps | ProviderCapability::VISION;
         }
 
@@ -639,9 +752,10 @@ RequestAnalysis RoutingLogic::analyze_request(const core::Request& request) {
         analysis.requires_tools_ = requires_tools;
         analysis.requires_json_mode_ = requires_json_mode;
         analysis.requires_function_calling_ = requires_function_calling;
+        analysis.content_length_ = scan.text_length;
 
         // Estimate tokens (rough estimate: 1 token ≈ 4 characters)
-        analysis.estimated_tokens_ = std::max(100, static_cast<int>(content_text.length() / 4));
+        analysis.estimated_tokens_ = std::max(100, static_cast<int>(scan.text_length / 4));
 
         // Set sensitivity values based on request type
         if (analysis.type_ == RequestType::THINKING || analysis.type_ == RequestType::LONG_CONTEXT) {
@@ -679,49 +793,15 @@ RequestAnalysis RoutingLogic::analyze_request(const core::Request& request) {
 }
 
 bool RoutingLogic::is_thinking_request(const std::string& content) {
-    std::string lower_content = content;
-    std::transform(lower_content.begin(), lower_content.end(), lower_content.begin(), ::tolower);
-
-    // Check for thinking keywords
-    for (const auto& keyword : thinking_keywords_) {
-        if (lower_content.find(keyword) != std::string::npos) {
-            return true;
-        }
-    }
-
-    // Additional patterns for thinking requests
-    std::vector<std::regex> thinking_patterns = {
-        std::regex(R"(\bstep\s+by\s+step\b)"),
-        std::regex(R"(\bbreak\s+down\b)"),
-        std::regex(R"(\bexplain\s+your\s+reasoning\b)"),
-        std::regex(R"(\bthink\s+aloud\b)"),
-        std::regex(R"(\bshow\s+your\s+work\b)"),
-        std::regex(R"(\bwalk\s+me\s+through\b)"),
-        std::regex(R"(\bhow\s+would\s+you\s+approach\b)"),
-        std::regex(R"(\bwhat\s+are\s+the\s+steps\b)")
-    };
-
-    for (const auto& pattern : thinking_patterns) {
-        if (std::regex_search(lower_content, pattern)) {
-            return true;
-        }
-    }
-
-    return false;
+    return (classifier_.load(std::memory_order_acquire)->scan(content) & CATEGORY_THINKING) != 0;
 }
 
 bool RoutingLogic::has_vision_content(const nlohmann::json& content) {
     try {
         if (content.is_string()) {
-            std::string str = content.get<std::string>();
-            std::transform(str.begin(), str.end(), str.begin(), ::tolower);
-
             // Check for vision keywords
-            for (const auto& keyword : vision_keywords_) {
-                if (str.find(keyword) != std::string::npos) {
-                    return true;
-                }
-            }
+            const auto& str = content.get_ref<const std::string&>();
+            return (classifier_.load(std::memory_order_acquire)->scan(str) & CATEGORY_VISION) != 0;
         } else if (content.is_array()) {
             // Check for image content in multimodal messages
             for (const auto& item : content) {
@@ -809,10 +889,29 @@ bool RoutingLogic::requires_streaming(const nlohmann::json& data) {
 
 void RoutingLogic::set_thinking_keywords(const std::vector<std::string>& keywords) {
     thinking_keywords_ = keywords;
+    rebuild_classifier();
 }
 
 void RoutingLogic::set_vision_keywords(const std::vector<std::string>& keywords) {
     vision_keywords_ = keywords;
+    rebuild_classifier();
+}
+
+void RoutingLogic::rebuild_classifier() {
+    std::vector<KeywordMatcher::Pattern> patterns;
+    for (const auto& keyword : thinking_keywords_) {
+        patterns.push_back({keyword, CATEGORY_THINKING, false});
+    }
+    for (const char* phrase : THINKING_PHRASES) {
+        patterns.push_back({phrase, CATEGORY_THINKING, true});
+    }
+    for (const auto& keyword : vision_keywords_) {
+        patterns.push_back({keyword, CATEGORY_VISION, false});
+    }
+    for (const char* marker : TOOL_MARKERS) {
+        patterns.push_back({marker, CATEGORY_TOOL_MARKER, false});
+    }
+    classifier_.store(std::make_shared<const KeywordMatcher>(patterns), std::memory_order_release);
 }
 
 // ============================================================================
@@ -822,12 +921,19 @@ void RoutingLogic::set_vision_keywords(const std::vector<std::string>& keywords)
 std::vector<std::string> RoutingLogic::filter_by_capability(
     const std::vector<std::string>& providers,
     ProviderCapability capability) {
+    return filter_by_capability(providers, capability, *health_monitor_->get_score_snapshot());
+}
+
+std::vector<std::string> RoutingLogic::filter_by_capability(
+    const std::vector<std::string>& providers,
+    ProviderCapability capability,
+    const ProviderScoreTable& scores) {
 
     std::vector<std::string> filtered;
 
     for (const auto& provider : providers) {
-        ProviderHealth* health = health_monitor_->get_provider_health(provider);
-        if (health && health->has_capability(capability)) {
+        const ProviderScore* score = scores.find(provider);
+        if (score && score->has_capability(capability)) {
             filtered.push_back(provider);
         }
     }
@@ -838,6 +944,13 @@ std::vector<std::string> RoutingLogic::filter_by_capability(
 std::vector<std::string> RoutingLogic::filter_by_request_type(
     const std::vector<std::string>& providers,
     RequestType request_type) {
+    return filter_by_request_type(providers, request_type, *health_monitor_->get_score_snapshot());
+}
+
+std::vector<std::string> RoutingLogic::filter_by_request_type(
+    const std::vector<std::string>& providers,
+    RequestType request_type,
+    const ProviderScoreTable& scores) {
 
     ProviderCapability required_caps = static_cast<ProviderCapability>(0);
 
@@ -860,21 +973,22 @@ std::vector<std::string> RoutingLogic::filter_by_request_type(
             return providers;
     }
 
-    return filter_by_capability(providers, required_caps);
+    return filter_by_capability(providers, required_caps, scores);
 }
 
 std::vector<std::string> RoutingLogic::filter_by_capacity(
     const std::vector<std::string>& providers,
     int additional_requests) {
 
+    auto scores = health_monitor_->get_score_snapshot();
     std::vector<std::string> filtered;
 
     for (const auto& provider : providers) {
-        ProviderHealth* health = health_monitor_->get_provider_health(provider);
-        if (health && health->can_accept_requests()) {
+        const ProviderScore* score = scores->find(provider);
+        if (score && score->can_accept_requests()) {
             // Check if provider has capacity
-            int current_requests = health->metrics_.requests_per_minute_;
-            int max_requests = health->metrics_.max_requests_per_minute_;
+            int current_requests = score->requests_per_minute_;
+            int max_requests = score->max_requests_per_minute_;
 
             if (current_requests + additional_requests <= max_requests) {
                 filtered.push_back(provider);
@@ -937,53 +1051,61 @@ ProviderCapability RoutingLogic::get_required_capabilities(const RequestAnalysis
 }
 
 std::vector<std::string> RoutingLogic::get_capable_providers(ProviderCapability capabilities) {
-    std::vector<std::string> all_providers = health_monitor_->get_healthy_providers();
-    return filter_by_capability(all_providers, capabilities);
+    auto scores = health_monitor_->get_score_snapshot();
+    std::vector<std::string> capable_providers;
+    for (const auto& [name, score] : scores->scores_) {
+        if (score.is_healthy() && score.can_accept_requests() && score.has_capability(capabilities)) {
+            capable_providers.push_back(name);
+        }
+    }
+    return capable_providers;
 }
 
 double RoutingLogic::calculate_provider_score(const std::string& provider,
                                              ProviderCapability /* capabilities */,
-                                             RoutingPriority priority) {
-    ProviderHealth* health = health_monitor_->get_provider_health(provider);
-    if (!health || !health->is_healthy()) {
+                                             RoutingPriority priority,
+                                             const ProviderScoreTable& scores) {
+    const ProviderScore* provider_score = scores.find(provider);
+    if (!provider_score || !provider_score->is_healthy()) {
         return 0.0;
     }
+    const ProviderScore& metrics = *provider_score;
 
     double score = 0.0;
 
     // Base score from provider health
-    score += health->metrics_.success_rate_ * 0.4;  // 40% weight for success rate
-    score += health->metrics_.performance_score_ * 0.3;  // 30% weight for performance
+    score += metrics.success_rate_ * 0.4;  // 40% weight for success rate
+    score += metrics.performance_score_ * 0.3;  // 30% weight for performance
 
     // Priority-specific scoring
     switch (priority) {
         case RoutingPriority::COST:
             // Lower cost = higher score
-            if (health->metrics_.cost_per_output_token_ > 0) {
-                score += (1.0 / health->metrics_.cost_per_output_token_) * 0.3;
+            if (metrics.cost_per_output_token_ > 0) {
+                score += (1.0 / metrics.cost_per_output_token_) * 0.3;
             }
             break;
 
         case RoutingPriority::PERFORMANCE:
             // Lower response time = higher score
-            if (health->metrics_.avg_response_time_ms_ > 0) {
-                score += (1000.0 / health->metrics_.avg_response_time_ms_) * 0.3;
+            if (metrics.avg_response_time_ms_ > 0) {
+                score += (1000.0 / metrics.avg_response_time_ms_) * 0.3;
             }
             break;
 
         case RoutingPriority::RELIABILITY:
             // Higher success rate = higher score
-            score += health->metrics_.success_rate_ * 0.3;
+            score += metrics.success_rate_ * 0.3;
             break;
 
         case RoutingPriority::BALANCED:
         default:
             // Balanced scoring
-            if (health->metrics_.cost_per_output_token_ > 0) {
-                score += (1.0 / health->metrics_.cost_per_output_token_) * 0.15;
+            if (metrics.cost_per_output_token_ > 0) {
+                score += (1.0 / metrics.cost_per_output_token_) * 0.15;
             }
-            if (health->metrics_.avg_response_time_ms_ > 0) {
-                score += (1000.0 / health->metrics_.avg_response_time_ms_) * 0.15;
+            if (metrics.avg_response_time_ms_ > 0) {
+                score += (1000.0 / metrics.avg_response_time_ms_) * 0.15;
             }
             break;
     }
@@ -993,20 +1115,20 @@ double RoutingLogic::calculate_provider_score(const std::string& provider,
 
 std::string RoutingLogic::generate_reasoning(const RoutingDecision& decision,
                                             const RequestAnalysis& analysis,
-                                            const std::vector<std::string>& candidates) {
+                                            const std::vector<std::string>& candidates,
+                                            const ProviderScoreTable& scores) {
     std::ostringstream reasoning;
 
     reasoning << "Selected provider '" << decision.selected_provider_
               << "' based on " << routing_priority_to_string(decision.priority_used_)
               << " priority. ";
 
-    ProviderHealth* health = health_monitor_->get_provider_health(decision.selected_provider_);
-    if (health) {
-        reasoning << "Provider health: " << health_status_to_string(health->status_.load())
+    if (const ProviderScore* score = scores.find(decision.selected_provider_)) {
+        reasoning << "Provider health: " << health_status_to_string(score->status_)
                   << ", Success rate: " << std::fixed << std::setprecision(2)
-                  << (health->metrics_.success_rate_ * 100) << "%, "
+                  << (score->success_rate_ * 100) << "%, "
                   << "Avg response time: " << std::setprecision(0)
-                  << health->metrics_.avg_response_time_ms_ << "ms. ";
+                  << score->avg_response_time_ms_ << "ms. ";
     }
 
     reasoning << "Request type: " << request_type_to_string(analysis.type_) << ". ";
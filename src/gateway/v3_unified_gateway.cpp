@@ -1,3 +1,4 @@
+#include "aimux/gateway/async_request_pipeline.hpp"
 #include "aimux/gateway/gateway_manager.hpp"
 #include "aimux/logging/logger.hpp"
 #include <crow.h>
@@ -14,6 +15,8 @@ namespace gateway {
  *
  * This implements the V3 architecture where a single /anthropic endpoint
  * intelligently routes requests to the best provider based on content analysis.
+ * Requests are routed through an AsyncRequestPipeline that enforces
+ * max_concurrent_requests and sheds load once its queue is full.
  */
 class V3UnifiedGateway {
 public:
@@ -24,6 +27,8 @@ public:
         bool enable_metrics = true;
         bool enable_cors = true;
         int max_concurrent_requests = 100;
+        int max_queued_requests = 1000;
+        size_t worker_threads = 4;
         std::chrono::seconds request_timeout{300};
 
         nlohmann::json to_json() const;
@@ -55,6 +60,7 @@ private:
 
     // Core components
     std::unique_ptr<GatewayManager> gateway_manager_;
+    std::unique_ptr<AsyncRequestPipeline> pipeline_;    // Declared after gateway_manager_: drained first
     std::unique_ptr<crow::SimpleApp> app_;
     std::thread server_thread_;
 
@@ -74,15 +80,17 @@ private:
     void setup_cors();
 
     // Route handlers
-    crow::response handle_anthropic_request(const crow::request& req);
+    void handle_anthropic_request(const crow::request& req, crow::response& res);
+    void handle_openai_request(const crow::request& req, crow::response& res);
+    crow::response handle_models(const std::string& format);
     crow::response handle_health_check(const crow::request& req);
     crow::response handle_metrics(const crow::request& req);
     crow::response handle_providers(const crow::request& req);
     crow::response handle_config(const crow::request& req);
 
     // Request processing
-    crow::response process_request(const crow::request& req);
-    core::Response create_aimux_request(const nlohmann::json& anthropic_request);
+    void process_request(const crow::request& req, crow::response& res);
+    core::Request create_aimux_request(const nlohmann::json& anthropic_request);
     crow::response convert_to_anthropic_response(const core::Response& aimux_response, const RequestTracker& tracker);
 
     // Utilities
@@ -109,6 +117,8 @@ nlohmann::json V3UnifiedGateway::Config::to_json() const {
     j["enable_metrics"] = enable_metrics;
     j["enable_cors"] = enable_cors;
     j["max_concurrent_requests"] = max_concurrent_requests;
+    j["max_queued_requests"] = max_queued_requests;
+    j["worker_threads"] = worker_threads;
     j["request_timeout"] = request_timeout.count();
     return j;
 }
@@ -121,6 +131,8 @@ V3UnifiedGateway::Config V3UnifiedGateway::Config::from_json(const nlohmann::jso
     config.enable_metrics = j.value("enable_metrics", true);
     config.enable_cors = j.value("enable_cors", true);
     config.max_concurrent_requests = j.value("max_concurrent_requests", 100);
+    config.max_queued_requests = j.value("max_queued_requests", 1000);
+    config.worker_threads = j.value("worker_threads", static_cast<size_t>(4));
     config.request_timeout = std::chrono::seconds(j.value("request_timeout", 300));
     return config;
 }
@@ -145,11 +157,26 @@ V3UnifiedGateway::V3UnifiedGateway(const Config& config)
         throw;
     }
 
+    // Upstream calls complete on the pipeline, not on Crow's threads
+    AsyncPipelineConfig pipeline_config;
+    pipeline_config.worker_threads_ = config_.worker_threads;
+    pipeline_config.max_concurrent_requests_ = config_.max_concurrent_requests;
+    pipeline_config.max_queue_depth_ = config_.max_queued_requests;
+    pipeline_config.max_queue_wait_ = std::chrono::duration_cast<std::chrono::milliseconds>(config_.request_timeout);
+    pipeline_ = std::make_unique<AsyncRequestPipeline>(
+        [this](const core::Request& request, AsyncRequestPipeline::Completion done) {
+            gateway_manager_->route_request_async(request, std::move(done), [this](std::function<void()> task) {
+                pipeline_->post(std::move(task));
+            });
+        },
+        pipeline_config);
+
     setup_routes();
 }
 
 V3UnifiedGateway::~V3UnifiedGateway() {
     stop();
+    pipeline_->stop();
 }
 
 bool V3UnifiedGateway::start() {
@@ -204,6 +231,12 @@ void V3UnifiedGateway::stop() {
 
 void V3UnifiedGateway::update_config(const Config& config) {
     config_ = config;
+
+    AsyncPipelineConfig pipeline_config;
+    pipeline_config.max_concurrent_requests_ = config_.max_concurrent_requests;
+    pipeline_config.max_queue_depth_ = config_.max_queued_requests;
+    pipeline_config.max_queue_wait_ = std::chrono::duration_cast<std::chrono::milliseconds>(config_.request_timeout);
+    pipeline_->update_limits(pipeline_config);
     aimux::info("V3UnifiedGateway: Configuration updated");
 }
 
@@ -242,6 +275,7 @@ nlohmann::json V3UnifiedGateway::get_metrics() const {
             std::chrono::steady_clock::now() - std::chrono::steady_clock::time_point{}).count()},
         {"max_concurrent_requests", config_.max_concurrent_requests}
     };
+    metrics["pipeline"] = pipeline_->to_json();
 
     return metrics;
 }
@@ -251,12 +285,12 @@ nlohmann::json V3UnifiedGateway::get_metrics() const {
 // ============================================================================
 
 void V3UnifiedGateway::setup_routes() {
-    CROW_ROUTE(*app_, "/anthropic").methods("POST"_method)([this](const crow::request& req) {
-        return handle_anthropic_request(req);
+    CROW_ROUTE(*app_, "/anthropic").methods("POST"_method)([this](const crow::request& req, crow::response& res) {
+        handle_anthropic_request(req, res);
     });
 
-    CROW_ROUTE(*app_, "/anthropic/v1/messages").methods("POST"_method)([this](const crow::request& req) {
-        return handle_anthropic_request(req);
+    CROW_ROUTE(*app_, "/anthropic/v1/messages").methods("POST"_method)([this](const crow::request& req, crow::response& res) {
+        handle_anthropic_request(req, res);
     });
 
     CROW_ROUTE(*app_, "/anthropic/v1/models").methods("GET"_method)([this](const crow::request& req) {
@@ -264,8 +298,8 @@ void V3UnifiedGateway::setup_routes() {
     });
 
     // OpenAI compatibility endpoint
-    CROW_ROUTE(*app_, "/v1/chat/completions").methods("POST"_method)([this](const crow::request& req) {
-        return handle_openai_request(req);
+    CROW_ROUTE(*app_, "/v1/chat/completions").methods("POST"_method)([this](const crow::request& req, crow::response& res) {
+        handle_openai_request(req, res);
     });
 
     CROW_ROUTE(*app_, "/v1/models").methods("GET"_method)([this](const crow::request& req) {
@@ -316,14 +350,14 @@ void V3UnifiedGateway::setup_cors() {
 // Route Handlers
 // ============================================================================
 
-crow::response V3UnifiedGateway::handle_anthropic_request(const crow::request& req) {
-    return process_request(req);
+void V3UnifiedGateway::handle_anthropic_request(const crow::request& req, crow::response& res) {
+    process_request(req, res);
 }
 
-crow::response V3UnifiedGateway::handle_openai_request(const crow::request& req) {
+void V3UnifiedGateway::handle_openai_request(const crow::request& req, crow::response& res) {
     // For now, treat OpenAI requests the same as Anthropic requests
     // In the future, we could add OpenAI-specific transformations
-    return process_request(req);
+    process_request(req, res);
 }
 
 crow::response V3UnifiedGateway::handle_health_check(const crow::request& req) {
@@ -463,46 +497,56 @@ crow::response V3UnifiedGateway::handle_models(const std::string& format) {
 // Request Processing
 // ============================================================================
 
-crow::response V3UnifiedGateway::process_request(const crow::request& req) {
+void V3UnifiedGateway::process_request(const crow::request& req, crow::response& res) {
     auto tracker = create_tracker(req);
 
+    // Every exit funnels through here so the tracker never outlives its response
+    auto finish = [this, &res, request_id = tracker.request_id](crow::response response) {
+        {
+            std::lock_guard<std::mutex> lock(requests_mutex_);
+            active_requests_.erase(request_id);
+        }
+        res = std::move(response);
+        res.end();
+    };
+
     try {
         // Parse request body
         nlohmann::json request_json;
         try {
             request_json = nlohmann::json::parse(req.body);
         } catch (const nlohmann::json::parse_error& e) {
-            return crow::response(400, create_error_response("INVALID_JSON", e.what()).dump());
+            finish(crow::response(400, create_error_response("INVALID_JSON", e.what()).dump()));
+            return;
         }
 
         // Validate request
         if (!validate_anthropic_request(request_json)) {
-            return crow::response(400, create_error_response("INVALID_REQUEST", "Invalid request format").dump());
+            finish(crow::response(400, create_error_response("INVALID_REQUEST", "Invalid request format").dump()));
+            return;
         }
 
-        // Convert to aimux format
-        core::Request aimux_request = create_aimux_request(request_json);
-
-        // Route through gateway manager
-        core::Response response;
-        if (gateway_manager_) {
-            response = gateway_manager_->route_request(aimux_request);
-        } else {
-            response.success = false;
-            response.error_message = "Gateway manager not available";
-            response.status_code = 503;
+        // Route through the pipeline and convert back to Anthropic format on completion
+        bool accepted = pipeline_->submit(create_aimux_request(request_json),
+            [this, finish, tracker](core::Response response) {
+                try {
+                    finish(convert_to_anthropic_response(response, tracker));
+                } catch (const std::exception& e) {
+                    aimux::error("Request processing failed: " + std::string(e.what()));
+                    finish(crow::response(500, create_error_response("INTERNAL_ERROR", e.what()).dump()));
+                }
+            });
+
+        if (!accepted) {
+            crow::response overloaded(503, create_error_response("OVERLOADED",
+                "More than " + std::to_string(config_.max_concurrent_requests) + " requests in progress").dump());
+            overloaded.set_header("Retry-After", "1");
+            finish(std::move(overloaded));
         }
 
-        // Convert back to Anthropic format
-        return convert_to_anthropic_response(response, tracker);
-
     } catch (const std::exception& e) {
         aimux::error("Request processing failed: " + std::string(e.what()));
-        return crow::response(500, create_error_response("INTERNAL_ERROR", e.what()).dump());
-    } finally {
-        // Clean up request tracker
-        std::lock_guard<std::mutex> lock(requests_mutex_);
-        active_requests_.erase(tracker.request_id);
+        finish(crow::response(500, create_error_response("INTERNAL_ERROR", e.what()).dump()));
     }
 }
 
@@ -531,20 +575,28 @@ crow::response V3UnifiedGateway::convert_to_anthropic_response(const core::Respo
         return crow::response(status_code, error_response.dump());
     }
 
-    try {
-        // Parse provider response and convert to Anthropic format
-        nlohmann::json response_data = nlohmann::json::parse(aimux_response.data);
+    // Reuse the parse made by earlier stages (prettifier, cache) if there was one
+    const nlohmann::json* document = aimux_response.json();
+    if (!document || !document->is_object()) {
+        aimux::error("Failed to parse provider response");
+        return crow::response(500, create_error_response("RESPONSE_PARSE_ERROR", "Invalid response from provider").dump());
+    }
 
-        // Add metadata
-        response_data["id"] = tracker.request_id;
-        response_data["model"] = aimux_response.provider_name;
+    auto has_string = [document](const char* key, const std::string& expected) {
+        auto it = document->find(key);
+        return it != document->end() && it->is_string() && it->get_ref<const std::string&>() == expected;
+    };
+    if (has_string("id", tracker.request_id) && has_string("model", aimux_response.provider_name)) {
+        // Nothing to change; send the original bytes
+        return crow::response(status_code, aimux_response.data);
+    }
 
-        return crow::response(status_code, response_data.dump());
+    // Add metadata
+    nlohmann::json response_data = *document;
+    response_data["id"] = tracker.request_id;
+    response_data["model"] = aimux_response.provider_name;
 
-    } catch (const nlohmann::json::parse_error& e) {
-        aimux::error("Failed to parse provider response: " + std::string(e.what()));
-        return crow::response(500, create_error_response("RESPONSE_PARSE_ERROR", "Invalid response from provider").dump());
-    }
+    return crow::response(status_code, core::dump_json(response_data));
 }
 
 // ============================================================================
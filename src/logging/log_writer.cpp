@@ -0,0 +1,518 @@
+#include "aimux/logging/log_writer.hpp"
+#include "aimux/logging/logger.hpp"
+#include <algorithm>
+#include <cerrno>
+#include <cstdio>
+#include <cstdlib>
+#include <ctime>
+#include <unordered_map>
+#include <vector>
+
+#include <fcntl.h>
+#include <limits.h>
+#include <sys/stat.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
+namespace aimux {
+namespace logging {
+
+namespace {
+
+#ifndef IOV_MAX
+constexpr int IOV_MAX = 1024;
+#endif
+
+const char* level_name(LogLevel level) {
+    switch (level) {
+        case LogLevel::TRACE: return "TRACE";
+        case LogLevel::DEBUG: return "DEBUG";
+        case LogLevel::INFO: return "INFO";
+        case LogLevel::WARN: return "WARN";
+        case LogLevel::ERROR: return "ERROR";
+        case LogLevel::FATAL: return "FATAL";
+        default: return "UNKNOWN";
+    }
+}
+
+// ISO 8601 UTC with milliseconds; the date part is cached per thread and second
+std::string format_timestamp(std::chrono::system_clock::time_point time) {
+    thread_local std::time_t cached_second = -1;
+    thread_local char cached[32];
+
+    auto since_epoch = time.time_since_epoch();
+    auto seconds = std::chrono::duration_cast<std::chrono::seconds>(since_epoch);
+    auto ms = std::chrono::duration_cast<std::chrono::milliseconds>(since_epoch - seconds).count();
+    if (ms < 0) {
+        ms += 1000;
+        seconds -= std::chrono::seconds(1);
+    }
+
+    std::time_t second = static_cast<std::time_t>(seconds.count());
+    if (second != cached_second) {
+        std::tm utc{};
+        gmtime_r(&second, &utc);
+        std::strftime(cached, sizeof(cached), "%Y-%m-%dT%H:%M:%S", &utc);
+        cached_second = second;
+    }
+
+    std::string result(cached);
+    result += '.';
+    result += static_cast<char>('0' + ms / 100);
+    result += static_cast<char>('0' + ms / 10 % 10);
+    result += static_cast<char>('0' + ms % 10);
+    result += 'Z';
+    return result;
+}
+
+// Writes every iovec, continuing after partial writes and EINTR
+bool write_all(int fd, iovec* iov, int count, uint64_t& calls) {
+    while (count > 0) {
+        ssize_t written = ::writev(fd, iov, std::min(count, IOV_MAX));
+        calls++;
+        if (written < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            return false;
+        }
+        auto remaining = static_cast<size_t>(written);
+        while (count > 0 && remaining >= iov->iov_len) {
+            remaining -= iov->iov_len;
+            iov++;
+            count--;
+        }
+        if (count > 0) {
+            iov->iov_base = static_cast<char*>(iov->iov_base) + remaining;
+            iov->iov_len -= remaining;
+        }
+    }
+    return true;
+}
+
+} // namespace
+
+nlohmann::json LogWriterStats::to_json() const {
+    return {
+        {"records_submitted", records_submitted},
+        {"records_written", records_written},
+        {"records_dropped", records_dropped},
+        {"batches", batches},
+        {"write_calls", write_calls},
+        {"write_errors", write_errors},
+        {"rotations", rotations}
+    };
+}
+
+struct LogWriter::Impl {
+    struct Slot {
+        std::atomic<size_t> sequence{0};
+        LogRecord record;
+    };
+
+    struct OpenFile {
+        int fd = -1;
+        uint64_t size = 0;
+        dev_t device = 0;
+        ino_t inode = 0;
+    };
+
+    Options options;
+    size_t mask;
+    std::unique_ptr<Slot[]> slots;
+
+    // Ring positions: tail is claimed by producers, head is owned by the writer
+    alignas(64) std::atomic<size_t> tail{0};
+    alignas(64) std::atomic<size_t> head{0};
+
+    std::atomic<bool> sleeping{false};
+    std::atomic<bool> stopping{false};
+    std::atomic<bool> stopped{false};
+    std::mutex wake_mutex;
+    std::condition_variable wake_cv;
+    std::condition_variable flushed_cv;
+
+    // Records taken off the ring and finished (written or failed)
+    std::atomic<uint64_t> processed{0};
+
+    std::atomic<uint64_t> submitted{0};
+    std::atomic<uint64_t> written{0};
+    std::atomic<uint64_t> dropped{0};
+    std::atomic<uint64_t> batches{0};
+    std::atomic<uint64_t> write_calls{0};
+    std::atomic<uint64_t> write_errors{0};
+    std::atomic<uint64_t> rotations{0};
+
+    // Output state, used by the writer thread (or by stop() once it has exited)
+    std::mutex io_mutex;
+    std::unordered_map<std::string, OpenFile> files;
+    std::vector<LogRecord> batch;
+    std::vector<std::string> lines;
+    std::vector<iovec> iov;
+
+    std::thread writer;
+
+    explicit Impl(const Options& opts) : options(opts) {
+        size_t capacity = 2;
+        while (capacity < options.ring_capacity) {
+            capacity <<= 1;
+        }
+        mask = capacity - 1;
+        slots = std::make_unique<Slot[]>(capacity);
+        for (size_t i = 0; i < capacity; ++i) {
+            slots[i].sequence.store(i, std::memory_order_relaxed);
+        }
+        options.max_batch = std::max<size_t>(options.max_batch, 1);
+        batch.reserve(options.max_batch);
+        lines.resize(options.max_batch);
+    }
+
+    ~Impl() {
+        for (auto& [path, file] : files) {
+            if (file.fd >= 0) {
+                ::close(file.fd);
+            }
+        }
+    }
+
+    bool push(LogRecord&& record) {
+        size_t position = tail.load(std::memory_order_relaxed);
+        Slot* slot;
+        while (true) {
+            slot = &slots[position & mask];
+            size_t sequence = slot->sequence.load(std::memory_order_acquire);
+            auto diff = static_cast<std::ptrdiff_t>(sequence) - static_cast<std::ptrdiff_t>(position);
+            if (diff == 0) {
+                if (tail.compare_exchange_weak(position, position + 1)) {
+                    break;
+                }
+            } else if (diff < 0) {
+                return false;   // Full
+            } else {
+                position = tail.load(std::memory_order_relaxed);
+            }
+        }
+        slot->record = std::move(record);
+        slot->sequence.store(position + 1, std::memory_order_release);
+        return true;
+    }
+
+    bool pop(LogRecord& out) {
+        size_t position = head.load(std::memory_order_relaxed);
+        Slot& slot = slots[position & mask];
+        if (slot.sequence.load(std::memory_order_acquire) != position + 1) {
+            return false;
+        }
+        out = std::move(slot.record);
+        slot.record = LogRecord{};
+        slot.sequence.store(position + mask + 1, std::memory_order_release);
+        head.store(position + 1, std::memory_order_relaxed);
+        return true;
+    }
+
+    bool ring_empty() const {
+        return tail.load() == head.load(std::memory_order_relaxed);
+    }
+
+    void wake_writer() {
+        if (sleeping.load() && sleeping.exchange(false)) {
+            std::lock_guard<std::mutex> lock(wake_mutex);
+            wake_cv.notify_one();
+        }
+    }
+
+    void run() {
+        while (true) {
+            batch.clear();
+            LogRecord record;
+            while (batch.size() < options.max_batch && pop(record)) {
+                batch.push_back(std::move(record));
+            }
+
+            if (batch.empty()) {
+                if (stopping.load()) {
+                    break;
+                }
+                if (!ring_empty()) {
+                    std::this_thread::yield();   // A producer has claimed a slot but not filled it yet
+                    continue;
+                }
+                sleeping.store(true);
+                std::unique_lock<std::mutex> lock(wake_mutex);
+                if (ring_empty()) {
+                    wake_cv.wait_for(lock, options.idle_wait, [this] {
+                        return !sleeping.load() || stopping.load();
+                    });
+                }
+                sleeping.store(false);
+                continue;
+            }
+
+            {
+                std::lock_guard<std::mutex> lock(io_mutex);
+                write_batch();
+            }
+            processed.fetch_add(batch.size());
+            std::lock_guard<std::mutex> lock(wake_mutex);
+            flushed_cv.notify_all();
+        }
+    }
+
+    // Renders and writes batch: one writev round for the console and one per file
+    void write_batch() {
+        uint64_t calls = 0;
+        if (lines.size() < batch.size()) {
+            lines.resize(batch.size());
+        }
+        for (size_t i = 0; i < batch.size(); ++i) {
+            lines[i].clear();
+            LogWriter::format(batch[i], lines[i]);
+        }
+
+        std::vector<bool> ok(batch.size(), true);
+
+        // Console
+        iov.clear();
+        std::vector<size_t> members;
+        for (size_t i = 0; i < batch.size(); ++i) {
+            if (batch[i].target && batch[i].target->console) {
+                iov.push_back({lines[i].data(), lines[i].size()});
+                members.push_back(i);
+            }
+        }
+        if (!iov.empty() && !write_all(STDOUT_FILENO, iov.data(), static_cast<int>(iov.size()), calls)) {
+            for (size_t i : members) {
+                ok[i] = false;
+            }
+        }
+
+        // Files, grouped by path in order of first appearance; rotation may split a group
+        std::vector<bool> done(batch.size(), false);
+        for (size_t first = 0; first < batch.size(); ++first) {
+            if (done[first] || !batch[first].target || batch[first].target->log_file.empty()) {
+                continue;
+            }
+            const std::string& path = batch[first].target->log_file;
+            members.clear();
+            for (size_t i = first; i < batch.size(); ++i) {
+                if (!done[i] && batch[i].target && batch[i].target->log_file == path) {
+                    done[i] = true;
+                    members.push_back(i);
+                }
+            }
+
+            size_t start = 0;
+            while (start < members.size()) {
+                OpenFile* file = open_file(path, lines[members[start]].size());
+                size_t end = start;
+                uint64_t bytes = 0;
+                iov.clear();
+                while (file && end < members.size()) {
+                    std::string& line = lines[members[end]];
+                    if (end > start && options.max_file_bytes > 0 &&
+                        file->size + bytes + line.size() > options.max_file_bytes) {
+                        break;
+                    }
+                    iov.push_back({line.data(), line.size()});
+                    bytes += line.size();
+                    end++;
+                }
+
+                if (!file || !write_all(file->fd, iov.data(), static_cast<int>(iov.size()), calls)) {
+                    if (file) {
+                        ::close(file->fd);   // Reopened for the next batch
+                        file->fd = -1;
+                    }
+                    for (size_t k = start; k < members.size(); ++k) {
+                        ok[members[k]] = false;
+                    }
+                    break;
+                }
+                file->size += bytes;
+                start = end;
+            }
+        }
+
+        uint64_t failed = static_cast<uint64_t>(std::count(ok.begin(), ok.end(), false));
+        written.fetch_add(batch.size() - failed, std::memory_order_relaxed);
+        write_errors.fetch_add(failed, std::memory_order_relaxed);
+        write_calls.fetch_add(calls, std::memory_order_relaxed);
+        batches.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    // Open (or rotate) @p path so that @p incoming more bytes fit
+    OpenFile* open_file(const std::string& path, uint64_t incoming) {
+        OpenFile& file = files[path];
+        struct stat st;
+
+        // Reopen when the file was moved or deleted behind our back (e.g. by logrotate)
+        if (file.fd >= 0 && (::stat(path.c_str(), &st) != 0 || st.st_ino != file.inode || st.st_dev != file.device)) {
+            ::close(file.fd);
+            file.fd = -1;
+        }
+        if (file.fd >= 0 && options.max_file_bytes > 0 && file.size > 0 &&
+            file.size + incoming > options.max_file_bytes) {
+            ::close(file.fd);
+            file.fd = -1;
+            rotate(path);
+        }
+        if (file.fd < 0) {
+            file.fd = ::open(path.c_str(), O_WRONLY | O_CREAT | O_APPEND | O_CLOEXEC, 0644);
+            if (file.fd < 0) {
+                return nullptr;
+            }
+            if (::fstat(file.fd, &st) == 0) {
+                file.size = static_cast<uint64_t>(st.st_size);
+                file.device = st.st_dev;
+                file.inode = st.st_ino;
+            } else {
+                file.size = 0;
+            }
+            if (options.max_file_bytes > 0 && file.size > 0 && file.size + incoming > options.max_file_bytes) {
+                return open_file(path, incoming);   // Left over from an earlier run
+            }
+        }
+        return &file;
+    }
+
+    void rotate(const std::string& path) {
+        if (options.max_files == 0) {
+            ::unlink(path.c_str());
+        } else {
+            for (unsigned i = options.max_files; i > 1; --i) {
+                std::string from = path + "." + std::to_string(i - 1);
+                std::string to = path + "." + std::to_string(i);
+                ::rename(from.c_str(), to.c_str());
+            }
+            ::rename(path.c_str(), (path + ".1").c_str());
+        }
+        rotations.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    // Writes whatever is left on the ring on the calling thread
+    void drain() {
+        std::lock_guard<std::mutex> lock(io_mutex);
+        while (true) {
+            batch.clear();
+            LogRecord record;
+            while (batch.size() < options.max_batch && pop(record)) {
+                batch.push_back(std::move(record));
+            }
+            if (batch.empty()) {
+                return;
+            }
+            write_batch();
+            processed.fetch_add(batch.size());
+        }
+    }
+};
+
+LogWriter& LogWriter::instance() {
+    // Never destroyed, so loggers used during static destruction stay safe
+    static LogWriter* writer = [] {
+        auto* created = new LogWriter(Options{});
+        std::atexit([] { LogWriter::instance().stop(); });
+        return created;
+    }();
+    return *writer;
+}
+
+LogWriter::LogWriter(const Options& options)
+    : pImpl(std::make_unique<Impl>(options)) {
+    pImpl->writer = std::thread([this] { pImpl->run(); });
+}
+
+LogWriter::~LogWriter() {
+    stop();
+}
+
+bool LogWriter::submit(LogRecord&& record) {
+    if (pImpl->stopped.load(std::memory_order_acquire)) {
+        // Writer thread is gone (process exit); write inline
+        std::lock_guard<std::mutex> lock(pImpl->io_mutex);
+        pImpl->batch.clear();
+        pImpl->batch.push_back(std::move(record));
+        pImpl->submitted.fetch_add(1, std::memory_order_relaxed);
+        pImpl->write_batch();
+        pImpl->processed.fetch_add(1);
+        return true;
+    }
+
+    if (!pImpl->push(std::move(record))) {
+        pImpl->dropped.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+    pImpl->submitted.fetch_add(1);
+    pImpl->wake_writer();
+    return true;
+}
+
+bool LogWriter::flush(std::chrono::milliseconds timeout) {
+    uint64_t target = pImpl->submitted.load();
+    if (pImpl->processed.load() >= target) {
+        return true;
+    }
+    pImpl->wake_writer();
+
+    std::unique_lock<std::mutex> lock(pImpl->wake_mutex);
+    return pImpl->flushed_cv.wait_for(lock, timeout, [this, target] {
+        return pImpl->processed.load() >= target || pImpl->stopped.load();
+    }) && pImpl->processed.load() >= target;
+}
+
+void LogWriter::stop() {
+    if (pImpl->stopping.exchange(true)) {
+        return;
+    }
+    {
+        std::lock_guard<std::mutex> lock(pImpl->wake_mutex);
+        pImpl->sleeping.store(false);
+        pImpl->wake_cv.notify_one();
+    }
+    if (pImpl->writer.joinable()) {
+        pImpl->writer.join();
+    }
+    pImpl->stopped.store(true, std::memory_order_release);
+    pImpl->drain();   // Records pushed while the writer was exiting
+
+    std::lock_guard<std::mutex> lock(pImpl->wake_mutex);
+    pImpl->flushed_cv.notify_all();
+}
+
+void LogWriter::format(const LogRecord& record, std::string& out) {
+    nlohmann::json entry;
+    entry["timestamp"] = format_timestamp(record.time);
+    entry["level"] = static_cast<int>(record.level);
+    entry["level_name"] = level_name(record.level);
+    entry["message"] = record.message;
+
+    if (record.target) {
+        entry["logger"] = record.target->logger_name;
+        for (const auto& [key, value] : record.target->default_fields.items()) {
+            entry[key] = value;
+        }
+    }
+
+    if (!record.data.empty()) {
+        entry["data"] = record.data;
+    }
+
+    // Invalid UTF-8 must not take the writer thread down
+    out += entry.dump(-1, ' ', false, nlohmann::json::error_handler_t::replace);
+    out += '\n';
+}
+
+LogWriterStats LogWriter::get_stats() const {
+    LogWriterStats stats;
+    stats.records_submitted = pImpl->submitted.load(std::memory_order_relaxed);
+    stats.records_written = pImpl->written.load(std::memory_order_relaxed);
+    stats.records_dropped = pImpl->dropped.load(std::memory_order_relaxed);
+    stats.batches = pImpl->batches.load(std::memory_order_relaxed);
+    stats.write_calls = pImpl->write_calls.load(std::memory_order_relaxed);
+    stats.write_errors = pImpl->write_errors.load(std::memory_order_relaxed);
+    stats.rotations = pImpl->rotations.load(std::memory_order_relaxed);
+    return stats;
+}
+
+} // namespace logging
+} // namespace aimux
@@ -1,8 +1,5 @@
 #include "aimux/logging/logger.hpp"
-#include <iostream>
-#include <fstream>
-#include <sstream>
-#include <iomanip>
+#include "aimux/logging/log_writer.hpp"
 #include <chrono>
 #include <thread>
 #include <mutex>
@@ -13,17 +10,21 @@ namespace logging {
 
 // Logger::Impl structure definition
 struct Logger::Impl {
-    std::string name;
-    std::string log_file;
-    LogLevel level;
-    bool console_enabled;
-    nlohmann::json default_fields;
-
-    Impl(const std::string& name, const std::string& log_file)
-        : name(name), level(LogLevel::INFO), console_enabled(true) {
-        if (!log_file.empty()) {
-            this->log_file = log_file;
-        }
+    // Settings are republished as an immutable target that queued records share
+    mutable std::mutex mutex;
+    LogTarget settings;
+    std::atomic<std::shared_ptr<const LogTarget>> target;
+    std::atomic<uint64_t> dropped{0};
+
+    Impl(const std::string& name, const std::string& log_file) {
+        settings.logger_name = name;
+        settings.log_file = log_file;
+        publish();
+    }
+
+    // Call with mutex held (or before the logger is shared)
+    void publish() {
+        target.store(std::make_shared<const LogTarget>(settings));
     }
 };
 
@@ -72,15 +73,25 @@ Logger::Logger(const std::string& name, const std::string& log_file)
 Logger::~Logger() = default;
 
 void Logger::set_level(LogLevel level) {
-    pImpl->level = level;
+    level_.store(level, std::memory_order_relaxed);
 }
 
 void Logger::set_console_enabled(bool enabled) {
-    pImpl->console_enabled = enabled;
+    std::lock_guard<std::mutex> lock(pImpl->mutex);
+    pImpl->settings.console = enabled;
+    pImpl->publish();
 }
 
 void Logger::add_default_field(const std::string& key, const nlohmann::json& value) {
-    pImpl->default_fields[key] = value;
+    std::lock_guard<std::mutex> lock(pImpl->mutex);
+    pImpl->settings.default_fields[key] = value;
+    pImpl->publish();
+}
+
+void Logger::remove_default_field(const std::string& key) {
+    std::lock_guard<std::mutex> lock(pImpl->mutex);
+    pImpl->settings.default_fields.erase(key);
+    pImpl->publish();
 }
 
 void Logger::trace(const std::string& message, const nlohmann::json& data) {
@@ -108,84 +119,38 @@ void Logger::fatal(const std::string& message, const nlohmann::json& data) {
 }
 
 nlohmann::json Logger::get_statistics() const {
+    auto target = pImpl->target.load();
     nlohmann::json stats;
-    stats["logger_name"] = pImpl->name;
-    stats["log_file"] = pImpl->log_file;
-    stats["level"] = static_cast<int>(pImpl->level);
-    stats["console_enabled"] = pImpl->console_enabled;
+    stats["logger_name"] = target->logger_name;
+    stats["log_file"] = target->log_file;
+    stats["level"] = static_cast<int>(level_.load(std::memory_order_relaxed));
+    stats["console_enabled"] = target->console;
+    stats["dropped_entries"] = pImpl->dropped.load(std::memory_order_relaxed);
+    stats["writer"] = LogWriter::instance().get_stats().to_json();
     return stats;
 }
 
 void Logger::flush() {
-    // For simple implementation, just flush stdout
-    if (pImpl->console_enabled) {
-        std::cout.flush();
-    }
+    LogWriter::instance().flush();
 }
 
 void Logger::log(LogLevel level, const std::string& message, const nlohmann::json& data) {
-    if (level < pImpl->level) {
+    if (!should_log(level)) {
         return;
     }
 
-    // Create log entry
-    nlohmann::json log_entry;
-    log_entry["timestamp"] = get_timestamp();
-    log_entry["level"] = static_cast<int>(level);
-    log_entry["level_name"] = level_to_string(level);
-    log_entry["message"] = message;
-    log_entry["logger"] = pImpl->name;
-
-    // Merge default fields
-    for (const auto& [key, value] : pImpl->default_fields.items()) {
-        log_entry[key] = value;
-    }
-
-    // Merge user data
-    if (!data.empty()) {
-        log_entry["data"] = data;
-    }
-
-    // Output log entry
-    std::string log_line = log_entry.dump();
-
-    if (pImpl->console_enabled) {
-        std::cout << log_line << std::endl;
+    // Formatting and I/O happen on the writer thread
+    LogRecord record{pImpl->target.load(), level, std::chrono::system_clock::now(), message, data};
+    if (!LogWriter::instance().submit(std::move(record))) {
+        pImpl->dropped.fetch_add(1, std::memory_order_relaxed);
+        return;
     }
 
-    if (!pImpl->log_file.empty()) {
-        std::ofstream file(pImpl->log_file, std::ios::app);
-        if (file.is_open()) {
-            file << log_line << std::endl;
-            file.close();
-        }
+    if (level == LogLevel::FATAL) {
+        LogWriter::instance().flush();
     }
 }
 
-std::string Logger::level_to_string(LogLevel level) const {
-    switch (level) {
-        case LogLevel::TRACE: return "TRACE";
-        case LogLevel::DEBUG: return "DEBUG";
-        case LogLevel::INFO: return "INFO";
-        case LogLevel::WARN: return "WARN";
-        case LogLevel::ERROR: return "ERROR";
-        case LogLevel::FATAL: return "FATAL";
-        default: return "UNKNOWN";
-    }
-}
-
-std::string Logger::get_timestamp() const {
-    auto now = std::chrono::system_clock::now();
-    auto time_t = std::chrono::system_clock::to_time_t(now);
-    auto ms = std::chrono::duration_cast<std::chrono::milliseconds>(
-        now.time_since_epoch()) % 1000;
-
-    std::stringstream ss;
-    ss << std::put_time(std::gmtime(&time_t), "%Y-%m-%dT%H:%M:%S");
-    ss << '.' << std::setfill('0') << std::setw(3) << ms.count() << 'Z';
-    return ss.str();
-}
-
 } // namespace logging
 } // namespace aimux
 
@@ -196,48 +161,52 @@ std::string Logger::get_timestamp() const {
 namespace aimux {
 
 // Get or create default logger
-static std::shared_ptr<logging::Logger> get_default_logger() {
+static const std::shared_ptr<logging::Logger>& get_default_logger() {
     static auto logger = logging::LoggerRegistry::get_logger("aimux_default");
     return logger;
 }
 
+logging::Logger& logging::default_logger() {
+    return *get_default_logger();
+}
+
 void debug(const std::string& message, const nlohmann::json& data) {
-    auto logger = get_default_logger();
+    const auto& logger = get_default_logger();
     if (logger) {
         logger->debug(message, data);
     }
 }
 
 void info(const std::string& message, const nlohmann::json& data) {
-    auto logger = get_default_logger();
+    const auto& logger = get_default_logger();
     if (logger) {
         logger->info(message, data);
     }
 }
 
 void warn(const std::string& message, const nlohmann::json& data) {
-    auto logger = get_default_logger();
+    const auto& logger = get_default_logger();
     if (logger) {
         logger->warn(message, data);
     }
 }
 
 void error(const std::string& message, const nlohmann::json& data) {
-    auto logger = get_default_logger();
+    const auto& logger = get_default_logger();
     if (logger) {
         logger->error(message, data);
     }
 }
 
 void fatal(const std::string& message, const nlohmann::json& data) {
-    auto logger = get_default_logger();
+    const auto& logger = get_default_logger();
     if (logger) {
         logger->fatal(message, data);
     }
 }
 
 void trace(const std::string& message, const nlohmann::json& data) {
-    auto logger = get_default_logger();
+    const auto& logger = get_default_logger();
     if (logger) {
         logger->trace(message, data);
     }
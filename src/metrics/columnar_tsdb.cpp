@@ -0,0 +1,1349 @@
+#include "aimux/metrics/columnar_tsdb.hpp"
+#include "aimux/metrics/gorilla_codec.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <limits>
+#include <type_traits>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+namespace aimux {
+namespace metrics {
+
+namespace {
+
+constexpr uint32_t BLOCK_MAGIC = 0x42445354;   // "TSDB" little-endian
+constexpr uint16_t BLOCK_VERSION = 1;
+constexpr uint8_t KIND_RAW = 0;
+constexpr uint8_t KIND_ROLLUP = 1;
+constexpr char KEY_SEPARATOR = '\x1f';
+constexpr const char* VALUE_COLUMN = "value";
+constexpr const char* RAW_PREFIX = "raw-";
+constexpr const char* ROLLUP_PREFIX = "rollup-";
+constexpr const char* FILE_SUFFIX = ".tsdb";
+
+// Rollup rows are stored as consecutive (timestamp, stat) pairs in this order
+enum RollupStat { ROLLUP_COUNT, ROLLUP_SUM, ROLLUP_SUMSQ, ROLLUP_MIN, ROLLUP_MAX, ROLLUP_STATS };
+
+constexpr double INF = std::numeric_limits<double>::infinity();
+
+int64_t to_us(std::chrono::system_clock::time_point time) {
+    return std::chrono::duration_cast<std::chrono::microseconds>(time.time_since_epoch()).count();
+}
+
+std::chrono::system_clock::time_point from_us(int64_t us) {
+    return std::chrono::system_clock::time_point(
+        std::chrono::duration_cast<std::chrono::system_clock::duration>(std::chrono::microseconds(us)));
+}
+
+template<typename Duration>
+int64_t duration_us(Duration duration) {
+    return std::chrono::duration_cast<std::chrono::microseconds>(duration).count();
+}
+
+// Start of the @p width wide bucket holding @p value, also for negative values
+int64_t align_down(int64_t value, int64_t width) {
+    int64_t remainder = value % width;
+    return remainder < 0 ? value - remainder - width : value - remainder;
+}
+
+uint32_t fnv1a(const void* data, size_t size, uint32_t hash = 2166136261u) {
+    const auto* bytes = static_cast<const uint8_t*>(data);
+    for (size_t i = 0; i < size; ++i) {
+        hash = (hash ^ bytes[i]) * 16777619u;
+    }
+    return hash;
+}
+
+std::string build_tag_key(const std::unordered_map<std::string, std::string>& tags) {
+    std::vector<std::pair<std::string, std::string>> sorted(tags.begin(), tags.end());
+    std::sort(sorted.begin(), sorted.end());
+
+    std::string key;
+    for (const auto& [name, value] : sorted) {
+        if (!key.empty()) {
+            key += KEY_SEPARATOR;
+        }
+        key += name;
+        key += '=';
+        key += value;
+    }
+    return key;
+}
+
+bool parse_file_name(const std::string& name, bool& rollup, int64_t& start_us) {
+    std::string_view view(name);
+    if (!view.ends_with(FILE_SUFFIX)) {
+        return false;
+    }
+    view.remove_suffix(std::strlen(FILE_SUFFIX));
+    if (view.starts_with(RAW_PREFIX)) {
+        rollup = false;
+        view.remove_prefix(std::strlen(RAW_PREFIX));
+    } else if (view.starts_with(ROLLUP_PREFIX)) {
+        rollup = true;
+        view.remove_prefix(std::strlen(ROLLUP_PREFIX));
+    } else {
+        return false;
+    }
+    try {
+        size_t used = 0;
+        start_us = std::stoll(std::string(view), &used);
+        return used == view.size();
+    } catch (const std::exception&) {
+        return false;
+    }
+}
+
+double percentile_of(std::vector<double>& values, double p) {
+    size_t rank = static_cast<size_t>(p / 100.0 * static_cast<double>(values.size() - 1));
+    std::nth_element(values.begin(), values.begin() + static_cast<std::ptrdiff_t>(rank), values.end());
+    return values[rank];
+}
+
+} // namespace
+
+// On-disk block header; files use the host byte order
+struct ColumnarTimeSeriesDB::BlockHeader {
+    uint32_t magic = BLOCK_MAGIC;
+    uint16_t version = BLOCK_VERSION;
+    uint8_t kind = KIND_RAW;
+    uint8_t metric_type = 0;
+    uint32_t key_bytes = 0;
+    uint32_t entries = 0;       // Points (raw) or rows (rollup) in the payload
+    uint64_t samples = 0;       // Original points summarised by the block
+    int64_t min_ts = 0;
+    int64_t max_ts = 0;
+    double sum = 0.0;
+    double sum_squares = 0.0;
+    double min = 0.0;
+    double max = 0.0;
+    uint32_t payload_bytes = 0;
+    uint32_t checksum = 0;      // FNV-1a over the header (checksum zeroed), key and payload
+
+    void absorb(int64_t timestamp, double value) {
+        if (samples == 0) {
+            min_ts = max_ts = timestamp;
+            min = max = value;
+        } else {
+            min_ts = std::min(min_ts, timestamp);
+            max_ts = std::max(max_ts, timestamp);
+            min = std::min(min, value);
+            max = std::max(max, value);
+        }
+        samples++;
+        entries++;
+        sum += value;
+        sum_squares += value * value;
+    }
+};
+
+struct ColumnarTimeSeriesDB::Series {
+    std::string key;          // measurement, column and tag key joined by KEY_SEPARATOR
+    std::string measurement;
+    std::string column;
+    std::string tag_key;      // Identifies the tag set across columns
+    std::unordered_map<std::string, std::string> tags;
+    MetricType type = MetricType::GAUGE;
+};
+
+struct ColumnarTimeSeriesDB::BlockRef {
+    BlockHeader header;
+    uint32_t series_id;
+    size_t payload_offset;
+};
+
+struct ColumnarTimeSeriesDB::Partition {
+    int64_t start_us = 0;
+    bool rollup = false;
+    std::string path;
+    size_t size = 0;                   // Bytes of valid blocks in the file
+    const uint8_t* data = nullptr;
+    std::vector<BlockRef> blocks;
+#ifndef _WIN32
+    void* mapping = nullptr;
+    size_t mapped_size = 0;
+#else
+    std::vector<uint8_t> buffer;
+#endif
+
+    ~Partition() { unmap(); }
+
+    void unmap() {
+#ifndef _WIN32
+        if (mapping) {
+            ::munmap(mapping, mapped_size);
+            mapping = nullptr;
+            mapped_size = 0;
+        }
+#else
+        buffer.clear();
+        buffer.shrink_to_fit();
+#endif
+        data = nullptr;
+    }
+
+    // Map the first `size` bytes of the file for reading
+    bool map() {
+        unmap();
+        if (size == 0) {
+            return true;
+        }
+#ifndef _WIN32
+        int fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0) {
+            return false;
+        }
+        void* address = ::mmap(nullptr, size, PROT_READ, MAP_SHARED, fd, 0);
+        ::close(fd);
+        if (address == MAP_FAILED) {
+            return false;
+        }
+        mapping = address;
+        mapped_size = size;
+        data = static_cast<const uint8_t*>(address);
+#else
+        std::ifstream in(path, std::ios::binary);
+        buffer.resize(size);
+        if (!in.read(reinterpret_cast<char*>(buffer.data()), static_cast<std::streamsize>(size))) {
+            buffer.clear();
+            return false;
+        }
+        data = buffer.data();
+#endif
+        return true;
+    }
+
+    const uint8_t* payload(const BlockRef& block) const {
+        return data + block.payload_offset;
+    }
+};
+
+struct ColumnarTimeSeriesDB::HeadBlock {
+    GorillaEncoder encoder;
+    BlockHeader summary;
+};
+
+struct ColumnarTimeSeriesDB::Accumulator {
+    double count = 0.0;
+    double sum = 0.0;
+    double sum_squares = 0.0;
+    double min = INF;
+    double max = -INF;
+    std::vector<double> values;   // Only filled for percentile queries
+
+    void merge(double n, double total, double total_squares, double lowest, double highest) {
+        count += n;
+        sum += total;
+        sum_squares += total_squares;
+        min = std::min(min, lowest);
+        max = std::max(max, highest);
+    }
+};
+
+struct ColumnarTimeSeriesDB::ScanPlan {
+    int64_t from_us = std::numeric_limits<int64_t>::min();
+    int64_t to_us = std::numeric_limits<int64_t>::max();
+    std::vector<int32_t> slot_of_series;    // -1 when the series does not match
+    struct Slot {
+        std::string column;
+        std::unordered_map<std::string, std::string> group;
+        MetricType type;
+    };
+    std::vector<Slot> slots;
+};
+
+namespace {
+
+/**
+ * Fold the points of [ts, ts + n) that fall inside [from, to] into the
+ * running totals. Written without data-dependent branches so the compiler
+ * can vectorise it; points outside the range contribute neutral elements.
+ */
+void fold_masked(const int64_t* ts, const double* values, size_t n, int64_t from, int64_t to,
+                 double& count, double& sum, double& sum_squares, double& min, double& max) {
+    double c = 0.0, s = 0.0, sq = 0.0, lo = INF, hi = -INF;
+    for (size_t i = 0; i < n; ++i) {
+        bool inside = (ts[i] >= from) & (ts[i] <= to);
+        double v = values[i];
+        double x = inside ? v : 0.0;
+        c += inside ? 1.0 : 0.0;
+        s += x;
+        sq += x * x;
+        lo = std::min(lo, inside ? v : INF);
+        hi = std::max(hi, inside ? v : -INF);
+    }
+    count += c;
+    sum += s;
+    sum_squares += sq;
+    min = std::min(min, lo);
+    max = std::max(max, hi);
+}
+
+} // namespace
+
+nlohmann::json WindowStatistics::to_json() const {
+    nlohmann::json j = stats.to_json();
+    j["start"] = std::chrono::duration_cast<std::chrono::milliseconds>(start.time_since_epoch()).count();
+    if (!group.empty()) {
+        j["group"] = group;
+    }
+    return j;
+}
+
+ColumnarTimeSeriesDB::ColumnarTimeSeriesDB(const TSDBConfig& config)
+    : TimeSeriesDB(config) {
+    static_assert(std::is_trivially_copyable_v<BlockHeader>);
+    static_assert(sizeof(BlockHeader) == 80, "block header layout is part of the file format");
+}
+
+ColumnarTimeSeriesDB::~ColumnarTimeSeriesDB() {
+    // Queued async writes call back into this object
+    stop_async_worker();
+    disconnect();
+}
+
+std::string ColumnarTimeSeriesDB::database_path() const {
+    return (std::filesystem::path(config_.data_directory) / config_.database).string();
+}
+
+bool ColumnarTimeSeriesDB::connect() {
+    std::unique_lock lock(state_mutex_);
+    if (connected_) {
+        return true;
+    }
+    if (!open_locked()) {
+        close_locked();
+        return false;
+    }
+
+    next_maintenance_us_ = to_us(std::chrono::system_clock::now()) + duration_us(config_.rollup_interval);
+    connected_ = true;
+    return true;
+}
+
+bool ColumnarTimeSeriesDB::disconnect() {
+    std::unique_lock lock(state_mutex_);
+    if (!connected_) {
+        return true;
+    }
+
+    bool flushed = true;
+    for (auto& [key, head] : heads_) {
+        flushed = seal_locked(key, *head) && flushed;
+    }
+    close_locked();
+    connected_ = false;
+    return flushed;
+}
+
+bool ColumnarTimeSeriesDB::is_connected() const {
+    return connected_;
+}
+
+bool ColumnarTimeSeriesDB::ping() {
+    return connected_;
+}
+
+bool ColumnarTimeSeriesDB::open_locked() {
+    std::error_code ec;
+    std::filesystem::create_directories(database_path(), ec);
+    if (ec) {
+        return false;
+    }
+
+    for (const auto& entry : std::filesystem::directory_iterator(database_path(), ec)) {
+        bool rollup = false;
+        int64_t start_us = 0;
+        if (!entry.is_regular_file() || !parse_file_name(entry.path().filename().string(), rollup, start_us)) {
+            continue;
+        }
+        if (!load_partition_locked(entry.path().string(), start_us, rollup)) {
+            return false;
+        }
+    }
+    return !ec;
+}
+
+void ColumnarTimeSeriesDB::close_locked() {
+    heads_.clear();
+    buffered_points_ = 0;
+    raw_partitions_.clear();
+    rollup_partitions_.clear();
+    series_.clear();
+    series_ids_.clear();
+}
+
+bool ColumnarTimeSeriesDB::load_partition_locked(const std::string& path, int64_t start_us, bool rollup) {
+    std::error_code ec;
+    auto file_size = std::filesystem::file_size(path, ec);
+    if (ec) {
+        return false;
+    }
+
+    auto partition = std::make_unique<Partition>();
+    partition->start_us = start_us;
+    partition->rollup = rollup;
+    partition->path = path;
+    partition->size = static_cast<size_t>(file_size);
+    if (!partition->map()) {
+        return false;
+    }
+
+    size_t offset = 0;
+    while (partition->size - offset >= sizeof(BlockHeader)) {
+        BlockHeader header;
+        std::memcpy(&header, partition->data + offset, sizeof(header));
+        if (header.magic != BLOCK_MAGIC || header.version != BLOCK_VERSION) {
+            break;
+        }
+        size_t total = sizeof(header) + header.key_bytes + header.payload_bytes;
+        if (total > partition->size - offset) {
+            break;
+        }
+
+        BlockHeader unsigned_header = header;
+        unsigned_header.checksum = 0;
+        const uint8_t* key_data = partition->data + offset + sizeof(header);
+        uint32_t checksum = fnv1a(&unsigned_header, sizeof(unsigned_header));
+        checksum = fnv1a(key_data, header.key_bytes + header.payload_bytes, checksum);
+        if (checksum != header.checksum) {
+            break;
+        }
+
+        // Key: measurement, column, then name=value tags
+        std::string key(reinterpret_cast<const char*>(key_data), header.key_bytes);
+        std::vector<std::string> parts;
+        size_t begin = 0;
+        while (true) {
+            size_t end = key.find(KEY_SEPARATOR, begin);
+            parts.push_back(key.substr(begin, end == std::string::npos ? std::string::npos : end - begin));
+            if (end == std::string::npos) {
+                break;
+            }
+            begin = end + 1;
+        }
+        if (parts.size() < 3) {
+            break;
+        }
+        std::unordered_map<std::string, std::string> tags;
+        for (size_t i = 2; i < parts.size(); ++i) {
+            size_t equals = parts[i].find('=');
+            if (equals != std::string::npos) {
+                tags[parts[i].substr(0, equals)] = parts[i].substr(equals + 1);
+            }
+        }
+
+        uint32_t series_id = intern_series_locked(parts[0], parts[1], tags,
+                                                  static_cast<MetricType>(header.metric_type));
+        partition->blocks.push_back({header, series_id, offset + sizeof(header) + header.key_bytes});
+        offset += total;
+    }
+
+    // Whatever follows the last intact block is a torn write
+    if (offset < partition->size) {
+        std::filesystem::resize_file(path, offset, ec);
+        if (ec) {
+            return false;
+        }
+        partition->size = offset;
+        if (!partition->map()) {
+            return false;
+        }
+    }
+
+    auto& partitions = rollup ? rollup_partitions_ : raw_partitions_;
+    partitions[start_us] = std::move(partition);
+    return true;
+}
+
+uint32_t ColumnarTimeSeriesDB::intern_series_locked(const std::string& measurement, const std::string& column,
+                                                    const std::unordered_map<std::string, std::string>& tags,
+                                                    MetricType type) {
+    std::string tag_key = build_tag_key(tags);
+    std::string key = measurement;
+    key += KEY_SEPARATOR;
+    key += column;
+    key += KEY_SEPARATOR;
+    key += tag_key;
+
+    auto it = series_ids_.find(key);
+    if (it != series_ids_.end()) {
+        return it->second;
+    }
+
+    auto id = static_cast<uint32_t>(series_.size());
+    series_.push_back({key, measurement, column, std::move(tag_key), tags, type});
+    series_ids_.emplace(std::move(key), id);
+    return id;
+}
+
+ColumnarTimeSeriesDB::Partition& ColumnarTimeSeriesDB::partition_locked(int64_t start_us, bool rollup) {
+    auto& partitions = rollup ? rollup_partitions_ : raw_partitions_;
+    auto& partition = partitions[start_us];
+    if (!partition) {
+        partition = std::make_unique<Partition>();
+        partition->start_us = start_us;
+        partition->rollup = rollup;
+        partition->path = (std::filesystem::path(database_path()) /
+            ((rollup ? ROLLUP_PREFIX : RAW_PREFIX) + std::to_string(start_us) + FILE_SUFFIX)).string();
+    }
+    return *partition;
+}
+
+bool ColumnarTimeSeriesDB::append_block_locked(Partition& partition, const BlockHeader& header,
+                                               uint32_t series_id, const std::vector<uint8_t>& payload) {
+    const std::string& key = series_[series_id].key;
+
+    BlockHeader block = header;
+    block.magic = BLOCK_MAGIC;
+    block.version = BLOCK_VERSION;
+    block.key_bytes = static_cast<uint32_t>(key.size());
+    block.payload_bytes = static_cast<uint32_t>(payload.size());
+    block.checksum = 0;
+    uint32_t checksum = fnv1a(&block, sizeof(block));
+    checksum = fnv1a(key.data(), key.size(), checksum);
+    block.checksum = fnv1a(payload.data(), payload.size(), checksum);
+
+    {
+        std::ofstream out(partition.path, std::ios::binary | std::ios::app);
+        out.write(reinterpret_cast<const char*>(&block), sizeof(block));
+        out.write(key.data(), static_cast<std::streamsize>(key.size()));
+        out.write(reinterpret_cast<const char*>(payload.data()), static_cast<std::streamsize>(payload.size()));
+        out.flush();
+        if (!out) {
+            // Drop a partial append so later blocks stay readable
+            std::error_code ec;
+            if (std::filesystem::exists(partition.path, ec)) {
+                std::filesystem::resize_file(partition.path, partition.size, ec);
+            }
+            return false;
+        }
+    }
+
+    size_t offset = partition.size;
+    partition.size += sizeof(block) + key.size() + payload.size();
+    partition.blocks.push_back({block, series_id, offset + sizeof(block) + key.size()});
+    return partition.map();
+}
+
+void ColumnarTimeSeriesDB::append_locked(uint32_t series_id, int64_t timestamp_us, double value) {
+    HeadKey key{align_down(timestamp_us, duration_us(config_.partition_duration)), series_id};
+    auto& head = heads_[key];
+    if (!head) {
+        head = std::make_unique<HeadBlock>();
+        head->summary.kind = KIND_RAW;
+        head->summary.metric_type = static_cast<uint8_t>(series_[series_id].type);
+    }
+
+    head->encoder.append(timestamp_us, value);
+    head->summary.absorb(timestamp_us, value);
+    head->summary.payload_bytes = static_cast<uint32_t>(head->encoder.bytes().size());
+    buffered_points_++;
+
+    if (head->encoder.count() >= config_.max_block_points && seal_locked(key, *head)) {
+        heads_.erase(key);
+    }
+}
+
+bool ColumnarTimeSeriesDB::seal_locked(const HeadKey& key, HeadBlock& head) {
+    if (head.encoder.count() == 0) {
+        return true;
+    }
+    if (!append_block_locked(partition_locked(key.first, false), head.summary, key.second, head.encoder.bytes())) {
+        return false;
+    }
+    buffered_points_ -= head.encoder.count();
+    return true;
+}
+
+bool ColumnarTimeSeriesDB::seal_partition_heads_locked(int64_t partition_start) {
+    bool sealed = true;
+    auto it = heads_.lower_bound({partition_start, 0});
+    while (it != heads_.end() && it->first.first == partition_start) {
+        if (seal_locked(it->first, *it->second)) {
+            it = heads_.erase(it);
+        } else {
+            sealed = false;
+            ++it;
+        }
+    }
+    return sealed;
+}
+
+bool ColumnarTimeSeriesDB::flush() {
+    std::unique_lock lock(state_mutex_);
+    bool flushed = true;
+    for (auto it = heads_.begin(); it != heads_.end();) {
+        if (seal_locked(it->first, *it->second)) {
+            it = heads_.erase(it);
+        } else {
+            flushed = false;
+            ++it;
+        }
+    }
+    return flushed;
+}
+
+bool ColumnarTimeSeriesDB::write_metrics(const std::vector<MetricPoint>& metrics) {
+    if (!connected_ && !connect()) {
+        return false;
+    }
+    return write_metrics_sync(metrics);
+}
+
+bool ColumnarTimeSeriesDB::write_events(const std::vector<PrettificationEvent>& events) {
+    if (!connected_ && !connect()) {
+        return false;
+    }
+    return write_events_sync(events);
+}
+
+bool ColumnarTimeSeriesDB::write_metrics_sync(const std::vector<MetricPoint>& metrics) {
+    {
+        std::unique_lock lock(state_mutex_);
+        if (!connected_) {
+            return false;
+        }
+
+        for (const auto& point : metrics) {
+            int64_t timestamp_us = to_us(point.timestamp);
+            append_locked(intern_series_locked(point.name, VALUE_COLUMN, point.tags, point.type),
+                          timestamp_us, point.value);
+            for (const auto& [field, value] : point.fields) {
+                append_locked(intern_series_locked(point.name, field, point.tags, point.type),
+                              timestamp_us, value);
+            }
+        }
+    }
+
+    maybe_run_maintenance();
+    return true;
+}
+
+bool ColumnarTimeSeriesDB::write_events_sync(const std::vector<PrettificationEvent>& events) {
+    std::vector<MetricPoint> points;
+    points.reserve(events.size());
+
+    for (const auto& event : events) {
+        MetricPoint point;
+        point.name = EVENTS_MEASUREMENT;
+        point.type = MetricType::TIMER;
+        point.value = event.processing_time_ms;
+        point.timestamp = event.timestamp;
+        point.tags = {
+            {"plugin", event.plugin_name},
+            {"provider", event.provider},
+            {"model", event.model},
+            {"input_format", event.input_format},
+            {"output_format", event.output_format},
+            {"success", event.success ? "true" : "false"}
+        };
+        if (!event.error_type.empty()) {
+            point.tags["error_type"] = event.error_type;
+        }
+        point.fields = {
+            {"input_size_bytes", static_cast<double>(event.input_size_bytes)},
+            {"output_size_bytes", static_cast<double>(event.output_size_bytes)},
+            {"tokens_processed", static_cast<double>(event.tokens_processed)}
+        };
+        points.push_back(std::move(point));
+    }
+
+    return write_metrics_sync(points);
+}
+
+void ColumnarTimeSeriesDB::maybe_run_maintenance() {
+    int64_t now_us = to_us(std::chrono::system_clock::now());
+    if (now_us < next_maintenance_us_.load(std::memory_order_relaxed) ||
+        maintenance_running_.exchange(true)) {
+        return;
+    }
+    next_maintenance_us_ = now_us + duration_us(config_.rollup_interval);
+    run_maintenance(from_us(now_us));
+    maintenance_running_ = false;
+}
+
+void ColumnarTimeSeriesDB::run_maintenance(std::chrono::system_clock::time_point now) {
+    std::unique_lock lock(state_mutex_);
+    if (!connected_) {
+        return;
+    }
+
+    int64_t now_us = to_us(now);
+    int64_t partition_us = duration_us(config_.partition_duration);
+
+    // Partitions that can no longer receive current data are sealed
+    std::vector<int64_t> finished;
+    for (const auto& [key, head] : heads_) {
+        if (key.first + partition_us <= now_us &&
+            (finished.empty() || finished.back() != key.first)) {
+            finished.push_back(key.first);
+        }
+    }
+    for (int64_t start : finished) {
+        seal_partition_heads_locked(start);
+    }
+
+    int64_t raw_retention_us = duration_us(config_.raw_retention);
+    if (raw_retention_us > 0 && config_.rollup_interval.count() > 0) {
+        std::vector<int64_t> expired;
+        for (const auto& [start, partition] : raw_partitions_) {
+            if (start + partition_us <= now_us - raw_retention_us) {
+                expired.push_back(start);
+            }
+        }
+        for (int64_t start : expired) {
+            rollup_partition_locked(start);
+        }
+    }
+
+    int64_t retention_us = active_retention_us_locked();
+    if (retention_us > 0) {
+        for (bool rollup : {false, true}) {
+            std::vector<int64_t> expired;
+            for (const auto& [start, partition] : rollup ? rollup_partitions_ : raw_partitions_) {
+                if (start + partition_us <= now_us - retention_us) {
+                    expired.push_back(start);
+                }
+            }
+            for (int64_t start : expired) {
+                drop_partition_locked(start, rollup);
+            }
+        }
+    }
+}
+
+bool ColumnarTimeSeriesDB::rollup_partition_locked(int64_t partition_start) {
+    if (!seal_partition_heads_locked(partition_start)) {
+        return false;
+    }
+    auto found = raw_partitions_.find(partition_start);
+    if (found == raw_partitions_.end()) {
+        return true;
+    }
+    const Partition& raw = *found->second;
+    int64_t rollup_us = duration_us(config_.rollup_interval);
+
+    struct Row {
+        double count = 0.0;
+        double sum = 0.0;
+        double sum_squares = 0.0;
+        double min = INF;
+        double max = -INF;
+    };
+    std::map<std::pair<uint32_t, int64_t>, Row> rows;   // Ordered by series, then time
+
+    std::vector<int64_t> timestamps;
+    std::vector<double> values;
+    for (const auto& block : raw.blocks) {
+        GorillaDecoder decoder(raw.payload(block), block.header.payload_bytes, block.header.entries);
+        decoder.decode_all(timestamps, values);
+        for (size_t i = 0; i < timestamps.size(); ++i) {
+            Row& row = rows[{block.series_id, align_down(timestamps[i], rollup_us)}];
+            row.count += 1.0;
+            row.sum += values[i];
+            row.sum_squares += values[i] * values[i];
+            row.min = std::min(row.min, values[i]);
+            row.max = std::max(row.max, values[i]);
+        }
+    }
+
+    Partition& target = partition_locked(partition_start, true);
+    bool written = true;
+    auto it = rows.begin();
+    while (it != rows.end()) {
+        uint32_t series_id = it->first.first;
+        GorillaEncoder encoder;
+        BlockHeader header;
+        header.kind = KIND_ROLLUP;
+        header.metric_type = static_cast<uint8_t>(series_[series_id].type);
+
+        for (; it != rows.end() && it->first.first == series_id &&
+               header.entries < config_.max_block_points; ++it) {
+            int64_t timestamp = it->first.second;
+            const Row& row = it->second;
+            encoder.append(timestamp, row.count);
+            encoder.append(timestamp, row.sum);
+            encoder.append(timestamp, row.sum_squares);
+            encoder.append(timestamp, row.min);
+            encoder.append(timestamp, row.max);
+
+            if (header.entries == 0) {
+                header.min_ts = timestamp;
+                header.min = row.min;
+                header.max = row.max;
+            }
+            header.max_ts = timestamp;
+            header.entries++;
+            header.samples += static_cast<uint64_t>(row.count);
+            header.sum += row.sum;
+            header.sum_squares += row.sum_squares;
+            header.min = std::min(header.min, row.min);
+            header.max = std::max(header.max, row.max);
+        }
+        written = append_block_locked(target, header, series_id, encoder.bytes()) && written;
+    }
+
+    if (!written) {
+        return false;
+    }
+    drop_partition_locked(partition_start, false);
+    return true;
+}
+
+void ColumnarTimeSeriesDB::drop_partition_locked(int64_t partition_start, bool rollup) {
+    if (!rollup) {
+        auto it = heads_.lower_bound({partition_start, 0});
+        while (it != heads_.end() && it->first.first == partition_start) {
+            buffered_points_ -= it->second->encoder.count();
+            it = heads_.erase(it);
+        }
+    }
+
+    auto& partitions = rollup ? rollup_partitions_ : raw_partitions_;
+    auto found = partitions.find(partition_start);
+    if (found == partitions.end()) {
+        return;
+    }
+    std::string path = found->second->path;
+    partitions.erase(found);
+
+    std::error_code ec;
+    std::filesystem::remove(path, ec);
+}
+
+int64_t ColumnarTimeSeriesDB::active_retention_us_locked() const {
+    if (!default_retention_policy_.empty()) {
+        auto it = retention_policies_.find(default_retention_policy_);
+        if (it != retention_policies_.end()) {
+            return duration_us(it->second);
+        }
+    }
+    return duration_us(config_.retention);
+}
+
+ColumnarTimeSeriesDB::ScanPlan ColumnarTimeSeriesDB::plan_scan_locked(
+    const TSDBQueryBuilder& query, const std::vector<std::string>& columns) const {
+    ScanPlan plan;
+    if (const auto& range = query.get_time_range()) {
+        plan.from_us = to_us(range->first);
+        plan.to_us = to_us(range->second);
+    }
+
+    std::vector<std::string> group_by;
+    for (const auto& tag : query.get_group_by()) {
+        group_by.push_back(tag);
+    }
+
+    std::unordered_map<std::string, int32_t> slot_ids;
+    plan.slot_of_series.assign(series_.size(), -1);
+    for (uint32_t id = 0; id < series_.size(); ++id) {
+        const Series& series = series_[id];
+        if (series.measurement != query.get_measurement()) {
+            continue;
+        }
+        if (!columns.empty() && std::find(columns.begin(), columns.end(), series.column) == columns.end()) {
+            continue;
+        }
+        bool matches = true;
+        for (const auto& [name, value] : query.get_tags()) {
+            auto tag = series.tags.find(name);
+            if (tag == series.tags.end() || tag->second != value) {
+                matches = false;
+                break;
+            }
+        }
+        if (!matches) {
+            continue;
+        }
+
+        std::unordered_map<std::string, std::string> group;
+        std::string slot_key = series.column;
+        for (const auto& name : group_by) {
+            auto tag = series.tags.find(name);
+            std::string value = tag == series.tags.end() ? "" : tag->second;
+            slot_key += KEY_SEPARATOR;
+            slot_key += value;
+            group[name] = std::move(value);
+        }
+
+        auto [slot, inserted] = slot_ids.emplace(slot_key, static_cast<int32_t>(plan.slots.size()));
+        if (inserted) {
+            plan.slots.push_back({series.column, std::move(group), series.type});
+        }
+        plan.slot_of_series[id] = slot->second;
+    }
+    return plan;
+}
+
+std::map<std::pair<int64_t, uint32_t>, ColumnarTimeSeriesDB::Accumulator>
+ColumnarTimeSeriesDB::aggregate_locked(const ScanPlan& plan, int64_t window_us, bool percentiles) const {
+    std::map<std::pair<int64_t, uint32_t>, Accumulator> windows;
+    if (plan.slots.empty() || plan.from_us > plan.to_us) {
+        return windows;
+    }
+
+    auto window_of = [window_us](int64_t timestamp) {
+        return window_us > 0 ? align_down(timestamp, window_us) : 0;
+    };
+
+    std::vector<int64_t> timestamps;
+    std::vector<double> values;
+
+    auto scan_block = [&](const BlockHeader& header, uint32_t series_id, const uint8_t* payload) {
+        int32_t slot = plan.slot_of_series[series_id];
+        if (slot < 0 || header.entries == 0 || header.max_ts < plan.from_us || header.min_ts > plan.to_us) {
+            return;
+        }
+        auto slot_id = static_cast<uint32_t>(slot);
+
+        // Fast path: the block summary already is the answer
+        bool inside = header.min_ts >= plan.from_us && header.max_ts <= plan.to_us;
+        if (inside && !percentiles && window_of(header.min_ts) == window_of(header.max_ts)) {
+            windows[{window_of(header.min_ts), slot_id}].merge(
+                static_cast<double>(header.samples), header.sum, header.sum_squares, header.min, header.max);
+            return;
+        }
+
+        GorillaDecoder decoder(payload, header.payload_bytes, header.kind == KIND_ROLLUP
+            ? static_cast<size_t>(header.entries) * ROLLUP_STATS : header.entries);
+        decoder.decode_all(timestamps, values);
+
+        if (header.kind == KIND_ROLLUP) {
+            for (size_t row = 0; row + ROLLUP_STATS <= values.size(); row += ROLLUP_STATS) {
+                int64_t timestamp = timestamps[row];
+                if (timestamp < plan.from_us || timestamp > plan.to_us) {
+                    continue;
+                }
+                Accumulator& accumulator = windows[{window_of(timestamp), slot_id}];
+                accumulator.merge(values[row + ROLLUP_COUNT], values[row + ROLLUP_SUM],
+                                  values[row + ROLLUP_SUMSQ], values[row + ROLLUP_MIN], values[row + ROLLUP_MAX]);
+                if (percentiles && values[row + ROLLUP_COUNT] > 0.0) {
+                    accumulator.values.push_back(values[row + ROLLUP_SUM] / values[row + ROLLUP_COUNT]);
+                }
+            }
+            return;
+        }
+
+        // Fold each run of points sharing a window with the masked loop
+        size_t n = timestamps.size();
+        size_t begin = 0;
+        while (begin < n) {
+            int64_t window = window_of(timestamps[begin]);
+            size_t end = begin + 1;
+            if (window_us > 0) {
+                while (end < n && window_of(timestamps[end]) == window) {
+                    end++;
+                }
+            } else {
+                end = n;
+            }
+
+            Accumulator& accumulator = windows[{window, slot_id}];
+            fold_masked(timestamps.data() + begin, values.data() + begin, end - begin, plan.from_us, plan.to_us,
+                        accumulator.count, accumulator.sum, accumulator.sum_squares,
+                        accumulator.min, accumulator.max);
+            if (percentiles) {
+                for (size_t i = begin; i < end; ++i) {
+                    if (timestamps[i] >= plan.from_us && timestamps[i] <= plan.to_us) {
+                        accumulator.values.push_back(values[i]);
+                    }
+                }
+            }
+            begin = end;
+        }
+    };
+
+    int64_t partition_us = duration_us(config_.partition_duration);
+    for (const auto* partitions : {&raw_partitions_, &rollup_partitions_}) {
+        for (const auto& [start, partition] : *partitions) {
+            if (start > plan.to_us || start + partition_us <= plan.from_us) {
+                continue;
+            }
+            for (const auto& block : partition->blocks) {
+                scan_block(block.header, block.series_id, partition->payload(block));
+            }
+        }
+    }
+    for (const auto& [key, head] : heads_) {
+        scan_block(head->summary, key.second, head->encoder.bytes().data());
+    }
+
+    return windows;
+}
+
+namespace {
+
+MetricStatistics to_statistics(std::string name, MetricType type, std::vector<double>& values,
+                               double count, double sum, double sum_squares, double min, double max,
+                               bool percentiles) {
+    MetricStatistics stats;
+    stats.name = std::move(name);
+    stats.type = type;
+    stats.count = count;
+    stats.sum = sum;
+    stats.min = min;
+    stats.max = max;
+    stats.mean = sum / count;
+    stats.std_dev = std::sqrt(std::max(0.0, sum_squares / count - stats.mean * stats.mean));
+    if (percentiles && !values.empty()) {
+        stats.median = percentile_of(values, 50.0);
+        stats.p95 = percentile_of(values, 95.0);
+        stats.p99 = percentile_of(values, 99.0);
+    }
+    return stats;
+}
+
+} // namespace
+
+std::vector<MetricStatistics> ColumnarTimeSeriesDB::query_aggregations(
+    const TSDBQueryBuilder& query,
+    const std::vector<std::string>& aggregations) {
+    auto started = std::chrono::steady_clock::now();
+    bool percentiles = std::any_of(aggregations.begin(), aggregations.end(), [](const std::string& name) {
+        return name == "median" || name == "p95" || name == "p99" || name == "percentile";
+    });
+
+    std::vector<std::string> columns = query.get_fields();
+    if (columns.empty()) {
+        columns.push_back(VALUE_COLUMN);
+    }
+
+    std::vector<MetricStatistics> results;
+    {
+        std::shared_lock lock(state_mutex_);
+        ScanPlan plan = plan_scan_locked(query, columns);
+        auto windows = aggregate_locked(plan, 0, percentiles);
+        for (auto& [key, accumulator] : windows) {
+            if (accumulator.count == 0.0) {
+                continue;
+            }
+            const auto& slot = plan.slots[key.second];
+            std::string name = slot.column == VALUE_COLUMN
+                ? query.get_measurement() : query.get_measurement() + "." + slot.column;
+            results.push_back(to_statistics(std::move(name), slot.type, accumulator.values,
+                                            accumulator.count, accumulator.sum, accumulator.sum_squares,
+                                            accumulator.min, accumulator.max, percentiles));
+        }
+    }
+
+    record_query_time(started);
+    return results;
+}
+
+std::vector<WindowStatistics> ColumnarTimeSeriesDB::query_windows(const TSDBQueryBuilder& query,
+                                                                  std::chrono::milliseconds window,
+                                                                  bool percentiles) {
+    auto started = std::chrono::steady_clock::now();
+    std::vector<WindowStatistics> results;
+    if (window.count() <= 0) {
+        return results;
+    }
+
+    std::vector<std::string> columns = query.get_fields();
+    if (columns.empty()) {
+        columns.push_back(VALUE_COLUMN);
+    }
+
+    {
+        std::shared_lock lock(state_mutex_);
+        ScanPlan plan = plan_scan_locked(query, columns);
+        auto windows = aggregate_locked(plan, duration_us(window), percentiles);
+        for (auto& [key, accumulator] : windows) {
+            if (accumulator.count == 0.0) {
+                continue;
+            }
+            const auto& slot = plan.slots[key.second];
+            std::string name = slot.column == VALUE_COLUMN
+                ? query.get_measurement() : query.get_measurement() + "." + slot.column;
+
+            WindowStatistics entry;
+            entry.start = from_us(key.first);
+            entry.group = slot.group;
+            entry.stats = to_statistics(std::move(name), slot.type, accumulator.values,
+                                        accumulator.count, accumulator.sum, accumulator.sum_squares,
+                                        accumulator.min, accumulator.max, percentiles);
+            results.push_back(std::move(entry));
+        }
+    }
+
+    record_query_time(started);
+    return results;
+}
+
+std::vector<MetricPoint> ColumnarTimeSeriesDB::query_metrics(const TSDBQueryBuilder& query) {
+    auto started = std::chrono::steady_clock::now();
+
+    std::vector<std::string> columns;
+    if (!query.get_fields().empty()) {
+        columns = query.get_fields();
+        columns.push_back(VALUE_COLUMN);
+    }
+
+    // Columns of one tag set at one timestamp join into one point
+    std::map<std::pair<int64_t, std::string>, MetricPoint> joined;
+    {
+        std::shared_lock lock(state_mutex_);
+        ScanPlan plan = plan_scan_locked(query, columns);
+
+        std::vector<int64_t> timestamps;
+        std::vector<double> values;
+        auto emit = [&](const Series& series, int64_t timestamp, double value) {
+            auto [it, inserted] = joined.try_emplace({timestamp, series.tag_key});
+            MetricPoint& point = it->second;
+            if (inserted) {
+                point.name = series.measurement;
+                point.type = series.type;
+                point.value = 0.0;
+                point.timestamp = from_us(timestamp);
+                point.tags = series.tags;
+            }
+            if (series.column == VALUE_COLUMN) {
+                point.value = value;
+            } else {
+                point.fields[series.column] = value;
+            }
+        };
+
+        auto scan_block = [&](const BlockHeader& header, uint32_t series_id, const uint8_t* payload) {
+            if (plan.slot_of_series[series_id] < 0 || header.entries == 0 ||
+                header.max_ts < plan.from_us || header.min_ts > plan.to_us) {
+                return;
+            }
+            bool rollup = header.kind == KIND_ROLLUP;
+            GorillaDecoder decoder(payload, header.payload_bytes,
+                                   rollup ? static_cast<size_t>(header.entries) * ROLLUP_STATS : header.entries);
+            decoder.decode_all(timestamps, values);
+
+            const Series& series = series_[series_id];
+            size_t stride = rollup ? ROLLUP_STATS : 1;
+            for (size_t i = 0; i + stride <= values.size(); i += stride) {
+                if (timestamps[i] < plan.from_us || timestamps[i] > plan.to_us) {
+                    continue;
+                }
+                double value = values[i];
+                if (rollup) {
+                    double count = values[i + ROLLUP_COUNT];
+                    value = count > 0.0 ? values[i + ROLLUP_SUM] / count : 0.0;
+                }
+                emit(series, timestamps[i], value);
+            }
+        };
+
+        int64_t partition_us = duration_us(config_.partition_duration);
+        for (const auto* partitions : {&raw_partitions_, &rollup_partitions_}) {
+            for (const auto& [start, partition] : *partitions) {
+                if (start > plan.to_us || start + partition_us <= plan.from_us) {
+                    continue;
+                }
+                for (const auto& block : partition->blocks) {
+                    scan_block(block.header, block.series_id, partition->payload(block));
+                }
+            }
+        }
+        for (const auto& [key, head] : heads_) {
+            scan_block(head->summary, key.second, head->encoder.bytes().data());
+        }
+    }
+
+    std::vector<MetricPoint> results;
+    results.reserve(joined.size());
+    for (auto& [key, point] : joined) {
+        results.push_back(std::move(point));
+    }
+    const auto& order = query.get_order_by();
+    if (order && order->second == "desc") {
+        std::reverse(results.begin(), results.end());
+    }
+    if (query.get_limit() && results.size() > *query.get_limit()) {
+        results.resize(*query.get_limit());
+    }
+
+    record_query_time(started);
+    return results;
+}
+
+std::vector<PrettificationEvent> ColumnarTimeSeriesDB::query_events(const TSDBQueryBuilder& query) {
+    TSDBQueryBuilder events_query(EVENTS_MEASUREMENT);
+    if (const auto& range = query.get_time_range()) {
+        events_query.time_range(range->first, range->second);
+    }
+    events_query.tags(query.get_tags());
+    if (query.get_limit()) {
+        events_query.limit(*query.get_limit());
+    }
+    if (const auto& order = query.get_order_by()) {
+        events_query.order_by(order->first, order->second);
+    }
+
+    std::vector<PrettificationEvent> events;
+    for (const auto& point : query_metrics(events_query)) {
+        auto tag = [&point](const char* name) {
+            auto it = point.tags.find(name);
+            return it == point.tags.end() ? std::string() : it->second;
+        };
+        auto field = [&point](const char* name) {
+            auto it = point.fields.find(name);
+            return it == point.fields.end() ? 0.0 : it->second;
+        };
+
+        PrettificationEvent event;
+        event.plugin_name = tag("plugin");
+        event.provider = tag("provider");
+        event.model = tag("model");
+        event.input_format = tag("input_format");
+        event.output_format = tag("output_format");
+        event.processing_time_ms = point.value;
+        event.input_size_bytes = static_cast<size_t>(field("input_size_bytes"));
+        event.output_size_bytes = static_cast<size_t>(field("output_size_bytes"));
+        event.success = tag("success") == "true";
+        event.error_type = tag("error_type");
+        event.tokens_processed = static_cast<size_t>(field("tokens_processed"));
+        event.timestamp = point.timestamp;
+        events.push_back(std::move(event));
+    }
+    return events;
+}
+
+bool ColumnarTimeSeriesDB::create_database(const std::string& name) {
+    std::error_code ec;
+    std::filesystem::create_directories(std::filesystem::path(config_.data_directory) / name, ec);
+    return !ec;
+}
+
+bool ColumnarTimeSeriesDB::drop_database(const std::string& name) {
+    std::unique_lock lock(state_mutex_);
+    bool current = name == config_.database;
+    if (current) {
+        close_locked();
+    }
+
+    std::error_code ec;
+    std::filesystem::remove_all(std::filesystem::path(config_.data_directory) / name, ec);
+    if (current && connected_) {
+        std::filesystem::create_directories(database_path(), ec);
+    }
+    return !ec;
+}
+
+std::vector<std::string> ColumnarTimeSeriesDB::list_databases() {
+    std::vector<std::string> databases;
+    std::error_code ec;
+    for (const auto& entry : std::filesystem::directory_iterator(config_.data_directory, ec)) {
+        if (entry.is_directory()) {
+            databases.push_back(entry.path().filename().string());
+        }
+    }
+    std::sort(databases.begin(), databases.end());
+    return databases;
+}
+
+bool ColumnarTimeSeriesDB::create_retention_policy(
+    const std::string& name,
+    const std::chrono::hours& duration,
+    int /*replication_factor*/,
+    bool default_policy) {
+    if (name.empty() || duration.count() <= 0) {
+        return false;
+    }
+
+    std::unique_lock lock(state_mutex_);
+    retention_policies_[name] = duration;
+    if (default_policy || default_retention_policy_.empty()) {
+        default_retention_policy_ = name;
+    }
+    return true;
+}
+
+bool ColumnarTimeSeriesDB::drop_retention_policy(const std::string& name) {
+    std::unique_lock lock(state_mutex_);
+    if (retention_policies_.erase(name) == 0) {
+        return false;
+    }
+    if (default_retention_policy_ == name) {
+        default_retention_policy_.clear();
+    }
+    return true;
+}
+
+std::vector<std::string> ColumnarTimeSeriesDB::list_retention_policies() {
+    std::shared_lock lock(state_mutex_);
+    std::vector<std::string> names;
+    for (const auto& [name, duration] : retention_policies_) {
+        names.push_back(name);
+    }
+    return names;
+}
+
+bool ColumnarTimeSeriesDB::create_continuous_query(const std::string& /*name*/, const std::string& /*query*/) {
+    // Rollups cover the downsampling use case; arbitrary continuous queries are not supported
+    return false;
+}
+
+bool ColumnarTimeSeriesDB::drop_continuous_query(const std::string& /*name*/) {
+    return false;
+}
+
+std::vector<std::string> ColumnarTimeSeriesDB::list_continuous_queries() {
+    return {};
+}
+
+nlohmann::json ColumnarTimeSeriesDB::get_status() const {
+    std::shared_lock lock(state_mutex_);
+
+    size_t bytes = 0;
+    uint64_t points = 0;
+    uint64_t rollup_rows = 0;
+    for (const auto& [start, partition] : raw_partitions_) {
+        bytes += partition->size;
+        for (const auto& block : partition->blocks) {
+            points += block.header.entries;
+        }
+    }
+    for (const auto& [start, partition] : rollup_partitions_) {
+        bytes += partition->size;
+        for (const auto& block : partition->blocks) {
+            rollup_rows += block.header.entries;
+        }
+    }
+
+    nlohmann::json status;
+    status["backend"] = "columnar";
+    status["connected"] = connected_.load();
+    status["path"] = database_path();
+    status["series"] = series_.size();
+    status["raw_partitions"] = raw_partitions_.size();
+    status["rollup_partitions"] = rollup_partitions_.size();
+    status["bytes_on_disk"] = bytes;
+    status["raw_points"] = points;
+    status["rollup_rows"] = rollup_rows;
+    status["buffered_points"] = buffered_points_;
+    status["retention_hours"] = std::chrono::duration_cast<std::chrono::hours>(
+        std::chrono::microseconds(active_retention_us_locked())).count();
+    status["retention_policies"] = nlohmann::json::array();
+    for (const auto& [name, duration] : retention_policies_) {
+        status["retention_policies"].push_back({{"name", name}, {"hours", duration.count()},
+                                                {"default", name == default_retention_policy_}});
+    }
+    status["query_time_ms"] = last_query_time_ms_.load();
+    return status;
+}
+
+double ColumnarTimeSeriesDB::get_query_performance_ms() const {
+    return last_query_time_ms_.load();
+}
+
+void ColumnarTimeSeriesDB::record_query_time(std::chrono::steady_clock::time_point started) const {
+    last_query_time_ms_ = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - started).count();
+}
+
+} // namespace metrics
+} // namespace aimux
@@ -0,0 +1,483 @@
+#include "aimux/metrics/influx_writer.hpp"
+#include "aimux/metrics/time_series_db.hpp"
+#include "aimux/metrics/columnar_tsdb.hpp"
+#include <algorithm>
+#include <charconv>
+#include <cmath>
+
+#ifdef AIMUX_HAVE_ZLIB
+#include <zlib.h>
+#endif
+
+#ifdef __linux__
+#include <sys/resource.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace aimux {
+namespace metrics {
+
+namespace {
+
+// Per-byte escaping rules for one line protocol element
+class EscapeTable {
+public:
+    enum Action : uint8_t { COPY, ESCAPE, NEWLINE };
+
+    constexpr explicit EscapeTable(std::string_view specials) : actions_{} {
+        for (char c : specials) {
+            actions_[static_cast<unsigned char>(c)] = ESCAPE;
+        }
+        // Newlines cannot be escaped in line protocol; they become (escaped) spaces
+        actions_[static_cast<unsigned char>('\n')] = NEWLINE;
+        actions_[static_cast<unsigned char>('\r')] = NEWLINE;
+        escape_space_ = actions_[static_cast<unsigned char>(' ')] == ESCAPE;
+    }
+
+    Action operator[](char c) const { return static_cast<Action>(actions_[static_cast<unsigned char>(c)]); }
+    bool escape_space() const { return escape_space_; }
+
+private:
+    uint8_t actions_[256];
+    bool escape_space_ = false;
+};
+
+constexpr EscapeTable MEASUREMENT_SPECIALS{", "};
+constexpr EscapeTable KEY_SPECIALS{",= "};
+constexpr EscapeTable STRING_SPECIALS{"\"\\"};
+
+void append_escaped(std::string& out, std::string_view text, const EscapeTable& table) {
+    size_t start = 0;
+    for (size_t i = 0; i < text.size(); ++i) {
+        EscapeTable::Action action = table[text[i]];
+        if (action == EscapeTable::COPY) {
+            continue;
+        }
+        out.append(text.data() + start, i - start);
+        if (action == EscapeTable::ESCAPE) {
+            out.push_back('\\');
+            out.push_back(text[i]);
+        } else {
+            if (table.escape_space()) {
+                out.push_back('\\');
+            }
+            out.push_back(' ');
+        }
+        start = i + 1;
+    }
+    out.append(text.data() + start, text.size() - start);
+}
+
+template<typename Number>
+void append_number(std::string& out, Number value) {
+    char buffer[32];
+    auto result = std::to_chars(buffer, buffer + sizeof(buffer), value);
+    out.append(buffer, result.ptr);
+}
+
+void append_double(std::string& out, double value) {
+    // Counters and token counts are whole numbers; integer formatting is much cheaper
+    if (std::trunc(value) == value && std::fabs(value) < 1e15) {
+        append_number(out, static_cast<int64_t>(value));
+    } else {
+        append_number(out, value);
+    }
+}
+
+void append_timestamp(std::string& out, std::chrono::system_clock::time_point timestamp) {
+    out.push_back(' ');
+    append_number(out, std::chrono::duration_cast<std::chrono::nanoseconds>(
+        timestamp.time_since_epoch()).count());
+    out.push_back('\n');
+}
+
+// Writes ",key=value" (or "key=value" for the first field); skips NaN and infinities
+bool append_field(std::string& out, std::string_view key, double value, bool& first) {
+    if (!std::isfinite(value)) {
+        return false;
+    }
+    if (!first) {
+        out.push_back(',');
+    }
+    first = false;
+    append_escaped(out, key, KEY_SPECIALS);
+    out.push_back('=');
+    append_double(out, value);
+    return true;
+}
+
+double elapsed_ms(std::chrono::steady_clock::time_point started) {
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - started).count();
+}
+
+} // namespace
+
+// LineProtocolEncoder implementation
+bool LineProtocolEncoder::append(std::string& out, const MetricPoint& point) {
+    const size_t rollback = out.size();
+    append_escaped(out, point.name, MEASUREMENT_SPECIALS);
+
+    tags_.clear();
+    for (const auto& [key, value] : point.tags) {
+        if (!value.empty()) {
+            tags_.emplace_back(key, value);
+        }
+    }
+    std::sort(tags_.begin(), tags_.end());
+    for (const auto& [key, value] : tags_) {
+        out.push_back(',');
+        append_escaped(out, key, KEY_SPECIALS);
+        out.push_back('=');
+        append_escaped(out, value, KEY_SPECIALS);
+    }
+
+    out.push_back(' ');
+    bool first = true;
+    append_field(out, "value", point.value, first);
+    for (const auto& [key, value] : point.fields) {
+        append_field(out, key, value, first);
+    }
+    if (first) {
+        out.resize(rollback);
+        return false;
+    }
+
+    append_timestamp(out, point.timestamp);
+    return true;
+}
+
+bool LineProtocolEncoder::append(std::string& out, const PrettificationEvent& event) {
+    out.append(ColumnarTimeSeriesDB::EVENTS_MEASUREMENT);
+
+    const std::pair<std::string_view, const std::string*> tags[] = {
+        {"input_format", &event.input_format},
+        {"model", &event.model},
+        {"output_format", &event.output_format},
+        {"plugin", &event.plugin_name},
+        {"provider", &event.provider},
+    };
+    for (const auto& [key, value] : tags) {
+        if (!value->empty()) {
+            out.push_back(',');
+            out.append(key);
+            out.push_back('=');
+            append_escaped(out, *value, KEY_SPECIALS);
+        }
+    }
+
+    out.push_back(' ');
+    bool first = true;
+    append_field(out, "processing_time_ms", event.processing_time_ms, first);
+    append_field(out, "input_size_bytes", static_cast<double>(event.input_size_bytes), first);
+    append_field(out, "output_size_bytes", static_cast<double>(event.output_size_bytes), first);
+    out.append(first ? "success=" : ",success=");
+    out.append(event.success ? "true" : "false");
+    first = false;
+    append_field(out, "tokens_processed", static_cast<double>(event.tokens_processed), first);
+
+    if (!event.error_type.empty()) {
+        out.append(",error_type=\"");
+        append_escaped(out, event.error_type, STRING_SPECIALS);
+        out.push_back('"');
+    }
+
+    append_timestamp(out, event.timestamp);
+    return true;
+}
+
+nlohmann::json InfluxWriteStats::to_json() const {
+    nlohmann::json j;
+    j["lines_accepted"] = lines_accepted;
+    j["lines_sent"] = lines_sent;
+    j["lines_dropped"] = lines_dropped;
+    j["batches_sent"] = batches_sent;
+    j["batches_failed"] = batches_failed;
+    j["bytes_encoded"] = bytes_encoded;
+    j["bytes_sent"] = bytes_sent;
+    j["compression_ratio"] = bytes_sent > 0 ? static_cast<double>(bytes_encoded) / bytes_sent : 0.0;
+    j["pending_lines"] = pending_lines;
+    j["pending_batches"] = pending_batches;
+    j["last_send_ms"] = last_send_ms;
+    j["max_send_ms"] = max_send_ms;
+    return j;
+}
+
+/**
+ * @brief Reusable gzip deflater; the stream state and output buffer survive between batches
+ */
+class InfluxWriteBatcher::Compressor {
+public:
+    explicit Compressor(int level) : level_(level) {}
+
+    ~Compressor() {
+#ifdef AIMUX_HAVE_ZLIB
+        if (initialised_) {
+            deflateEnd(&stream_);
+        }
+#endif
+    }
+
+    Compressor(const Compressor&) = delete;
+    Compressor& operator=(const Compressor&) = delete;
+
+    /// Gzip @p input into output(); false if compression is unavailable or failed
+    bool compress(std::string_view input) {
+#ifdef AIMUX_HAVE_ZLIB
+        if (!initialised_) {
+            // 15 + 16 window bits selects the gzip wrapper InfluxDB expects
+            if (deflateInit2(&stream_, level_, Z_DEFLATED, 15 + 16, 8, Z_DEFAULT_STRATEGY) != Z_OK) {
+                return false;
+            }
+            initialised_ = true;
+        } else if (deflateReset(&stream_) != Z_OK) {
+            return false;
+        }
+
+        const size_t bound = deflateBound(&stream_, static_cast<uLong>(input.size()));
+        bool ok = false;
+        output_.resize_and_overwrite(bound, [&](char* data, size_t size) {
+            stream_.next_in = reinterpret_cast<Bytef*>(const_cast<char*>(input.data()));
+            stream_.avail_in = static_cast<uInt>(input.size());
+            stream_.next_out = reinterpret_cast<Bytef*>(data);
+            stream_.avail_out = static_cast<uInt>(size);
+            ok = deflate(&stream_, Z_FINISH) == Z_STREAM_END;
+            return ok ? static_cast<size_t>(stream_.total_out) : size_t{0};
+        });
+        return ok;
+#else
+        static_cast<void>(input);
+        static_cast<void>(level_);
+        return false;
+#endif
+    }
+
+    std::string_view output() const { return output_; }
+
+private:
+    int level_;
+    std::string output_;
+#ifdef AIMUX_HAVE_ZLIB
+    z_stream stream_{};
+    bool initialised_ = false;
+#endif
+};
+
+// InfluxWriteBatcher implementation
+InfluxWriteBatcher::Options InfluxWriteBatcher::Options::from_config(const TSDBConfig& config) {
+    Options options;
+    options.max_lines = config.max_batch_size;
+    options.max_bytes = config.max_batch_bytes;
+    options.flush_interval = config.flush_interval;
+    options.max_pending_batches = config.max_pending_batches;
+    options.max_retries = config.max_retries;
+    options.retry_delay = std::chrono::duration_cast<std::chrono::milliseconds>(config.retry_delay);
+    options.gzip = config.enable_compression;
+    return options;
+}
+
+InfluxWriteBatcher::InfluxWriteBatcher(Options options, Transport transport)
+    : options_(std::move(options)),
+      transport_(std::move(transport)),
+      compressor_(std::make_unique<Compressor>(options_.gzip_level)) {
+    options_.max_lines = std::max<size_t>(options_.max_lines, 1);
+    options_.max_bytes = std::max<size_t>(options_.max_bytes, 1);
+    options_.max_pending_batches = std::max<size_t>(options_.max_pending_batches, 1);
+#ifndef AIMUX_HAVE_ZLIB
+    options_.gzip = false;
+#endif
+    flusher_ = std::thread([this] { run(); });
+}
+
+InfluxWriteBatcher::~InfluxWriteBatcher() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stopping_ = true;
+    }
+    work_cv_.notify_all();
+    if (flusher_.joinable()) {
+        flusher_.join();
+    }
+}
+
+size_t InfluxWriteBatcher::add(const std::vector<MetricPoint>& metrics) {
+    return add_items(metrics);
+}
+
+size_t InfluxWriteBatcher::add(const std::vector<PrettificationEvent>& events) {
+    return add_items(events);
+}
+
+template<typename Item>
+size_t InfluxWriteBatcher::add_items(const std::vector<Item>& items) {
+    size_t added = 0;
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (const auto& item : items) {
+        if (!encoder_.append(open_, item)) {
+            continue;
+        }
+        added++;
+        line_added_locked();
+    }
+    stats_.lines_accepted += added;
+    return added;
+}
+
+void InfluxWriteBatcher::line_added_locked() {
+    if (open_lines_ == 0) {
+        // The flusher sleeps untimed while nothing is open; arm its deadline
+        open_since_ = std::chrono::steady_clock::now();
+        work_cv_.notify_one();
+    }
+    open_lines_++;
+    if (open_lines_ >= options_.max_lines || open_.size() >= options_.max_bytes) {
+        seal_locked();
+    }
+}
+
+void InfluxWriteBatcher::seal_locked() {
+    if (open_lines_ == 0) {
+        return;
+    }
+
+    if (ready_.size() >= options_.max_pending_batches) {
+        // The endpoint is not keeping up: shed the oldest data rather than block producers
+        Batch& oldest = ready_.front();
+        stats_.lines_dropped += oldest.lines;
+        recycle_locked(std::move(oldest.body));
+        ready_.pop_front();
+        finished_batches_++;
+        idle_cv_.notify_all();
+    }
+
+    stats_.bytes_encoded += open_.size();
+    ready_.push_back(Batch{std::move(open_), open_lines_});
+    open_ = take_buffer_locked();
+    open_lines_ = 0;
+    sealed_batches_++;
+    work_cv_.notify_one();
+}
+
+std::string InfluxWriteBatcher::take_buffer_locked() {
+    if (spare_buffers_.empty()) {
+        return {};
+    }
+    std::string buffer = std::move(spare_buffers_.back());
+    spare_buffers_.pop_back();
+    return buffer;
+}
+
+void InfluxWriteBatcher::recycle_locked(std::string buffer) {
+    // Two spares cover the open batch and the one being sent in steady state
+    if (spare_buffers_.size() < 2) {
+        buffer.clear();
+        spare_buffers_.push_back(std::move(buffer));
+    }
+}
+
+bool InfluxWriteBatcher::flush(std::chrono::milliseconds timeout) {
+    std::unique_lock<std::mutex> lock(mutex_);
+    seal_locked();
+    const uint64_t target = sealed_batches_;
+    return idle_cv_.wait_for(lock, timeout, [&] { return finished_batches_ >= target; });
+}
+
+void InfluxWriteBatcher::set_transport(Transport transport) {
+    std::unique_lock<std::mutex> lock(mutex_);
+    idle_cv_.wait(lock, [this] { return !in_flight_; });
+    transport_ = std::move(transport);
+}
+
+InfluxWriteStats InfluxWriteBatcher::get_stats() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    InfluxWriteStats stats = stats_;
+    stats.pending_lines = open_lines_;
+    for (const auto& batch : ready_) {
+        stats.pending_lines += batch.lines;
+    }
+    stats.pending_batches = ready_.size();
+    return stats;
+}
+
+bool InfluxWriteBatcher::compresses() const {
+    return options_.gzip;
+}
+
+void InfluxWriteBatcher::run() {
+#ifdef __linux__
+    // Compression and sending are background work; let request threads win the CPU
+    setpriority(PRIO_PROCESS, static_cast<id_t>(::syscall(SYS_gettid)), 10);
+#endif
+
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (true) {
+        if (ready_.empty()) {
+            const auto deadline = open_since_ + options_.flush_interval;
+            if (open_lines_ > 0 && (stopping_ || std::chrono::steady_clock::now() >= deadline)) {
+                seal_locked();
+                continue;
+            }
+            if (stopping_) {
+                break;
+            }
+            if (open_lines_ > 0) {
+                work_cv_.wait_until(lock, deadline);
+            } else {
+                work_cv_.wait(lock);
+            }
+            continue;
+        }
+
+        Batch batch = std::move(ready_.front());
+        ready_.pop_front();
+        in_flight_ = true;
+        deliver(lock, batch);
+        in_flight_ = false;
+        finished_batches_++;
+        recycle_locked(std::move(batch.body));
+        idle_cv_.notify_all();
+    }
+}
+
+bool InfluxWriteBatcher::deliver(std::unique_lock<std::mutex>& lock, Batch& batch) {
+    lock.unlock();
+    std::string_view body = batch.body;
+    bool gzipped = false;
+    if (options_.gzip && compressor_->compress(batch.body)) {
+        body = compressor_->output();
+        gzipped = true;
+    }
+
+    size_t attempts = 0;
+    while (true) {
+        // transport_ is only replaced while no send is in flight
+        auto started = std::chrono::steady_clock::now();
+        bool sent = transport_ && transport_(body, gzipped);
+        double send_ms = elapsed_ms(started);
+
+        lock.lock();
+        stats_.last_send_ms = send_ms;
+        stats_.max_send_ms = std::max(stats_.max_send_ms, send_ms);
+        if (sent) {
+            stats_.lines_sent += batch.lines;
+            stats_.batches_sent++;
+            stats_.bytes_sent += body.size();
+            return true;
+        }
+
+        // Retrying only makes sense while newer data is not already being shed
+        if (attempts++ >= options_.max_retries || stopping_ ||
+            ready_.size() >= options_.max_pending_batches) {
+            stats_.batches_failed++;
+            stats_.lines_dropped += batch.lines;
+            return false;
+        }
+        work_cv_.wait_for(lock, options_.retry_delay, [this] {
+            return stopping_ || ready_.size() >= options_.max_pending_batches;
+        });
+        lock.unlock();
+    }
+}
+
+} // namespace metrics
+} // namespace aimux
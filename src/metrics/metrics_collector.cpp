@@ -5,6 +5,7 @@
 #include <sstream>
 #include <iomanip>
 #include <numeric>
+#include <string_view>
 
 namespace aimux {
 namespace metrics {
@@ -97,9 +98,139 @@ PrettificationEvent PrettificationEvent::from_json(const nlohmann::json& j) {
     return event;
 }
 
+// MetricsCollector internals
+
+namespace {
+
+std::atomic<uint64_t> next_collector_id{1};
+
+} // namespace
+
+struct MetricsCollector::Series {
+    std::string name;
+    MetricType type = MetricType::COUNTER;
+    Tags tags;
+    std::atomic<bool> exported{false};      // Registered through register_metric(), not only raw events
+    std::atomic<double> last_value{0.0};    // Gauges report the latest value
+};
+
+/// One thread's running totals for one series; written only by that thread
+struct MetricsCollector::SeriesCell {
+    explicit SeriesCell(bool with_histogram)
+        : histogram(with_histogram ? std::make_unique<LatencyHistogram>() : nullptr) {}
+
+    static uint64_t histogram_units(double value) {
+        double scaled = value * HISTOGRAM_SCALE;
+        if (!(scaled > 0.0)) {
+            return 0;
+        }
+        if (scaled >= static_cast<double>(LatencyHistogram::MAX_TRACKABLE)) {
+            return LatencyHistogram::MAX_TRACKABLE;
+        }
+        return static_cast<uint64_t>(std::llround(scaled));
+    }
+
+    void record(double value) {
+        sum.store(sum.load(std::memory_order_relaxed) + value, std::memory_order_relaxed);
+        sum_squares.store(sum_squares.load(std::memory_order_relaxed) + value * value,
+                          std::memory_order_relaxed);
+        if (value < min.load(std::memory_order_relaxed)) {
+            min.store(value, std::memory_order_relaxed);
+        }
+        if (value > max.load(std::memory_order_relaxed)) {
+            max.store(value, std::memory_order_relaxed);
+        }
+        if (histogram) {
+            histogram->record(histogram_units(value));
+        }
+        count.store(count.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+    }
+
+    /// Fold another cell in; only used by the merger on cells it owns
+    void absorb(const SeriesCell& other) {
+        sum.store(sum.load(std::memory_order_relaxed) + other.sum.load(std::memory_order_relaxed),
+                  std::memory_order_relaxed);
+        sum_squares.store(sum_squares.load(std::memory_order_relaxed) +
+                          other.sum_squares.load(std::memory_order_relaxed), std::memory_order_relaxed);
+        min.store(std::min(min.load(std::memory_order_relaxed), other.min.load(std::memory_order_relaxed)),
+                  std::memory_order_relaxed);
+        max.store(std::max(max.load(std::memory_order_relaxed), other.max.load(std::memory_order_relaxed)),
+                  std::memory_order_relaxed);
+        if (histogram && other.histogram) {
+            histogram->merge_from(*other.histogram);
+        }
+        count.store(count.load(std::memory_order_relaxed) + other.count.load(std::memory_order_acquire),
+                    std::memory_order_relaxed);
+    }
+
+    std::atomic<uint64_t> count{0};
+    std::atomic<double> sum{0.0};
+    std::atomic<double> sum_squares{0.0};
+    std::atomic<double> min{std::numeric_limits<double>::infinity()};
+    std::atomic<double> max{-std::numeric_limits<double>::infinity()};
+    std::unique_ptr<LatencyHistogram> histogram;   // Null for counters
+};
+
+struct MetricsCollector::ThreadShard {
+    explicit ThreadShard(size_t capacity) : cells(capacity) {}
+
+    ~ThreadShard() {
+        for (auto& cell : cells) {
+            delete cell.load(std::memory_order_relaxed);
+        }
+    }
+
+    std::vector<std::atomic<SeriesCell*>> cells;   // Indexed by series id, created on first record
+    std::atomic<bool> retired{false};              // Owning thread has exited
+    std::atomic<bool> collector_alive{true};
+};
+
+/// Merged totals of one series across all threads; immutable once published
+struct MetricsCollector::SeriesAggregate {
+    explicit SeriesAggregate(bool with_histogram)
+        : histogram(with_histogram ? std::make_unique<LatencyHistogram>() : nullptr) {}
+
+    void add(const SeriesCell& cell) {
+        uint64_t n = cell.count.load(std::memory_order_acquire);
+        if (n == 0) {
+            return;
+        }
+        count += n;
+        sum += cell.sum.load(std::memory_order_relaxed);
+        sum_squares += cell.sum_squares.load(std::memory_order_relaxed);
+        min = std::min(min, cell.min.load(std::memory_order_relaxed));
+        max = std::max(max, cell.max.load(std::memory_order_relaxed));
+        if (histogram && cell.histogram) {
+            histogram->merge_from(*cell.histogram);
+        }
+    }
+
+    uint64_t count = 0;
+    double sum = 0.0;
+    double sum_squares = 0.0;
+    double min = std::numeric_limits<double>::infinity();
+    double max = -std::numeric_limits<double>::infinity();
+    std::unique_ptr<LatencyHistogram> histogram;
+};
+
+struct MetricsCollector::MergedView {
+    std::vector<std::shared_ptr<const SeriesAggregate>> series;   // Indexed by series id
+};
+
+/// Merger-only bookkeeping, guarded by merge_mutex_
+struct MetricsCollector::MergeState {
+    std::vector<std::unique_ptr<SeriesCell>> retired;   // Cells of threads that have exited
+    std::vector<uint64_t> exported_count;
+    std::vector<double> exported_sum;
+};
+
 // MetricsCollector implementation
 MetricsCollector::MetricsCollector(const Config& config)
-    : config_(config) {
+    : config_(config),
+      max_series_(std::clamp<size_t>(config.max_series, 1, MetricHandle::INVALID - 1)),
+      instance_id_(next_collector_id.fetch_add(1, std::memory_order_relaxed)),
+      series_(max_series_),
+      merge_state_(std::make_unique<MergeState>()) {
     if (config_.enable_real_time) {
         start_collection();
     }
@@ -107,7 +238,140 @@ MetricsCollector::MetricsCollector(const Config& config)
 
 MetricsCollector::~MetricsCollector() {
     stop_collection();
-    flush();
+
+    // Threads still holding a shard drop it on their next record into another collector
+    std::lock_guard<std::mutex> lock(shards_mutex_);
+    for (auto& shard : shards_) {
+        shard->collector_alive.store(false, std::memory_order_release);
+    }
+}
+
+MetricHandle MetricsCollector::register_metric(const std::string& name, MetricType type, const Tags& tags) {
+    return intern_series(name, type, tags, true);
+}
+
+MetricHandle MetricsCollector::intern_series(const std::string& name, MetricType type,
+                                             const Tags& tags, bool exported) {
+    std::vector<std::pair<std::string_view, std::string_view>> sorted_tags(tags.begin(), tags.end());
+    std::sort(sorted_tags.begin(), sorted_tags.end());
+
+    std::string key;
+    key.reserve(name.size() + 2 + sorted_tags.size() * 16);
+    key += static_cast<char>('0' + static_cast<int>(type));
+    key += '\x1f';
+    key += name;
+    for (const auto& [tag, value] : sorted_tags) {
+        key += '\x1f';
+        key += tag;
+        key += '=';
+        key += value;
+    }
+
+    {
+        std::shared_lock<std::shared_mutex> lock(registry_mutex_);
+        auto it = series_ids_.find(key);
+        if (it != series_ids_.end()) {
+            Series& series = *series_[it->second];
+            if (exported && !series.exported.load(std::memory_order_relaxed)) {
+                series.exported.store(true, std::memory_order_relaxed);
+            }
+            return MetricHandle(it->second, type);
+        }
+    }
+
+    std::unique_lock<std::shared_mutex> lock(registry_mutex_);
+    auto it = series_ids_.find(key);
+    if (it != series_ids_.end()) {
+        if (exported) {
+            series_[it->second]->exported.store(true, std::memory_order_relaxed);
+        }
+        return MetricHandle(it->second, type);
+    }
+
+    uint32_t id = series_count_.load(std::memory_order_relaxed);
+    if (id >= max_series_) {
+        dropped_series_.fetch_add(1, std::memory_order_relaxed);
+        return MetricHandle();
+    }
+
+    auto series = std::make_unique<Series>();
+    series->name = name;
+    series->type = type;
+    series->tags = tags;
+    series->exported.store(exported, std::memory_order_relaxed);
+    series_[id] = std::move(series);
+    series_ids_.emplace(std::move(key), id);
+    series_by_name_[name].push_back(id);
+    series_count_.store(id + 1, std::memory_order_release);
+    return MetricHandle(id, type);
+}
+
+MetricsCollector::ThreadShard& MetricsCollector::local_shard() {
+    struct ShardCache {
+        uint64_t last_id = 0;
+        ThreadShard* last = nullptr;
+        std::vector<std::pair<uint64_t, std::shared_ptr<ThreadShard>>> shards;
+
+        ~ShardCache() {
+            for (auto& entry : shards) {
+                entry.second->retired.store(true, std::memory_order_release);
+            }
+        }
+    };
+    thread_local ShardCache cache;
+
+    if (cache.last_id == instance_id_) {
+        return *cache.last;
+    }
+    for (auto& [id, shard] : cache.shards) {
+        if (id == instance_id_) {
+            cache.last_id = id;
+            cache.last = shard.get();
+            return *shard;
+        }
+    }
+
+    std::erase_if(cache.shards, [](const auto& entry) {
+        return !entry.second->collector_alive.load(std::memory_order_acquire);
+    });
+
+    auto shard = std::make_shared<ThreadShard>(max_series_);
+    {
+        std::lock_guard<std::mutex> lock(shards_mutex_);
+        shards_.push_back(shard);
+    }
+    cache.shards.emplace_back(instance_id_, shard);
+    cache.last_id = instance_id_;
+    cache.last = shard.get();
+    return *shard;
+}
+
+bool MetricsCollector::record_value(MetricHandle handle, double value) {
+    if (!handle.valid() || handle.id_ >= series_count_.load(std::memory_order_acquire)) {
+        return false;
+    }
+
+    auto& slot = local_shard().cells[handle.id_];
+    SeriesCell* cell = slot.load(std::memory_order_relaxed);
+    if (!cell) {
+        cell = new SeriesCell(handle.type_ != MetricType::COUNTER);
+        slot.store(cell, std::memory_order_release);
+    }
+    cell->record(value);
+
+    if (handle.type_ == MetricType::GAUGE) {
+        series_[handle.id_]->last_value.store(value, std::memory_order_relaxed);
+    }
+    return true;
+}
+
+void MetricsCollector::record(MetricHandle handle, double value) {
+    if (!collecting_.load(std::memory_order_relaxed)) return;
+
+    if (record_value(handle, value) && metric_callback_) {
+        const Series& series = *series_[handle.id_];
+        metric_callback_(create_metric_point(series.name, series.type, value, series.tags));
+    }
 }
 
 void MetricsCollector::record_counter(const std::string& name, double value,
@@ -121,43 +385,34 @@ void MetricsCollector::record_counter(const std::string& name, double value,
         }
     }
 
-    auto point = create_metric_point(name, MetricType::COUNTER, value, tags);
-    record_event(point);
+    record(register_metric(name, MetricType::COUNTER, tags), value);
 }
 
 void MetricsCollector::record_gauge(const std::string& name, double value,
                                    const std::unordered_map<std::string, std::string>& tags) {
-    auto point = create_metric_point(name, MetricType::GAUGE, value, tags);
-    record_event(point);
+    record(register_metric(name, MetricType::GAUGE, tags), value);
 }
 
 void MetricsCollector::record_histogram(const std::string& name, double value,
                                        const std::unordered_map<std::string, std::string>& tags) {
-    auto point = create_metric_point(name, MetricType::HISTOGRAM, value, tags);
-    record_event(point);
+    record(register_metric(name, MetricType::HISTOGRAM, tags), value);
 }
 
 void MetricsCollector::record_timer(const std::string& name, std::chrono::nanoseconds duration,
                                    const std::unordered_map<std::string, std::string>& tags) {
-    double value_ms = std::chrono::duration<double, std::milli>(duration).count();
-    auto point = create_metric_point(name, MetricType::TIMER, value_ms, tags);
-    record_event(point);
+    record(register_metric(name, MetricType::TIMER, tags), duration);
 }
 
 void MetricsCollector::record_event(const MetricPoint& event) {
     if (!collecting_.load()) return;
 
-    {
-        std::lock_guard<std::mutex> lock(metrics_mutex_);
+    if (metrics_buffer_.size() < config_.buffer_size) {
         metrics_buffer_.push(event);
-
-        // Prevent buffer overflow
-        while (metrics_buffer_.size() > config_.buffer_size) {
-            metrics_buffer_.pop();
-        }
+    } else {
+        dropped_points_.fetch_add(1, std::memory_order_relaxed);
     }
 
-    update_real_time_aggregation(event);
+    record_value(intern_series(event.name, event.type, event.tags, false), event.value);
 
     if (metric_callback_) {
         metric_callback_(event);
@@ -167,14 +422,10 @@ void MetricsCollector::record_event(const MetricPoint& event) {
 void MetricsCollector::record_prettification_event(const PrettificationEvent& event) {
     if (!collecting_.load()) return;
 
-    {
-        std::lock_guard<std::mutex> lock(events_mutex_);
+    if (events_buffer_.size() < config_.buffer_size) {
         events_buffer_.push(event);
-
-        // Prevent buffer overflow
-        while (events_buffer_.size() > config_.buffer_size) {
-            events_buffer_.pop();
-        }
+    } else {
+        dropped_points_.fetch_add(1, std::memory_order_relaxed);
     }
 
     if (event_callback_) {
@@ -217,47 +468,66 @@ MetricStatistics MetricsCollector::get_statistics(
 std::vector<MetricStatistics> MetricsCollector::get_real_time_stats(const std::vector<std::string>& metric_names) const {
     std::vector<MetricStatistics> stats;
 
-    std::lock_guard<std::mutex> lock(aggregation_mutex_);
+    {
+        std::lock_guard<std::mutex> lock(merge_mutex_);
+        merge_shards();
+    }
+    auto view = merged_.load(std::memory_order_acquire);
+    if (!view) {
+        return stats;
+    }
 
     for (const auto& name : metric_names) {
-        auto it = recent_values_.find(name);
-        if (it != recent_values_.end() && !it->second.empty()) {
-            const auto& values = it->second;
-
-            MetricStatistics stat;
-            stat.name = name;
-            stat.type = MetricType::GAUGE;
-            stat.count = values.size();
-            stat.sum = std::accumulate(values.begin(), values.end(), 0.0);
-            stat.mean = stat.sum / stat.count;
-            stat.min = *std::min_element(values.begin(), values.end());
-            stat.max = *std::max_element(values.begin(), values.end());
-
-            // Calculate percentiles
-            auto sorted_values = values;
-            std::sort(sorted_values.begin(), sorted_values.end());
-
-            if (!sorted_values.empty()) {
-                auto percentile = [&](double p) {
-                    size_t index = static_cast<size_t>(p * (sorted_values.size() - 1));
-                    return sorted_values[index];
-                };
-
-                stat.median = percentile(0.5);
-                stat.p95 = percentile(0.95);
-                stat.p99 = percentile(0.99);
-
-                // Calculate standard deviation
-                double variance = 0.0;
-                for (double value : values) {
-                    variance += (value - stat.mean) * (value - stat.mean);
+        std::vector<uint32_t> ids;
+        {
+            std::shared_lock<std::shared_mutex> lock(registry_mutex_);
+            auto it = series_by_name_.find(name);
+            if (it != series_by_name_.end()) {
+                ids = it->second;
+            }
+        }
+
+        MetricStatistics stat;
+        stat.name = name;
+        std::unique_ptr<LatencyHistogram> histogram;
+        uint64_t count = 0;
+        double sum_squares = 0.0;
+        for (uint32_t id : ids) {
+            if (id >= view->series.size() || !view->series[id] || view->series[id]->count == 0) {
+                continue;
+            }
+            const SeriesAggregate& aggregate = *view->series[id];
+            if (count == 0) {
+                stat.type = series_[id]->type;
+            }
+            count += aggregate.count;
+            stat.sum += aggregate.sum;
+            sum_squares += aggregate.sum_squares;
+            stat.min = std::min(stat.min, aggregate.min);
+            stat.max = std::max(stat.max, aggregate.max);
+            if (aggregate.histogram) {
+                if (!histogram) {
+                    histogram = std::make_unique<LatencyHistogram>();
                 }
-                variance /= stat.count;
-                stat.std_dev = std::sqrt(variance);
+                histogram->merge_from(*aggregate.histogram);
             }
+        }
+        if (count == 0) {
+            continue;
+        }
 
-            stats.push_back(stat);
+        stat.count = static_cast<double>(count);
+        stat.mean = stat.sum / stat.count;
+        stat.std_dev = std::sqrt(std::max(0.0, sum_squares / stat.count - stat.mean * stat.mean));
+        if (histogram) {
+            auto percentile = [&](double p) {
+                return std::clamp(histogram->percentile(p) / HISTOGRAM_SCALE, stat.min, stat.max);
+            };
+            stat.median = percentile(50.0);
+            stat.p95 = percentile(95.0);
+            stat.p99 = percentile(99.0);
         }
+        stats.push_back(stat);
     }
 
     return stats;
@@ -282,15 +552,18 @@ void MetricsCollector::start_collection() {
 
     collecting_ = true;
     should_stop_.store(false);
-    processor_thread_ = std::thread(&MetricsCollector::process_batch, this);
+    processor_thread_ = std::thread(&MetricsCollector::collection_loop, this);
 }
 
 void MetricsCollector::stop_collection() {
     if (!collecting_.load()) return;
 
     collecting_ = false;
-    should_stop_.store(true);
-    processor_cv_.notify_one();
+    {
+        std::lock_guard<std::mutex> lock(processor_mutex_);
+        should_stop_.store(true);
+    }
+    processor_cv_.notify_all();
 
     if (processor_thread_.joinable()) {
         processor_thread_.join();
@@ -307,6 +580,7 @@ void MetricsCollector::clear_old_data() {
 
 void MetricsCollector::update_config(const Config& config) {
     config_ = config;
+    config_.max_series = max_series_;
 }
 
 nlohmann::json MetricsCollector::get_status() const {
@@ -315,64 +589,192 @@ nlohmann::json MetricsCollector::get_status() const {
     status["buffer_size"] = config_.buffer_size;
     status["flush_interval_ms"] = config_.flush_interval.count();
     status["sampling_rate"] = config_.sampling_rate;
+    status["metrics_buffer_size"] = metrics_buffer_.size();
+    status["events_buffer_size"] = events_buffer_.size();
+    status["dropped_points"] = dropped_points_.load(std::memory_order_relaxed);
 
     {
-        std::lock_guard<std::mutex> lock(metrics_mutex_);
-        status["metrics_buffer_size"] = metrics_buffer_.size();
+        std::shared_lock<std::shared_mutex> lock(registry_mutex_);
+        status["real_time_metrics_count"] = series_by_name_.size();
     }
+    status["series_count"] = series_count_.load(std::memory_order_relaxed);
+    status["max_series"] = max_series_;
+    status["dropped_series"] = dropped_series_.load(std::memory_order_relaxed);
 
     {
-        std::lock_guard<std::mutex> lock(events_mutex_);
-        status["events_buffer_size"] = events_buffer_.size();
+        std::lock_guard<std::mutex> lock(shards_mutex_);
+        status["recording_threads"] = shards_.size();
     }
 
+    return status;
+}
+
+void MetricsCollector::merge_shards() const {
+    MergeState& state = *merge_state_;
+
+    std::vector<std::shared_ptr<ThreadShard>> live;
+    std::vector<std::shared_ptr<ThreadShard>> retired;
     {
-        std::lock_guard<std::mutex> lock(aggregation_mutex_);
-        status["real_time_metrics_count"] = recent_values_.size();
+        std::lock_guard<std::mutex> lock(shards_mutex_);
+        for (auto& shard : shards_) {
+            (shard->retired.load(std::memory_order_acquire) ? retired : live).push_back(shard);
+        }
+        if (!retired.empty()) {
+            shards_ = live;
+        }
     }
 
-    return status;
-}
+    uint32_t count = series_count_.load(std::memory_order_acquire);
+    if (state.retired.size() < count) {
+        state.retired.resize(count);
+    }
 
-void MetricsCollector::process_batch() {
-    while (!should_stop_.load()) {
-        std::vector<MetricPoint> metrics_batch;
-        std::vector<PrettificationEvent> events_batch;
+    // An exited thread never writes again, so its cells move into the merger's own totals
+    for (const auto& shard : retired) {
+        for (uint32_t id = 0; id < shard->cells.size() && id < count; ++id) {
+            SeriesCell* cell = shard->cells[id].load(std::memory_order_acquire);
+            if (!cell) {
+                continue;
+            }
+            if (!state.retired[id]) {
+                state.retired[id] = std::make_unique<SeriesCell>(cell->histogram != nullptr);
+            }
+            state.retired[id]->absorb(*cell);
+        }
+    }
 
-        // Collect metrics batch
-        {
-            std::lock_guard<std::mutex> lock(metrics_mutex_);
-            while (!metrics_buffer_.empty() && metrics_batch.size() < config_.buffer_size) {
-                metrics_batch.push_back(metrics_buffer_.front());
-                metrics_buffer_.pop();
+    auto previous = merged_.load(std::memory_order_acquire);
+    auto view = std::make_shared<MergedView>();
+    if (previous) {
+        view->series = previous->series;
+    }
+    bool changed = view->series.size() != count;
+    view->series.resize(count);
+
+    for (uint32_t id = 0; id < count; ++id) {
+        const SeriesCell* retired_cell = state.retired[id].get();
+        uint64_t total = retired_cell ? retired_cell->count.load(std::memory_order_relaxed) : 0;
+        for (const auto& shard : live) {
+            if (const SeriesCell* cell = shard->cells[id].load(std::memory_order_acquire)) {
+                total += cell->count.load(std::memory_order_acquire);
             }
         }
 
-        // Collect events batch
-        {
-            std::lock_guard<std::mutex> lock(events_mutex_);
-            while (!events_buffer_.empty() && events_batch.size() < config_.buffer_size) {
-                events_batch.push_back(events_buffer_.front());
-                events_buffer_.pop();
+        uint64_t merged_count = view->series[id] ? view->series[id]->count : 0;
+        if (total == merged_count) {
+            continue;
+        }
+
+        auto aggregate = std::make_shared<SeriesAggregate>(series_[id]->type != MetricType::COUNTER);
+        if (retired_cell) {
+            aggregate->add(*retired_cell);
+        }
+        for (const auto& shard : live) {
+            if (const SeriesCell* cell = shard->cells[id].load(std::memory_order_acquire)) {
+                aggregate->add(*cell);
             }
         }
+        view->series[id] = std::move(aggregate);
+        changed = true;
+    }
+
+    if (changed) {
+        merged_.store(std::move(view), std::memory_order_release);
+    }
+}
+
+void MetricsCollector::export_aggregates(std::vector<MetricPoint>& points) {
+    MergeState& state = *merge_state_;
+    auto view = merged_.load(std::memory_order_acquire);
+    if (!view) {
+        return;
+    }
+    if (state.exported_count.size() < view->series.size()) {
+        state.exported_count.resize(view->series.size(), 0);
+        state.exported_sum.resize(view->series.size(), 0.0);
+    }
+
+    auto now = std::chrono::system_clock::now();
+    for (uint32_t id = 0; id < view->series.size(); ++id) {
+        const auto& aggregate = view->series[id];
+        const Series& series = *series_[id];
+        if (!aggregate || !series.exported.load(std::memory_order_relaxed) ||
+            aggregate->count == state.exported_count[id]) {
+            continue;
+        }
 
-        // Store batches
-        if (!metrics_batch.empty()) {
-            store_metrics(metrics_batch);
+        double count = static_cast<double>(aggregate->count - state.exported_count[id]);
+        double sum = aggregate->sum - state.exported_sum[id];
+        state.exported_count[id] = aggregate->count;
+        state.exported_sum[id] = aggregate->sum;
+
+        double value = sum / count;
+        if (series.type == MetricType::COUNTER) {
+            value = sum;
+        } else if (series.type == MetricType::GAUGE) {
+            value = series.last_value.load(std::memory_order_relaxed);
         }
 
-        if (!events_batch.empty()) {
-            store_events(events_batch);
+        MetricPoint point = create_metric_point(series.name, series.type, value, series.tags);
+        point.timestamp = now;
+        point.fields["count"] = count;
+        point.fields["sum"] = sum;
+        if (aggregate->histogram) {
+            point.fields["min"] = aggregate->min;
+            point.fields["max"] = aggregate->max;
+            point.fields["p50"] = std::clamp(aggregate->histogram->percentile(50.0) / HISTOGRAM_SCALE,
+                                             aggregate->min, aggregate->max);
+            point.fields["p95"] = std::clamp(aggregate->histogram->percentile(95.0) / HISTOGRAM_SCALE,
+                                             aggregate->min, aggregate->max);
+            point.fields["p99"] = std::clamp(aggregate->histogram->percentile(99.0) / HISTOGRAM_SCALE,
+                                             aggregate->min, aggregate->max);
         }
+        points.push_back(std::move(point));
+    }
+}
+
+void MetricsCollector::process_batch() {
+    std::lock_guard<std::mutex> batch_lock(batch_mutex_);
+
+    std::vector<MetricPoint> metrics_batch;
+    std::vector<PrettificationEvent> events_batch;
+
+    {
+        std::lock_guard<std::mutex> lock(merge_mutex_);
+        merge_shards();
+        export_aggregates(metrics_batch);
+    }
+
+    metrics_buffer_.drain([&](MetricPoint&& point) {
+        metrics_batch.push_back(std::move(point));
+    });
+    events_buffer_.drain([&](PrettificationEvent&& event) {
+        events_batch.push_back(std::move(event));
+    });
+
+    // Store batches
+    if (!metrics_batch.empty()) {
+        store_metrics(metrics_batch);
+    }
+
+    if (!events_batch.empty()) {
+        store_events(events_batch);
+    }
+}
 
-        // Wait for next flush interval or stop signal
-        std::unique_lock<std::mutex> lock(metrics_mutex_);
+void MetricsCollector::collection_loop() {
+    std::unique_lock<std::mutex> lock(processor_mutex_);
+    while (!should_stop_.load()) {
         processor_cv_.wait_for(lock, config_.flush_interval, [this] {
-            return should_stop_.load() ||
-                   !metrics_buffer_.empty() ||
-                   !events_buffer_.empty();
+            return should_stop_.load();
         });
+        if (should_stop_.load()) {
+            break;
+        }
+
+        lock.unlock();
+        process_batch();
+        lock.lock();
     }
 }
 
@@ -398,38 +800,15 @@ MetricPoint MetricsCollector::create_metric_point(
     return point;
 }
 
-void MetricsCollector::update_real_time_aggregation(const MetricPoint& point) {
-    std::lock_guard<std::mutex> lock(aggregation_mutex_);
-
-    auto& values = recent_values_[point.name];
-    values.push_back(point.value);
-
-    // Keep only recent values (last 1000 for efficiency)
-    if (values.size() > 1000) {
-        values.erase(values.begin(), values.begin() + static_cast<std::ptrdiff_t>(values.size() - 1000));
-    }
-
-    last_update_[point.name] = point.timestamp;
-}
-
-std::vector<double> MetricsCollector::calculate_percentiles(const std::vector<double>& values) const {
-    if (values.empty()) return {};
-
-    auto sorted_values = values;
-    std::sort(sorted_values.begin(), sorted_values.end());
-
-    auto percentile = [&](double p) {
-        size_t index = static_cast<size_t>(p * (sorted_values.size() - 1));
-        return sorted_values[index];
-    };
-
-    return {percentile(0.5), percentile(0.95), percentile(0.99)};
-}
-
 // InMemoryMetricsCollector implementation
 InMemoryMetricsCollector::InMemoryMetricsCollector(const Config& config)
     : MetricsCollector(config) {}
 
+InMemoryMetricsCollector::~InMemoryMetricsCollector() {
+    stop_collection();
+    flush();
+}
+
 void InMemoryMetricsCollector::clear_stored_data() {
     std::lock_guard<std::mutex> lock(storage_mutex_);
     stored_metrics_.clear();
@@ -1,4 +1,5 @@
 #include "aimux/metrics/time_series_db.hpp"
+#include "aimux/metrics/columnar_tsdb.hpp"
 #include <algorithm>
 #include <sstream>
 #include <iomanip>
@@ -137,46 +138,48 @@ void TimeSeriesDB::write_metrics_async(const std::vector<MetricPoint>& metrics)
     AsyncWriteRequest request;
     request.type = AsyncWriteRequest::METRICS;
     request.metrics = metrics;
-
-    {
-        std::lock_guard<std::mutex> lock(async_mutex_);
-        async_write_queue_.push(request);
-    }
-    async_cv_.notify_one();
+    enqueue_async_write(std::move(request));
 }
 
 void TimeSeriesDB::write_events_async(const std::vector<PrettificationEvent>& events) {
     AsyncWriteRequest request;
     request.type = AsyncWriteRequest::EVENTS;
     request.events = events;
+    enqueue_async_write(std::move(request));
+}
 
+void TimeSeriesDB::enqueue_async_write(AsyncWriteRequest request) {
     {
         std::lock_guard<std::mutex> lock(async_mutex_);
-        async_write_queue_.push(request);
+        async_write_queue_.push(std::move(request));
+        if (async_drain_scheduled_) {
+            return;   // The running drain picks it up
+        }
+        async_drain_scheduled_ = true;
+    }
+
+    if (!async_pool_ || should_stop_async_ || !async_pool_->post([this] { process_async_writes(); })) {
+        process_async_writes();
     }
-    async_cv_.notify_one();
 }
 
 void TimeSeriesDB::process_async_writes() {
     std::queue<AsyncWriteRequest> local_queue;
 
-    while (!should_stop_async_) {
+    while (true) {
         {
-            std::unique_lock<std::mutex> lock(async_mutex_);
-            async_cv_.wait(lock, [this] {
-                return !async_write_queue_.empty() || should_stop_async_;
-            });
-
-            // Move all pending requests to local queue
-            while (!async_write_queue_.empty()) {
-                local_queue.push(async_write_queue_.front());
-                async_write_queue_.pop();
+            std::lock_guard<std::mutex> lock(async_mutex_);
+            if (async_write_queue_.empty()) {
+                async_drain_scheduled_ = false;
+                async_cv_.notify_all();
+                return;
             }
+            local_queue.swap(async_write_queue_);
         }
 
         // Process requests outside of lock
         while (!local_queue.empty()) {
-            auto request = local_queue.front();
+            auto request = std::move(local_queue.front());
             local_queue.pop();
 
             bool success = false;
@@ -199,23 +202,30 @@ void TimeSeriesDB::process_async_writes() {
 
 void TimeSeriesDB::start_async_worker() {
     should_stop_async_ = false;
-    async_worker_ = std::thread(&TimeSeriesDB::process_async_writes, this);
+    async_pool_ = core::ThreadPool::shared();
 }
 
 void TimeSeriesDB::stop_async_worker() {
     should_stop_async_ = true;
-    async_cv_.notify_one();
 
-    if (async_worker_.joinable()) {
-        async_worker_.join();
-    }
+    // Let an in-progress drain finish what was queued before we go away
+    std::unique_lock<std::mutex> lock(async_mutex_);
+    async_cv_.wait(lock, [this] { return !async_drain_scheduled_; });
 }
 
 // InfluxDB2Client implementation
 InfluxDB2Client::InfluxDB2Client(const TSDBConfig& config)
-    : TimeSeriesDB(config) {}
+    : TimeSeriesDB(config) {
+    write_url_ = build_write_url();
+    write_batcher_ = std::make_unique<InfluxWriteBatcher>(
+        InfluxWriteBatcher::Options::from_config(config_),
+        [this](std::string_view body, bool gzipped) { return post_write_batch(body, gzipped); });
+}
 
 InfluxDB2Client::~InfluxDB2Client() {
+    stop_async_worker();
+    // Drains the last batch through post_write_batch() while the client is still whole
+    write_batcher_.reset();
     disconnect();
 }
 
@@ -437,6 +447,9 @@ nlohmann::json InfluxDB2Client::get_status() const {
         status["last_query_time_ms"] = last_query_time_ms_.load();
     }
 
+    status["compression"] = write_batcher_->compresses() ? "gzip" : "none";
+    status["writes"] = write_batcher_->get_stats().to_json();
+
     return status;
 }
 
@@ -446,21 +459,38 @@ double InfluxDB2Client::get_query_performance_ms() const {
 }
 
 bool InfluxDB2Client::write_metrics_sync(const std::vector<MetricPoint>& metrics) {
-    std::string line_protocol = format_metrics_for_influx(metrics);
-    if (line_protocol.empty()) return true;
-
-    nlohmann::json response;
-    std::string error;
-    return http_request("POST", build_write_url(), line_protocol, response, error);
+    return batched_write_ok(metrics.size(), write_batcher_->add(metrics));
 }
 
 bool InfluxDB2Client::write_events_sync(const std::vector<PrettificationEvent>& events) {
-    std::string line_protocol = format_events_for_influx(events);
-    if (line_protocol.empty()) return true;
+    return batched_write_ok(events.size(), write_batcher_->add(events));
+}
+
+bool InfluxDB2Client::batched_write_ok(size_t offered, size_t accepted) {
+    uint64_t dropped = write_batcher_->get_stats().lines_dropped;
+    bool no_new_drops = reported_drops_.exchange(dropped) == dropped;
+    return no_new_drops && (offered == 0 || accepted > 0);
+}
+
+void InfluxDB2Client::set_write_transport(InfluxWriteBatcher::Transport transport) {
+    if (!transport) {
+        transport = [this](std::string_view body, bool gzipped) { return post_write_batch(body, gzipped); };
+    }
+    write_batcher_->set_transport(std::move(transport));
+}
+
+bool InfluxDB2Client::flush_writes(std::chrono::milliseconds timeout) {
+    return write_batcher_->flush(timeout);
+}
 
+InfluxWriteStats InfluxDB2Client::get_write_stats() const {
+    return write_batcher_->get_stats();
+}
+
+bool InfluxDB2Client::post_write_batch(std::string_view body, bool gzipped) {
     nlohmann::json response;
     std::string error;
-    return http_request("POST", build_write_url(), line_protocol, response, error);
+    return http_request("POST", write_url_, body, response, error, gzipped ? "gzip" : "");
 }
 
 std::string InfluxDB2Client::build_write_url() const {
@@ -477,75 +507,6 @@ std::string InfluxDB2Client::build_query_url() const {
     return url.str();
 }
 
-std::string InfluxDB2Client::format_metrics_for_influx(const std::vector<MetricPoint>& metrics) const {
-    std::stringstream result;
-
-    for (const auto& metric : metrics) {
-        // Write measurement name
-        result << metric.name;
-
-        // Write tags
-        if (!metric.tags.empty()) {
-            result << ",";
-            bool first = true;
-            for (const auto& [key, value] : metric.tags) {
-                if (!first) result << ",";
-                result << key << "=" << value;
-                first = false;
-            }
-        }
-
-        // Write fields
-        result << " ";
-        result << "value=" << metric.value;
-        if (!metric.fields.empty()) {
-            for (const auto& [key, value] : metric.fields) {
-                result << "," << key << "=" << value;
-            }
-        }
-
-        // Write timestamp
-        auto timestamp_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
-            metric.timestamp.time_since_epoch()).count();
-        result << " " << timestamp_ns;
-
-        result << "\n";
-    }
-
-    return result.str();
-}
-
-std::string InfluxDB2Client::format_events_for_influx(const std::vector<PrettificationEvent>& events) const {
-    std::stringstream result;
-
-    for (const auto& event : events) {
-        result << "prettification_events";
-        result << ",plugin=" << event.plugin_name;
-        result << ",provider=" << event.provider;
-        result << ",model=" << event.model;
-        result << ",input_format=" << event.input_format;
-        result << ",output_format=" << event.output_format;
-        result << " ";
-        result << "processing_time_ms=" << event.processing_time_ms;
-        result << ",input_size_bytes=" << event.input_size_bytes;
-        result << ",output_size_bytes=" << event.output_size_bytes;
-        result << ",success=" << (event.success ? "true" : "false");
-        result << ",tokens_processed=" << event.tokens_processed;
-
-        if (!event.error_type.empty()) {
-            result << ",error_type=\"" << event.error_type << "\"";
-        }
-
-        auto timestamp_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
-            event.timestamp.time_since_epoch()).count();
-        result << " " << timestamp_ns;
-
-        result << "\n";
-    }
-
-    return result.str();
-}
-
 MetricPoint InfluxDB2Client::parse_influx_point(const nlohmann::json& /*json_point*/) const {
     MetricPoint point;
     // Implementation would parse based on the JSON structure from InfluxDB
@@ -560,9 +521,10 @@ PrettificationEvent InfluxDB2Client::parse_influx_event(const nlohmann::json& /*
 
 bool InfluxDB2Client::http_request(const std::string& /*method*/,
                                   const std::string& /*endpoint*/,
-                                  const std::string& /*body*/,
+                                  std::string_view /*body*/,
                                   nlohmann::json& /*response*/,
-                                  std::string& /*error_msg*/) {
+                                  std::string& /*error_msg*/,
+                                  std::string_view /*content_encoding*/) {
     // This would implement actual HTTP client logic
     // For now, return success
     return true;
@@ -748,6 +710,8 @@ std::unique_ptr<TimeSeriesDB> TimeSeriesDBFactory::create(const std::string& bac
         return std::make_unique<InfluxDB2Client>(config);
     } else if (backend_type == "mock") {
         return std::make_unique<MockTimeSeriesDB>(config);
+    } else if (backend_type == "columnar") {
+        return std::make_unique<ColumnarTimeSeriesDB>(config);
     }
 
     auto it = backends_.find(backend_type);
@@ -763,7 +727,7 @@ void TimeSeriesDBFactory::register_backend(const std::string& name, BackendFacto
 }
 
 std::vector<std::string> TimeSeriesDBFactory::list_available_backends() {
-    std::vector<std::string> result = {"influxdb2", "mock"};
+    std::vector<std::string> result = {"influxdb2", "mock", "columnar"};
     for (const auto& [name, factory] : backends_) {
         result.push_back(name);
     }
@@ -0,0 +1,409 @@
+#include "aimux/network/curl_multi_engine.hpp"
+#include "aimux/logging/logger.hpp"
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <unistd.h>
+#include <algorithm>
+#include <array>
+#include <cerrno>
+#include <chrono>
+#include <cstring>
+#include <mutex>
+#include <thread>
+#include <unordered_set>
+#include <vector>
+
+namespace aimux {
+namespace network {
+
+namespace {
+    constexpr int MAX_EPOLL_EVENTS = 256;
+}
+
+struct CurlMultiEngine::Impl {
+    struct Transfer {
+        CURL* easy;
+        CompletionCallback on_complete;
+    };
+
+    struct Timer {
+        std::chrono::steady_clock::time_point deadline;
+        uint64_t sequence;      // Keeps equal deadlines in scheduling order
+        TimerCallback on_fire;
+
+        bool operator>(const Timer& other) const {
+            return deadline != other.deadline ? deadline > other.deadline : sequence > other.sequence;
+        }
+    };
+
+    CURLM* multi = nullptr;
+    int epoll_fd = -1;
+    int wake_fd = -1;
+    std::thread loop_thread;
+    std::atomic<bool> running{false};
+
+    // Handed over from submitting threads; drained by the loop thread only
+    std::mutex pending_mutex;
+    std::vector<Transfer*> pending;
+    std::vector<Timer> pending_timers;
+    uint64_t timer_sequence = 0;
+
+    // Loop-thread state
+    std::unordered_set<Transfer*> in_flight;
+    std::vector<Timer> timers;  // Min-heap on deadline
+    bool timer_armed = false;
+    std::chrono::steady_clock::time_point timer_deadline;
+
+    std::atomic<uint64_t> submitted{0};
+    std::atomic<uint64_t> completed{0};
+    std::atomic<uint64_t> failed{0};
+    std::atomic<uint64_t> active{0};
+    std::atomic<uint64_t> watched_sockets{0};
+    std::atomic<uint64_t> loop_wakeups{0};
+    std::atomic<uint64_t> timers_pending{0};
+    std::atomic<uint64_t> timers_fired{0};
+
+    explicit Impl(long max_total_connections) {
+        static std::once_flag curl_init_flag;
+        std::call_once(curl_init_flag, []() { curl_global_init(CURL_GLOBAL_DEFAULT); });
+
+        multi = curl_multi_init();
+        epoll_fd = epoll_create1(EPOLL_CLOEXEC);
+        wake_fd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+        if (!multi || epoll_fd < 0 || wake_fd < 0) {
+            aimux::error("CurlMultiEngine: failed to initialize event loop: " + std::string(std::strerror(errno)));
+            return;
+        }
+
+        epoll_event ev{};
+        ev.events = EPOLLIN;
+        ev.data.fd = wake_fd;
+        epoll_ctl(epoll_fd, EPOLL_CTL_ADD, wake_fd, &ev);
+
+        curl_multi_setopt(multi, CURLMOPT_SOCKETFUNCTION, socket_callback);
+        curl_multi_setopt(multi, CURLMOPT_SOCKETDATA, this);
+        curl_multi_setopt(multi, CURLMOPT_TIMERFUNCTION, timer_callback);
+        curl_multi_setopt(multi, CURLMOPT_TIMERDATA, this);
+        curl_multi_setopt(multi, CURLMOPT_PIPELINING, CURLPIPE_MULTIPLEX);
+        curl_multi_setopt(multi, CURLMOPT_MAX_TOTAL_CONNECTIONS, max_total_connections);
+
+        running.store(true);
+        loop_thread = std::thread([this]() { run_loop(); });
+    }
+
+    ~Impl() {
+        stop();
+        if (multi) {
+            curl_multi_cleanup(multi);
+        }
+        if (wake_fd >= 0) {
+            close(wake_fd);
+        }
+        if (epoll_fd >= 0) {
+            close(epoll_fd);
+        }
+    }
+
+    void stop() {
+        bool was_running = false;
+        {
+            // Serialized with submit() so nothing is queued after the final drain
+            std::lock_guard<std::mutex> lock(pending_mutex);
+            was_running = running.exchange(false);
+        }
+        if (was_running) {
+            wake();
+        }
+        if (loop_thread.joinable()) {
+            loop_thread.join();
+        }
+    }
+
+    void wake() {
+        uint64_t one = 1;
+        ssize_t written = write(wake_fd, &one, sizeof(one));
+        (void)written;
+    }
+
+    static int socket_callback(CURL* /*easy*/, curl_socket_t s, int what, void* userp, void* socketp) {
+        auto* self = static_cast<Impl*>(userp);
+
+        if (what == CURL_POLL_REMOVE) {
+            epoll_ctl(self->epoll_fd, EPOLL_CTL_DEL, s, nullptr);
+            if (socketp) {
+                curl_multi_assign(self->multi, s, nullptr);
+                self->watched_sockets--;
+            }
+            return 0;
+        }
+
+        epoll_event ev{};
+        ev.data.fd = s;
+        if (what & CURL_POLL_IN) {
+            ev.events |= EPOLLIN;
+        }
+        if (what & CURL_POLL_OUT) {
+            ev.events |= EPOLLOUT;
+        }
+
+        if (!socketp) {
+            // Descriptors can be recycled by the kernel before curl reports the removal
+            if (epoll_ctl(self->epoll_fd, EPOLL_CTL_ADD, s, &ev) != 0 && errno == EEXIST) {
+                epoll_ctl(self->epoll_fd, EPOLL_CTL_MOD, s, &ev);
+            }
+            curl_multi_assign(self->multi, s, self);
+            self->watched_sockets++;
+        } else {
+            epoll_ctl(self->epoll_fd, EPOLL_CTL_MOD, s, &ev);
+        }
+        return 0;
+    }
+
+    static int timer_callback(CURLM* /*multi*/, long timeout_ms, void* userp) {
+        auto* self = static_cast<Impl*>(userp);
+        if (timeout_ms < 0) {
+            self->timer_armed = false;
+        } else {
+            self->timer_armed = true;
+            self->timer_deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(timeout_ms);
+        }
+        return 0;
+    }
+
+    int next_wait_ms() const {
+        if (!timer_armed && timers.empty()) {
+            return -1;
+        }
+        auto deadline = timer_armed ? timer_deadline : timers.front().deadline;
+        if (!timers.empty() && timers.front().deadline < deadline) {
+            deadline = timers.front().deadline;
+        }
+        // Round up so a sub-millisecond remainder does not spin on epoll_wait(0)
+        auto remaining = std::chrono::ceil<std::chrono::milliseconds>(
+            deadline - std::chrono::steady_clock::now()).count();
+        return remaining > 0 ? static_cast<int>(remaining) : 0;
+    }
+
+    void fire_timer(TimerCallback& on_fire, bool fired) {
+        timers_pending--;
+        if (fired) {
+            timers_fired++;
+        }
+        try {
+            on_fire(fired);
+        } catch (const std::exception& e) {
+            aimux::error("CurlMultiEngine: timer callback threw: " + std::string(e.what()));
+        }
+    }
+
+    void run_due_timers() {
+        auto now = std::chrono::steady_clock::now();
+        while (!timers.empty() && timers.front().deadline <= now) {
+            // Callbacks may schedule again; those land in pending_timers, not here
+            std::pop_heap(timers.begin(), timers.end(), std::greater<Timer>());
+            TimerCallback on_fire = std::move(timers.back().on_fire);
+            timers.pop_back();
+            fire_timer(on_fire, true);
+        }
+    }
+
+    void add_pending() {
+        std::vector<Transfer*> batch;
+        std::vector<Timer> new_timers;
+        {
+            std::lock_guard<std::mutex> lock(pending_mutex);
+            batch.swap(pending);
+            new_timers.swap(pending_timers);
+        }
+        for (Timer& timer : new_timers) {
+            timers.push_back(std::move(timer));
+            std::push_heap(timers.begin(), timers.end(), std::greater<Timer>());
+        }
+        for (Transfer* transfer : batch) {
+            curl_easy_setopt(transfer->easy, CURLOPT_PRIVATE, transfer);
+            CURLMcode rc = curl_multi_add_handle(multi, transfer->easy);
+            if (rc != CURLM_OK) {
+                complete(transfer, CURLE_FAILED_INIT);
+                continue;
+            }
+            in_flight.insert(transfer);
+        }
+    }
+
+    void complete(Transfer* transfer, CURLcode result) {
+        active--;
+        completed++;
+        if (result != CURLE_OK) {
+            failed++;
+        }
+        try {
+            transfer->on_complete(result);
+        } catch (const std::exception& e) {
+            aimux::error("CurlMultiEngine: completion callback threw: " + std::string(e.what()));
+        }
+        delete transfer;
+    }
+
+    void drain_completions() {
+        int msgs_left = 0;
+        while (CURLMsg* msg = curl_multi_info_read(multi, &msgs_left)) {
+            if (msg->msg != CURLMSG_DONE) {
+                continue;
+            }
+            CURL* easy = msg->easy_handle;
+            CURLcode result = msg->data.result;
+            Transfer* transfer = nullptr;
+            curl_easy_getinfo(easy, CURLINFO_PRIVATE, reinterpret_cast<char**>(&transfer));
+            curl_multi_remove_handle(multi, easy);
+            if (transfer) {
+                in_flight.erase(transfer);
+                complete(transfer, result);
+            }
+        }
+    }
+
+    void run_loop() {
+        std::array<epoll_event, MAX_EPOLL_EVENTS> events{};
+        int still_running = 0;
+
+        while (running.load()) {
+            int n = epoll_wait(epoll_fd, events.data(), MAX_EPOLL_EVENTS, next_wait_ms());
+            if (n < 0) {
+                if (errno == EINTR) {
+                    continue;
+                }
+                aimux::error("CurlMultiEngine: epoll_wait failed: " + std::string(std::strerror(errno)));
+                std::lock_guard<std::mutex> lock(pending_mutex);
+                running.store(false);
+                break;
+            }
+            loop_wakeups++;
+
+            for (int i = 0; i < n; ++i) {
+                int fd = events[i].data.fd;
+                if (fd == wake_fd) {
+                    uint64_t count = 0;
+                    while (read(wake_fd, &count, sizeof(count)) > 0) {
+                    }
+                    add_pending();
+                    continue;
+                }
+
+                int flags = 0;
+                if (events[i].events & EPOLLIN) {
+                    flags |= CURL_CSELECT_IN;
+                }
+                if (events[i].events & EPOLLOUT) {
+                    flags |= CURL_CSELECT_OUT;
+                }
+                if (events[i].events & (EPOLLERR | EPOLLHUP)) {
+                    flags |= CURL_CSELECT_ERR;
+                }
+                curl_multi_socket_action(multi, fd, flags, &still_running);
+            }
+
+            if (timer_armed && std::chrono::steady_clock::now() >= timer_deadline) {
+                timer_armed = false;
+                curl_multi_socket_action(multi, CURL_SOCKET_TIMEOUT, 0, &still_running);
+            }
+
+            drain_completions();
+            run_due_timers();
+        }
+
+        // Cancel whatever is left so every submitter hears back exactly once
+        for (Transfer* transfer : in_flight) {
+            curl_multi_remove_handle(multi, transfer->easy);
+            complete(transfer, CURLE_ABORTED_BY_CALLBACK);
+        }
+        in_flight.clear();
+
+        std::vector<Transfer*> leftover;
+        std::vector<Timer> leftover_timers;
+        {
+            std::lock_guard<std::mutex> lock(pending_mutex);
+            leftover.swap(pending);
+            leftover_timers.swap(pending_timers);
+        }
+        for (Transfer* transfer : leftover) {
+            complete(transfer, CURLE_ABORTED_BY_CALLBACK);
+        }
+
+        for (Timer& timer : timers) {
+            fire_timer(timer.on_fire, false);
+        }
+        timers.clear();
+        for (Timer& timer : leftover_timers) {
+            fire_timer(timer.on_fire, false);
+        }
+    }
+};
+
+CurlMultiEngine::CurlMultiEngine(long max_total_connections)
+    : pImpl(std::make_unique<Impl>(max_total_connections)) {}
+
+CurlMultiEngine::~CurlMultiEngine() = default;
+
+CurlMultiEngine& CurlMultiEngine::instance() {
+    static CurlMultiEngine engine;
+    return engine;
+}
+
+bool CurlMultiEngine::submit(CURL* easy, CompletionCallback on_complete) {
+    if (!easy || !pImpl->running.load()) {
+        return false;
+    }
+
+    auto* transfer = new Impl::Transfer{easy, std::move(on_complete)};
+    {
+        std::lock_guard<std::mutex> lock(pImpl->pending_mutex);
+        if (!pImpl->running.load()) {
+            delete transfer;
+            return false;
+        }
+        pImpl->submitted++;
+        pImpl->active++;
+        pImpl->pending.push_back(transfer);
+    }
+    pImpl->wake();
+    return true;
+}
+
+bool CurlMultiEngine::schedule(std::chrono::milliseconds delay, TimerCallback on_fire) {
+    if (!on_fire || !pImpl->running.load()) {
+        return false;
+    }
+
+    auto deadline = std::chrono::steady_clock::now() + std::max(delay, std::chrono::milliseconds(0));
+    {
+        std::lock_guard<std::mutex> lock(pImpl->pending_mutex);
+        if (!pImpl->running.load()) {
+            return false;
+        }
+        pImpl->pending_timers.push_back({deadline, pImpl->timer_sequence++, std::move(on_fire)});
+        pImpl->timers_pending++;
+    }
+    pImpl->wake();
+    return true;
+}
+
+void CurlMultiEngine::shutdown() {
+    pImpl->stop();
+}
+
+nlohmann::json CurlMultiEngine::get_statistics() const {
+    nlohmann::json stats;
+    stats["running"] = pImpl->running.load();
+    stats["submitted"] = pImpl->submitted.load();
+    stats["completed"] = pImpl->completed.load();
+    stats["failed"] = pImpl->failed.load();
+    stats["in_flight"] = pImpl->active.load();
+    stats["watched_sockets"] = pImpl->watched_sockets.load();
+    stats["loop_wakeups"] = pImpl->loop_wakeups.load();
+    stats["timers_pending"] = pImpl->timers_pending.load();
+    stats["timers_fired"] = pImpl->timers_fired.load();
+    return stats;
+}
+
+} // namespace network
+} // namespace aimux
@@ -1,4 +1,6 @@
 #include "aimux/network/http_client.hpp"
+#include "aimux/network/curl_multi_engine.hpp"
+#include "aimux/core/cancellation.hpp"
 #include <curl/curl.h>
 #include <sstream>
 #include <iomanip>
@@ -7,17 +9,14 @@
 #include <chrono>
 #include <thread>
 #include <unordered_map>
+#include <array>
+#include <atomic>
+#include <mutex>
+#include <condition_variable>
 
 namespace aimux {
 namespace network {
 
-// Static callback function for CURL
-static size_t WriteCallback(void* contents, size_t size, size_t nmemb, std::string* userp) {
-    size_t total_size = size * nmemb;
-    userp->append(static_cast<char*>(contents), total_size);
-    return total_size;
-}
-
 // HttpResponse implementation
 nlohmann::json HttpResponse::to_json() const {
     nlohmann::json j;
@@ -55,20 +54,242 @@ nlohmann::json HttpRequest::to_json() const {
 
 // HttpClient implementation
 struct HttpClient::Impl {
+    // Shared clients build requests on many threads; the mutex guards the list
+    std::mutex headers_mutex;
     std::vector<std::pair<std::string, std::string>> default_headers;
-    int timeout_ms = 30000;
+    std::atomic<int> connect_timeout_ms{30000};
     mutable std::mutex stats_mutex;
     nlohmann::json stats;
     bool in_use = false;
     std::chrono::steady_clock::time_point last_activity;
-    
-    Impl(int /*max_connections*/, int /*connection_timeout_ms*/) {
+
+    // Reusable easy handles; curl_easy_reset keeps their live connections
+    std::atomic<size_t> max_connections{10};
+    std::mutex handles_mutex;
+    std::vector<CURL*> idle_handles;
+
+    // Share DNS and TLS session caches between pooled handles. Connections
+    // are not shared: libcurl does not support one connection cache used from
+    // concurrent threads, so reuse comes from each pooled handle's own cache
+    // (kept across curl_easy_reset) and from the event loop's multi handle.
+    CURLSH* share = nullptr;
+    std::array<std::mutex, CURL_LOCK_DATA_LAST> share_locks;
+    std::atomic<uint64_t> share_lock_acquisitions{0};
+
+    std::atomic<uint64_t> handles_created{0};
+    std::atomic<uint64_t> active_requests{0};
+    std::atomic<uint64_t> new_connections{0};
+    std::atomic<uint64_t> reused_connections{0};
+    std::atomic<uint64_t> tls_handshakes{0};
+    std::atomic<uint64_t> http2_responses{0};
+
+    // Transfers handed to the event loop; the destructor waits for them
+    std::atomic<uint64_t> async_in_flight{0};
+    std::mutex async_mutex;
+    std::condition_variable async_done;
+
+    Impl(int max_conns, int connection_timeout_ms)
+        : connect_timeout_ms(connection_timeout_ms),
+          max_connections(static_cast<size_t>(std::max(1, max_conns))) {
         stats["total_requests"] = 0;
         stats["successful_requests"] = 0;
         stats["failed_requests"] = 0;
         stats["avg_response_time_ms"] = 0.0;
+
+        static std::once_flag curl_init_flag;
+        std::call_once(curl_init_flag, []() { curl_global_init(CURL_GLOBAL_DEFAULT); });
+
+        share = curl_share_init();
+        if (share) {
+            curl_share_setopt(share, CURLSHOPT_LOCKFUNC, share_lock);
+            curl_share_setopt(share, CURLSHOPT_UNLOCKFUNC, share_unlock);
+            curl_share_setopt(share, CURLSHOPT_USERDATA, this);
+            curl_share_setopt(share, CURLSHOPT_SHARE, CURL_LOCK_DATA_DNS);
+            curl_share_setopt(share, CURLSHOPT_SHARE, CURL_LOCK_DATA_SSL_SESSION);
+        }
     }
-    
+
+    ~Impl() {
+        for (CURL* handle : idle_handles) {
+            curl_easy_cleanup(handle);
+        }
+        idle_handles.clear();
+        if (share) {
+            curl_share_cleanup(share);
+        }
+    }
+
+    static void share_lock(CURL* /*handle*/, curl_lock_data data, curl_lock_access /*access*/, void* userptr) {
+        Impl* impl = static_cast<Impl*>(userptr);
+        impl->share_locks[data].lock();
+        impl->share_lock_acquisitions.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    static void share_unlock(CURL* /*handle*/, curl_lock_data data, void* userptr) {
+        static_cast<Impl*>(userptr)->share_locks[data].unlock();
+    }
+
+    CURL* acquire_handle() {
+        {
+            std::lock_guard<std::mutex> lock(handles_mutex);
+            if (!idle_handles.empty()) {
+                CURL* handle = idle_handles.back();
+                idle_handles.pop_back();
+                return handle;
+            }
+        }
+        CURL* handle = curl_easy_init();
+        if (handle) {
+            handles_created++;
+        }
+        return handle;
+    }
+
+    void release_handle(CURL* handle) {
+        curl_easy_reset(handle);
+        {
+            std::lock_guard<std::mutex> lock(handles_mutex);
+            if (idle_handles.size() < max_connections.load(std::memory_order_relaxed)) {
+                idle_handles.push_back(handle);
+                return;
+            }
+        }
+        curl_easy_cleanup(handle);
+    }
+
+    void record_connection_info(CURL* handle) {
+        long num_connects = 0;
+        curl_easy_getinfo(handle, CURLINFO_NUM_CONNECTS, &num_connects);
+        if (num_connects > 0) {
+            new_connections += static_cast<uint64_t>(num_connects);
+        } else {
+            reused_connections++;
+        }
+
+        curl_off_t appconnect_us = 0;
+        curl_easy_getinfo(handle, CURLINFO_APPCONNECT_TIME_T, &appconnect_us);
+        if (num_connects > 0 && appconnect_us > 0) {
+            tls_handshakes++;
+        }
+
+        long http_version = 0;
+        curl_easy_getinfo(handle, CURLINFO_HTTP_VERSION, &http_version);
+        if (http_version == CURL_HTTP_VERSION_2_0) {
+            http2_responses++;
+        }
+    }
+
+    curl_slist* configure_handle(CURL* curl, const HttpRequest& request) {
+        // Set URL
+        curl_easy_setopt(curl, CURLOPT_URL, request.url.c_str());
+        
+        // Set method
+        if (request.method == "POST") {
+            curl_easy_setopt(curl, CURLOPT_POST, 1L);
+            curl_easy_setopt(curl, CURLOPT_POSTFIELDS, request.body.c_str());
+            curl_easy_setopt(curl, CURLOPT_POSTFIELDSIZE, request.body.length());
+        } else if (request.method == "GET") {
+            curl_easy_setopt(curl, CURLOPT_HTTPGET, 1L);
+        } else if (request.method == "PUT") {
+            curl_easy_setopt(curl, CURLOPT_CUSTOMREQUEST, "PUT");
+            curl_easy_setopt(curl, CURLOPT_POSTFIELDS, request.body.c_str());
+            curl_easy_setopt(curl, CURLOPT_POSTFIELDSIZE, request.body.length());
+        } else if (request.method == "DELETE") {
+            curl_easy_setopt(curl, CURLOPT_CUSTOMREQUEST, "DELETE");
+        }
+        
+        // Set headers
+        struct curl_slist* headers = nullptr;
+        for (const auto& header : request.headers) {
+            std::string header_line = header.first + ": " + header.second;
+            headers = curl_slist_append(headers, header_line.c_str());
+        }
+        
+        // Add default headers
+        {
+            std::lock_guard<std::mutex> lock(headers_mutex);
+            for (const auto& header : default_headers) {
+                std::string header_line = header.first + ": " + header.second;
+                headers = curl_slist_append(headers, header_line.c_str());
+            }
+        }
+        
+        if (headers) {
+            curl_easy_setopt(curl, CURLOPT_HTTPHEADER, headers);
+        }
+        
+        // Set timeouts
+        curl_easy_setopt(curl, CURLOPT_TIMEOUT_MS, request.timeout_ms);
+        curl_easy_setopt(curl, CURLOPT_CONNECTTIMEOUT_MS,
+                         static_cast<long>(std::min(request.timeout_ms / 2, connect_timeout_ms.load())));
+        curl_easy_setopt(curl, CURLOPT_NOSIGNAL, 1L);
+        
+        // Connection reuse: shared DNS/TLS caches, HTTP/2 multiplexing and keep-alive
+        if (share) {
+            curl_easy_setopt(curl, CURLOPT_SHARE, share);
+        }
+        curl_easy_setopt(curl, CURLOPT_HTTP_VERSION, CURL_HTTP_VERSION_2TLS);
+        curl_easy_setopt(curl, CURLOPT_PIPEWAIT, 1L);
+        curl_easy_setopt(curl, CURLOPT_TCP_KEEPALIVE, 1L);
+        curl_easy_setopt(curl, CURLOPT_MAXCONNECTS, static_cast<long>(max_connections.load()));
+        
+        // SSL settings
+        curl_easy_setopt(curl, CURLOPT_SSL_VERIFYPEER, 1L);
+        curl_easy_setopt(curl, CURLOPT_SSL_VERIFYHOST, 2L);
+        
+        return headers;
+    }
+
+    static int cancel_callback(void* clientp, curl_off_t /*dltotal*/, curl_off_t /*dlnow*/,
+                               curl_off_t /*ultotal*/, curl_off_t /*ulnow*/) {
+        return static_cast<const core::CancellationToken*>(clientp)->cancelled() ? 1 : 0;
+    }
+
+    // curl polls the token from its progress callback (at least once a second)
+    static void watch_cancellation(CURL* curl, const core::CancellationToken* token) {
+        if (token->valid()) {
+            curl_easy_setopt(curl, CURLOPT_NOPROGRESS, 0L);
+            curl_easy_setopt(curl, CURLOPT_XFERINFOFUNCTION, cancel_callback);
+            curl_easy_setopt(curl, CURLOPT_XFERINFODATA, token);
+        }
+    }
+
+    void finish_request(CURL* curl, CURLcode res,
+                        std::chrono::high_resolution_clock::time_point start_time,
+                        HttpResponse& response,
+                        const core::CancellationToken& token = {}) {
+        if (res == CURLE_OK) {
+            long status_code = 0;
+            curl_easy_getinfo(curl, CURLINFO_RESPONSE_CODE, &status_code);
+            response.status_code = static_cast<int>(status_code);
+            record_connection_info(curl);
+        } else if (res == CURLE_ABORTED_BY_CALLBACK && token.cancelled()) {
+            response.error_message = "Request cancelled";
+            response.status_code = 0;
+        } else {
+            response.error_message = curl_easy_strerror(res);
+            response.status_code = 0;
+        }
+        
+        // Calculate response time
+        auto end_time = std::chrono::high_resolution_clock::now();
+        response.response_time_ms = std::chrono::duration<double, std::milli>(end_time - start_time).count();
+        
+        // Update statistics
+        std::lock_guard<std::mutex> lock(stats_mutex);
+        stats["total_requests"] = stats["total_requests"].get<int>() + 1;
+        if (res == CURLE_OK && response.is_success()) {
+            stats["successful_requests"] = stats["successful_requests"].get<int>() + 1;
+        } else {
+            stats["failed_requests"] = stats["failed_requests"].get<int>() + 1;
+        }
+        
+        // Update average response time
+        int total = stats["total_requests"];
+        double current_avg = stats["avg_response_time_ms"];
+        stats["avg_response_time_ms"] = (current_avg * (total - 1) + response.response_time_ms) / total;
+    }
+
     static size_t write_callback(void* contents, size_t size, size_t nmemb, std::string* response) {
         size_t total_size = size * nmemb;
         response->append(static_cast<char*>(contents), total_size);
@@ -103,154 +324,174 @@ struct HttpClient::Impl {
 HttpClient::HttpClient(int max_connections, int connection_timeout_ms) 
     : pImpl(std::make_unique<Impl>(max_connections, connection_timeout_ms)) {}
 
-HttpClient::~HttpClient() = default;
+HttpClient::~HttpClient() {
+    // Completion callbacks reference this client; let outstanding ones finish
+    std::unique_lock<std::mutex> lock(pImpl->async_mutex);
+    pImpl->async_done.wait(lock, [this]() { return pImpl->async_in_flight.load() == 0; });
+}
 
 HttpResponse HttpClient::send_request(const HttpRequest& request) {
     auto start_time = std::chrono::high_resolution_clock::now();
     
     HttpResponse response;
-    CURL* curl = curl_easy_init();
+    CURL* curl = pImpl->acquire_handle();
     
     if (!curl) {
         response.error_message = "Failed to initialize CURL";
         response.status_code = 0;
         return response;
     }
+    pImpl->active_requests++;
     
-    // Set URL
-    curl_easy_setopt(curl, CURLOPT_URL, request.url.c_str());
-    
-    // Set method
-    if (request.method == "POST") {
-        curl_easy_setopt(curl, CURLOPT_POST, 1L);
-        curl_easy_setopt(curl, CURLOPT_POSTFIELDS, request.body.c_str());
-        curl_easy_setopt(curl, CURLOPT_POSTFIELDSIZE, request.body.length());
-    } else if (request.method == "GET") {
-        curl_easy_setopt(curl, CURLOPT_HTTPGET, 1L);
-    } else if (request.method == "PUT") {
-        curl_easy_setopt(curl, CURLOPT_CUSTOMREQUEST, "PUT");
-        curl_easy_setopt(curl, CURLOPT_POSTFIELDS, request.body.c_str());
-        curl_easy_setopt(curl, CURLOPT_POSTFIELDSIZE, request.body.length());
-    } else if (request.method == "DELETE") {
-        curl_easy_setopt(curl, CURLOPT_CUSTOMREQUEST, "DELETE");
-    }
-    
-    // Set headers
-    struct curl_slist* headers = nullptr;
-    for (const auto& header : request.headers) {
-        std::string header_line = header.first + ": " + header.second;
-        headers = curl_slist_append(headers, header_line.c_str());
-    }
-    
-    // Add default headers
-    for (const auto& header : pImpl->default_headers) {
-        std::string header_line = header.first + ": " + header.second;
-        headers = curl_slist_append(headers, header_line.c_str());
-    }
-    
-    if (headers) {
-        curl_easy_setopt(curl, CURLOPT_HTTPHEADER, headers);
-    }
-    
-    // Set timeouts
-    curl_easy_setopt(curl, CURLOPT_TIMEOUT, request.timeout_ms / 1000);
-    curl_easy_setopt(curl, CURLOPT_CONNECTTIMEOUT, 10);
-    
-    // SSL verification options (configurable)
-    curl_easy_setopt(curl, CURLOPT_SSL_VERIFYPEER, 1L);
-    curl_easy_setopt(curl, CURLOPT_SSL_VERIFYHOST, 2L);
-    
-    // Set response data
-    std::string response_data;
-    curl_easy_setopt(curl, CURLOPT_WRITEFUNCTION, WriteCallback);
-    curl_easy_setopt(curl, CURLOPT_WRITEDATA, &response_data);
-    curl_easy_setopt(curl, CURLOPT_TIMEOUT_MS, request.timeout_ms);
-    curl_easy_setopt(curl, CURLOPT_CONNECTTIMEOUT_MS, request.timeout_ms / 2);
+    struct curl_slist* headers = pImpl->configure_handle(curl, request);
     
     // Set callbacks
     curl_easy_setopt(curl, CURLOPT_WRITEFUNCTION, Impl::write_callback);
     curl_easy_setopt(curl, CURLOPT_WRITEDATA, &response.body);
     curl_easy_setopt(curl, CURLOPT_HEADERFUNCTION, Impl::header_callback);
     curl_easy_setopt(curl, CURLOPT_HEADERDATA, &response.headers);
-    
-    // SSL settings
-    curl_easy_setopt(curl, CURLOPT_SSL_VERIFYPEER, 1L);
-    curl_easy_setopt(curl, CURLOPT_SSL_VERIFYHOST, 2L);
+    const core::CancellationToken token = core::current_cancellation();
+    Impl::watch_cancellation(curl, &token);
     
     // Perform request
     CURLcode res = curl_easy_perform(curl);
+    pImpl->finish_request(curl, res, start_time, response, token);
     
-    if (res == CURLE_OK) {
-        curl_easy_getinfo(curl, CURLINFO_RESPONSE_CODE, &response.status_code);
-    } else {
-        response.error_message = curl_easy_strerror(res);
-        response.status_code = 0;
-    }
-    
-    // Calculate response time
-    auto end_time = std::chrono::high_resolution_clock::now();
-    response.response_time_ms = std::chrono::duration<double, std::milli>(end_time - start_time).count();
-    
-    // Update statistics
-    {
-        std::lock_guard<std::mutex> lock(pImpl->stats_mutex);
-        pImpl->stats["total_requests"] = pImpl->stats["total_requests"].get<int>() + 1;
-        if (res == CURLE_OK && response.is_success()) {
-            pImpl->stats["successful_requests"] = pImpl->stats["successful_requests"].get<int>() + 1;
-        } else {
-            pImpl->stats["failed_requests"] = pImpl->stats["failed_requests"].get<int>() + 1;
-        }
-        
-        // Update average response time
-        int total = pImpl->stats["total_requests"];
-        double current_avg = pImpl->stats["avg_response_time_ms"];
-        pImpl->stats["avg_response_time_ms"] = (current_avg * (total - 1) + response.response_time_ms) / total;
-    }
-    
-    // Cleanup
+    // Cleanup - the handle goes back to the pool with its connection intact
     if (headers) {
         curl_slist_free_all(headers);
     }
-    curl_easy_cleanup(curl);
+    pImpl->active_requests--;
+    pImpl->release_handle(curl);
     
     return response;
 }
 
 void HttpClient::send_request_async(const HttpRequest& request, ResponseCallback callback) {
-    std::thread([this, request, callback]() {
-        HttpResponse response = send_request(request);
-        callback(response);
-    }).detach();
+    // State that must outlive this call until the event loop completes the transfer
+    struct AsyncTransfer {
+        HttpResponse response;
+        HttpRequest request;
+        CURL* curl = nullptr;
+        struct curl_slist* headers = nullptr;
+        std::chrono::high_resolution_clock::time_point start_time;
+        core::CancellationToken token;  // The submitting thread's, checked on the loop thread
+    };
+    
+    auto transfer = std::make_shared<AsyncTransfer>();
+    transfer->start_time = std::chrono::high_resolution_clock::now();
+    transfer->request = request;  // POSTFIELDS points into this copy
+    transfer->token = core::current_cancellation();
+    transfer->curl = pImpl->acquire_handle();
+    
+    if (!transfer->curl) {
+        transfer->response.error_message = "Failed to initialize CURL";
+        callback(transfer->response);
+        return;
+    }
+    pImpl->active_requests++;
+    pImpl->async_in_flight++;
+    
+    CURL* curl = transfer->curl;
+    transfer->headers = pImpl->configure_handle(curl, transfer->request);
+    curl_easy_setopt(curl, CURLOPT_WRITEFUNCTION, Impl::write_callback);
+    curl_easy_setopt(curl, CURLOPT_WRITEDATA, &transfer->response.body);
+    curl_easy_setopt(curl, CURLOPT_HEADERFUNCTION, Impl::header_callback);
+    curl_easy_setopt(curl, CURLOPT_HEADERDATA, &transfer->response.headers);
+    Impl::watch_cancellation(curl, &transfer->token);
+    
+    Impl* impl = pImpl.get();
+    auto on_complete = [impl, transfer, callback](CURLcode res) {
+        impl->finish_request(transfer->curl, res, transfer->start_time, transfer->response, transfer->token);
+        if (transfer->headers) {
+            curl_slist_free_all(transfer->headers);
+        }
+        impl->release_handle(transfer->curl);
+        impl->active_requests--;
+        {
+            // Last touch of the client; the user callback only sees the response
+            std::lock_guard<std::mutex> lock(impl->async_mutex);
+            impl->async_in_flight--;
+            impl->async_done.notify_all();
+        }
+        
+        callback(transfer->response);
+    };
+    
+    if (!CurlMultiEngine::instance().submit(curl, on_complete)) {
+        // Event loop is gone (process shutdown); fail the request without blocking
+        on_complete(CURLE_ABORTED_BY_CALLBACK);
+    }
 }
 
 std::future<HttpResponse> HttpClient::send_request_future(const HttpRequest& request) {
-    return std::async(std::launch::async, [this, request]() {
-        return send_request(request);
+    auto promise = std::make_shared<std::promise<HttpResponse>>();
+    std::future<HttpResponse> future = promise->get_future();
+    send_request_async(request, [promise](const HttpResponse& response) {
+        promise->set_value(response);
     });
+    return future;
 }
 
 nlohmann::json HttpClient::get_statistics() const {
-    std::lock_guard<std::mutex> lock(pImpl->stats_mutex);
-    nlohmann::json stats = pImpl->stats;
+    nlohmann::json stats;
+    {
+        std::lock_guard<std::mutex> lock(pImpl->stats_mutex);
+        stats = pImpl->stats;
+    }
+    
+    size_t idle_handles = 0;
+    {
+        std::lock_guard<std::mutex> lock(pImpl->handles_mutex);
+        idle_handles = pImpl->idle_handles.size();
+    }
     
     nlohmann::json pool_stats;
-    pool_stats["max_connections"] = 10;
-    pool_stats["active_connections"] = 0;
-    pool_stats["idle_connections"] = 0;
+    pool_stats["max_connections"] = pImpl->max_connections.load();
+    pool_stats["connect_timeout_ms"] = pImpl->connect_timeout_ms.load();
+    pool_stats["active_connections"] = pImpl->active_requests.load();
+    pool_stats["idle_connections"] = idle_handles;
+    pool_stats["handles_created"] = pImpl->handles_created.load();
+    pool_stats["async_in_flight"] = pImpl->async_in_flight.load();
     stats["connection_pool"] = pool_stats;
     
+    uint64_t new_connections = pImpl->new_connections.load();
+    uint64_t reused_connections = pImpl->reused_connections.load();
+    uint64_t total_connections = new_connections + reused_connections;
+    
+    nlohmann::json connection_stats;
+    connection_stats["new_connections"] = new_connections;
+    connection_stats["reused_connections"] = reused_connections;
+    connection_stats["tls_handshakes"] = pImpl->tls_handshakes.load();
+    connection_stats["http2_responses"] = pImpl->http2_responses.load();
+    connection_stats["share_lock_acquisitions"] = pImpl->share_lock_acquisitions.load();
+    connection_stats["reuse_ratio"] = total_connections > 0
+        ? static_cast<double>(reused_connections) / static_cast<double>(total_connections)
+        : 0.0;
+    stats["connections"] = connection_stats;
+    
     return stats;
 }
 
 void HttpClient::set_timeout(int timeout_ms) {
-    pImpl->timeout_ms = timeout_ms;
+    pImpl->connect_timeout_ms = timeout_ms;
+}
+
+void HttpClient::set_max_connections(int max_connections) {
+    pImpl->max_connections = static_cast<size_t>(std::max(1, max_connections));
+}
+
+size_t HttpClient::max_connections() const {
+    return pImpl->max_connections.load();
 }
 
 void HttpClient::add_default_header(const std::string& name, const std::string& value) {
+    std::lock_guard<std::mutex> lock(pImpl->headers_mutex);
     pImpl->default_headers.emplace_back(name, value);
 }
 
 void HttpClient::remove_default_header(const std::string& name) {
+    std::lock_guard<std::mutex> lock(pImpl->headers_mutex);
     pImpl->default_headers.erase(
         std::remove_if(pImpl->default_headers.begin(), pImpl->default_headers.end(),
             [&name](const auto& header) { return header.first == name; }),
@@ -267,6 +508,38 @@ std::unique_ptr<HttpClient> HttpClientFactory::create_client(int max_connections
     return std::make_unique<HttpClient>(max_connections, timeout_ms);
 }
 
+namespace {
+std::mutex shared_clients_mutex;
+std::unordered_map<std::string, std::shared_ptr<HttpClient>> shared_clients;
+}
+
+std::shared_ptr<HttpClient> HttpClientFactory::get_shared_client(const std::string& key, int max_connections,
+                                                                 int connection_timeout_ms) {
+    std::lock_guard<std::mutex> lock(shared_clients_mutex);
+    auto& client = shared_clients[key];
+    if (!client) {
+        client = std::make_shared<HttpClient>(max_connections, connection_timeout_ms);
+    } else if (client->max_connections() < static_cast<size_t>(std::max(1, max_connections))) {
+        // Another user of the key needs a larger pool; never shrink it under the first
+        client->set_max_connections(max_connections);
+    }
+    return client;
+}
+
+nlohmann::json HttpClientFactory::get_shared_client_statistics() {
+    std::vector<std::pair<std::string, std::shared_ptr<HttpClient>>> clients;
+    {
+        std::lock_guard<std::mutex> lock(shared_clients_mutex);
+        clients.assign(shared_clients.begin(), shared_clients.end());
+    }
+    
+    nlohmann::json stats = nlohmann::json::object();
+    for (const auto& [key, client] : clients) {
+        stats[key] = client->get_statistics();
+    }
+    return stats;
+}
+
 void HttpClientFactory::configure_ssl(const std::string& /*ca_cert_path*/, bool /*verify_peer*/) {
     // Basic SSL verification implemented
 }
@@ -1,7 +1,6 @@
 #include "aimux/prettifier/anthropic_formatter.hpp"
 #include "aimux/core/model_registry.hpp"
 #include <map>
-#include <regex>
 #include <sstream>
 #include <chrono>
 #include <algorithm>
@@ -24,14 +23,22 @@ namespace prettifier {
 
 // ClaudePatterns implementation
 AnthropicFormatter::ClaudePatterns::ClaudePatterns()
-    : function_calls_start(R"(<function_calls[^>]*>)", std::regex::optimize | std::regex::icase)
-    , function_calls_end(R"(</function_calls>)", std::regex::optimize | std::regex::icase)
-    , function_call_pattern(R"(<invoke[^>]*name\s*=\s*\"([^\"]+)\"[^>]*>([\s\S]*?)</invoke>)", std::regex::optimize | std::regex::icase)
-    , thinking_start(R"(<thinking>)", std::regex::optimize | std::regex::icase)
-    , thinking_end(R"(</thinking>)", std::regex::optimize | std::regex::icase)
-    , reflection_pattern(R"(<reflection[^>]*>([\s\S]*?)</reflection>)", std::regex::optimize | std::regex::icase)
-    , code_block_pattern(R"(```[\s\S]*?```)", std::regex::optimize)
-    , xml_artifact_pattern(R"(&[a-z]+;|&\#[0-9]+;)", std::regex::optimize) {
+    : function_calls_start(set.add("anthropic.function_calls_start", R"(<function_calls[^>]*>)", CompiledPattern::ICASE))
+    , function_calls_end(set.add("anthropic.function_calls_end", R"(</function_calls>)", CompiledPattern::ICASE))
+    , function_call_pattern(set.add("anthropic.invoke", R"(<invoke[^>]*name\s*=\s*\"([^\"]+)\"[^>]*>([\s\S]*?)</invoke>)", CompiledPattern::ICASE))
+    , parameter_pattern(set.add("anthropic.parameter", R"(<parameter[^>]*name\s*=\s*\"([^\"]+)\"[^>]*>(.*?)</parameter>)", CompiledPattern::ICASE))
+    , thinking_start(set.add("anthropic.thinking_start", R"(<thinking>)", CompiledPattern::ICASE))
+    , thinking_end(set.add("anthropic.thinking_end", R"(</thinking>)", CompiledPattern::ICASE))
+    , reflection_pattern(set.add("anthropic.reflection", R"(<reflection[^>]*>([\s\S]*?)</reflection>)", CompiledPattern::ICASE))
+    , code_block_pattern(set.add("anthropic.code_block", R"(```[\s\S]*?```)"))
+    , xml_artifact_pattern(set.add("anthropic.xml_artifact", R"(&[a-z]+;|&\#[0-9]+;)"))
+    , blank_lines_pattern(set.add("anthropic.blank_lines", R"(\s*\n\s*\n\s*\n)"))
+    , line_endings_pattern(set.add("anthropic.line_endings", R"(\r\n|\r)"))
+    , excess_whitespace_pattern(set.add("anthropic.excess_whitespace", R"(\n\s*\n\s*\n)"))
+    , image_pattern(set.add("anthropic.image", R"(\[Image: ([^\]]+)\])"))
+    , document_pattern(set.add("anthropic.document", R"(Document Analysis:|Document Content:)"))
+    , step_pattern(set.add("anthropic.reasoning_step", R"(\d+\.\s*([^.\n]+))"))
+    , analysis_pattern(set.add("anthropic.analysis_keyword", R"((analysis|examination|evaluation|consideration)[^.,]*[.,])", CompiledPattern::ICASE)) {
 }
 
 // AnthropicFormatter implementation
@@ -206,8 +213,10 @@ ProcessingResult AnthropicFormatter::postprocess_response(
         // Clean content while preserving structure
         std::string cleaned_content = clean_claude_content(response.data);
 
-        // Try JSON tool_use extraction first (Claude v3.5+ format)
-        std::vector<ToolCall> tool_calls = extract_claude_json_tool_uses(response.data);
+        // Try JSON tool_use extraction first (Claude v3.5+ format), reusing the response's parse
+        const nlohmann::json* document = response.json();
+        std::vector<ToolCall> tool_calls = document ? extract_claude_json_tool_uses(*document)
+                                                    : extract_claude_json_tool_uses(response.data);
 
         // Fall back to XML extraction if no JSON tool_use blocks found (older Claude format)
         if (tool_calls.empty()) {
@@ -316,9 +325,9 @@ ProcessingResult AnthropicFormatter::process_streaming_chunk(
         // Check for thinking blocks
         if (in_thinking_block_ || streaming_content_.find("<thinking>") != std::string::npos) {
             // Extract partial thinking content
-            std::smatch thinking_match;
-            if (std::regex_search(streaming_content_, thinking_match, patterns_->thinking_start) &&
-                std::regex_search(streaming_content_, thinking_match, patterns_->thinking_end)) {
+            PatternMatch thinking_match;
+            if (patterns_->thinking_start.search(streaming_content_) &&
+                patterns_->thinking_end.search(streaming_content_, thinking_match)) {
                 std::string full_thinking = thinking_match.str();
                 if (full_thinking.length() <= static_cast<size_t>(max_thinking_length_)) {
                     thinking_buffer_ = full_thinking;
@@ -473,6 +482,8 @@ nlohmann::json AnthropicFormatter::get_metrics() const {
     metrics["reasoning_extraction_rate"] = count > 0 ?
         static_cast<double>(reasoning_content_extracted_.load()) / count : 0.0;
 
+    metrics["patterns"] = patterns_->set.to_json();
+
     return metrics;
 }
 
@@ -590,47 +601,37 @@ std::vector<ToolCall> AnthropicFormatter::extract_claude_xml_tool_calls(const st
     std::vector<ToolCall> tool_calls;
 
     try {
-        std::smatch match;
-        std::string search_content = content;
+        std::string_view search_content = content;
+        PatternMatch match;
 
         // Find function_calls blocks
-        while (std::regex_search(search_content, match, patterns_->function_calls_start)) {
-            size_t start_pos = static_cast<size_t>(match.position());
+        while (patterns_->function_calls_start.search(search_content, match)) {
+            size_t start_pos = match.position;
             size_t end_pos = search_content.find("</function_calls>", start_pos);
 
             if (end_pos != std::string::npos) {
-                std::string function_block = search_content.substr(start_pos, end_pos - start_pos + 17);
+                std::string_view function_block = search_content.substr(start_pos, end_pos - start_pos + 17);
 
                 // Validate XML structure if enabled
-                if (validate_xml_structure_ && !validate_claude_xml(function_block)) {
+                if (validate_xml_structure_ && !validate_claude_xml(std::string(function_block))) {
                     xml_validation_errors_.fetch_add(1);
-                    search_content = match.suffix();
+                    search_content.remove_prefix(match.position + match.length());
                     continue;
                 }
 
                 // Extract individual function calls
-                std::smatch invoke_match;
-                std::string block_search = function_block;
-
-                while (std::regex_search(block_search, invoke_match, patterns_->function_call_pattern)) {
+                patterns_->function_call_pattern.for_each_match(function_block, [&](const PatternMatch& invoke_match) {
                     ToolCall call;
                     call.status = "completed";
                     call.timestamp = std::chrono::system_clock::now();
 
-                    call.name = invoke_match[1].str();
+                    call.name = invoke_match.str(1);
 
-                    // Extract parameters from invoke content
-                    std::string param_content = invoke_match[2].str();
+                    // Parse parameter tags from the invoke content
                     nlohmann::json params = nlohmann::json::object();
-
-                    // Parse parameter tags
-                    static const std::regex param_pattern(R"(<parameter[^>]*name\s*=\s*\"([^\"]+)\"[^>]*>(.*?)</parameter>)", std::regex::icase);
-                    std::smatch param_match;
-                    std::string param_search = param_content;
-
-                    while (std::regex_search(param_search, param_match, param_pattern)) {
-                        std::string param_name = param_match[1].str();
-                        std::string param_value = param_match[2].str();
+                    patterns_->parameter_pattern.for_each_match(invoke_match.groups[2], [&](const PatternMatch& param_match) {
+                        std::string param_name = param_match.str(1);
+                        std::string param_value = param_match.str(2);
 
                         try {
                             // Try to parse as JSON, fallback to string
@@ -638,17 +639,15 @@ std::vector<ToolCall> AnthropicFormatter::extract_claude_xml_tool_calls(const st
                         } catch (...) {
                             params[param_name] = param_value;
                         }
-
-                        param_search = param_match.suffix();
-                    }
+                        return true;
+                    });
 
                     call.parameters = params;
                     tool_calls.push_back(call);
+                    return true;
+                });
 
-                    block_search = invoke_match.suffix();
-                }
-
-                search_content = search_content.substr(end_pos + 17);
+                search_content.remove_prefix(end_pos + 17);
             } else {
                 break;
             }
@@ -669,11 +668,11 @@ std::pair<std::string, std::string> AnthropicFormatter::extract_thinking_blocks(
     std::string reasoning_content;
 
     try {
-        std::smatch thinking_match;
+        PatternMatch thinking_match;
 
         // Find thinking blocks
-        if (std::regex_search(cleaned_content, thinking_match, patterns_->thinking_start)) {
-            size_t think_start = static_cast<size_t>(thinking_match.position());
+        if (patterns_->thinking_start.search(cleaned_content, thinking_match)) {
+            size_t think_start = thinking_match.position;
 
             // Find corresponding end tag
             size_t think_end = cleaned_content.find("</thinking>", think_start);
@@ -696,27 +695,25 @@ std::pair<std::string, std::string> AnthropicFormatter::extract_thinking_blocks(
                     thinking_blocks_processed_.fetch_add(1);
 
                     // Clean up extra whitespace
-                    static const std::regex whitespace_clean(R"(\s*\n\s*\n\s*\n)");
-                    cleaned_content = std::regex_replace(cleaned_content, whitespace_clean, "\n\n");
+                    cleaned_content = patterns_->blank_lines_pattern.replace_all(cleaned_content, "\n\n");
                 }
             }
         }
 
         // Extract reflection blocks if present
         if (extract_reasoning_) {
-            std::smatch reflection_match;
+            PatternMatch reflection_match;
             std::string search_content = cleaned_content;
 
-            while (std::regex_search(search_content, reflection_match, patterns_->reflection_pattern)) {
-                std::string reflection_content = reflection_match[1].str();
+            while (patterns_->reflection_pattern.search(search_content, reflection_match)) {
+                std::string reflection_content = reflection_match.str(1);
                 if (!reasoning_content.empty()) {
                     reasoning_content += "\n\n";
                 }
                 reasoning_content += "Reflection: " + reflection_content;
 
                 // Remove reflection block from main content
-                size_t refl_start = search_content.find(reflection_match.str());
-                search_content.erase(refl_start, reflection_match.str().length());
+                search_content.erase(reflection_match.position, reflection_match.length());
             }
 
             if (!reasoning_content.empty()) {
@@ -779,34 +776,32 @@ std::string AnthropicFormatter::clean_claude_content(const std::string& content)
 
         // Clean XML artifacts if enabled
         if (clean_xml_artifacts_) {
-            cleaned = std::regex_replace(cleaned, patterns_->xml_artifact_pattern, "");
+            cleaned = patterns_->xml_artifact_pattern.replace_all(cleaned, "");
         }
 
         // Normalize whitespace while preserving structure
         // Preserve code blocks if enabled
         std::vector<std::string> code_blocks;
         if (preserve_code_blocks_) {
-            std::smatch code_match;
-            std::string search_content = cleaned;
-
-            while (std::regex_search(search_content, code_match, patterns_->code_block_pattern)) {
+            // Swap each code block for its own numbered placeholder in one pass
+            std::string with_placeholders;
+            size_t copied = 0;
+            patterns_->code_block_pattern.for_each_match(cleaned, [&](const PatternMatch& code_match) {
+                with_placeholders.append(cleaned, copied, code_match.position - copied);
+                with_placeholders += "CODE_BLOCK_PLACEHOLDER_" + std::to_string(code_blocks.size());
                 code_blocks.push_back(code_match.str());
-                search_content = code_match.suffix();
-            }
-
-            // Replace code blocks with placeholders
-            for (size_t i = 0; i < code_blocks.size(); ++i) {
-                cleaned = std::regex_replace(cleaned, patterns_->code_block_pattern,
-                    "CODE_BLOCK_PLACEHOLDER_" + std::to_string(i));
+                copied = code_match.position + code_match.length();
+                return true;
+            });
+            if (!code_blocks.empty()) {
+                with_placeholders.append(cleaned, copied, std::string::npos);
+                cleaned = std::move(with_placeholders);
             }
         }
 
         // Normalize line endings and excess whitespace
-        static const std::regex line_endings(R"(\r\n|\r)");
-        cleaned = std::regex_replace(cleaned, line_endings, "\n");
-
-        static const std::regex excess_whitespace(R"(\n\s*\n\s*\n)");
-        cleaned = std::regex_replace(cleaned, excess_whitespace, "\n\n");
+        cleaned = patterns_->line_endings_pattern.replace_all(cleaned, "\n");
+        cleaned = patterns_->excess_whitespace_pattern.replace_all(cleaned, "\n\n");
 
         // Restore code blocks if they were extracted
         if (preserve_code_blocks_ && !code_blocks.empty()) {
@@ -996,12 +991,10 @@ std::string AnthropicFormatter::process_multimodal_content(const std::string& co
         std::string processed = content;
 
         // Handle image analysis results
-        static const std::regex image_pattern(R"(\[Image: ([^\]]+)\])");
-        processed = std::regex_replace(processed, image_pattern, "🖼️ Image Analysis: $1");
+        processed = patterns_->image_pattern.replace_all(processed, "🖼️ Image Analysis: $1");
 
         // Handle document processing results
-        static const std::regex doc_pattern(R"(Document Analysis:|Document Content:)");
-        processed = std::regex_replace(processed, doc_pattern, "📄 Document Content:");
+        processed = patterns_->document_pattern.replace_all(processed, "📄 Document Content:");
 
         if (processed != content) {
             multimodal_responses_processed_.fetch_add(1);
@@ -1020,25 +1013,18 @@ std::string AnthropicFormatter::extract_reasoning_traces(const std::string& cont
         std::string traces;
 
         // Extract numbered reasoning steps
-        static const std::regex step_pattern(R"(\d+\.\s*([^.\n]+))");
-        std::sregex_iterator iter(content.begin(), content.end(), step_pattern);
-        std::sregex_iterator end;
-
-        for (std::sregex_iterator i = iter; i != end; ++i) {
+        patterns_->step_pattern.for_each_match(content, [&traces](const PatternMatch& match) {
             if (!traces.empty()) traces += "\n";
-            traces += i->str();
-        }
+            traces += match.groups[0];
+            return true;
+        });
 
         // Extract analysis keywords
-        static const std::regex analysis_pattern(R"((analysis|examination|evaluation|consideration)[^.,]*[.,])", std::regex::icase);
-        std::smatch match;
-        std::string search_content = content;
-
-        while (std::regex_search(search_content, match, analysis_pattern)) {
+        patterns_->analysis_pattern.for_each_match(content, [&traces](const PatternMatch& match) {
             if (!traces.empty()) traces += "\n";
-            traces += match.str();
-            search_content = match.suffix();
-        }
+            traces += match.groups[0];
+            return true;
+        });
 
         return traces;
 
@@ -1062,35 +1048,39 @@ bool AnthropicFormatter::validate_claude_tool_call(const ToolCall& tool_call) co
 }
 
 std::vector<ToolCall> AnthropicFormatter::extract_claude_json_tool_uses(const std::string& content) const {
-    std::vector<ToolCall> tool_calls;
+    // Try to parse content as JSON - this handles API response format
+    nlohmann::json response_json;
 
+    // First, try to parse the entire content as JSON (v3.5+ format with content array)
     try {
-        // Try to parse content as JSON - this handles API response format
-        nlohmann::json response_json;
-
-        // First, try to parse the entire content as JSON (v3.5+ format with content array)
-        try {
-            response_json = nlohmann::json::parse(content);
-        } catch (...) {
-            // If not valid JSON, try to extract a JSON object from the content
-            // This handles cases where content has surrounding text
-            std::string::size_type start = content.find('{');
-            std::string::size_type end = content.rfind('}');
-
-            if (start != std::string::npos && end != std::string::npos && start < end) {
-                std::string json_str = content.substr(start, end - start + 1);
-                try {
-                    response_json = nlohmann::json::parse(json_str);
-                } catch (...) {
-                    LOG_DEBUG("Failed to parse JSON from content");
-                    return tool_calls;
-                }
-            } else {
-                LOG_DEBUG("No JSON object found in content");
-                return tool_calls;
+        response_json = core::parse_json(content);
+    } catch (...) {
+        // If not valid JSON, try to extract a JSON object from the content
+        // This handles cases where content has surrounding text
+        std::string::size_type start = content.find('{');
+        std::string::size_type end = content.rfind('}');
+
+        if (start != std::string::npos && end != std::string::npos && start < end) {
+            std::string json_str = content.substr(start, end - start + 1);
+            try {
+                response_json = core::parse_json(json_str);
+            } catch (...) {
+                LOG_DEBUG("Failed to parse JSON from content");
+                return {};
             }
+        } else {
+            LOG_DEBUG("No JSON object found in content");
+            return {};
         }
+    }
+
+    return extract_claude_json_tool_uses(response_json);
+}
 
+std::vector<ToolCall> AnthropicFormatter::extract_claude_json_tool_uses(const nlohmann::json& response_json) const {
+    std::vector<ToolCall> tool_calls;
+
+    try {
         // Check for content array (Claude v3.5+ format)
         if (response_json.contains("content") && response_json["content"].is_array()) {
             const auto& content_array = response_json["content"];
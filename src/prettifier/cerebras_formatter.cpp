@@ -1,7 +1,6 @@
 #include "aimux/prettifier/cerebras_formatter.hpp"
 #include "aimux/core/model_registry.hpp"
 #include <map>
-#include <regex>
 #include <sstream>
 #include <chrono>
 #include <algorithm>
@@ -24,9 +23,11 @@ namespace prettifier {
 
 // CerebrasPatterns implementation
 CerebrasFormatter::CerebrasPatterns::CerebrasPatterns()
-    : fast_tool_pattern(R"(\{\"type\":\"function_call\",\"function\":\{[^}]*\}\})", std::regex::optimize)
-    , cerebras_json_pattern(R"(\{(?:[^{}]|\{[^{}]*\})*\})", std::regex::optimize)
-    , streaming_tool_pattern(R"(data:\s*\{[^}]*\"function_call\"[^}]*\})", std::regex::optimize) {
+    : fast_tool_pattern(set.add("cerebras.fast_tool", R"(\{\"type\":\"function_call\",\"function\":\{[^}]*\}\})"))
+    , cerebras_json_pattern(set.add("cerebras.json_object", R"(\{(?:[^{}]|\{[^{}]*\})*\})"))
+    , streaming_tool_pattern(set.add("cerebras.streaming_tool", R"(data:\s*\{[^}]*\"function_call\"[^}]*\})"))
+    , artifacts_pattern(set.add("cerebras.stream_artifacts", R"(\[DONE\]|data:\s*\{|:\s*\"?DONE\"?)"))
+    , whitespace_pattern(set.add("cerebras.whitespace", R"(\s+)")) {
 }
 
 // CerebrasFormatter implementation
@@ -378,6 +379,7 @@ nlohmann::json CerebrasFormatter::get_metrics() const {
     metrics["cache_hit_rate"] = (cache_hits_.load() + cache_misses_.load()) > 0 ?
         static_cast<double>(cache_hits_.load()) / (cache_hits_.load() + cache_misses_.load()) : 0.0;
     metrics["fast_failovers_triggered"] = fast_failovers_triggered_.load();
+    metrics["patterns"] = patterns_->set.to_json();
     metrics["speed_optimization_enabled"] = optimize_speed_;
 
     return metrics;
@@ -477,12 +479,10 @@ std::string CerebrasFormatter::fast_normalize_content(const std::string& content
         std::string normalized = content;
 
         // Remove common Cerebras artifacts that don't affect tool calls
-        static const std::regex artifacts_pattern(R"(\[DONE\]|data:\s*\{|:\s*\"?DONE\"?)", std::regex::optimize);
-        normalized = std::regex_replace(normalized, artifacts_pattern, "");
+        normalized = patterns_->artifacts_pattern.replace_all(normalized, "");
 
         // Basic whitespace cleanup (preserving tool call structure)
-        static const std::regex whitespace_pattern(R"(\s+)", std::regex::optimize);
-        normalized = std::regex_replace(normalized, whitespace_pattern, " ");
+        normalized = patterns_->whitespace_pattern.replace_all(normalized, " ");
 
         // Trim leading/trailing whitespace
         normalized.erase(0, normalized.find_first_not_of(" \t\n\r"));
@@ -554,12 +554,8 @@ std::vector<ToolCall> CerebrasFormatter::extract_cerebras_tool_calls(const std::
         // Use pre-compiled patterns for speed
         if (patterns_ && cache_tool_patterns_) {
             // Pattern 1: Fast tool call pattern (most common in Cerebras)
-            std::smatch match;
-            std::string search_content = content;
-
-            while (std::regex_search(search_content, match, patterns_->fast_tool_pattern)) {
-                std::string json_str = match[0].str();
-                auto json_opt2 = validate_json(json_str);
+            patterns_->fast_tool_pattern.for_each_match(content, [&](const PatternMatch& match) {
+                auto json_opt2 = validate_json(match.str());
 
                 if (json_opt2 && json_opt2->contains("function")) {
                     ToolCall call;
@@ -580,15 +576,15 @@ std::vector<ToolCall> CerebrasFormatter::extract_cerebras_tool_calls(const std::
                     tool_calls.push_back(call);
                 }
 
-                search_content = match.suffix();
                 cache_used = true;
-            }
+                return true;
+            });
 
             // Pattern 2: General JSON pattern (fallback)
             if (tool_calls.empty()) {
-                if (std::regex_search(content, match, patterns_->cerebras_json_pattern)) {
-                    std::string json_str = match[0].str();
-                    auto json_opt3 = validate_json(json_str);
+                PatternMatch match;
+                if (patterns_->cerebras_json_pattern.search(content, match)) {
+                    auto json_opt3 = validate_json(match.str());
 
                     if (json_opt3 && json_opt3->contains("function_call")) {
                         ToolCall call;
@@ -0,0 +1,183 @@
+#include "aimux/prettifier/chunk_pool.hpp"
+#include <algorithm>
+#include <cstring>
+#include <limits>
+#include <new>
+
+namespace aimux {
+namespace prettifier {
+
+ChunkPool::ChunkPool(size_t budget_bytes) : budget_bytes_(budget_bytes) {}
+
+ChunkPool::~ChunkPool() {
+    // Blocks still referenced are owned by their slices; only the cache is ours
+    trim_free_blocks(0);
+}
+
+ChunkBlock* ChunkPool::acquire(size_t min_capacity) {
+    size_t capacity = std::max(min_capacity, BLOCK_SIZE);
+    bool shared = capacity == BLOCK_SIZE;
+
+    if (shared) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (free_list_) {
+            ChunkBlock* block = free_list_;
+            free_list_ = block->next_free;
+            --free_blocks_;
+            block->next_free = nullptr;
+            block->refs.store(1, std::memory_order_relaxed);
+            in_use_bytes_.fetch_add(capacity, std::memory_order_relaxed);
+            return block;
+        }
+    }
+
+    if (capacity > std::numeric_limits<uint32_t>::max() || !reserve(capacity)) {
+        rejected_.fetch_add(1, std::memory_order_relaxed);
+        return nullptr;
+    }
+
+    void* raw = ::operator new(sizeof(ChunkBlock) + capacity, std::nothrow);
+    if (!raw) {
+        allocated_bytes_.fetch_sub(capacity, std::memory_order_relaxed);
+        rejected_.fetch_add(1, std::memory_order_relaxed);
+        return nullptr;
+    }
+
+    auto* block = ::new (raw) ChunkBlock();
+    block->capacity = static_cast<uint32_t>(capacity);
+    block->pool = this;
+    block->refs.store(1, std::memory_order_relaxed);
+    in_use_bytes_.fetch_add(capacity, std::memory_order_relaxed);
+    if (shared) {
+        total_blocks_.fetch_add(1, std::memory_order_relaxed);
+    }
+    return block;
+}
+
+void ChunkPool::set_budget(size_t budget_bytes) {
+    budget_bytes_.store(budget_bytes, std::memory_order_relaxed);
+
+    size_t in_use = in_use_bytes_.load(std::memory_order_relaxed);
+    trim_free_blocks(budget_bytes > in_use ? budget_bytes - in_use : 0);
+}
+
+ChunkPool::Stats ChunkPool::get_stats() const {
+    Stats stats;
+    stats.budget_bytes = budget_bytes_.load(std::memory_order_relaxed);
+    stats.allocated_bytes = allocated_bytes_.load(std::memory_order_relaxed);
+    stats.in_use_bytes = in_use_bytes_.load(std::memory_order_relaxed);
+    stats.total_blocks = total_blocks_.load(std::memory_order_relaxed);
+    stats.rejected = rejected_.load(std::memory_order_relaxed);
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stats.free_blocks = free_blocks_;
+    }
+    return stats;
+}
+
+void ChunkPool::recycle(ChunkBlock* block) noexcept {
+    in_use_bytes_.fetch_sub(block->capacity, std::memory_order_relaxed);
+
+    // Keep shared-size blocks for reuse unless the budget was lowered under us
+    if (block->capacity == BLOCK_SIZE &&
+        allocated_bytes_.load(std::memory_order_relaxed) <= budget_bytes_.load(std::memory_order_relaxed)) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        block->next_free = free_list_;
+        free_list_ = block;
+        ++free_blocks_;
+        return;
+    }
+
+    free_block(block);
+}
+
+bool ChunkPool::reserve(size_t bytes) {
+    for (bool trimmed = false;; trimmed = true) {
+        size_t budget = budget_bytes_.load(std::memory_order_relaxed);
+        size_t allocated = allocated_bytes_.load(std::memory_order_relaxed);
+        while (allocated + bytes <= budget) {
+            if (allocated_bytes_.compare_exchange_weak(allocated, allocated + bytes,
+                                                       std::memory_order_relaxed)) {
+                return true;
+            }
+        }
+        if (trimmed) {
+            return false;
+        }
+        // Cached blocks count against the budget; give them up before refusing
+        trim_free_blocks(0);
+    }
+}
+
+void ChunkPool::trim_free_blocks(size_t keep_bytes) {
+    ChunkBlock* released = nullptr;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        while (free_list_ && free_blocks_ * BLOCK_SIZE > keep_bytes) {
+            ChunkBlock* block = free_list_;
+            free_list_ = block->next_free;
+            --free_blocks_;
+            block->next_free = released;
+            released = block;
+        }
+    }
+
+    while (released) {
+        ChunkBlock* next = released->next_free;
+        free_block(released);
+        released = next;
+    }
+}
+
+void ChunkPool::free_block(ChunkBlock* block) noexcept {
+    ChunkPool* pool = block->pool;
+    pool->allocated_bytes_.fetch_sub(block->capacity, std::memory_order_relaxed);
+    if (block->capacity == BLOCK_SIZE) {
+        pool->total_blocks_.fetch_sub(1, std::memory_order_relaxed);
+    }
+    block->~ChunkBlock();
+    ::operator delete(block);
+}
+
+bool ChunkWriter::append(std::string_view data, ChunkSlice& out) {
+    if (data.empty()) {
+        out = ChunkSlice();
+        return true;
+    }
+
+    if (data.size() > ChunkPool::MAX_SHARED_CHUNK) {
+        ChunkBlock* block = pool_->acquire(data.size());
+        if (!block) {
+            return false;
+        }
+        std::memcpy(block->data(), data.data(), data.size());
+        out = ChunkSlice(block, 0, static_cast<uint32_t>(data.size()));
+        return true;
+    }
+
+    if (!block_ || block_->capacity - used_ < data.size()) {
+        ChunkBlock* next = pool_->acquire();
+        if (!next) {
+            return false;
+        }
+        reset();
+        block_ = next;
+    }
+
+    std::memcpy(block_->data() + used_, data.data(), data.size());
+    block_->refs.fetch_add(1, std::memory_order_relaxed);
+    out = ChunkSlice(block_, used_, static_cast<uint32_t>(data.size()));
+    used_ += static_cast<uint32_t>(data.size());
+    return true;
+}
+
+void ChunkWriter::reset() noexcept {
+    if (block_ && block_->refs.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+        ChunkPool::release(block_);
+    }
+    block_ = nullptr;
+    used_ = 0;
+}
+
+} // namespace prettifier
+} // namespace aimux
@@ -14,74 +14,84 @@ namespace aimux {
 namespace prettifier {
 
 // ProviderPatterns implementation
-std::vector<std::regex> ProviderPatterns::get_cerebras_patterns() {
-    return {
+const std::vector<const CompiledPattern*>& ProviderPatterns::get_cerebras_patterns() {
+    auto& registry = PatternRegistry::instance();
+    static const std::vector<const CompiledPattern*> patterns = {
         // Fix incomplete code blocks (common in fast responses)
-        std::regex(R"(```([a-zA-Z0-9_]*)\s*\n(.*?)\n```)", std::regex::ECMAScript),
+        &registry.get("markdown.cerebras.code_block", R"(```([a-zA-Z0-9_]*)\s*\n(.*?)\n```)"),
 
         // Normalize JSON tool responses
-        std::regex(R"(\{\s*"tool_calls"\s*:\s*\[.*?\]\s*\})", std::regex::ECMAScript),
+        &registry.get("markdown.cerebras.tool_calls", R"(\{\s*"tool_calls"\s*:\s*\[.*?\]\s*\})"),
 
         // Fix missing language identifiers
-        std::regex(R"(```\s*\n(.*?)\n```)", std::regex::ECMAScript)
+        &registry.get("markdown.cerebras.code_block_no_lang", R"(```\s*\n(.*?)\n```)")
     };
+    return patterns;
 }
 
-std::vector<std::regex> ProviderPatterns::get_openai_patterns() {
-    return {
+const std::vector<const CompiledPattern*>& ProviderPatterns::get_openai_patterns() {
+    auto& registry = PatternRegistry::instance();
+    static const std::vector<const CompiledPattern*> patterns = {
         // Normalize OpenAI function calling format (simplified)
-        std::regex(R"(```json\s*\n\{[^}]*\}\s*```)", std::regex::ECMAScript),
+        &registry.get("markdown.openai.json_block", R"(```json\s*\n\{[^}]*\}\s*```)"),
 
         // Clean up verbose code blocks
-        std::regex(R"(```([a-zA-Z0-9_+]+)\s*\n(.*?)\s*```)", std::regex::ECMAScript),
+        &registry.get("markdown.openai.code_block", R"(```([a-zA-Z0-9_+]+)\s*\n(.*?)\s*```)"),
 
         // Normalize step-by-step explanations
-        std::regex(R"(^\s*\d+\.\s+(.*$))", std::regex::ECMAScript)
+        &registry.get("markdown.openai.numbered_step", R"(^\s*\d+\.\s+(.*$))")
     };
+    return patterns;
 }
 
-std::vector<std::regex> ProviderPatterns::get_anthropic_patterns() {
-    return {
+const std::vector<const CompiledPattern*>& ProviderPatterns::get_anthropic_patterns() {
+    auto& registry = PatternRegistry::instance();
+    static const std::vector<const CompiledPattern*> patterns = {
         // Handle Claude XML tool tags (simplified)
-        std::regex(R"(<tool_use>\s*\n\{.*?\}\s*\n</tool_use>)", std::regex::ECMAScript),
+        &registry.get("markdown.anthropic.tool_use", R"(<tool_use>\s*\n\{.*?\}\s*\n</tool_use>)"),
 
         // Extract thinking/reasoning blocks
-        std::regex(R"(<thinking>\s*\n(.*?)\n</thinking>)", std::regex::ECMAScript),
+        &registry.get("markdown.anthropic.thinking", R"(<thinking>\s*\n(.*?)\n</thinking>)"),
 
         // Fix Claude's sometimes inconsistent code fencing
-        std::regex(R"(```([a-zA-Z0-9_+]*)\s*(.*?)\s*```)", std::regex::ECMAScript)
+        &registry.get("markdown.anthropic.code_fence", R"(```([a-zA-Z0-9_+]*)\s*(.*?)\s*```)")
     };
+    return patterns;
 }
 
-std::vector<std::regex> ProviderPatterns::get_synthetic_patterns() {
-    return {
+const std::vector<const CompiledPattern*>& ProviderPatterns::get_synthetic_patterns() {
+    auto& registry = PatternRegistry::instance();
+    static const std::vector<const CompiledPattern*> patterns = {
         // Handle complex nested markdown structures
-        std::regex(R"(```([a-zA-Z0-9_+]*)\s*\n(.*?)\n```)", std::regex::ECMAScript),
+        &registry.get("markdown.synthetic.code_block", R"(```([a-zA-Z0-9_+]*)\s*\n(.*?)\n```)"),
 
         // Normalize structured tool outputs
-        std::regex(R"(\{\s*"tool"\s*:\s*"[^"]*"\s*,\s*"result"\s*:\s*[^}]*\s*\})", std::regex::ECMAScript),
+        &registry.get("markdown.synthetic.tool_result", R"(\{\s*"tool"\s*:\s*"[^"]*"\s*,\s*"result"\s*:\s*[^}]*\s*\})"),
 
         // Clean up reasoning chains
-        std::regex(R"(^\s*(?:Step\s+\d+:|=>|→)\s*(.*$))", std::regex::ECMAScript)
+        &registry.get("markdown.synthetic.reasoning_chain", R"(^\s*(?:Step\s+\d+:|=>|→)\s*(.*$))")
     };
+    return patterns;
 }
 
-std::vector<std::regex> ProviderPatterns::get_common_patterns() {
-    return {
+const std::vector<const CompiledPattern*>& ProviderPatterns::get_common_patterns() {
+    auto& registry = PatternRegistry::instance();
+    static const std::vector<const CompiledPattern*> patterns = {
         // Fix common markdown syntax errors
-        std::regex(R"(^\s*#{1,6}\s+(.+)$)", std::regex::ECMAScript),
+        &registry.get("markdown.common.heading", R"(^\s*#{1,6}\s+(.+)$)"),
 
         // Normalize list markers
-        std::regex(R"(^\s*[-*+]\s+(.+)$)", std::regex::ECMAScript),
-        std::regex(R"(^\s*\d+\.\s+(.+)$)", std::regex::ECMAScript),
+        &registry.get("markdown.common.bullet", R"(^\s*[-*+]\s+(.+)$)"),
+        &registry.get("markdown.common.numbered", R"(^\s*\d+\.\s+(.+)$)"),
 
         // Fix link formatting
-        std::regex(R"(\[([^\]]+)\]\s*\(\s*([^)]+)\s*\))", std::regex::ECMAScript),
+        &registry.get("markdown.common.link", R"(\[([^\]]+)\]\s*\(\s*([^)]+)\s*\))"),
 
         // Clean up excessive whitespace
-        std::regex(R"(\n{3,})"), // 3+ newlines to 2
-        std::regex(R"([ \t]{2,})") // 2+ spaces to 1
+        &registry.get("markdown.common.excess_newlines", R"(\n{3,})"), // 3+ newlines to 2
+        &registry.get("markdown.common.excess_spaces", R"([ \t]{2,})") // 2+ spaces to 1
     };
+    return patterns;
 }
 
 // MarkdownNormalizerPlugin implementation
@@ -277,6 +287,7 @@ nlohmann::json MarkdownNormalizerPlugin::get_configuration() const {
 nlohmann::json MarkdownNormalizerPlugin::get_metrics() const {
     nlohmann::json j = stats_.to_json();
     j["configuration"] = config_.to_json();
+    j["patterns"] = pattern_set_.to_json();
     return j;
 }
 
@@ -336,8 +347,7 @@ std::string MarkdownNormalizerPlugin::apply_provider_normalization(
     // Apply provider-specific transformations
     if (provider == "cerebras") {
         // Cerebras-specific fixes
-        processed = std::regex_replace(processed,
-            std::regex(R"(```\s*\n(.*?)\n```)"), "```text\n$1```");
+        processed = code_block_no_lang_->replace_all(processed, "```text\n$1```");
     } else if (provider == "openai") {
         // OpenAI-specific fixes
         // Clean up verbose output
@@ -383,8 +393,7 @@ std::string MarkdownNormalizerPlugin::normalize_code_blocks(const std::string& c
 
     try {
         // Simple code block fixing - ensure language is specified
-        static const std::regex code_block_no_lang_regex(R"(```\s*\n(.*?)\n```)", std::regex::ECMAScript);
-        processed = std::regex_replace(processed, code_block_no_lang_regex, "```text\n$1```");
+        processed = code_block_no_lang_->replace_all(processed, "```text\n$1```");
 
         stats_.code_blocks_fixed++;
 
@@ -404,7 +413,7 @@ std::string MarkdownNormalizerPlugin::cleanup_whitespace(const std::string& cont
 
     try {
         // Reduce multiple consecutive newlines to maximum 2
-        processed = std::regex_replace(processed, std::regex(R"(\n{3,})"), "\n\n");
+        processed = excess_newlines_->replace_all(processed, "\n\n");
 
         // Remove trailing whitespace from each line
         std::istringstream stream(processed);
@@ -478,16 +487,8 @@ std::string MarkdownNormalizerPlugin::apply_common_fixes(const std::string& cont
 
 bool MarkdownNormalizerPlugin::contains_injection_patterns(const std::string& content) const {
     // Check for common injection patterns
-    std::vector<std::regex> injection_patterns = {
-        std::regex(R"(<script[^>]*>.*?</script>)", std::regex::icase),
-        std::regex(R"(javascript\s*:)", std::regex::icase),
-        std::regex(R"(eval\s*\()", std::regex::icase),
-        std::regex(R"(document\s*\.)", std::regex::icase),
-        std::regex(R"(window\s*\.)", std::regex::icase)
-    };
-
-    for (const auto& pattern : injection_patterns) {
-        if (std::regex_search(content, pattern)) {
+    for (const CompiledPattern* pattern : injection_patterns_) {
+        if (pattern->search(content)) {
             return true;
         }
     }
@@ -505,14 +506,11 @@ std::string MarkdownNormalizerPlugin::sanitize_content(const std::string& conten
     std::string sanitized = content;
 
     // Remove or escape dangerous HTML elements
-    sanitized = std::regex_replace(sanitized,
-        std::regex(R"(<script[^>]*>)", std::regex::icase), "&lt;script&gt;");
-    sanitized = std::regex_replace(sanitized,
-        std::regex(R"(</script>)", std::regex::icase), "&lt;/script&gt;");
+    sanitized = script_open_->replace_all(sanitized, "&lt;script&gt;");
+    sanitized = script_close_->replace_all(sanitized, "&lt;/script&gt;");
 
     // Escape potential XSS vectors
-    sanitized = std::regex_replace(sanitized,
-        std::regex(R"(javascript\s*:)", std::regex::icase), "javascript:");
+    sanitized = javascript_scheme_->replace_all(sanitized, "javascript:");
 
     return sanitized;
 }
@@ -526,10 +524,23 @@ void MarkdownNormalizerPlugin::initialize_patterns() {
     provider_patterns_["synthetic"] = ProviderPatterns::get_synthetic_patterns();
     common_patterns_ = ProviderPatterns::get_common_patterns();
 
+    code_block_no_lang_ = &pattern_set_.add("markdown.code_block_no_lang", R"(```\s*\n(.*?)\n```)");
+    excess_newlines_ = &pattern_set_.add("markdown.common.excess_newlines", R"(\n{3,})");
+    script_open_ = &pattern_set_.add("security.script_open", R"(<script[^>]*>)", CompiledPattern::ICASE);
+    script_close_ = &pattern_set_.add("security.script_close", R"(</script>)", CompiledPattern::ICASE);
+    javascript_scheme_ = &pattern_set_.add("security.javascript_scheme", R"(javascript\s*:)", CompiledPattern::ICASE);
+    injection_patterns_ = {
+        &pattern_set_.add("markdown.injection.script_block", R"(<script[^>]*>.*?</script>)", CompiledPattern::ICASE),
+        javascript_scheme_,
+        &pattern_set_.add("markdown.injection.eval", R"(eval\s*\()", CompiledPattern::ICASE),
+        &pattern_set_.add("markdown.injection.document", R"(document\s*\.)", CompiledPattern::ICASE),
+        &pattern_set_.add("markdown.injection.window", R"(window\s*\.)", CompiledPattern::ICASE)
+    };
+
     log_debug("initialize_patterns", "Pattern initialization completed");
 }
 
-std::vector<std::regex> MarkdownNormalizerPlugin::get_provider_patterns(const std::string& provider) const {
+std::vector<const CompiledPattern*> MarkdownNormalizerPlugin::get_provider_patterns(const std::string& provider) const {
     std::lock_guard<std::mutex> lock(patterns_mutex_);
 
     auto it = provider_patterns_.find(provider);
@@ -1,7 +1,6 @@
 #include "aimux/prettifier/openai_formatter.hpp"
 #include "aimux/core/model_registry.hpp"
 #include <map>
-#include <regex>
 #include <sstream>
 #include <chrono>
 #include <algorithm>
@@ -24,13 +23,20 @@ namespace prettifier {
 
 // OpenAIPatterns implementation
 OpenAIFormatter::OpenAIPatterns::OpenAIPatterns()
-    : function_call_pattern(R"(\"tool_calls\":\s*\[\s*\{[^}]*\"function\"[^}]*\}\s*\])", std::regex::optimize)
-    , tool_calls_pattern(R"(\"function\":\s*\{[^}]*\"name\"[^}]*\"arguments\"[^}]*\})", std::regex::optimize)
-    , legacy_function_pattern(R"(\"function_call\":\s*\{[^}]*\"name\"[^}]*\"arguments\"[^}]*\})", std::regex::optimize)
-    , json_schema_pattern(R"(\"response_format\":\s*\{[^}]*\"type\"[^}]*\"schema\"[^}]*\})", std::regex::optimize)
-    , structured_output_pattern(R"(^\{[\s\S]*\}$)", std::regex::optimize) // Basic JSON structure
-    , streaming_delta_pattern(R"(\"delta\":\s*\{[^}]*\})", std::regex::optimize)
-    , streaming_function_delta(R"(\"function_call\":\s*\{[^}]*\})", std::regex::optimize) {
+    : function_call_pattern(set.add("openai.tool_calls_array", R"(\"tool_calls\":\s*\[\s*\{[^}]*\"function\"[^}]*\}\s*\])"))
+    , tool_calls_pattern(set.add("openai.function_object", R"(\"function\":\s*\{[^}]*\"name\"[^}]*\"arguments\"[^}]*\})"))
+    , legacy_function_pattern(set.add("openai.legacy_function_call", R"(\"function_call\":\s*\{[^}]*\"name\"[^}]*\"arguments\"[^}]*\})"))
+    , json_schema_pattern(set.add("openai.json_schema", R"(\"response_format\":\s*\{[^}]*\"type\"[^}]*\"schema\"[^}]*\})"))
+    , structured_output_pattern(set.add("openai.structured_output", R"(^\{[\s\S]*\}$)")) // Basic JSON structure
+    , streaming_delta_pattern(set.add("openai.streaming_delta", R"(\"delta\":\s*\{[^}]*\})"))
+    , streaming_function_delta(set.add("openai.streaming_function_delta", R"(\"function_call\":\s*\{[^}]*\})"))
+    , sse_data_pattern(set.add("openai.sse_data", R"(data:\s*\{[^}]*\})"))
+    , trailing_comma_pattern(set.add("openai.trailing_comma", R"(,\s*([}\]]))"))
+    , artifacts_pattern(set.add("openai.stream_artifacts", R"(\[DONE\]|data:\s*\{|:\s*\"?DONE\"?)"))
+    , whitespace_pattern(set.add("openai.whitespace", R"(\s+)")) {
+    for (const CompiledPattern* pattern : PatternRegistry::instance().security_patterns()) {
+        set.track(*pattern);
+    }
 }
 
 // OpenAIFormatter implementation
@@ -197,30 +203,36 @@ ProcessingResult OpenAIFormatter::postprocess_response(
         result.success = true;
         result.output_format = "toon";
 
+        // Parse the body once; every step below reads this document
+        std::optional<nlohmann::json> repaired;
+        const nlohmann::json* document = response_json(response, repaired);
+
         // Detect format type
-        std::string format_type = detect_format_type(response.data);
+        std::string format_type = document ? detect_format_type(*document) : "unknown";
         LOG_DEBUG("Detected format type: %s", format_type.c_str());
 
         // Clean content based on detected format
-        std::string cleaned_content = clean_openai_content(response.data);
+        std::string cleaned_content = document ? core::dump_json(*document) : clean_openai_content(response.data);
 
         // Extract function calls based on format
         std::vector<ToolCall> tool_calls;
         std::string final_content = cleaned_content;
+        std::string content_format = document ? format_type : detect_format_type(final_content);
 
         if (format_type == "function-calling" || format_type == "legacy-function") {
-            tool_calls = extract_openai_function_calls(cleaned_content);
+            tool_calls = extract_openai_function_calls(*document);
         } else if (format_type == "structured-output") {
-            // Validate structured output JSON
-            final_content = validate_structured_output(cleaned_content);
+            // Validate structured output JSON; cleaned_content is already its canonical form
+            check_structured_output(*document);
         } else if (format_type == "legacy-format" && support_legacy_formats_) {
             // Process legacy formats
             final_content = process_legacy_format(cleaned_content);
             tool_calls = extract_openai_function_calls(final_content);
+            content_format = detect_format_type(final_content);
         }
 
         // Generate OpenAI-compatible TOON format
-        std::string toon_content = generate_openai_toon(final_content, tool_calls, context);
+        std::string toon_content = generate_openai_toon(final_content, tool_calls, content_format, context);
 
         result.processed_content = toon_content;
         result.extracted_tool_calls = tool_calls;
@@ -295,10 +307,9 @@ ProcessingResult OpenAIFormatter::process_streaming_chunk(
         auto chunk_json = validate_json(chunk);
         if (!chunk_json) {
             // Try to extract JSON from SSE format
-            static const std::regex sse_pattern(R"(data:\s*\{[^}]*\})");
-            std::smatch match;
-            if (std::regex_search(chunk, match, sse_pattern)) {
-                chunk_json = validate_json(match[0].str());
+            PatternMatch match;
+            if (patterns_->sse_data_pattern.search(chunk, match)) {
+                chunk_json = validate_json(match.str());
             }
         }
 
@@ -382,7 +393,8 @@ ProcessingResult OpenAIFormatter::end_streaming(const ProcessingContext& context
         std::vector<ToolCall> final_tool_calls = extract_openai_function_calls(streaming_content_);
 
         // Generate final TOON format
-        std::string final_toon = generate_openai_toon(streaming_content_, final_tool_calls, context);
+        std::string final_toon = generate_openai_toon(
+            streaming_content_, final_tool_calls, detect_format_type(streaming_content_), context);
 
         ProcessingResult result;
         result.success = true;
@@ -476,6 +488,7 @@ nlohmann::json OpenAIFormatter::get_metrics() const {
     metrics["streaming_chunks_processed"] = streaming_chunks_processed_.load();
     metrics["success_rate"] = count > 0 ?
         static_cast<double>(count - validation_errors_.load()) / count : 1.0;
+    metrics["patterns"] = patterns_->set.to_json();
 
     return metrics;
 }
@@ -588,17 +601,20 @@ nlohmann::json OpenAIFormatter::get_diagnostics() const {
 // Private helper methods implementation
 
 std::vector<ToolCall> OpenAIFormatter::extract_openai_function_calls(const std::string& content) const {
+    auto content_json = validate_json(content);
+    if (!content_json) {
+        return {};
+    }
+    return extract_openai_function_calls(*content_json);
+}
+
+std::vector<ToolCall> OpenAIFormatter::extract_openai_function_calls(const nlohmann::json& content_json) const {
     std::vector<ToolCall> tool_calls;
 
     try {
-        auto content_json = validate_json(content);
-        if (!content_json) {
-            return tool_calls;
-        }
-
         // Extract from standard tool_calls format
-        if (content_json->contains("choices") && !content_json->at("choices").empty()) {
-            const auto& choice = content_json->at("choices")[0];
+        if (content_json.contains("choices") && !content_json.at("choices").empty()) {
+            const auto& choice = content_json.at("choices")[0];
             if (choice.contains("message") && choice.at("message").contains("tool_calls")) {
                 const auto& tool_calls_array = choice.at("message")["tool_calls"];
 
@@ -634,8 +650,8 @@ std::vector<ToolCall> OpenAIFormatter::extract_openai_function_calls(const std::
 
         // Extract from legacy function_call format
         if (tool_calls.empty() && support_legacy_formats_) {
-            if (content_json->contains("choices") && !content_json->at("choices").empty()) {
-                const auto& choice = content_json->at("choices")[0];
+            if (content_json.contains("choices") && !content_json.at("choices").empty()) {
+                const auto& choice = content_json.at("choices")[0];
                 if (choice.contains("message") && choice.at("message").contains("function_call")) {
                     const auto& func_call = choice.at("message")["function_call"];
 
@@ -676,27 +692,9 @@ std::string OpenAIFormatter::validate_structured_output(
 
     try {
         // Try to parse as JSON
-        auto json = nlohmann::json::parse(content);
-
-        // Basic validation
-        if (!json.is_object()) {
-            throw std::invalid_argument("Structured output must be a JSON object");
-        }
-
-        // Schema validation if provided
-        if (schema && validate_tool_schemas_) {
-            // Basic schema validation - could be expanded with full JSON schema support
-            if (schema->contains("required")) {
-                for (const auto& required_field : schema->at("required")) {
-                    if (!json.contains(required_field.get<std::string>())) {
-                        throw std::invalid_argument("Missing required field: " + required_field.get<std::string>());
-                    }
-                }
-            }
-        }
-
-        structured_outputs_validated_.fetch_add(1);
-        return json.dump();
+        auto json = core::parse_json(content);
+        check_structured_output(json, schema);
+        return core::dump_json(json);
 
     } catch (const nlohmann::json::parse_error& e) {
         // Try to repair common JSON issues
@@ -704,12 +702,11 @@ std::string OpenAIFormatter::validate_structured_output(
             std::string repaired = content;
 
             // Remove trailing commas
-            static const std::regex trailing_comma(R"(,\s*([}\]]))");
-            repaired = std::regex_replace(repaired, trailing_comma, "$1");
+            repaired = patterns_->trailing_comma_pattern.replace_all(repaired, "$1");
 
-            auto json = nlohmann::json::parse(repaired);
+            auto json = core::parse_json(repaired);
             structured_outputs_validated_.fetch_add(1);
-            return json.dump();
+            return core::dump_json(json);
 
         } catch (...) {
             throw std::invalid_argument("Invalid structured output JSON: " + std::string(e.what()));
@@ -717,6 +714,30 @@ std::string OpenAIFormatter::validate_structured_output(
     }
 }
 
+void OpenAIFormatter::check_structured_output(
+    const nlohmann::json& json,
+    const std::optional<nlohmann::json>& schema) const {
+
+    // Basic validation
+    if (!json.is_object()) {
+        throw std::invalid_argument("Structured output must be a JSON object");
+    }
+
+    // Schema validation if provided
+    if (schema && validate_tool_schemas_) {
+        // Basic schema validation - could be expanded with full JSON schema support
+        if (schema->contains("required")) {
+            for (const auto& required_field : schema->at("required")) {
+                if (!json.contains(required_field.get<std::string>())) {
+                    throw std::invalid_argument("Missing required field: " + required_field.get<std::string>());
+                }
+            }
+        }
+    }
+
+    structured_outputs_validated_.fetch_add(1);
+}
+
 std::string OpenAIFormatter::process_legacy_format(const std::string& content) const {
     try {
         auto content_json = validate_json(content);
@@ -749,6 +770,7 @@ std::string OpenAIFormatter::process_legacy_format(const std::string& content) c
 std::string OpenAIFormatter::generate_openai_toon(
     const std::string& content,
     const std::vector<ToolCall>& tool_calls,
+    const std::string& format_type,
     const ProcessingContext& context) const {
 
     try {
@@ -777,13 +799,13 @@ std::string OpenAIFormatter::generate_openai_toon(
             {"processed_at", std::chrono::duration_cast<std::chrono::seconds>(
                 std::chrono::system_clock::now().time_since_epoch()).count()},
             {"openai_capabilities", capabilities()},
-            {"format_type", detect_format_type(content)},
+            {"format_type", format_type},
             {"legacy_support_enabled", support_legacy_formats_},
             {"structured_outputs_enabled", enable_structured_outputs_},
             {"function_validation", strict_function_validation_}
         };
 
-        return toon.dump();
+        return core::dump_json(toon);
 
     } catch (const std::exception& e) {
         LOG_DEBUG("TOON generation failed: %s", e.what());
@@ -867,15 +889,18 @@ void OpenAIFormatter::update_openai_metrics(
 }
 
 std::string OpenAIFormatter::detect_format_type(const std::string& content) const {
-    try {
-        auto content_json = validate_json(content);
-        if (!content_json) {
-            return "unknown";
-        }
+    auto content_json = validate_json(content);
+    if (!content_json) {
+        return "unknown";
+    }
+    return detect_format_type(*content_json);
+}
 
+std::string OpenAIFormatter::detect_format_type(const nlohmann::json& content_json) const {
+    try {
         // Check for function calling
-        if (content_json->contains("choices") && !content_json->at("choices").empty()) {
-            const auto& choice = content_json->at("choices")[0];
+        if (content_json.contains("choices") && !content_json.at("choices").empty()) {
+            const auto& choice = content_json.at("choices")[0];
             if (choice.contains("message")) {
                 const auto& message = choice.at("message");
 
@@ -888,14 +913,14 @@ std::string OpenAIFormatter::detect_format_type(const std::string& content) cons
         }
 
         // Check for structured output
-        if (content_json->is_object() && !content_json->contains("choices")) {
+        if (content_json.is_object() && !content_json.contains("choices")) {
             return "structured-output";
         }
 
         // Check for legacy format
-        if (content_json->contains("text") ||
-            (content_json->contains("choices") &&
-             content_json->at("choices")[0].contains("text"))) {
+        if (content_json.contains("text") ||
+            (content_json.contains("choices") &&
+             content_json.at("choices")[0].contains("text"))) {
             return "legacy-format";
         }
 
@@ -927,12 +952,10 @@ std::string OpenAIFormatter::clean_openai_content(const std::string& content) co
         std::string cleaned = content;
 
         // Remove common OpenAI artifacts
-        static const std::regex artifacts_pattern(R"(\[DONE\]|data:\s*\{|:\s*\"?DONE\"?)", std::regex::optimize);
-        cleaned = std::regex_replace(cleaned, artifacts_pattern, "");
+        cleaned = patterns_->artifacts_pattern.replace_all(cleaned, "");
 
         // Normalize whitespace
-        static const std::regex whitespace_pattern(R"(\s+)", std::regex::optimize);
-        cleaned = std::regex_replace(cleaned, whitespace_pattern, " ");
+        cleaned = patterns_->whitespace_pattern.replace_all(cleaned, " ");
 
         // Trim
         cleaned.erase(0, cleaned.find_first_not_of(" \t\n\r"));
@@ -947,34 +970,8 @@ std::string OpenAIFormatter::clean_openai_content(const std::string& content) co
 }
 
 bool OpenAIFormatter::contains_malicious_patterns(const std::string& content) const {
-    std::vector<std::regex> malicious_patterns = {
-        // XSS patterns
-        std::regex(R"(<script[^>]*>)", std::regex::icase),
-        std::regex(R"(javascript\s*:)", std::regex::icase),
-        std::regex(R"(onerror\s*=)", std::regex::icase),
-        std::regex(R"(onload\s*=)", std::regex::icase),
-        std::regex(R"(</script>)", std::regex::icase),
-
-        // Code execution patterns
-        std::regex(R"(eval\s*\()", std::regex::icase),
-        std::regex(R"(system\s*\()", std::regex::icase),
-        std::regex(R"(exec\s*\()", std::regex::icase),
-
-        // SQL injection patterns
-        std::regex(R"('\s+OR\s+'1'\s*=\s*'1)", std::regex::icase),
-        std::regex(R"("\s+OR\s+"1"\s*=\s*"1)", std::regex::icase),
-        std::regex(R"(;\s*DROP\s+TABLE)", std::regex::icase),
-        std::regex(R"(UNION\s+SELECT)", std::regex::icase),
-
-        // Path traversal patterns
-        std::regex(R"(\.\./)", std::regex::icase),
-        std::regex(R"(\.\.[\\\/])", std::regex::icase),
-        std::regex(R"(/etc/passwd)", std::regex::icase),
-        std::regex(R"(c:\\windows)", std::regex::icase)
-    };
-
-    for (const auto& pattern : malicious_patterns) {
-        if (std::regex_search(content, pattern)) {
+    for (const CompiledPattern* pattern : PatternRegistry::instance().security_patterns()) {
+        if (pattern->search(content)) {
             return true;
         }
     }
@@ -0,0 +1,400 @@
+#include "aimux/prettifier/pattern_registry.hpp"
+#include <algorithm>
+#include <cstdio>
+#include <mutex>
+#include <optional>
+#include <regex>
+
+#ifdef AIMUX_HAVE_RE2
+#include <re2/re2.h>
+#endif
+
+#define LOG_WARN(msg, ...) do { printf("[WARN] PatternRegistry: " msg "\n", ##__VA_ARGS__); } while(0)
+
+namespace aimux {
+namespace prettifier {
+
+namespace {
+    // Capture groups held on the stack before spilling to the heap
+    constexpr int INLINE_GROUPS = 16;
+
+    void append_format(std::string& out, std::string_view format, const PatternMatch& match,
+                       std::string_view text) {
+        for (size_t i = 0; i < format.size(); ++i) {
+            char c = format[i];
+            if (c != '$' || i + 1 == format.size()) {
+                out.push_back(c);
+                continue;
+            }
+
+            char next = format[i + 1];
+            if (next == '$') {
+                out.push_back('$');
+                ++i;
+            } else if (next == '&') {
+                out.append(match.groups[0]);
+                ++i;
+            } else if (next == '`') {
+                out.append(text.substr(0, match.position));
+                ++i;
+            } else if (next == '\'') {
+                out.append(text.substr(match.position + match.length()));
+                ++i;
+            } else if (next >= '0' && next <= '9') {
+                size_t index = static_cast<size_t>(next - '0');
+                size_t consumed = 1;
+                // Two-digit group references take precedence when that group exists
+                if (i + 2 < format.size() && format[i + 2] >= '0' && format[i + 2] <= '9') {
+                    size_t two = index * 10 + static_cast<size_t>(format[i + 2] - '0');
+                    if (two < match.size()) {
+                        index = two;
+                        consumed = 2;
+                    }
+                }
+                if (index < match.size()) {
+                    out.append(match.groups[index]);
+                }
+                i += consumed;
+            } else {
+                out.push_back(c);
+            }
+        }
+    }
+}
+
+// ============================================================================
+// CompiledPattern
+// ============================================================================
+
+struct CompiledPattern::Engine {
+#ifdef AIMUX_HAVE_RE2
+    std::unique_ptr<re2::RE2> re2;
+#endif
+    std::optional<std::regex> fallback;
+    int group_count = 0;
+};
+
+CompiledPattern::CompiledPattern(std::string name, std::string pattern, uint32_t flags)
+    : name_(std::move(name)), pattern_(std::move(pattern)), flags_(flags),
+      engine_(std::make_unique<Engine>()) {
+#ifdef AIMUX_HAVE_RE2
+    re2::RE2::Options options;
+    options.set_encoding(re2::RE2::Options::EncodingLatin1);   // Byte semantics, like std::regex
+    options.set_case_sensitive((flags_ & ICASE) == 0);
+    options.set_log_errors(false);
+
+    std::string source = (flags_ & MULTILINE) ? "(?m)" + pattern_ : pattern_;
+    auto compiled = std::make_unique<re2::RE2>(source, options);
+    if (compiled->ok()) {
+        engine_->group_count = compiled->NumberOfCapturingGroups();
+        engine_->re2 = std::move(compiled);
+        return;
+    }
+    LOG_WARN("'%s' uses syntax outside RE2 (%s); falling back to std::regex",
+             name_.c_str(), compiled->error().c_str());
+#endif
+
+    auto syntax = std::regex::ECMAScript | std::regex::optimize;
+    if (flags_ & ICASE) {
+        syntax |= std::regex::icase;
+    }
+    if (flags_ & MULTILINE) {
+        syntax |= std::regex::multiline;
+    }
+    engine_->fallback.emplace(pattern_, syntax);
+    engine_->group_count = static_cast<int>(engine_->fallback->mark_count());
+}
+
+CompiledPattern::~CompiledPattern() = default;
+
+const char* CompiledPattern::engine() const {
+#ifdef AIMUX_HAVE_RE2
+    if (engine_->re2) {
+        return "re2";
+    }
+#endif
+    return "std::regex";
+}
+
+bool CompiledPattern::find(std::string_view text, size_t start, bool anchor_both,
+                           PatternMatch* match) const {
+#ifdef AIMUX_HAVE_RE2
+    if (engine_->re2) {
+        re2::StringPiece input(text.data(), text.size());
+        if (!match) {
+            // No submatches requested lets RE2 answer from its DFA alone
+            return engine_->re2->Match(input, start, text.size(),
+                                       anchor_both ? re2::RE2::ANCHOR_BOTH : re2::RE2::UNANCHORED,
+                                       nullptr, 0);
+        }
+
+        int count = engine_->group_count + 1;
+        re2::StringPiece inline_groups[INLINE_GROUPS];
+        std::vector<re2::StringPiece> heap_groups;
+        re2::StringPiece* groups = inline_groups;
+        if (count > INLINE_GROUPS) {
+            heap_groups.resize(static_cast<size_t>(count));
+            groups = heap_groups.data();
+        }
+
+        if (!engine_->re2->Match(input, start, text.size(),
+                                 anchor_both ? re2::RE2::ANCHOR_BOTH : re2::RE2::UNANCHORED,
+                                 groups, count)) {
+            return false;
+        }
+        match->groups.resize(static_cast<size_t>(count));
+        for (int i = 0; i < count; ++i) {
+            match->groups[i] = groups[i].data() ? std::string_view(groups[i].data(), groups[i].size())
+                                                : std::string_view();
+        }
+        match->position = static_cast<size_t>(groups[0].data() - text.data());
+        return true;
+    }
+#endif
+
+    const std::regex& regex = *engine_->fallback;
+    const char* begin = text.data() + start;
+    const char* end = text.data() + text.size();
+    auto flags = start > 0 ? std::regex_constants::match_prev_avail
+                           : std::regex_constants::match_default;
+
+    std::cmatch m;
+    bool found = anchor_both ? std::regex_match(begin, end, m, regex, flags)
+                             : std::regex_search(begin, end, m, regex, flags);
+    if (!found || !match) {
+        return found;
+    }
+    match->groups.resize(m.size());
+    for (size_t i = 0; i < m.size(); ++i) {
+        match->groups[i] = m[i].matched
+            ? std::string_view(m[i].first, static_cast<size_t>(m[i].second - m[i].first))
+            : std::string_view();
+    }
+    match->position = static_cast<size_t>(m[0].first - text.data());
+    return true;
+}
+
+void CompiledPattern::record(std::chrono::steady_clock::duration elapsed, bool matched) const {
+    uint64_t ns = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count());
+    calls_.fetch_add(1, std::memory_order_relaxed);
+    total_ns_.fetch_add(ns, std::memory_order_relaxed);
+    if (matched) {
+        matches_.fetch_add(1, std::memory_order_relaxed);
+    }
+    uint64_t previous = max_ns_.load(std::memory_order_relaxed);
+    while (ns > previous && !max_ns_.compare_exchange_weak(previous, ns, std::memory_order_relaxed)) {
+    }
+}
+
+bool CompiledPattern::search(std::string_view text) const {
+    auto start = std::chrono::steady_clock::now();
+    bool found = find(text, 0, false, nullptr);
+    record(std::chrono::steady_clock::now() - start, found);
+    return found;
+}
+
+bool CompiledPattern::search(std::string_view text, PatternMatch& match) const {
+    auto start = std::chrono::steady_clock::now();
+    bool found = find(text, 0, false, &match);
+    record(std::chrono::steady_clock::now() - start, found);
+    return found;
+}
+
+bool CompiledPattern::full_match(std::string_view text) const {
+    auto start = std::chrono::steady_clock::now();
+    bool found = find(text, 0, true, nullptr);
+    record(std::chrono::steady_clock::now() - start, found);
+    return found;
+}
+
+bool CompiledPattern::full_match(std::string_view text, PatternMatch& match) const {
+    auto start = std::chrono::steady_clock::now();
+    bool found = find(text, 0, true, &match);
+    record(std::chrono::steady_clock::now() - start, found);
+    return found;
+}
+
+size_t CompiledPattern::for_each_match(std::string_view text,
+                                       const std::function<bool(const PatternMatch&)>& visitor) const {
+    auto start = std::chrono::steady_clock::now();
+    size_t count = 0;
+    size_t position = 0;
+    PatternMatch match;
+
+    while (position <= text.size() && find(text, position, false, &match)) {
+        ++count;
+        bool keep_going = visitor(match);
+        // Step past empty matches so the scan always advances
+        position = match.position + std::max<size_t>(match.length(), 1);
+        if (!keep_going) {
+            break;
+        }
+    }
+
+    record(std::chrono::steady_clock::now() - start, count > 0);
+    return count;
+}
+
+std::string CompiledPattern::replace_all(std::string_view text, std::string_view format) const {
+    auto start = std::chrono::steady_clock::now();
+    std::string out;
+    size_t copied = 0;
+    size_t position = 0;
+    bool any = false;
+    PatternMatch match;
+
+    while (position <= text.size() && find(text, position, false, &match)) {
+        if (!any) {
+            out.reserve(text.size());
+            any = true;
+        }
+        out.append(text.substr(copied, match.position - copied));
+        append_format(out, format, match, text);
+        copied = match.position + match.length();
+
+        if (match.length() == 0) {
+            // An empty match consumes nothing; copy one character and move on
+            if (match.position < text.size()) {
+                out.push_back(text[match.position]);
+            }
+            copied = match.position + 1;
+        }
+        position = copied;
+    }
+
+    if (any) {
+        if (copied < text.size()) {
+            out.append(text.substr(copied));
+        }
+    } else {
+        out.assign(text);
+    }
+
+    record(std::chrono::steady_clock::now() - start, any);
+    return out;
+}
+
+nlohmann::json CompiledPattern::to_json() const {
+    uint64_t calls = calls_.load(std::memory_order_relaxed);
+    uint64_t total_ns = total_ns_.load(std::memory_order_relaxed);
+
+    nlohmann::json j;
+    j["pattern"] = pattern_;
+    j["engine"] = engine();
+    j["calls"] = calls;
+    j["matches"] = matches_.load(std::memory_order_relaxed);
+    j["total_time_us"] = total_ns / 1000;
+    j["avg_time_us"] = calls > 0 ? static_cast<double>(total_ns) / 1000.0 / static_cast<double>(calls) : 0.0;
+    j["max_time_us"] = static_cast<double>(max_ns_.load(std::memory_order_relaxed)) / 1000.0;
+    return j;
+}
+
+void CompiledPattern::reset_stats() const {
+    calls_.store(0, std::memory_order_relaxed);
+    matches_.store(0, std::memory_order_relaxed);
+    total_ns_.store(0, std::memory_order_relaxed);
+    max_ns_.store(0, std::memory_order_relaxed);
+}
+
+// ============================================================================
+// PatternRegistry
+// ============================================================================
+
+PatternRegistry& PatternRegistry::instance() {
+    static PatternRegistry registry;
+    return registry;
+}
+
+const CompiledPattern& PatternRegistry::get(const std::string& name, const std::string& pattern,
+                                            uint32_t flags) {
+    std::string key = std::to_string(flags) + ':' + pattern;
+    {
+        std::shared_lock<std::shared_mutex> lock(mutex_);
+        auto it = patterns_.find(key);
+        if (it != patterns_.end()) {
+            return *it->second;
+        }
+    }
+
+    // Compile outside the lock; a racing registration of the same key keeps the first
+    auto compiled = std::make_unique<CompiledPattern>(name, pattern, flags);
+    std::unique_lock<std::shared_mutex> lock(mutex_);
+    auto [it, inserted] = patterns_.try_emplace(key, std::move(compiled));
+    return *it->second;
+}
+
+const std::vector<const CompiledPattern*>& PatternRegistry::security_patterns() {
+    static const std::vector<const CompiledPattern*> patterns = [this]() {
+        auto add = [this](const char* name, const char* pattern) {
+            return &get(std::string("security.") + name, pattern, CompiledPattern::ICASE);
+        };
+        return std::vector<const CompiledPattern*>{
+            // XSS patterns
+            add("script_open", R"(<script[^>]*>)"),
+            add("javascript_scheme", R"(javascript\s*:)"),
+            add("onerror", R"(onerror\s*=)"),
+            add("onload", R"(onload\s*=)"),
+            add("script_close", R"(</script>)"),
+
+            // Code execution patterns
+            add("eval", R"(eval\s*\()"),
+            add("system", R"(system\s*\()"),
+            add("exec", R"(exec\s*\()"),
+
+            // SQL injection patterns
+            add("sql_or_single", R"('\s+OR\s+'1'\s*=\s*'1)"),
+            add("sql_or_double", R"("\s+OR\s+"1"\s*=\s*"1)"),
+            add("drop_table", R"(;\s*DROP\s+TABLE)"),
+            add("union_select", R"(UNION\s+SELECT)"),
+
+            // Path traversal patterns
+            add("path_traversal", R"(\.\./)"),
+            add("dot_dot_separator", R"(\.\.[\\\/])"),
+            add("etc_passwd", R"(/etc/passwd)"),
+            add("windows_dir", R"(c:\\windows)")
+        };
+    }();
+    return patterns;
+}
+
+size_t PatternRegistry::size() const {
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+    return patterns_.size();
+}
+
+nlohmann::json PatternRegistry::get_metrics() const {
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+    nlohmann::json metrics = nlohmann::json::object();
+    for (const auto& [key, pattern] : patterns_) {
+        metrics[pattern->name()] = pattern->to_json();
+    }
+    return metrics;
+}
+
+// ============================================================================
+// PatternSet
+// ============================================================================
+
+const CompiledPattern& PatternSet::add(const std::string& name, const std::string& pattern,
+                                       uint32_t flags) {
+    const CompiledPattern& compiled = PatternRegistry::instance().get(name, pattern, flags);
+    track(compiled);
+    return compiled;
+}
+
+void PatternSet::track(const CompiledPattern& pattern) {
+    if (std::find(patterns_.begin(), patterns_.end(), &pattern) == patterns_.end()) {
+        patterns_.push_back(&pattern);
+    }
+}
+
+nlohmann::json PatternSet::to_json() const {
+    nlohmann::json metrics = nlohmann::json::object();
+    for (const CompiledPattern* pattern : patterns_) {
+        metrics[pattern->name()] = pattern->to_json();
+    }
+    return metrics;
+}
+
+} // namespace prettifier
+} // namespace aimux
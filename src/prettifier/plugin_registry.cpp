@@ -4,7 +4,7 @@
 #include <algorithm>
 #include <random>
 #include <sstream>
-#include <regex>
+#include "aimux/prettifier/pattern_registry.hpp"
 #include <atomic>
 
 namespace aimux {
@@ -44,8 +44,9 @@ PluginManifest PluginManifest::from_json(const nlohmann::json& j) {
 }
 
 bool PluginManifest::validate() const {
-    std::regex name_regex(R"(^[a-zA-Z0-9_-]+$)");
-    if (!std::regex_match(name, name_regex)) return false;
+    static const CompiledPattern& name_pattern =
+        PatternRegistry::instance().get("plugin.manifest_name", R"([a-zA-Z0-9_-]+)");
+    if (!name_pattern.full_match(name)) return false;
     if (name.empty() || version.empty()) return false;
     return true;
 }
@@ -1,5 +1,5 @@
 #include "aimux/prettifier/prettifier_plugin.hpp"
-#include <regex>
+#include "aimux/prettifier/pattern_registry.hpp"
 #include <sstream>
 
 // TODO: Replace with proper logging when available
@@ -89,26 +89,20 @@ std::vector<ToolCall> PrettifierPlugin::extract_tool_calls(const std::string& co
 
     // Common patterns for tool calls across different providers
 
+    auto& registry = PatternRegistry::instance();
+
     // Pattern 1: XML-style function calls (Claude format)
-    static const std::regex xml_pattern(
+    static const CompiledPattern& xml_pattern = registry.get("plugin.xml_function_calls",
         R"(<function_calls>\s*(\{[^<]*\})\s*</function_calls>)");
 
     // Pattern 2: JSON in code blocks (OpenAI format)
-    static const std::regex json_code_pattern(
+    static const CompiledPattern& json_code_pattern = registry.get("plugin.json_code_block",
         R"(```(?:json)?\s*(\{[^`]*\})\s*```)");
 
-    // Pattern 3: Direct JSON objects (non-recursive for C++ regex compatibility)
-    static const std::regex direct_json_pattern(
-        R"(\{[^{}]*\})");
-
     try {
-        std::smatch match;
-        std::string search_content = content;
-
         // Try XML pattern first
-        while (std::regex_search(search_content, match, xml_pattern)) {
-            std::string json_str = match[1].str();
-            auto json_opt = validate_json(json_str);
+        xml_pattern.for_each_match(content, [&](const PatternMatch& match) {
+            auto json_opt = validate_json(match.str(1));
             if (json_opt) {
                 ToolCall call;
                 call.status = "pending";
@@ -126,15 +120,12 @@ std::vector<ToolCall> PrettifierPlugin::extract_tool_calls(const std::string& co
 
                 tool_calls.push_back(call);
             }
-
-            search_content = match.suffix();
-        }
+            return true;
+        });
 
         // Try JSON code block pattern
-        search_content = content;
-        while (std::regex_search(search_content, match, json_code_pattern)) {
-            std::string json_str = match[1].str();
-            auto json_opt = validate_json(json_str);
+        json_code_pattern.for_each_match(content, [&](const PatternMatch& match) {
+            auto json_opt = validate_json(match.str(1));
             if (json_opt) {
                 ToolCall call;
                 call.status = "pending";
@@ -154,9 +145,8 @@ std::vector<ToolCall> PrettifierPlugin::extract_tool_calls(const std::string& co
 
                 tool_calls.push_back(call);
             }
-
-            search_content = match.suffix();
-        }
+            return true;
+        });
 
         // Try direct JSON pattern (be more selective to avoid false positives)
         // Temporarily disabled due to regex issues - will re-enable later
@@ -201,7 +191,7 @@ std::vector<ToolCall> PrettifierPlugin::extract_tool_calls(const std::string& co
 std::optional<nlohmann::json> PrettifierPlugin::validate_json(const std::string& content) const {
     try {
         // Try to parse as JSON
-        auto json = nlohmann::json::parse(content);
+        auto json = core::parse_json(content);
         return json;
     } catch (const nlohmann::json::parse_error& e) {
         // Try to repair common JSON issues
@@ -219,11 +209,12 @@ std::optional<nlohmann::json> PrettifierPlugin::validate_json(const std::string&
             }
 
             // Remove whitespace before closing braces/brackets that was after commas
-            static const std::regex whitespace_before_closing(R"(\s*([}\]])\s*$)");
-            repaired = std::regex_replace(repaired, whitespace_before_closing, "$1");
+            static const CompiledPattern& whitespace_before_closing = PatternRegistry::instance().get(
+                "plugin.whitespace_before_closing", R"(\s*([}\]])\s*$)");
+            repaired = whitespace_before_closing.replace_all(repaired, "$1");
 
             // Try parsing again
-            auto json = nlohmann::json::parse(repaired);
+            auto json = core::parse_json(repaired);
             return json;
         } catch (...) {
             // If repair fails, return empty
@@ -232,5 +223,17 @@ std::optional<nlohmann::json> PrettifierPlugin::validate_json(const std::string&
     }
 }
 
+const nlohmann::json* PrettifierPlugin::response_json(const core::Response& response,
+                                                      std::optional<nlohmann::json>& repaired) const {
+    if (const nlohmann::json* document = response.json()) {
+        return document;
+    }
+    if (response.data.empty()) {
+        return nullptr;
+    }
+    repaired = validate_json(response.data);
+    return repaired ? &*repaired : nullptr;
+}
+
 } // namespace prettifier
 } // namespace aimux
\ No newline at end of file
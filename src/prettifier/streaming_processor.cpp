@@ -13,37 +13,35 @@ namespace aimux {
 namespace prettifier {
 
 // StreamingProcessor implementation
-StreamingProcessor::StreamingProcessor() : start_time_(std::chrono::steady_clock::now()) {
-    LOG_DEBUG("Initializing StreamingProcessor with thread pool size: %d", thread_pool_size_);
+StreamingProcessor::StreamingProcessor() : StreamingProcessor(core::ThreadPool::shared()) {}
 
-    try {
-        initialize_buffer_pool();
-        initialize_thread_pool();
-        LOG_DEBUG("StreamingProcessor initialized successfully");
-    } catch (const std::exception& e) {
-        LOG_ERROR("Failed to initialize StreamingProcessor: %s", e.what());
-        throw;
-    }
+StreamingProcessor::StreamingProcessor(std::shared_ptr<core::ThreadPool> pool)
+    : pool_(std::move(pool)), start_time_(std::chrono::steady_clock::now()) {
+    LOG_DEBUG("Initializing StreamingProcessor on pool '%s' (%zu workers)", pool_->name().c_str(), pool_->size());
 }
 
 StreamingProcessor::~StreamingProcessor() {
     LOG_DEBUG("Shutting down StreamingProcessor");
 
-    // Signal shutdown to worker threads
+    // Queued chunks see the flag and resolve to false without processing
     shutdown_requested_.store(true);
-    queue_cv_.notify_all();
 
-    // Wait for all worker threads to complete
-    for (auto& thread : worker_threads_) {
-        if (thread.joinable()) {
-            thread.join();
-        }
-    }
-
-    // Clean up remaining streams
+    // The pool outlives us, so wait for drains that still reference this processor
     {
-        std::unique_lock<std::shared_mutex> lock(streams_mutex_);
-        active_streams_.clear();
+        std::unique_lock<std::mutex> lock(pending_mutex_);
+        pending_cv_.wait(lock, [this] { return pending_tasks_.load() == 0; });
+    }
+
+    // Outstanding futures may keep a context alive; settle them and hand
+    // every slice back before the chunk pool goes away
+    for (auto& shard : stream_shards_) {
+        std::unique_lock<std::shared_mutex> lock(shard.mutex);
+        for (auto& [stream_id, stream] : shard.streams) {
+            discard_queued_chunks(*stream);
+            std::lock_guard<std::mutex> ctx_lock(stream->context_mutex);
+            close_stream(*stream, "Processor shut down");
+        }
+        shard.streams.clear();
     }
 
     LOG_DEBUG("StreamingProcessor shutdown completed");
@@ -56,7 +54,7 @@ std::string StreamingProcessor::create_stream(
     auto stream_id = generate_stream_id();
 
     try {
-        auto stream_context = std::make_unique<StreamContext>();
+        auto stream_context = std::make_shared<StreamContext>(chunk_pool_);
         stream_context->stream_id = stream_id;
         stream_context->process_context = context;
         stream_context->start_time = std::chrono::steady_clock::now();
@@ -77,20 +75,36 @@ std::string StreamingProcessor::create_stream(
             }}
         };
 
+        if (!validate_stream_state(*stream_context)) {
+            throw std::invalid_argument("Stream requires a formatter");
+        }
+
         // Pre-allocate chunk buffer
         stream_context->chunk_buffer.reserve(100); // Reserve space for 100 chunks
         stream_context->content_accumulator.reserve(8192); // 8KB initial content buffer
 
+        // Streams that have queued their final chunk no longer count
+        if (open_streams_.fetch_add(1) >= max_concurrent_streams_) {
+            open_streams_.fetch_sub(1);
+            throw std::runtime_error("Maximum concurrent streams exceeded");
+        }
+
         {
-            std::unique_lock<std::shared_mutex> lock(streams_mutex_);
-            if (active_streams_.size() >= max_concurrent_streams_) {
-                throw std::runtime_error("Maximum concurrent streams exceeded");
-            }
-            active_streams_[stream_id] = std::move(stream_context);
+            auto& shard = stream_shards_[shard_index(stream_id)];
+            std::unique_lock<std::shared_mutex> lock(shard.mutex);
+            shard.streams[stream_id] = std::move(stream_context);
         }
 
         total_streams_.fetch_add(1);
 
+        // Reap uncollected streams at most once a second
+        auto now_ms = std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count();
+        auto due_ms = next_cleanup_ms_.load(std::memory_order_relaxed);
+        if (now_ms >= due_ms && next_cleanup_ms_.compare_exchange_strong(due_ms, now_ms + 1000)) {
+            cleanup_expired_streams();
+        }
+
         LOG_DEBUG("Created stream %s for provider %s", stream_id.c_str(), context.provider_name.c_str());
         return stream_id;
 
@@ -101,44 +115,34 @@ std::string StreamingProcessor::create_stream(
     }
 }
 
+bool StreamingProcessor::submit_chunk(
+    const std::string& stream_id,
+    std::string_view chunk,
+    bool is_final) {
+
+    auto stream_context = get_stream_context(stream_id);
+    return stream_context && enqueue_chunk(stream_context, chunk, is_final, nullptr);
+}
+
 std::future<bool> StreamingProcessor::process_chunk(
     const std::string& stream_id,
     const std::string& chunk,
     bool is_final) {
 
     auto stream_context = get_stream_context(stream_id);
-    if (!stream_context || !stream_context->is_active) {
+    uint64_t sequence = 0;
+    if (!stream_context || !enqueue_chunk(stream_context, chunk, is_final, &sequence)) {
         std::promise<bool> promise;
         promise.set_value(false);
         return promise.get_future();
     }
 
-    // Apply backpressure if necessary
-    if (!apply_backpressure(stream_id)) {
-        std::promise<bool> promise;
-        promise.set_value(false);
-        backpressure_events_.fetch_add(1);
-        return promise.get_future();
-    }
-
-    // Create processing task
-    ProcessingTask task;
-    task.stream_id = stream_id;
-    task.chunk_data = chunk;
-    task.is_final = is_final;
-    task.timestamp = std::chrono::steady_clock::now();
-
-    // Get future BEFORE moving task into queue
-    auto future = task.completion_promise.get_future();
-
-    {
-        std::unique_lock<std::mutex> lock(queue_mutex_);
-        task_queue_.push(std::move(task));
-    }
-
-    queue_cv_.notify_one();
-
-    return future;
+    // Resolved from the stream's completion signal instead of a promise per chunk
+    return std::async(std::launch::deferred, [stream_context = std::move(stream_context), sequence] {
+        std::unique_lock<std::mutex> lock(stream_context->context_mutex);
+        stream_context->completion_cv.wait(lock, [&] { return stream_context->chunks_settled > sequence; });
+        return sequence < stream_context->chunks_succeeded;
+    });
 }
 
 ProcessingResult StreamingProcessor::get_result(const std::string& stream_id) {
@@ -150,39 +154,32 @@ ProcessingResult StreamingProcessor::get_result(const std::string& stream_id) {
         return result;
     }
 
-    // Wait for stream to be finalized with simple polling
-    constexpr int max_wait_ms = 5000;
-    constexpr int poll_interval_ms = 10;
-    auto start_wait = std::chrono::steady_clock::now();
+    // Wait for the stream to be finalized or closed; the worker signals it
+    constexpr auto max_wait = std::chrono::milliseconds(5000);
+    auto stream_deadline = stream_context->start_time + std::chrono::milliseconds(stream_timeout_ms_);
+    auto wait_until = std::min(std::chrono::steady_clock::now() + max_wait, stream_deadline);
 
-    while (true) {
-        bool is_active = stream_context->is_active.load();
-        bool is_finalized = stream_context->is_finalized.load();
-
-        if (!is_active || is_finalized) {
-            break; // Stream is done
-        }
+    std::unique_lock<std::mutex> lock(stream_context->context_mutex);
+    bool done = stream_context->completion_cv.wait_until(lock, wait_until, [&] {
+        return !stream_context->is_active.load();
+    });
 
-        auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(
-            std::chrono::steady_clock::now() - start_wait).count();
-
-        if (elapsed > max_wait_ms) {
+    if (!done) {
+        if (std::chrono::steady_clock::now() < stream_deadline) {
             ProcessingResult result;
             result.success = false;
             result.error_message = "Stream result retrieval timeout: " + stream_id;
             return result;
         }
-
-        std::this_thread::sleep_for(std::chrono::milliseconds(poll_interval_ms));
+        close_stream(*stream_context, "Stream timeout");
     }
 
-    // Now safely read the stream context with lock
-    std::lock_guard<std::mutex> lock(stream_context->context_mutex);
-
     if (!stream_context->error_message.empty()) {
         ProcessingResult result;
         result.success = false;
         result.error_message = stream_context->error_message;
+        lock.unlock();
+        erase_stream(stream_id);
         return result;
     }
 
@@ -218,6 +215,8 @@ ProcessingResult StreamingProcessor::get_result(const std::string& stream_id) {
     LOG_DEBUG("Retrieved result for stream %s: %zu chunks in %ld ms",
               stream_id.c_str(), stream_context->total_chunks, total_time);
 
+    lock.unlock();
+    erase_stream(stream_id);
     return result;
 }
 
@@ -228,14 +227,11 @@ bool StreamingProcessor::cancel_stream(const std::string& stream_id) {
     }
 
     {
+        // Chunks still queued are settled as failed by the stream's drain
         std::lock_guard<std::mutex> lock(stream_context->context_mutex);
-        stream_context->is_active.store(false);
-        stream_context->error_message = "Stream cancelled";
+        close_stream(*stream_context, "Stream cancelled");
     }
 
-    // Update statistics
-    failed_streams_.fetch_add(1);
-
     LOG_DEBUG("Cancelled stream %s", stream_id.c_str());
     return true;
 }
@@ -256,6 +252,7 @@ bool StreamingProcessor::configure(const nlohmann::json& config) {
 
         if (config.contains("buffer_size_mb")) {
             buffer_size_mb_ = config["buffer_size_mb"].get<size_t>();
+            chunk_pool_.set_budget(buffer_size_mb_ * 1024 * 1024);
         }
 
         if (config.contains("backpressure_threshold")) {
@@ -308,27 +305,23 @@ StreamingProcessor::ProcessorStats StreamingProcessor::get_statistics() const {
     ProcessorStats stats;
 
     auto now = std::chrono::steady_clock::now();
-    auto total_time_ms = std::chrono::duration_cast<std::chrono::milliseconds>(now - start_time_).count();
+    double elapsed_seconds = std::chrono::duration<double>(now - start_time_).count();
 
     stats.total_streams = total_streams_.load();
     stats.completed_streams = completed_streams_.load();
     stats.failed_streams = failed_streams_.load();
     stats.total_chunks_processed = total_chunks_processed_.load();
     stats.total_bytes_processed = total_bytes_processed_.load();
-    stats.current_memory_usage = current_memory_usage_.load();
+    stats.current_memory_usage = chunk_pool_.allocated_bytes();
     stats.backpressure_events = backpressure_events_.load();
 
     // Calculate derived metrics
-    if (total_time_ms > 0) {
-        stats.average_chunks_per_second = static_cast<double>(total_chunks_processed_.load()) / (total_time_ms / 1000.0);
-        stats.average_throughput_mbps = (static_cast<double>(total_bytes_processed_.load()) * 8.0) / (total_time_ms * 1000000.0);
+    if (elapsed_seconds > 0.0) {
+        stats.average_chunks_per_second = static_cast<double>(stats.total_chunks_processed) / elapsed_seconds;
+        stats.average_throughput_mbps = (static_cast<double>(stats.total_bytes_processed) * 8.0) / (elapsed_seconds * 1000000.0);
     }
 
-    // Count active streams
-    {
-        std::shared_lock<std::shared_mutex> lock(streams_mutex_);
-        stats.active_streams = active_streams_.size();
-    }
+    stats.active_streams = open_streams_.load();
 
     return stats;
 }
@@ -355,23 +348,45 @@ nlohmann::json StreamingProcessor::get_diagnostics() const {
     diagnostics["configuration"] = get_configuration();
 
     // Thread pool status
+    auto pool_stats = pool_->get_stats();
+    nlohmann::json workers = nlohmann::json::array();
+    for (const auto& worker : pool_stats.workers) {
+        workers.push_back({
+            {"queue_depth", worker.queued_tasks},
+            {"executed", worker.executed_tasks},
+            {"stolen", worker.stolen_tasks},
+            {"idle", worker.idle},
+            {"cpu", worker.cpu}
+        });
+    }
     diagnostics["thread_pool"] = {
-        {"worker_threads", worker_threads_.size()},
+        {"name", pool_->name()},
+        {"worker_threads", pool_stats.total_threads},
+        {"active_threads", pool_stats.active_threads},
+        {"queued_tasks", pool_stats.queued_tasks},
+        {"stolen_tasks", pool_stats.stolen_tasks},
+        {"pending_chunks", pending_tasks_.load()},
+        {"workers", workers},
         {"shutdown_requested", shutdown_requested_.load()}
     };
 
-    // Buffer pool status
+    // Chunk pool status
+    auto pool_usage = chunk_pool_.get_stats();
     diagnostics["buffer_pool"] = {
-        {"total_buffers", buffer_pool_.total_buffers},
-        {"available_buffers", buffer_pool_.available_buffers.size()},
-        {"buffer_size_bytes", buffer_pool_.buffer_size}
+        {"total_buffers", pool_usage.total_blocks},
+        {"available_buffers", pool_usage.free_blocks},
+        {"buffer_size_bytes", ChunkPool::BLOCK_SIZE},
+        {"budget_bytes", pool_usage.budget_bytes},
+        {"allocated_bytes", pool_usage.allocated_bytes},
+        {"in_use_bytes", pool_usage.in_use_bytes},
+        {"rejected_allocations", pool_usage.rejected}
     };
 
     // Active streams details
     nlohmann::json streams_info = nlohmann::json::array();
-    {
-        std::shared_lock<std::shared_mutex> lock(streams_mutex_);
-        for (const auto& [stream_id, stream] : active_streams_) {
+    for (const auto& shard : stream_shards_) {
+        std::shared_lock<std::shared_mutex> lock(shard.mutex);
+        for (const auto& [stream_id, stream] : shard.streams) {
             auto stream_age_ms = std::chrono::duration_cast<std::chrono::milliseconds>(
                 std::chrono::steady_clock::now() - stream->start_time).count();
 
@@ -385,6 +400,7 @@ nlohmann::json StreamingProcessor::get_diagnostics() const {
                 {"model", stream->process_context.model_name},
                 {"chunks_received", stream->total_chunks},
                 {"bytes_received", stream->total_bytes},
+                {"queued_chunks", stream->queue.size()},
                 {"age_ms", stream_age_ms},
                 {"is_active", is_active},
                 {"is_finalized", is_finalized}
@@ -407,7 +423,7 @@ nlohmann::json StreamingProcessor::health_check() const {
         auto stats = get_statistics();
 
         // Check thread pool responsiveness
-        bool thread_pool_responsive = !shutdown_requested_.load() && !worker_threads_.empty();
+        bool thread_pool_responsive = !shutdown_requested_.load() && pool_ && pool_->size() > 0;
         health["thread_pool_responsive"] = thread_pool_responsive;
 
         // Check memory usage
@@ -458,7 +474,6 @@ void StreamingProcessor::reset_statistics() {
     total_chunks_processed_.store(0);
     total_bytes_processed_.store(0);
     backpressure_events_.store(0);
-    current_memory_usage_.store(0);
 
     start_time_ = std::chrono::steady_clock::now();
 
@@ -511,152 +526,234 @@ void StreamingProcessor::optimize_for_memory() {
 
 // Private methods implementation
 
-void StreamingProcessor::initialize_thread_pool() {
-    worker_threads_.reserve(static_cast<size_t>(thread_pool_size_));
+bool StreamingProcessor::enqueue_chunk(
+    const std::shared_ptr<StreamContext>& stream,
+    std::string_view chunk,
+    bool is_final,
+    uint64_t* sequence) {
 
-    for (int i = 0; i < thread_pool_size_; ++i) {
-        worker_threads_.emplace_back(&StreamingProcessor::worker_thread_main, this);
+    if (shutdown_requested_.load()) {
+        return false;
     }
 
-    LOG_DEBUG("Thread pool initialized with %d threads", thread_pool_size_);
-}
+    {
+        std::lock_guard<std::mutex> lock(stream->producer_mutex);
+        if (!stream->is_active.load() || stream->final_submitted) {
+            return false;
+        }
 
-void StreamingProcessor::worker_thread_main() {
-    thread_local std::string thread_id = "worker_" + std::to_string(std::hash<std::thread::id>{}(std::this_thread::get_id()));
+        // Per-stream budget: chunks held by the stream, queued or processed
+        if (stream->chunks_submitted >= backpressure_threshold_ || stream->queue.full()) {
+            LOG_DEBUG("Backpressure applied to stream %s: %lu chunks held, %zu queued",
+                      stream->stream_id.c_str(), static_cast<unsigned long>(stream->chunks_submitted),
+                      stream->queue.size());
+            backpressure_events_.fetch_add(1);
+            return false;
+        }
 
-    while (!shutdown_requested_.load()) {
-        std::unique_lock<std::mutex> lock(queue_mutex_);
+        // Global budget: bytes held by all streams
+        QueuedChunk queued;
+        if (!stream->writer.append(chunk, queued.data)) {
+            LOG_DEBUG("Backpressure applied to stream %s: chunk memory budget of %zu MB exhausted",
+                      stream->stream_id.c_str(), buffer_size_mb_);
+            backpressure_events_.fetch_add(1);
+            return false;
+        }
 
-        // Wait for task or shutdown
-        queue_cv_.wait(lock, [this]() {
-            return !task_queue_.empty() || shutdown_requested_.load();
-        });
+        queued.is_final = is_final;
+        queued.enqueued_ms = static_cast<uint32_t>(std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::steady_clock::now() - stream->start_time).count());
+        stream->queue.try_push(std::move(queued));
 
-        if (shutdown_requested_.load()) {
-            break;
+        if (sequence) {
+            *sequence = stream->chunks_submitted;
         }
+        ++stream->chunks_submitted;
+        stream->final_submitted = is_final;
+    }
 
-        if (task_queue_.empty()) {
-            continue;
-        }
+    if (is_final) {
+        release_open_slot(*stream);
+    }
 
-        ProcessingTask task = std::move(task_queue_.front());
-        task_queue_.pop();
+    // Pairs with the fence in drain_stream: either the drain sees this chunk
+    // or we see its flag cleared and schedule another
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    schedule_drain(stream);
+    return true;
+}
+
+void StreamingProcessor::schedule_drain(const std::shared_ptr<StreamContext>& stream) {
+    if (stream->drain_scheduled.exchange(true)) {
+        return;
+    }
 
-        lock.unlock(); // Release queue lock while processing
+    pending_tasks_.fetch_add(1);
+    bool queued = pool_->post([this, stream] {
+        drain_stream(stream);
+        finish_pending_task();
+    });
 
-        auto start_time = std::chrono::high_resolution_clock::now();
+    if (!queued) {
+        // Pool shut down: nobody else will read the ring
+        finish_pending_task();
+        discard_queued_chunks(*stream);
+        stream->drain_scheduled.store(false);
+    }
+}
 
-        try {
-            bool success = process_task(task);
-            task.completion_promise.set_value(success);
+void StreamingProcessor::drain_stream(const std::shared_ptr<StreamContext>& stream) {
+    // Bound the time one stream holds a worker; the rest goes to the back of the pool
+    constexpr size_t max_batch = 64;
+    QueuedChunk chunk;
 
-            auto elapsed_us = std::chrono::duration_cast<std::chrono::microseconds>(
-                std::chrono::high_resolution_clock::now() - start_time).count();
+    while (true) {
+        size_t processed = 0;
+        while (processed < max_batch && stream->queue.try_pop(chunk)) {
+            run_chunk(*stream, chunk);
+            chunk.data.reset();
+            ++processed;
+        }
 
-            if (enable_metrics_) {
-                update_metrics(task.chunk_data.length(), static_cast<size_t>(elapsed_us));
+        if (processed == max_batch) {
+            pending_tasks_.fetch_add(1);
+            if (pool_->post([this, stream] {
+                    drain_stream(stream);
+                    finish_pending_task();
+                })) {
+                return;
             }
+            finish_pending_task();
+            continue;
+        }
+
+        stream->drain_scheduled.store(false);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
 
-        } catch (const std::exception& e) {
-            LOG_ERROR("Task processing failed in %s: %s", thread_id.c_str(), e.what());
-            task.completion_promise.set_exception(std::current_exception());
+        // A producer that pushed before seeing the flag cleared left its chunk to us
+        if (stream->queue.empty() || stream->drain_scheduled.exchange(true)) {
+            return;
         }
     }
-
-    LOG_DEBUG("Worker thread %s exiting", thread_id.c_str());
 }
 
-bool StreamingProcessor::process_task(const ProcessingTask& task) {
-    auto stream_context = get_stream_context(task.stream_id);
-    if (!stream_context || !stream_context->is_active.load()) {
-        return false;
+void StreamingProcessor::run_chunk(StreamContext& stream, QueuedChunk& chunk) {
+    auto start_time = std::chrono::steady_clock::now();
+    size_t chunk_size = chunk.data.size();
+
+    bool success = false;
+    if (!shutdown_requested_.load() && stream.is_active.load()) {
+        success = process_queued_chunk(stream, chunk);
     }
 
-    try {
-        // Prepare for processing - scope the lock
-        std::shared_ptr<PrettifierPlugin> formatter;
-        ProcessingContext process_context;
-        bool is_final = task.is_final;
+    {
+        std::lock_guard<std::mutex> lock(stream.context_mutex);
+        if (success && stream.chunks_succeeded == stream.chunks_settled) {
+            ++stream.chunks_succeeded;
+        }
+        ++stream.chunks_settled;
+    }
+    stream.completion_cv.notify_all();
 
-        {
-            std::lock_guard<std::mutex> lock(stream_context->context_mutex);
+    if (success) {
+        total_chunks_processed_.fetch_add(1);
+        if (enable_metrics_) {
+            auto elapsed_us = std::chrono::duration_cast<std::chrono::microseconds>(
+                std::chrono::steady_clock::now() - start_time).count();
+            update_metrics(chunk_size, static_cast<size_t>(elapsed_us));
+        }
+    }
+}
 
-            // Double-check active status after acquiring lock
-            if (!stream_context->is_active.load()) {
-                return false;
-            }
+bool StreamingProcessor::process_queued_chunk(StreamContext& stream, QueuedChunk& chunk) {
+    // Only this stream's drain runs here, and everything read outside the
+    // lock (formatter, context, start time) is fixed at creation
+    auto now = std::chrono::steady_clock::now();
+    auto stream_age_ms = std::chrono::duration_cast<std::chrono::milliseconds>(now - stream.start_time).count();
 
-            // Check for timeout
-            auto now = std::chrono::steady_clock::now();
-            auto stream_age_ms = std::chrono::duration_cast<std::chrono::milliseconds>(
-                now - stream_context->start_time).count();
+    if (stream_age_ms > stream_timeout_ms_) {
+        std::lock_guard<std::mutex> lock(stream.context_mutex);
+        close_stream(stream, "Stream timeout");
+        return false;
+    }
 
-            if (stream_age_ms > stream_timeout_ms_) {
-                stream_context->error_message = "Stream timeout";
-                stream_context->is_active.store(false);
-                failed_streams_.fetch_add(1);
-                return false;
-            }
+    if (stream_age_ms - chunk.enqueued_ms > chunk_timeout_ms_) {
+        LOG_DEBUG("Chunk timeout for stream %s, processing anyway", stream.stream_id.c_str());
+    }
 
-            // Check chunk timeout
-            auto chunk_age_ms = std::chrono::duration_cast<std::chrono::milliseconds>(
-                now - task.timestamp).count();
-            if (chunk_age_ms > chunk_timeout_ms_) {
-                LOG_DEBUG("Chunk timeout for stream %s, processing anyway", task.stream_id.c_str());
-            }
+    try {
+        // The plugin interface takes a std::string; stage the slice in a
+        // per-worker buffer whose capacity is reused across chunks
+        thread_local std::string staging;
+        staging.assign(chunk.data.view());
 
-            // Add chunk to buffer
-            stream_context->chunk_buffer.push_back(task.chunk_data);
-            stream_context->total_bytes += task.chunk_data.length();
-            stream_context->total_chunks++;
-            total_chunks_processed_.fetch_add(task.chunk_data.length());
+        ProcessingResult chunk_result = stream.formatter->process_streaming_chunk(
+            staging,
+            chunk.is_final,
+            stream.process_context);
 
-            // Copy formatter and context for processing outside lock
-            formatter = stream_context->formatter;
-            process_context = stream_context->process_context;
-        } // Release lock while doing expensive formatting
+        std::lock_guard<std::mutex> lock(stream.context_mutex);
 
-        // Process chunk with formatter (without holding lock)
-        ProcessingResult chunk_result = formatter->process_streaming_chunk(
-            task.chunk_data,
-            is_final,
-            process_context);
+        // Cancelled while the formatter ran
+        if (!stream.is_active.load()) {
+            return false;
+        }
 
-        // Re-acquire lock for modifications
-        {
-            std::lock_guard<std::mutex> lock(stream_context->context_mutex);
+        stream.total_bytes += chunk.data.size();
+        stream.total_chunks++;
+        stream.chunk_buffer.push_back(std::move(chunk.data));
 
-            if (is_final) {
-                finalize_stream(*stream_context);
-            }
+        // Extract tool calls if any
+        if (!chunk_result.extracted_tool_calls.empty()) {
+            stream.accumulated_tool_calls.insert(
+                stream.accumulated_tool_calls.end(),
+                chunk_result.extracted_tool_calls.begin(),
+                chunk_result.extracted_tool_calls.end());
+        }
 
-            // Extract tool calls if any
-            if (!chunk_result.extracted_tool_calls.empty()) {
-                stream_context->accumulated_tool_calls.insert(
-                    stream_context->accumulated_tool_calls.end(),
-                    chunk_result.extracted_tool_calls.begin(),
-                    chunk_result.extracted_tool_calls.end());
-            }
+        // Accumulate content
+        if (!chunk_result.processed_content.empty()) {
+            stream.content_accumulator += chunk_result.processed_content;
+        }
 
-            // Accumulate content
-            if (!chunk_result.processed_content.empty()) {
-                stream_context->content_accumulator += chunk_result.processed_content;
-            }
+        if (chunk.is_final) {
+            finalize_stream(stream);
         }
 
         return true;
 
     } catch (const std::exception& e) {
-        LOG_ERROR("Failed to process task for stream %s: %s", task.stream_id.c_str(), e.what());
-        std::lock_guard<std::mutex> lock(stream_context->context_mutex);
-        stream_context->error_message = e.what();
-        stream_context->is_active.store(false);
-        failed_streams_.fetch_add(1);
+        LOG_ERROR("Failed to process chunk for stream %s: %s", stream.stream_id.c_str(), e.what());
+        std::lock_guard<std::mutex> lock(stream.context_mutex);
+        close_stream(stream, e.what());
         return false;
     }
 }
 
+void StreamingProcessor::discard_queued_chunks(StreamContext& stream) {
+    QueuedChunk chunk;
+    size_t discarded = 0;
+    while (stream.queue.try_pop(chunk)) {
+        chunk.data.reset();
+        ++discarded;
+    }
+
+    if (discarded > 0) {
+        {
+            std::lock_guard<std::mutex> lock(stream.context_mutex);
+            stream.chunks_settled += discarded;
+        }
+        stream.completion_cv.notify_all();
+    }
+}
+
+void StreamingProcessor::finish_pending_task() {
+    std::lock_guard<std::mutex> lock(pending_mutex_);
+    if (pending_tasks_.fetch_sub(1) == 1) {
+        pending_cv_.notify_all();
+    }
+}
+
 void StreamingProcessor::finalize_stream(StreamContext& stream) {
     // Caller must hold stream.context_mutex
     if (stream.is_finalized.load()) {
@@ -677,7 +774,37 @@ void StreamingProcessor::finalize_stream(StreamContext& stream) {
     }
 
     stream.is_finalized.store(true);
-    stream.is_active.store(false);
+    close_stream(stream, "");
+}
+
+void StreamingProcessor::release_open_slot(StreamContext& stream) {
+    if (stream.holds_open_slot.exchange(false)) {
+        open_streams_.fetch_sub(1);
+    }
+}
+
+bool StreamingProcessor::close_stream(StreamContext& stream, const std::string& error) {
+    // Caller must hold stream.context_mutex
+    if (!stream.is_active.exchange(false)) {
+        return false;
+    }
+
+    if (!error.empty()) {
+        stream.error_message = error;
+        failed_streams_.fetch_add(1);
+    }
+    release_open_slot(stream);
+
+    // The raw chunks are no longer needed; return their storage to the pool
+    stream.chunk_buffer.clear();
+    stream.chunk_buffer.shrink_to_fit();
+    {
+        std::lock_guard<std::mutex> producer_lock(stream.producer_mutex);
+        stream.writer.reset();
+    }
+
+    stream.completion_cv.notify_all();
+    return true;
 }
 
 std::string StreamingProcessor::generate_streaming_toon(StreamContext& stream) {
@@ -711,119 +838,59 @@ std::string StreamingProcessor::generate_streaming_toon(StreamContext& stream) {
     return toon.dump();
 }
 
-bool StreamingProcessor::apply_backpressure(const std::string& stream_id) {
-    auto stream_context = get_stream_context(stream_id);
-    if (!stream_context) {
-        return false;
-    }
-
-    // Check per-stream threshold
-    if (stream_context->total_chunks >= backpressure_threshold_) {
-        LOG_DEBUG("Backpressure applied to stream %s: %zu chunks received",
-                  stream_id.c_str(), stream_context->total_chunks);
-        return false;
-    }
-
-    // Check global threshold
-    {
-        std::shared_lock<std::shared_mutex> lock(streams_mutex_);
-        if (active_streams_.size() >= max_concurrent_streams_) {
-            LOG_DEBUG("Global backpressure: %zu active streams", active_streams_.size());
-            return false;
-        }
-    }
-
-    return true;
-}
-
-char* StreamingProcessor::get_buffer_from_pool() {
-    std::lock_guard<std::mutex> lock(buffer_pool_.pool_mutex);
-
-    if (buffer_pool_.available_buffers.empty()) {
-        // Allocate new buffer if pool is empty
-        auto new_buffer = std::make_unique<char[]>(buffer_pool_.buffer_size);
-        char* buffer_ptr = new_buffer.get();
-        buffer_pool_.buffers.push_back(std::move(new_buffer));
-        buffer_pool_.total_buffers++;
-        return buffer_ptr;
-    }
-
-    char* buffer = buffer_pool_.available_buffers.front();
-    buffer_pool_.available_buffers.pop();
-    return buffer;
-}
-
-void StreamingProcessor::return_buffer_to_pool(char* buffer) {
-    std::lock_guard<std::mutex> lock(buffer_pool_.pool_mutex);
-    buffer_pool_.available_buffers.push(buffer);
-}
-
-void StreamingProcessor::initialize_buffer_pool() {
-    size_t buffer_size = 1024 * 1024; // 1MB buffers
-    size_t num_buffers = (buffer_size_mb_ * 1024 * 1024) / buffer_size;
-
-    buffer_pool_.buffer_size = buffer_size;
-    buffer_pool_.total_buffers = num_buffers;
-
-    // Allocate initial buffers
-    for (size_t i = 0; i < num_buffers; ++i) {
-        auto buffer = std::make_unique<char[]>(buffer_size);
-        buffer_pool_.available_buffers.push(buffer.get());
-        buffer_pool_.buffers.push_back(std::move(buffer));
-    }
-
-    LOG_DEBUG("Buffer pool initialized: %zu buffers of %zu bytes each", num_buffers, buffer_size);
-}
-
 void StreamingProcessor::update_metrics(size_t chunk_size, size_t /*processing_time_us*/) {
     if (enable_metrics_) {
         total_bytes_processed_.fetch_add(chunk_size);
-        current_memory_usage_.fetch_add(chunk_size);
     }
 }
 
 void StreamingProcessor::cleanup_expired_streams() {
     auto now = std::chrono::steady_clock::now();
 
-    std::unique_lock<std::shared_mutex> lock(streams_mutex_);
-    auto it = active_streams_.begin();
-
-    while (it != active_streams_.end()) {
-        auto age_ms = std::chrono::duration_cast<std::chrono::milliseconds>(
-            now - it->second->start_time).count();
-
-        bool is_finalized = it->second->is_finalized.load();
-
-        if (age_ms > stream_timeout_ms_ * 2 && !is_finalized) {
-            LOG_DEBUG("Cleaning up expired stream %s", it->first.c_str());
-
-            // Lock the stream context before modifying
-            {
-                std::lock_guard<std::mutex> ctx_lock(it->second->context_mutex);
-                it->second->is_active.store(false);
-                it->second->error_message = "Stream expired";
+    for (auto& shard : stream_shards_) {
+        std::unique_lock<std::shared_mutex> lock(shard.mutex);
+        auto it = shard.streams.begin();
+
+        while (it != shard.streams.end()) {
+            auto& stream = *it->second;
+            auto age_ms = std::chrono::duration_cast<std::chrono::milliseconds>(
+                now - stream.start_time).count();
+
+            bool expired = false;
+            if (!stream.is_active.load()) {
+                // Finished or cancelled and never collected
+                expired = age_ms > stream_timeout_ms_;
+            } else if (age_ms > stream_timeout_ms_ * 2) {
+                LOG_DEBUG("Cleaning up expired stream %s", it->first.c_str());
+                std::lock_guard<std::mutex> ctx_lock(stream.context_mutex);
+                close_stream(stream, "Stream expired");
+                expired = true;
             }
 
-            failed_streams_.fetch_add(1);
-            it = active_streams_.erase(it);
-        } else {
-            ++it;
+            if (expired) {
+                it = shard.streams.erase(it);
+            } else {
+                ++it;
+            }
         }
     }
 }
 
 std::shared_ptr<StreamingProcessor::StreamContext> StreamingProcessor::get_stream_context(const std::string& stream_id) const {
-    std::shared_lock<std::shared_mutex> lock(streams_mutex_);
-    auto it = active_streams_.find(stream_id);
-    if (it != active_streams_.end()) {
-        // Return raw pointer wrapped in shared_ptr with custom deleter that does nothing
-        // The mutex lock ensures the unique_ptr remains valid during this access
-        // But we need to ensure callers don't hold onto this beyond the scope where they need it
-        StreamContext* raw_ptr = it->second.get();
-        // Return a shared_ptr with a no-op deleter - the unique_ptr still owns the memory
-        return std::shared_ptr<StreamContext>(raw_ptr, [](StreamContext*){});
-    }
-    return nullptr;
+    const auto& shard = stream_shards_[shard_index(stream_id)];
+    std::shared_lock<std::shared_mutex> lock(shard.mutex);
+    auto it = shard.streams.find(stream_id);
+    return it != shard.streams.end() ? it->second : nullptr;
+}
+
+void StreamingProcessor::erase_stream(const std::string& stream_id) {
+    auto& shard = stream_shards_[shard_index(stream_id)];
+    std::unique_lock<std::shared_mutex> lock(shard.mutex);
+    shard.streams.erase(stream_id);
+}
+
+size_t StreamingProcessor::shard_index(const std::string& stream_id) {
+    return std::hash<std::string>{}(stream_id) % STREAM_SHARDS;
 }
 
 std::string StreamingProcessor::generate_stream_id() const {
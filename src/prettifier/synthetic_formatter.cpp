@@ -1,5 +1,5 @@
 #include "aimux/prettifier/synthetic_formatter.hpp"
-#include <regex>
+#include "aimux/prettifier/pattern_registry.hpp"
 #include <sstream>
 #include <chrono>
 #include <algorithm>
@@ -1087,34 +1087,8 @@ nlohmann::json SyntheticFormatter::analyze_performance_regression() const {
 }
 
 bool SyntheticFormatter::contains_malicious_patterns(const std::string& content) const {
-    std::vector<std::regex> malicious_patterns = {
-        // XSS patterns
-        std::regex(R"(<script[^>]*>)", std::regex::icase),
-        std::regex(R"(javascript\s*:)", std::regex::icase),
-        std::regex(R"(onerror\s*=)", std::regex::icase),
-        std::regex(R"(onload\s*=)", std::regex::icase),
-        std::regex(R"(</script>)", std::regex::icase),
-
-        // Code execution patterns
-        std::regex(R"(eval\s*\()", std::regex::icase),
-        std::regex(R"(system\s*\()", std::regex::icase),
-        std::regex(R"(exec\s*\()", std::regex::icase),
-
-        // SQL injection patterns
-        std::regex(R"('\s+OR\s+'1'\s*=\s*'1)", std::regex::icase),
-        std::regex(R"("\s+OR\s+"1"\s*=\s*"1)", std::regex::icase),
-        std::regex(R"(;\s*DROP\s+TABLE)", std::regex::icase),
-        std::regex(R"(UNION\s+SELECT)", std::regex::icase),
-
-        // Path traversal patterns
-        std::regex(R"(\.\./)", std::regex::icase),
-        std::regex(R"(\.\.[\\\/])", std::regex::icase),
-        std::regex(R"(/etc/passwd)", std::regex::icase),
-        std::regex(R"(c:\\windows)", std::regex::icase)
-    };
-
-    for (const auto& pattern : malicious_patterns) {
-        if (std::regex_search(content, pattern)) {
+    for (const CompiledPattern* pattern : PatternRegistry::instance().security_patterns()) {
+        if (pattern->search(content)) {
             return true;
         }
     }
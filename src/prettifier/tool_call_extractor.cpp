@@ -14,70 +14,132 @@
 namespace aimux {
 namespace prettifier {
 
+namespace {
+    // Nesting levels searched for well-formed calls inside malformed JSON
+    constexpr int MAX_RECOVERY_DEPTH = 3;
+
+    const nlohmann::json* find_field(const nlohmann::json& object, const char* key) {
+        auto it = object.find(key);
+        return it != object.end() ? &*it : nullptr;
+    }
+
+    std::string string_field(const nlohmann::json& object, const char* key) {
+        const auto* value = find_field(object, key);
+        return value && value->is_string() ? value->get<std::string>() : std::string();
+    }
+
+    // Arguments may be a JSON-encoded string (OpenAI) or an object (Anthropic input)
+    std::string argument_text(const nlohmann::json* value) {
+        if (!value || value->is_null()) {
+            return "";
+        }
+        return value->is_string() ? value->get<std::string>() : value->dump();
+    }
+
+    std::string_view trim(std::string_view text) {
+        size_t begin = text.find_first_not_of(" \t\r\n");
+        if (begin == std::string_view::npos) {
+            return {};
+        }
+        size_t end = text.find_last_not_of(" \t\r\n");
+        return text.substr(begin, end - begin + 1);
+    }
+
+    // Value of name="..." within an opening tag
+    std::string xml_attribute(std::string_view opening, std::string_view attribute) {
+        size_t position = 0;
+        while ((position = opening.find(attribute, position)) != std::string_view::npos) {
+            size_t after = position + attribute.size();
+            bool starts_word = position > 0 && (opening[position - 1] == ' ' || opening[position - 1] == '\t' ||
+                                                opening[position - 1] == '\n');
+            if (starts_word && after + 1 < opening.size() && opening[after] == '=' &&
+                (opening[after + 1] == '"' || opening[after + 1] == '\'')) {
+                char quote = opening[after + 1];
+                size_t close = opening.find(quote, after + 2);
+                if (close != std::string_view::npos) {
+                    return std::string(opening.substr(after + 2, close - after - 2));
+                }
+            }
+            position = after;
+        }
+        return "";
+    }
+}
+
 // ProviderToolPatterns implementation
-std::vector<std::regex> ProviderToolPatterns::get_cerebras_patterns() {
-    return {
+const std::vector<const CompiledPattern*>& ProviderToolPatterns::get_cerebras_patterns() {
+    auto& registry = PatternRegistry::instance();
+    static const std::vector<const CompiledPattern*> patterns = {
         // Cerebras JSON tool calls format (simplified)
-        std::regex(R"(\{\s*"tool_calls"\s*:\s*\[.*?\]\s*\})", std::regex::ECMAScript),
+        &registry.get("tool_call.cerebras.tool_calls", R"(\{\s*"tool_calls"\s*:\s*\[.*?\]\s*\})"),
 
         // Simple tool call format (simplified)
-        std::regex(R"(\{\s*"name"\s*:\s*"[^"]*"\s*,\s*"arguments"\s*:\s*"[^"]*"\s*\})", std::regex::ECMAScript),
+        &registry.get("tool_call.cerebras.function", R"(\{\s*"name"\s*:\s*"[^"]*"\s*,\s*"arguments"\s*:\s*"[^"]*"\s*\})"),
 
         // Tool calls with id (simplified)
-        std::regex(R"(\{\s*"id"\s*:\s*"[^"]*"[^}]*\})", std::regex::ECMAScript)
+        &registry.get("tool_call.cerebras.id_object", R"(\{\s*"id"\s*:\s*"[^"]*"[^}]*\})")
     };
+    return patterns;
 }
 
-std::vector<std::regex> ProviderToolPatterns::get_openai_patterns() {
-    return {
+const std::vector<const CompiledPattern*>& ProviderToolPatterns::get_openai_patterns() {
+    auto& registry = PatternRegistry::instance();
+    static const std::vector<const CompiledPattern*> patterns = {
         // OpenAI function calling format (simplified)
-        std::regex(R"(\{\s*"function"\s*:\s*\{[^}]*\}\s*\})", std::regex::ECMAScript),
+        &registry.get("tool_call.openai.function", R"(\{\s*"function"\s*:\s*\{[^}]*\}\s*\})"),
 
         // Multiple tool calls (simplified)
-        std::regex(R"(\{\s*"tool_calls"\s*:\s*\[.*?\]\s*\})", std::regex::ECMAScript),
+        &registry.get("tool_call.openai.tool_calls", R"(\{\s*"tool_calls"\s*:\s*\[.*?\]\s*\})"),
 
         // Individual tool call with id (simplified)
-        std::regex(R"(\{\s*"id".*?"function".*?\})", std::regex::ECMAScript)
+        &registry.get("tool_call.openai.id_function", R"(\{\s*"id".*?"function".*?\})")
     };
+    return patterns;
 }
 
-std::vector<std::regex> ProviderToolPatterns::get_anthropic_patterns() {
-    return {
+const std::vector<const CompiledPattern*>& ProviderToolPatterns::get_anthropic_patterns() {
+    auto& registry = PatternRegistry::instance();
+    static const std::vector<const CompiledPattern*> patterns = {
         // Anthropic XML tool calls (simplified)
-        std::regex(R"(<tool_use>.*?</tool_use>)", std::regex::ECMAScript),
+        &registry.get("tool_call.anthropic.tool_use", R"(<tool_use>.*?</tool_use>)"),
 
         // Claude tool use format (simplified)
-        std::regex(R"(<invoke.*?>.*?</invoke>)", std::regex::ECMAScript),
+        &registry.get("tool_call.anthropic.invoke", R"(<invoke.*?>.*?</invoke>)"),
 
         // Function call with parameters (simplified)
-        std::regex(R"(<function_call>.*?</function_call>)", std::regex::ECMAScript)
+        &registry.get("tool_call.anthropic.function_call", R"(<function_call>.*?</function_call>)")
     };
+    return patterns;
 }
 
-std::vector<std::regex> ProviderToolPatterns::get_synthetic_patterns() {
-    return {
+const std::vector<const CompiledPattern*>& ProviderToolPatterns::get_synthetic_patterns() {
+    auto& registry = PatternRegistry::instance();
+    static const std::vector<const CompiledPattern*> patterns = {
         // Synthetic mixed format (simplified)
-        std::regex(R"(\{\s*"tool".*?\})", std::regex::ECMAScript),
+        &registry.get("tool_call.synthetic.tool_object", R"(\{\s*"tool".*?\})"),
 
         // Command style (simplified)
-        std::regex(R"(`[^`]+`\s*:\s*`[^`]*`)", std::regex::ECMAScript),
+        &registry.get("tool_call.synthetic.backtick_pair", R"(`[^`]+`\s*:\s*`[^`]*`)"),
 
         // Step format (simplified)
-        std::regex(R"(^\s*(?:Tool|Execute|Run):\s*[^=]+)", std::regex::ECMAScript)
+        &registry.get("tool_call.synthetic.command_line", R"(^\s*(?:Tool|Execute|Run):\s*[^=]+)")
     };
+    return patterns;
 }
 
-std::vector<std::regex> ProviderToolPatterns::get_common_patterns() {
-    return {
+const std::vector<const CompiledPattern*>& ProviderToolPatterns::get_common_patterns() {
+    auto& registry = PatternRegistry::instance();
+    static const std::vector<const CompiledPattern*> patterns = {
         // Generic JSON tool pattern (simplified)
-        std::regex(R"(\{\s*".*?"\s*:\s*".*?"\s*\})", std::regex::ECMAScript),
+        &registry.get("tool_call.common.json_pair", R"(\{\s*".*?"\s*:\s*".*?"\s*\})"),
 
         // Bracket notation (simplified)
-        std::regex(R"(\[[^\[\]]+\]\s*\([^)]*\))", std::regex::ECMAScript),
+        &registry.get("tool_call.common.markdown_link", R"(\[[^\[\]]+\]\s*\([^)]*\))"),
 
         // Simple name:args format
-        std::regex(R"(^\s*[a-zA-Z_][a-zA-Z0-9_]*\s*:\s*.+$)", std::regex::ECMAScript)
+        &registry.get("tool_call.common.key_value", R"(^\s*[a-zA-Z_][a-zA-Z0-9_]*\s*:\s*.+$)")
     };
+    return patterns;
 }
 
 // ToolCallExtractorPlugin implementation
@@ -205,6 +267,8 @@ bool ToolCallExtractorPlugin::begin_streaming(const ProcessingContext& context)
     reset_streaming_state();
     streaming_active_ = true;
     current_provider_ = context.provider_name;
+    streaming_state_ = std::make_unique<ExtractionState>(
+        formats_for_provider(current_provider_), config_.max_content_size);
     log_debug("streaming", "Started streaming for provider: " + context.provider_name);
     return true;
 }
@@ -219,15 +283,19 @@ ProcessingResult ToolCallExtractorPlugin::process_streaming_chunk(
     }
 
     try {
-        std::string processed_chunk = process_streaming_extraction(chunk, is_final);
-
         ProcessingResult result;
         result.success = true;
-        result.processed_content = processed_chunk;
+        result.processed_content = chunk;
         result.streaming_mode = true;
 
+        // Calls are reported with the chunk that completes them
+        result.extracted_tool_calls = process_streaming_extraction(chunk, is_final);
+        result.metadata["tool_calls_completed"] = result.extracted_tool_calls.size();
+
         if (is_final) {
-            result = end_streaming(context);
+            result.metadata["tool_calls_total"] = streaming_reported_;
+            result.streaming_mode = false;
+            end_streaming(context);
         }
 
         return result;
@@ -240,9 +308,15 @@ ProcessingResult ToolCallExtractorPlugin::process_streaming_chunk(
 ProcessingResult ToolCallExtractorPlugin::end_streaming(const ProcessingContext& context) {
     ProcessingResult result;
     result.success = true;
-    result.processed_content = streaming_buffer_;
     result.streaming_mode = false;
 
+    if (streaming_state_) {
+        finish_extraction(*streaming_state_);
+        result.extracted_tool_calls = streaming_state_->completed;
+    }
+    // Content was passed through chunk by chunk; report the complete call list
+    result.metadata["tool_calls_extracted"] = result.extracted_tool_calls.size();
+
     reset_streaming_state();
     log_debug("streaming", "Ended streaming");
 
@@ -276,6 +350,7 @@ nlohmann::json ToolCallExtractorPlugin::get_configuration() const {
 nlohmann::json ToolCallExtractorPlugin::get_metrics() const {
     nlohmann::json j = stats_.to_json();
     j["configuration"] = config_.to_json();
+    j["patterns"] = pattern_set_.to_json();
     return j;
 }
 
@@ -310,139 +385,228 @@ std::vector<ToolCall> ToolCallExtractorPlugin::extract_tool_calls(
     const std::string& content,
     const std::string& provider) const {
 
-    std::vector<ToolCall> all_tool_calls;
-
-    // Extract provider-specific tool calls
-    auto provider_calls = extract_provider_tool_calls(content, provider);
-    all_tool_calls.insert(all_tool_calls.end(), provider_calls.begin(), provider_calls.end());
-
-    // Apply common patterns as fallback
-    if (all_tool_calls.empty()) {
-        auto patterns = get_provider_patterns("common");
-        for (const auto& pattern : patterns) {
-            std::sregex_iterator iter(content.begin(), content.end(), pattern);
-            std::sregex_iterator end;
-
-            for (; iter != end && all_tool_calls.size() < config_.max_tool_calls; ++iter) {
-                std::smatch match = *iter;
-                if (match.size() >= 2) {
-                    ToolCall tool;
-                    tool.name = "extracted_tool";
-                    tool.id = generate_call_id();
-                    tool.parameters = nlohmann::json{{"raw_content", match[0].str()}};
-                    tool.status = "pending";
-
-                    if (validate_tool_call(tool)) {
-                        all_tool_calls.push_back(tool);
-                    }
-                }
-            }
+    ExtractionState state(formats_for_provider(provider), config_.max_content_size);
+    feed_extraction(state, content);
+    finish_extraction(state);
+    return std::move(state.completed);
+}
+
+uint32_t ToolCallExtractorPlugin::formats_for_provider(const std::string& provider) const {
+    uint32_t formats = ToolCallScanner::ALL;
+    if (provider == "cerebras" || provider == "openai") {
+        formats = ToolCallScanner::JSON;
+    }
+    if (!config_.enable_json_parsing) {
+        formats &= ~static_cast<uint32_t>(ToolCallScanner::JSON);
+    }
+    if (!config_.enable_xml_parsing) {
+        formats &= ~static_cast<uint32_t>(ToolCallScanner::XML);
+    }
+    return formats;
+}
+
+void ToolCallExtractorPlugin::feed_extraction(ExtractionState& state, std::string_view content) const {
+    state.segments.clear();
+    state.scanner.feed(content, state.segments);
+
+    for (const auto& segment : state.segments) {
+        if (state.completed.size() >= config_.max_tool_calls) {
+            break;
+        }
+        if (segment.kind == ToolCallScanner::Segment::Kind::JSON_OBJECT) {
+            handle_json_segment(state, segment.text);
+        } else {
+            add_tool_call(state, parse_tool_call_from_xml(segment.tag, segment.text));
         }
     }
+    state.segments.clear();
+}
 
-    // Limit number of tool calls
-    if (all_tool_calls.size() > config_.max_tool_calls) {
-        all_tool_calls.resize(config_.max_tool_calls);
+void ToolCallExtractorPlugin::finish_extraction(ExtractionState& state) const {
+    if (state.scanner.in_element()) {
+        stats_.xml_parse_failures++;
+        log_debug("finish_extraction", "Unterminated XML tool element at end of content");
     }
+    state.scanner.finish();
 
-    return all_tool_calls;
+    // Delta calls whose stream ended without a finish marker
+    flush_pending(state, "");
 }
 
-std::vector<ToolCall> ToolCallExtractorPlugin::extract_provider_tool_calls(
-    const std::string& content,
-    const std::string& provider) const {
+void ToolCallExtractorPlugin::handle_json_segment(ExtractionState& state, const std::string& text,
+                                                  int depth) const {
+    auto json = nlohmann::json::parse(text, nullptr, false);
+    if (!json.is_discarded()) {
+        resolve_json(state, json);
+        return;
+    }
 
-    std::vector<ToolCall> tool_calls;
+    stats_.json_parse_failures++;
+    if (!config_.enable_error_recovery || depth >= MAX_RECOVERY_DEPTH) {
+        return;
+    }
 
-    if (provider == "cerebras" || provider == "openai") {
-        tool_calls = extract_json_tool_calls(content);
-    } else if (provider == "anthropic") {
-        tool_calls = extract_xml_tool_calls(content);
-    } else if (provider == "synthetic") {
-        // Try JSON first, then XML, then text patterns
-        auto json_calls = extract_json_tool_calls(content);
-        tool_calls.insert(tool_calls.end(), json_calls.begin(), json_calls.end());
-
-        if (tool_calls.empty()) {
-            auto xml_calls = extract_xml_tool_calls(content);
-            tool_calls.insert(tool_calls.end(), xml_calls.begin(), xml_calls.end());
+    // Salvage well-formed objects nested inside the malformed one
+    ToolCallScanner inner(ToolCallScanner::JSON, config_.max_content_size);
+    std::vector<ToolCallScanner::Segment> segments;
+    inner.feed(std::string_view(text).substr(1), segments);
+    for (const auto& segment : segments) {
+        if (state.completed.size() >= config_.max_tool_calls) {
+            break;
         }
+        handle_json_segment(state, segment.text, depth + 1);
     }
-
-    return tool_calls;
 }
 
-std::vector<ToolCall> ToolCallExtractorPlugin::extract_json_tool_calls(const std::string& content) const {
-    std::vector<ToolCall> tool_calls;
+void ToolCallExtractorPlugin::resolve_json(ExtractionState& state, const nlohmann::json& json) const {
+    if (!json.is_object()) {
+        return;
+    }
 
-    try {
-        // Try to parse as complete JSON
-        auto json_obj = nlohmann::json::parse(content);
+    // Chat completion responses and their streamed deltas
+    if (const auto* choices = find_field(json, "choices"); choices && choices->is_array()) {
+        for (size_t i = 0; i < choices->size(); ++i) {
+            const auto& choice = (*choices)[i];
+            if (!choice.is_object()) {
+                continue;
+            }
+            const auto* index = find_field(choice, "index");
+            std::string prefix = "openai:" + (index ? index->dump() : std::to_string(i)) + ":";
 
-        // Handle different JSON structures
-        if (json_obj.contains("tool_calls") && json_obj["tool_calls"].is_array()) {
-            for (const auto& call : json_obj["tool_calls"]) {
-                if (auto tool = parse_tool_call_from_json(call)) {
-                    tool_calls.push_back(*tool);
+            if (const auto* message = find_field(choice, "message"); message && message->is_object()) {
+                resolve_json(state, *message);
+            }
+
+            const auto* delta = find_field(choice, "delta");
+            const auto* calls = delta && delta->is_object() ? find_field(*delta, "tool_calls") : nullptr;
+            if (calls && calls->is_array()) {
+                for (const auto& call : *calls) {
+                    if (!call.is_object()) {
+                        continue;
+                    }
+                    const auto* call_index = find_field(call, "index");
+                    auto& pending = state.pending[prefix + (call_index ? call_index->dump() : "0") + ":"];
+                    if (std::string id = string_field(call, "id"); !id.empty()) {
+                        pending.id = std::move(id);
+                    }
+                    if (const auto* function = find_field(call, "function"); function && function->is_object()) {
+                        if (std::string name = string_field(*function, "name"); !name.empty()) {
+                            pending.name = std::move(name);
+                        }
+                        pending.arguments += string_field(*function, "arguments");
+                    }
                 }
             }
+
+            const auto* finish_reason = find_field(choice, "finish_reason");
+            if (finish_reason && !finish_reason->is_null()) {
+                flush_pending(state, prefix);
+            }
         }
+        return;
+    }
 
-        // Handle function array
-        if (json_obj.contains("functions") && json_obj["functions"].is_array()) {
-            for (const auto& func : json_obj["functions"]) {
-                if (auto tool = parse_tool_call_from_json(func)) {
-                    tool_calls.push_back(*tool);
+    // Anthropic streaming events
+    std::string type = string_field(json, "type");
+    if (type == "content_block_start" || type == "content_block_delta" || type == "content_block_stop") {
+        const auto* index = find_field(json, "index");
+        std::string key = "anthropic:" + (index ? index->dump() : "0") + ":";
+
+        if (type == "content_block_start") {
+            const auto* block = find_field(json, "content_block");
+            if (block && block->is_object() && string_field(*block, "type") == "tool_use") {
+                auto& pending = state.pending[key];
+                pending.id = string_field(*block, "id");
+                pending.name = string_field(*block, "name");
+                // The start event normally carries an empty input placeholder
+                const auto* input = find_field(*block, "input");
+                if (input && !input->empty()) {
+                    pending.arguments = input->dump();
                 }
             }
+        } else if (type == "content_block_delta") {
+            auto it = state.pending.find(key);
+            const auto* delta = find_field(json, "delta");
+            if (it != state.pending.end() && delta && delta->is_object() &&
+                string_field(*delta, "type") == "input_json_delta") {
+                it->second.arguments += string_field(*delta, "partial_json");
+            }
+        } else {
+            flush_pending(state, key);
         }
-
-    } catch (const std::exception& e) {
-        // Try regex-based extraction as fallback
-        if (config_.enable_error_recovery) {
-            tool_calls = recover_from_json_error(content);
+        return;
+    }
+    if (type == "message_start") {
+        if (const auto* message = find_field(json, "message"); message) {
+            resolve_json(state, *message);
         }
-        stats_.json_parse_failures++;
-        log_debug("extract_json_tool_calls", "JSON parse failed: " + std::string(e.what()));
+        return;
+    }
+    if (type == "tool_use") {
+        add_tool_call(state, parse_tool_call_from_json(json));
+        return;
     }
 
-    return tool_calls;
-}
-
-std::vector<ToolCall> ToolCallExtractorPlugin::extract_xml_tool_calls(const std::string& content) const {
-    std::vector<ToolCall> tool_calls;
+    // Anthropic messages
+    if (const auto* content = find_field(json, "content"); content && content->is_array()) {
+        for (const auto& block : *content) {
+            if (block.is_object() && string_field(block, "type") == "tool_use") {
+                add_tool_call(state, parse_tool_call_from_json(block));
+            }
+        }
+    }
 
-    try {
-        // Simple XML parsing using regex for now
-        std::regex tool_regex(R"(<tool_use>.*?</tool_use>)");
-        std::sregex_iterator iter(content.begin(), content.end(), tool_regex);
-        std::sregex_iterator end;
-
-        for (; iter != end && tool_calls.size() < config_.max_tool_calls; ++iter) {
-            std::smatch match = *iter;
-            if (match.size() >= 1) {
-                ToolCall tool;
-                tool.name = "xml_tool_call";
-                tool.id = generate_call_id();
-                tool.parameters = nlohmann::json{{"raw_content", match[0].str()}};
-                tool.status = "pending";
-
-                if (validate_tool_call(tool)) {
-                    tool_calls.push_back(tool);
+    // Tool call lists
+    bool listed = false;
+    for (const char* key : {"tool_calls", "functions"}) {
+        const auto* calls = find_field(json, key);
+        if (calls && calls->is_array()) {
+            listed = true;
+            for (const auto& call : *calls) {
+                if (call.is_object()) {
+                    add_tool_call(state, parse_tool_call_from_json(call));
                 }
             }
         }
+    }
+    if (listed) {
+        return;
+    }
 
-    } catch (const std::exception& e) {
-        // Try recovery
-        if (config_.enable_error_recovery) {
-            tool_calls = recover_from_xml_error(content);
+    // A single bare call
+    const auto* function = find_field(json, "function");
+    const auto* tool = find_field(json, "tool");
+    bool bare_call = (function && function->is_object()) ||
+                     (find_field(json, "name") && (find_field(json, "arguments") || find_field(json, "input"))) ||
+                     (tool && tool->is_string());
+    if (bare_call) {
+        add_tool_call(state, parse_tool_call_from_json(json));
+    }
+}
+
+void ToolCallExtractorPlugin::flush_pending(ExtractionState& state, const std::string& prefix) const {
+    auto it = state.pending.lower_bound(prefix);
+    while (it != state.pending.end() && it->first.compare(0, prefix.size(), prefix) == 0) {
+        const auto& pending = it->second;
+        if (!pending.name.empty()) {
+            ToolCall tool;
+            tool.name = pending.name;
+            tool.id = pending.id.empty() ? generate_call_id() : pending.id;
+            tool.parameters = nlohmann::json{{"arguments", sanitize_tool_arguments(pending.arguments)}};
+            tool.status = "pending";
+            tool.timestamp = std::chrono::system_clock::now();
+            if (validate_tool_call(tool)) {
+                add_tool_call(state, std::move(tool));
+            }
         }
-        stats_.xml_parse_failures++;
-        log_debug("extract_xml_tool_calls", "XML parse failed: " + std::string(e.what()));
+        it = state.pending.erase(it);
     }
+}
 
-    return tool_calls;
+void ToolCallExtractorPlugin::add_tool_call(ExtractionState& state, std::optional<ToolCall> tool) const {
+    if (tool && state.completed.size() < config_.max_tool_calls) {
+        state.completed.push_back(std::move(*tool));
+    }
 }
 
 std::optional<ToolCall> ToolCallExtractorPlugin::parse_tool_call_from_json(const nlohmann::json& json_obj) const {
@@ -452,32 +616,33 @@ std::optional<ToolCall> ToolCallExtractorPlugin::parse_tool_call_from_json(const
         tool.timestamp = std::chrono::system_clock::now();
 
         // Handle different JSON structures
-        if (json_obj.contains("function")) {
+        const auto* function = find_field(json_obj, "function");
+        if (function && function->is_object()) {
             // OpenAI format
-            const auto& func = json_obj["function"];
-            std::string raw_args = func.value("arguments", "");
-            std::string sanitized_args = sanitize_tool_arguments(raw_args);
-            tool.name = func.value("name", "");
+            std::string sanitized_args = sanitize_tool_arguments(argument_text(find_field(*function, "arguments")));
+            tool.name = string_field(*function, "name");
             tool.parameters = nlohmann::json{{"arguments", sanitized_args}};
-            tool.id = json_obj.value("id", generate_call_id());
         } else if (json_obj.contains("name")) {
-            // Simple format
-            std::string raw_args = json_obj.value("arguments", json_obj.value("input", ""));
+            // Simple format; Anthropic tool_use blocks carry an "input" object
+            const auto* arguments = find_field(json_obj, "arguments");
+            std::string raw_args = argument_text(arguments ? arguments : find_field(json_obj, "input"));
             std::string sanitized_args = sanitize_tool_arguments(raw_args);
-            tool.name = json_obj["name"];
+            tool.name = string_field(json_obj, "name");
             tool.parameters = nlohmann::json{{"arguments", sanitized_args}};
-            tool.id = json_obj.value("id", generate_call_id());
         } else if (json_obj.contains("tool")) {
             // Tool format
-            std::string raw_args = json_obj.value("args", "");
-            std::string sanitized_args = sanitize_tool_arguments(raw_args);
-            tool.name = json_obj["tool"];
+            std::string sanitized_args = sanitize_tool_arguments(argument_text(find_field(json_obj, "args")));
+            tool.name = string_field(json_obj, "tool");
             tool.parameters = nlohmann::json{{"args", sanitized_args}};
-            tool.id = json_obj.value("id", generate_call_id());
         } else {
             return std::nullopt;
         }
 
+        tool.id = string_field(json_obj, "id");
+        if (tool.id.empty()) {
+            tool.id = generate_call_id();
+        }
+
         if (validate_tool_call(tool)) {
             return tool;
         }
@@ -489,14 +654,60 @@ std::optional<ToolCall> ToolCallExtractorPlugin::parse_tool_call_from_json(const
     return std::nullopt;
 }
 
-std::optional<ToolCall> ToolCallExtractorPlugin::parse_tool_call_from_xml(const std::string& xml_element) const {
-    // Simple XML parsing - for now, just create a basic tool call
+std::optional<ToolCall> ToolCallExtractorPlugin::parse_tool_call_from_xml(const std::string& tag,
+                                                                          const std::string& xml_element) const {
+    std::string_view element(xml_element);
+    size_t open_end = element.find('>');
+    std::string_view opening = element.substr(0, open_end);
+    size_t body_begin = open_end == std::string_view::npos ? element.size() : open_end + 1;
+    size_t body_end = element.rfind("</");
+    std::string_view body = body_end != std::string_view::npos && body_end >= body_begin
+        ? trim(element.substr(body_begin, body_end - body_begin))
+        : std::string_view();
+
     ToolCall tool;
+    tool.status = "pending";
+    tool.timestamp = std::chrono::system_clock::now();
+
+    if (tag == "invoke") {
+        // <invoke name="tool"><parameter name="key">value</parameter>...</invoke>
+        std::string name = xml_attribute(opening, "name");
+        if (!name.empty()) {
+            nlohmann::json arguments = nlohmann::json::object();
+            size_t position = 0;
+            while ((position = body.find("<parameter", position)) != std::string_view::npos) {
+                size_t tag_end = body.find('>', position);
+                size_t close = tag_end == std::string_view::npos
+                    ? std::string_view::npos : body.find("</parameter>", tag_end);
+                if (close == std::string_view::npos) {
+                    break;
+                }
+                std::string key = xml_attribute(body.substr(position, tag_end - position), "name");
+                if (!key.empty()) {
+                    arguments[key] = std::string(body.substr(tag_end + 1, close - tag_end - 1));
+                }
+                position = close + std::string_view("</parameter>").size();
+            }
+
+            tool.name = name;
+            tool.id = generate_call_id();
+            tool.parameters = nlohmann::json{{"arguments", sanitize_tool_arguments(arguments.dump())}};
+            return validate_tool_call(tool) ? std::optional<ToolCall>(std::move(tool)) : std::nullopt;
+        }
+    } else if (!body.empty() && body.front() == '{') {
+        // <tool_use>{"name": ..., "input": ...}</tool_use>
+        auto json = nlohmann::json::parse(body, nullptr, false);
+        if (json.is_object()) {
+            if (auto parsed = parse_tool_call_from_json(json)) {
+                return parsed;
+            }
+        }
+    }
+
+    // Unstructured body: keep the element verbatim
     tool.name = "xml_tool_call";
     tool.id = generate_call_id();
     tool.parameters = nlohmann::json{{"raw_content", xml_element}};
-    tool.status = "pending";
-    tool.timestamp = std::chrono::system_clock::now();
 
     if (validate_tool_call(tool)) {
         return tool;
@@ -528,34 +739,8 @@ bool ToolCallExtractorPlugin::validate_tool_call(const ToolCall& tool_call) cons
 }
 
 bool ToolCallExtractorPlugin::contains_malicious_patterns(const std::string& content) const {
-    std::vector<std::regex> malicious_patterns = {
-        // XSS patterns
-        std::regex(R"(<script[^>]*>)", std::regex::icase),
-        std::regex(R"(javascript\s*:)", std::regex::icase),
-        std::regex(R"(onerror\s*=)", std::regex::icase),
-        std::regex(R"(onload\s*=)", std::regex::icase),
-        std::regex(R"(</script>)", std::regex::icase),
-
-        // Code execution patterns
-        std::regex(R"(eval\s*\()", std::regex::icase),
-        std::regex(R"(system\s*\()", std::regex::icase),
-        std::regex(R"(exec\s*\()", std::regex::icase),
-
-        // SQL injection patterns
-        std::regex(R"('\s+OR\s+'1'\s*=\s*'1)", std::regex::icase),
-        std::regex(R"("\s+OR\s+"1"\s*=\s*"1)", std::regex::icase),
-        std::regex(R"(;\s*DROP\s+TABLE)", std::regex::icase),
-        std::regex(R"(UNION\s+SELECT)", std::regex::icase),
-
-        // Path traversal patterns
-        std::regex(R"(\.\./)", std::regex::icase),
-        std::regex(R"(\.\.[\\\/])", std::regex::icase),
-        std::regex(R"(/etc/passwd)", std::regex::icase),
-        std::regex(R"(c:\\windows)", std::regex::icase)
-    };
-
-    for (const auto& pattern : malicious_patterns) {
-        if (std::regex_search(content, pattern)) {
+    for (const CompiledPattern* pattern : malicious_patterns_) {
+        if (pattern->search(content)) {
             return true;
         }
     }
@@ -581,78 +766,31 @@ bool ToolCallExtractorPlugin::is_valid_tool_name(const std::string& tool_name) c
 }
 
 std::string ToolCallExtractorPlugin::sanitize_tool_arguments(const std::string& arguments) const {
-    std::string sanitized = arguments;
-
-    // XSS escaping - HTML entities
-    sanitized = std::regex_replace(sanitized, std::regex("<"), "&lt;");
-    sanitized = std::regex_replace(sanitized, std::regex(">"), "&gt;");
-    sanitized = std::regex_replace(sanitized, std::regex(R"(")", std::regex::icase), "&quot;");
-    sanitized = std::regex_replace(sanitized, std::regex("'"), "&#39;");
-
     // SQL injection - escape single and double quotes
-    // This is already handled by HTML entity escaping above, but add explicit SQL safeguards
-    if (std::regex_search(arguments, std::regex(R"('\s+OR\s+')", std::regex::icase))) {
+    // This is already handled by HTML entity escaping below, but add explicit SQL safeguards
+    if (sql_or_->search(arguments)) {
         return ""; // Block suspicious SQL patterns entirely
     }
 
     // Path traversal - block directory traversal attempts
-    if (std::regex_search(arguments, std::regex(R"(\.\./)", std::regex::icase))) {
+    if (path_traversal_->search(arguments)) {
         return ""; // Block path traversal
     }
 
-    return sanitized;
-}
-
-std::vector<ToolCall> ToolCallExtractorPlugin::recover_from_json_error(const std::string& content) const {
-    std::vector<ToolCall> tool_calls;
-
-    // Simple pattern matching for common tool call formats
-    std::regex simple_regex(R"(\{\s*"name"\s*:\s*"[^"]*"\s*,\s*"arguments"\s*:\s*"[^"]*"\s*\})");
-    std::sregex_iterator iter(content.begin(), content.end(), simple_regex);
-    std::sregex_iterator end;
-
-    for (; iter != end && tool_calls.size() < config_.max_tool_calls; ++iter) {
-        std::smatch match = *iter;
-        if (match.size() >= 1) {
-            ToolCall tool;
-            tool.name = "recovered_tool";
-            tool.id = generate_call_id();
-            tool.parameters = nlohmann::json{{"raw_content", match[0].str()}};
-            tool.status = "pending";
-
-            if (validate_tool_call(tool)) {
-                tool_calls.push_back(tool);
-            }
+    // XSS escaping - HTML entities, in a single pass over the input
+    std::string sanitized;
+    sanitized.reserve(arguments.size());
+    for (char c : arguments) {
+        switch (c) {
+            case '<': sanitized += "&lt;"; break;
+            case '>': sanitized += "&gt;"; break;
+            case '"': sanitized += "&quot;"; break;
+            case '\'': sanitized += "&#39;"; break;
+            default: sanitized.push_back(c); break;
         }
     }
 
-    return tool_calls;
-}
-
-std::vector<ToolCall> ToolCallExtractorPlugin::recover_from_xml_error(const std::string& content) const {
-    std::vector<ToolCall> tool_calls;
-
-    // Simple XML-like pattern matching
-    std::regex xml_regex(R"(<invoke.*?>.*?</invoke>)");
-    std::sregex_iterator iter(content.begin(), content.end(), xml_regex);
-    std::sregex_iterator end;
-
-    for (; iter != end && tool_calls.size() < config_.max_tool_calls; ++iter) {
-        std::smatch match = *iter;
-        if (match.size() >= 1) {
-            ToolCall tool;
-            tool.name = "recovered_xml_tool";
-            tool.id = generate_call_id();
-            tool.parameters = nlohmann::json{{"raw_content", match[0].str()}};
-            tool.status = "pending";
-
-            if (validate_tool_call(tool)) {
-                tool_calls.push_back(tool);
-            }
-        }
-    }
-
-    return tool_calls;
+    return sanitized;
 }
 
 void ToolCallExtractorPlugin::initialize_patterns() {
@@ -665,10 +803,18 @@ void ToolCallExtractorPlugin::initialize_patterns() {
     provider_patterns_["common"] = ProviderToolPatterns::get_common_patterns();
     common_patterns_ = ProviderToolPatterns::get_common_patterns();
 
+    sql_or_ = &pattern_set_.add("tool_call.sql_or", R"('\s+OR\s+')", CompiledPattern::ICASE);
+    path_traversal_ = &pattern_set_.add("security.path_traversal", R"(\.\./)", CompiledPattern::ICASE);
+
+    malicious_patterns_ = PatternRegistry::instance().security_patterns();
+    for (const CompiledPattern* pattern : malicious_patterns_) {
+        pattern_set_.track(*pattern);
+    }
+
     log_debug("initialize_patterns", "Pattern initialization completed");
 }
 
-std::vector<std::regex> ToolCallExtractorPlugin::get_provider_patterns(const std::string& provider) const {
+std::vector<const CompiledPattern*> ToolCallExtractorPlugin::get_provider_patterns(const std::string& provider) const {
     std::lock_guard<std::mutex> lock(patterns_mutex_);
 
     auto it = provider_patterns_.find(provider);
@@ -704,22 +850,24 @@ bool ToolCallExtractorPlugin::check_content_limits(const std::string& content) c
 }
 
 void ToolCallExtractorPlugin::reset_streaming_state() {
-    streaming_buffer_.clear();
+    streaming_state_.reset();
+    streaming_reported_ = 0;
     streaming_active_ = false;
     current_provider_.clear();
 }
 
-std::string ToolCallExtractorPlugin::process_streaming_extraction(const std::string& chunk, bool is_final) {
-    streaming_buffer_ += chunk;
-
+std::vector<ToolCall> ToolCallExtractorPlugin::process_streaming_extraction(const std::string& chunk, bool is_final) {
+    ExtractionState& state = *streaming_state_;
+    feed_extraction(state, chunk);
     if (is_final) {
-        // Extract tool calls from complete buffer
-        std::vector<ToolCall> tool_calls = extract_tool_calls(streaming_buffer_, current_provider_);
-        return serialize_tool_calls_to_toon(tool_calls);
-    } else {
-        // For partial chunks, just return as-is
-        return chunk;
+        finish_extraction(state);
     }
+
+    std::vector<ToolCall> completed(state.completed.begin() + static_cast<std::ptrdiff_t>(streaming_reported_),
+                                    state.completed.end());
+    streaming_reported_ = state.completed.size();
+    stats_.tools_extracted += completed.size();
+    return completed;
 }
 
 std::string ToolCallExtractorPlugin::generate_call_id() const {
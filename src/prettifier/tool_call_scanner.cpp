@@ -0,0 +1,281 @@
+#include "aimux/prettifier/tool_call_scanner.hpp"
+#include <array>
+#include <cstring>
+
+namespace aimux {
+namespace prettifier {
+
+namespace {
+    // Longest element name worth reading before giving up on a tag
+    constexpr size_t MAX_TAG_NAME = 16;
+
+    constexpr std::array<std::string_view, 3> TOOL_ELEMENTS = {"tool_use", "invoke", "function_call"};
+
+    bool is_tag_char(char c) {
+        return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || c == '_';
+    }
+
+    bool is_space(char c) {
+        return c == ' ' || c == '\t' || c == '\n' || c == '\r';
+    }
+
+    bool is_tool_element(std::string_view name) {
+        for (std::string_view element : TOOL_ELEMENTS) {
+            if (name == element) {
+                return true;
+            }
+        }
+        return false;
+    }
+}
+
+ToolCallScanner::ToolCallScanner(uint32_t formats, size_t max_segment_size)
+    : formats_(formats), max_segment_size_(max_segment_size) {}
+
+void ToolCallScanner::reset() {
+    state_ = State::TEXT;
+    buffer_.clear();
+    segment_offset_ = 0;
+    position_ = 0;
+    depth_ = 0;
+    tag_.clear();
+    closing_tag_.clear();
+    closing_matched_ = 0;
+}
+
+bool ToolCallScanner::finish() {
+    bool open = state_ != State::TEXT && state_ != State::TAG_NAME;
+    abandon_segment();
+    return open;
+}
+
+void ToolCallScanner::begin_segment(uint64_t offset, char first) {
+    buffer_.clear();
+    buffer_.push_back(first);
+    segment_offset_ = offset;
+    depth_ = 1;
+    tag_.clear();
+    closing_matched_ = 0;
+}
+
+void ToolCallScanner::abandon_segment() {
+    state_ = State::TEXT;
+    buffer_.clear();
+    depth_ = 0;
+    tag_.clear();
+    closing_matched_ = 0;
+}
+
+void ToolCallScanner::feed(std::string_view text, std::vector<Segment>& out) {
+    const bool want_json = (formats_ & JSON) != 0;
+    const bool want_xml = (formats_ & XML) != 0;
+    const char* data = text.data();
+    const size_t n = text.size();
+    size_t i = 0;
+
+    // Append data[i, end) to the open segment, dropping it if it grows too large
+    auto keep = [&](size_t end) {
+        if (over_limit(end - i)) {
+            ++oversized_;
+            abandon_segment();
+            return false;
+        }
+        buffer_.append(data + i, end - i);
+        return true;
+    };
+
+    auto emit = [&](Segment::Kind kind) {
+        Segment segment;
+        segment.kind = kind;
+        segment.offset = segment_offset_;
+        segment.text = std::move(buffer_);
+        if (kind == Segment::Kind::XML_ELEMENT) {
+            segment.tag = tag_;
+        }
+        out.push_back(std::move(segment));
+        abandon_segment();
+    };
+
+    while (i < n) {
+        switch (state_) {
+            case State::TEXT: {
+                size_t j = i;
+                if (want_json && !want_xml) {
+                    const void* hit = std::memchr(data + i, '{', n - i);
+                    j = hit ? static_cast<size_t>(static_cast<const char*>(hit) - data) : n;
+                } else if (want_xml && !want_json) {
+                    const void* hit = std::memchr(data + i, '<', n - i);
+                    j = hit ? static_cast<size_t>(static_cast<const char*>(hit) - data) : n;
+                } else if (want_json) {
+                    while (j < n && data[j] != '{' && data[j] != '<') {
+                        ++j;
+                    }
+                } else {
+                    j = n;
+                }
+                if (j == n) {
+                    i = n;
+                    break;
+                }
+                begin_segment(position_ + j, data[j]);
+                state_ = data[j] == '{' ? State::JSON_START : State::TAG_NAME;
+                i = j + 1;
+                break;
+            }
+
+            case State::JSON_START: {
+                size_t j = i;
+                while (j < n && is_space(data[j])) {
+                    ++j;
+                }
+                if (j == n) {
+                    keep(n);
+                    i = n;
+                    break;
+                }
+                if (data[j] != '"') {
+                    // Prose or code such as "{ return x; }" or an empty object;
+                    // rescan this byte as text
+                    abandon_segment();
+                    i = j;
+                    break;
+                }
+                if (keep(j + 1)) {
+                    state_ = State::JSON_STRING;
+                }
+                i = j + 1;
+                break;
+            }
+
+            case State::JSON_BODY: {
+                size_t j = i;
+                bool closed = false;
+                bool string_start = false;
+                for (; j < n; ++j) {
+                    char c = data[j];
+                    if (c == '"') {
+                        string_start = true;
+                        break;
+                    }
+                    if (c == '{' || c == '[') {
+                        ++depth_;
+                    } else if ((c == '}' || c == ']') && --depth_ == 0) {
+                        closed = true;
+                        break;
+                    }
+                }
+                if (j == n) {
+                    keep(n);
+                    i = n;
+                    break;
+                }
+                if (keep(j + 1)) {
+                    if (closed) {
+                        emit(Segment::Kind::JSON_OBJECT);
+                    } else if (string_start) {
+                        state_ = State::JSON_STRING;
+                    }
+                }
+                i = j + 1;
+                break;
+            }
+
+            case State::JSON_STRING: {
+                size_t j = i;
+                while (j < n && data[j] != '"' && data[j] != '\\') {
+                    ++j;
+                }
+                if (j == n) {
+                    keep(n);
+                    i = n;
+                    break;
+                }
+                if (keep(j + 1)) {
+                    state_ = data[j] == '\\' ? State::JSON_ESCAPE : State::JSON_BODY;
+                }
+                i = j + 1;
+                break;
+            }
+
+            case State::JSON_ESCAPE: {
+                if (keep(i + 1)) {
+                    state_ = State::JSON_STRING;
+                }
+                ++i;
+                break;
+            }
+
+            case State::TAG_NAME: {
+                size_t j = i;
+                while (j < n && is_tag_char(data[j]) && tag_.size() + (j - i) <= MAX_TAG_NAME) {
+                    ++j;
+                }
+                tag_.append(data + i, j - i);
+                if (tag_.size() > MAX_TAG_NAME) {
+                    abandon_segment();
+                    i = j;
+                    break;
+                }
+                if (j == n) {
+                    keep(n);
+                    i = n;
+                    break;
+                }
+                char c = data[j];
+                if ((c == '>' || is_space(c)) && is_tool_element(tag_)) {
+                    if (keep(j + 1)) {
+                        closing_tag_ = "</" + tag_ + ">";
+                        closing_matched_ = 0;
+                        state_ = State::XML_BODY;
+                    }
+                    i = j + 1;
+                } else {
+                    // Not one of ours (e.g. <function_calls> wrapper); rescan this byte
+                    abandon_segment();
+                    i = j;
+                }
+                break;
+            }
+
+            case State::XML_BODY: {
+                size_t j = i;
+                bool closed = false;
+                while (j < n) {
+                    if (closing_matched_ == 0) {
+                        const void* hit = std::memchr(data + j, '<', n - j);
+                        if (!hit) {
+                            j = n;
+                            break;
+                        }
+                        j = static_cast<size_t>(static_cast<const char*>(hit) - data);
+                    }
+                    char c = data[j];
+                    if (c == closing_tag_[closing_matched_]) {
+                        if (++closing_matched_ == closing_tag_.size()) {
+                            closed = true;
+                            break;
+                        }
+                    } else {
+                        closing_matched_ = c == '<' ? 1 : 0;
+                    }
+                    ++j;
+                }
+                if (!closed) {
+                    keep(n);
+                    i = n;
+                    break;
+                }
+                if (keep(j + 1)) {
+                    emit(Segment::Kind::XML_ELEMENT);
+                }
+                i = j + 1;
+                break;
+            }
+        }
+    }
+
+    position_ += n;
+}
+
+} // namespace prettifier
+} // namespace aimux
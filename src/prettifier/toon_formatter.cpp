@@ -1,8 +1,8 @@
 #include "aimux/prettifier/toon_formatter.hpp"
+#include "aimux/prettifier/pattern_registry.hpp"
 #include <sstream>
 #include <iomanip>
 #include <algorithm>
-#include <regex>
 #include <chrono>
 #include <ctime>
 #include <set>
@@ -171,20 +171,23 @@ std::optional<std::string> ToonFormatter::extract_section(
 bool ToonFormatter::validate_toon(const std::string& toon_content, std::string& error_message) {
     try {
         // Check for basic structure
-        static const std::regex section_regex(R"(^# ([A-Z]+)\s*$)", std::regex::multiline);
+        static const CompiledPattern& section_pattern = PatternRegistry::instance().get(
+            "toon.section_header", R"(^# ([A-Z]+)\s*$)", CompiledPattern::MULTILINE);
 
-        std::sregex_iterator iter(toon_content.begin(), toon_content.end(), section_regex);
-        std::sregex_iterator end;
+        std::vector<std::string> section_names;
+        section_pattern.for_each_match(toon_content, [&](const PatternMatch& match) {
+            section_names.push_back(match.str(1));
+            return true;
+        });
 
-        if (iter == end) {
+        if (section_names.empty()) {
             error_message = "No valid TOON sections found";
             return false;
         }
 
         // Validate section names
         std::set<std::string> found_sections;
-        for (auto it = iter; it != end; ++it) {
-            std::string section_name = (*it)[1].str();
+        for (const auto& section_name : section_names) {
             if (!is_valid_section_name(section_name)) {
                 error_message = "Invalid section name: " + section_name;
                 return false;
@@ -253,8 +256,9 @@ std::string ToonFormatter::escape_toon_content(const std::string& input) {
 
     // Escape section headers that could interfere
     // Match headers at beginning of line or after newline
-    static const std::regex header_regex(R"((^|\n)# )");
-    escaped = std::regex_replace(escaped, header_regex, "$1\\# ");
+    static const CompiledPattern& header_pattern =
+        PatternRegistry::instance().get("toon.header", R"((^|\n)# )");
+    escaped = header_pattern.replace_all(escaped, "$1\\# ");
 
     return escaped;
 }
@@ -263,8 +267,9 @@ std::string ToonFormatter::unescape_toon_content(const std::string& input) {
     std::string unescaped = input;
 
     // Unescape escaped headers
-    static const std::regex escaped_header_regex(R"((^|\n)\\# )");
-    unescaped = std::regex_replace(unescaped, escaped_header_regex, "$1# ");
+    static const CompiledPattern& escaped_header_pattern =
+        PatternRegistry::instance().get("toon.escaped_header", R"((^|\n)\\# )");
+    unescaped = escaped_header_pattern.replace_all(unescaped, "$1# ");
 
     return unescaped;
 }
@@ -342,30 +347,25 @@ std::vector<std::pair<std::string, std::string>> ToonFormatter::parse_sections(
 
     std::vector<std::pair<std::string, std::string>> sections;
 
-    static const std::regex section_regex(R"(# ([A-Z]+)\s*$)", std::regex::multiline);
-
-    std::sregex_token_iterator iter(toon_content.begin(), toon_content.end(),
-                                   section_regex, {-1, 1});
-    std::sregex_token_iterator end;
+    static const CompiledPattern& section_pattern = PatternRegistry::instance().get(
+        "toon.section_split", R"(# ([A-Z]+)\s*$)", CompiledPattern::MULTILINE);
 
     std::string current_section;
     std::string current_content;
+    size_t consumed = 0;
 
-    while (iter != end) {
-        // First token is the content before the match
-        if (iter != end) {
-            current_content += *iter++;
-        }
-
-        // Second token is the captured group (section name)
-        if (iter != end) {
-            if (!current_section.empty()) {
-                sections.emplace_back(current_section, current_content);
-            }
-            current_section = *iter++;
-            current_content = "";
+    // Text between one header and the next is the earlier header's content
+    section_pattern.for_each_match(toon_content, [&](const PatternMatch& match) {
+        current_content.append(toon_content, consumed, match.position - consumed);
+        if (!current_section.empty()) {
+            sections.emplace_back(current_section, current_content);
         }
-    }
+        current_section = match.str(1);
+        current_content.clear();
+        consumed = match.position + match.length();
+        return true;
+    });
+    current_content.append(toon_content, consumed, std::string::npos);
 
     // Add the last section
     if (!current_section.empty() && !current_content.empty()) {
@@ -403,10 +403,11 @@ nlohmann::json ToonFormatter::parse_content_section(const std::string& content)
     nlohmann::json parsed = nlohmann::json::object();
 
     try {
-        static const std::regex type_regex(R"(^\[TYPE:\s*([^\]]+)\])");
-        static const std::regex format_regex(R"(^\[FORMAT:\s*([^\]]+)\])");
-        static const std::regex content_regex(R"(^\[CONTENT:\s*(.*)\])");
-        static const std::regex content_size_regex(R"(^\[CONTENT_SIZE:\s*([^\]]+)\])");
+        auto& registry = PatternRegistry::instance();
+        static const CompiledPattern& type_pattern = registry.get("toon.content.type", R"(^\[TYPE:\s*([^\]]+)\])");
+        static const CompiledPattern& format_pattern = registry.get("toon.content.format", R"(^\[FORMAT:\s*([^\]]+)\])");
+        static const CompiledPattern& content_pattern = registry.get("toon.content.content", R"(^\[CONTENT:\s*(.*)\])");
+        static const CompiledPattern& content_size_pattern = registry.get("toon.content.size", R"(^\[CONTENT_SIZE:\s*([^\]]+)\])");
 
         bool in_content_block = false;
         std::string accumulated_content;
@@ -419,16 +420,16 @@ nlohmann::json ToonFormatter::parse_content_section(const std::string& content)
 
             if (line.empty()) continue;
 
-            std::smatch match;
-            if (std::regex_match(line, match, type_regex)) {
-                parsed["type"] = match[1].str();
-            } else if (std::regex_match(line, match, format_regex)) {
-                parsed["format"] = match[1].str();
-            } else if (std::regex_match(line, match, content_size_regex)) {
+            PatternMatch match;
+            if (type_pattern.full_match(line, match)) {
+                parsed["type"] = match.str(1);
+            } else if (format_pattern.full_match(line, match)) {
+                parsed["format"] = match.str(1);
+            } else if (content_size_pattern.full_match(line, match)) {
                 in_content_block = true;
-                parsed["content_size"] = match[1].str();
-            } else if (std::regex_match(line, match, content_regex)) {
-                parsed["content"] = match[1].str();
+                parsed["content_size"] = match.str(1);
+            } else if (content_pattern.full_match(line, match)) {
+                parsed["content"] = match.str(1);
             } else if (in_content_block) {
                 if (!accumulated_content.empty()) accumulated_content += "\n";
                 accumulated_content += line;
@@ -447,10 +448,11 @@ nlohmann::json ToonFormatter::parse_content_section(const std::string& content)
 nlohmann::json ToonFormatter::parse_tools_section(const std::string& content) {
     nlohmann::json tools = nlohmann::json::array();
 
-    static const std::regex call_regex(R"(^\[CALL:\s*([^\]]+)\])");
-    static const std::regex params_regex(R"(^\[PARAM:\s*([^\]]+)\])");
-    static const std::regex status_regex(R"(^\[STATUS:\s*([^\]]+)\])");
-    static const std::regex result_regex(R"(^\[RESULT:\s*([^\]]+)\])");
+    auto& registry = PatternRegistry::instance();
+    static const CompiledPattern& call_pattern = registry.get("toon.tools.call", R"(^\[CALL:\s*([^\]]+)\])");
+    static const CompiledPattern& params_pattern = registry.get("toon.tools.param", R"(^\[PARAM:\s*([^\]]+)\])");
+    static const CompiledPattern& status_pattern = registry.get("toon.tools.status", R"(^\[STATUS:\s*([^\]]+)\])");
+    static const CompiledPattern& result_pattern = registry.get("toon.tools.result", R"(^\[RESULT:\s*([^\]]+)\])");
 
     std::istringstream stream(content);
     std::string line;
@@ -461,26 +463,26 @@ nlohmann::json ToonFormatter::parse_tools_section(const std::string& content) {
         line.erase(line.find_last_not_of(" \t\r\n") + 1);
         if (line.empty()) continue;
 
-        std::smatch match;
-        if (std::regex_match(line, match, call_regex)) {
+        PatternMatch match;
+        if (call_pattern.full_match(line, match)) {
             if (!current_tool.empty()) {
                 tools.push_back(current_tool);
                 current_tool = nlohmann::json::object();
             }
-            current_tool["name"] = match[1].str();
-        } else if (std::regex_match(line, match, params_regex)) {
+            current_tool["name"] = match.str(1);
+        } else if (params_pattern.full_match(line, match)) {
             try {
-                current_tool["parameters"] = nlohmann::json::parse(match[1].str());
+                current_tool["parameters"] = nlohmann::json::parse(match.str(1));
             } catch (const std::exception&) {
-                current_tool["parameters_raw"] = match[1].str();
+                current_tool["parameters_raw"] = match.str(1);
             }
-        } else if (std::regex_match(line, match, status_regex)) {
-            current_tool["status"] = match[1].str();
-        } else if (std::regex_match(line, match, result_regex)) {
+        } else if (status_pattern.full_match(line, match)) {
+            current_tool["status"] = match.str(1);
+        } else if (result_pattern.full_match(line, match)) {
             try {
-                current_tool["result"] = nlohmann::json::parse(match[1].str());
+                current_tool["result"] = nlohmann::json::parse(match.str(1));
             } catch (const std::exception&) {
-                current_tool["result_raw"] = match[1].str();
+                current_tool["result_raw"] = match.str(1);
             }
         }
     }
@@ -494,7 +496,8 @@ nlohmann::json ToonFormatter::parse_tools_section(const std::string& content) {
 }
 
 std::string ToonFormatter::parse_thinking_section(const std::string& content) {
-    static const std::regex reasoning_regex(R"(^\[REASONING:\s*(.*)\])");
+    auto& registry = PatternRegistry::instance();
+    static const CompiledPattern& reasoning_pattern = registry.get("toon.thinking.reasoning", R"(^\[REASONING:\s*(.*)\])");
 
     std::istringstream stream(content);
     std::string line;
@@ -502,9 +505,9 @@ std::string ToonFormatter::parse_thinking_section(const std::string& content) {
     while (std::getline(stream, line)) {
         line.erase(line.find_last_not_of(" \t\r\n") + 1);
 
-        std::smatch match;
-        if (std::regex_match(line, match, reasoning_regex)) {
-            return unescape_toon_content(match[1].str());
+        PatternMatch match;
+        if (reasoning_pattern.full_match(line, match)) {
+            return unescape_toon_content(match.str(1));
         }
     }
 
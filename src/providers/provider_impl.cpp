@@ -1,6 +1,8 @@
 #include "aimux/providers/provider_impl.hpp"
 #include "aimux/providers/api_specs.hpp"
 #include "aimux/network/http_client.hpp"
+#include "aimux/network/curl_multi_engine.hpp"
+#include "aimux/core/cancellation.hpp"
 #include <iostream>
 #include <fstream>
 #include <sstream>
@@ -8,6 +10,8 @@
 #include <algorithm>
 #include <thread>
 #include <iomanip>
+#include <future>
+#include <cctype>
 
 #include <openssl/evp.h>
 #include <openssl/sha.h>
@@ -109,8 +113,9 @@ BaseProvider::BaseProvider(const std::string& name, const nlohmann::json& config
     api_key_hash_ = security::hash_api_key(raw_api_key);
     
     endpoint_ = config.value("endpoint", "");
+    health_probe_path_ = config.value("health_probe_path", std::string(api_specs::paths::MODELS));
     max_requests_per_minute_ = config.value("max_requests_per_minute", 60);
-    rate_limit_reset_ = std::chrono::steady_clock::now() + std::chrono::minutes(1);
+    init_rate_limiter();
 
     // Health tracking configuration
     consecutive_failures_ = 0;
@@ -120,33 +125,29 @@ BaseProvider::BaseProvider(const std::string& name, const nlohmann::json& config
 }
 
 bool BaseProvider::check_rate_limit() {
-    auto now = std::chrono::steady_clock::now();
-    
-    // Reset if minute has passed
-    if (now >= rate_limit_reset_) {
-        requests_made_ = 0;
-        rate_limit_reset_ = now + std::chrono::minutes(1);
-    }
-    
-    // Enhanced rate limiting with burst protection
-    bool allowed = requests_made_ < max_requests_per_minute_;
-    if (!allowed) {
-        // Log rate limit exceeded event
-        std::cerr << "Rate limit exceeded for provider " << provider_name_ 
-                  << ": " << requests_made_ << "/" << max_requests_per_minute_ << std::endl;
-    }
-    
-    return allowed;
+    return rate_limiter_->try_acquire();
+}
+
+void BaseProvider::init_rate_limiter() {
+    // Keyed by the key hash so providers sharing an API key share its quota
+    rate_limiter_ = core::RateLimiter::shared(provider_name_ + "/" + api_key_hash_,
+                                              max_requests_per_minute_,
+                                              config_.value("rate_limit_burst", 0));
 }
 
-void BaseProvider::update_rate_limit() {
-    requests_made_++;
+void BaseProvider::add_rate_limit_status(nlohmann::json& status) const {
+    core::RateLimiter::State state = rate_limiter_->state();
+    status["max_requests_per_minute"] = max_requests_per_minute_;
+    status["burst"] = state.burst;
+    status["requests_remaining"] = state.remaining;
+    status["requests_made"] = state.burst - state.remaining;
+    status["reset_in_seconds"] = std::chrono::ceil<std::chrono::seconds>(state.reset_in).count();
 }
 
 void BaseProvider::check_recovery() {
     if (!is_healthy_ && consecutive_failures_ > 0) {
         auto now = std::chrono::steady_clock::now();
-        auto time_since_failure = std::chrono::duration_cast<std::chrono::seconds>(now - last_failure_time_);
+        auto time_since_failure = std::chrono::duration_cast<std::chrono::seconds>(now - last_failure_time_.load());
 
         if (time_since_failure >= recovery_delay_) {
             // Attempt recovery - reset health status
@@ -156,11 +157,267 @@ void BaseProvider::check_recovery() {
     }
 }
 
+void BaseProvider::init_http_client() {
+    request_timeout_ = std::chrono::milliseconds(
+        config_.value("timeout_ms", static_cast<int>(api_specs::timeouts::REQUEST_TIMEOUT.count())));
+    int connect_timeout_ms =
+        config_.value("connect_timeout_ms", static_cast<int>(api_specs::timeouts::CONNECTION_TIMEOUT.count()));
+    int max_connections = config_.value("max_connections", config_.value("max_concurrent_requests", 10));
+
+    http_client_ = network::HttpClientFactory::get_shared_client(provider_name_ + "@" + endpoint_,
+                                                                 max_connections, connect_timeout_ms);
+}
+
+namespace {
+    // One send_with_retries() call; owned jointly by the caller and pending callbacks
+    struct RetryState {
+        std::shared_ptr<network::HttpClient> client;
+        network::HttpRequest request;
+        RetryPolicy policy;
+        core::CancellationToken token;
+        std::function<void(network::HttpResponse)> on_complete;
+        int attempt = 0;
+    };
+
+    bool is_retryable(int status_code) {
+        return status_code == 429 || status_code >= 500 || status_code == 0;
+    }
+
+    std::chrono::milliseconds retry_after(const network::HttpResponse& response) {
+        for (const auto& [name, value] : response.headers) {
+            if (name.size() == 11 &&
+                std::equal(name.begin(), name.end(), "retry-after",
+                           [](char a, char b) { return std::tolower(static_cast<unsigned char>(a)) == b; })) {
+                try {
+                    return std::chrono::seconds(std::stoi(value));
+                } catch (...) {
+                    // HTTP-date form; fall back to the policy default
+                }
+            }
+        }
+        return std::chrono::milliseconds(0);
+    }
+
+    std::chrono::milliseconds retry_delay(const network::HttpResponse& response, int attempt,
+                                          const RetryPolicy& policy) {
+        if (response.status_code == 429) {
+            auto delay = retry_after(response);
+            return std::min(delay.count() > 0 ? delay : policy.rate_limit_delay, policy.max_delay);
+        }
+
+        auto delay = std::min(policy.base_delay * (1 << std::min(attempt, 16)), policy.max_delay);
+        thread_local std::mt19937 jitter_rng(std::random_device{}());
+        std::uniform_int_distribution<long long> jitter(delay.count() / 2, delay.count());
+        return std::chrono::milliseconds(jitter(jitter_rng));
+    }
+
+    void start_attempt(const std::shared_ptr<RetryState>& state) {
+        // Later attempts start on the event loop thread; carry the caller's token there
+        core::CancellationScope scope(state->token);
+        state->client->send_request_async(state->request, [state](const network::HttpResponse& response) {
+            if (!is_retryable(response.status_code) || state->token.cancelled() ||
+                state->attempt + 1 >= state->policy.max_attempts) {
+                state->on_complete(response);
+                return;
+            }
+
+            auto delay = retry_delay(response, state->attempt++, state->policy);
+            bool scheduled = network::CurlMultiEngine::instance().schedule(delay,
+                [state, response](bool fired) {
+                    if (!fired || state->token.cancelled()) {
+                        state->on_complete(response);
+                        return;
+                    }
+                    start_attempt(state);
+                });
+            if (!scheduled) {
+                state->on_complete(response);
+            }
+        });
+    }
+}
+
+void BaseProvider::send_with_retries_async(const network::HttpRequest& http_request,
+                                           std::function<void(network::HttpResponse)> on_complete,
+                                           const RetryPolicy& policy) {
+    auto state = std::make_shared<RetryState>();
+    state->client = http_client_;
+    state->request = http_request;
+    state->policy = policy;
+    state->token = core::current_cancellation();
+    state->on_complete = std::move(on_complete);
+
+    start_attempt(state);
+}
+
+network::HttpResponse BaseProvider::send_with_retries(const network::HttpRequest& http_request,
+                                                      const RetryPolicy& policy) {
+    auto result = std::make_shared<std::promise<network::HttpResponse>>();
+    std::future<network::HttpResponse> response = result->get_future();
+
+    send_with_retries_async(http_request, [result](network::HttpResponse http_response) {
+        result->set_value(std::move(http_response));
+    }, policy);
+
+    core::CancellationToken token = core::current_cancellation();
+    if (token.valid()) {
+        // A pending backoff timer would hold the caller until it fires; stop waiting instead
+        while (response.wait_for(std::chrono::milliseconds(20)) != std::future_status::ready) {
+            if (token.cancelled()) {
+                network::HttpResponse cancelled;
+                cancelled.error_message = "Request cancelled";
+                return cancelled;
+            }
+        }
+    }
+    return response.get();
+}
+
+void BaseProvider::send_request_async(const core::Request& request, core::ResponseCallback on_complete) {
+    network::HttpRequest http_request;
+    try {
+        if (!http_client_ || !build_http_request(request, http_request)) {
+            core::Bridge::send_request_async(request, std::move(on_complete));
+            return;
+        }
+    } catch (const std::exception& e) {
+        on_complete(make_exception_response(e));
+        return;
+    }
+
+    if (!check_rate_limit()) {
+        core::Response response;
+        response.success = false;
+        response.error_message = "Rate limit exceeded";
+        response.status_code = 429;
+        response.provider_name = provider_name_;
+        on_complete(std::move(response));
+        return;
+    }
+
+    // Completions run on the event loop thread; carry the caller's token there
+    // so process_response() recognises a cancelled hedge loser
+    send_with_retries_async(http_request,
+        [this, token = core::current_cancellation(), on_complete = std::move(on_complete)](
+            network::HttpResponse http_response) {
+            core::CancellationScope scope(token);
+            core::Response response = process_response(http_response.status_code, http_response.body);
+            response.response_time_ms = http_response.response_time_ms;
+            on_complete(std::move(response));
+        });
+}
+
+void BaseProvider::apply_auth_headers(network::HttpRequest& http_request) const {
+    uint64_t epoch = ::aimux::security::AdvancedCrypto::credential_epoch();
+    auto prepared = auth_headers_.load(std::memory_order_acquire);
+
+    if (!prepared || prepared->epoch != epoch) {
+        // Concurrent rebuilds after a rotation are harmless: each renders the same list
+        auto fresh = std::make_shared<AuthHeaders>();
+        std::string bearer = "Bearer " + security::decrypt_api_key(encrypted_api_key_);
+        fresh->authorization = ::aimux::security::SecureString(bearer);
+        OPENSSL_cleanse(bearer.data(), bearer.size());
+        add_request_headers(fresh->headers);
+        fresh->epoch = epoch;
+
+        prepared = std::move(fresh);
+        auth_headers_.store(prepared, std::memory_order_release);
+    }
+
+    http_request.headers.clear();
+    http_request.headers.reserve(prepared->headers.size() + 1);
+    http_request.headers.emplace_back(api_specs::headers::AUTHORIZATION, prepared->authorization.view());
+    http_request.headers.insert(http_request.headers.end(), prepared->headers.begin(), prepared->headers.end());
+}
+
+void BaseProvider::add_request_headers(std::vector<std::pair<std::string, std::string>>& headers) const {
+    headers.emplace_back(api_specs::headers::CONTENT_TYPE, api_specs::headers::APPLICATION_JSON);
+    headers.emplace_back(api_specs::headers::USER_AGENT, api_specs::headers::AIMUX_USER_AGENT);
+}
+
+bool BaseProvider::build_http_request(const core::Request& /*request*/, network::HttpRequest& /*http_request*/) {
+    return false;
+}
+
+network::HttpRequest BaseProvider::build_probe_request() const {
+    // Same credentials as a real call, but a bodiless GET that costs no tokens
+    network::HttpRequest http_request;
+    http_request.url = endpoint_ + health_probe_path_;
+    http_request.method = "GET";
+    http_request.timeout_ms = api_specs::timeouts::HEALTH_PROBE.count();
+    apply_auth_headers(http_request);
+    return http_request;
+}
+
+core::Response BaseProvider::make_probe_response(const network::HttpResponse& http_response) const {
+    core::Response response;
+    response.provider_name = provider_name_;
+    response.status_code = http_response.status_code;
+    response.success = http_response.is_success();
+    response.response_time_ms = http_response.response_time_ms;
+    if (!response.success) {
+        response.error_message = http_response.error_message.empty()
+            ? "Health probe returned HTTP " + std::to_string(http_response.status_code)
+            : http_response.error_message;
+    }
+    return response;
+}
+
+core::Response BaseProvider::probe_health() {
+    if (!http_client_ || health_probe_path_.empty()) {
+        return core::Bridge::probe_health();
+    }
+
+    try {
+        return make_probe_response(http_client_->send_request(build_probe_request()));
+    } catch (const std::exception& e) {
+        return make_exception_response(e);
+    }
+}
+
+void BaseProvider::probe_health_async(core::ResponseCallback on_complete) {
+    if (!http_client_ || health_probe_path_.empty()) {
+        core::Bridge::probe_health_async(std::move(on_complete));
+        return;
+    }
+
+    network::HttpRequest http_request;
+    try {
+        http_request = build_probe_request();
+    } catch (const std::exception& e) {
+        on_complete(make_exception_response(e));
+        return;
+    }
+
+    // No retries: a failed probe is itself the signal, and the next one is already scheduled
+    http_client_->send_request_async(http_request,
+        [this, on_complete = std::move(on_complete)](const network::HttpResponse& http_response) {
+            on_complete(make_probe_response(http_response));
+        });
+}
+
+core::Response BaseProvider::make_exception_response(const std::exception& e) {
+    core::Response response;
+    response.success = false;
+    response.error_message = provider_name_ + " error: " + std::string(e.what());
+    response.status_code = 500;
+    response.provider_name = provider_name_;
+    return response;
+}
+
 core::Response BaseProvider::process_response(int status_code, const std::string& response_body) {
     core::Response response;
     response.status_code = status_code;
     response.provider_name = provider_name_;
 
+    if (status_code == 0 && core::current_cancellation().cancelled()) {
+        // Abandoned by the caller (e.g. a losing hedge); says nothing about provider health
+        response.success = false;
+        response.status_code = 499;
+        response.error_message = "Request cancelled";
+        return response;
+    }
+
     if (status_code >= 200 && status_code < 300) {
         response.success = true;
         response.data = response_body;
@@ -225,6 +482,9 @@ CerebrasProvider::CerebrasProvider(const nlohmann::json& config)
 
     // Use API specs for rate limiting
     max_requests_per_minute_ = config.value("max_requests_per_minute", api_specs::get_rate_limit("cerebras"));
+    init_rate_limiter();
+
+    init_http_client();
 }
 
 core::Response CerebrasProvider::send_request(const core::Request& request) {
@@ -237,55 +497,12 @@ core::Response CerebrasProvider::send_request(const core::Request& request) {
         return response;
     }
     
-    update_rate_limit();
-    
     try {
-        // Decrypt API key for use
-        std::string api_key = security::decrypt_api_key(encrypted_api_key_);
-        auto http_client = network::HttpClientFactory::create_client();
-
-        // Use API specs headers
-        http_client->add_default_header(api_specs::headers::AUTHORIZATION, "Bearer " + api_key);
-        http_client->add_default_header(api_specs::headers::CONTENT_TYPE, api_specs::headers::APPLICATION_JSON);
-        http_client->add_default_header(api_specs::headers::USER_AGENT, api_specs::headers::AIMUX_USER_AGENT);
-
         network::HttpRequest http_request;
-        http_request.url = endpoint_ + api_specs::paths::CHAT_COMPLETIONS;
-        http_request.method = "POST";
-        http_request.body = format_cerebras_request(request);
-        http_request.timeout_ms = api_specs::timeouts::REQUEST_TIMEOUT.count();
-        
-        // Retry logic for better reliability
-        network::HttpResponse http_response;
-        int max_retries = 3;
+        build_http_request(request, http_request);
         
-        for (int attempt = 0; attempt < max_retries; ++attempt) {
-            try {
-                http_response = http_client->send_request(http_request);
-                
-                // Check for successful HTTP status
-                if (http_response.status_code >= 200 && http_response.status_code < 300) {
-                    break; // Success, exit retry loop
-                } else if (http_response.status_code == 429) {
-                    // Rate limited - wait before retry
-                    std::this_thread::sleep_for(std::chrono::seconds(1));
-                } else if (http_response.status_code >= 500) {
-                    // Server error - retry after brief delay
-                    if (attempt < max_retries - 1) {
-                        std::this_thread::sleep_for(std::chrono::milliseconds(500 * (attempt + 1)));
-                    }
-                } else {
-                    // Client error (4xx) - don't retry
-                    break;
-                }
-            } catch (const std::exception& e) {
-                if (attempt == max_retries - 1) {
-                    throw; // Re-throw on final attempt
-                }
-                // Wait before retry
-                std::this_thread::sleep_for(std::chrono::milliseconds(1000 * (attempt + 1)));
-            }
-        }
+        // 429/5xx/transport failures are retried with backoff on the event loop
+        network::HttpResponse http_response = send_with_retries(http_request);
         
         core::Response response = process_response(http_response.status_code, http_response.body);
         response.response_time_ms = http_response.response_time_ms;
@@ -293,47 +510,60 @@ core::Response CerebrasProvider::send_request(const core::Request& request) {
         return response;
         
     } catch (const std::exception& e) {
-        core::Response response;
-        response.success = false;
-        response.provider_name = provider_name_;
+        return make_exception_response(e);
+    }
+}
 
-        // Enhanced error categorization
-        std::string error_msg = e.what();
-        if (error_msg.find("timeout") != std::string::npos ||
-            error_msg.find("Timeout") != std::string::npos) {
-            response.error_message = "Cerebras timeout error: " + error_msg;
-            response.status_code = 408;
-            consecutive_failures_++;
-            last_failure_time_ = std::chrono::steady_clock::now();
-        } else if (error_msg.find("connection") != std::string::npos ||
-                   error_msg.find("network") != std::string::npos ||
-                   error_msg.find("Network") != std::string::npos) {
-            response.error_message = "Cerebras network error: " + error_msg;
-            response.status_code = 503;
-            consecutive_failures_++;
-            last_failure_time_ = std::chrono::steady_clock::now();
-        } else if (error_msg.find("authentication") != std::string::npos ||
-                   error_msg.find("auth") != std::string::npos ||
-                   error_msg.find("unauthorized") != std::string::npos) {
-            response.error_message = "Cerebras authentication error: " + error_msg;
-            response.status_code = 401;
-            is_healthy_ = false;  // Auth errors should mark as unhealthy
-            consecutive_failures_ = 5;
-            last_failure_time_ = std::chrono::steady_clock::now();
-        } else {
-            response.error_message = "Cerebras error: " + error_msg;
-            response.status_code = 500;
-            consecutive_failures_++;
-            last_failure_time_ = std::chrono::steady_clock::now();
+bool CerebrasProvider::build_http_request(const core::Request& request, network::HttpRequest& http_request) {
+    http_request.url = endpoint_ + api_specs::paths::CHAT_COMPLETIONS;
+    http_request.method = "POST";
+    apply_auth_headers(http_request);
+    http_request.body = format_cerebras_request(request);
+    http_request.timeout_ms = static_cast<int>(request_timeout_.count());
+    return true;
+}
 
-            // Mark as unhealthy after multiple unknown errors
-            if (consecutive_failures_ >= 3) {
-                is_healthy_ = false;
-            }
-        }
+core::Response CerebrasProvider::make_exception_response(const std::exception& e) {
+    core::Response response;
+    response.success = false;
+    response.provider_name = provider_name_;
 
-        return response;
+    // Enhanced error categorization
+    std::string error_msg = e.what();
+    if (error_msg.find("timeout") != std::string::npos ||
+        error_msg.find("Timeout") != std::string::npos) {
+        response.error_message = "Cerebras timeout error: " + error_msg;
+        response.status_code = 408;
+        consecutive_failures_++;
+        last_failure_time_ = std::chrono::steady_clock::now();
+    } else if (error_msg.find("connection") != std::string::npos ||
+               error_msg.find("network") != std::string::npos ||
+               error_msg.find("Network") != std::string::npos) {
+        response.error_message = "Cerebras network error: " + error_msg;
+        response.status_code = 503;
+        consecutive_failures_++;
+        last_failure_time_ = std::chrono::steady_clock::now();
+    } else if (error_msg.find("authentication") != std::string::npos ||
+               error_msg.find("auth") != std::string::npos ||
+               error_msg.find("unauthorized") != std::string::npos) {
+        response.error_message = "Cerebras authentication error: " + error_msg;
+        response.status_code = 401;
+        is_healthy_ = false;  // Auth errors should mark as unhealthy
+        consecutive_failures_ = 5;
+        last_failure_time_ = std::chrono::steady_clock::now();
+    } else {
+        response.error_message = "Cerebras error: " + error_msg;
+        response.status_code = 500;
+        consecutive_failures_++;
+        last_failure_time_ = std::chrono::steady_clock::now();
+
+        // Mark as unhealthy after multiple unknown errors
+        if (consecutive_failures_ >= 3) {
+            is_healthy_ = false;
+        }
     }
+
+    return response;
 }
 
 bool CerebrasProvider::is_healthy() const {
@@ -350,14 +580,12 @@ nlohmann::json CerebrasProvider::get_rate_limit_status() const {
     nlohmann::json status;
     status["provider"] = provider_name_;
     status["endpoint"] = endpoint_;
-    status["requests_made"] = requests_made_;
-    status["max_requests_per_minute"] = max_requests_per_minute_;
-    status["requests_remaining"] = std::max(0, max_requests_per_minute_ - requests_made_);
+    add_rate_limit_status(status);
+    status["is_healthy"] = is_healthy_.load();
 
-    auto now = std::chrono::steady_clock::now();
-    auto reset_in_seconds = std::chrono::duration_cast<std::chrono::seconds>(rate_limit_reset_ - now).count();
-    status["reset_in_seconds"] = std::max<long long>(0LL, reset_in_seconds);
-    status["is_healthy"] = is_healthy_;
+    if (http_client_) {
+        status["http_client"] = http_client_->get_statistics();
+    }
 
     // Add provider capabilities from API specs
     auto caps = api_specs::get_provider_capabilities("cerebras");
@@ -420,7 +648,7 @@ std::string CerebrasProvider::format_cerebras_request(const core::Request& reque
         cerebras_request["top_p"] = 0.95;
     }
 
-    return cerebras_request.dump();
+    return core::dump_json(cerebras_request);
 }
 
 nlohmann::json CerebrasProvider::parse_cerebras_response(const std::string& response) {
@@ -515,6 +743,9 @@ ZaiProvider::ZaiProvider(const nlohmann::json& config)
 
     // Use API specs for rate limiting
     max_requests_per_minute_ = config.value("max_requests_per_minute", api_specs::get_rate_limit("zai"));
+    init_rate_limiter();
+
+    init_http_client();
 }
 
 core::Response ZaiProvider::send_request(const core::Request& request) {
@@ -527,6 +758,35 @@ core::Response ZaiProvider::send_request(const core::Request& request) {
         return response;
     }
 
+    if (auto invalid = validate_zai_request(request)) {
+        return *invalid;
+    }
+
+    try {
+        network::HttpRequest http_request;
+        build_http_request(request, http_request);
+        
+        network::HttpResponse http_response = http_client_->send_request(http_request);
+        
+        core::Response response = process_response(http_response.status_code, http_response.body);
+        response.response_time_ms = http_response.response_time_ms;
+        
+        return response;
+        
+    } catch (const std::exception& e) {
+        return make_exception_response(e);
+    }
+}
+
+void ZaiProvider::send_request_async(const core::Request& request, core::ResponseCallback on_complete) {
+    if (auto invalid = validate_zai_request(request)) {
+        on_complete(std::move(*invalid));
+        return;
+    }
+    BaseProvider::send_request_async(request, std::move(on_complete));
+}
+
+std::optional<core::Response> ZaiProvider::validate_zai_request(const core::Request& request) const {
     // Validate request structure before processing
     if (request.data.empty()) {
         core::Response response;
@@ -581,80 +841,66 @@ core::Response ZaiProvider::send_request(const core::Request& request) {
         }
     }
 
-    update_rate_limit();
-    
-    try {
-        // Decrypt API key for use
-        std::string api_key = security::decrypt_api_key(encrypted_api_key_);
-        auto http_client = network::HttpClientFactory::create_client();
+    return std::nullopt;
+}
 
-        // Use API specs headers
-        http_client->add_default_header(api_specs::headers::AUTHORIZATION, "Bearer " + api_key);
-        http_client->add_default_header(api_specs::headers::CONTENT_TYPE, api_specs::headers::APPLICATION_JSON);
-        http_client->add_default_header(api_specs::headers::USER_AGENT, api_specs::headers::AIMUX_USER_AGENT);
+bool ZaiProvider::build_http_request(const core::Request& request, network::HttpRequest& http_request) {
+    http_request.url = endpoint_ + api_specs::paths::CHAT_COMPLETIONS;
+    http_request.method = "POST";
+    apply_auth_headers(http_request);
+    http_request.body = format_zai_request(request);
+    http_request.timeout_ms = static_cast<int>(request_timeout_.count());
+    return true;
+}
 
-        network::HttpRequest http_request;
-        http_request.url = endpoint_ + api_specs::paths::CHAT_COMPLETIONS;
-        http_request.method = "POST";
-        http_request.body = format_zai_request(request);
-        http_request.timeout_ms = api_specs::timeouts::REQUEST_TIMEOUT.count();
-        
-        network::HttpResponse http_response = http_client->send_request(http_request);
-        
-        core::Response response = process_response(http_response.status_code, http_response.body);
-        response.response_time_ms = http_response.response_time_ms;
-        
-        return response;
-        
-    } catch (const std::exception& e) {
-        core::Response response;
-        response.success = false;
-        response.provider_name = provider_name_;
+core::Response ZaiProvider::make_exception_response(const std::exception& e) {
+    core::Response response;
+    response.success = false;
+    response.provider_name = provider_name_;
 
-        // Enhanced error categorization for Z.AI
-        std::string error_msg = e.what();
-        if (error_msg.find("timeout") != std::string::npos ||
-            error_msg.find("Timeout") != std::string::npos) {
-            response.error_message = "Z.AI timeout error: " + error_msg;
-            response.status_code = 408;
-            consecutive_failures_++;
-            last_failure_time_ = std::chrono::steady_clock::now();
-        } else if (error_msg.find("connection") != std::string::npos ||
-                   error_msg.find("network") != std::string::npos ||
-                   error_msg.find("Network") != std::string::npos) {
-            response.error_message = "Z.AI network error: " + error_msg;
-            response.status_code = 503;
-            consecutive_failures_++;
-            last_failure_time_ = std::chrono::steady_clock::now();
-        } else if (error_msg.find("authentication") != std::string::npos ||
-                   error_msg.find("auth") != std::string::npos ||
-                   error_msg.find("unauthorized") != std::string::npos) {
-            response.error_message = "Z.AI authentication error: " + error_msg;
-            response.status_code = 401;
-            is_healthy_ = false;  // Auth errors should mark as unhealthy
-            consecutive_failures_ = 5;
-            last_failure_time_ = std::chrono::steady_clock::now();
-        } else if (error_msg.find("parse") != std::string::npos ||
-                   error_msg.find("JSON") != std::string::npos ||
-                   error_msg.find("format") != std::string::npos) {
-            response.error_message = "Z.AI format error: " + error_msg;
-            response.status_code = 422;  // Unprocessable Entity
-            consecutive_failures_++;  // Format errors shouldn't mark as unhealthy immediately
-            last_failure_time_ = std::chrono::steady_clock::now();
-        } else {
-            response.error_message = "Z.AI error: " + error_msg;
-            response.status_code = 500;
-            consecutive_failures_++;
-            last_failure_time_ = std::chrono::steady_clock::now();
+    // Enhanced error categorization for Z.AI
+    std::string error_msg = e.what();
+    if (error_msg.find("timeout") != std::string::npos ||
+        error_msg.find("Timeout") != std::string::npos) {
+        response.error_message = "Z.AI timeout error: " + error_msg;
+        response.status_code = 408;
+        consecutive_failures_++;
+        last_failure_time_ = std::chrono::steady_clock::now();
+    } else if (error_msg.find("connection") != std::string::npos ||
+               error_msg.find("network") != std::string::npos ||
+               error_msg.find("Network") != std::string::npos) {
+        response.error_message = "Z.AI network error: " + error_msg;
+        response.status_code = 503;
+        consecutive_failures_++;
+        last_failure_time_ = std::chrono::steady_clock::now();
+    } else if (error_msg.find("authentication") != std::string::npos ||
+               error_msg.find("auth") != std::string::npos ||
+               error_msg.find("unauthorized") != std::string::npos) {
+        response.error_message = "Z.AI authentication error: " + error_msg;
+        response.status_code = 401;
+        is_healthy_ = false;  // Auth errors should mark as unhealthy
+        consecutive_failures_ = 5;
+        last_failure_time_ = std::chrono::steady_clock::now();
+    } else if (error_msg.find("parse") != std::string::npos ||
+               error_msg.find("JSON") != std::string::npos ||
+               error_msg.find("format") != std::string::npos) {
+        response.error_message = "Z.AI format error: " + error_msg;
+        response.status_code = 422;  // Unprocessable Entity
+        consecutive_failures_++;  // Format errors shouldn't mark as unhealthy immediately
+        last_failure_time_ = std::chrono::steady_clock::now();
+    } else {
+        response.error_message = "Z.AI error: " + error_msg;
+        response.status_code = 500;
+        consecutive_failures_++;
+        last_failure_time_ = std::chrono::steady_clock::now();
 
-            // Mark as unhealthy after multiple unknown errors
-            if (consecutive_failures_ >= 3) {
-                is_healthy_ = false;
-            }
+        // Mark as unhealthy after multiple unknown errors
+        if (consecutive_failures_ >= 3) {
+            is_healthy_ = false;
         }
-
-        return response;
     }
+
+    return response;
 }
 
 bool ZaiProvider::is_healthy() const {
@@ -671,14 +917,12 @@ nlohmann::json ZaiProvider::get_rate_limit_status() const {
     nlohmann::json status;
     status["provider"] = provider_name_;
     status["endpoint"] = endpoint_;
-    status["requests_made"] = requests_made_;
-    status["max_requests_per_minute"] = max_requests_per_minute_;
-    status["requests_remaining"] = std::max(0, max_requests_per_minute_ - requests_made_);
+    add_rate_limit_status(status);
+    status["is_healthy"] = is_healthy_.load();
 
-    auto now = std::chrono::steady_clock::now();
-    auto reset_in_seconds = std::chrono::duration_cast<std::chrono::seconds>(rate_limit_reset_ - now).count();
-    status["reset_in_seconds"] = std::max<long long>(0LL, reset_in_seconds);
-    status["is_healthy"] = is_healthy_;
+    if (http_client_) {
+        status["http_client"] = http_client_->get_statistics();
+    }
 
     // Add provider capabilities from API specs
     auto caps = api_specs::get_provider_capabilities("zai");
@@ -854,7 +1098,7 @@ std::string ZaiProvider::format_zai_request(const core::Request& request) {
         openai_request["stream"] = true;
     }
 
-    return openai_request.dump();
+    return core::dump_json(openai_request);
 }
 
 nlohmann::json ZaiProvider::parse_zai_response(const std::string& response) {
@@ -1055,7 +1299,7 @@ core::Response SyntheticProvider::send_request(const core::Request& request) {
     response.provider_name = provider_name_;
     response.response_time_ms = sleep_dist(rng_);
     
-    update_rate_limit();
+    requests_served_++;
     
     return response;
 }
@@ -1071,9 +1315,10 @@ std::string SyntheticProvider::get_provider_name() const {
 nlohmann::json SyntheticProvider::get_rate_limit_status() const {
     nlohmann::json status;
     status["provider"] = provider_name_;
-    status["requests_made"] = requests_made_;
+    int requests_made = requests_served_.load();
+    status["requests_made"] = requests_made;
     status["max_requests_per_minute"] = 1000; // High limit for synthetic
-    status["requests_remaining"] = 1000 - requests_made_;
+    status["requests_remaining"] = 1000 - requests_made;
     status["reset_in_seconds"] = 60;
     return status;
 }
@@ -1117,6 +1362,9 @@ MiniMaxProvider::MiniMaxProvider(const nlohmann::json& config)
         throw std::invalid_argument("Invalid or malformed API key for MiniMax provider");
     }
 
+    // The Anthropic-compatible API documents no models listing: probe only when configured
+    health_probe_path_ = config.value("health_probe_path", "");
+
     // Extract and validate Group ID for MiniMax authentication
     group_id_ = config.value("group_id", "");
     if (group_id_.empty()) {
@@ -1135,6 +1383,9 @@ MiniMaxProvider::MiniMaxProvider(const nlohmann::json& config)
 
     // Use API specs for rate limiting
     max_requests_per_minute_ = config.value("max_requests_per_minute", api_specs::get_rate_limit("minimax"));
+    init_rate_limiter();
+
+    init_http_client();
 }
 
 core::Response MiniMaxProvider::send_request(const core::Request& request) {
@@ -1147,28 +1398,11 @@ core::Response MiniMaxProvider::send_request(const core::Request& request) {
         return response;
     }
     
-    update_rate_limit();
-    
     try {
-        auto http_client = network::HttpClientFactory::create_client();
-
-        // Add MiniMax-specific auth headers
-        auto auth_headers = get_auth_headers();
-        for (const auto& header : auth_headers) {
-            http_client->add_default_header(header.first, header.second);
-        }
-
-        // Use API specs headers
-        http_client->add_default_header(api_specs::headers::CONTENT_TYPE, api_specs::headers::APPLICATION_JSON);
-        http_client->add_default_header(api_specs::headers::USER_AGENT, api_specs::headers::AIMUX_USER_AGENT);
-
         network::HttpRequest http_request;
-        http_request.url = endpoint_ + api_specs::paths::MESSAGES;
-        http_request.method = "POST";
-        http_request.body = format_minimax_request(request);
-        http_request.timeout_ms = api_specs::timeouts::REQUEST_TIMEOUT.count();
+        build_http_request(request, http_request);
         
-        network::HttpResponse http_response = http_client->send_request(http_request);
+        network::HttpResponse http_response = http_client_->send_request(http_request);
         
         core::Response response = process_response(http_response.status_code, http_response.body);
         response.response_time_ms = http_response.response_time_ms;
@@ -1185,6 +1419,16 @@ core::Response MiniMaxProvider::send_request(const core::Request& request) {
     }
 }
 
+bool MiniMaxProvider::build_http_request(const core::Request& request, network::HttpRequest& http_request) {
+    http_request.url = endpoint_ + api_specs::paths::MESSAGES;
+    http_request.method = "POST";
+
+    apply_auth_headers(http_request);
+    http_request.body = format_minimax_request(request);
+    http_request.timeout_ms = static_cast<int>(request_timeout_.count());
+    return true;
+}
+
 bool MiniMaxProvider::is_healthy() const {
     // Check for potential recovery before returning status
     const_cast<MiniMaxProvider*>(this)->check_recovery();
@@ -1199,14 +1443,12 @@ nlohmann::json MiniMaxProvider::get_rate_limit_status() const {
     nlohmann::json status;
     status["provider"] = provider_name_;
     status["endpoint"] = endpoint_;
-    status["requests_made"] = requests_made_;
-    status["max_requests_per_minute"] = max_requests_per_minute_;
-    status["requests_remaining"] = std::max(0, max_requests_per_minute_ - requests_made_);
+    add_rate_limit_status(status);
+    status["is_healthy"] = is_healthy_.load();
 
-    auto now = std::chrono::steady_clock::now();
-    auto reset_in_seconds = std::chrono::duration_cast<std::chrono::seconds>(rate_limit_reset_ - now).count();
-    status["reset_in_seconds"] = std::max<long long>(0LL, reset_in_seconds);
-    status["is_healthy"] = is_healthy_;
+    if (http_client_) {
+        status["http_client"] = http_client_->get_statistics();
+    }
 
     // Add provider capabilities from API specs
     auto caps = api_specs::get_provider_capabilities("minimax");
@@ -1301,18 +1543,13 @@ std::string MiniMaxProvider::format_minimax_request(const core::Request& request
         }
     }
 
-    return minimax_request.dump();
+    return core::dump_json(minimax_request);
 }
 
-std::map<std::string, std::string> MiniMaxProvider::get_auth_headers() const {
-    std::map<std::string, std::string> headers;
-    std::string api_key = security::decrypt_api_key(encrypted_api_key_);
-
+void MiniMaxProvider::add_request_headers(std::vector<std::pair<std::string, std::string>>& headers) const {
     // MiniMax-specific authentication
-    headers[api_specs::headers::AUTHORIZATION] = "Bearer " + api_key;
-    headers[api_specs::headers::X_GROUP_ID] = group_id_;
-
-    return headers;
+    headers.emplace_back(api_specs::headers::X_GROUP_ID, group_id_);
+    BaseProvider::add_request_headers(headers);
 }
 
 nlohmann::json MiniMaxProvider::parse_minimax_response(const std::string& response) {
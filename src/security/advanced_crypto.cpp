@@ -2,18 +2,26 @@
 #include <openssl/evp.h>
 #include <openssl/rand.h>
 #include <openssl/sha.h>
-#include <openssl/pbkdf2.h>
 #include <openssl/aes.h>
-#include <openssl/base64.h>
+#include <openssl/bio.h>
+#include <openssl/buffer.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#include <iostream>
 #include <sstream>
 #include <iomanip>
 #include <stdexcept>
 #include <cstring>
-#include <iomanip>
 
 namespace aimux {
 namespace security {
 
+namespace {
+
+std::atomic<uint64_t> g_credential_epoch{0};
+
+} // namespace
+
 AdvancedCrypto::AdvancedCrypto(const std::string& master_key)
     : cipher_ctx_(nullptr, [](EVP_CIPHER_CTX* ctx) { if (ctx) EVP_CIPHER_CTX_free(ctx); }) {
 
@@ -25,17 +33,7 @@ AdvancedCrypto::AdvancedCrypto(const std::string& master_key)
         master_key_ = hex_to_bytes(master_key);
     }
 
-    // Initialize current key metadata
-    KeyInfo current_key;
-    current_key.key = master_key_;
-    current_key.metadata.key_id = generate_key_id();
-    current_key.metadata.created_at = std::chrono::system_clock::now();
-    current_key.metadata.expires_at = std::chrono::system_clock::now() + std::chrono::hours(24 * 30); // 30 days
-    current_key.metadata.is_active = true;
-    current_key.metadata.version = 1;
-
-    key_history_.push_back(current_key);
-    current_key_id_ = current_key.metadata.key_id;
+    add_master_key(1);
 
     std::cout << "✅ AdvancedCrypto initialized with key ID: " << current_key_id_ << std::endl;
 }
@@ -65,17 +63,18 @@ AdvancedCrypto::EncryptedData AdvancedCrypto::encrypt_api_key(const std::string&
         throw std::runtime_error("API key cannot be empty");
     }
 
-    // Generate salt and IV
-    auto salt = generate_random_bytes(SALT_SIZE);
+    // Fresh IV per call; the salt (and so the derived key) belongs to the master key
     auto iv = generate_random_bytes(IV_SIZE);
 
-    // Derive encryption key from master key and salt
-    auto encryption_key = derive_encryption_key(master_key_, salt);
+    std::lock_guard<std::mutex> lock(mutex_);
+    const KeyInfo& current_key = key_history_.back();
+    const auto* encryption_key = reinterpret_cast<const unsigned char*>(
+        cached_encryption_key(current_key, current_key.salt).view().data());
 
     // Encrypt using AES-256-GCM
     try {
         EncryptedData result;
-        result.salt = salt;
+        result.salt = current_key.salt;
         result.iv = iv;
 
         // Convert string to bytes
@@ -87,7 +86,7 @@ AdvancedCrypto::EncryptedData AdvancedCrypto::encrypt_api_key(const std::string&
             throw std::runtime_error("Failed to initialize AES-256-GCM encryption");
         }
 
-        if (EVP_EncryptInit_ex(cipher_ctx_.get(), nullptr, nullptr, encryption_key.data(), iv.data()) != 1) {
+        if (EVP_EncryptInit_ex(cipher_ctx_.get(), nullptr, nullptr, encryption_key, iv.data()) != 1) {
             throw std::runtime_error("Failed to set encryption key and IV");
         }
 
@@ -112,13 +111,9 @@ AdvancedCrypto::EncryptedData AdvancedCrypto::encrypt_api_key(const std::string&
             throw std::runtime_error("Failed to get authentication tag");
         }
 
-        // Securely clear the derived key
-        secure_clear(encryption_key.data(), encryption_key.size());
-
         return result;
 
     } catch (const std::exception& e) {
-        secure_clear(encryption_key.data(), encryption_key.size());
         throw std::runtime_error("Encryption failed: " + std::string(e.what()));
     }
 }
@@ -129,6 +124,8 @@ std::string AdvancedCrypto::decrypt_api_key(const EncryptedData& encrypted_data)
         throw std::runtime_error("Invalid encrypted data structure");
     }
 
+    std::lock_guard<std::mutex> lock(mutex_);
+
     // Try decrypting with current and all valid keys
     for (const auto& key_info : key_history_) {
         if (!key_info.metadata.is_active && key_info.metadata.expires_at < std::chrono::system_clock::now()) {
@@ -136,25 +133,23 @@ std::string AdvancedCrypto::decrypt_api_key(const EncryptedData& encrypted_data)
         }
 
         try {
-            auto encryption_key = derive_encryption_key(key_info.key, encrypted_data.salt);
+            const auto* encryption_key = reinterpret_cast<const unsigned char*>(
+                cached_encryption_key(key_info, encrypted_data.salt).view().data());
 
             std::vector<uint8_t> plaintext(encrypted_data.ciphertext.size() + AES_BLOCK_SIZE);
 
             if (EVP_DecryptInit_ex(cipher_ctx_.get(), EVP_aes_256_gcm(), nullptr, nullptr, nullptr) != 1) {
-                secure_clear(encryption_key.data(), encryption_key.size());
                 continue;
             }
 
             if (EVP_DecryptInit_ex(cipher_ctx_.get(), nullptr, nullptr,
-                                  encryption_key.data(), encrypted_data.iv.data()) != 1) {
-                secure_clear(encryption_key.data(), encryption_key.size());
+                                  encryption_key, encrypted_data.iv.data()) != 1) {
                 continue;
             }
 
             int len;
             if (EVP_DecryptUpdate(cipher_ctx_.get(), plaintext.data(), &len,
                                  encrypted_data.ciphertext.data(), encrypted_data.ciphertext.size()) != 1) {
-                secure_clear(encryption_key.data(), encryption_key.size());
                 continue;
             }
 
@@ -163,22 +158,20 @@ std::string AdvancedCrypto::decrypt_api_key(const EncryptedData& encrypted_data)
             // Set the expected tag value
             if (EVP_CIPHER_CTX_ctrl(cipher_ctx_.get(), EVP_CTRL_GCM_SET_TAG, TAG_SIZE,
                                    const_cast<uint8_t*>(encrypted_data.tag.data())) != 1) {
-                secure_clear(encryption_key.data(), encryption_key.size());
                 continue;
             }
 
             if (EVP_DecryptFinal_ex(cipher_ctx_.get(), plaintext.data() + len, &len) <= 0) {
                 // Authentication failed
-                secure_clear(encryption_key.data(), encryption_key.size());
                 continue;
             }
 
             plaintext_len += len;
             plaintext.resize(plaintext_len);
 
-            secure_clear(encryption_key.data(), encryption_key.size());
-
-            return std::string(plaintext.begin(), plaintext.end());
+            std::string api_key(plaintext.begin(), plaintext.end());
+            secure_clear(plaintext.data(), plaintext.size());
+            return api_key;
 
         } catch (const std::exception&) {
             continue; // Try next key
@@ -226,6 +219,8 @@ std::string AdvancedCrypto::decrypt_api_key_from_base64(const std::string& base6
 }
 
 void AdvancedCrypto::rotate_master_key(int grace_period_hours) {
+    std::lock_guard<std::mutex> lock(mutex_);
+
     // Mark current key as inactive but still valid for grace period
     for (auto& key_info : key_history_) {
         if (key_info.metadata.key_id == current_key_id_) {
@@ -239,24 +234,37 @@ void AdvancedCrypto::rotate_master_key(int grace_period_hours) {
     // Generate new master key
     std::vector<uint8_t> old_master_key = master_key_;
     master_key_ = generate_master_key();
+    add_master_key(key_history_.back().metadata.version + 1);
+
+    // Securely clear old key; keys derived from it are re-derived on demand during the grace period
+    secure_clear(old_master_key.data(), old_master_key.size());
+    derived_keys_.clear();
+    g_credential_epoch.fetch_add(1, std::memory_order_release);
 
-    // Create new metadata
+    std::cout << "🔄 Master key rotated. New key ID: " << current_key_id_
+              << " (Grace period: " << grace_period_hours << " hours)" << std::endl;
+}
+
+uint64_t AdvancedCrypto::credential_epoch() noexcept {
+    return g_credential_epoch.load(std::memory_order_acquire);
+}
+
+uint64_t AdvancedCrypto::derivation_count() const noexcept {
+    return derivations_.load(std::memory_order_relaxed);
+}
+
+void AdvancedCrypto::add_master_key(int version) {
     KeyInfo new_key;
     new_key.key = master_key_;
+    new_key.salt = generate_random_bytes(SALT_SIZE);
     new_key.metadata.key_id = generate_key_id();
     new_key.metadata.created_at = std::chrono::system_clock::now();
     new_key.metadata.expires_at = std::chrono::system_clock::now() + std::chrono::hours(24 * 30); // 30 days
     new_key.metadata.is_active = true;
-    new_key.metadata.version = key_history_.back().metadata.version + 1;
+    new_key.metadata.version = version;
 
-    key_history_.push_back(new_key);
-    current_key_id_ = new_key.metadata.key_id;
-
-    // Securely clear old key
-    secure_clear(old_master_key.data(), old_master_key.size());
-
-    std::cout << "🔄 Master key rotated. New key ID: " << current_key_id_
-              << " (Grace period: " << grace_period_hours << " hours)" << std::endl;
+    key_history_.push_back(std::move(new_key));
+    current_key_id_ = key_history_.back().metadata.key_id;
 }
 
 std::string AdvancedCrypto::generate_secure_key(size_t key_length) {
@@ -356,6 +364,7 @@ std::vector<uint8_t> AdvancedCrypto::base64_decode(const std::string& base64) {
 }
 
 AdvancedCrypto::KeyMetadata AdvancedCrypto::get_master_key_metadata() const {
+    std::lock_guard<std::mutex> lock(mutex_);
     for (const auto& key_info : key_history_) {
         if (key_info.metadata.key_id == current_key_id_) {
             return key_info.metadata;
@@ -365,6 +374,7 @@ AdvancedCrypto::KeyMetadata AdvancedCrypto::get_master_key_metadata() const {
 }
 
 bool AdvancedCrypto::is_key_valid(const std::string& key_id) const {
+    std::lock_guard<std::mutex> lock(mutex_);
     for (const auto& key_info : key_history_) {
         if (key_info.metadata.key_id == key_id) {
             return key_info.metadata.is_active || key_info.metadata.expires_at > std::chrono::system_clock::now();
@@ -385,6 +395,30 @@ std::vector<uint8_t> AdvancedCrypto::derive_encryption_key(
     );
 }
 
+const SecureString& AdvancedCrypto::cached_encryption_key(const KeyInfo& key_info,
+                                                          const std::vector<uint8_t>& salt) {
+    std::string cache_key = key_info.metadata.key_id;
+    cache_key.push_back('/');
+    cache_key.append(salt.begin(), salt.end());
+
+    auto it = derived_keys_.find(cache_key);
+    if (it != derived_keys_.end()) {
+        return it->second;
+    }
+
+    // Foreign salts (data from older encryptions) could otherwise grow the cache without bound
+    if (derived_keys_.size() >= MAX_DERIVED_KEYS) {
+        derived_keys_.clear();
+    }
+
+    auto derived = derive_encryption_key(key_info.key, salt);
+    derivations_.fetch_add(1, std::memory_order_relaxed);
+    SecureString secure_key(reinterpret_cast<const char*>(derived.data()), derived.size());
+    secure_clear(derived.data(), derived.size());
+
+    return derived_keys_.emplace(std::move(cache_key), std::move(secure_key)).first->second;
+}
+
 void AdvancedCrypto::secure_clear(void* data, size_t length) {
     if (data && length > 0) {
         volatile char* p = static_cast<char*>(data);
@@ -405,23 +439,83 @@ std::string AdvancedCrypto::generate_key_id() const {
 }
 
 // SecureString implementation
-SecureString::SecureString(const std::string& str) : size_(str.size()) {
-    data_ = std::make_unique<char[]>(size_ + 1);
-    std::memcpy(data_.get(), str.c_str(), size_);
+SecureString::SecureString(const std::string& str) : SecureString(str.data(), str.size()) {
+}
+
+SecureString::SecureString(const char* data, size_t size) {
+    if (size == 0) {
+        return;
+    }
+
+    // Whole pages of our own, so munlock() in release() cannot unlock another string's value
+    size_t page = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+    size_t mapped = (size + 1 + page - 1) / page * page;
+    void* memory = mmap(nullptr, mapped, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (memory == MAP_FAILED) {
+        throw std::bad_alloc();
+    }
+#ifdef MADV_DONTDUMP
+    madvise(memory, mapped, MADV_DONTDUMP);
+#endif
+    locked_ = mlock(memory, mapped) == 0;
+
+    data_ = static_cast<char*>(memory);
+    size_ = size;
+    mapped_ = mapped;
+    std::memcpy(data_, data, size_);
     data_[size_] = '\0';
 }
 
 SecureString::~SecureString() {
+    release();
+}
+
+SecureString::SecureString(SecureString&& other) noexcept
+    : data_(other.data_), size_(other.size_), mapped_(other.mapped_), locked_(other.locked_) {
+    other.data_ = nullptr;
+    other.size_ = 0;
+    other.mapped_ = 0;
+    other.locked_ = false;
+}
+
+SecureString& SecureString::operator=(SecureString&& other) noexcept {
+    if (this != &other) {
+        release();
+        data_ = other.data_;
+        size_ = other.size_;
+        mapped_ = other.mapped_;
+        locked_ = other.locked_;
+        other.data_ = nullptr;
+        other.size_ = 0;
+        other.mapped_ = 0;
+        other.locked_ = false;
+    }
+    return *this;
+}
+
+void SecureString::release() noexcept {
     if (data_) {
-        volatile char* p = data_.get();
+        volatile char* p = data_;
         for (size_t i = 0; i < size_; ++i) {
             p[i] = 0;
         }
+        if (locked_) {
+            munlock(data_, mapped_);
+        }
+        munmap(data_, mapped_);
+        data_ = nullptr;
+        size_ = 0;
+        mapped_ = 0;
+        locked_ = false;
     }
 }
 
 std::string SecureString::get() const {
-    return std::string(data_.get(), size_);
+    return std::string(view());
+}
+
+std::string_view SecureString::view() const noexcept {
+    return data_ ? std::string_view(data_, size_) : std::string_view();
 }
 
 bool SecureString::empty() const {
@@ -432,5 +526,9 @@ size_t SecureString::size() const {
     return size_;
 }
 
+bool SecureString::is_locked() const noexcept {
+    return locked_;
+}
+
 } // namespace security
 } // namespace aimux
\ No newline at end of file
@@ -3,19 +3,179 @@
 #include <random>
 #include <sstream>
 #include <iomanip>
-#include <fstream>
 #include <atomic>
+#include <charconv>
 #include <cstring>
+#include <map>
+#include <string_view>
 
 #ifdef __linux__
 #include <sys/sysinfo.h>
 #include <sys/resource.h>
+#include <fcntl.h>
 #include <unistd.h>
 #endif
 
 namespace aimux {
 namespace webui {
 
+namespace {
+constexpr const char* PROVIDER_LATENCY_MEASUREMENT = "provider_latency_ms";
+
+// Message members that change on every broadcast and are not part of deltas
+bool is_envelope_key(const std::string& key) {
+    return key == "timestamp" || key == "seq" || key == "update_type";
+}
+
+// JSON merge patch (RFC 7386) turning @p before into @p after; false when equal.
+// Arrays and scalars are replaced whole. Snapshots hold no nulls, so a null
+// in the patch always means "removed".
+bool merge_diff(const nlohmann::json& before, const nlohmann::json& after, nlohmann::json& patch) {
+    if (!before.is_object() || !after.is_object()) {
+        if (before == after) {
+            return false;
+        }
+        patch = after;
+        return true;
+    }
+
+    patch = nlohmann::json::object();
+    for (const auto& [key, value] : after.items()) {
+        auto previous = before.find(key);
+        if (previous == before.end()) {
+            patch[key] = value;
+            continue;
+        }
+        nlohmann::json child;
+        if (merge_diff(*previous, value, child)) {
+            patch[key] = std::move(child);
+        }
+    }
+    for (const auto& [key, value] : before.items()) {
+        if (!after.contains(key)) {
+            patch[key] = nullptr;
+        }
+    }
+    return !patch.empty();
+}
+
+// Snapshot restricted to the sections and providers of @p subscription
+nlohmann::json filter_snapshot(const nlohmann::json& snapshot, const StreamSubscription& subscription) {
+    nlohmann::json view = nlohmann::json::object();
+    for (const auto& [key, value] : snapshot.items()) {
+        if (!is_envelope_key(key) && !subscription.sections.empty() &&
+            std::find(subscription.sections.begin(), subscription.sections.end(), key) == subscription.sections.end()) {
+            continue;
+        }
+        if (key == "providers" && !subscription.providers.empty()) {
+            nlohmann::json providers = nlohmann::json::object();
+            for (const auto& name : subscription.providers) {
+                if (auto it = value.find(name); it != value.end()) {
+                    providers[name] = *it;
+                }
+            }
+            view[key] = std::move(providers);
+        } else {
+            view[key] = value;
+        }
+    }
+    return view;
+}
+
+// Frames of one broadcast for one subscription key, serialised at most once each
+struct TickFrames {
+    enum class Delta { PENDING, NO_BASE, UNCHANGED, CHANGED };
+
+    nlohmann::json owned_view;                    // Set when the view is filtered
+    const nlohmann::json* view = nullptr;
+    std::shared_ptr<const std::string> keyframe;
+    std::shared_ptr<const std::string> delta;
+    Delta delta_state = Delta::PENDING;
+};
+
+#ifdef __linux__
+// A /proc file kept open and re-read with pread, avoiding a stream and an
+// open/close per sample
+class ProcFile {
+public:
+    explicit ProcFile(const char* path) : fd_(::open(path, O_RDONLY | O_CLOEXEC)) {}
+    ~ProcFile() {
+        if (fd_ >= 0) {
+            ::close(fd_);
+        }
+    }
+
+    ProcFile(const ProcFile&) = delete;
+    ProcFile& operator=(const ProcFile&) = delete;
+
+    std::string_view read() {
+        if (fd_ < 0) {
+            return {};
+        }
+        ssize_t length = ::pread(fd_, buffer_, sizeof(buffer_), 0);
+        return length > 0 ? std::string_view(buffer_, static_cast<size_t>(length)) : std::string_view{};
+    }
+
+private:
+    int fd_;
+    char buffer_[4096];
+};
+
+// Parse the next unsigned integer after @p position, skipping separators
+bool next_number(std::string_view text, size_t& position, uint64_t& value) {
+    while (position < text.size() && (text[position] < '0' || text[position] > '9')) {
+        if (text[position] == '\n') {
+            return false;
+        }
+        position++;
+    }
+    auto result = std::from_chars(text.data() + position, text.data() + text.size(), value);
+    if (result.ec != std::errc()) {
+        return false;
+    }
+    position = static_cast<size_t>(result.ptr - text.data());
+    return true;
+}
+#endif
+}
+
+std::string StreamSubscription::key() const {
+    if (sections.empty() && providers.empty()) {
+        return "";   // Everything; shared with clients that never subscribed
+    }
+    auto join_sorted = [](std::vector<std::string> values) {
+        std::sort(values.begin(), values.end());
+        std::string joined;
+        for (const auto& value : values) {
+            joined += value;
+            joined += ',';
+        }
+        return joined;
+    };
+    return "s=" + join_sorted(sections) + "|p=" + join_sorted(providers);
+}
+
+StreamSubscription StreamSubscription::from_json(const nlohmann::json& j) {
+    StreamSubscription subscription;
+    auto read_names = [&j](const char* key, std::vector<std::string>& names) {
+        auto it = j.find(key);
+        if (it == j.end() || !it->is_array()) {
+            return;
+        }
+        for (const auto& name : *it) {
+            if (name.is_string() &&
+                std::find(names.begin(), names.end(), name.get<std::string>()) == names.end()) {
+                names.push_back(name.get<std::string>());
+            }
+        }
+    };
+    read_names("sections", subscription.sections);
+    read_names("providers", subscription.providers);
+    subscription.delta = j.value("delta", false);
+    subscription.ack = j.value("ack", false);
+    return subscription;
+}
+
 MetricsStreamer& MetricsStreamer::getInstance() {
     static MetricsStreamer instance;
     return instance;
@@ -28,6 +188,22 @@ bool MetricsStreamer::initialize(const MetricsStreamerConfig& config) {
 
     config_ = config;
 
+    // Optional on-disk per-provider history
+    if (!config_.history_store_path.empty()) {
+        metrics::TSDBConfig store_config;
+        store_config.data_directory = config_.history_store_path;
+        store_config.database = "provider_history";
+        store_config.retention = std::chrono::hours(config_.history_store_retention_hours);
+
+        auto store = std::make_shared<metrics::ColumnarTimeSeriesDB>(store_config);
+        if (store->connect()) {
+            std::unique_lock<std::shared_mutex> lock(history_mutex_);
+            history_store_ = std::move(store);
+        } else {
+            std::cerr << "Failed to open metrics history store at " << config_.history_store_path << std::endl;
+        }
+    }
+
     // Initialize system metrics
     system_metrics_.start_time = std::chrono::steady_clock::now();
 
@@ -74,6 +250,12 @@ void MetricsStreamer::shutdown() {
         broadcast_thread_.join();
     }
 
+    // Closing the store writes out buffered history
+    {
+        std::unique_lock<std::shared_mutex> lock(history_mutex_);
+        history_store_.reset();
+    }
+
     // Close all WebSocket connections
     {
         std::shared_lock<std::shared_mutex> lock(connections_mutex_);
@@ -156,6 +338,19 @@ void MetricsStreamer::handle_message(const std::string& connection_id, const std
             auto data = get_comprehensive_metrics();
             send_to_connection(connection_id, data);
 
+            // Deltas must not be applied on top of this out-of-band snapshot
+            std::shared_lock<std::shared_mutex> lock(connections_mutex_);
+            if (auto it = connections_.find(connection_id); it != connections_.end()) {
+                std::lock_guard<std::mutex> state_lock(it->second->state_mutex);
+                it->second->needs_keyframe = true;
+            }
+
+        } else if (type == "subscribe") {
+            handle_subscribe(connection_id, msg);
+
+        } else if (type == "ack") {
+            handle_ack(connection_id, msg);
+
         } else if (type == "auth") {
             handle_connection_request(connection_id, msg);
 
@@ -193,6 +388,27 @@ void MetricsStreamer::update_provider_metrics(const std::string& provider_name,
                                              uint64_t input_tokens,
                                              uint64_t output_tokens,
                                              double cost) {
+    // Taken before providers_mutex_, which update_historical_data() nests inside history_mutex_
+    std::shared_ptr<metrics::ColumnarTimeSeriesDB> store;
+    {
+        std::shared_lock<std::shared_mutex> history_lock(history_mutex_);
+        store = history_store_;
+    }
+    if (store) {
+        metrics::MetricPoint point;
+        point.name = PROVIDER_LATENCY_MEASUREMENT;
+        point.type = metrics::MetricType::TIMER;
+        point.value = response_time_ms;
+        point.timestamp = std::chrono::system_clock::now();
+        point.tags = {{"provider", provider_name}};
+        point.fields = {
+            {"success", success ? 1.0 : 0.0},
+            {"tokens", static_cast<double>(input_tokens + output_tokens)},
+            {"cost", cost}
+        };
+        store->write_metrics_async({point});
+    }
+
     std::unique_lock<std::shared_mutex> lock(providers_mutex_);
 
     ProviderMetrics& metrics = provider_metrics_[provider_name];
@@ -302,6 +518,62 @@ HistoricalData MetricsStreamer::get_historical_data() const {
     return historical_data_;
 }
 
+bool MetricsStreamer::has_history_store() const {
+    std::shared_lock<std::shared_mutex> lock(history_mutex_);
+    return history_store_ != nullptr;
+}
+
+nlohmann::json MetricsStreamer::query_history(const std::string& provider,
+                                              std::chrono::minutes span,
+                                              std::chrono::seconds step) const {
+    nlohmann::json result;
+    result["minutes"] = span.count();
+    result["step_seconds"] = step.count();
+    result["points"] = nlohmann::json::array();
+
+    std::shared_ptr<metrics::ColumnarTimeSeriesDB> store;
+    {
+        std::shared_lock<std::shared_mutex> lock(history_mutex_);
+        store = history_store_;
+    }
+    if (!store || span.count() <= 0 || step.count() <= 0) {
+        return result;
+    }
+
+    auto now = std::chrono::system_clock::now();
+    metrics::TSDBQueryBuilder query(PROVIDER_LATENCY_MEASUREMENT);
+    query.time_range(now - span, now).fields({"value", "success"}).group_by({"provider"});
+    if (!provider.empty()) {
+        query.tag("provider", provider);
+    }
+
+    // Latency and success come back as separate columns; join them per window and provider
+    std::map<std::pair<int64_t, std::string>, nlohmann::json> rows;
+    for (const auto& window : store->query_windows(query, step)) {
+        auto start_ms = std::chrono::duration_cast<std::chrono::milliseconds>(
+            window.start.time_since_epoch()).count();
+        const std::string& name = window.group.at("provider");
+
+        nlohmann::json& row = rows[{start_ms, name}];
+        row["timestamp"] = start_ms;
+        row["provider"] = name;
+        if (window.stats.name == PROVIDER_LATENCY_MEASUREMENT) {
+            row["requests"] = static_cast<uint64_t>(window.stats.count);
+            row["avg_response_time_ms"] = window.stats.mean;
+            row["min_response_time_ms"] = window.stats.min;
+            row["max_response_time_ms"] = window.stats.max;
+        } else {
+            row["success_rate"] = window.stats.mean * 100.0;
+        }
+    }
+
+    for (auto& [key, row] : rows) {
+        result["points"].push_back(std::move(row));
+    }
+    result["query_time_ms"] = store->get_query_performance_ms();
+    return result;
+}
+
 MetricsStreamer::PerformanceStats MetricsStreamer::get_performance_stats() const {
     std::lock_guard<std::mutex> lock(performance_mutex_);
     return performance_stats_;
@@ -394,6 +666,7 @@ void MetricsStreamer::websocket_broadcast_loop() {
 
     auto broadcast_interval = std::chrono::milliseconds(config_.broadcast_interval_ms);
     auto last_broadcast = std::chrono::steady_clock::now();
+    uint64_t sequence_num = 0;
 
     while (running_.load()) {
         try {
@@ -403,9 +676,7 @@ void MetricsStreamer::websocket_broadcast_loop() {
             cleanup_stale_connections();
 
             // Broadcast to all connected clients
-            uint64_t sequence_num = performance_stats_.total_broadcasts;
-            auto data = create_comprehensive_message(sequence_num);
-            broadcast_to_all_connections(data);
+            broadcast_to_all_connections(++sequence_num);
 
             // Update performance statistics
             auto end_time = std::chrono::steady_clock::now();
@@ -473,31 +744,114 @@ void MetricsStreamer::update_system_metrics() {
     system_metrics_.requests_per_second = total_rps;
 }
 
-void MetricsStreamer::broadcast_to_all_connections(const nlohmann::json& data) {
+void MetricsStreamer::broadcast_to_all_connections(uint64_t sequence_num) {
     std::shared_lock<std::shared_mutex> lock(connections_mutex_);
-    std::string data_str = data.dump();
+    if (connections_.empty()) {
+        last_views_.clear();
+        return;   // Nothing is built or serialised without an audience
+    }
 
-    for (const auto& [id, conn] : connections_) {
-        if (conn && conn->connection) {
-            try {
-                conn->connection->send_text(data_str);
-                conn->messages_sent++;
+    const nlohmann::json snapshot = create_comprehensive_message(sequence_num);
+    const bool keyframe_due = config_.keyframe_interval <= 1 || sequence_num % config_.keyframe_interval == 0;
+    const size_t max_unacked = std::max<uint32_t>(config_.max_unacked_frames, 1);
+
+    std::unordered_map<std::string, TickFrames> frames;
+    std::unordered_map<std::string, BroadcastView> next_views;
+    uint64_t serialized = 0, sent = 0, dropped = 0, deltas = 0, bytes = 0;
+
+    auto frames_for = [&](const StreamSubscription& subscription, const std::string& key) -> TickFrames& {
+        auto [it, inserted] = frames.try_emplace(key);
+        TickFrames& tick = it->second;
+        if (inserted) {
+            if (key.empty()) {
+                tick.view = &snapshot;
+            } else {
+                tick.owned_view = filter_snapshot(snapshot, subscription);
+                tick.view = &tick.owned_view;
+            }
+            tick.keyframe = std::make_shared<const std::string>(tick.view->dump());
+            serialized++;
+        }
+        return tick;
+    };
 
-                {
-                    std::lock_guard<std::mutex> perf_lock(performance_mutex_);
-                    performance_stats_.messages_sent++;
-                }
+    // Diffs against the previous broadcast once per key and keeps this one as the next base
+    auto prepare_delta = [&](TickFrames& tick, const std::string& key) {
+        if (tick.delta_state != TickFrames::Delta::PENDING) {
+            return;
+        }
+        tick.delta_state = TickFrames::Delta::NO_BASE;
+        auto previous = last_views_.find(key);
+        if (previous != last_views_.end() && previous->second.seq + 1 == sequence_num) {
+            nlohmann::json delta = create_delta_message(previous->second.data, *tick.view);
+            if (delta["changes"].empty()) {
+                tick.delta_state = TickFrames::Delta::UNCHANGED;
+            } else {
+                tick.delta = std::make_shared<const std::string>(delta.dump());
+                tick.delta_state = TickFrames::Delta::CHANGED;
+                serialized++;
+            }
+        }
+        next_views[key] = BroadcastView{sequence_num, *tick.view};
+    };
 
-            } catch (const std::exception& e) {
-                std::cerr << "Failed to send data to connection " << id << ": " << e.what() << std::endl;
+    for (const auto& [id, conn] : connections_) {
+        if (!conn || !conn->connection) {
+            continue;
+        }
+        std::lock_guard<std::mutex> state_lock(conn->state_mutex);
+        TickFrames& tick = frames_for(conn->subscription, conn->subscription_key);
+        std::shared_ptr<const std::string> payload = tick.keyframe;
+        bool is_delta = false;
+
+        if (conn->subscription.delta && config_.enable_delta_compression) {
+            prepare_delta(tick, conn->subscription_key);
+            bool in_sync = !conn->needs_keyframe && !keyframe_due && conn->last_frame_seq + 1 == sequence_num;
+            if (in_sync && tick.delta_state == TickFrames::Delta::UNCHANGED) {
+                conn->last_frame_seq = sequence_num;   // Nothing to say; the client is still current
+                continue;
+            }
+            if (in_sync && tick.delta_state == TickFrames::Delta::CHANGED) {
+                payload = tick.delta;
+                is_delta = true;
+            }
+        }
 
-                {
-                    std::lock_guard<std::mutex> perf_lock(performance_mutex_);
-                    performance_stats_.messages_dropped++;
-                }
+        // A client that stopped acking is not fed further; it resumes with a keyframe
+        if (conn->subscription.ack && conn->unacked_frames.size() >= max_unacked) {
+            conn->needs_keyframe = true;
+            dropped++;
+            continue;
+        }
+
+        try {
+            conn->connection->send_text(*payload);
+            conn->messages_sent++;
+            conn->last_frame_seq = sequence_num;
+            conn->needs_keyframe = false;
+            if (conn->subscription.ack) {
+                conn->unacked_frames.push_back(sequence_num);
+            }
+            sent++;
+            bytes += payload->size();
+            if (is_delta) {
+                deltas++;
             }
+        } catch (const std::exception& e) {
+            std::cerr << "Failed to send data to connection " << id << ": " << e.what() << std::endl;
+            conn->needs_keyframe = true;
+            dropped++;
         }
     }
+
+    last_views_ = std::move(next_views);
+
+    std::lock_guard<std::mutex> perf_lock(performance_mutex_);
+    performance_stats_.frames_serialized += serialized;
+    performance_stats_.messages_sent += sent;
+    performance_stats_.messages_dropped += dropped;
+    performance_stats_.delta_frames_sent += deltas;
+    performance_stats_.bytes_sent += bytes;
 }
 
 void MetricsStreamer::send_to_connection(const std::string& connection_id, const nlohmann::json& data) {
@@ -506,7 +860,9 @@ void MetricsStreamer::send_to_connection(const std::string& connection_id, const
 
     if (it != connections_.end() && it->second && it->second->connection) {
         try {
-            it->second->connection->send_text(data.dump());
+            std::string payload = data.dump();
+            std::lock_guard<std::mutex> state_lock(it->second->state_mutex);
+            it->second->connection->send_text(std::move(payload));
             it->second->messages_sent++;
 
             {
@@ -595,6 +951,38 @@ void MetricsStreamer::update_historical_data() {
     historical_data_.add_memory_usage(memory_usage);
 }
 
+nlohmann::json MetricsStreamer::create_delta_message(const nlohmann::json& previous_data,
+                                                     const nlohmann::json& current_data) const {
+    nlohmann::json changes = nlohmann::json::object();
+    for (const auto& [key, value] : current_data.items()) {
+        if (is_envelope_key(key)) {
+            continue;
+        }
+        auto previous = previous_data.find(key);
+        if (previous == previous_data.end()) {
+            changes[key] = value;
+            continue;
+        }
+        nlohmann::json patch;
+        if (merge_diff(*previous, value, patch)) {
+            changes[key] = std::move(patch);
+        }
+    }
+    for (const auto& [key, value] : previous_data.items()) {
+        if (!is_envelope_key(key) && !current_data.contains(key)) {
+            changes[key] = nullptr;
+        }
+    }
+
+    return {
+        {"update_type", "metrics_delta"},
+        {"timestamp", current_data.value("timestamp", uint64_t{0})},
+        {"seq", current_data.value("seq", uint64_t{0})},
+        {"base_seq", previous_data.value("seq", uint64_t{0})},
+        {"changes", std::move(changes)}
+    };
+}
+
 nlohmann::json MetricsStreamer::create_comprehensive_message(uint64_t sequence_num) const {
     nlohmann::json message;
     message["timestamp"] = get_current_timestamp();
@@ -699,6 +1087,48 @@ void MetricsStreamer::handle_ping_pong(const std::string& connection_id, const n
     send_to_connection(connection_id, pong);
 }
 
+void MetricsStreamer::handle_subscribe(const std::string& connection_id, const nlohmann::json& message) {
+    StreamSubscription subscription = StreamSubscription::from_json(message);
+    {
+        std::shared_lock<std::shared_mutex> lock(connections_mutex_);
+        auto it = connections_.find(connection_id);
+        if (it == connections_.end()) {
+            return;
+        }
+        std::lock_guard<std::mutex> state_lock(it->second->state_mutex);
+        it->second->subscription = subscription;
+        it->second->subscription_key = subscription.key();
+        it->second->needs_keyframe = true;
+        it->second->unacked_frames.clear();
+    }
+
+    nlohmann::json response = {
+        {"type", "subscribed"},
+        {"sections", subscription.sections},
+        {"providers", subscription.providers},
+        {"delta", subscription.delta && config_.enable_delta_compression},
+        {"ack", subscription.ack},
+        {"keyframe_interval", config_.keyframe_interval},
+        {"timestamp", get_current_timestamp()}
+    };
+    send_to_connection(connection_id, response);
+}
+
+void MetricsStreamer::handle_ack(const std::string& connection_id, const nlohmann::json& message) {
+    uint64_t seq = message.value("seq", uint64_t{0});
+
+    std::shared_lock<std::shared_mutex> lock(connections_mutex_);
+    auto it = connections_.find(connection_id);
+    if (it == connections_.end()) {
+        return;
+    }
+    std::lock_guard<std::mutex> state_lock(it->second->state_mutex);
+    auto& unacked = it->second->unacked_frames;
+    while (!unacked.empty() && unacked.front() <= seq) {
+        unacked.pop_front();
+    }
+}
+
 bool MetricsStreamer::authenticate_connection(const std::string& /* connection_id */, const std::string& auth_token) const {
     if (!config_.enable_authentication) {
         return true;
@@ -713,30 +1143,33 @@ uint64_t MetricsStreamer::get_current_timestamp() const {
 
 double MetricsStreamer::calculate_cpu_usage() const {
 #ifdef __linux__
+    // Only the metrics collection thread samples, so plain statics suffice
+    static ProcFile stat_file("/proc/stat");
     static uint64_t last_idle = 0, last_total = 0;
 
-    std::ifstream file("/proc/stat");
-    if (!file.is_open()) {
-        return 0.0;
+    // First line: "cpu  user nice system idle iowait irq softirq steal ..."
+    std::string_view text = stat_file.read();
+    size_t position = 0;
+    uint64_t fields[8];
+    bool parsed = text.starts_with("cpu ");
+    for (size_t i = 0; parsed && i < 8; ++i) {
+        parsed = next_number(text, position, fields[i]);
     }
 
-    std::string line;
-    if (std::getline(file, line)) {
-        std::istringstream iss(line);
-        std::string cpu_label;
-        uint64_t user, nice, system, idle, iowait, irq, softirq, steal;
-
-        if (iss >> cpu_label >> user >> nice >> system >> idle >> iowait >> irq >> softirq >> steal) {
-            uint64_t total = user + nice + system + idle + iowait + irq + softirq + steal;
-            uint64_t diff_idle = idle - last_idle;
-            uint64_t diff_total = total - last_total;
-
-            if (diff_total > 0) {
-                double usage = 100.0 * (1.0 - static_cast<double>(diff_idle) / diff_total);
-                last_idle = idle;
-                last_total = total;
-                return usage;
-            }
+    if (parsed) {
+        uint64_t idle = fields[3];
+        uint64_t total = 0;
+        for (uint64_t field : fields) {
+            total += field;
+        }
+        uint64_t diff_idle = idle - last_idle;
+        uint64_t diff_total = total - last_total;
+
+        if (diff_total > 0) {
+            double usage = 100.0 * (1.0 - static_cast<double>(diff_idle) / diff_total);
+            last_idle = idle;
+            last_total = total;
+            return usage;
         }
     }
 #endif
@@ -750,18 +1183,15 @@ double MetricsStreamer::calculate_cpu_usage() const {
 
 uint64_t MetricsStreamer::get_memory_usage() const {
 #ifdef __linux__
-    std::ifstream file("/proc/self/status");
-    if (file.is_open()) {
-        std::string line;
-        while (std::getline(file, line)) {
-            if (line.substr(0, 6) == "VmRSS:") {
-                std::istringstream iss(line);
-                std::string label, value, unit;
-                if (iss >> label >> value >> unit) {
-                    return std::stoull(value) / 1024; // Convert KB to MB
-                }
-            }
-        }
+    // "size resident shared ..." in pages; resident matches VmRSS
+    static ProcFile statm_file("/proc/self/statm");
+    static const uint64_t page_size = static_cast<uint64_t>(::sysconf(_SC_PAGESIZE));
+
+    std::string_view text = statm_file.read();
+    size_t position = 0;
+    uint64_t size_pages = 0, resident_pages = 0;
+    if (next_number(text, position, size_pages) && next_number(text, position, resident_pages)) {
+        return resident_pages * page_size / (1024 * 1024);
     }
 #endif
 
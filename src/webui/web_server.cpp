@@ -2,6 +2,7 @@
 #include <sstream>
 #include <iostream>
 #include <algorithm>
+#include <cstdlib>
 
 #include "aimux/webui/web_server.hpp"
 #include "aimux/webui/metrics_streamer.hpp"
@@ -67,6 +68,8 @@ WebServer::WebServer(const aimux::config::WebUIConfig& config)
     metrics_config.enable_authentication = config.enable_websocket_auth;
     metrics_config.auth_token = config.websocket_auth_token;
     metrics_config.history_retention_minutes = config.history_retention_minutes > 0 ? config.history_retention_minutes : 60;
+    metrics_config.history_store_path = config.history_store_path;
+    metrics_config.history_store_retention_hours = config.history_store_retention_hours > 0 ? config.history_store_retention_hours : 168;
     if (!MetricsStreamer::getInstance().initialize(metrics_config)) {
         std::cerr << "Failed to initialize MetricsStreamer" << std::endl;
     }
@@ -269,10 +272,23 @@ void WebServer::setup_routes() {
     });
 
     // Historical data endpoint
-    CROW_ROUTE(app, "/metrics/history")([this]() {
+    CROW_ROUTE(app, "/metrics/history")([this](const crow::request& req) {
         try {
-            auto history = MetricsStreamer::getInstance().get_historical_data();
-            crow::response response(200, history.to_json().dump());
+            auto& streamer = MetricsStreamer::getInstance();
+            nlohmann::json history = streamer.get_historical_data().to_json();
+
+            // Persisted per-provider history: ?provider=&minutes=&step_seconds=
+            if (streamer.has_history_store()) {
+                const char* provider = req.url_params.get("provider");
+                const char* minutes = req.url_params.get("minutes");
+                const char* step = req.url_params.get("step_seconds");
+                history["providers"] = streamer.query_history(
+                    provider ? provider : "",
+                    std::chrono::minutes(minutes ? std::max(1, std::atoi(minutes)) : 60),
+                    std::chrono::seconds(step ? std::max(1, std::atoi(step)) : 60));
+            }
+
+            crow::response response(200, history.dump());
             response.add_header("Content-Type", "application/json");
             response.add_header("Access-Control-Allow-Origin", "*");
             return response;
@@ -0,0 +1,320 @@
+#include <gtest/gtest.h>
+#include "aimux/gateway/admission_control.hpp"
+#include "aimux/core/rate_limiter.hpp"
+#include <atomic>
+#include <chrono>
+#include <future>
+#include <thread>
+#include <vector>
+
+using namespace aimux;
+using namespace aimux::gateway;
+using namespace std::chrono_literals;
+
+namespace {
+
+AdmissionLimits concurrency_limits(int max_concurrent, int max_queue_depth, std::chrono::milliseconds max_wait) {
+    AdmissionLimits limits;
+    limits.max_concurrent_requests_ = max_concurrent;
+    limits.max_queue_depth_ = max_queue_depth;
+    limits.max_queue_wait_ = max_wait;
+    return limits;
+}
+
+} // namespace
+
+TEST(RateLimiterTest, AllowsBurstThenRejectsWithRetryAfter) {
+    core::RateLimiter limiter(60, 3);   // One per second, three back to back
+
+    for (int i = 0; i < 3; ++i) {
+        EXPECT_TRUE(limiter.try_acquire()) << i;
+    }
+
+    std::chrono::milliseconds retry_after{0};
+    EXPECT_FALSE(limiter.try_acquire(&retry_after));
+    EXPECT_GT(retry_after, 0ms);
+    EXPECT_LE(retry_after, 1000ms);
+
+    auto state = limiter.state();
+    EXPECT_EQ(state.limit, 60);
+    EXPECT_EQ(state.burst, 3);
+    EXPECT_EQ(state.remaining, 0);
+}
+
+TEST(RateLimiterTest, ZeroLimitIsUnlimited) {
+    core::RateLimiter limiter(0);
+    for (int i = 0; i < 10000; ++i) {
+        ASSERT_TRUE(limiter.try_acquire());
+    }
+
+    limiter.configure(60, 1);
+    EXPECT_TRUE(limiter.try_acquire());
+    EXPECT_FALSE(limiter.try_acquire());
+}
+
+TEST(RateLimiterTest, ConcurrentCallersNeverExceedBurst) {
+    core::RateLimiter limiter(1, 100);   // Refills far too slowly to matter here
+    std::atomic<int> granted{0};
+
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 8; ++t) {
+        threads.emplace_back([&] {
+            for (int i = 0; i < 100; ++i) {
+                if (limiter.try_acquire()) {
+                    granted++;
+                }
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    EXPECT_EQ(granted.load(), 100);
+}
+
+TEST(RateLimiterTest, SharedLimiterIsOnePerKey) {
+    auto first = core::RateLimiter::shared("provider/key-a", 60);
+    auto second = core::RateLimiter::shared("provider/key-a", 120);
+    auto other = core::RateLimiter::shared("provider/key-b", 60);
+
+    EXPECT_EQ(first.get(), second.get());
+    EXPECT_NE(first.get(), other.get());
+    EXPECT_EQ(first->state().limit, 120);   // Last configuration wins
+}
+
+TEST(AdmissionControllerTest, UnconfiguredProvidersAreAlwaysAdmitted) {
+    AdmissionController controller;
+    for (int i = 0; i < 100; ++i) {
+        ASSERT_TRUE(controller.admit("anything").admitted());
+    }
+}
+
+TEST(AdmissionControllerTest, RateLimitRejectsWithoutTakingASlot) {
+    AdmissionController controller;
+    AdmissionLimits limits = concurrency_limits(1, 0, 0ms);
+    limits.max_requests_per_minute_ = 60;
+    limits.burst_ = 1;
+    controller.configure("alpha", limits);
+
+    AdmissionTicket first = controller.admit("alpha");
+    ASSERT_TRUE(first.admitted());
+
+    AdmissionTicket second = controller.admit("alpha");
+    EXPECT_EQ(second.result(), AdmissionResult::RATE_LIMITED);
+    EXPECT_GT(second.retry_after(), 0ms);
+
+    auto metrics = controller.to_json()["alpha"];
+    EXPECT_EQ(metrics["in_flight"], 1);
+    EXPECT_EQ(metrics["rejected_rate_limited"], 1);
+    EXPECT_EQ(metrics["rejected_saturated"], 0);
+}
+
+TEST(AdmissionControllerTest, QueuedRequestTakesReleasedSlot) {
+    AdmissionController controller;
+    controller.configure("alpha", concurrency_limits(1, 4, 2000ms));
+
+    auto holder = std::make_unique<AdmissionTicket>(controller.admit("alpha"));
+    ASSERT_TRUE(holder->admitted());
+
+    std::thread releaser([&] {
+        std::this_thread::sleep_for(30ms);
+        holder.reset();
+    });
+
+    auto start = std::chrono::steady_clock::now();
+    AdmissionTicket queued = controller.admit("alpha");
+    auto waited = std::chrono::steady_clock::now() - start;
+    releaser.join();
+
+    EXPECT_TRUE(queued.admitted());
+    EXPECT_LT(waited, 1000ms);
+
+    auto metrics = controller.to_json()["alpha"];
+    EXPECT_EQ(metrics["in_flight"], 1);
+    EXPECT_EQ(metrics["queued"], 1);
+    EXPECT_EQ(metrics["admitted"], 2);
+    EXPECT_EQ(metrics["queue_wait_ms"]["count"], 1);
+}
+
+TEST(AdmissionControllerTest, SaturatedWhenQueueFullOrWaitExpires) {
+    AdmissionController controller;
+    controller.configure("alpha", concurrency_limits(1, 0, 50ms));
+
+    AdmissionTicket holder = controller.admit("alpha");
+    ASSERT_TRUE(holder.admitted());
+
+    // No queue at all: rejected without waiting
+    auto start = std::chrono::steady_clock::now();
+    EXPECT_EQ(controller.admit("alpha").result(), AdmissionResult::SATURATED);
+    EXPECT_LT(std::chrono::steady_clock::now() - start, 40ms);
+
+    // Room to queue, but the slot never frees up
+    controller.configure("alpha", concurrency_limits(1, 1, 50ms));
+    start = std::chrono::steady_clock::now();
+    EXPECT_EQ(controller.admit("alpha").result(), AdmissionResult::SATURATED);
+    EXPECT_GE(std::chrono::steady_clock::now() - start, 45ms);
+
+    auto metrics = controller.to_json()["alpha"];
+    EXPECT_EQ(metrics["rejected_saturated"], 2);
+    EXPECT_EQ(metrics["queue_depth"], 0);
+    EXPECT_EQ(metrics["in_flight"], 1);
+}
+
+TEST(AdmissionControllerTest, ConcurrencyLimitHoldsUnderContention) {
+    AdmissionController controller;
+    controller.configure("alpha", concurrency_limits(3, 64, 5000ms));
+
+    std::atomic<int> active{0};
+    std::atomic<int> peak{0};
+    std::atomic<int> admitted{0};
+
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 12; ++t) {
+        threads.emplace_back([&] {
+            for (int i = 0; i < 20; ++i) {
+                AdmissionTicket ticket = controller.admit("alpha");
+                if (!ticket.admitted()) {
+                    continue;
+                }
+                admitted++;
+                int now = ++active;
+                int seen = peak.load();
+                while (now > seen && !peak.compare_exchange_weak(seen, now)) {}
+                std::this_thread::sleep_for(100us);
+                --active;
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    EXPECT_LE(peak.load(), 3);
+    EXPECT_EQ(admitted.load(), 240);
+    EXPECT_EQ(controller.to_json()["alpha"]["in_flight"], 0);
+}
+
+TEST(AdmissionControllerTest, SaturatedRequestsGiveTheirRateTokenBack) {
+    AdmissionController controller;
+    AdmissionLimits limits = concurrency_limits(1, 1, 20ms);
+    limits.max_requests_per_minute_ = 60;
+    limits.burst_ = 2;
+    controller.configure("alpha", limits);
+
+    auto holder = std::make_unique<AdmissionTicket>(controller.admit("alpha"));
+    ASSERT_TRUE(holder->admitted());
+
+    // Neither the immediate rejection nor the timed-out wait reaches the provider
+    EXPECT_EQ(controller.try_admit("alpha").result(), AdmissionResult::SATURATED);
+    EXPECT_EQ(controller.admit("alpha").result(), AdmissionResult::SATURATED);
+    EXPECT_EQ(controller.to_json()["alpha"]["rate_limit"]["remaining"], 1);
+
+    holder.reset();
+    EXPECT_TRUE(controller.admit("alpha").admitted());
+    EXPECT_EQ(controller.to_json()["alpha"]["rejected_rate_limited"], 0);
+}
+
+TEST(AdmissionControllerTest, TryAdmitNeverWaitsForASlot) {
+    AdmissionController controller;
+    controller.configure("alpha", concurrency_limits(1, 8, 2000ms));
+
+    AdmissionTicket holder = controller.try_admit("alpha");
+    ASSERT_TRUE(holder.admitted());
+
+    auto start = std::chrono::steady_clock::now();
+    EXPECT_EQ(controller.try_admit("alpha").result(), AdmissionResult::SATURATED);
+    EXPECT_LT(std::chrono::steady_clock::now() - start, 100ms);
+
+    auto metrics = controller.to_json()["alpha"];
+    EXPECT_EQ(metrics["queued"], 0);
+    EXPECT_EQ(metrics["queue_depth"], 0);
+    EXPECT_EQ(metrics["rejected_saturated"], 1);
+}
+
+TEST(AdmissionControllerTest, AdmitAsyncParksUntilASlotIsReleased) {
+    AdmissionController controller;
+    controller.configure("alpha", concurrency_limits(1, 4, 2000ms));
+
+    auto holder = std::make_unique<AdmissionTicket>(controller.try_admit("alpha"));
+    ASSERT_TRUE(holder->admitted());
+
+    std::promise<AdmissionTicket> resumed;
+    std::atomic<bool> called{false};
+    controller.admit_async("alpha", [&](AdmissionTicket ticket) {
+        called = true;
+        resumed.set_value(std::move(ticket));
+    });
+
+    // Parked, not rejected, and the caller was not held up
+    EXPECT_FALSE(called.load());
+    EXPECT_EQ(controller.to_json()["alpha"]["queue_depth"], 1);
+
+    holder.reset();
+    auto future = resumed.get_future();
+    ASSERT_EQ(future.wait_for(1000ms), std::future_status::ready);
+    EXPECT_TRUE(future.get().admitted());
+
+    auto metrics = controller.to_json()["alpha"];
+    EXPECT_EQ(metrics["in_flight"], 0);
+    EXPECT_EQ(metrics["queue_depth"], 0);
+    EXPECT_EQ(metrics["queued"], 1);
+    EXPECT_EQ(metrics["admitted"], 2);
+    EXPECT_EQ(metrics["queue_wait_ms"]["count"], 1);
+}
+
+TEST(AdmissionControllerTest, AdmitAsyncExpiresParkedRequestsAndBoundsTheQueue) {
+    AdmissionController controller;
+    AdmissionLimits limits = concurrency_limits(1, 1, 50ms);
+    limits.max_requests_per_minute_ = 60;
+    limits.burst_ = 3;
+    controller.configure("alpha", limits);
+
+    AdmissionTicket holder = controller.try_admit("alpha");
+    ASSERT_TRUE(holder.admitted());
+
+    auto start = std::chrono::steady_clock::now();
+    std::promise<AdmissionTicket> expired;
+    controller.admit_async("alpha", [&](AdmissionTicket ticket) { expired.set_value(std::move(ticket)); });
+
+    // The queue holds one: the next request is turned away before admit_async() returns
+    AdmissionResult overflow = AdmissionResult::ADMITTED;
+    controller.admit_async("alpha", [&](AdmissionTicket ticket) { overflow = ticket.result(); });
+    EXPECT_EQ(overflow, AdmissionResult::SATURATED);
+
+    auto future = expired.get_future();
+    ASSERT_EQ(future.wait_for(1000ms), std::future_status::ready);
+    EXPECT_EQ(future.get().result(), AdmissionResult::SATURATED);
+    EXPECT_GE(std::chrono::steady_clock::now() - start, 45ms);
+
+    auto metrics = controller.to_json()["alpha"];
+    EXPECT_EQ(metrics["rejected_saturated"], 2);
+    EXPECT_EQ(metrics["queue_depth"], 0);
+    EXPECT_EQ(metrics["in_flight"], 1);
+    EXPECT_EQ(metrics["queue_wait_ms"]["count"], 1);
+    EXPECT_EQ(metrics["rate_limit"]["remaining"], 2);
+}
+
+TEST(AdmissionControllerTest, RemovedProviderIsUnlimited) {
+    AdmissionController controller;
+    controller.configure("alpha", concurrency_limits(1, 0, 0ms));
+    AdmissionTicket holder = controller.admit("alpha");
+    ASSERT_EQ(controller.admit("alpha").result(), AdmissionResult::SATURATED);
+
+    controller.remove("alpha");
+    EXPECT_TRUE(controller.admit("alpha").admitted());
+    EXPECT_FALSE(controller.to_json().contains("alpha"));
+}
+
+TEST(AdmissionLimitsTest, JsonRoundTrip) {
+    AdmissionLimits limits = concurrency_limits(7, 3, 125ms);
+    limits.max_requests_per_minute_ = 600;
+    limits.burst_ = 20;
+
+    AdmissionLimits round_trip = AdmissionLimits::from_json(limits.to_json());
+    EXPECT_EQ(round_trip.max_requests_per_minute_, 600);
+    EXPECT_EQ(round_trip.burst_, 20);
+    EXPECT_EQ(round_trip.max_concurrent_requests_, 7);
+    EXPECT_EQ(round_trip.max_queue_depth_, 3);
+    EXPECT_EQ(round_trip.max_queue_wait_, 125ms);
+}
@@ -0,0 +1,233 @@
+#include <gtest/gtest.h>
+#include "aimux/gateway/async_request_pipeline.hpp"
+#include <atomic>
+#include <chrono>
+#include <future>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+using namespace aimux;
+using namespace aimux::gateway;
+using namespace std::chrono_literals;
+
+namespace {
+
+core::Response ok_response(const std::string& data) {
+    core::Response response;
+    response.success = true;
+    response.status_code = 200;
+    response.data = data;
+    return response;
+}
+
+// Dispatcher that parks every request until the test completes it, like a slow upstream
+class ParkedDispatcher {
+public:
+    AsyncRequestPipeline::Dispatcher dispatcher() {
+        return [this](const core::Request& request, AsyncRequestPipeline::Completion done) {
+            std::lock_guard<std::mutex> lock(mutex_);
+            parked_.push_back({request.model, std::move(done)});
+            parked_cv_.notify_all();
+        };
+    }
+
+    bool wait_for(size_t count, std::chrono::milliseconds timeout = 2000ms) {
+        std::unique_lock<std::mutex> lock(mutex_);
+        return parked_cv_.wait_for(lock, timeout, [&] { return parked_.size() >= count; });
+    }
+
+    size_t parked() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return parked_.size();
+    }
+
+    /// Complete everything parked so far from a separate thread
+    void release_all() {
+        std::vector<std::pair<std::string, AsyncRequestPipeline::Completion>> parked;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            parked.swap(parked_);
+        }
+        std::thread([parked = std::move(parked)]() {
+            for (const auto& [model, done] : parked) {
+                done(ok_response(model));
+            }
+        }).join();
+    }
+
+private:
+    std::mutex mutex_;
+    std::condition_variable parked_cv_;
+    std::vector<std::pair<std::string, AsyncRequestPipeline::Completion>> parked_;
+};
+
+core::Request make_request(const std::string& model) {
+    core::Request request;
+    request.model = model;
+    request.method = "POST";
+    return request;
+}
+
+AsyncPipelineConfig limits(int max_concurrent, int max_queue_depth, std::chrono::milliseconds max_wait = 5000ms) {
+    AsyncPipelineConfig config;
+    config.worker_threads_ = 2;
+    config.max_concurrent_requests_ = max_concurrent;
+    config.max_queue_depth_ = max_queue_depth;
+    config.max_queue_wait_ = max_wait;
+    return config;
+}
+
+} // namespace
+
+TEST(AsyncRequestPipelineTest, HoldsManySlowRequestsOnFewThreads) {
+    ParkedDispatcher upstream;
+    AsyncRequestPipeline pipeline(upstream.dispatcher(), limits(2000, 2000));
+
+    constexpr int REQUESTS = 1000;
+    std::atomic<int> completed{0};
+    for (int i = 0; i < REQUESTS; ++i) {
+        ASSERT_TRUE(pipeline.submit(make_request("m" + std::to_string(i)), [&](core::Response response) {
+            EXPECT_TRUE(response.success);
+            completed++;
+        }));
+    }
+
+    // All of them are outstanding at once with only two workers
+    ASSERT_TRUE(upstream.wait_for(REQUESTS));
+    EXPECT_EQ(pipeline.in_flight(), REQUESTS);
+    EXPECT_EQ(completed.load(), 0);
+
+    upstream.release_all();
+    EXPECT_EQ(completed.load(), REQUESTS);
+    EXPECT_EQ(pipeline.in_flight(), 0);
+
+    auto metrics = pipeline.to_json();
+    EXPECT_EQ(metrics["workers"], 2);
+    EXPECT_EQ(metrics["peak_in_flight"], REQUESTS);
+    EXPECT_EQ(metrics["completed"], REQUESTS);
+}
+
+TEST(AsyncRequestPipelineTest, QueuesBeyondConcurrencyLimit) {
+    ParkedDispatcher upstream;
+    AsyncRequestPipeline pipeline(upstream.dispatcher(), limits(2, 10));
+
+    std::atomic<int> completed{0};
+    for (int i = 0; i < 5; ++i) {
+        ASSERT_TRUE(pipeline.submit(make_request("m"), [&](core::Response) { completed++; }));
+    }
+
+    ASSERT_TRUE(upstream.wait_for(2));
+    std::this_thread::sleep_for(20ms);
+    EXPECT_EQ(upstream.parked(), 2u);
+    EXPECT_EQ(pipeline.in_flight(), 2);
+    EXPECT_EQ(pipeline.queue_depth(), 3u);
+
+    // Completions free slots for the queued requests
+    upstream.release_all();
+    ASSERT_TRUE(upstream.wait_for(2));
+    upstream.release_all();
+    ASSERT_TRUE(upstream.wait_for(1));
+    upstream.release_all();
+
+    EXPECT_EQ(completed.load(), 5);
+    EXPECT_EQ(pipeline.queue_depth(), 0u);
+}
+
+TEST(AsyncRequestPipelineTest, ShedsWhenQueueIsFull) {
+    ParkedDispatcher upstream;
+    AsyncRequestPipeline pipeline(upstream.dispatcher(), limits(1, 2));
+
+    ASSERT_TRUE(pipeline.submit(make_request("a"), [](core::Response) {}));
+    ASSERT_TRUE(upstream.wait_for(1));
+    EXPECT_TRUE(pipeline.submit(make_request("b"), [](core::Response) {}));
+    EXPECT_TRUE(pipeline.submit(make_request("c"), [](core::Response) {}));
+
+    bool called = false;
+    EXPECT_FALSE(pipeline.submit(make_request("d"), [&](core::Response) { called = true; }));
+    EXPECT_FALSE(called);
+    EXPECT_EQ(pipeline.to_json()["shed"], 1);
+
+    std::atomic<bool> stopped{false};
+    std::thread releaser([&] {
+        while (!stopped.load()) {
+            upstream.release_all();
+            std::this_thread::sleep_for(5ms);
+        }
+    });
+    pipeline.stop();
+    stopped = true;
+    releaser.join();
+}
+
+TEST(AsyncRequestPipelineTest, ExpiresRequestsThatWaitTooLong) {
+    ParkedDispatcher upstream;
+    AsyncRequestPipeline pipeline(upstream.dispatcher(), limits(1, 10, 50ms));
+
+    ASSERT_TRUE(pipeline.submit(make_request("slow"), [](core::Response) {}));
+    ASSERT_TRUE(upstream.wait_for(1));
+
+    std::promise<core::Response> expired;
+    auto start = std::chrono::steady_clock::now();
+    ASSERT_TRUE(pipeline.submit(make_request("late"), [&](core::Response response) {
+        expired.set_value(std::move(response));
+    }));
+
+    auto future = expired.get_future();
+    ASSERT_EQ(future.wait_for(2s), std::future_status::ready);
+    core::Response response = future.get();
+    EXPECT_GE(std::chrono::steady_clock::now() - start, 45ms);
+    EXPECT_FALSE(response.success);
+    EXPECT_EQ(response.status_code, 503);
+    EXPECT_NE(response.data.find("QUEUE_TIMEOUT"), std::string::npos);
+    EXPECT_EQ(upstream.parked(), 1u);   // Never dispatched
+    EXPECT_EQ(pipeline.to_json()["expired"], 1);
+
+    upstream.release_all();
+}
+
+TEST(AsyncRequestPipelineTest, PostedTasksRunOnWorkers) {
+    ParkedDispatcher upstream;
+    AsyncRequestPipeline pipeline(upstream.dispatcher(), limits(1, 1));
+
+    std::promise<std::thread::id> ran_on;
+    pipeline.post([&] { ran_on.set_value(std::this_thread::get_id()); });
+
+    auto future = ran_on.get_future();
+    ASSERT_EQ(future.wait_for(2s), std::future_status::ready);
+    EXPECT_NE(future.get(), std::this_thread::get_id());
+}
+
+TEST(AsyncRequestPipelineTest, StopFailsQueuedAndWaitsForInFlight) {
+    ParkedDispatcher upstream;
+    AsyncRequestPipeline pipeline(upstream.dispatcher(), limits(1, 10));
+
+    std::atomic<int> succeeded{0};
+    std::atomic<int> rejected{0};
+    auto on_complete = [&](core::Response response) {
+        (response.success ? succeeded : rejected)++;
+    };
+    ASSERT_TRUE(pipeline.submit(make_request("a"), on_complete));
+    ASSERT_TRUE(upstream.wait_for(1));
+    ASSERT_TRUE(pipeline.submit(make_request("b"), on_complete));
+
+    std::thread releaser([&] {
+        std::this_thread::sleep_for(50ms);
+        upstream.release_all();
+    });
+    pipeline.stop();
+    releaser.join();
+
+    EXPECT_EQ(succeeded.load(), 1);
+    EXPECT_EQ(rejected.load(), 1);
+    EXPECT_FALSE(pipeline.submit(make_request("c"), on_complete));
+}
+
+TEST(AsyncPipelineConfigTest, JsonRoundTrip) {
+    AsyncPipelineConfig config = limits(64, 128, 1500ms);
+    AsyncPipelineConfig round_trip = AsyncPipelineConfig::from_json(config.to_json());
+    EXPECT_EQ(round_trip.worker_threads_, 2u);
+    EXPECT_EQ(round_trip.max_concurrent_requests_, 64);
+    EXPECT_EQ(round_trip.max_queue_depth_, 128);
+    EXPECT_EQ(round_trip.max_queue_wait_, 1500ms);
+}
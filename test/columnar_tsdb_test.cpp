@@ -0,0 +1,432 @@
+#include <gtest/gtest.h>
+#include "aimux/metrics/columnar_tsdb.hpp"
+#include "aimux/metrics/gorilla_codec.hpp"
+#include <algorithm>
+#include <bit>
+#include <chrono>
+#include <cmath>
+#include <filesystem>
+#include <fstream>
+#include <limits>
+#include <random>
+#include <thread>
+#include <vector>
+
+using namespace aimux::metrics;
+using namespace std::chrono_literals;
+
+namespace {
+
+MetricPoint latency_point(const std::string& provider, double value, std::chrono::system_clock::time_point at) {
+    MetricPoint point;
+    point.name = "provider_latency_ms";
+    point.type = MetricType::TIMER;
+    point.value = value;
+    point.timestamp = at;
+    point.tags = {{"provider", provider}};
+    return point;
+}
+
+// A timestamp on a whole-hour boundary so partition layouts are predictable
+std::chrono::system_clock::time_point hour_aligned(std::chrono::system_clock::time_point at) {
+    return std::chrono::floor<std::chrono::hours>(at);
+}
+
+class ColumnarTimeSeriesDBTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        directory_ = std::filesystem::temp_directory_path() /
+            ("aimux_tsdb_" + std::to_string(std::random_device{}()) + "_" +
+             ::testing::UnitTest::GetInstance()->current_test_info()->name());
+        std::filesystem::remove_all(directory_);
+
+        config_.data_directory = directory_.string();
+        config_.database = "test";
+        config_.flush_interval = 0ms;
+        config_.max_block_points = 64;
+    }
+
+    void TearDown() override {
+        std::filesystem::remove_all(directory_);
+    }
+
+    std::unique_ptr<ColumnarTimeSeriesDB> open() {
+        auto db = std::make_unique<ColumnarTimeSeriesDB>(config_);
+        EXPECT_TRUE(db->connect());
+        return db;
+    }
+
+    std::vector<std::filesystem::path> files() const {
+        std::vector<std::filesystem::path> found;
+        for (const auto& entry : std::filesystem::directory_iterator(directory_ / config_.database)) {
+            found.push_back(entry.path().filename());
+        }
+        std::sort(found.begin(), found.end());
+        return found;
+    }
+
+    std::filesystem::path directory_;
+    TSDBConfig config_;
+};
+
+} // namespace
+
+TEST(GorillaCodecTest, RoundTripsTimestampsAndValuesExactly) {
+    std::vector<int64_t> timestamps;
+    std::vector<double> values;
+    int64_t t = 1'700'000'000'000'000;
+    std::mt19937 rng(42);
+    std::uniform_int_distribution<int> jitter(-5000, 5000);
+
+    for (int i = 0; i < 500; ++i) {
+        t += 1'000'000 + (i % 7 == 0 ? jitter(rng) : 0);   // Mostly regular, some jitter
+        timestamps.push_back(t);
+        values.push_back(i % 3 == 0 ? 120.5 : 100.0 + i * 0.25);
+    }
+    // Edge values the XOR encoding must survive
+    for (double edge : {0.0, -0.0, std::numeric_limits<double>::max(), std::numeric_limits<double>::lowest(),
+                        std::numeric_limits<double>::denorm_min(), std::numeric_limits<double>::infinity(), 1e-300}) {
+        t += 3;
+        timestamps.push_back(t);
+        values.push_back(edge);
+    }
+    // Backwards and very large timestamp jumps
+    timestamps.push_back(t - 10'000'000'000);
+    values.push_back(1.0);
+    timestamps.push_back(t + (int64_t{1} << 50));
+    values.push_back(2.0);
+
+    GorillaEncoder encoder;
+    for (size_t i = 0; i < timestamps.size(); ++i) {
+        encoder.append(timestamps[i], values[i]);
+    }
+
+    std::vector<int64_t> decoded_timestamps;
+    std::vector<double> decoded_values;
+    GorillaDecoder decoder(encoder.bytes().data(), encoder.bytes().size(), encoder.count());
+    ASSERT_TRUE(decoder.decode_all(decoded_timestamps, decoded_values));
+    ASSERT_EQ(decoded_timestamps, timestamps);
+    ASSERT_EQ(decoded_values.size(), values.size());
+    for (size_t i = 0; i < values.size(); ++i) {
+        EXPECT_EQ(std::bit_cast<uint64_t>(decoded_values[i]), std::bit_cast<uint64_t>(values[i])) << i;
+    }
+
+    // Regular samples of a slowly moving value compress far below 16 bytes a point
+    EXPECT_LT(encoder.bytes().size(), timestamps.size() * 8);
+}
+
+TEST(GorillaCodecTest, TruncatedStreamStopsInsteadOfOverreading) {
+    GorillaEncoder encoder;
+    for (int i = 0; i < 100; ++i) {
+        encoder.append(i * 1000, i * 1.5);
+    }
+
+    std::vector<int64_t> timestamps;
+    std::vector<double> values;
+    GorillaDecoder decoder(encoder.bytes().data(), encoder.bytes().size() / 2, encoder.count());
+    EXPECT_FALSE(decoder.decode_all(timestamps, values));
+    EXPECT_LT(timestamps.size(), 100u);
+}
+
+TEST_F(ColumnarTimeSeriesDBTest, WritesAndQueriesPointsWithTagFilters) {
+    auto db = open();
+    auto base = hour_aligned(std::chrono::system_clock::now()) - 2h;
+
+    std::vector<MetricPoint> points;
+    for (int i = 0; i < 200; ++i) {
+        auto point = latency_point(i % 2 == 0 ? "openai" : "anthropic", i, base + i * 1s);
+        point.fields["tokens"] = i * 10;
+        points.push_back(point);
+    }
+    ASSERT_TRUE(db->write_metrics(points));
+
+    auto openai = db->query_metrics(TSDBQueryBuilder("provider_latency_ms").tag("provider", "openai"));
+    ASSERT_EQ(openai.size(), 100u);
+    for (size_t i = 0; i < openai.size(); ++i) {
+        EXPECT_EQ(openai[i].value, static_cast<double>(i * 2));
+        EXPECT_EQ(openai[i].fields.at("tokens"), static_cast<double>(i * 20));
+        EXPECT_EQ(openai[i].tags.at("provider"), "openai");
+        EXPECT_EQ(openai[i].timestamp, base + static_cast<int>(i * 2) * 1s);
+    }
+
+    auto newest = db->query_metrics(TSDBQueryBuilder("provider_latency_ms")
+        .time_range(base + 50s, base + 59s).order_by("time", "desc").limit(3));
+    ASSERT_EQ(newest.size(), 3u);
+    EXPECT_EQ(newest[0].value, 59.0);
+    EXPECT_EQ(newest[2].value, 57.0);
+
+    EXPECT_TRUE(db->query_metrics(TSDBQueryBuilder("other")).empty());
+}
+
+TEST_F(ColumnarTimeSeriesDBTest, AggregationsMatchAcrossSealedAndBufferedBlocks) {
+    auto db = open();
+    auto base = hour_aligned(std::chrono::system_clock::now()) - 3h;
+
+    std::vector<MetricPoint> points;
+    double sum = 0.0;
+    for (int i = 0; i < 1000; ++i) {
+        double value = (i * 37) % 101;
+        sum += value;
+        points.push_back(latency_point("openai", value, base + i * 100ms));
+    }
+    ASSERT_TRUE(db->write_metrics(points));   // 64-point blocks plus a partial head
+
+    auto stats = db->query_aggregations(TSDBQueryBuilder("provider_latency_ms"), {"mean", "count", "p95"});
+    ASSERT_EQ(stats.size(), 1u);
+    EXPECT_EQ(stats[0].count, 1000.0);
+    EXPECT_DOUBLE_EQ(stats[0].sum, sum);
+    EXPECT_EQ(stats[0].min, 0.0);
+    EXPECT_EQ(stats[0].max, 100.0);
+    EXPECT_NEAR(stats[0].p95, 95.0, 1.0);
+
+    // A range cutting through blocks: header fast path and masked decode must agree
+    auto range = TSDBQueryBuilder("provider_latency_ms").time_range(base + 10s, base + 80s);
+    double expected_sum = 0.0;
+    int expected_count = 0;
+    for (int i = 100; i <= 800; ++i) {
+        expected_sum += (i * 37) % 101;
+        expected_count++;
+    }
+    auto summary = db->query_aggregations(range, {"mean", "count"});
+    auto exact = db->query_aggregations(range, {"mean", "count", "median"});
+    ASSERT_EQ(summary.size(), 1u);
+    ASSERT_EQ(exact.size(), 1u);
+    EXPECT_EQ(summary[0].count, expected_count);
+    EXPECT_DOUBLE_EQ(summary[0].sum, expected_sum);
+    EXPECT_EQ(exact[0].count, summary[0].count);
+    EXPECT_DOUBLE_EQ(exact[0].sum, summary[0].sum);
+    EXPECT_DOUBLE_EQ(exact[0].std_dev, summary[0].std_dev);
+}
+
+TEST_F(ColumnarTimeSeriesDBTest, WindowsGroupByTagAndTime) {
+    auto db = open();
+    auto base = hour_aligned(std::chrono::system_clock::now()) - 1h;
+
+    std::vector<MetricPoint> points;
+    for (int i = 0; i < 180; ++i) {
+        points.push_back(latency_point("openai", 100.0, base + i * 1s));
+        points.push_back(latency_point("anthropic", 200.0 + i, base + i * 1s));
+    }
+    ASSERT_TRUE(db->write_metrics(points));
+
+    auto windows = db->query_windows(TSDBQueryBuilder("provider_latency_ms").group_by({"provider"}), 60s);
+    ASSERT_EQ(windows.size(), 6u);   // Three minutes, two providers
+
+    for (const auto& window : windows) {
+        EXPECT_EQ(window.stats.count, 60.0);
+        auto minute = std::chrono::duration_cast<std::chrono::minutes>(window.start - base).count();
+        if (window.group.at("provider") == "openai") {
+            EXPECT_DOUBLE_EQ(window.stats.mean, 100.0);
+        } else {
+            EXPECT_DOUBLE_EQ(window.stats.min, 200.0 + minute * 60);
+            EXPECT_DOUBLE_EQ(window.stats.max, 259.0 + minute * 60);
+        }
+    }
+    EXPECT_EQ(windows.front().start, base);
+    EXPECT_EQ(windows.front().to_json()["group"]["provider"], windows.front().group.at("provider"));
+}
+
+TEST_F(ColumnarTimeSeriesDBTest, DataSurvivesReconnect) {
+    auto base = hour_aligned(std::chrono::system_clock::now()) - 2h;
+    {
+        auto db = open();
+        std::vector<MetricPoint> points;
+        for (int i = 0; i < 100; ++i) {
+            points.push_back(latency_point("openai", i, base + i * 1s));
+        }
+        ASSERT_TRUE(db->write_metrics(points));
+        EXPECT_TRUE(db->disconnect());
+    }
+
+    auto db = open();
+    auto stats = db->query_aggregations(TSDBQueryBuilder("provider_latency_ms").tag("provider", "openai"));
+    ASSERT_EQ(stats.size(), 1u);
+    EXPECT_EQ(stats[0].count, 100.0);
+    EXPECT_DOUBLE_EQ(stats[0].mean, 49.5);
+    EXPECT_EQ(db->get_status()["buffered_points"], 0);
+    EXPECT_GT(db->get_status()["bytes_on_disk"].get<size_t>(), 0u);
+}
+
+TEST_F(ColumnarTimeSeriesDBTest, TornTailIsTruncatedOnOpen) {
+    auto base = hour_aligned(std::chrono::system_clock::now()) - 2h;
+    {
+        auto db = open();
+        std::vector<MetricPoint> points;
+        for (int i = 0; i < 128; ++i) {   // Exactly two sealed blocks
+            points.push_back(latency_point("openai", i, base + i * 1s));
+        }
+        ASSERT_TRUE(db->write_metrics(points));
+        db->disconnect();
+    }
+
+    auto names = files();
+    ASSERT_EQ(names.size(), 1u);
+    auto path = directory_ / config_.database / names[0];
+    auto intact = std::filesystem::file_size(path);
+    {
+        std::ofstream out(path, std::ios::binary | std::ios::app);
+        out << "half a block header";
+    }
+
+    auto db = open();
+    EXPECT_EQ(std::filesystem::file_size(path), intact);
+    auto stats = db->query_aggregations(TSDBQueryBuilder("provider_latency_ms"));
+    ASSERT_EQ(stats.size(), 1u);
+    EXPECT_EQ(stats[0].count, 128.0);
+
+    // Corrupt the last block's payload: only the first block survives
+    db->disconnect();
+    {
+        std::fstream io(path, std::ios::binary | std::ios::in | std::ios::out);
+        io.seekp(static_cast<std::streamoff>(intact) - 2);
+        io.put('\xff');
+    }
+    db = open();
+    stats = db->query_aggregations(TSDBQueryBuilder("provider_latency_ms"));
+    ASSERT_EQ(stats.size(), 1u);
+    EXPECT_EQ(stats[0].count, 64.0);
+}
+
+TEST_F(ColumnarTimeSeriesDBTest, RollupKeepsExactSummariesAndRemovesRawData) {
+    config_.raw_retention = 24h;
+    config_.rollup_interval = 60s;
+    auto db = open();
+    auto now = hour_aligned(std::chrono::system_clock::now());
+    auto old = now - 30h;
+
+    std::vector<MetricPoint> points;
+    double sum = 0.0;
+    for (int i = 0; i < 600; ++i) {   // Ten minutes, one point a second
+        double value = 50.0 + (i % 17);
+        sum += value;
+        points.push_back(latency_point("openai", value, old + i * 1s));
+    }
+    points.push_back(latency_point("openai", 1.0, now + 1s));   // Current data stays raw
+    ASSERT_TRUE(db->write_metrics(points));
+
+    db->run_maintenance(now + 2s);
+
+    auto status = db->get_status();
+    EXPECT_EQ(status["raw_partitions"], 0);
+    EXPECT_EQ(status["buffered_points"], 1);
+    EXPECT_EQ(status["rollup_partitions"], 1);
+    EXPECT_EQ(status["rollup_rows"], 10);
+
+    auto old_range = TSDBQueryBuilder("provider_latency_ms").time_range(old, old + 1h);
+    auto stats = db->query_aggregations(old_range);
+    ASSERT_EQ(stats.size(), 1u);
+    EXPECT_EQ(stats[0].count, 600.0);
+    EXPECT_DOUBLE_EQ(stats[0].sum, sum);
+    EXPECT_EQ(stats[0].min, 50.0);
+    EXPECT_EQ(stats[0].max, 66.0);
+
+    auto windows = db->query_windows(old_range, 5min);
+    ASSERT_EQ(windows.size(), 2u);
+    EXPECT_EQ(windows[0].stats.count, 300.0);
+
+    // Downsampled points come back one per rollup interval
+    EXPECT_EQ(db->query_metrics(old_range).size(), 10u);
+
+    // Rolled-up data survives a reopen
+    db->disconnect();
+    db = open();
+    stats = db->query_aggregations(old_range);
+    ASSERT_EQ(stats.size(), 1u);
+    EXPECT_EQ(stats[0].count, 600.0);
+}
+
+TEST_F(ColumnarTimeSeriesDBTest, RetentionDropsExpiredPartitions) {
+    config_.retention = 24h;
+    config_.raw_retention = 0h;   // No rollups
+    auto db = open();
+    auto now = hour_aligned(std::chrono::system_clock::now());
+
+    ASSERT_TRUE(db->write_metrics({latency_point("openai", 1.0, now - 48h),
+                                   latency_point("openai", 2.0, now - 2h)}));
+    db->flush();
+    EXPECT_EQ(files().size(), 2u);
+
+    db->run_maintenance(now);
+    EXPECT_EQ(files().size(), 1u);
+    auto remaining = db->query_metrics(TSDBQueryBuilder("provider_latency_ms"));
+    ASSERT_EQ(remaining.size(), 1u);
+    EXPECT_EQ(remaining[0].value, 2.0);
+
+    // A default retention policy overrides the configured retention
+    ASSERT_TRUE(db->create_retention_policy("short", 1h, 1, true));
+    EXPECT_EQ(db->list_retention_policies(), std::vector<std::string>{"short"});
+    db->run_maintenance(now);
+    EXPECT_TRUE(db->query_metrics(TSDBQueryBuilder("provider_latency_ms")).empty());
+    EXPECT_TRUE(db->drop_retention_policy("short"));
+}
+
+TEST_F(ColumnarTimeSeriesDBTest, EventsRoundTrip) {
+    auto db = open();
+    auto now = std::chrono::system_clock::now();
+
+    PrettificationEvent event;
+    event.plugin_name = "markdown";
+    event.provider = "openai";
+    event.model = "gpt-4";
+    event.input_format = "json";
+    event.output_format = "markdown";
+    event.processing_time_ms = 12.5;
+    event.input_size_bytes = 1024;
+    event.output_size_bytes = 2048;
+    event.success = false;
+    event.error_type = "timeout";
+    event.tokens_processed = 300;
+    event.timestamp = now;
+    ASSERT_TRUE(db->write_events({event}));
+
+    auto events = db->query_events(TSDBQueryBuilder("ignored").tag("provider", "openai"));
+    ASSERT_EQ(events.size(), 1u);
+    EXPECT_EQ(events[0].plugin_name, "markdown");
+    EXPECT_EQ(events[0].model, "gpt-4");
+    EXPECT_EQ(events[0].processing_time_ms, 12.5);
+    EXPECT_EQ(events[0].input_size_bytes, 1024u);
+    EXPECT_EQ(events[0].output_size_bytes, 2048u);
+    EXPECT_FALSE(events[0].success);
+    EXPECT_EQ(events[0].error_type, "timeout");
+    EXPECT_EQ(events[0].tokens_processed, 300u);
+    EXPECT_EQ(std::chrono::floor<std::chrono::microseconds>(events[0].timestamp),
+              std::chrono::floor<std::chrono::microseconds>(now));
+}
+
+TEST_F(ColumnarTimeSeriesDBTest, ConcurrentWritersAndReaders) {
+    auto db = open();
+    auto base = std::chrono::system_clock::now() - 1h;
+    constexpr int WRITERS = 4;
+    constexpr int POINTS = 2000;
+
+    std::vector<std::thread> threads;
+    for (int w = 0; w < WRITERS; ++w) {
+        threads.emplace_back([&, w] {
+            for (int i = 0; i < POINTS; ++i) {
+                db->write_metrics({latency_point("p" + std::to_string(w), 1.0, base + i * 1ms)});
+            }
+        });
+    }
+    threads.emplace_back([&] {
+        for (int i = 0; i < 50; ++i) {
+            db->query_windows(TSDBQueryBuilder("provider_latency_ms"), 1s, true);
+        }
+    });
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    auto stats = db->query_aggregations(TSDBQueryBuilder("provider_latency_ms"));
+    ASSERT_EQ(stats.size(), 1u);
+    EXPECT_EQ(stats[0].count, WRITERS * POINTS);
+}
+
+TEST(TimeSeriesDBFactoryTest, CreatesColumnarBackend) {
+    TSDBConfig config;
+    config.flush_interval = 0ms;
+    auto db = TimeSeriesDBFactory::create("columnar", config);
+    EXPECT_NE(dynamic_cast<ColumnarTimeSeriesDB*>(db.get()), nullptr);
+
+    auto backends = TimeSeriesDBFactory::list_available_backends();
+    EXPECT_NE(std::find(backends.begin(), backends.end(), "columnar"), backends.end());
+}
@@ -0,0 +1,161 @@
+#include <gtest/gtest.h>
+#include "aimux/security/advanced_crypto.hpp"
+#include "aimux/providers/provider_impl.hpp"
+#include "aimux/providers/api_specs.hpp"
+#include <atomic>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace aimux;
+using aimux::security::AdvancedCrypto;
+using aimux::security::SecureString;
+
+namespace {
+
+const char* const CEREBRAS_KEY = "csk-test0123456789abcdefghijkl";
+
+class TestCerebrasProvider : public providers::CerebrasProvider {
+public:
+    using providers::CerebrasProvider::CerebrasProvider;
+    using providers::CerebrasProvider::build_http_request;
+};
+
+class TestMiniMaxProvider : public providers::MiniMaxProvider {
+public:
+    using providers::MiniMaxProvider::MiniMaxProvider;
+    using providers::MiniMaxProvider::build_http_request;
+};
+
+core::Request make_request() {
+    core::Request request;
+    request.model = "llama3.1-8b";
+    request.method = "POST";
+    request.data = {{"messages", nlohmann::json::array({{{"role", "user"}, {"content", "hi"}}})}};
+    return request;
+}
+
+} // namespace
+
+TEST(SecureStringTest, HoldsValueInItsOwnLockedPages) {
+    SecureString secret(std::string("sk-0123456789"));
+    EXPECT_EQ(secret.view(), "sk-0123456789");
+    EXPECT_EQ(secret.get(), "sk-0123456789");
+    EXPECT_EQ(secret.size(), 13u);
+    // mlock may be refused under a tight RLIMIT_MEMLOCK; the value must survive either way
+    if (!secret.is_locked()) {
+        GTEST_LOG_(INFO) << "mlock refused; running without locked memory";
+    }
+
+    SecureString moved(std::move(secret));
+    EXPECT_EQ(moved.view(), "sk-0123456789");
+    EXPECT_TRUE(secret.empty());
+    EXPECT_TRUE(secret.view().empty());
+
+    SecureString empty;
+    EXPECT_TRUE(empty.empty());
+    EXPECT_FALSE(empty.is_locked());
+    moved = std::move(empty);
+    EXPECT_TRUE(moved.empty());
+}
+
+TEST(AdvancedCryptoTest, DerivesEachKeyOnceAndRoundTrips) {
+    AdvancedCrypto crypto;
+
+    std::vector<std::string> blobs;
+    for (int i = 0; i < 5; ++i) {
+        blobs.push_back(crypto.encrypt_api_key_to_base64("sk-key-" + std::to_string(i)));
+    }
+    for (int round = 0; round < 3; ++round) {
+        for (int i = 0; i < 5; ++i) {
+            EXPECT_EQ(crypto.decrypt_api_key_from_base64(blobs[i]), "sk-key-" + std::to_string(i));
+        }
+    }
+    // One master key and one salt: PBKDF2 ran once for 20 operations
+    EXPECT_EQ(crypto.derivation_count(), 1u);
+
+    // Random IVs still make every ciphertext distinct
+    EXPECT_NE(blobs[0], crypto.encrypt_api_key_to_base64("sk-key-0"));
+}
+
+TEST(AdvancedCryptoTest, RotationAdvancesTheEpochAndKeepsOldDataReadable) {
+    AdvancedCrypto crypto;
+    std::string old_blob = crypto.encrypt_api_key_to_base64("sk-before-rotation");
+    auto old_id = crypto.get_master_key_metadata().key_id;
+    uint64_t epoch = AdvancedCrypto::credential_epoch();
+
+    crypto.rotate_master_key(1);
+
+    EXPECT_EQ(AdvancedCrypto::credential_epoch(), epoch + 1);
+    EXPECT_NE(crypto.get_master_key_metadata().key_id, old_id);
+    EXPECT_TRUE(crypto.is_key_valid(old_id));
+
+    // The cache was wiped: the old key is re-derived once during the grace period
+    uint64_t before = crypto.derivation_count();
+    EXPECT_EQ(crypto.decrypt_api_key_from_base64(old_blob), "sk-before-rotation");
+    EXPECT_EQ(crypto.decrypt_api_key_from_base64(old_blob), "sk-before-rotation");
+    EXPECT_LE(crypto.derivation_count() - before, 2u);   // New key tried first, then the old one
+
+    std::string new_blob = crypto.encrypt_api_key_to_base64("sk-after-rotation");
+    EXPECT_EQ(crypto.decrypt_api_key_from_base64(new_blob), "sk-after-rotation");
+}
+
+TEST(AdvancedCryptoTest, ConcurrentUseIsSafe) {
+    AdvancedCrypto crypto;
+    std::string blob = crypto.encrypt_api_key_to_base64("sk-shared-key");
+
+    std::vector<std::thread> workers;
+    std::atomic<int> failures{0};
+    for (int t = 0; t < 4; ++t) {
+        workers.emplace_back([&] {
+            for (int i = 0; i < 50; ++i) {
+                if (crypto.decrypt_api_key_from_base64(blob) != "sk-shared-key") {
+                    failures++;
+                }
+                crypto.encrypt_api_key("sk-other-key");
+            }
+        });
+    }
+    for (auto& worker : workers) {
+        worker.join();
+    }
+    EXPECT_EQ(failures.load(), 0);
+    EXPECT_EQ(crypto.derivation_count(), 1u);
+}
+
+TEST(ProviderAuthHeadersTest, ReusesRenderedHeadersUntilRotation) {
+    TestCerebrasProvider provider(nlohmann::json{{"api_key", CEREBRAS_KEY}});
+
+    network::HttpRequest first;
+    ASSERT_TRUE(provider.build_http_request(make_request(), first));
+    ASSERT_EQ(first.headers.size(), 3u);
+    EXPECT_EQ(first.headers[0].first, providers::api_specs::headers::AUTHORIZATION);
+    EXPECT_EQ(first.headers[0].second, std::string("Bearer ") + CEREBRAS_KEY);
+    EXPECT_EQ(first.headers[1].first, providers::api_specs::headers::CONTENT_TYPE);
+    EXPECT_EQ(first.headers[2].first, providers::api_specs::headers::USER_AGENT);
+
+    network::HttpRequest second;
+    second.headers = {{"Stale", "header"}};
+    ASSERT_TRUE(provider.build_http_request(make_request(), second));
+    EXPECT_EQ(second.headers, first.headers);
+
+    // Rotating any master key invalidates the rendered list; the rebuilt one is identical
+    AdvancedCrypto crypto;
+    crypto.rotate_master_key(1);
+    network::HttpRequest third;
+    ASSERT_TRUE(provider.build_http_request(make_request(), third));
+    EXPECT_EQ(third.headers, first.headers);
+}
+
+TEST(ProviderAuthHeadersTest, MiniMaxSendsItsGroupIdAfterAuthorization) {
+    TestMiniMaxProvider provider(nlohmann::json{{"api_key", "mm-test0123456789abcdefghijkl"}, {"group_id", "group-1234"}});
+
+    network::HttpRequest http_request;
+    ASSERT_TRUE(provider.build_http_request(make_request(), http_request));
+    ASSERT_EQ(http_request.headers.size(), 4u);
+    EXPECT_EQ(http_request.headers[0].second, "Bearer mm-test0123456789abcdefghijkl");
+    EXPECT_EQ(http_request.headers[1].first, providers::api_specs::headers::X_GROUP_ID);
+    EXPECT_EQ(http_request.headers[1].second, "group-1234");
+    EXPECT_EQ(http_request.headers[2].first, providers::api_specs::headers::CONTENT_TYPE);
+    EXPECT_EQ(http_request.headers[3].first, providers::api_specs::headers::USER_AGENT);
+}
@@ -0,0 +1,171 @@
+#include <gtest/gtest.h>
+#include "aimux/gateway/format_detector.hpp"
+#include <cctype>
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
+
+using namespace aimux::gateway;
+using nlohmann::json;
+
+namespace {
+
+using HeaderList = std::vector<std::pair<std::string, std::string>>;
+
+crow::request make_request(const std::string& url, const HeaderList& headers = {}) {
+    crow::request req;
+    req.url = url;
+    for (const auto& [name, value] : headers) {
+        req.add_header(name, value);
+    }
+    return req;
+}
+
+std::string lowercase(std::string text) {
+    for (auto& c : text) {
+        c = static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
+    }
+    return text;
+}
+
+// A long conversation: the keys after "messages" lie far beyond the scan limit
+json long_conversation(size_t turns) {
+    json messages = json::array();
+    for (size_t i = 0; i < turns; ++i) {
+        messages.push_back({{"role", i % 2 ? "assistant" : "user"}, {"content", std::string(200, 'x')}});
+    }
+    return messages;
+}
+
+} // namespace
+
+TEST(FormatDetectorFastPathTest, EndpointDecidesWithoutTouchingTheBody) {
+    FormatDetector detector;
+    // Not even valid JSON: a decision from the endpoint never looks at it
+    std::string body = "{\"messages\": [" + std::string(1 << 20, '[');
+
+    auto result = detector.detect_format(make_request("/v1/messages"), body);
+    EXPECT_EQ(result.format, APIFormat::ANTHROPIC);
+    EXPECT_EQ(result.document, nullptr);
+
+    result = detector.detect_format(make_request("/v1/chat/completions",
+                                                 {{"Authorization", "Bearer sk-test"}}), body);
+    EXPECT_EQ(result.format, APIFormat::OPENAI);
+    EXPECT_EQ(result.document, nullptr);
+}
+
+TEST(FormatDetectorFastPathTest, HeadersAreMatchedCaseInsensitively) {
+    FormatDetector detector;
+    std::string body = json{{"messages", long_conversation(4)}}.dump();
+
+    auto result = detector.detect_format(make_request("/proxy", {{"X-API-Key", "sk-ant"}}), body);
+    EXPECT_EQ(result.format, APIFormat::ANTHROPIC);
+    EXPECT_EQ(result.document, nullptr);
+
+    result = detector.detect_format(make_request("/proxy", {{"AUTHORIZATION", "bearer sk-test"}}), body);
+    EXPECT_EQ(result.format, APIFormat::OPENAI);
+    EXPECT_EQ(result.document, nullptr);
+}
+
+TEST(FormatDetectorFastPathTest, PrefixKeysDecideBeforeALargeMessagesArray) {
+    FormatDetector detector;
+    // Client SDKs put model and parameters ahead of the conversation
+    nlohmann::ordered_json body = {
+        {"model", "claude-3-5-sonnet-20241022"},
+        {"max_tokens", 1024},
+        {"system", "Be brief."},
+        {"messages", long_conversation(500)}
+    };
+    std::string text = body.dump();
+    ASSERT_GT(text.size(), detector.get_config().body_scan_limit * 10);
+
+    auto result = detector.detect_format(make_request("/proxy"), text);
+    EXPECT_EQ(result.format, APIFormat::ANTHROPIC);
+    EXPECT_EQ(result.document, nullptr);
+
+    // Bedrock-style body: no model at all, anthropic_version up front
+    nlohmann::ordered_json bedrock = {
+        {"anthropic_version", "bedrock-2023-05-31"},
+        {"max_tokens", 1024},
+        {"messages", long_conversation(500)}
+    };
+    result = detector.detect_format(make_request("/model/invoke"), bedrock.dump());
+    EXPECT_EQ(result.format, APIFormat::ANTHROPIC);
+    EXPECT_EQ(result.document, nullptr);
+}
+
+TEST(FormatDetectorFastPathTest, AmbiguousPrefixFallsBackToOneParseAndHandsItOn) {
+    FormatDetector detector;
+    // Conflicting endpoint and headers, and "model" only after the large array
+    json body = {{"messages", long_conversation(500)}, {"model", "gpt-4o"}, {"stream", true}};
+    std::string text = body.dump();
+    auto req = make_request("/v1/messages", {{"Authorization", "Bearer sk-test"}});
+
+    auto result = detector.detect_format(req, text);
+    ASSERT_NE(result.document, nullptr);
+    EXPECT_EQ(*result.document, body);
+
+    std::map<std::string, std::string> headers = {{"authorization", "Bearer sk-test"}};
+    auto full = detector.detect_format(body, headers, "/v1/messages");
+    EXPECT_EQ(result.format, full.format);
+    EXPECT_DOUBLE_EQ(result.confidence, full.confidence);
+}
+
+TEST(FormatDetectorFastPathTest, AgreesWithFullParseDetection) {
+    FormatDetector detector;
+    std::vector<std::string> urls = {"/v1/messages", "/v1/chat/completions", "/proxy"};
+    std::vector<HeaderList> header_sets = {
+        {},
+        {{"x-api-key", "sk-ant"}},
+        {{"Authorization", "Bearer sk-test"}},
+        {{"x-api-key", "sk-ant"}, {"Authorization", "Bearer sk-test"}},
+    };
+    std::vector<json> bodies = {
+        {{"model", "claude-3-haiku-20240307"}, {"max_tokens", 10}, {"system", "s"},
+         {"messages", json::array({{{"role", "user"}, {"content", "hi"}}})}},
+        {{"model", "gpt-4o"}, {"frequency_penalty", 0.5}, {"stream", true},
+         {"messages", json::array({{{"role", "system"}, {"content", "s"}}, {{"role", "user"}, {"content", "hi"}}})}},
+        {{"messages", long_conversation(300)}, {"model", "claude-3-opus"}, {"top_k", 5}},
+        {{"messages", long_conversation(300)}, {"model", "gpt-3.5-turbo"}, {"presence_penalty", 1.0}},
+        {{"model", "custom-model"}, {"messages", long_conversation(2)}},
+        // Structure keys present, but no message whose role and content pass validation
+        {{"system", "s"}, {"messages", json::array()}},
+        {{"system", "s"}, {"stream", true},
+         {"messages", json::array({{{"role", "tool"}, {"tool_call_id", "call_1"}, {"content", "42"}}})}},
+        {{"stream", true}, {"messages", json::array({{{"role", "system"}, {"content", "s"}}})}},
+        {{"system", "s"}, {"messages", json::array({"hi", {{"role", "user"}}, {{"content", "hi"}, {"role", "user"}}})}},
+    };
+
+    for (const auto& url : urls) {
+        for (const auto& header_list : header_sets) {
+            std::map<std::string, std::string> headers;
+            for (const auto& [name, value] : header_list) {
+                headers[lowercase(name)] = value;
+            }
+            for (const auto& body : bodies) {
+                auto fast = detector.detect_format(make_request(url, header_list), body.dump());
+                auto full = detector.detect_format(body, headers, url);
+                EXPECT_EQ(fast.format, full.format)
+                    << url << " headers=" << header_list.size() << " body=" << body.dump().substr(0, 60);
+            }
+        }
+    }
+}
+
+TEST(FormatDetectorFastPathTest, SkipsNonJsonAndSurvivesMalformedBodies) {
+    FormatDetector detector;
+
+    auto form = make_request("/proxy", {{"Content-Type", "application/x-www-form-urlencoded"}});
+    auto result = detector.detect_format(form, "model=claude-3-opus");
+    EXPECT_EQ(result.format, APIFormat::UNKNOWN);
+    EXPECT_EQ(result.document, nullptr);
+
+    result = detector.detect_format(make_request("/proxy"), "{\"model\": \"claude-3-opus\", \"messages\": [");
+    EXPECT_EQ(result.format, APIFormat::ANTHROPIC);   // From the model seen in the prefix
+    EXPECT_EQ(result.document, nullptr);
+
+    result = detector.detect_format(make_request("/proxy"), "{\"messages\": [" + std::string(8192, ' '));
+    EXPECT_EQ(result.format, APIFormat::UNKNOWN);
+    EXPECT_EQ(result.document, nullptr);
+}
@@ -0,0 +1,481 @@
+#include <gtest/gtest.h>
+#include "aimux/gateway/gateway_manager.hpp"
+#include "aimux/core/cancellation.hpp"
+#include "aimux/network/curl_multi_engine.hpp"
+#include <atomic>
+#include <chrono>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <vector>
+
+using namespace aimux;
+using namespace aimux::gateway;
+using namespace std::chrono_literals;
+
+namespace {
+
+// Calls to every FakeBridge in a test, in arrival order
+struct CallLog {
+    std::atomic<int> calls{0};
+    std::atomic<int> cancelled{0};
+};
+
+/**
+ * The first bridge to be called takes first_call_delay (giving up early if
+ * cancelled); later calls take later_call_delay. Which provider the router
+ * picks first therefore does not matter to the tests.
+ */
+class FakeBridge : public core::Bridge {
+public:
+    FakeBridge(std::string name, std::shared_ptr<CallLog> log,
+               std::chrono::milliseconds first_call_delay, std::chrono::milliseconds later_call_delay,
+               bool first_call_fails = false)
+        : name_(std::move(name)), log_(std::move(log)),
+          first_call_delay_(first_call_delay), later_call_delay_(later_call_delay),
+          first_call_fails_(first_call_fails) {}
+
+    core::Response send_request(const core::Request& /*request*/) override {
+        bool first = log_->calls.fetch_add(1) == 0;
+        auto deadline = std::chrono::steady_clock::now() + (first ? first_call_delay_ : later_call_delay_);
+
+        core::Response response;
+        response.provider_name = name_;
+        while (std::chrono::steady_clock::now() < deadline) {
+            if (core::current_cancellation().cancelled()) {
+                log_->cancelled++;
+                response.status_code = 499;
+                response.error_message = "Request cancelled";
+                return response;
+            }
+            std::this_thread::sleep_for(5ms);
+        }
+
+        response.success = !(first && first_call_fails_);
+        response.status_code = response.success ? 200 : 503;
+        response.data = R"({"provider": ")" + name_ + R"("})";
+        return response;
+    }
+
+    bool is_healthy() const override { return true; }
+    std::string get_provider_name() const override { return name_; }
+    nlohmann::json get_rate_limit_status() const override { return nlohmann::json::object(); }
+
+private:
+    std::string name_;
+    std::shared_ptr<CallLog> log_;
+    std::chrono::milliseconds first_call_delay_;
+    std::chrono::milliseconds later_call_delay_;
+    bool first_call_fails_;
+};
+
+// Completes on the network event loop after a delay, the way HTTP providers do
+class EventLoopBridge : public core::Bridge {
+public:
+    EventLoopBridge(std::string name, std::shared_ptr<CallLog> log, std::chrono::milliseconds delay,
+                    bool first_call_fails = false,
+                    std::optional<std::chrono::milliseconds> first_call_delay = std::nullopt)
+        : name_(std::move(name)), log_(std::move(log)), delay_(delay), first_call_fails_(first_call_fails),
+          first_call_delay_(first_call_delay.value_or(delay)) {}
+
+    core::Response send_request(const core::Request& /*request*/) override {
+        blocking_calls_++;
+        core::Response response;
+        response.provider_name = name_;
+        response.status_code = 500;
+        return response;
+    }
+
+    void send_request_async(const core::Request& /*request*/, core::ResponseCallback on_complete) override {
+        bool first = log_->calls.fetch_add(1) == 0;
+
+        core::Response response;
+        response.provider_name = name_;
+        response.success = !(first && first_call_fails_);
+        response.status_code = response.success ? 200 : 503;
+        response.data = R"({"provider": ")" + name_ + R"("})";
+
+        network::CurlMultiEngine::instance().schedule(first ? first_call_delay_ : delay_,
+            [response, on_complete = std::move(on_complete)](bool) { on_complete(response); });
+    }
+
+    bool is_healthy() const override { return true; }
+    std::string get_provider_name() const override { return name_; }
+    nlohmann::json get_rate_limit_status() const override { return nlohmann::json::object(); }
+
+    static inline std::atomic<int> blocking_calls_{0};
+
+private:
+    std::string name_;
+    std::shared_ptr<CallLog> log_;
+    std::chrono::milliseconds delay_;
+    bool first_call_fails_;
+    std::chrono::milliseconds first_call_delay_;
+};
+
+// Answers from the event loop through its own members, like BaseProvider's callbacks
+class SelfReferencingBridge : public core::Bridge {
+public:
+    SelfReferencingBridge(std::string name, std::shared_ptr<std::atomic<bool>> destroyed)
+        : name_(std::move(name)), destroyed_(std::move(destroyed)) {}
+    ~SelfReferencingBridge() override { *destroyed_ = true; }
+
+    core::Response send_request(const core::Request& /*request*/) override { return core::Response{}; }
+
+    void send_request_async(const core::Request& /*request*/, core::ResponseCallback on_complete) override {
+        network::CurlMultiEngine::instance().schedule(50ms,
+            [this, on_complete = std::move(on_complete)](bool) {
+                core::Response response;
+                response.provider_name = name_;
+                response.success = !*destroyed_;
+                response.status_code = response.success ? 200 : 500;
+                response.data = R"({"provider": ")" + name_ + R"("})";
+                on_complete(std::move(response));
+            });
+    }
+
+    bool is_healthy() const override { return true; }
+    std::string get_provider_name() const override { return name_; }
+    nlohmann::json get_rate_limit_status() const override { return nlohmann::json::object(); }
+
+private:
+    std::string name_;
+    std::shared_ptr<std::atomic<bool>> destroyed_;
+};
+
+core::Request make_request() {
+    core::Request request;
+    request.model = "test-model";
+    request.data = {{"messages", {{{"role", "user"}, {"content", "hello"}}}}, {"temperature", 0.7}};
+    return request;
+}
+
+} // namespace
+
+class GatewayHedgingTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        log_ = std::make_shared<CallLog>();
+        manager_ = std::make_unique<GatewayManager>();
+        manager_->initialize();
+        manager_->stop_health_monitoring();
+        manager_->set_route_callback([this](const RequestMetrics& metrics) {
+            std::lock_guard<std::mutex> lock(routed_mutex_);
+            routed_.push_back(metrics);
+        });
+    }
+
+    void add_bridges(std::chrono::milliseconds first_call_delay, std::chrono::milliseconds later_call_delay,
+                     bool first_call_fails = false) {
+        for (const char* name : {"alpha", "beta"}) {
+            manager_->add_provider_adapter(std::make_unique<FakeBridge>(
+                name, log_, first_call_delay, later_call_delay, first_call_fails));
+        }
+    }
+
+    void enable_hedging(std::chrono::milliseconds delay) {
+        HedgingConfig config;
+        config.enabled_ = true;
+        config.default_delay_ = delay;
+        config.min_delay_ = 1ms;
+        manager_->configure_hedging(config);
+    }
+
+    RequestMetrics last_routed() {
+        std::lock_guard<std::mutex> lock(routed_mutex_);
+        return routed_.back();
+    }
+
+    std::shared_ptr<CallLog> log_;
+    std::unique_ptr<GatewayManager> manager_;
+    std::mutex routed_mutex_;
+    std::vector<RequestMetrics> routed_;
+};
+
+TEST_F(GatewayHedgingTest, BackupRequestWinsAndSlowPrimaryIsCancelled) {
+    add_bridges(3000ms, 20ms);
+    enable_hedging(50ms);
+
+    auto start = std::chrono::steady_clock::now();
+    core::Response response = manager_->route_request(make_request());
+    auto elapsed = std::chrono::steady_clock::now() - start;
+
+    ASSERT_TRUE(response.success);
+    EXPECT_LT(elapsed, 1000ms);
+    EXPECT_EQ(log_->calls.load(), 2);
+    EXPECT_NE(last_routed().routing_reasoning_.find("[HEDGED]"), std::string::npos);
+
+    auto metrics = manager_->get_hedging_metrics();
+    EXPECT_EQ(metrics["hedged_requests"], 1u);
+    EXPECT_EQ(metrics["hedge_wins"], 1u);
+    EXPECT_EQ(metrics["cancelled_attempts"], 1u);
+
+    // The loser notices its token and unwinds; the manager waits for it on shutdown
+    manager_->shutdown();
+    EXPECT_EQ(log_->cancelled.load(), 1);
+}
+
+TEST_F(GatewayHedgingTest, FastPrimaryIsNeverHedged) {
+    add_bridges(10ms, 10ms);
+    enable_hedging(500ms);
+
+    core::Response response = manager_->route_request(make_request());
+
+    ASSERT_TRUE(response.success);
+    EXPECT_EQ(log_->calls.load(), 1);
+    EXPECT_EQ(manager_->get_hedging_metrics()["hedges_launched"], 0u);
+}
+
+TEST_F(GatewayHedgingTest, CacheHitsAreRecordedAsGatewayTraffic) {
+    add_bridges(10ms, 10ms);
+    manager_->enable_response_cache(true);
+
+    core::Request request = make_request();
+    request.data["temperature"] = 0;
+    ASSERT_TRUE(manager_->route_request(request).success);
+    core::Response cached = manager_->route_request(request);
+
+    ASSERT_TRUE(cached.success);
+    EXPECT_EQ(cached.provider_name, "response_cache");
+    EXPECT_EQ(log_->calls.load(), 1);
+    EXPECT_EQ(last_routed().provider_name_, "response_cache");
+    EXPECT_TRUE(last_routed().success_);
+    EXPECT_EQ(manager_->get_metrics()["total_requests"], 2u);
+}
+
+TEST_F(GatewayHedgingTest, FailedPrimaryFailsOverWithoutWaitingForTheHedgeDelay) {
+    add_bridges(0ms, 10ms, true);
+    enable_hedging(2000ms);
+
+    auto start = std::chrono::steady_clock::now();
+    core::Response response = manager_->route_request(make_request());
+    auto elapsed = std::chrono::steady_clock::now() - start;
+
+    ASSERT_TRUE(response.success);
+    EXPECT_LT(elapsed, 1000ms);
+    EXPECT_EQ(log_->calls.load(), 2);
+    EXPECT_NE(last_routed().routing_reasoning_.find("[FAILOVER]"), std::string::npos);
+    EXPECT_EQ(manager_->get_hedging_metrics()["hedges_launched"], 0u);
+}
+
+TEST_F(GatewayHedgingTest, HedgeDelayTracksProviderLatencyPercentile) {
+    add_bridges(0ms, 0ms);
+
+    HedgingConfig config;
+    config.enabled_ = false;
+    config.latency_percentile_ = 90.0;
+    config.min_samples_ = 5;
+    config.default_delay_ = 777ms;
+    config.min_delay_ = 1ms;
+    config.max_delay_ = 60ms;
+    manager_->configure_hedging(config);
+
+    EXPECT_EQ(manager_->get_hedge_delay("alpha"), 777ms);
+
+    LatencyWindow window;
+    EXPECT_FALSE(window.percentile(50.0).has_value());
+    for (int i = 1; i <= 100; ++i) {
+        window.record(i);
+    }
+    EXPECT_NEAR(*window.percentile(90.0), 90.0, 1.0);
+    EXPECT_NEAR(*window.percentile(50.0), 50.0, 1.0);
+
+    // Latencies are learned from ordinary (unhedged) traffic
+    for (int i = 0; i < 10; ++i) {
+        ASSERT_TRUE(manager_->route_request(make_request()).success);
+    }
+    auto delay = std::min(manager_->get_hedge_delay("alpha"), manager_->get_hedge_delay("beta"));
+    EXPECT_LE(delay, 60ms);
+    EXPECT_NE(delay, 777ms);
+
+    auto round_trip = HedgingConfig::from_json(config.to_json());
+    EXPECT_EQ(round_trip.min_samples_, 5u);
+    EXPECT_EQ(round_trip.max_delay_, 60ms);
+}
+
+TEST_F(GatewayHedgingTest, AsyncRoutingKeepsManySlowCallsInFlightWithoutThreads) {
+    for (const char* name : {"alpha", "beta"}) {
+        manager_->add_provider_adapter(std::make_unique<EventLoopBridge>(name, log_, 100ms));
+    }
+    EventLoopBridge::blocking_calls_ = 0;
+
+    constexpr int REQUESTS = 200;
+    std::atomic<int> succeeded{0};
+    std::promise<void> all_done;
+    std::atomic<int> remaining{REQUESTS};
+
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < REQUESTS; ++i) {
+        manager_->route_request_async(make_request(), [&](core::Response response) {
+            if (response.success) {
+                succeeded++;
+            }
+            if (--remaining == 0) {
+                all_done.set_value();
+            }
+        });
+    }
+
+    // Two hundred 100ms calls overlap on the one event loop thread
+    ASSERT_EQ(all_done.get_future().wait_for(5s), std::future_status::ready);
+    EXPECT_LT(std::chrono::steady_clock::now() - start, 2000ms);
+    EXPECT_EQ(succeeded.load(), REQUESTS);
+    EXPECT_EQ(EventLoopBridge::blocking_calls_.load(), 0);
+}
+
+TEST_F(GatewayHedgingTest, AsyncRoutingQueuesForASaturatedProviderWithoutBlocking) {
+    manager_->add_provider("synthetic", {
+        {"name", "synthetic"},
+        {"base_url", "https://synthetic.local"},
+        {"max_concurrent_requests", 1},
+        {"max_queued_requests", 4},
+        {"max_queue_wait_ms", 2000}
+    });
+    manager_->add_provider_adapter(std::make_unique<EventLoopBridge>("synthetic", log_, 50ms));
+
+    constexpr int REQUESTS = 3;
+    std::atomic<int> succeeded{0};
+    std::atomic<int> remaining{REQUESTS};
+    std::promise<void> all_done;
+
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < REQUESTS; ++i) {
+        manager_->route_request_async(make_request(), [&](core::Response response) {
+            if (response.success) {
+                succeeded++;
+            }
+            if (--remaining == 0) {
+                all_done.set_value();
+            }
+        });
+    }
+    // Queued requests park on the provider's slot instead of holding up the caller
+    EXPECT_LT(std::chrono::steady_clock::now() - start, 50ms);
+
+    // One slot: the calls run one after another, each taking the slot its predecessor released
+    ASSERT_EQ(all_done.get_future().wait_for(2s), std::future_status::ready);
+    EXPECT_GE(std::chrono::steady_clock::now() - start, 140ms);
+    EXPECT_EQ(succeeded.load(), REQUESTS);
+
+    auto admission = manager_->get_admission_metrics()["synthetic"];
+    EXPECT_EQ(admission["queued"], 2);
+    EXPECT_EQ(admission["rejected_saturated"], 0);
+    EXPECT_EQ(admission["queue_wait_ms"]["count"], 2);
+    EXPECT_EQ(admission["in_flight"], 0);
+}
+
+TEST_F(GatewayHedgingTest, AsyncRoutingFailsOverFromTheCompletion) {
+    for (const char* name : {"alpha", "beta"}) {
+        manager_->add_provider_adapter(std::make_unique<EventLoopBridge>(name, log_, 10ms, true));
+    }
+
+    // Continuations go through the executor, as with AsyncRequestPipeline::post
+    std::atomic<int> executed{0};
+    std::vector<std::thread> executor_threads;
+    std::mutex executor_mutex;
+    auto executor = [&](std::function<void()> task) {
+        executed++;
+        std::lock_guard<std::mutex> lock(executor_mutex);
+        executor_threads.emplace_back(std::move(task));
+    };
+
+    std::promise<core::Response> result;
+    manager_->route_request_async(make_request(), [&](core::Response response) {
+        result.set_value(std::move(response));
+    }, executor);
+
+    auto future = result.get_future();
+    ASSERT_EQ(future.wait_for(2s), std::future_status::ready);
+    core::Response response = future.get();
+
+    EXPECT_TRUE(response.success);
+    EXPECT_EQ(log_->calls.load(), 2);
+    EXPECT_EQ(executed.load(), 2);
+    EXPECT_NE(last_routed().routing_reasoning_.find("[FAILOVER]"), std::string::npos);
+
+    std::lock_guard<std::mutex> lock(executor_mutex);
+    for (auto& thread : executor_threads) {
+        thread.join();
+    }
+}
+
+TEST_F(GatewayHedgingTest, RemovingAProviderKeepsItsBridgeAliveForRequestsInFlight) {
+    auto destroyed = std::make_shared<std::atomic<bool>>(false);
+    manager_->add_provider_adapter(std::make_unique<SelfReferencingBridge>("alpha", destroyed));
+
+    std::promise<core::Response> result;
+    manager_->route_request_async(make_request(), [&](core::Response response) {
+        result.set_value(std::move(response));
+    });
+    manager_->remove_provider_adapter("alpha");
+    EXPECT_FALSE(destroyed->load());
+
+    auto future = result.get_future();
+    ASSERT_EQ(future.wait_for(2s), std::future_status::ready);
+    EXPECT_TRUE(future.get().success);
+
+    // Released with the provider's callback, once it has returned
+    auto deadline = std::chrono::steady_clock::now() + 2s;
+    while (!destroyed->load() && std::chrono::steady_clock::now() < deadline) {
+        std::this_thread::sleep_for(5ms);
+    }
+    EXPECT_TRUE(destroyed->load());
+}
+
+TEST_F(GatewayHedgingTest, AsyncHedgeStartsFromAnEngineTimerWithoutBlockingThreads) {
+    for (const char* name : {"alpha", "beta"}) {
+        manager_->add_provider_adapter(std::make_unique<EventLoopBridge>(name, log_, 20ms, false, 600ms));
+    }
+    enable_hedging(50ms);
+    EventLoopBridge::blocking_calls_ = 0;
+
+    // No executor: the race is started, hedged and decided entirely on the event loop
+    std::promise<core::Response> result;
+    auto start = std::chrono::steady_clock::now();
+    manager_->route_request_async(make_request(), [&](core::Response response) {
+        result.set_value(std::move(response));
+    });
+
+    auto future = result.get_future();
+    ASSERT_EQ(future.wait_for(2s), std::future_status::ready);
+    EXPECT_LT(std::chrono::steady_clock::now() - start, 500ms);
+    EXPECT_TRUE(future.get().success);
+    EXPECT_EQ(log_->calls.load(), 2);
+    EXPECT_EQ(EventLoopBridge::blocking_calls_.load(), 0);
+    EXPECT_NE(last_routed().routing_reasoning_.find("[HEDGED]"), std::string::npos);
+
+    auto metrics = manager_->get_hedging_metrics();
+    EXPECT_EQ(metrics["hedges_launched"], 1u);
+    EXPECT_EQ(metrics["hedge_wins"], 1u);
+    EXPECT_EQ(metrics["cancelled_attempts"], 1u);
+}
+
+TEST(CurlMultiEngineTimerTest, TimersFireInDeadlineOrderWithoutBlockingThreads) {
+    network::CurlMultiEngine engine;
+    std::mutex mutex;
+    std::vector<int> order;
+    std::promise<void> done;
+
+    for (int delay : {40, 10, 25}) {
+        ASSERT_TRUE(engine.schedule(std::chrono::milliseconds(delay), [&, delay](bool fired) {
+            EXPECT_TRUE(fired);
+            std::lock_guard<std::mutex> lock(mutex);
+            order.push_back(delay);
+            if (order.size() == 3) {
+                done.set_value();
+            }
+        }));
+    }
+
+    ASSERT_EQ(done.get_future().wait_for(2s), std::future_status::ready);
+    EXPECT_EQ(order, (std::vector<int>{10, 25, 40}));
+
+    // Timers still pending at shutdown are reported as not fired
+    std::promise<bool> outcome;
+    ASSERT_TRUE(engine.schedule(60s, [&](bool fired) { outcome.set_value(fired); }));
+    engine.shutdown();
+    EXPECT_FALSE(outcome.get_future().get());
+    EXPECT_FALSE(engine.schedule(1ms, [](bool) {}));
+}
@@ -0,0 +1,218 @@
+#include <gtest/gtest.h>
+#include "aimux/network/http_client.hpp"
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <arpa/inet.h>
+#include <poll.h>
+#include <unistd.h>
+#include <atomic>
+#include <future>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace aimux::network;
+
+namespace {
+
+/**
+ * Keep-alive HTTP/1.1 server on loopback answering every request with a
+ * fixed JSON body. Counts accepted connections so tests can see reuse.
+ */
+class LocalUpstream {
+public:
+    LocalUpstream() {
+        listen_fd_ = socket(AF_INET, SOCK_STREAM, 0);
+        int reuse = 1;
+        setsockopt(listen_fd_, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse));
+
+        sockaddr_in addr{};
+        addr.sin_family = AF_INET;
+        addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        bind(listen_fd_, reinterpret_cast<sockaddr*>(&addr), sizeof(addr));
+        listen(listen_fd_, 64);
+
+        socklen_t len = sizeof(addr);
+        getsockname(listen_fd_, reinterpret_cast<sockaddr*>(&addr), &len);
+        port_ = ntohs(addr.sin_port);
+
+        running_ = true;
+        thread_ = std::thread([this]() { run(); });
+    }
+
+    ~LocalUpstream() {
+        running_ = false;
+        thread_.join();
+        for (auto& conn : connections_) {
+            close(conn.fd);
+        }
+        close(listen_fd_);
+    }
+
+    std::string url() const {
+        return "http://127.0.0.1:" + std::to_string(port_) + "/v1/models";
+    }
+
+    int accepted() const { return accepted_.load(); }
+
+private:
+    struct Connection {
+        int fd;
+        std::string inbound;
+    };
+
+    void run() {
+        while (running_) {
+            std::vector<pollfd> fds{{listen_fd_, POLLIN, 0}};
+            for (const auto& conn : connections_) {
+                fds.push_back({conn.fd, POLLIN, 0});
+            }
+            if (poll(fds.data(), fds.size(), 10) <= 0) {
+                continue;
+            }
+            if (fds[0].revents & POLLIN) {
+                connections_.push_back({accept(listen_fd_, nullptr, nullptr), ""});
+                accepted_++;
+            }
+            for (size_t i = 1; i < fds.size(); ++i) {
+                if (fds[i].revents & (POLLIN | POLLHUP)) {
+                    serve(connections_[i - 1]);
+                }
+            }
+            std::erase_if(connections_, [](const Connection& conn) { return conn.fd < 0; });
+        }
+    }
+
+    void serve(Connection& conn) {
+        char buffer[4096];
+        ssize_t got = read(conn.fd, buffer, sizeof(buffer));
+        if (got <= 0) {
+            close(conn.fd);
+            conn.fd = -1;
+            return;
+        }
+        conn.inbound.append(buffer, static_cast<size_t>(got));
+
+        static const std::string reply =
+            "HTTP/1.1 200 OK\r\nContent-Type: application/json\r\n"
+            "Content-Length: 11\r\nConnection: keep-alive\r\n\r\n{\"ok\":true}";
+        size_t end;
+        while ((end = conn.inbound.find("\r\n\r\n")) != std::string::npos) {
+            conn.inbound.erase(0, end + 4);
+            ssize_t written = write(conn.fd, reply.data(), reply.size());
+            (void)written;
+        }
+    }
+
+    int listen_fd_ = -1;
+    int port_ = 0;
+    std::atomic<bool> running_{false};
+    std::atomic<int> accepted_{0};
+    std::thread thread_;
+    std::vector<Connection> connections_;
+};
+
+HttpRequest get_request(const LocalUpstream& upstream) {
+    HttpRequest request;
+    request.url = upstream.url();
+    request.timeout_ms = 5000;
+    return request;
+}
+
+} // namespace
+
+TEST(HttpClientPoolTest, SequentialRequestsReuseOneHandleAndConnection) {
+    LocalUpstream upstream;
+    HttpClient client(4, 5000);
+
+    for (int i = 0; i < 5; ++i) {
+        auto response = client.send_request(get_request(upstream));
+        ASSERT_EQ(response.status_code, 200) << response.error_message;
+        EXPECT_EQ(response.body, "{\"ok\":true}");
+    }
+
+    auto stats = client.get_statistics();
+    EXPECT_EQ(stats["connection_pool"]["handles_created"], 1);
+    EXPECT_EQ(stats["connection_pool"]["idle_connections"], 1);
+    EXPECT_EQ(stats["connections"]["new_connections"], 1);
+    EXPECT_EQ(stats["connections"]["reused_connections"], 4);
+    EXPECT_EQ(upstream.accepted(), 1);
+}
+
+TEST(HttpClientPoolTest, PooledHandlesTakeTheShareLocks) {
+    LocalUpstream upstream;
+    HttpClient client(4, 5000);
+
+    // The event loop and a blocking caller draw from the same pool and share;
+    // back-to-back async transfers reuse the multi handle's connection
+    for (int i = 0; i < 3; ++i) {
+        ASSERT_EQ(client.send_request_future(get_request(upstream)).get().status_code, 200);
+    }
+    uint64_t locks_after_async = client.get_statistics()["connections"]["share_lock_acquisitions"];
+    EXPECT_GT(locks_after_async, 0u);
+
+    ASSERT_EQ(client.send_request(get_request(upstream)).status_code, 200);
+    auto stats = client.get_statistics();
+    EXPECT_GT(stats["connections"]["share_lock_acquisitions"].get<uint64_t>(), locks_after_async);
+    EXPECT_LE(stats["connection_pool"]["handles_created"].get<int>(), 3);
+    EXPECT_GE(stats["connections"]["reused_connections"].get<int>(), 1);
+}
+
+TEST(HttpClientPoolTest, IdleHandlesAreCappedAtMaxConnections) {
+    LocalUpstream upstream;
+    HttpClient client(2, 5000);
+
+    std::vector<std::future<HttpResponse>> futures;
+    for (int i = 0; i < 6; ++i) {
+        futures.push_back(client.send_request_future(get_request(upstream)));
+    }
+    for (auto& future : futures) {
+        ASSERT_EQ(future.get().status_code, 200);
+    }
+    EXPECT_LE(client.get_statistics()["connection_pool"]["idle_connections"].get<int>(), 2);
+
+    client.set_max_connections(8);
+    EXPECT_EQ(client.max_connections(), 8u);
+}
+
+TEST(HttpClientPoolTest, DefaultHeadersCanChangeWhileRequestsAreBuilt) {
+    LocalUpstream upstream;
+    HttpClient client(4, 5000);
+
+    // Shared clients are reconfigured while other threads send through them
+    std::atomic<bool> done{false};
+    std::thread editor([&]() {
+        while (!done) {
+            client.add_default_header("X-Trace", "on");
+            client.remove_default_header("X-Trace");
+        }
+    });
+
+    std::vector<std::future<HttpResponse>> futures;
+    for (int i = 0; i < 8; ++i) {
+        futures.push_back(client.send_request_future(get_request(upstream)));
+    }
+    for (int i = 0; i < 8; ++i) {
+        EXPECT_EQ(client.send_request(get_request(upstream)).status_code, 200);
+    }
+    for (auto& future : futures) {
+        EXPECT_EQ(future.get().status_code, 200);
+    }
+    done = true;
+    editor.join();
+}
+
+TEST(HttpClientFactoryTest, SharedClientTakesTheCallersLimitsAndOnlyGrows) {
+    auto client = HttpClientFactory::get_shared_client("http-client-test@local", 4, 7000);
+    auto stats = client->get_statistics();
+    EXPECT_EQ(stats["connection_pool"]["max_connections"], 4);
+    EXPECT_EQ(stats["connection_pool"]["connect_timeout_ms"], 7000);
+
+    auto larger = HttpClientFactory::get_shared_client("http-client-test@local", 16, 1000);
+    EXPECT_EQ(larger, client);
+    EXPECT_EQ(client->max_connections(), 16u);
+
+    HttpClientFactory::get_shared_client("http-client-test@local", 2);
+    EXPECT_EQ(client->max_connections(), 16u);
+    EXPECT_NE(HttpClientFactory::get_shared_client("http-client-test@other", 4), client);
+}
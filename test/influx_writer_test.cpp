@@ -0,0 +1,347 @@
+#include <gtest/gtest.h>
+#include "aimux/metrics/influx_writer.hpp"
+#include "aimux/metrics/time_series_db.hpp"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <limits>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#ifdef AIMUX_HAVE_ZLIB
+#include <zlib.h>
+#endif
+
+using namespace aimux::metrics;
+using namespace std::chrono_literals;
+
+namespace {
+
+const auto EPOCH_PLUS_1S = std::chrono::system_clock::time_point{} + 1s;
+
+MetricPoint point(const std::string& name, double value) {
+    MetricPoint point;
+    point.name = name;
+    point.type = MetricType::GAUGE;
+    point.value = value;
+    point.timestamp = EPOCH_PLUS_1S;
+    return point;
+}
+
+std::vector<MetricPoint> points(size_t count) {
+    std::vector<MetricPoint> result;
+    for (size_t i = 0; i < count; ++i) {
+        result.push_back(point("requests", static_cast<double>(i)));
+    }
+    return result;
+}
+
+size_t count_lines(std::string_view body) {
+    return static_cast<size_t>(std::count(body.begin(), body.end(), '\n'));
+}
+
+// Records every delivered body; optionally blocks until released
+class RecordingTransport {
+public:
+    InfluxWriteBatcher::Transport transport() {
+        return [this](std::string_view body, bool gzipped) {
+            std::unique_lock<std::mutex> lock(mutex_);
+            calls_++;
+            cv_.notify_all();
+            cv_.wait(lock, [this] { return !blocked_; });
+            if (failures_left_ > 0) {
+                failures_left_--;
+                return false;
+            }
+            bodies_.emplace_back(body);
+            gzipped_ = gzipped;
+            return true;
+        };
+    }
+
+    void block() { std::lock_guard<std::mutex> lock(mutex_); blocked_ = true; }
+    void release() { std::lock_guard<std::mutex> lock(mutex_); blocked_ = false; cv_.notify_all(); }
+    void fail(int times) { std::lock_guard<std::mutex> lock(mutex_); failures_left_ = times; }
+
+    bool wait_for_calls(int calls, std::chrono::milliseconds timeout = 2s) {
+        std::unique_lock<std::mutex> lock(mutex_);
+        return cv_.wait_for(lock, timeout, [&] { return calls_ >= calls; });
+    }
+
+    std::vector<std::string> bodies() { std::lock_guard<std::mutex> lock(mutex_); return bodies_; }
+    int calls() { std::lock_guard<std::mutex> lock(mutex_); return calls_; }
+    bool gzipped() { std::lock_guard<std::mutex> lock(mutex_); return gzipped_; }
+
+private:
+    std::mutex mutex_;
+    std::condition_variable cv_;
+    std::vector<std::string> bodies_;
+    int calls_ = 0;
+    int failures_left_ = 0;
+    bool blocked_ = false;
+    bool gzipped_ = false;
+};
+
+InfluxWriteBatcher::Options plain_options() {
+    InfluxWriteBatcher::Options options;
+    options.gzip = false;
+    options.flush_interval = 10s;     // Only size limits and flush() seal batches
+    options.retry_delay = 1ms;
+    return options;
+}
+
+} // namespace
+
+TEST(LineProtocolEncoderTest, EscapesNamesAndSortsTags) {
+    MetricPoint metric = point("http requests,total", 1.5);
+    metric.tags = {{"zone", "us east"}, {"a=b", "x,y"}, {"empty", ""}};
+    metric.fields = {{"bad", std::numeric_limits<double>::quiet_NaN()}};
+
+    LineProtocolEncoder encoder;
+    std::string out = "prefix\n";
+    ASSERT_TRUE(encoder.append(out, metric));
+    EXPECT_EQ(out, "prefix\nhttp\\ requests\\,total,a\\=b=x\\,y,zone=us\\ east value=1.5 1000000000\n");
+}
+
+TEST(LineProtocolEncoderTest, SkipsPointsWithoutFiniteFields) {
+    LineProtocolEncoder encoder;
+    std::string out = "kept\n";
+    EXPECT_FALSE(encoder.append(out, point("gauge", std::numeric_limits<double>::infinity())));
+    EXPECT_EQ(out, "kept\n");
+
+    MetricPoint metric = point("gauge", std::numeric_limits<double>::quiet_NaN());
+    metric.fields = {{"tokens", 42.0}};
+    EXPECT_TRUE(encoder.append(out, metric));
+    EXPECT_EQ(out, "kept\ngauge tokens=42 1000000000\n");
+}
+
+TEST(LineProtocolEncoderTest, EncodesEvents) {
+    PrettificationEvent event{};
+    event.plugin_name = "toon";
+    event.provider = "cerebras";
+    event.model = "";
+    event.input_format = "json";
+    event.output_format = "text\nplain";
+    event.processing_time_ms = 2.25;
+    event.input_size_bytes = 100;
+    event.output_size_bytes = 80;
+    event.success = false;
+    event.error_type = "bad \"quote\" \\";
+    event.tokens_processed = 7;
+    event.timestamp = EPOCH_PLUS_1S;
+
+    LineProtocolEncoder encoder;
+    std::string out;
+    ASSERT_TRUE(encoder.append(out, event));
+    EXPECT_EQ(out,
+              "prettification_events,input_format=json,output_format=text\\ plain,plugin=toon,provider=cerebras "
+              "processing_time_ms=2.25,input_size_bytes=100,output_size_bytes=80,success=false,"
+              "tokens_processed=7,error_type=\"bad \\\"quote\\\" \\\\\" 1000000000\n");
+}
+
+TEST(InfluxWriteBatcherTest, SealsBatchesAtLineAndByteLimits) {
+    RecordingTransport endpoint;
+    auto options = plain_options();
+    options.max_lines = 3;
+    {
+        InfluxWriteBatcher batcher(options, endpoint.transport());
+        EXPECT_EQ(batcher.add(points(7)), 7u);
+        ASSERT_TRUE(batcher.flush());
+
+        auto bodies = endpoint.bodies();
+        ASSERT_EQ(bodies.size(), 3u);
+        EXPECT_EQ(count_lines(bodies[0]), 3u);
+        EXPECT_EQ(count_lines(bodies[1]), 3u);
+        EXPECT_EQ(count_lines(bodies[2]), 1u);
+
+        auto stats = batcher.get_stats();
+        EXPECT_EQ(stats.lines_accepted, 7u);
+        EXPECT_EQ(stats.lines_sent, 7u);
+        EXPECT_EQ(stats.batches_sent, 3u);
+        EXPECT_EQ(stats.bytes_sent, stats.bytes_encoded);
+    }
+
+    RecordingTransport by_size;
+    options.max_lines = 1000;
+    options.max_bytes = 64;       // Each "requests value=N 1000000000\n" line is ~30 bytes
+    InfluxWriteBatcher batcher(options, by_size.transport());
+    batcher.add(points(6));
+    ASSERT_TRUE(batcher.flush());
+    auto bodies = by_size.bodies();
+    ASSERT_EQ(bodies.size(), 2u);
+    EXPECT_EQ(count_lines(bodies[0]), 3u);
+    EXPECT_GE(bodies[0].size(), 64u);
+}
+
+TEST(InfluxWriteBatcherTest, FlushesOpenBatchAfterInterval) {
+    RecordingTransport endpoint;
+    auto options = plain_options();
+    options.flush_interval = 20ms;
+    InfluxWriteBatcher batcher(options, endpoint.transport());
+
+    batcher.add(points(2));
+    ASSERT_TRUE(endpoint.wait_for_calls(1));
+    auto bodies = endpoint.bodies();
+    ASSERT_EQ(bodies.size(), 1u);
+    EXPECT_EQ(count_lines(bodies[0]), 2u);
+}
+
+TEST(InfluxWriteBatcherTest, DestructorDeliversPendingLines) {
+    RecordingTransport endpoint;
+    {
+        InfluxWriteBatcher batcher(plain_options(), endpoint.transport());
+        batcher.add(points(5));
+    }
+    auto bodies = endpoint.bodies();
+    ASSERT_EQ(bodies.size(), 1u);
+    EXPECT_EQ(count_lines(bodies[0]), 5u);
+}
+
+TEST(InfluxWriteBatcherTest, SlowEndpointDropsOldestBatchesWithoutBlocking) {
+    RecordingTransport endpoint;
+    auto options = plain_options();
+    options.max_lines = 1;
+    options.max_pending_batches = 2;
+    InfluxWriteBatcher batcher(options, endpoint.transport());
+
+    endpoint.block();
+    batcher.add(points(1));
+    ASSERT_TRUE(endpoint.wait_for_calls(1));    // First batch is stuck in the transport
+
+    auto started = std::chrono::steady_clock::now();
+    for (int i = 0; i < 9; ++i) {
+        batcher.add(points(1));
+    }
+    EXPECT_LT(std::chrono::steady_clock::now() - started, 500ms);
+
+    auto stats = batcher.get_stats();
+    EXPECT_EQ(stats.pending_batches, 2u);
+    EXPECT_EQ(stats.lines_dropped, 7u);
+
+    endpoint.release();
+    ASSERT_TRUE(batcher.flush());
+    stats = batcher.get_stats();
+    EXPECT_EQ(stats.lines_accepted, 10u);
+    EXPECT_EQ(stats.lines_sent, 3u);
+    EXPECT_EQ(stats.lines_dropped, 7u);
+    EXPECT_EQ(stats.pending_lines, 0u);
+}
+
+TEST(InfluxWriteBatcherTest, RetriesFailedSendsThenCountsThemDropped) {
+    RecordingTransport endpoint;
+    auto options = plain_options();
+    options.max_retries = 3;
+    InfluxWriteBatcher batcher(options, endpoint.transport());
+
+    endpoint.fail(2);
+    batcher.add(points(4));
+    ASSERT_TRUE(batcher.flush());
+    EXPECT_EQ(endpoint.calls(), 3);
+    EXPECT_EQ(batcher.get_stats().lines_sent, 4u);
+    EXPECT_EQ(batcher.get_stats().batches_failed, 0u);
+
+    endpoint.fail(10);
+    batcher.add(points(2));
+    ASSERT_TRUE(batcher.flush());
+    EXPECT_EQ(endpoint.calls(), 3 + 4);          // First attempt plus three retries
+    auto stats = batcher.get_stats();
+    EXPECT_EQ(stats.batches_failed, 1u);
+    EXPECT_EQ(stats.lines_dropped, 2u);
+    EXPECT_EQ(stats.lines_sent, 4u);
+}
+
+#ifdef AIMUX_HAVE_ZLIB
+TEST(InfluxWriteBatcherTest, GzippedBodiesInflateToLineProtocol) {
+    RecordingTransport endpoint;
+    auto options = plain_options();
+    options.gzip = true;
+    InfluxWriteBatcher batcher(options, endpoint.transport());
+    ASSERT_TRUE(batcher.compresses());
+
+    auto metrics = points(500);
+    std::string expected;
+    LineProtocolEncoder encoder;
+    for (const auto& metric : metrics) {
+        encoder.append(expected, metric);
+    }
+
+    // Two batches exercise reuse of the deflate stream
+    for (int round = 0; round < 2; ++round) {
+        batcher.add(metrics);
+        ASSERT_TRUE(batcher.flush());
+    }
+    ASSERT_TRUE(endpoint.gzipped());
+
+    for (const auto& body : endpoint.bodies()) {
+        EXPECT_LT(body.size(), expected.size() / 4);
+
+        z_stream stream{};
+        ASSERT_EQ(inflateInit2(&stream, 15 + 16), Z_OK);
+        std::string inflated(expected.size() * 2, '\0');
+        stream.next_in = reinterpret_cast<Bytef*>(const_cast<char*>(body.data()));
+        stream.avail_in = static_cast<uInt>(body.size());
+        stream.next_out = reinterpret_cast<Bytef*>(inflated.data());
+        stream.avail_out = static_cast<uInt>(inflated.size());
+        EXPECT_EQ(inflate(&stream, Z_FINISH), Z_STREAM_END);
+        inflated.resize(stream.total_out);
+        inflateEnd(&stream);
+        EXPECT_EQ(inflated, expected);
+    }
+    auto stats = batcher.get_stats();
+    EXPECT_EQ(stats.bytes_encoded, 2 * expected.size());
+    EXPECT_LT(stats.bytes_sent, stats.bytes_encoded);
+}
+#endif
+
+TEST(InfluxDB2ClientWriteTest, WritesGoThroughTheBatcher) {
+    TSDBConfig config;
+    config.enable_compression = false;
+    config.flush_interval = 10s;
+    InfluxDB2Client client(config);
+
+    RecordingTransport endpoint;
+    client.set_write_transport(endpoint.transport());
+    ASSERT_TRUE(client.write_metrics(points(3)));
+
+    PrettificationEvent event{};
+    event.plugin_name = "toon";
+    event.success = true;
+    event.timestamp = EPOCH_PLUS_1S;
+    ASSERT_TRUE(client.write_events({event}));
+    ASSERT_TRUE(client.flush_writes());
+
+    auto bodies = endpoint.bodies();
+    ASSERT_EQ(bodies.size(), 1u);
+    EXPECT_EQ(count_lines(bodies[0]), 4u);
+    EXPECT_NE(bodies[0].find("prettification_events,plugin=toon "), std::string::npos);
+
+    auto status = client.get_status();
+    EXPECT_EQ(status["compression"], "none");
+    EXPECT_EQ(status["writes"]["lines_sent"], 4);
+}
+
+TEST(InfluxDB2ClientWriteTest, DroppedBatchesFailTheNextWrite) {
+    TSDBConfig config;
+    config.enable_compression = false;
+    config.flush_interval = 10s;
+    config.max_retries = 0;
+    InfluxDB2Client client(config);
+
+    RecordingTransport endpoint;
+    client.set_write_transport(endpoint.transport());
+    endpoint.fail(1);
+    ASSERT_TRUE(client.write_metrics(points(2)));
+    ASSERT_TRUE(client.flush_writes());
+    ASSERT_EQ(client.get_write_stats().lines_dropped, 2u);
+
+    // The loss is reported once, then writes succeed again
+    EXPECT_FALSE(client.write_metrics(points(1)));
+    EXPECT_TRUE(client.write_metrics(points(1)));
+
+    // Nothing encodable is a failure too
+    EXPECT_FALSE(client.write_metrics({point("nan", std::numeric_limits<double>::quiet_NaN())}));
+    EXPECT_TRUE(client.write_metrics({}));
+}
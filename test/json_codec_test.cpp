@@ -0,0 +1,92 @@
+#include <gtest/gtest.h>
+#include "aimux/core/router.hpp"
+#include "aimux/core/json_codec.hpp"
+#include <string>
+#include <thread>
+
+using namespace aimux::core;
+
+TEST(JsonCodecTest, ResponseParsesOnceAndCopiesShareTheDocument) {
+    JsonCodecScope scope;
+
+    Response response;
+    response.success = true;
+    response.data = R"({"id": "msg_1", "content": [{"type": "text", "text": "hi"}]})";
+
+    const nlohmann::json* first = response.json();
+    ASSERT_NE(first, nullptr);
+    EXPECT_EQ((*first)["id"], "msg_1");
+
+    Response copy = response;
+    EXPECT_EQ(copy.json(), first);
+    EXPECT_EQ(response.json(), first);
+
+    auto work = scope.counters();
+    EXPECT_EQ(work.parses, 1u);
+    EXPECT_EQ(work.reuses, 2u);
+    EXPECT_EQ(work.bytes_parsed, response.data.size());
+}
+
+TEST(JsonCodecTest, NewBodyIsNeverServedFromAStaleDocument) {
+    Response response;
+    response.data = R"({"value": 1})";
+    ASSERT_EQ((*response.json())["value"], 1);
+
+    // Same length, different bytes
+    response.set_data(R"({"value": 2})");
+    ASSERT_NE(response.json(), nullptr);
+    EXPECT_EQ((*response.json())["value"], 2);
+
+    // A copy keeps the document of the body it was copied with
+    Response copy = response;
+    copy.set_data(R"({"value": 3})");
+    EXPECT_EQ((*copy.json())["value"], 3);
+    EXPECT_EQ((*response.json())["value"], 2);
+
+    // Direct writes that change the length are still caught
+    response.data = R"({"value": 42})";
+    EXPECT_EQ((*response.json())["value"], 42);
+
+    response.data = "not json";
+    EXPECT_EQ(response.json(), nullptr);
+
+    JsonCodecScope scope;
+    EXPECT_EQ(response.json(), nullptr);
+    EXPECT_EQ(scope.counters().parses, 0u);
+}
+
+TEST(JsonCodecTest, SetJsonKeepsTheDocumentItSerialized) {
+    JsonCodecScope scope;
+
+    Response response;
+    response.set_json({{"type", "message"}, {"stop_reason", "end_turn"}});
+    EXPECT_EQ(response.data, R"({"stop_reason":"end_turn","type":"message"})");
+
+    const nlohmann::json* document = response.json();
+    ASSERT_NE(document, nullptr);
+    EXPECT_EQ((*document)["type"], "message");
+
+    auto work = scope.counters();
+    EXPECT_EQ(work.parses, 0u);
+    EXPECT_EQ(work.dumps, 1u);
+    EXPECT_EQ(work.reuses, 1u);
+}
+
+TEST(JsonCodecTest, CountersArePerThread) {
+    JsonCodecScope scope;
+    parse_json(R"([1, 2, 3])");
+    EXPECT_TRUE(try_parse_json("{oops").is_discarded());
+    dump_json(nlohmann::json::object());
+
+    std::thread other([]() {
+        JsonCodecScope other_scope;
+        parse_json("{}");
+        EXPECT_EQ(other_scope.counters().parses, 1u);
+    });
+    other.join();
+
+    auto work = scope.counters();
+    EXPECT_EQ(work.parses, 2u);
+    EXPECT_EQ(work.dumps, 1u);
+    EXPECT_EQ(work.to_json()["bytes_dumped"], 2u);
+}
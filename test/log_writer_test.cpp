@@ -0,0 +1,219 @@
+#include <gtest/gtest.h>
+#include "aimux/logging/log_writer.hpp"
+#include "aimux/logging/logger.hpp"
+#include <atomic>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace aimux::logging;
+using namespace std::chrono_literals;
+
+namespace {
+
+std::vector<nlohmann::json> read_lines(const std::filesystem::path& path) {
+    std::vector<nlohmann::json> lines;
+    std::ifstream file(path);
+    std::string line;
+    while (std::getline(file, line)) {
+        lines.push_back(nlohmann::json::parse(line));
+    }
+    return lines;
+}
+
+std::shared_ptr<const LogTarget> file_target(const std::filesystem::path& path, const std::string& name = "test") {
+    auto target = std::make_shared<LogTarget>();
+    target->logger_name = name;
+    target->console = false;
+    target->log_file = path.string();
+    return target;
+}
+
+LogRecord make_record(std::shared_ptr<const LogTarget> target, const std::string& message,
+                      LogLevel level = LogLevel::INFO) {
+    return LogRecord{std::move(target), level, std::chrono::system_clock::now(), message, {}};
+}
+
+} // namespace
+
+class LogWriterTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        dir_ = std::filesystem::temp_directory_path() /
+               ("aimux_log_writer_" + std::to_string(::testing::UnitTest::GetInstance()->random_seed()) + "_" +
+                ::testing::UnitTest::GetInstance()->current_test_info()->name());
+        std::filesystem::remove_all(dir_);
+        std::filesystem::create_directories(dir_);
+    }
+
+    void TearDown() override {
+        std::filesystem::remove_all(dir_);
+    }
+
+    std::filesystem::path dir_;
+};
+
+TEST_F(LogWriterTest, FormatsTheStructuredLine) {
+    auto target = std::make_shared<LogTarget>();
+    target->logger_name = "gateway";
+    target->default_fields = {{"service", "aimux"}};
+
+    LogRecord record{target, LogLevel::WARN, std::chrono::system_clock::time_point{} + 1'700'000'000'123ms,
+                     "slow provider", {{"provider", "zai"}}};
+    std::string line;
+    LogWriter::format(record, line);
+
+    ASSERT_EQ(line.back(), '\n');
+    auto entry = nlohmann::json::parse(line);
+    EXPECT_EQ(entry["timestamp"], "2023-11-14T22:13:20.123Z");
+    EXPECT_EQ(entry["level"], 3);
+    EXPECT_EQ(entry["level_name"], "WARN");
+    EXPECT_EQ(entry["message"], "slow provider");
+    EXPECT_EQ(entry["logger"], "gateway");
+    EXPECT_EQ(entry["service"], "aimux");
+    EXPECT_EQ(entry["data"]["provider"], "zai");
+
+    // No "data" member without data, and invalid UTF-8 does not throw
+    line.clear();
+    LogWriter::format(LogRecord{target, LogLevel::INFO, {}, "bad \xff byte", {}}, line);
+    auto plain = nlohmann::json::parse(line);
+    EXPECT_FALSE(plain.contains("data"));
+}
+
+TEST_F(LogWriterTest, WritesRecordsInOrderAcrossFiles) {
+    LogWriter writer(LogWriter::Options{});
+    auto first = file_target(dir_ / "first.log", "first");
+    auto second = file_target(dir_ / "second.log", "second");
+
+    for (int i = 0; i < 500; ++i) {
+        ASSERT_TRUE(writer.submit(make_record(i % 2 ? second : first, "line " + std::to_string(i))));
+    }
+    ASSERT_TRUE(writer.flush());
+
+    auto first_lines = read_lines(dir_ / "first.log");
+    auto second_lines = read_lines(dir_ / "second.log");
+    ASSERT_EQ(first_lines.size(), 250u);
+    ASSERT_EQ(second_lines.size(), 250u);
+    for (size_t i = 0; i < 250; ++i) {
+        EXPECT_EQ(first_lines[i]["message"], "line " + std::to_string(2 * i));
+        EXPECT_EQ(second_lines[i]["message"], "line " + std::to_string(2 * i + 1));
+        EXPECT_EQ(second_lines[i]["logger"], "second");
+    }
+
+    auto stats = writer.get_stats();
+    EXPECT_EQ(stats.records_written, 500u);
+    EXPECT_EQ(stats.records_dropped, 0u);
+    // Batched: far fewer system calls than lines
+    EXPECT_LT(stats.write_calls, 500u);
+}
+
+TEST_F(LogWriterTest, RotatesFilesAboveTheSizeLimit) {
+    LogWriter::Options options;
+    options.max_file_bytes = 4096;
+    options.max_files = 2;
+    LogWriter writer(options);
+    auto target = file_target(dir_ / "rotating.log");
+
+    for (int i = 0; i < 400; ++i) {
+        ASSERT_TRUE(writer.submit(make_record(target, "entry " + std::to_string(i))));
+        if (i % 50 == 49) {
+            ASSERT_TRUE(writer.flush());
+        }
+    }
+    ASSERT_TRUE(writer.flush());
+
+    EXPECT_GT(writer.get_stats().rotations, 0u);
+    EXPECT_TRUE(std::filesystem::exists(dir_ / "rotating.log.1"));
+    EXPECT_TRUE(std::filesystem::exists(dir_ / "rotating.log.2"));
+    EXPECT_FALSE(std::filesystem::exists(dir_ / "rotating.log.3"));
+    EXPECT_LE(std::filesystem::file_size(dir_ / "rotating.log"), 4096u);
+    EXPECT_LE(std::filesystem::file_size(dir_ / "rotating.log.1"), 4096u);
+
+    // The newest entries are in the live file
+    auto lines = read_lines(dir_ / "rotating.log");
+    ASSERT_FALSE(lines.empty());
+    EXPECT_EQ(lines.back()["message"], "entry 399");
+}
+
+TEST_F(LogWriterTest, FullRingDropsAndCountsInsteadOfBlocking) {
+    LogWriter::Options options;
+    options.ring_capacity = 8;
+    LogWriter writer(options);
+    auto target = file_target(dir_ / "burst.log");
+
+    constexpr int THREADS = 4;
+    constexpr int PER_THREAD = 5000;
+    std::atomic<uint64_t> accepted{0};
+    std::vector<std::thread> producers;
+    for (int t = 0; t < THREADS; ++t) {
+        producers.emplace_back([&, t] {
+            for (int i = 0; i < PER_THREAD; ++i) {
+                if (writer.submit(make_record(target, std::to_string(t) + ":" + std::to_string(i)))) {
+                    accepted++;
+                }
+            }
+        });
+    }
+    for (auto& producer : producers) {
+        producer.join();
+    }
+    ASSERT_TRUE(writer.flush());
+
+    auto stats = writer.get_stats();
+    EXPECT_GT(stats.records_dropped, 0u);
+    EXPECT_EQ(stats.records_submitted, accepted.load());
+    EXPECT_EQ(stats.records_submitted + stats.records_dropped, static_cast<uint64_t>(THREADS) * PER_THREAD);
+    EXPECT_EQ(stats.records_written, stats.records_submitted);
+    EXPECT_EQ(read_lines(dir_ / "burst.log").size(), stats.records_written);
+}
+
+TEST_F(LogWriterTest, StopDrainsAndLaterRecordsAreWrittenInline) {
+    auto writer = std::make_unique<LogWriter>(LogWriter::Options{});
+    auto target = file_target(dir_ / "stop.log");
+
+    for (int i = 0; i < 100; ++i) {
+        writer->submit(make_record(target, "before"));
+    }
+    writer->stop();
+    EXPECT_EQ(read_lines(dir_ / "stop.log").size(), 100u);
+
+    EXPECT_TRUE(writer->submit(make_record(target, "after")));
+    auto lines = read_lines(dir_ / "stop.log");
+    ASSERT_EQ(lines.size(), 101u);
+    EXPECT_EQ(lines.back()["message"], "after");
+}
+
+TEST_F(LogWriterTest, LoggerSkipsFilteredLevelsAndWritesThroughTheWriter) {
+    Logger logger("log_writer_test", (dir_ / "logger.log").string());
+    logger.set_console_enabled(false);
+    logger.set_level(LogLevel::INFO);
+    logger.add_default_field("component", "test");
+
+    int evaluated = 0;
+    auto build = [&evaluated](const std::string& text) {
+        evaluated++;
+        return text;
+    };
+
+    AIMUX_LOG_DEBUG(logger, build("filtered"));
+    AIMUX_LOG_INFO(logger, build("kept"), {{"n", 1}});
+    EXPECT_EQ(evaluated, 1);
+    EXPECT_FALSE(AIMUX_LOG_ENABLED(logger, LogLevel::DEBUG));
+    EXPECT_TRUE(AIMUX_LOG_ENABLED(logger, LogLevel::ERROR));
+
+    logger.remove_default_field("component");
+    logger.warn("no component");
+    logger.flush();
+
+    auto lines = read_lines(dir_ / "logger.log");
+    ASSERT_EQ(lines.size(), 2u);
+    EXPECT_EQ(lines[0]["message"], "kept");
+    EXPECT_EQ(lines[0]["component"], "test");
+    EXPECT_EQ(lines[0]["data"]["n"], 1);
+    EXPECT_EQ(lines[1]["message"], "no component");
+    EXPECT_FALSE(lines[1].contains("component"));
+    EXPECT_EQ(logger.get_statistics()["dropped_entries"], 0);
+}
@@ -4,6 +4,8 @@
 #include <chrono>
 #include <memory>
 #include <random>
+#include <map>
+#include <unordered_set>
 #include "aimux/metrics/metrics_collector.hpp"
 #include "aimux/metrics/time_series_db.hpp"
 
@@ -26,6 +28,14 @@ public:
     MOCK_METHOD(bool, drop_database, (const std::string&), (override));
     MOCK_METHOD(std::vector<std::string>, list_databases, (), (override));
 
+    bool write_metrics(const std::vector<MetricPoint>& metrics) override {
+        return write_metrics_sync(metrics);
+    }
+
+    bool write_events(const std::vector<PrettificationEvent>& events) override {
+        return write_events_sync(events);
+    }
+
     bool write_metrics_sync(const std::vector<MetricPoint>& metrics) override {
         stored_metrics_.insert(stored_metrics_.end(), metrics.begin(), metrics.end());
         return true;
@@ -244,11 +254,17 @@ TEST_F(MetricsCollectorTest, SamplingRate) {
 
     sampling_collector->flush();
 
-    auto stored_metrics = sampling_collector->get_stored_metrics();
+    // Counters are stored pre-aggregated; their summed values count the sampled records
+    double sampled = 0.0;
+    for (const auto& metric : sampling_collector->get_stored_metrics()) {
+        if (metric.name == "sampled_metric") {
+            sampled += metric.value;
+        }
+    }
 
     // Should have approximately 10% of the metrics (with some tolerance)
-    EXPECT_GT(stored_metrics.size(), 50);
-    EXPECT_LT(stored_metrics.size(), 150);
+    EXPECT_GT(sampled, 50);
+    EXPECT_LT(sampled, 150);
 }
 
 TEST_F(MetricsCollectorTest, StressTestHighThroughput) {
@@ -276,23 +292,27 @@ TEST_F(MetricsCollectorTest, StressTestHighThroughput) {
     auto end_time = std::chrono::high_resolution_clock::now();
     auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(end_time - start_time);
 
+    // One aggregated point per tag set and flush, carrying the record count
     auto stored_metrics = collector_->get_stored_metrics();
-    EXPECT_EQ(stored_metrics.size(), num_threads * metrics_per_thread);
+    EXPECT_GE(stored_metrics.size(), static_cast<size_t>(num_threads));
 
     // Verify performance requirement: should finish within reasonable time
     EXPECT_LT(duration.count(), 5000); // Less than 5 seconds for 100k metrics
 
     // Verify all thread values are present
-    std::unordered_set<int> thread_ids;
+    std::map<int, double> records_per_thread;
     for (const auto& metric : stored_metrics) {
         if (metric.name == "stress_test") {
             auto thread_it = metric.tags.find("thread");
             if (thread_it != metric.tags.end()) {
-                thread_ids.insert(std::stoi(thread_it->second));
+                records_per_thread[std::stoi(thread_it->second)] += metric.fields.at("count");
             }
         }
     }
-    EXPECT_EQ(thread_ids.size(), num_threads);
+    EXPECT_EQ(records_per_thread.size(), num_threads);
+    for (const auto& [thread_id, records] : records_per_thread) {
+        EXPECT_EQ(records, metrics_per_thread) << thread_id;
+    }
 }
 
 TEST_F(MetricsCollectorTest, MemoryUsage) {
@@ -300,16 +320,27 @@ TEST_F(MetricsCollectorTest, MemoryUsage) {
     collector_->clear_stored_data();
     size_t initial_count = collector_->get_stored_metrics().size();
 
-    // Add a large number of metrics
+    // Add a large number of metrics; storage grows with series, not records
     const int large_count = 50000;
+    const int series_count = 100;
     for (int i = 0; i < large_count; ++i) {
         collector_->record_gauge("memory_test", static_cast<double>(i),
-            {{"index", std::to_string(i)}});
+            {{"index", std::to_string(i % series_count)}});
     }
 
     collector_->flush();
     auto stored_metrics = collector_->get_stored_metrics();
-    EXPECT_EQ(stored_metrics.size(), large_count);
+    EXPECT_GE(stored_metrics.size(), static_cast<size_t>(series_count));
+
+    double records = 0.0;
+    std::unordered_set<std::string> indexes;
+    for (const auto& metric : stored_metrics) {
+        records += metric.fields.at("count");
+        indexes.insert(metric.tags.at("index"));
+    }
+    EXPECT_EQ(records, large_count);
+    EXPECT_EQ(indexes.size(), static_cast<size_t>(series_count));
+    EXPECT_EQ(collector_->get_status()["series_count"], series_count);
 
     // Clear and verify memory is freed
     collector_->clear_stored_data();
@@ -382,6 +413,139 @@ TEST_F(MetricsCollectorTest, ConcurrencySafety) {
     }
 }
 
+TEST_F(MetricsCollectorTest, HandlesAreInternedPerNameTypeAndTags) {
+    auto first = collector_->register_metric("requests", MetricType::COUNTER, {{"provider", "a"}, {"model", "m"}});
+    auto again = collector_->register_metric("requests", MetricType::COUNTER, {{"model", "m"}, {"provider", "a"}});
+    auto other_tags = collector_->register_metric("requests", MetricType::COUNTER, {{"provider", "b"}});
+    auto other_type = collector_->register_metric("requests", MetricType::GAUGE, {{"provider", "a"}, {"model", "m"}});
+
+    ASSERT_TRUE(first.valid());
+    EXPECT_EQ(first.id(), again.id());
+    EXPECT_NE(first.id(), other_tags.id());
+    EXPECT_NE(first.id(), other_type.id());
+    EXPECT_FALSE(MetricHandle().valid());
+
+    for (int i = 0; i < 10; ++i) {
+        collector_->record(first, 2.0);
+    }
+    collector_->record(other_tags, 1.0);
+    collector_->record(MetricHandle(), 100.0);   // Ignored
+
+    auto stats = collector_->get_real_time_stats({"requests"});
+    ASSERT_EQ(stats.size(), 1u);
+    EXPECT_EQ(stats[0].type, MetricType::COUNTER);
+    EXPECT_EQ(stats[0].count, 11);
+    EXPECT_EQ(stats[0].sum, 21.0);
+}
+
+TEST_F(MetricsCollectorTest, SeriesCardinalityIsBounded) {
+    MetricsCollector::Config config;
+    config.max_series = 8;
+    InMemoryMetricsCollector bounded(config);
+
+    for (int i = 0; i < 20; ++i) {
+        bounded.record_gauge("per_user", 1.0, {{"user", std::to_string(i)}});
+    }
+    bounded.flush();
+
+    EXPECT_EQ(bounded.get_stored_metrics().size(), 8u);
+    auto status = bounded.get_status();
+    EXPECT_EQ(status["series_count"], 8);
+    EXPECT_EQ(status["dropped_series"], 12);
+    EXPECT_FALSE(bounded.register_metric("another", MetricType::COUNTER).valid());
+}
+
+TEST_F(MetricsCollectorTest, FlushStoresDeltasSinceLastFlush) {
+    auto handle = collector_->register_metric("latency_ms", MetricType::HISTOGRAM);
+    for (int i = 1; i <= 100; ++i) {
+        collector_->record(handle, static_cast<double>(i));
+    }
+    collector_->flush();
+    collector_->flush();   // Nothing new: no point
+
+    collector_->record(handle, 1000.0);
+    collector_->flush();
+
+    double records = 0.0;
+    std::vector<MetricPoint> points;
+    for (const auto& metric : collector_->get_stored_metrics()) {
+        if (metric.name == "latency_ms") {
+            points.push_back(metric);
+            records += metric.fields.at("count");
+        }
+    }
+    EXPECT_EQ(records, 101.0);
+    ASSERT_GE(points.size(), 2u);
+
+    const auto& last = points.back();
+    EXPECT_EQ(last.fields.at("count"), 1.0);
+    EXPECT_EQ(last.value, 1000.0);
+    EXPECT_EQ(last.fields.at("max"), 1000.0);
+    EXPECT_NEAR(last.fields.at("p50"), 50.0, 3.0);   // Percentiles cover the series lifetime
+}
+
+TEST_F(MetricsCollectorTest, RecordsFromExitedThreadsAreKept) {
+    auto handle = collector_->register_metric("worker_ms", MetricType::TIMER);
+
+    for (int round = 0; round < 3; ++round) {
+        std::vector<std::thread> threads;
+        for (int t = 0; t < 4; ++t) {
+            threads.emplace_back([&] {
+                for (int i = 0; i < 1000; ++i) {
+                    collector_->record(handle, std::chrono::milliseconds(2));
+                }
+            });
+        }
+        for (auto& thread : threads) {
+            thread.join();
+        }
+        collector_->flush();
+    }
+
+    auto stats = collector_->get_real_time_stats({"worker_ms"});
+    ASSERT_EQ(stats.size(), 1u);
+    EXPECT_EQ(stats[0].type, MetricType::TIMER);
+    EXPECT_EQ(stats[0].count, 12000);
+    EXPECT_NEAR(stats[0].mean, 2.0, 1e-9);
+    EXPECT_NEAR(stats[0].p99, 2.0, 0.15);
+    EXPECT_LE(collector_->get_status()["recording_threads"], 1);
+}
+
+TEST(MpscQueueTest, DrainsEveryPushOncePerProducerOrder) {
+    MpscQueue<std::pair<int, int>> queue;
+    constexpr int PRODUCERS = 4;
+    constexpr int PER_PRODUCER = 20000;
+
+    std::vector<int> next(PRODUCERS, 0);
+    size_t drained = 0;
+    bool in_order = true;
+    auto consume = [&](std::pair<int, int>&& item) {
+        in_order = in_order && item.second == next[item.first];
+        next[item.first] = item.second + 1;
+        drained++;
+    };
+
+    std::vector<std::thread> producers;
+    for (int p = 0; p < PRODUCERS; ++p) {
+        producers.emplace_back([&queue, p] {
+            for (int i = 0; i < PER_PRODUCER; ++i) {
+                queue.push({p, i});
+            }
+        });
+    }
+    while (drained < PRODUCERS * PER_PRODUCER) {
+        queue.drain(consume);
+    }
+    for (auto& producer : producers) {
+        producer.join();
+    }
+
+    EXPECT_TRUE(in_order);
+    EXPECT_EQ(queue.drain(consume), 0u);
+    EXPECT_EQ(queue.size(), 0u);
+    EXPECT_TRUE(queue.empty());
+}
+
 TEST_F(MetricsCollectorTest, StatusAndConfiguration) {
     auto status = collector_->get_status();
     EXPECT_TRUE(status.contains("collecting"));
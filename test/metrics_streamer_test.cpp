@@ -0,0 +1,279 @@
+#include <gtest/gtest.h>
+#include "aimux/webui/metrics_streamer.hpp"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace aimux::webui;
+using namespace std::chrono_literals;
+
+namespace {
+
+/**
+ * WebSocket connection that records every text frame sent to it.
+ */
+class FakeConnection : public crow::websocket::connection {
+public:
+    void send_text(std::string msg) override {
+        std::lock_guard<std::mutex> lock(mutex_);
+        frames_.push_back(nlohmann::json::parse(msg));
+        raw_.push_back(std::move(msg));
+    }
+    void send_binary(std::string) override {}
+    void send_ping(std::string) override {}
+    void send_pong(std::string) override {}
+    void close(std::string const&, uint16_t) override {}
+    std::string get_remote_ip() override { return "127.0.0.1"; }
+    std::string get_subprotocol() const override { return ""; }
+
+    std::vector<nlohmann::json> frames() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return frames_;
+    }
+
+    std::vector<std::string> raw() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return raw_;
+    }
+
+private:
+    mutable std::mutex mutex_;
+    std::vector<nlohmann::json> frames_;
+    std::vector<std::string> raw_;
+};
+
+bool is_broadcast(const nlohmann::json& frame) {
+    std::string type = frame.value("update_type", "");
+    return type == "comprehensive_metrics" || type == "metrics_delta";
+}
+
+// Broadcast frames received after the "subscribed" reply (all of them without one)
+std::vector<nlohmann::json> broadcasts_after_subscribe(const FakeConnection& conn) {
+    auto frames = conn.frames();
+    auto subscribed = std::find_if(frames.begin(), frames.end(), [](const nlohmann::json& frame) {
+        return frame.value("type", "") == "subscribed";
+    });
+    auto from = subscribed == frames.end() ? frames.begin() : subscribed + 1;
+
+    std::vector<nlohmann::json> result;
+    std::copy_if(from, frames.end(), std::back_inserter(result), is_broadcast);
+    return result;
+}
+
+bool wait_for(const std::function<bool()>& condition, std::chrono::milliseconds timeout = 5s) {
+    auto deadline = std::chrono::steady_clock::now() + timeout;
+    while (std::chrono::steady_clock::now() < deadline) {
+        if (condition()) {
+            return true;
+        }
+        std::this_thread::sleep_for(5ms);
+    }
+    return condition();
+}
+
+nlohmann::json without_envelope(nlohmann::json frame) {
+    frame.erase("timestamp");
+    frame.erase("seq");
+    frame.erase("update_type");
+    return frame;
+}
+
+} // namespace
+
+class MetricsStreamerTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        config_.update_interval_ms = 10;
+        config_.broadcast_interval_ms = 20;
+        config_.keyframe_interval = 5;
+        config_.max_unacked_frames = 2;
+    }
+
+    void TearDown() override {
+        for (const auto& id : connection_ids_) {
+            streamer().unregister_connection(id);
+        }
+        streamer().shutdown();
+    }
+
+    MetricsStreamer& streamer() { return MetricsStreamer::getInstance(); }
+
+    void start() {
+        baseline_ = streamer().get_performance_stats();   // The singleton keeps counting across tests
+        ASSERT_TRUE(streamer().initialize(config_));
+    }
+
+    uint64_t dropped_since_start() {
+        return streamer().get_performance_stats().messages_dropped - baseline_.messages_dropped;
+    }
+
+    std::string connect(FakeConnection& conn) {
+        std::string id = streamer().register_connection(&conn, "test");
+        connection_ids_.push_back(id);
+        return id;
+    }
+
+    void subscribe(const std::string& id, nlohmann::json request) {
+        request["type"] = "subscribe";
+        streamer().handle_message(id, request.dump());
+    }
+
+    MetricsStreamerConfig config_;
+    MetricsStreamer::PerformanceStats baseline_;
+    std::vector<std::string> connection_ids_;
+};
+
+TEST(StreamSubscriptionTest, KeyIgnoresOrderAndIsEmptyForEverything) {
+    auto a = StreamSubscription::from_json({{"sections", {"system", "providers"}}, {"providers", {"b", "a"}}});
+    auto b = StreamSubscription::from_json({{"sections", {"providers", "system", "system"}},
+                                            {"providers", {"a", "b"}}, {"delta", true}});
+    EXPECT_EQ(a.key(), b.key());
+    EXPECT_FALSE(a.delta);
+    EXPECT_TRUE(b.delta);
+    EXPECT_EQ(b.sections.size(), 2u);
+
+    auto all = StreamSubscription::from_json({{"delta", true}, {"ack", true}, {"sections", "system"}});
+    EXPECT_EQ(all.key(), "");
+    EXPECT_TRUE(all.ack);
+}
+
+TEST_F(MetricsStreamerTest, NoSnapshotsAreBuiltWithoutConnections) {
+    start();
+    std::this_thread::sleep_for(100ms);
+
+    auto stats = streamer().get_performance_stats();
+    EXPECT_EQ(stats.frames_serialized, baseline_.frames_serialized);
+}
+
+TEST_F(MetricsStreamerTest, LegacyClientsShareOneSerializedFrame) {
+    start();
+    FakeConnection first, second;
+    connect(first);
+    connect(second);
+
+    ASSERT_TRUE(wait_for([&] { return first.raw().size() >= 3 && second.raw().size() >= 3; }));
+    streamer().shutdown();
+
+    // Same broadcast, same bytes
+    std::map<uint64_t, std::string> by_seq;
+    for (const auto& raw : first.raw()) {
+        by_seq[nlohmann::json::parse(raw)["seq"].get<uint64_t>()] = raw;
+    }
+    size_t matched = 0;
+    for (const auto& raw : second.raw()) {
+        auto frame = nlohmann::json::parse(raw);
+        EXPECT_EQ(frame["update_type"], "comprehensive_metrics");
+        if (auto it = by_seq.find(frame["seq"].get<uint64_t>()); it != by_seq.end()) {
+            EXPECT_EQ(raw, it->second);
+            matched++;
+        }
+    }
+    EXPECT_GE(matched, 2u);
+
+    auto stats = streamer().get_performance_stats();
+    EXPECT_LT(stats.frames_serialized - baseline_.frames_serialized,
+              stats.messages_sent - baseline_.messages_sent);
+    EXPECT_GT(stats.bytes_sent, baseline_.bytes_sent);
+}
+
+TEST_F(MetricsStreamerTest, DeltasReconstructFullFrames) {
+    start();
+    FakeConnection legacy, delta;
+    connect(legacy);
+    subscribe(connect(delta), {{"delta", true}});
+
+    std::atomic<bool> producing{true};
+    std::thread producer([&] {
+        for (int i = 0; producing.load(); ++i) {
+            streamer().update_provider_metrics(i % 2 ? "alpha" : "beta", 50.0 + i, i % 5 != 0);
+            std::this_thread::sleep_for(3ms);
+        }
+    });
+
+    ASSERT_TRUE(wait_for([&] {
+        auto frames = broadcasts_after_subscribe(delta);
+        return std::count_if(frames.begin(), frames.end(), [](const nlohmann::json& frame) {
+            return frame["update_type"] == "metrics_delta";
+        }) >= 6;
+    }));
+    producing.store(false);
+    producer.join();
+    streamer().shutdown();
+
+    std::map<uint64_t, nlohmann::json> full_frames;
+    for (const auto& frame : legacy.frames()) {
+        full_frames[frame["seq"].get<uint64_t>()] = without_envelope(frame);
+    }
+
+    nlohmann::json state;
+    uint64_t state_seq = 0;
+    size_t keyframes = 0, deltas = 0;
+    for (const auto& frame : broadcasts_after_subscribe(delta)) {
+        uint64_t seq = frame["seq"].get<uint64_t>();
+        if (frame["update_type"] == "comprehensive_metrics") {
+            state = without_envelope(frame);
+            keyframes++;
+        } else {
+            // Unchanged broadcasts are not sent, so the base may be newer than the last frame
+            ASSERT_GE(frame["base_seq"].get<uint64_t>(), state_seq) << "delta on top of a missed frame";
+            state.merge_patch(frame["changes"]);
+            deltas++;
+        }
+        state_seq = seq;
+
+        auto full = full_frames.find(seq);
+        ASSERT_NE(full, full_frames.end());
+        EXPECT_EQ(state, full->second) << "at seq " << seq;
+    }
+    EXPECT_GE(keyframes, 2u);   // The first frame, then one per keyframe_interval
+    EXPECT_GE(deltas, 6u);
+
+    auto stats = streamer().get_performance_stats();
+    EXPECT_GE(stats.delta_frames_sent - baseline_.delta_frames_sent, deltas);
+}
+
+TEST_F(MetricsStreamerTest, SubscriptionFiltersSectionsAndProviders) {
+    streamer().update_provider_metrics("alpha", 40.0, true);
+    streamer().update_provider_metrics("beta", 60.0, true);
+    start();
+
+    FakeConnection conn;
+    subscribe(connect(conn), {{"sections", {"providers"}}, {"providers", {"alpha"}}});
+
+    ASSERT_TRUE(wait_for([&] { return broadcasts_after_subscribe(conn).size() >= 2; }));
+    streamer().shutdown();
+
+    for (const auto& frame : broadcasts_after_subscribe(conn)) {
+        EXPECT_EQ(without_envelope(frame).size(), 1u);
+        ASSERT_TRUE(frame.contains("providers"));
+        EXPECT_TRUE(frame["providers"].contains("alpha"));
+        EXPECT_FALSE(frame["providers"].contains("beta"));
+    }
+}
+
+TEST_F(MetricsStreamerTest, SlowAckingClientIsSkippedUntilItCatchesUp) {
+    start();
+    FakeConnection conn;
+    std::string id = connect(conn);
+    subscribe(id, {{"delta", true}, {"ack", true}});
+
+    // max_unacked_frames are sent, then the client is skipped
+    ASSERT_TRUE(wait_for([&] { return dropped_since_start() >= 3; }));
+    auto stalled = broadcasts_after_subscribe(conn);
+    ASSERT_EQ(stalled.size(), 2u);
+
+    streamer().handle_message(id, nlohmann::json{{"type", "ack"}, {"seq", stalled.back()["seq"]}}.dump());
+    ASSERT_TRUE(wait_for([&] { return broadcasts_after_subscribe(conn).size() >= 3; }));
+    streamer().shutdown();
+
+    // It missed broadcasts, so it resumes from a keyframe
+    auto resumed = broadcasts_after_subscribe(conn)[2];
+    EXPECT_EQ(resumed["update_type"], "comprehensive_metrics");
+    EXPECT_GT(resumed["seq"].get<uint64_t>(), stalled.back()["seq"].get<uint64_t>() + 1);
+}
@@ -0,0 +1,159 @@
+#include <gtest/gtest.h>
+#include "aimux/prettifier/pattern_registry.hpp"
+#include <regex>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace aimux::prettifier;
+
+class PatternRegistryTest : public ::testing::Test {
+protected:
+    static std::regex reference(const std::string& pattern, uint32_t flags) {
+        auto syntax = std::regex::ECMAScript;
+        if (flags & CompiledPattern::ICASE) syntax |= std::regex::icase;
+        if (flags & CompiledPattern::MULTILINE) syntax |= std::regex::multiline;
+        return std::regex(pattern, syntax);
+    }
+};
+
+TEST_F(PatternRegistryTest, IdenticalPatternsShareOneCompilation) {
+    auto& registry = PatternRegistry::instance();
+    const auto& first = registry.get("test.shared", R"(foo\d+)");
+    const auto& second = registry.get("test.shared_again", R"(foo\d+)");
+    const auto& icase = registry.get("test.shared_icase", R"(foo\d+)", CompiledPattern::ICASE);
+
+    EXPECT_EQ(&first, &second);
+    EXPECT_NE(&first, &icase);
+    EXPECT_EQ(second.name(), "test.shared");
+    EXPECT_TRUE(icase.search("xx FOO12"));
+    EXPECT_FALSE(first.search("xx FOO12"));
+}
+
+TEST_F(PatternRegistryTest, ReplaceMatchesStdRegex) {
+    struct Case {
+        std::string pattern;
+        uint32_t flags;
+        std::string input;
+        std::string format;
+    };
+    const std::vector<Case> cases = {
+        {R"(\n{3,})", CompiledPattern::NONE, "a\n\n\n\nb\n\nc\n\n\n", "\n\n"},
+        {R"(\s+)", CompiledPattern::NONE, "  lots \t of\n\nspace  ", " "},
+        {R"(,\s*([}\]]))", CompiledPattern::NONE, R"({"a": [1, 2, ], "b": 3 ,})", "$1"},
+        {R"(```\s*\n(.*?)\n```)", CompiledPattern::NONE, "```\ncode\n``` and ```\nmore\n```", "```text\n$1```"},
+        {R"((^|\n)# )", CompiledPattern::NONE, "# META\nx\n# CONTENT\n", "$1\\# "},
+        {R"(<script[^>]*>)", CompiledPattern::ICASE, "<SCRIPT src=x><script>", "&lt;script&gt;"},
+        {R"(\[DONE\]|data:\s*\{|:\s*\"?DONE\"?)", CompiledPattern::NONE, "data: {x} [DONE] : \"DONE\"", ""},
+        {R"(x*)", CompiledPattern::NONE, "axxb", "-"},
+        {R"((a)|(b))", CompiledPattern::NONE, "abc", "[$1|$2|$&|$$]"},
+        {R"(^\s*\d+\.\s+(.*)$)", CompiledPattern::MULTILINE, "1. one\n2.  two\nthree", "* $1"},
+    };
+
+    for (const auto& c : cases) {
+        const auto& pattern = PatternRegistry::instance().get("test.replace", c.pattern, c.flags);
+        std::string expected = std::regex_replace(c.input, reference(c.pattern, c.flags), c.format);
+        EXPECT_EQ(pattern.replace_all(c.input, c.format), expected) << c.pattern;
+    }
+}
+
+TEST_F(PatternRegistryTest, MatchesAndGroupsAgreeWithStdRegex) {
+    const std::string text =
+        "# META\nversion: 1\n# CONTENT\n[TYPE: text]\n# TOOLS\n[CALL: search]\n[PARAM: {}]\n";
+    const auto& sections = PatternRegistry::instance().get(
+        "test.sections", R"(^# ([A-Z]+)\s*$)", CompiledPattern::MULTILINE);
+
+    std::vector<std::string> names;
+    std::vector<size_t> positions;
+    sections.for_each_match(text, [&](const PatternMatch& match) {
+        names.push_back(match.str(1));
+        positions.push_back(match.position);
+        return true;
+    });
+
+    std::vector<std::string> expected_names;
+    std::vector<size_t> expected_positions;
+    std::regex ref = reference(R"(^# ([A-Z]+)\s*$)", CompiledPattern::MULTILINE);
+    for (std::sregex_iterator it(text.begin(), text.end(), ref), end; it != end; ++it) {
+        expected_names.push_back((*it)[1].str());
+        expected_positions.push_back(static_cast<size_t>(it->position()));
+    }
+    EXPECT_EQ(names, expected_names);
+    EXPECT_EQ(positions, expected_positions);
+
+    const auto& call = PatternRegistry::instance().get("test.call", R"(^\[CALL:\s*([^\]]+)\])");
+    PatternMatch match;
+    ASSERT_TRUE(call.full_match("[CALL: search]", match));
+    EXPECT_EQ(match.str(1), "search");
+    EXPECT_FALSE(call.full_match("[CALL: search] trailing"));
+    EXPECT_TRUE(call.search("[CALL: search] trailing"));
+
+    // Stopping early
+    size_t visited = sections.for_each_match(text, [](const PatternMatch&) { return false; });
+    EXPECT_EQ(visited, 1u);
+}
+
+TEST_F(PatternRegistryTest, SecurityPatternsAreCaseInsensitive) {
+    const auto& patterns = PatternRegistry::instance().security_patterns();
+    auto flagged = [&patterns](const std::string& text) {
+        for (const CompiledPattern* pattern : patterns) {
+            if (pattern->search(text)) return true;
+        }
+        return false;
+    };
+
+    EXPECT_TRUE(flagged("<ScRiPt>alert(1)</script>"));
+    EXPECT_TRUE(flagged("x' or '1'='1"));
+    EXPECT_TRUE(flagged("../../etc/passwd"));
+    EXPECT_TRUE(flagged("C:\\Windows\\system32"));
+    EXPECT_FALSE(flagged("a harmless tool argument"));
+}
+
+TEST_F(PatternRegistryTest, RecordsPerPatternTiming) {
+    const auto& pattern = PatternRegistry::instance().get("test.metrics", R"(needle\d)");
+    pattern.reset_stats();
+
+    const std::string haystack = std::string(4096, 'x') + "needle7";
+    for (int i = 0; i < 10; ++i) {
+        EXPECT_TRUE(pattern.search(haystack));
+    }
+    EXPECT_FALSE(pattern.search("no match here"));
+
+    auto json = pattern.to_json();
+    EXPECT_EQ(json["calls"].get<uint64_t>(), 11u);
+    EXPECT_EQ(json["matches"].get<uint64_t>(), 10u);
+    EXPECT_GE(json["max_time_us"].get<double>(), json["avg_time_us"].get<double>());
+    EXPECT_TRUE(json["engine"] == "re2" || json["engine"] == "std::regex");
+
+    PatternSet set;
+    set.track(pattern);
+    set.track(pattern);
+    EXPECT_EQ(set.to_json().size(), 1u);
+    EXPECT_TRUE(PatternRegistry::instance().get_metrics().contains("test.metrics"));
+}
+
+TEST_F(PatternRegistryTest, ConcurrentLookupsAndMatches) {
+    constexpr int THREADS = 4;
+    std::vector<std::thread> threads;
+    std::vector<int> found(THREADS, 0);
+
+    for (int t = 0; t < THREADS; ++t) {
+        threads.emplace_back([t, &found]() {
+            for (int i = 0; i < 200; ++i) {
+                const auto& pattern = PatternRegistry::instance().get(
+                    "test.concurrent", R"(id-(\d+))");
+                PatternMatch match;
+                if (pattern.search("prefix id-" + std::to_string(i), match) &&
+                    match.str(1) == std::to_string(i)) {
+                    ++found[t];
+                }
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    for (int count : found) {
+        EXPECT_EQ(count, 200);
+    }
+}
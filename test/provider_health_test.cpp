@@ -0,0 +1,309 @@
+#include <gtest/gtest.h>
+#include "aimux/gateway/provider_health.hpp"
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+
+using namespace aimux;
+using namespace aimux::gateway;
+using namespace std::chrono_literals;
+
+namespace {
+
+core::Response make_response(int status_code) {
+    core::Response response;
+    response.status_code = status_code;
+    response.success = status_code >= 200 && status_code < 300;
+    return response;
+}
+
+OutlierDetectionConfig fast_config() {
+    OutlierDetectionConfig config;
+    config.consecutive_errors_ = 3;
+    config.base_ejection_time_ = 50ms;
+    config.max_ejection_time_ = 2000ms;
+    config.recovery_probes_ = 2;
+    config.recovery_successes_ = 3;
+    config.min_latency_samples_ = 5;
+    return config;
+}
+
+} // namespace
+
+class ProviderHealthMonitorTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        monitor_.configure_outlier_detection(fast_config());
+        for (const char* name : {"alpha", "beta", "gamma", "delta"}) {
+            monitor_.add_provider(name, nlohmann::json::object());
+        }
+    }
+
+    void feed(const std::string& provider, int status_code, int times, double latency_ms = 100.0) {
+        for (int i = 0; i < times; ++i) {
+            monitor_.update_provider_metrics(provider, make_response(status_code), latency_ms);
+        }
+    }
+
+    HealthStatus status(const std::string& provider) { return monitor_.get_provider_status(provider); }
+
+    ProviderHealthMonitor monitor_;
+};
+
+TEST_F(ProviderHealthMonitorTest, OnlyUpstreamErrorsCountTowardsEjection) {
+    feed("beta", 400, 10);
+    feed("beta", 429, 10);
+    feed("beta", 499, 10);
+    EXPECT_EQ(status("beta"), HealthStatus::HEALTHY);
+
+    feed("alpha", 503, 2);
+    EXPECT_EQ(status("alpha"), HealthStatus::DEGRADED);
+    feed("alpha", 0, 1);
+    EXPECT_EQ(status("alpha"), HealthStatus::CIRCUIT_OPEN);
+    EXPECT_FALSE(monitor_.get_provider_health("alpha")->can_accept_requests());
+
+    auto healthy = monitor_.get_healthy_providers();
+    EXPECT_EQ(std::count(healthy.begin(), healthy.end(), "alpha"), 0);
+}
+
+TEST_F(ProviderHealthMonitorTest, ProbesEndEjectionAndTrafficCompletesRecovery) {
+    std::atomic<int> probes{0};
+    monitor_.set_health_probe([&](const std::string&, ProviderHealthMonitor::ProbeCallback on_complete) {
+        probes++;
+        on_complete(make_response(200));
+    });
+
+    feed("alpha", 503, 3);
+    ASSERT_EQ(status("alpha"), HealthStatus::CIRCUIT_OPEN);
+
+    // No probing while the ejection is still running
+    monitor_.perform_health_check("alpha");
+    EXPECT_EQ(probes.load(), 0);
+
+    std::this_thread::sleep_for(60ms);
+    monitor_.perform_health_check("alpha");
+    EXPECT_EQ(status("alpha"), HealthStatus::CIRCUIT_OPEN);
+    monitor_.perform_health_check("alpha");
+    EXPECT_EQ(probes.load(), 2);
+
+    // Back on probation: routable, but only HEALTHY after a run of successes
+    ProviderHealth* health = monitor_.get_provider_health("alpha");
+    EXPECT_EQ(status("alpha"), HealthStatus::DEGRADED);
+    EXPECT_TRUE(health->recovering_.load());
+    EXPECT_TRUE(health->is_healthy());
+
+    feed("alpha", 200, 2);
+    EXPECT_EQ(status("alpha"), HealthStatus::DEGRADED);
+    feed("alpha", 200, 1);
+    EXPECT_EQ(status("alpha"), HealthStatus::HEALTHY);
+}
+
+TEST_F(ProviderHealthMonitorTest, RelapseOnProbationEjectsForLonger) {
+    feed("alpha", 503, 3);
+    ProviderHealth* health = monitor_.get_provider_health("alpha");
+    health->attempt_recovery();
+    monitor_.evaluate_outliers();   // No probe installed: expired ejection goes on probation
+    ASSERT_EQ(status("alpha"), HealthStatus::DEGRADED);
+
+    auto before = std::chrono::steady_clock::now();
+    feed("alpha", 502, 1);
+    ASSERT_EQ(status("alpha"), HealthStatus::CIRCUIT_OPEN);
+    EXPECT_EQ(health->ejection_count_.load(), 2);
+
+    auto ejected_for = std::chrono::nanoseconds(health->ejected_until_ns_.load() -
+        std::chrono::duration_cast<std::chrono::nanoseconds>(before.time_since_epoch()).count());
+    EXPECT_GE(ejected_for, 90ms);   // Twice the 50ms base
+}
+
+TEST_F(ProviderHealthMonitorTest, SlowProviderIsEjectedAsLatencyOutlier) {
+    feed("alpha", 200, 10, 100.0);
+    feed("beta", 200, 10, 110.0);
+    feed("gamma", 200, 10, 95.0);
+    feed("delta", 200, 10, 1500.0);
+
+    monitor_.evaluate_outliers();
+
+    EXPECT_EQ(status("delta"), HealthStatus::CIRCUIT_OPEN);
+    for (const char* name : {"alpha", "beta", "gamma"}) {
+        EXPECT_EQ(status(name), HealthStatus::HEALTHY) << name;
+    }
+
+    // Too few samples to judge
+    monitor_.add_provider("epsilon", nlohmann::json::object());
+    feed("epsilon", 200, 2, 5000.0);
+    monitor_.evaluate_outliers();
+    EXPECT_EQ(status("epsilon"), HealthStatus::HEALTHY);
+}
+
+TEST_F(ProviderHealthMonitorTest, NeverEjectsMoreThanTheConfiguredShare) {
+    for (const char* name : {"alpha", "beta", "gamma", "delta"}) {
+        feed(name, 503, 5);
+    }
+
+    int ejected = 0;
+    for (const char* name : {"alpha", "beta", "gamma", "delta"}) {
+        if (status(name) == HealthStatus::CIRCUIT_OPEN) {
+            ejected++;
+        } else {
+            EXPECT_EQ(status(name), HealthStatus::DEGRADED) << name;
+        }
+    }
+    EXPECT_EQ(ejected, 2);
+}
+
+TEST_F(ProviderHealthMonitorTest, MonitorThreadProbesOnScheduleAndStopsPromptly) {
+    std::atomic<int> probes{0};
+    monitor_.set_health_probe([&](const std::string& provider, ProviderHealthMonitor::ProbeCallback on_complete) {
+        if (provider == "alpha") {
+            probes++;
+        }
+        on_complete(make_response(200));
+    });
+    monitor_.get_provider_health("alpha")->probe_interval_ = 1s;
+
+    monitor_.start_monitoring();
+    auto deadline = std::chrono::steady_clock::now() + 3s;
+    while (probes.load() == 0 && std::chrono::steady_clock::now() < deadline) {
+        std::this_thread::sleep_for(10ms);
+    }
+    EXPECT_GE(probes.load(), 1);
+
+    auto start = std::chrono::steady_clock::now();
+    monitor_.stop_monitoring();
+    EXPECT_LT(std::chrono::steady_clock::now() - start, 500ms);
+}
+
+TEST_F(ProviderHealthMonitorTest, HangingProbeHoldsUpNoOtherProviderAndSurvivesRemoval) {
+    std::atomic<int> probes{0};
+    ProviderHealthMonitor::ProbeCallback pending;
+    monitor_.set_health_probe([&](const std::string& provider, ProviderHealthMonitor::ProbeCallback on_complete) {
+        probes++;
+        if (provider == "alpha") {
+            pending = std::move(on_complete);   // Answered later, like a slow upstream
+        } else {
+            on_complete(make_response(200));
+        }
+    });
+
+    monitor_.perform_health_check("alpha");
+    monitor_.perform_health_check("beta");
+    EXPECT_EQ(probes.load(), 2);
+    ASSERT_TRUE(pending);
+
+    // Still in progress: a second check does not stack another probe
+    monitor_.perform_health_check("alpha");
+    EXPECT_EQ(probes.load(), 2);
+
+    // The late completion finds its entry alive even though the provider is gone
+    monitor_.remove_provider("alpha");
+    pending(make_response(503));
+    EXPECT_EQ(status("alpha"), HealthStatus::UNHEALTHY);
+    EXPECT_EQ(status("beta"), HealthStatus::HEALTHY);
+
+    auto start = std::chrono::steady_clock::now();
+    monitor_.stop_monitoring();
+    EXPECT_LT(std::chrono::steady_clock::now() - start, 100ms);
+}
+
+TEST_F(ProviderHealthMonitorTest, SnapshotsPublishStatusAtOnceAndBatchMetrics) {
+    monitor_.set_score_publish_interval(1h);
+    auto initial = monitor_.get_score_snapshot();
+    ASSERT_NE(initial->find("alpha"), nullptr);
+    EXPECT_EQ(initial->scores_.size(), 4u);
+
+    // Metric-only updates wait for the next publish
+    feed("beta", 200, 5, 400.0);
+    EXPECT_EQ(monitor_.get_score_snapshot()->version_, initial->version_);
+
+    // Status changes do not
+    feed("alpha", 503, 3);
+    auto ejected = monitor_.get_score_snapshot();
+    EXPECT_GT(ejected->version_, initial->version_);
+    EXPECT_EQ(ejected->find("alpha")->status_, HealthStatus::CIRCUIT_OPEN);
+    EXPECT_FALSE(ejected->find("alpha")->can_accept_requests());
+    EXPECT_EQ(initial->find("alpha")->status_, HealthStatus::HEALTHY);   // Old readers keep their view
+
+    monitor_.set_score_publish_interval(0ms);
+    feed("beta", 200, 1, 400.0);
+    EXPECT_NEAR(monitor_.get_score_snapshot()->find("beta")->avg_response_time_ms_, 400.0, 1e-6);
+}
+
+TEST_F(ProviderHealthMonitorTest, MonitorThreadPublishesTrailingMetricUpdates) {
+    monitor_.set_score_publish_interval(100ms);
+    monitor_.publish_scores();
+    monitor_.start_monitoring();
+    auto published = monitor_.get_score_snapshot();
+
+    // Inside the interval: readers keep the old table and never rebuild it themselves
+    feed("beta", 200, 1, 400.0);
+    EXPECT_EQ(monitor_.get_score_snapshot()->version_, published->version_);
+
+    auto deadline = std::chrono::steady_clock::now() + 2s;
+    while (monitor_.get_score_snapshot()->version_ == published->version_ &&
+           std::chrono::steady_clock::now() < deadline) {
+        std::this_thread::sleep_for(5ms);
+    }
+    EXPECT_GT(monitor_.get_score_snapshot()->version_, published->version_);
+    EXPECT_NEAR(monitor_.get_score_snapshot()->find("beta")->avg_response_time_ms_, 400.0, 1e-6);
+    monitor_.stop_monitoring();
+}
+
+TEST_F(ProviderHealthMonitorTest, InFlightRequestsAreCountedLive) {
+    {
+        InFlightRequest first = monitor_.begin_request("alpha");
+        InFlightRequest second = monitor_.begin_request("alpha");
+        InFlightRequest unknown = monitor_.begin_request("nobody");
+        EXPECT_EQ(monitor_.get_score_snapshot()->find("alpha")->in_flight(), 2);
+
+        InFlightRequest moved = std::move(first);
+        EXPECT_EQ(monitor_.get_score_snapshot()->find("alpha")->in_flight(), 2);
+    }
+    EXPECT_EQ(monitor_.get_score_snapshot()->find("alpha")->in_flight(), 0);
+}
+
+TEST_F(ProviderHealthMonitorTest, ReadersRunAlongsideWriters) {
+    monitor_.set_score_publish_interval(0ms);
+    std::atomic<bool> stop{false};
+
+    std::vector<std::thread> writers;
+    for (const char* name : {"alpha", "beta"}) {
+        writers.emplace_back([&, name] {
+            for (int i = 0; i < 2000; ++i) {
+                monitor_.update_provider_metrics(name, make_response(200), 50.0 + i % 10);
+            }
+        });
+    }
+
+    std::thread reader([&] {
+        uint64_t last_version = 0;
+        while (!stop.load()) {
+            auto scores = monitor_.get_score_snapshot();
+            ASSERT_GE(scores->version_, last_version);
+            last_version = scores->version_;
+            ASSERT_EQ(scores->scores_.size(), 4u);
+            ASSERT_EQ(monitor_.get_healthy_providers().size(), 4u);
+        }
+    });
+
+    for (auto& writer : writers) {
+        writer.join();
+    }
+    stop = true;
+    reader.join();
+
+    auto scores = monitor_.get_score_snapshot();
+    EXPECT_GE(scores->find("alpha")->avg_response_time_ms_, 50.0);
+    EXPECT_LE(scores->find("alpha")->avg_response_time_ms_, 60.0);
+}
+
+TEST(OutlierDetectionConfigTest, JsonRoundTrip) {
+    OutlierDetectionConfig config = fast_config();
+    config.latency_z_threshold_ = 4.5;
+
+    OutlierDetectionConfig round_trip = OutlierDetectionConfig::from_json(config.to_json());
+    EXPECT_EQ(round_trip.consecutive_errors_, 3);
+    EXPECT_EQ(round_trip.base_ejection_time_, 50ms);
+    EXPECT_DOUBLE_EQ(round_trip.latency_z_threshold_, 4.5);
+    EXPECT_EQ(round_trip.recovery_successes_, 3);
+}
@@ -0,0 +1,158 @@
+#include <gtest/gtest.h>
+#include "aimux/gateway/request_metrics_store.hpp"
+#include "aimux/metrics/latency_histogram.hpp"
+#include <thread>
+#include <vector>
+
+using namespace aimux;
+using namespace aimux::gateway;
+
+namespace {
+
+MetricRecord make_record(uint16_t provider_id, uint32_t duration_us, bool success, int64_t end_ns) {
+    MetricRecord record;
+    record.provider_id = provider_id;
+    record.duration_us = duration_us;
+    record.end_ns = end_ns;
+    record.start_ns = end_ns - static_cast<int64_t>(duration_us) * 1000;
+    record.http_status = success ? 200 : 503;
+    record.request_tokens = 10;
+    record.response_tokens = 20;
+    record.cost_usd = 0.001f;
+    if (success) {
+        record.flags |= MetricRecord::SUCCESS;
+    }
+    return record;
+}
+
+} // namespace
+
+TEST(LatencyHistogramTest, BucketsCoverEveryValueWithBoundedError) {
+    using metrics::LatencyHistogram;
+
+    for (uint64_t value : {0ull, 1ull, 31ull, 32ull, 33ull, 1000ull, 123456ull, 987654321ull}) {
+        size_t index = LatencyHistogram::bucket_index(value);
+        ASSERT_LT(index, LatencyHistogram::BUCKET_COUNT);
+        EXPECT_LE(LatencyHistogram::bucket_lower_bound(index), value);
+        EXPECT_GE(LatencyHistogram::bucket_upper_bound(index), value);
+
+        double width = static_cast<double>(LatencyHistogram::bucket_upper_bound(index) -
+                                           LatencyHistogram::bucket_lower_bound(index));
+        EXPECT_LE(width, static_cast<double>(value) / 16.0);
+    }
+    EXPECT_EQ(LatencyHistogram::bucket_index(LatencyHistogram::MAX_TRACKABLE + 1000),
+              LatencyHistogram::bucket_index(LatencyHistogram::MAX_TRACKABLE));
+    EXPECT_LT(LatencyHistogram::bucket_index(LatencyHistogram::MAX_TRACKABLE), LatencyHistogram::BUCKET_COUNT);
+}
+
+TEST(LatencyHistogramTest, PercentilesTrackUniformDistribution) {
+    metrics::LatencyHistogram histogram;
+    EXPECT_EQ(histogram.percentile(50.0), 0.0);
+
+    for (uint64_t us = 1; us <= 10000; ++us) {
+        histogram.record(us);
+    }
+
+    EXPECT_EQ(histogram.count(), 10000u);
+    EXPECT_EQ(histogram.min(), 1u);
+    EXPECT_EQ(histogram.max(), 10000u);
+    EXPECT_NEAR(histogram.mean(), 5000.5, 0.01);
+    EXPECT_NEAR(histogram.percentile(50.0), 5000.0, 5000.0 * 0.07);
+    EXPECT_NEAR(histogram.percentile(99.0), 9900.0, 9900.0 * 0.07);
+    EXPECT_LE(histogram.percentile(100.0), 10000.0);
+
+    histogram.reset();
+    EXPECT_EQ(histogram.count(), 0u);
+    EXPECT_EQ(histogram.min(), 0u);
+}
+
+TEST(RequestMetricsStoreTest, InternsProvidersAndFallsBackToOther) {
+    RequestMetricsStore store(100, 2);
+
+    uint16_t alpha = store.intern("alpha");
+    EXPECT_NE(alpha, RequestMetricsStore::OTHER_PROVIDER);
+    EXPECT_EQ(store.intern("alpha"), alpha);
+    EXPECT_NE(store.intern("beta"), alpha);
+    EXPECT_EQ(store.provider_name(alpha), "alpha");
+
+    for (size_t i = 0; i < RequestMetricsStore::MAX_PROVIDERS; ++i) {
+        store.intern("provider-" + std::to_string(i));
+    }
+    EXPECT_EQ(store.intern("one-too-many"), RequestMetricsStore::OTHER_PROVIDER);
+    EXPECT_EQ(store.provider_name(RequestMetricsStore::OTHER_PROVIDER), "other");
+}
+
+TEST(RequestMetricsStoreTest, AggregatesOutliveRingHistory) {
+    RequestMetricsStore store(8, 1);
+    uint16_t alpha = store.intern("alpha");
+    uint16_t beta = store.intern("beta");
+
+    for (int i = 0; i < 20; ++i) {
+        store.record(make_record(i % 2 == 0 ? alpha : beta, 1000 * (i + 1), i % 4 != 3, 1000000 + i));
+    }
+
+    EXPECT_EQ(store.total_requests(), 20u);
+    EXPECT_EQ(store.successful_requests(), 15u);
+    EXPECT_EQ(store.latency().count(), 20u);
+
+    auto providers = store.providers_to_json();
+    EXPECT_EQ(providers["alpha"]["requests"], 10u);
+    EXPECT_EQ(providers["beta"]["successful_requests"], 5u);
+    EXPECT_EQ(providers["alpha"]["request_tokens"], 100u);
+    EXPECT_FALSE(providers.contains("other"));
+
+    // Only the ring's capacity is retained, newest last
+    auto recent = store.recent(100);
+    ASSERT_EQ(recent.size(), 8u);
+    EXPECT_EQ(recent.front().end_ns, 1000000 + 12);
+    EXPECT_EQ(recent.back().end_ns, 1000000 + 19);
+    EXPECT_EQ(store.recent(3).size(), 3u);
+    EXPECT_EQ(store.recent(3).front().end_ns, 1000000 + 17);
+
+    store.clear();
+    EXPECT_EQ(store.total_requests(), 0u);
+    EXPECT_TRUE(store.recent(100).empty());
+    EXPECT_TRUE(store.providers_to_json().empty());
+}
+
+TEST(RequestMetricsStoreTest, ConcurrentWritersLoseNothing) {
+    constexpr int kThreads = 8;
+    constexpr int kPerThread = 5000;
+    RequestMetricsStore store(1024, 4);
+
+    std::vector<std::thread> writers;
+    for (int t = 0; t < kThreads; ++t) {
+        writers.emplace_back([&store, t] {
+            uint16_t id = store.intern("provider-" + std::to_string(t % 3));
+            for (int i = 0; i < kPerThread; ++i) {
+                store.record(make_record(id, 500 + i % 100, true, static_cast<int64_t>(t) * kPerThread + i));
+            }
+        });
+    }
+
+    // Readers run alongside writers and must only ever see fully written records
+    std::atomic<bool> stop{false};
+    std::thread reader([&] {
+        while (!stop.load()) {
+            for (const MetricRecord& record : store.recent(256)) {
+                ASSERT_EQ(record.start_ns, record.end_ns - static_cast<int64_t>(record.duration_us) * 1000);
+            }
+        }
+    });
+
+    for (auto& writer : writers) {
+        writer.join();
+    }
+    stop = true;
+    reader.join();
+
+    EXPECT_EQ(store.total_requests(), static_cast<uint64_t>(kThreads * kPerThread));
+    EXPECT_EQ(store.latency().count(), static_cast<uint64_t>(kThreads * kPerThread));
+
+    uint64_t per_provider = 0;
+    for (const auto& provider : store.providers_to_json()) {
+        per_provider += provider["requests"].get<uint64_t>();
+    }
+    EXPECT_EQ(per_provider, static_cast<uint64_t>(kThreads * kPerThread));
+    EXPECT_EQ(store.recent(store.capacity()).size(), store.capacity());
+}
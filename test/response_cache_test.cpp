@@ -0,0 +1,183 @@
+#include <gtest/gtest.h>
+#include "aimux/cache/response_cache.hpp"
+#include <atomic>
+#include <chrono>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace aimux::cache;
+
+class ResponseCacheTest : public ::testing::Test {
+protected:
+    static ResponseCache::Config single_shard(size_t max_entries) {
+        ResponseCache::Config config;
+        config.max_entries = max_entries;
+        config.shard_count = 1;
+        return config;
+    }
+};
+
+TEST_F(ResponseCacheTest, PutThenGetReturnsPayload) {
+    ResponseCache cache;
+    cache.putPayload("key", "{\"content\":\"hello\"}", "claude-3");
+
+    auto hit = cache.getPayload("key", "claude-3");
+    ASSERT_TRUE(hit.has_value());
+    EXPECT_EQ(*hit, "{\"content\":\"hello\"}");
+    EXPECT_FALSE(cache.getPayload("missing", "claude-3").has_value());
+
+    auto stats = cache.getStats();
+    EXPECT_EQ(stats.hits, 1u);
+    EXPECT_EQ(stats.misses, 1u);
+    EXPECT_EQ(stats.entries, 1u);
+}
+
+TEST_F(ResponseCacheTest, EvictsLeastRecentlyUsed) {
+    ResponseCache cache(single_shard(3));
+    cache.putPayload("a", "1");
+    cache.putPayload("b", "2");
+    cache.putPayload("c", "3");
+
+    // Touch "a" so "b" becomes the eviction victim
+    ASSERT_TRUE(cache.getPayload("a").has_value());
+    cache.putPayload("d", "4");
+
+    EXPECT_TRUE(cache.getPayload("a").has_value());
+    EXPECT_FALSE(cache.getPayload("b").has_value());
+    EXPECT_TRUE(cache.getPayload("c").has_value());
+    EXPECT_TRUE(cache.getPayload("d").has_value());
+    EXPECT_EQ(cache.getStats().evictions, 1u);
+}
+
+TEST_F(ResponseCacheTest, MemoryAccountingTracksPayloadBytes) {
+    ResponseCache cache(single_shard(100));
+    cache.putPayload("small", "x");
+    size_t small_usage = cache.getStats().memory_usage_bytes;
+
+    std::string large(64 * 1024, 'y');
+    cache.putPayload("large", large);
+    size_t with_large = cache.getStats().memory_usage_bytes;
+    EXPECT_GE(with_large - small_usage, large.size());
+
+    cache.remove("large");
+    EXPECT_EQ(cache.getStats().memory_usage_bytes, small_usage);
+
+    cache.clear();
+    EXPECT_EQ(cache.getStats().memory_usage_bytes, 0u);
+}
+
+TEST_F(ResponseCacheTest, MemoryLimitEvictsOldEntries) {
+    ResponseCache::Config config = single_shard(1000);
+    config.max_memory_mb = 1;
+    ResponseCache cache(config);
+
+    std::string payload(200 * 1024, 'z');
+    for (int i = 0; i < 10; ++i) {
+        cache.putPayload("entry-" + std::to_string(i), payload);
+    }
+
+    auto stats = cache.getStats();
+    EXPECT_LE(stats.memory_usage_bytes, 1024u * 1024u);
+    EXPECT_GT(stats.evictions, 0u);
+    EXPECT_TRUE(cache.getPayload("entry-9").has_value());
+    EXPECT_FALSE(cache.getPayload("entry-0").has_value());
+}
+
+TEST_F(ResponseCacheTest, OversizedPayloadIsRejectedWithoutEvicting) {
+    ResponseCache::Config config = single_shard(1000);
+    config.max_memory_mb = 1;
+    ResponseCache cache(config);
+
+    cache.putPayload("a", "1");
+    cache.putPayload("b", "2");
+    cache.putPayload("huge", std::string(2 * 1024 * 1024, 'h'));
+
+    EXPECT_FALSE(cache.getPayload("huge").has_value());
+    EXPECT_TRUE(cache.getPayload("a").has_value());
+    EXPECT_TRUE(cache.getPayload("b").has_value());
+    EXPECT_EQ(cache.getStats().evictions, 0u);
+}
+
+TEST_F(ResponseCacheTest, ExpiredEntriesMiss) {
+    ResponseCache cache;
+    cache.putPayload("short", "v", "", std::chrono::milliseconds(1));
+    std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    EXPECT_FALSE(cache.getPayload("short").has_value());
+    EXPECT_EQ(cache.getStats().entries, 0u);
+}
+
+TEST_F(ResponseCacheTest, RouteStatsAreSeparated) {
+    ResponseCache cache(single_shard(1));
+    cache.putPayload("k1", "v1", "route-a");
+    cache.getPayload("k1", "route-a");
+    cache.getPayload("k2", "route-b");
+    cache.putPayload("k2", "v2", "route-b");  // evicts k1, owned by route-a
+
+    auto routes = cache.getRouteStats();
+    EXPECT_EQ(routes["route-a"]["hits"], 1u);
+    EXPECT_EQ(routes["route-a"]["evictions"], 1u);
+    EXPECT_EQ(routes["route-b"]["misses"], 1u);
+    EXPECT_EQ(routes["route-b"]["evictions"], 0u);
+}
+
+TEST_F(ResponseCacheTest, RouteLabelsPastTheCapFoldIntoOther) {
+    auto config = single_shard(16);
+    config.max_routes = 2;
+    ResponseCache cache(config);
+
+    // Client-chosen labels must not grow the route table without bound
+    for (int i = 0; i < 100; ++i) {
+        cache.getPayload("k" + std::to_string(i), "model-" + std::to_string(i));
+    }
+    cache.getPayload("k0", "model-0");
+
+    auto routes = cache.getRouteStats();
+    EXPECT_EQ(routes.size(), 3u);
+    EXPECT_EQ(routes["model-0"]["misses"], 2u);
+    EXPECT_EQ(routes["model-1"]["misses"], 1u);
+    EXPECT_EQ(routes["other"]["misses"], 98u);
+}
+
+TEST_F(ResponseCacheTest, KeyCoversWholeRequest) {
+    ResponseCache cache;
+    nlohmann::json base = {
+        {"messages", {{{"role", "user"}, {"content", "hi"}}}},
+        {"temperature", 0}
+    };
+    nlohmann::json with_tools = base;
+    with_tools["tools"] = nlohmann::json::array({{{"name", "search"}}});
+    nlohmann::json opted_in = base;
+    opted_in["aimux_cache"] = true;
+
+    EXPECT_NE(cache.generateKey("m", base), cache.generateKey("m", with_tools));
+    EXPECT_NE(cache.generateKey("m", base), cache.generateKey("other", base));
+    EXPECT_EQ(cache.generateKey("m", base), cache.generateKey("m", opted_in));
+}
+
+TEST_F(ResponseCacheTest, ConcurrentAccessAcrossShards) {
+    ResponseCache cache;
+    std::atomic<size_t> hits{0};
+    std::vector<std::thread> threads;
+
+    for (int t = 0; t < 8; ++t) {
+        threads.emplace_back([&, t]() {
+            for (int i = 0; i < 500; ++i) {
+                std::string key = "k" + std::to_string((t * 500 + i) % 200);
+                if (cache.getPayload(key, "route")) {
+                    hits++;
+                } else {
+                    cache.putPayload(key, "payload-" + key, "route");
+                }
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    auto stats = cache.getStats();
+    EXPECT_EQ(stats.hits, hits.load());
+    EXPECT_EQ(stats.hits + stats.misses, 8u * 500u);
+    EXPECT_LE(stats.entries, 200u);
+}
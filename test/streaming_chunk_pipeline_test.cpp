@@ -0,0 +1,249 @@
+#include <gtest/gtest.h>
+#include "aimux/prettifier/chunk_pool.hpp"
+#include "aimux/prettifier/streaming_processor.hpp"
+#include <atomic>
+#include <chrono>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace aimux::prettifier;
+
+namespace {
+
+// Streams chunks back unchanged, so a stream's content shows the order it saw
+class EchoPlugin : public PrettifierPlugin {
+public:
+    std::string get_name() const override { return "echo"; }
+    std::string version() const override { return "1.0.0"; }
+    std::string description() const override { return "Returns streaming chunks unchanged"; }
+    std::vector<std::string> supported_formats() const override { return {"text"}; }
+    std::vector<std::string> output_formats() const override { return {"toon"}; }
+    std::vector<std::string> supported_providers() const override { return {"test"}; }
+    std::vector<std::string> capabilities() const override { return {"streaming"}; }
+
+    ProcessingResult preprocess_request(const aimux::core::Request&) override {
+        return create_success_result("");
+    }
+
+    ProcessingResult postprocess_response(const aimux::core::Response&, const ProcessingContext&) override {
+        return create_success_result("");
+    }
+};
+
+ProcessingContext make_context() {
+    ProcessingContext context;
+    context.provider_name = "test";
+    context.model_name = "test-model";
+    context.streaming_mode = true;
+    return context;
+}
+
+std::string streamed_content(const ProcessingResult& result) {
+    return nlohmann::json::parse(result.processed_content)["content"].get<std::string>();
+}
+
+} // namespace
+
+TEST(ChunkPoolTest, SmallChunksShareRecycledBlocks) {
+    ChunkPool pool(1024 * 1024);
+    std::vector<ChunkSlice> slices;
+    {
+        ChunkWriter writer(pool);
+        for (int i = 0; i < 100; ++i) {
+            ChunkSlice slice;
+            ASSERT_TRUE(writer.append("chunk-" + std::to_string(i), slice));
+            slices.push_back(std::move(slice));
+        }
+    }
+    EXPECT_EQ(pool.get_stats().total_blocks, 1u);
+    EXPECT_EQ(slices[42].view(), "chunk-42");
+
+    // A copy keeps the block alive after the original is gone
+    ChunkSlice kept = slices[7];
+    slices.clear();
+    EXPECT_EQ(kept.view(), "chunk-7");
+    EXPECT_EQ(pool.get_stats().free_blocks, 0u);
+
+    kept.reset();
+    auto stats = pool.get_stats();
+    EXPECT_EQ(stats.free_blocks, 1u);
+    EXPECT_EQ(stats.in_use_bytes, 0u);
+
+    // The next stream reuses the cached block
+    ChunkWriter writer(pool);
+    ChunkSlice slice;
+    ASSERT_TRUE(writer.append("again", slice));
+    EXPECT_EQ(pool.get_stats().total_blocks, 1u);
+    EXPECT_EQ(pool.allocated_bytes(), ChunkPool::BLOCK_SIZE);
+}
+
+TEST(ChunkPoolTest, BudgetCoversLargeChunksAndCachedBlocks) {
+    ChunkPool pool(4 * ChunkPool::BLOCK_SIZE);
+    ChunkWriter writer(pool);
+    std::string large(3 * ChunkPool::BLOCK_SIZE, 'x');
+
+    ChunkSlice first;
+    ASSERT_TRUE(writer.append(large, first));
+    EXPECT_EQ(first.view(), large);
+
+    ChunkSlice second;
+    EXPECT_FALSE(writer.append(large, second));
+    EXPECT_TRUE(second.empty());
+    EXPECT_EQ(pool.get_stats().rejected, 1u);
+
+    // Dedicated blocks are freed, not cached
+    first.reset();
+    EXPECT_EQ(pool.allocated_bytes(), 0u);
+
+    // Cached small blocks are given up before a large chunk is refused
+    {
+        ChunkSlice small;
+        ASSERT_TRUE(writer.append("small", small));
+        writer.reset();
+    }
+    EXPECT_EQ(pool.get_stats().free_blocks, 1u);
+    ASSERT_TRUE(writer.append(std::string(4 * ChunkPool::BLOCK_SIZE, 'y'), second));
+    EXPECT_EQ(pool.get_stats().free_blocks, 0u);
+}
+
+TEST(SpscRingTest, TransfersEveryItemInOrderAcrossThreads) {
+    constexpr size_t COUNT = 100000;
+    SpscRing<size_t> ring(64);
+    EXPECT_EQ(ring.capacity(), 64u);
+
+    std::thread producer([&] {
+        for (size_t i = 0; i < COUNT; ++i) {
+            size_t item = i;
+            while (!ring.try_push(std::move(item))) {
+                std::this_thread::yield();
+            }
+        }
+    });
+
+    size_t expected = 0;
+    while (expected < COUNT) {
+        size_t item;
+        if (ring.try_pop(item)) {
+            ASSERT_EQ(item, expected);
+            ++expected;
+        } else {
+            std::this_thread::yield();
+        }
+    }
+    producer.join();
+    EXPECT_TRUE(ring.empty());
+}
+
+TEST(StreamingChunkPipelineTest, ChunksOfEachStreamAreProcessedInOrder) {
+    constexpr int STREAMS = 16;
+    constexpr int CHUNKS = 200;
+    StreamingProcessor processor;
+    auto plugin = std::make_shared<EchoPlugin>();
+
+    std::vector<std::string> stream_ids;
+    for (int s = 0; s < STREAMS; ++s) {
+        stream_ids.push_back(processor.create_stream(make_context(), plugin));
+    }
+
+    std::vector<std::thread> producers;
+    for (int t = 0; t < 4; ++t) {
+        producers.emplace_back([&, t] {
+            for (int s = t; s < STREAMS; s += 4) {
+                for (int c = 0; c < CHUNKS; ++c) {
+                    // A full ring is backpressure; wait for the stream's worker
+                    while (!processor.submit_chunk(stream_ids[s], std::to_string(c) + ",", c == CHUNKS - 1)) {
+                        std::this_thread::yield();
+                    }
+                }
+            }
+        });
+    }
+    for (auto& producer : producers) {
+        producer.join();
+    }
+
+    std::string expected;
+    for (int c = 0; c < CHUNKS; ++c) {
+        expected += std::to_string(c) + ",";
+    }
+    for (const auto& stream_id : stream_ids) {
+        auto result = processor.get_result(stream_id);
+        ASSERT_TRUE(result.success) << result.error_message;
+        EXPECT_EQ(streamed_content(result), expected);
+        EXPECT_EQ(result.metadata["total_chunks"], CHUNKS);
+    }
+
+    auto stats = processor.get_statistics();
+    EXPECT_EQ(stats.total_chunks_processed, static_cast<uint64_t>(STREAMS * CHUNKS));
+    EXPECT_EQ(stats.active_streams, 0u);
+
+    // Collected streams hand their blocks back; only the cache remains
+    auto pool = processor.get_diagnostics()["buffer_pool"];
+    EXPECT_EQ(pool["in_use_bytes"], 0);
+}
+
+TEST(StreamingChunkPipelineTest, MemoryBudgetRefusesChunksUntilStreamsRelease) {
+    StreamingProcessor processor;
+    processor.configure({{"buffer_size_mb", 1}});
+    auto plugin = std::make_shared<EchoPlugin>();
+    std::string large(600 * 1024, 'x');
+
+    auto first = processor.create_stream(make_context(), plugin);
+    EXPECT_TRUE(processor.process_chunk(first, large).get());
+
+    // The first stream still holds its chunk, so a second one does not fit
+    auto second = processor.create_stream(make_context(), plugin);
+    EXPECT_FALSE(processor.submit_chunk(second, large));
+    EXPECT_EQ(processor.get_statistics().backpressure_events, 1u);
+    EXPECT_LE(processor.get_statistics().current_memory_usage, 1024u * 1024u);
+
+    EXPECT_TRUE(processor.process_chunk(first, "done", true).get());
+    ASSERT_TRUE(processor.get_result(first).success);
+
+    EXPECT_TRUE(processor.process_chunk(second, large, true).get());
+    auto result = processor.get_result(second);
+    ASSERT_TRUE(result.success) << result.error_message;
+    EXPECT_EQ(streamed_content(result).size(), large.size());
+}
+
+TEST(StreamingChunkPipelineTest, StreamsStopCountingOnceTheirFinalChunkIsQueued) {
+    StreamingProcessor processor;
+    processor.configure({{"max_concurrent_streams", 2}});
+    auto plugin = std::make_shared<EchoPlugin>();
+
+    auto first = processor.create_stream(make_context(), plugin);
+    auto second = processor.create_stream(make_context(), plugin);
+    EXPECT_THROW(processor.create_stream(make_context(), plugin), std::runtime_error);
+
+    ASSERT_TRUE(processor.submit_chunk(first, "last", true));
+    auto third = processor.create_stream(make_context(), plugin);
+    EXPECT_FALSE(processor.submit_chunk(first, "after the final chunk"));
+
+    ASSERT_TRUE(processor.cancel_stream(second));
+    EXPECT_NO_THROW(processor.create_stream(make_context(), plugin));
+    EXPECT_EQ(processor.get_result(second).error_message, "Stream cancelled");
+    EXPECT_TRUE(processor.get_result(first).success);
+    EXPECT_FALSE(processor.get_result(first).success);   // Released once collected
+    EXPECT_TRUE(processor.is_stream_active(third));
+}
+
+TEST(StreamingChunkPipelineTest, GetResultWakesWhenTheFinalChunkIsProcessed) {
+    StreamingProcessor processor;
+    auto stream_id = processor.create_stream(make_context(), std::make_shared<EchoPlugin>());
+    ASSERT_TRUE(processor.submit_chunk(stream_id, "first "));
+
+    std::thread producer([&] {
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+        processor.submit_chunk(stream_id, "last", true);
+    });
+
+    auto started = std::chrono::steady_clock::now();
+    auto result = processor.get_result(stream_id);
+    auto waited = std::chrono::steady_clock::now() - started;
+    producer.join();
+
+    ASSERT_TRUE(result.success) << result.error_message;
+    EXPECT_EQ(streamed_content(result), "first last");
+    EXPECT_LT(waited, std::chrono::seconds(2));
+}
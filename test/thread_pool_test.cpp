@@ -0,0 +1,186 @@
+#include <gtest/gtest.h>
+#include "aimux/core/thread_manager.hpp"
+#include <atomic>
+#include <chrono>
+#include <future>
+#include <memory>
+#include <thread>
+#include <vector>
+
+using namespace aimux::core;
+using namespace std::chrono_literals;
+
+TEST(PoolTaskTest, SmallCapturesAreStoredInline) {
+    int value = 0;
+    auto small = [&value] { value++; };
+    EXPECT_TRUE(PoolTask::fits_inline<decltype(small)>());
+
+    struct Large { char bytes[256]; };
+    auto large = [payload = Large{}] { (void)payload; };
+    EXPECT_FALSE(PoolTask::fits_inline<decltype(large)>());
+
+    PoolTask task(small);
+    PoolTask moved(std::move(task));
+    EXPECT_FALSE(task);
+    ASSERT_TRUE(moved);
+    moved();
+    EXPECT_EQ(value, 1);
+}
+
+TEST(PoolTaskTest, AcceptsMoveOnlyCallables) {
+    auto owned = std::make_unique<int>(41);
+    std::promise<int> result;
+    auto future = result.get_future();
+
+    PoolTask task([owned = std::move(owned), result = std::move(result)]() mutable {
+        result.set_value(*owned + 1);
+    });
+    PoolTask target;
+    target = std::move(task);
+    target();
+
+    EXPECT_EQ(future.get(), 42);
+}
+
+TEST(ThreadPoolTest, SubmitReturnsResultsAndExceptions) {
+    ThreadPool pool(4, "test");
+
+    std::vector<std::future<int>> futures;
+    for (int i = 0; i < 100; ++i) {
+        futures.push_back(pool.submit([](int x) { return x * 2; }, i));
+    }
+    int sum = 0;
+    for (auto& future : futures) {
+        sum += future.get();
+    }
+    EXPECT_EQ(sum, 9900);
+
+    auto failing = pool.submit([]() -> int { throw std::runtime_error("boom"); });
+    EXPECT_THROW(failing.get(), std::runtime_error);
+
+    auto moved = pool.submit([](std::unique_ptr<int> p) { return *p; }, std::make_unique<int>(7));
+    EXPECT_EQ(moved.get(), 7);
+}
+
+TEST(ThreadPoolTest, IdleWorkersStealFromABusyWorker) {
+    ThreadPool pool(4, "steal");
+
+    // One task fans out from a worker, so everything lands in that worker's own deque
+    constexpr int CHILDREN = 64;
+    std::atomic<int> done{0};
+    std::promise<void> all_done;
+    pool.post([&] {
+        for (int i = 0; i < CHILDREN; ++i) {
+            pool.post([&] {
+                std::this_thread::sleep_for(2ms);
+                if (++done == CHILDREN) {
+                    all_done.set_value();
+                }
+            });
+        }
+    });
+
+    ASSERT_EQ(all_done.get_future().wait_for(5s), std::future_status::ready);
+
+    auto stats = pool.get_stats();
+    EXPECT_EQ(stats.total_threads, 4u);
+    EXPECT_GT(stats.stolen_tasks, 0u);
+
+    size_t workers_used = 0;
+    for (const auto& worker : stats.workers) {
+        if (worker.executed_tasks > 0) {
+            workers_used++;
+        }
+    }
+    EXPECT_GT(workers_used, 1u);
+}
+
+TEST(ThreadPoolTest, ManyProducersAllTasksRunOnce) {
+    ThreadPool pool(4, "producers");
+
+    constexpr int PRODUCERS = 8;
+    constexpr int PER_PRODUCER = 5000;
+    std::vector<std::atomic<int>> runs(PRODUCERS * PER_PRODUCER);
+
+    std::vector<std::thread> producers;
+    for (int p = 0; p < PRODUCERS; ++p) {
+        producers.emplace_back([&, p] {
+            for (int i = 0; i < PER_PRODUCER; ++i) {
+                ASSERT_TRUE(pool.post([&runs, index = p * PER_PRODUCER + i] { runs[index]++; }));
+            }
+        });
+    }
+    for (auto& producer : producers) {
+        producer.join();
+    }
+
+    pool.shutdown();
+    for (size_t i = 0; i < runs.size(); ++i) {
+        ASSERT_EQ(runs[i].load(), 1) << i;
+    }
+    EXPECT_EQ(pool.get_stats().completed_tasks, runs.size());
+}
+
+TEST(ThreadPoolTest, ShutdownRunsQueuedTasksThenRejects) {
+    ThreadPool pool(1, "drain");
+
+    std::promise<void> started;
+    std::promise<void> release;
+    auto gate = release.get_future().share();
+    std::atomic<int> ran{0};
+    pool.post([&started, gate] {
+        started.set_value();
+        gate.wait();
+    });
+    started.get_future().wait();
+    for (int i = 0; i < 10; ++i) {
+        pool.post([&] { ran++; });
+    }
+    EXPECT_EQ(pool.get_stats().queued_tasks, 10u);
+
+    std::thread stopper([&] { pool.shutdown(); });
+    std::this_thread::sleep_for(20ms);
+    release.set_value();
+    stopper.join();
+
+    EXPECT_EQ(ran.load(), 10);
+    EXPECT_FALSE(pool.post([] {}));
+    EXPECT_THROW(pool.submit([] { return 1; }), std::runtime_error);
+}
+
+TEST(ThreadPoolTest, FailedPostsAreCounted) {
+    ThreadPool pool(2, "failures");
+    pool.post([] { throw std::runtime_error("ignored"); });
+    pool.shutdown();
+    EXPECT_EQ(pool.get_stats().failed_tasks, 1u);
+}
+
+TEST(ThreadPoolTest, WorkerThreadsKnowTheirPool) {
+    ThreadPool pool(2, "identity");
+    ThreadPool other(1, "other");
+
+    EXPECT_FALSE(pool.is_worker_thread());
+    EXPECT_TRUE(pool.submit([&] { return pool.is_worker_thread(); }).get());
+    EXPECT_FALSE(other.submit([&] { return pool.is_worker_thread(); }).get());
+}
+
+TEST(ThreadPoolTest, PinnedWorkersReportTheirCore) {
+    ThreadPool pool(2, "pinned", true);
+    pool.submit([] {}).get();
+
+    auto stats = pool.get_stats();
+    ASSERT_EQ(stats.workers.size(), 2u);
+#ifdef __linux__
+    EXPECT_GE(stats.workers[0].cpu, 0);
+#endif
+    ThreadPool unpinned(1, "unpinned");
+    EXPECT_EQ(unpinned.get_stats().workers[0].cpu, -1);
+}
+
+TEST(ThreadPoolTest, SharedPoolIsOneInstance) {
+    auto first = ThreadPool::shared();
+    auto second = ThreadPool::shared();
+    EXPECT_EQ(first.get(), second.get());
+    EXPECT_GE(first->size(), 2u);
+    EXPECT_EQ(first->submit([] { return 5; }).get(), 5);
+}
@@ -0,0 +1,213 @@
+#include <gtest/gtest.h>
+#include "aimux/prettifier/tool_call_scanner.hpp"
+#include "aimux/prettifier/tool_call_extractor.hpp"
+#include <chrono>
+#include <regex>
+#include <string>
+#include <vector>
+
+using namespace aimux::prettifier;
+
+class ToolCallScannerTest : public ::testing::Test {
+protected:
+    static std::vector<ToolCallScanner::Segment> scan_in_pieces(const std::string& text, size_t piece,
+                                                                uint32_t formats = ToolCallScanner::ALL) {
+        ToolCallScanner scanner(formats);
+        std::vector<ToolCallScanner::Segment> segments;
+        for (size_t i = 0; i < text.size(); i += piece) {
+            scanner.feed(std::string_view(text).substr(i, piece), segments);
+        }
+        scanner.finish();
+        return segments;
+    }
+
+    static ProcessingContext context_for(const std::string& provider) {
+        ProcessingContext context;
+        context.provider_name = provider;
+        context.streaming_mode = true;
+        return context;
+    }
+
+    static std::vector<ToolCall> stream(ToolCallExtractorPlugin& plugin, const std::string& provider,
+                                        const std::vector<std::string>& chunks) {
+        auto context = context_for(provider);
+        std::vector<ToolCall> calls;
+        EXPECT_TRUE(plugin.begin_streaming(context));
+        for (size_t i = 0; i < chunks.size(); ++i) {
+            auto result = plugin.process_streaming_chunk(chunks[i], i + 1 == chunks.size(), context);
+            EXPECT_TRUE(result.success);
+            EXPECT_EQ(result.processed_content, chunks[i]);
+            calls.insert(calls.end(), result.extracted_tool_calls.begin(), result.extracted_tool_calls.end());
+        }
+        return calls;
+    }
+};
+
+TEST_F(ToolCallScannerTest, SegmentsSurviveAnyChunkBoundary) {
+    const std::string text =
+        "Let me check. {\"name\": \"search\", \"arguments\": \"{\\\"q\\\": \\\"a } b\\\"\"} then "
+        "<tool_use>{\"name\": \"read\", \"input\": {\"path\": \"/tmp\"}}</tool_use> done";
+
+    auto whole = scan_in_pieces(text, text.size());
+    ASSERT_EQ(whole.size(), 2u);
+    EXPECT_EQ(whole[0].kind, ToolCallScanner::Segment::Kind::JSON_OBJECT);
+    EXPECT_EQ(whole[0].offset, text.find('{'));
+    EXPECT_EQ(whole[1].kind, ToolCallScanner::Segment::Kind::XML_ELEMENT);
+    EXPECT_EQ(whole[1].tag, "tool_use");
+    EXPECT_EQ(whole[1].text.substr(whole[1].text.size() - 11), "</tool_use>");
+
+    for (size_t piece : {1u, 2u, 3u, 7u, 16u}) {
+        auto segments = scan_in_pieces(text, piece);
+        ASSERT_EQ(segments.size(), whole.size()) << "piece " << piece;
+        for (size_t i = 0; i < segments.size(); ++i) {
+            EXPECT_EQ(segments[i].text, whole[i].text) << "piece " << piece;
+            EXPECT_EQ(segments[i].offset, whole[i].offset) << "piece " << piece;
+        }
+    }
+}
+
+TEST_F(ToolCallScannerTest, IgnoresProseBracesAndForeignTags) {
+    const std::string text =
+        "if (x) { return y; } and {} and <div>{ not json }</div> <function_calls>"
+        "<invoke name=\"ls\"></invoke></function_calls>";
+
+    auto segments = scan_in_pieces(text, 5);
+    ASSERT_EQ(segments.size(), 1u);
+    EXPECT_EQ(segments[0].tag, "invoke");
+
+    EXPECT_TRUE(scan_in_pieces(text, 5, ToolCallScanner::JSON).empty());
+}
+
+TEST_F(ToolCallScannerTest, UnterminatedAndOversizedSegmentsAreDropped) {
+    ToolCallScanner scanner(ToolCallScanner::JSON, 64);
+    std::vector<ToolCallScanner::Segment> segments;
+
+    scanner.feed("{\"name\": \"" + std::string(100, 'x') + "\"} {\"a\": 1}", segments);
+    ASSERT_EQ(segments.size(), 1u);
+    EXPECT_EQ(segments[0].text, "{\"a\": 1}");
+    EXPECT_EQ(scanner.oversized_segments(), 1u);
+
+    scanner.feed("{\"open\": [1, 2", segments);
+    EXPECT_TRUE(scanner.in_segment());
+    EXPECT_TRUE(scanner.finish());
+    EXPECT_FALSE(scanner.in_segment());
+    EXPECT_EQ(scanner.buffered(), 0u);
+}
+
+TEST_F(ToolCallScannerTest, ExtractsCallsSplitAcrossChunks) {
+    ToolCallExtractorPlugin plugin;
+    const std::string text =
+        "Calling {\"tool_calls\": [{\"id\": \"call_1\", \"function\": {\"name\": \"get_weather\", "
+        "\"arguments\": \"{\\\"city\\\": \\\"Paris\\\"}\"}}]} now";
+
+    std::vector<std::string> chunks;
+    for (size_t i = 0; i < text.size(); i += 3) {
+        chunks.push_back(text.substr(i, 3));
+    }
+
+    auto calls = stream(plugin, "openai", chunks);
+    ASSERT_EQ(calls.size(), 1u);
+    EXPECT_EQ(calls[0].name, "get_weather");
+    EXPECT_EQ(calls[0].id, "call_1");
+}
+
+TEST_F(ToolCallScannerTest, AssemblesOpenAIStreamDeltas) {
+    ToolCallExtractorPlugin plugin;
+    auto calls = stream(plugin, "openai", {
+        R"(data: {"choices":[{"index":0,"delta":{"tool_calls":[{"index":0,"id":"call_a","function":{"name":"lookup","arguments":""}}]},"finish_reason":null}]})" "\n\n",
+        R"(data: {"choices":[{"index":0,"delta":{"tool_calls":[{"index":0,"function":{"arguments":"{\"id\":"}}]},"finish_reason":null}]})" "\n\n",
+        R"(data: {"choices":[{"index":0,"delta":{"tool_calls":[{"index":0,"function":{"arguments":"42}"}}]},"finish_reason":null}]})" "\n\n",
+        R"(data: {"choices":[{"index":0,"delta":{},"finish_reason":"tool_calls"}]})" "\n\ndata: [DONE]\n\n",
+    });
+
+    ASSERT_EQ(calls.size(), 1u);
+    EXPECT_EQ(calls[0].name, "lookup");
+    EXPECT_EQ(calls[0].id, "call_a");
+    EXPECT_NE(calls[0].parameters["arguments"].get<std::string>().find("42"), std::string::npos);
+}
+
+TEST_F(ToolCallScannerTest, AssemblesAnthropicStreamEvents) {
+    ToolCallExtractorPlugin plugin;
+    auto calls = stream(plugin, "anthropic", {
+        "event: content_block_start\ndata: {\"type\":\"content_block_start\",\"index\":1,"
+        "\"content_block\":{\"type\":\"tool_use\",\"id\":\"toolu_1\",\"name\":\"get_time\",\"input\":{}}}\n\n",
+        "event: content_block_delta\ndata: {\"type\":\"content_block_delta\",\"index\":1,"
+        "\"delta\":{\"type\":\"input_json_delta\",\"partial_json\":\"{\\\"tz\\\": \"}}\n\n",
+        "event: content_block_delta\ndata: {\"type\":\"content_block_delta\",\"index\":1,"
+        "\"delta\":{\"type\":\"input_json_delta\",\"partial_json\":\"\\\"UTC\\\"}\"}}\n\n",
+        "event: content_block_stop\ndata: {\"type\":\"content_block_stop\",\"index\":1}\n\n",
+        "Also <invoke name=\"list_files\"><parameter name=\"path\">src</parameter></invoke>",
+    });
+
+    ASSERT_EQ(calls.size(), 2u);
+    EXPECT_EQ(calls[0].name, "get_time");
+    EXPECT_EQ(calls[0].id, "toolu_1");
+    EXPECT_NE(calls[0].parameters["arguments"].get<std::string>().find("UTC"), std::string::npos);
+    EXPECT_EQ(calls[1].name, "list_files");
+    EXPECT_NE(calls[1].parameters["arguments"].get<std::string>().find("src"), std::string::npos);
+}
+
+TEST_F(ToolCallScannerTest, EndStreamingReportsAllCallsOnce) {
+    ToolCallExtractorPlugin plugin;
+    auto context = context_for("synthetic");
+    ASSERT_TRUE(plugin.begin_streaming(context));
+
+    auto first = plugin.process_streaming_chunk("{\"name\": \"a\", \"arguments\": \"{}\"} {\"name\": \"b\",", false, context);
+    EXPECT_EQ(first.extracted_tool_calls.size(), 1u);
+
+    auto second = plugin.process_streaming_chunk(" \"arguments\": \"{}\"}", false, context);
+    ASSERT_EQ(second.extracted_tool_calls.size(), 1u);
+    EXPECT_EQ(second.extracted_tool_calls[0].name, "b");
+
+    auto end = plugin.end_streaming(context);
+    EXPECT_TRUE(end.success);
+    EXPECT_EQ(end.extracted_tool_calls.size(), 2u);
+
+    // A second end_streaming (as StreamingProcessor::finalize_stream issues) is harmless
+    auto again = plugin.end_streaming(context);
+    EXPECT_TRUE(again.success);
+    EXPECT_TRUE(again.extracted_tool_calls.empty());
+}
+
+TEST_F(ToolCallScannerTest, RespectsMaxToolCalls) {
+    ToolCallExtractorPlugin plugin;
+    ASSERT_TRUE(plugin.configure({{"max_tool_calls", 3}}));
+
+    std::string text;
+    for (int i = 0; i < 10; ++i) {
+        text += "{\"name\": \"tool_" + std::to_string(i) + "\", \"arguments\": \"{}\"}\n";
+    }
+
+    auto calls = stream(plugin, "cerebras", {text});
+    EXPECT_EQ(calls.size(), 3u);
+}
+
+TEST_F(ToolCallScannerTest, SinglePassIsFasterThanRegexScan) {
+    std::string text;
+    for (int i = 0; i < 2000; ++i) {
+        text += "Some narrative text with {braces} and <b>markup</b>. ";
+        if (i % 100 == 0) {
+            text += "<tool_use>{\"name\": \"t\", \"input\": {}}</tool_use> ";
+            text += "{\"name\": \"f\", \"arguments\": \"{}\"} ";
+        }
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    auto segments = scan_in_pieces(text, 512);
+    auto scanner_time = std::chrono::steady_clock::now() - start;
+
+    // The per-format regex passes the extractor used to run
+    start = std::chrono::steady_clock::now();
+    size_t regex_hits = 0;
+    for (const char* pattern : {R"(\{[^{}]*"name"[^{}]*\})", R"(<tool_use>[\s\S]*?</tool_use>)",
+                                R"(<invoke.*?>[\s\S]*?</invoke>)"}) {
+        std::regex re(pattern);
+        regex_hits += std::distance(std::sregex_iterator(text.begin(), text.end(), re), std::sregex_iterator());
+    }
+    auto regex_time = std::chrono::steady_clock::now() - start;
+
+    EXPECT_EQ(segments.size(), 40u);
+    // The flat-object pattern misses every call whose arguments contain braces
+    EXPECT_GE(regex_hits, 20u);
+    EXPECT_LT(scanner_time, regex_time);
+}
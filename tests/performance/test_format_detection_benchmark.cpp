@@ -0,0 +1,111 @@
+/**
+ * Format Detection Benchmark
+ *
+ * Measures per-request format detection as the body grows. The previous
+ * detect_format(crow::request, body) copied every header into a lowercased
+ * std::map and parsed the whole body before looking at anything; the
+ * tiered detector settles most requests from the endpoint, the headers or
+ * the first few kilobytes of the body, so its cost should not grow with
+ * the body.
+ */
+
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <cctype>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <string>
+
+#include "aimux/gateway/format_detector.hpp"
+
+using namespace aimux::gateway;
+using namespace std::chrono;
+
+namespace {
+
+std::string make_body(size_t turns) {
+    nlohmann::ordered_json messages = nlohmann::ordered_json::array();
+    for (size_t i = 0; i < turns; ++i) {
+        messages.push_back({{"role", i % 2 ? "assistant" : "user"}, {"content", std::string(500, 'x')}});
+    }
+    nlohmann::ordered_json body = {
+        {"model", "claude-3-5-sonnet-20241022"},
+        {"max_tokens", 1024},
+        {"system", "You are a helpful assistant."},
+        {"messages", messages}
+    };
+    return body.dump();
+}
+
+crow::request make_request(const std::string& url) {
+    crow::request req;
+    req.url = url;
+    req.add_header("Content-Type", "application/json");
+    req.add_header("User-Agent", "bench-client/1.0");
+    req.add_header("Accept", "application/json");
+    return req;
+}
+
+/**
+ * Reference copy of the previous request-level detection, kept only for comparison.
+ */
+DetectionResult legacy_detect(FormatDetector& detector, const crow::request& req, const std::string& body) {
+    std::map<std::string, std::string> headers;
+    for (const auto& header : req.headers) {
+        std::string name = header.first;
+        for (auto& c : name) {
+            c = static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
+        }
+        headers[name] = header.second;
+    }
+    nlohmann::json json_data;
+    try {
+        json_data = nlohmann::json::parse(body);
+    } catch (const nlohmann::json::exception&) {
+    }
+    return detector.detect_format(json_data, headers, req.url);
+}
+
+template <typename Fn>
+double us_per_call(int calls, Fn&& fn) {
+    auto started = steady_clock::now();
+    for (int i = 0; i < calls; ++i) {
+        fn();
+    }
+    return duration<double, std::micro>(steady_clock::now() - started).count() / calls;
+}
+
+} // namespace
+
+TEST(FormatDetectionBenchmark, TieredDetectionCostIsFlatInBodySize) {
+    FormatDetector detector;
+    std::cout << "\nFormat detection per request\n"
+              << "  body        route     full parse      tiered\n";
+
+    double largest_tiered_us = 0.0;
+    for (size_t turns : {4u, 512u, 8192u}) {
+        std::string body = make_body(turns);
+        int calls = turns > 1000 ? 5 : 200;
+        for (const char* url : {"/v1/messages", "/proxy"}) {
+            crow::request req = make_request(url);
+
+            DetectionResult legacy;
+            double legacy_us = us_per_call(calls, [&] { legacy = legacy_detect(detector, req, body); });
+            DetectionResult tiered;
+            double tiered_us = us_per_call(calls * 20, [&] { tiered = detector.detect_format(req, body); });
+
+            ASSERT_EQ(tiered.format, legacy.format);
+            ASSERT_EQ(tiered.document, nullptr);
+            largest_tiered_us = std::max(largest_tiered_us, tiered_us);
+
+            std::cout << std::fixed << std::setprecision(2) << "  " << std::setw(8) << body.size() / 1024.0
+                      << " KB  " << std::setw(12) << std::left << url << std::right << std::setw(9) << legacy_us
+                      << " us  " << std::setw(8) << tiered_us << " us\n";
+        }
+    }
+
+    // Microseconds regardless of body size
+    EXPECT_LT(largest_tiered_us, 50.0);
+}
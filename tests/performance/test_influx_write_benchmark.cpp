@@ -0,0 +1,293 @@
+/**
+ * InfluxDB Write Path Benchmark
+ *
+ * Measures InfluxDB2Client writes against an in-process mock endpoint that
+ * inflates gzipped bodies, counts lines and simulates request latency. The
+ * previous write path formatted each call through std::stringstream and
+ * posted it synchronously, so every producer paid the endpoint round trip;
+ * the batched path encodes into a reused buffer and hands batches to a
+ * background flusher, shedding the oldest batches when the endpoint falls
+ * behind. Producer latency must stay flat however slow the endpoint is, and
+ * every accepted line must end up either sent or counted as dropped.
+ */
+
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "aimux/metrics/influx_writer.hpp"
+#include "aimux/metrics/time_series_db.hpp"
+
+#ifdef AIMUX_HAVE_ZLIB
+#include <zlib.h>
+#endif
+
+using namespace aimux::metrics;
+using namespace std::chrono;
+
+namespace {
+
+/**
+ * Reference copy of the previous stringstream formatter, kept only for comparison.
+ */
+std::string legacy_format(const std::vector<MetricPoint>& metrics) {
+    std::stringstream result;
+    for (const auto& metric : metrics) {
+        result << metric.name;
+        if (!metric.tags.empty()) {
+            result << ",";
+            bool first = true;
+            for (const auto& [key, value] : metric.tags) {
+                if (!first) result << ",";
+                result << key << "=" << value;
+                first = false;
+            }
+        }
+        result << " ";
+        result << "value=" << metric.value;
+        for (const auto& [key, value] : metric.fields) {
+            result << "," << key << "=" << value;
+        }
+        auto timestamp_ns = duration_cast<nanoseconds>(metric.timestamp.time_since_epoch()).count();
+        result << " " << timestamp_ns;
+        result << "\n";
+    }
+    return result.str();
+}
+
+/**
+ * Stand-in for the InfluxDB write endpoint: inflates, counts and sleeps.
+ */
+class MockWriteEndpoint {
+public:
+    explicit MockWriteEndpoint(microseconds latency) : latency_(latency) {}
+
+    bool post(std::string_view body, bool gzipped) {
+        size_t lines = 0;
+        if (gzipped) {
+            lines = count_lines(inflate_body(body));
+        } else {
+            lines = count_lines(body);
+        }
+        lines_.fetch_add(lines, std::memory_order_relaxed);
+        requests_.fetch_add(1, std::memory_order_relaxed);
+        if (latency_.count() > 0) {
+            std::this_thread::sleep_for(latency_);
+        }
+        return true;
+    }
+
+    size_t lines() const { return lines_.load(); }
+    size_t requests() const { return requests_.load(); }
+
+private:
+    static size_t count_lines(std::string_view body) {
+        return static_cast<size_t>(std::count(body.begin(), body.end(), '\n'));
+    }
+
+    std::string inflate_body(std::string_view body) {
+        std::string out;
+#ifdef AIMUX_HAVE_ZLIB
+        z_stream stream{};
+        inflateInit2(&stream, 15 + 16);
+        stream.next_in = reinterpret_cast<Bytef*>(const_cast<char*>(body.data()));
+        stream.avail_in = static_cast<uInt>(body.size());
+        char chunk[64 * 1024];
+        int rc = Z_OK;
+        while (rc == Z_OK) {
+            stream.next_out = reinterpret_cast<Bytef*>(chunk);
+            stream.avail_out = sizeof(chunk);
+            rc = inflate(&stream, Z_NO_FLUSH);
+            out.append(chunk, sizeof(chunk) - stream.avail_out);
+        }
+        inflateEnd(&stream);
+#endif
+        return out;
+    }
+
+    microseconds latency_;
+    std::atomic<size_t> lines_{0};
+    std::atomic<size_t> requests_{0};
+};
+
+std::vector<MetricPoint> request_metrics(int request, system_clock::time_point at) {
+    static const char* providers[] = {"cerebras", "zai", "synthetic", "openai"};
+    MetricPoint latency;
+    latency.name = "provider_latency_ms";
+    latency.type = MetricType::TIMER;
+    latency.value = 80.0 + (request % 97) * 1.5;
+    latency.timestamp = at;
+    latency.tags = {{"provider", providers[request % 4]}, {"model", "default"}, {"region", "us-east"}};
+    latency.fields = {{"tokens", static_cast<double>(request % 2000)}, {"cost", 0.000125 * (request % 13)}};
+
+    MetricPoint throughput = latency;
+    throughput.name = "provider_requests";
+    throughput.type = MetricType::COUNTER;
+    throughput.value = 1.0;
+    throughput.fields.clear();
+    return {latency, throughput};
+}
+
+struct PeakResult {
+    double mean_call_us = 0.0;
+    double max_call_us = 0.0;
+    InfluxWriteStats stats;
+    size_t endpoint_lines = 0;
+};
+
+// Producers write two points per simulated request; request handling itself
+// is modelled as @p request_time spent off-CPU (upstream I/O)
+PeakResult run_peak(InfluxDB2Client& client, MockWriteEndpoint& endpoint, int threads, int calls_per_thread,
+                    microseconds request_time) {
+    client.set_write_transport([&endpoint](std::string_view body, bool gzipped) {
+        return endpoint.post(body, gzipped);
+    });
+
+    std::vector<double> total_us(threads, 0.0);
+    std::vector<double> max_us(threads, 0.0);
+    std::vector<std::thread> producers;
+    auto now = system_clock::now();
+    for (int t = 0; t < threads; ++t) {
+        producers.emplace_back([&, t] {
+            for (int i = 0; i < calls_per_thread; ++i) {
+                auto metrics = request_metrics(t * calls_per_thread + i, now + microseconds(i));
+                auto started = steady_clock::now();
+                client.write_metrics(metrics);
+                double us = duration<double, std::micro>(steady_clock::now() - started).count();
+                total_us[t] += us;
+                max_us[t] = std::max(max_us[t], us);
+                if (request_time.count() > 0) {
+                    std::this_thread::sleep_for(request_time);
+                }
+            }
+        });
+    }
+    for (auto& producer : producers) {
+        producer.join();
+    }
+    client.flush_writes(seconds{30});
+
+    PeakResult result;
+    for (int t = 0; t < threads; ++t) {
+        result.mean_call_us += total_us[t];
+        result.max_call_us = std::max(result.max_call_us, max_us[t]);
+    }
+    result.mean_call_us /= static_cast<double>(threads) * calls_per_thread;
+    result.stats = client.get_write_stats();
+    result.endpoint_lines = endpoint.lines();
+    return result;
+}
+
+} // namespace
+
+class InfluxWriteBenchmark : public ::testing::Test {
+protected:
+    TSDBConfig config_;
+};
+
+TEST_F(InfluxWriteBenchmark, EncoderMatchesPreviousFormatter) {
+    // Single tags and short decimals print identically in both implementations
+    std::vector<MetricPoint> metrics;
+    for (int i = 0; i < 50; ++i) {
+        MetricPoint point;
+        point.name = "provider_latency_ms";
+        point.type = MetricType::TIMER;
+        point.value = 100.25 + i;
+        point.timestamp = system_clock::time_point{} + seconds(1'700'000'000 + i);
+        point.tags = {{"provider", "cerebras"}};
+        metrics.push_back(point);
+    }
+
+    LineProtocolEncoder encoder;
+    std::string encoded;
+    for (const auto& metric : metrics) {
+        encoder.append(encoded, metric);
+    }
+    EXPECT_EQ(encoded, legacy_format(metrics));
+}
+
+TEST_F(InfluxWriteBenchmark, EncodingOutpacesStringstream) {
+    constexpr int POINTS = 20000;
+    constexpr int ROUNDS = 5;
+
+    std::vector<MetricPoint> metrics;
+    auto now = system_clock::now();
+    for (int i = 0; i < POINTS / 2; ++i) {
+        auto pair = request_metrics(i, now + microseconds(i));
+        metrics.insert(metrics.end(), pair.begin(), pair.end());
+    }
+
+    size_t legacy_bytes = 0;
+    auto started = steady_clock::now();
+    for (int round = 0; round < ROUNDS; ++round) {
+        legacy_bytes += legacy_format(metrics).size();
+    }
+    double legacy_ns = duration<double, std::nano>(steady_clock::now() - started).count() / (POINTS * ROUNDS);
+
+    LineProtocolEncoder encoder;
+    std::string arena;
+    size_t encoded_bytes = 0;
+    started = steady_clock::now();
+    for (int round = 0; round < ROUNDS; ++round) {
+        arena.clear();
+        for (const auto& metric : metrics) {
+            encoder.append(arena, metric);
+        }
+        encoded_bytes += arena.size();
+    }
+    double encoder_ns = duration<double, std::nano>(steady_clock::now() - started).count() / (POINTS * ROUNDS);
+
+    std::cout << "\nLine protocol encoding (" << POINTS << " points, 3 tags, 2 fields)\n";
+    std::cout << std::fixed << std::setprecision(1)
+              << "  stringstream: " << legacy_ns << " ns/point, " << legacy_bytes / ROUNDS << " bytes\n"
+              << "  encoder:      " << encoder_ns << " ns/point, " << encoded_bytes / ROUNDS << " bytes\n"
+              << "  speedup:      " << legacy_ns / encoder_ns << "x\n";
+
+    EXPECT_LT(encoder_ns, legacy_ns);
+}
+
+TEST_F(InfluxWriteBenchmark, ProducersStayFlatAgainstSlowEndpoint) {
+    constexpr int THREADS = 4;
+    constexpr int CALLS = 5000;     // Two points per call
+
+    struct Scenario {
+        int request_us;    // 0: producers do nothing but write (saturation)
+        int endpoint_ms;
+    };
+
+    std::cout << "\nInfluxDB2Client writes at peak (" << THREADS << " producers x " << CALLS << " calls)\n";
+    std::cout << std::setw(12) << "request us" << std::setw(13) << "endpoint ms" << std::setw(10) << "mean us"
+              << std::setw(11) << "max us" << std::setw(9) << "batches" << std::setw(8) << "sent"
+              << std::setw(9) << "dropped" << std::setw(7) << "ratio" << "\n";
+
+    for (Scenario scenario : {Scenario{100, 0}, Scenario{100, 2}, Scenario{100, 50}, Scenario{0, 0}}) {
+        InfluxDB2Client client(config_);
+        MockWriteEndpoint endpoint{milliseconds(scenario.endpoint_ms)};
+        PeakResult result = run_peak(client, endpoint, THREADS, CALLS, microseconds(scenario.request_us));
+        const auto& stats = result.stats;
+
+        double ratio = stats.bytes_sent > 0 ? static_cast<double>(stats.bytes_encoded) / stats.bytes_sent : 0.0;
+        std::cout << std::setw(12) << scenario.request_us << std::setw(13) << scenario.endpoint_ms
+                  << std::fixed << std::setprecision(2) << std::setw(10) << result.mean_call_us
+                  << std::setw(11) << result.max_call_us << std::setw(9) << stats.batches_sent
+                  << std::setw(8) << stats.lines_sent << std::setw(9) << stats.lines_dropped
+                  << std::setw(7) << std::setprecision(1) << ratio << "\n";
+
+        // Every line is accounted for, and what was sent is what the endpoint saw
+        EXPECT_EQ(stats.lines_accepted, static_cast<uint64_t>(THREADS) * CALLS * 2);
+        EXPECT_EQ(stats.lines_sent + stats.lines_dropped, stats.lines_accepted);
+        EXPECT_EQ(stats.pending_lines, 0u);
+        EXPECT_EQ(result.endpoint_lines, stats.lines_sent);
+
+        // Producers never wait for the endpoint; the old path blocked each call for a round trip
+        EXPECT_LT(result.mean_call_us, 1000.0);
+    }
+}
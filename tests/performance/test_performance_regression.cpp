@@ -693,4 +693,88 @@ TEST_F(PerformanceRegressionTest, ComprehensivePerformanceReport) {
     }
 
     std::cout << std::string(60, '=') << "\n\n";
-}
\ No newline at end of file
+}
+// Router dispatch overhead: the cached provider table against building a
+// bridge per request (serialize the config, construct, discard)
+namespace {
+
+class NoopBridge : public Bridge {
+public:
+    explicit NoopBridge(std::string name) : name_(std::move(name)) {}
+
+    Response send_request(const Request& /* request */) override {
+        Response response;
+        response.success = true;
+        response.status_code = 200;
+        return response;
+    }
+    bool is_healthy() const override { return true; }
+    std::string get_provider_name() const override { return name_; }
+    nlohmann::json get_rate_limit_status() const override { return nlohmann::json::object(); }
+
+private:
+    std::string name_;
+};
+
+std::vector<ProviderConfig> dispatch_benchmark_providers() {
+    std::vector<ProviderConfig> providers;
+    for (const char* name : {"cerebras", "zai", "minimax", "synthetic"}) {
+        ProviderConfig config;
+        config.name = name;
+        config.endpoint = std::string("https://api.") + name + ".example/v1";
+        config.api_key = "sk-benchmark-key";
+        config.models = {"model-a", "model-b"};
+        providers.push_back(config);
+    }
+    return providers;
+}
+
+} // namespace
+
+TEST(RouterDispatchBenchmark, CachedBridgeTableBeatsPerRequestConstruction) {
+    constexpr int iterations = 20000;
+    const std::vector<ProviderConfig> providers = dispatch_benchmark_providers();
+
+    std::atomic<int> bridges_built{0};
+    Router router(providers, [&](const ProviderConfig& config) -> std::shared_ptr<Bridge> {
+        bridges_built++;
+        return std::make_shared<NoopBridge>(config.name);
+    });
+
+    Request request;
+    request.model = "model-a";
+    request.method = "POST";
+    request.data = nlohmann::json{{"messages", {{{"role", "user"}, {"content", "ping"}}}}};
+
+    auto start = high_resolution_clock::now();
+    for (int i = 0; i < iterations; ++i) {
+        Response response = router.route(request);
+        ASSERT_TRUE(response.success);
+    }
+    double cached_us = duration<double, std::micro>(high_resolution_clock::now() - start).count() / iterations;
+    EXPECT_EQ(bridges_built.load(), static_cast<int>(providers.size()));
+
+    // Previous per-request path: find the config by name, serialize it and build a bridge
+    start = high_resolution_clock::now();
+    for (int i = 0; i < iterations; ++i) {
+        const std::string& selected = providers[i % providers.size()].name;
+        auto it = std::find_if(providers.begin(), providers.end(),
+            [&selected](const ProviderConfig& config) { return config.name == selected; });
+        auto bridge = BridgeFactory::create_bridge(it->name, it->to_json());
+        ASSERT_NE(bridge, nullptr);
+    }
+    double legacy_us = duration<double, std::micro>(high_resolution_clock::now() - start).count() / iterations;
+
+    std::cout << "Router dispatch overhead: cached table " << std::fixed << std::setprecision(2)
+              << cached_us << " us/route, per-request bridge construction " << legacy_us
+              << " us/route (before the upstream call)\n";
+
+    EXPECT_LT(cached_us, legacy_us);
+
+    // A config change rebuilds only what changed
+    std::vector<ProviderConfig> updated = providers;
+    updated[0].api_key = "sk-rotated-key";
+    router.update_providers(updated);
+    EXPECT_EQ(bridges_built.load(), static_cast<int>(providers.size()) + 1);
+    EXPECT_TRUE(router.route(request).success);
+}
@@ -0,0 +1,252 @@
+/**
+ * Request Analysis Microbenchmark
+ *
+ * Measures RoutingLogic::analyze_request on 100 KB+ agent transcripts
+ * (system prompt, alternating turns, tool calls and tool results) against the
+ * previous implementation, which copied the message array, re-serialized
+ * every message to look for tool calls and compiled eight std::regex objects
+ * per request. Classification results must agree on the shared sample set.
+ */
+
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <regex>
+#include <string>
+#include <vector>
+
+#include "aimux/gateway/keyword_matcher.hpp"
+#include "aimux/gateway/routing_logic.hpp"
+#include "nlohmann/json.hpp"
+
+using namespace aimux::gateway;
+using namespace std::chrono;
+
+namespace {
+
+/**
+ * Reference copy of the pre-automaton classifier, kept only for comparison.
+ */
+RequestType legacy_classify(const aimux::core::Request& request) {
+    static const std::vector<std::string> thinking_keywords{
+        "think", "reason", "analyze", "step by step", "break down",
+        "explain", "consider", "evaluate", "compare", "conclude"
+    };
+
+    nlohmann::json messages;
+    if (request.data.contains("messages")) {
+        messages = request.data["messages"];
+    }
+
+    std::string content_text;
+    bool has_images = false;
+    bool requires_tools = false;
+    for (const auto& message : messages) {
+        if (message.contains("content")) {
+            const auto& content = message["content"];
+            if (content.is_string()) {
+                content_text += content.get<std::string>() + " ";
+            } else if (content.is_array()) {
+                for (const auto& item : content) {
+                    if (item.contains("type")) {
+                        std::string type = item["type"];
+                        if (type == "text" && item.contains("text")) {
+                            content_text += item["text"].get<std::string>() + " ";
+                        } else if (type == "image") {
+                            has_images = true;
+                        }
+                    }
+                }
+            }
+        }
+        std::string message_str = message.dump();
+        if (message_str.find("tool_call") != std::string::npos ||
+            message_str.find("function_call") != std::string::npos) {
+            requires_tools = true;
+        }
+    }
+
+    bool thinking = false;
+    std::string lower = content_text;
+    std::transform(lower.begin(), lower.end(), lower.begin(), ::tolower);
+    for (const auto& keyword : thinking_keywords) {
+        if (lower.find(keyword) != std::string::npos) {
+            thinking = true;
+            break;
+        }
+    }
+    if (!thinking) {
+        std::vector<std::regex> patterns = {
+            std::regex(R"(\bstep\s+by\s+step\b)"),
+            std::regex(R"(\bbreak\s+down\b)"),
+            std::regex(R"(\bexplain\s+your\s+reasoning\b)"),
+            std::regex(R"(\bthink\s+aloud\b)"),
+            std::regex(R"(\bshow\s+your\s+work\b)"),
+            std::regex(R"(\bwalk\s+me\s+through\b)"),
+            std::regex(R"(\bhow\s+would\s+you\s+approach\b)"),
+            std::regex(R"(\bwhat\s+are\s+the\s+steps\b)")
+        };
+        for (const auto& pattern : patterns) {
+            if (std::regex_search(lower, pattern)) {
+                thinking = true;
+                break;
+            }
+        }
+    }
+
+    bool streaming = request.data.contains("stream") && request.data["stream"].get<bool>();
+    if (has_images) return RequestType::MULTIMODAL;
+    if (thinking) return RequestType::THINKING;
+    if (requires_tools) return RequestType::TOOLS;
+    if (streaming) return RequestType::STREAMING;
+    if (content_text.length() > 10000) return RequestType::LONG_CONTEXT;
+    return RequestType::STANDARD;
+}
+
+/**
+ * Agent-style transcript of roughly target_bytes of prompt text. The filler
+ * avoids every classifier keyword so the whole prompt must be scanned.
+ */
+aimux::core::Request make_agent_request(size_t target_bytes, const std::string& final_instruction) {
+    static const std::string filler =
+        "src/network/http_client.cpp:412: curl_easy_setopt(curl, CURLOPT_TIMEOUT_MS, timeout); "
+        "the build finished with 0 errors and 3 warnings in the network module, "
+        "file listing: include/ src/ tests/ docs/ CMakeLists.txt vcpkg.json README.md\n";
+
+    nlohmann::json messages = nlohmann::json::array();
+    std::string system_prompt;
+    while (system_prompt.size() < target_bytes / 2) {
+        system_prompt += filler;
+    }
+    messages.push_back({{"role", "system"}, {"content", system_prompt}});
+
+    messages.push_back({{"role", "user"}, {"content", nlohmann::json::array({
+        {{"type", "text"}, {"text", "Fix the failing build."}}
+    })}});
+
+    size_t written = system_prompt.size();
+    int call = 0;
+    while (written < target_bytes) {
+        std::string output;
+        for (int i = 0; i < 8; ++i) {
+            output += filler;
+        }
+        std::string id = "call_" + std::to_string(call++);
+        messages.push_back({{"role", "assistant"}, {"content", "Running the next command."},
+                            {"tool_calls", {{{"id", id}, {"type", "function"},
+                                             {"function", {{"name", "bash"},
+                                                           {"arguments", "{\"cmd\":\"make\"}"}}}}}}});
+        messages.push_back({{"role", "tool"}, {"tool_call_id", id}, {"content", output}});
+        written += output.size();
+    }
+    messages.push_back({{"role", "user"}, {"content", final_instruction}});
+
+    aimux::core::Request request;
+    request.model = "claude-3-5-sonnet";
+    request.method = "POST";
+    request.data = {{"messages", messages}, {"max_tokens", 4096}};
+    return request;
+}
+
+template <typename Fn>
+double mean_microseconds(int iterations, Fn&& fn) {
+    auto start = high_resolution_clock::now();
+    for (int i = 0; i < iterations; ++i) {
+        fn();
+    }
+    return duration<double, std::micro>(high_resolution_clock::now() - start).count() / iterations;
+}
+
+} // namespace
+
+class RequestAnalysisBenchmark : public ::testing::Test {
+protected:
+    RoutingLogic routing_{nullptr};
+};
+
+TEST_F(RequestAnalysisBenchmark, MatcherHonorsCaseWhitespaceAndBoundaries) {
+    KeywordMatcher matcher({
+        {"step by step", 1, true},
+        {"Image", 2, false},
+        {"tool_call", 4, false}
+    });
+
+    EXPECT_EQ(matcher.scan("Go STEP\n\tby   step please"), 1u);
+    EXPECT_EQ(matcher.scan("footstep by step"), 0u);      // leading boundary
+    EXPECT_EQ(matcher.scan("step by steps"), 0u);         // trailing boundary
+    EXPECT_EQ(matcher.scan("step by step"), 1u);          // boundary at end of input
+    EXPECT_EQ(matcher.scan("an IMAGES folder"), 2u);      // plain keywords are substrings
+    EXPECT_EQ(matcher.scan("{\"tool_calls\": []} image"), 6u);
+
+    // Matches spanning separately fed pieces
+    KeywordMatcher::Scanner scanner(matcher);
+    scanner.feed("first step by");
+    scanner.feed(" st");
+    scanner.feed("ep");
+    EXPECT_EQ(scanner.finish(), 1u);
+}
+
+TEST_F(RequestAnalysisBenchmark, ClassificationMatchesPreviousImplementation) {
+    std::vector<aimux::core::Request> samples;
+    auto add = [&samples](nlohmann::json data) {
+        aimux::core::Request request;
+        request.model = "claude-3-5-sonnet";
+        request.method = "POST";
+        request.data = std::move(data);
+        samples.push_back(std::move(request));
+    };
+
+    add({{"messages", {{{"role", "user"}, {"content", "Hello there"}}}}});
+    add({{"messages", {{{"role", "user"}, {"content", "Walk   me\nthrough the setup"}}}}});
+    add({{"messages", {{{"role", "user"}, {"content", "Please ANALYZE this log"}}}}});
+    add({{"messages", {{{"role", "user"}, {"content", {
+        {{"type", "text"}, {"text", "What is in this?"}},
+        {{"type", "image"}, {"source", {{"type", "base64"}, {"data", "AAAA"}}}}
+    }}}}}});
+    add({{"messages", {
+        {{"role", "user"}, {"content", "Fetch the page"}},
+        {{"role", "assistant"}, {"content", nullptr}, {"tool_calls", {{{"id", "call_1"}}}}}
+    }}});
+    add({{"messages", {{{"role", "user"}, {"content", "Hi"}}}}, {"stream", true}});
+    add({{"messages", {{{"role", "user"}, {"content", std::string(12000, 'x')}}}}});
+    samples.push_back(make_agent_request(100 * 1024, "Continue with the next file."));
+    samples.push_back(make_agent_request(100 * 1024, "Now break down the failures."));
+
+    for (const auto& request : samples) {
+        EXPECT_EQ(routing_.analyze_request(request).type_, legacy_classify(request))
+            << request.data.dump().substr(0, 120);
+    }
+}
+
+TEST_F(RequestAnalysisBenchmark, AgentPromptsAnalyzeWithoutReparsing) {
+    constexpr int LEGACY_ITERATIONS = 3;   // Regex path costs ~1 ms per KB
+    constexpr int ITERATIONS = 50;
+
+    std::cout << "\nRequest analysis on agent transcripts\n";
+    std::cout << std::setw(10) << "size KB" << std::setw(14) << "legacy us"
+              << std::setw(16) << "single-pass us" << std::setw(10) << "speedup" << "\n";
+
+    for (size_t kb : {100u, 250u, 500u}) {
+        auto request = make_agent_request(kb * 1024, "Continue with the next file.");
+
+        RequestType expected = legacy_classify(request);
+        ASSERT_EQ(routing_.analyze_request(request).type_, expected);
+
+        double legacy_us = mean_microseconds(LEGACY_ITERATIONS, [&]() {
+            volatile RequestType type = legacy_classify(request);
+            (void)type;
+        });
+        double single_pass_us = mean_microseconds(ITERATIONS, [&]() {
+            volatile int tokens = routing_.analyze_request(request).estimated_tokens_;
+            (void)tokens;
+        });
+
+        std::cout << std::setw(10) << kb << std::setw(14) << std::fixed << std::setprecision(1)
+                  << legacy_us << std::setw(16) << single_pass_us << std::setw(9)
+                  << std::setprecision(1) << legacy_us / single_pass_us << "x\n";
+
+        EXPECT_LT(single_pass_us, legacy_us);
+    }
+}
@@ -0,0 +1,251 @@
+/**
+ * Upstream I/O Load Benchmark
+ *
+ * Drives HttpClient::send_request_future against a local mock upstream that
+ * holds every request open for a fixed delay, emulating long-running LLM
+ * calls. Requests are multiplexed on the shared curl_multi event loop, so the
+ * process thread count must stay flat while concurrency grows.
+ */
+
+#include <gtest/gtest.h>
+#include <sys/epoll.h>
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <arpa/inet.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <fstream>
+#include <future>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "aimux/network/http_client.hpp"
+#include "aimux/network/curl_multi_engine.hpp"
+
+using namespace aimux::network;
+using namespace std::chrono;
+
+namespace {
+
+size_t current_thread_count() {
+    std::ifstream status("/proc/self/status");
+    std::string line;
+    while (std::getline(status, line)) {
+        if (line.rfind("Threads:", 0) == 0) {
+            return std::stoul(line.substr(8));
+        }
+    }
+    return 0;
+}
+
+/**
+ * Single-threaded keep-alive HTTP/1.1 server that answers each request
+ * after a fixed delay.
+ */
+class DelayedMockUpstream {
+public:
+    explicit DelayedMockUpstream(milliseconds delay) : delay_(delay) {
+        listen_fd_ = socket(AF_INET, SOCK_STREAM | SOCK_NONBLOCK, 0);
+        int reuse = 1;
+        setsockopt(listen_fd_, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse));
+
+        sockaddr_in addr{};
+        addr.sin_family = AF_INET;
+        addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        addr.sin_port = 0;
+        bind(listen_fd_, reinterpret_cast<sockaddr*>(&addr), sizeof(addr));
+        listen(listen_fd_, 1024);
+
+        socklen_t len = sizeof(addr);
+        getsockname(listen_fd_, reinterpret_cast<sockaddr*>(&addr), &len);
+        port_ = ntohs(addr.sin_port);
+
+        epoll_fd_ = epoll_create1(0);
+        epoll_event ev{};
+        ev.events = EPOLLIN;
+        ev.data.fd = listen_fd_;
+        epoll_ctl(epoll_fd_, EPOLL_CTL_ADD, listen_fd_, &ev);
+
+        running_ = true;
+        thread_ = std::thread([this]() { run(); });
+    }
+
+    ~DelayedMockUpstream() {
+        running_ = false;
+        thread_.join();
+        for (auto& [fd, conn] : connections_) {
+            close(fd);
+        }
+        close(epoll_fd_);
+        close(listen_fd_);
+    }
+
+    std::string url() const {
+        return "http://127.0.0.1:" + std::to_string(port_) + "/v1/chat/completions";
+    }
+
+private:
+    struct Connection {
+        std::string inbound;
+        std::vector<steady_clock::time_point> due;
+    };
+
+    void run() {
+        std::vector<epoll_event> events(512);
+        while (running_) {
+            int n = epoll_wait(epoll_fd_, events.data(), static_cast<int>(events.size()), 5);
+            for (int i = 0; i < n; ++i) {
+                int fd = events[i].data.fd;
+                if (fd == listen_fd_) {
+                    accept_all();
+                } else {
+                    read_from(fd);
+                }
+            }
+            respond_due();
+        }
+    }
+
+    void accept_all() {
+        while (true) {
+            int fd = accept4(listen_fd_, nullptr, nullptr, SOCK_NONBLOCK);
+            if (fd < 0) {
+                return;
+            }
+            epoll_event ev{};
+            ev.events = EPOLLIN;
+            ev.data.fd = fd;
+            epoll_ctl(epoll_fd_, EPOLL_CTL_ADD, fd, &ev);
+            connections_[fd];
+        }
+    }
+
+    void read_from(int fd) {
+        char buffer[4096];
+        auto& conn = connections_[fd];
+        while (true) {
+            ssize_t got = read(fd, buffer, sizeof(buffer));
+            if (got > 0) {
+                conn.inbound.append(buffer, static_cast<size_t>(got));
+                continue;
+            }
+            if (got == 0) {
+                epoll_ctl(epoll_fd_, EPOLL_CTL_DEL, fd, nullptr);
+                close(fd);
+                connections_.erase(fd);
+                return;
+            }
+            break;
+        }
+        size_t end;
+        while ((end = conn.inbound.find("\r\n\r\n")) != std::string::npos) {
+            conn.inbound.erase(0, end + 4);
+            conn.due.push_back(steady_clock::now() + delay_);
+        }
+    }
+
+    void respond_due() {
+        static const std::string reply =
+            "HTTP/1.1 200 OK\r\nContent-Type: application/json\r\n"
+            "Content-Length: 11\r\nConnection: keep-alive\r\n\r\n{\"ok\":true}";
+        auto now = steady_clock::now();
+        for (auto& [fd, conn] : connections_) {
+            while (!conn.due.empty() && conn.due.front() <= now) {
+                ssize_t written = write(fd, reply.data(), reply.size());
+                (void)written;
+                conn.due.erase(conn.due.begin());
+            }
+        }
+    }
+
+    milliseconds delay_;
+    int listen_fd_ = -1;
+    int epoll_fd_ = -1;
+    int port_ = 0;
+    std::atomic<bool> running_{false};
+    std::thread thread_;
+    std::map<int, Connection> connections_;
+};
+
+} // namespace
+
+class UpstreamIoLoadTest : public ::testing::Test {
+protected:
+    static constexpr milliseconds UPSTREAM_DELAY{300};
+
+    struct LevelResult {
+        size_t concurrency = 0;
+        size_t succeeded = 0;
+        size_t peak_threads = 0;
+        double wall_ms = 0.0;
+    };
+
+    LevelResult run_level(HttpClient& client, const std::string& url, size_t concurrency) {
+        LevelResult result;
+        result.concurrency = concurrency;
+
+        HttpRequest request;
+        request.url = url;
+        request.method = "GET";
+        request.timeout_ms = 10000;
+
+        auto start = high_resolution_clock::now();
+        std::vector<std::future<HttpResponse>> futures;
+        futures.reserve(concurrency);
+        for (size_t i = 0; i < concurrency; ++i) {
+            futures.push_back(client.send_request_future(request));
+        }
+
+        // Sample while every request is parked in the upstream
+        std::this_thread::sleep_for(UPSTREAM_DELAY / 2);
+        result.peak_threads = current_thread_count();
+
+        for (auto& future : futures) {
+            HttpResponse response = future.get();
+            if (response.status_code == 200) {
+                result.succeeded++;
+            }
+        }
+        result.wall_ms = duration<double, std::milli>(high_resolution_clock::now() - start).count();
+        result.peak_threads = std::max(result.peak_threads, current_thread_count());
+        return result;
+    }
+};
+
+TEST_F(UpstreamIoLoadTest, ThreadCountStaysFlatAsConcurrencyGrows) {
+    DelayedMockUpstream upstream(UPSTREAM_DELAY);
+    HttpClient client(64, 10000);
+
+    // Warm up the event loop so its thread is counted at every level
+    ASSERT_EQ(run_level(client, upstream.url(), 1).succeeded, 1u);
+
+    std::vector<LevelResult> results;
+    for (size_t concurrency : {16u, 64u, 128u, 256u}) {
+        results.push_back(run_level(client, upstream.url(), concurrency));
+    }
+
+    std::cout << "\nUpstream I/O load (mock delay " << UPSTREAM_DELAY.count() << " ms)\n";
+    std::cout << std::setw(12) << "concurrency" << std::setw(12) << "ok"
+              << std::setw(10) << "threads" << std::setw(12) << "wall ms" << "\n";
+    for (const auto& r : results) {
+        std::cout << std::setw(12) << r.concurrency << std::setw(12) << r.succeeded
+                  << std::setw(10) << r.peak_threads << std::setw(12)
+                  << std::fixed << std::setprecision(1) << r.wall_ms << "\n";
+    }
+    std::cout << "Engine: " << CurlMultiEngine::instance().get_statistics().dump() << "\n";
+
+    for (const auto& r : results) {
+        EXPECT_EQ(r.succeeded, r.concurrency);
+        // Requests overlap instead of queueing behind a thread pool
+        EXPECT_LT(r.wall_ms, UPSTREAM_DELAY.count() * 4.0);
+        // No per-request threads: growth from 16 to 256 in flight adds nothing
+        EXPECT_LE(r.peak_threads, results.front().peak_threads + 1);
+    }
+}